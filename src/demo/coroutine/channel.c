@@ -51,13 +51,13 @@ static tb_void_t tb_demo_coroutine_channel_test_recv(tb_cpointer_t priv)
         tb_trace_i("[coroutine: %p]: recv: %lu ok", tb_coroutine_self(), data);
     }
 }
-static tb_void_t tb_demo_coroutine_channel_test(tb_size_t size)
+static tb_void_t tb_demo_coroutine_channel_test(tb_size_t size, tb_size_t worker_maxn, tb_size_t mode)
 {
     // trace
     tb_trace_i("test: %lu", size);
 
     // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_with_mode(worker_maxn, mode);
     if (scheduler)
     {
         // init channel
@@ -100,13 +100,13 @@ static tb_void_t tb_demo_coroutine_channel_perf_recv(tb_cpointer_t priv)
     tb_size_t count = COUNT;
     while (count--) tb_co_channel_recv(channel);
 }
-static tb_void_t tb_demo_coroutine_channel_perf(tb_size_t size)
+static tb_void_t tb_demo_coroutine_channel_perf(tb_size_t size, tb_size_t worker_maxn, tb_size_t mode)
 {
     // trace
     tb_trace_i("perf: %lu", size);
 
     // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_with_mode(worker_maxn, mode);
     if (scheduler)
     {
         // init channel
@@ -142,13 +142,22 @@ static tb_void_t tb_demo_coroutine_channel_perf(tb_size_t size)
  */
 tb_int_t tb_demo_coroutine_channel_main(tb_int_t argc, tb_char_t** argv)
 {
-    tb_demo_coroutine_channel_test(0);
-    tb_demo_coroutine_channel_test(1);
-    tb_demo_coroutine_channel_test(5);
+    // run it on the multiple workers? e.g. demo coroutine_channel multi [workers]
+    tb_size_t mode = TB_CO_SCHEDULER_MODE_SINGLE;
+    tb_size_t worker_maxn = 0;
+    if (argc > 1 && !tb_strcmp(argv[1], "multi"))
+    {
+        mode = TB_CO_SCHEDULER_MODE_MULTI;
+        if (argc > 2) worker_maxn = tb_atoi(argv[2]);
+    }
+
+    tb_demo_coroutine_channel_test(0, worker_maxn, mode);
+    tb_demo_coroutine_channel_test(1, worker_maxn, mode);
+    tb_demo_coroutine_channel_test(5, worker_maxn, mode);
 
-    tb_demo_coroutine_channel_perf(0);
-    tb_demo_coroutine_channel_perf(1);
-    tb_demo_coroutine_channel_perf(10);
+    tb_demo_coroutine_channel_perf(0, worker_maxn, mode);
+    tb_demo_coroutine_channel_perf(1, worker_maxn, mode);
+    tb_demo_coroutine_channel_perf(10, worker_maxn, mode);
 
     return 0;
 }
@@ -0,0 +1,192 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the hello response data
+#define TB_DEMO_HELLO       "hello tbox!"
+
+// the idle timeout of the server connection
+#define TB_DEMO_TIMEOUT     (200)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the http server
+static tb_http_server_ref_t     g_server = tb_null;
+
+// the server url
+static tb_char_t                g_url[64];
+
+// the request count
+static tb_size_t                g_requests = 100;
+
+// the failed request count
+static tb_size_t                g_failed = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * server
+ */
+static tb_bool_t tb_demo_server_on_request(tb_http_server_request_ref_t request, tb_http_server_response_ref_t response, tb_cpointer_t priv)
+{
+    response->type = "text/plain";
+    response->data = (tb_byte_t const*)TB_DEMO_HELLO;
+    response->size = sizeof(TB_DEMO_HELLO) - 1;
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * client
+ */
+static tb_bool_t tb_demo_client_http(tb_noarg_t)
+{
+    // init http
+    tb_http_ref_t http = tb_http_init();
+    tb_assert_and_check_return_val(http, tb_false);
+
+    // get it
+    tb_bool_t ok = tb_false;
+    tb_byte_t data[sizeof(TB_DEMO_HELLO) - 1];
+    if (    tb_http_ctrl(http, TB_HTTP_OPTION_SET_URL, g_url)
+        &&  tb_http_open(http)
+        &&  tb_http_status(http)->content_size == sizeof(data)
+        &&  tb_http_bread(http, data, sizeof(data)))
+    {
+        ok = !tb_memcmp(data, TB_DEMO_HELLO, sizeof(data));
+    }
+
+    // exit http, the connection will be put to the pool
+    tb_http_exit(http);
+    return ok;
+}
+static tb_bool_t tb_demo_client_post(tb_noarg_t)
+{
+    // init http
+    tb_http_ref_t http = tb_http_init();
+    tb_assert_and_check_return_val(http, tb_false);
+
+    // post it, it will not be retried on the stale connection because it is not idempotent
+    tb_bool_t ok = tb_false;
+    tb_byte_t data[sizeof(TB_DEMO_HELLO) - 1];
+    if (    tb_http_ctrl(http, TB_HTTP_OPTION_SET_URL, g_url)
+        &&  tb_http_ctrl(http, TB_HTTP_OPTION_SET_METHOD, TB_HTTP_METHOD_POST)
+        &&  tb_http_ctrl(http, TB_HTTP_OPTION_SET_POST_DATA, TB_DEMO_HELLO, sizeof(TB_DEMO_HELLO) - 1)
+        &&  tb_http_open(http)
+        &&  tb_http_status(http)->content_size == sizeof(data)
+        &&  tb_http_bread(http, data, sizeof(data)))
+    {
+        ok = !tb_memcmp(data, TB_DEMO_HELLO, sizeof(data));
+    }
+
+    // exit http, the connection will be put to the pool
+    tb_http_exit(http);
+    return ok;
+}
+static tb_bool_t tb_demo_client_stream(tb_noarg_t)
+{
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(g_url);
+    tb_assert_and_check_return_val(stream, tb_false);
+
+    // get it
+    tb_bool_t ok = tb_false;
+    tb_byte_t data[sizeof(TB_DEMO_HELLO) - 1];
+    if (    tb_stream_open(stream)
+        &&  tb_stream_size(stream) == sizeof(data)
+        &&  tb_stream_bread(stream, data, sizeof(data)))
+    {
+        ok = !tb_memcmp(data, TB_DEMO_HELLO, sizeof(data));
+    }
+
+    // exit stream
+    tb_stream_exit(stream);
+    return ok;
+}
+static tb_void_t tb_demo_client_loop(tb_cpointer_t priv)
+{
+    // get it with tb_http and tb_stream alternately
+    tb_size_t i = 0;
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < g_requests; i++)
+    {
+        if (!((i & 1)? tb_demo_client_stream() : tb_demo_client_http())) g_failed++;
+    }
+    t = tb_mclock() - t;
+
+    // trace
+    tb_http_pool_stat_t stat;
+    tb_http_pool_stat(tb_http_pool(), &stat);
+    tb_trace_i("%lu requests, %lld ms, failed: %lu, idle: %lu, hits: %llu, misses: %llu"
+        , g_requests, t, g_failed, stat.idle, stat.hits, stat.misses);
+
+    // wait the server to close the idle connection, the stale connection will be dropped
+    tb_msleep(TB_DEMO_TIMEOUT * 2);
+    if (!tb_demo_client_http()) g_failed++;
+
+    // post it after the server timeout again
+    tb_msleep(TB_DEMO_TIMEOUT * 2);
+    if (!tb_demo_client_post()) g_failed++;
+
+    // trace
+    tb_http_pool_stat(tb_http_pool(), &stat);
+    tb_trace_i("after the server timeout, failed: %lu, idle: %lu, hits: %llu, misses: %llu, stale: %llu"
+        , g_failed, stat.idle, stat.hits, stat.misses, stat.stale);
+
+    // close all idle connections before stopping the server
+    tb_http_pool_clear(tb_http_pool());
+    tb_http_server_stop(g_server);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_coroutine_http_pool_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the request count
+    if (argc > 1 && argv[1]) g_requests = tb_atoi(argv[1]);
+
+    // done
+    tb_co_scheduler_ref_t scheduler = tb_null;
+    do
+    {
+        // init scheduler
+        scheduler = tb_co_scheduler_init();
+        tb_assert_and_check_break(scheduler);
+
+        // init server
+        g_server = tb_http_server_init(tb_demo_server_on_request, tb_null);
+        tb_assert_and_check_break(g_server);
+
+        // the server will close the idle connection after timeout
+        if (!tb_http_server_ctrl(g_server, TB_HTTP_SERVER_OPTION_SET_TIMEOUT, (tb_long_t)TB_DEMO_TIMEOUT)) break;
+
+        // bind a random port
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+        if (!tb_http_server_bind(g_server, &addr)) break;
+        if (!tb_http_server_addr(g_server, &addr)) break;
+        tb_snprintf(g_url, sizeof(g_url), "http://127.0.0.1:%u/", tb_ipaddr_port(&addr));
+        tb_trace_i("server: %s", g_url);
+
+        // start server and client
+        if (!tb_http_server_start(g_server, scheduler)) break;
+        if (!tb_coroutine_start(scheduler, tb_demo_client_loop, tb_null, 0)) break;
+
+        // run scheduler
+        tb_co_scheduler_loop(scheduler, tb_true);
+
+    } while (0);
+
+    // exit server
+    if (g_server) tb_http_server_exit(g_server);
+    g_server = tb_null;
+
+    // exit scheduler
+    if (scheduler) tb_co_scheduler_exit(scheduler);
+    return 0;
+}
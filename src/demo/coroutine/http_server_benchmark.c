@@ -0,0 +1,315 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the timeout
+#define TB_DEMO_TIMEOUT     (10000)
+
+// the max pipeline depth
+#define TB_DEMO_DEPTH_MAXN  (64)
+
+// the hello response data
+#define TB_DEMO_HELLO       "hello tbox!"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the client type
+typedef struct __tb_demo_client_t
+{
+    // the socket
+    tb_socket_ref_t sock;
+
+    // the recv data size
+    tb_size_t       size;
+
+    // the recv data
+    tb_byte_t       data[16384];
+
+}tb_demo_client_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the server address
+static tb_ipaddr_t              g_addr;
+
+// the http server
+static tb_http_server_ref_t     g_server = tb_null;
+
+// the client count
+static tb_size_t                g_clients = 16;
+
+// the request count of each client
+static tb_size_t                g_requests = 10000;
+
+// the pipeline depth
+static tb_size_t                g_depth = 16;
+
+// the finished client count
+static tb_size_t                g_finished = 0;
+
+// the succeeded request count
+static tb_hize_t                g_succeeded = 0;
+
+// the failed client count
+static tb_size_t                g_failed = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * server
+ */
+static tb_bool_t tb_demo_server_on_request(tb_http_server_request_ref_t request, tb_http_server_response_ref_t response, tb_cpointer_t priv)
+{
+    // echo the request body
+    if (request->method == TB_HTTP_METHOD_POST)
+    {
+        response->type = "application/octet-stream";
+        response->data = request->body;
+        response->size = request->body_size;
+    }
+    // hello
+    else if (request->path_size == 1)
+    {
+        response->type = "text/plain";
+        response->data = (tb_byte_t const*)TB_DEMO_HELLO;
+        response->size = sizeof(TB_DEMO_HELLO) - 1;
+    }
+    else response->code = TB_HTTP_CODE_NOT_FOUND;
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * client
+ */
+static tb_bool_t tb_demo_client_send(tb_demo_client_t* client, tb_char_t const* data, tb_size_t size)
+{
+    tb_size_t send = 0;
+    tb_bool_t wait = tb_false;
+    while (send < size)
+    {
+        tb_long_t real = tb_socket_send(client->sock, (tb_byte_t const*)data + send, size - send);
+        if (real > 0)
+        {
+            send += real;
+            wait = tb_false;
+        }
+        else if (!real && !wait)
+        {
+            if (tb_socket_wait(client->sock, TB_SOCKET_EVENT_SEND, TB_DEMO_TIMEOUT) <= 0) break;
+            wait = tb_true;
+        }
+        else break;
+    }
+    return send == size;
+}
+static tb_bool_t tb_demo_client_recv(tb_demo_client_t* client)
+{
+    tb_bool_t wait = tb_false;
+    while (client->size < sizeof(client->data))
+    {
+        tb_long_t real = tb_socket_recv(client->sock, client->data + client->size, sizeof(client->data) - client->size);
+        if (real > 0)
+        {
+            client->size += real;
+            return tb_true;
+        }
+        else if (!real && !wait)
+        {
+            if (tb_socket_wait(client->sock, TB_SOCKET_EVENT_RECV, TB_DEMO_TIMEOUT) <= 0) break;
+            wait = tb_true;
+        }
+        else break;
+    }
+    return tb_false;
+}
+static tb_bool_t tb_demo_client_response(tb_demo_client_t* client, tb_char_t const* body, tb_size_t body_size)
+{
+    // find the head end
+    tb_char_t const* e = tb_null;
+    while (!(e = (tb_char_t const*)tb_memmem(client->data, client->size, "\r\n\r\n", 4)))
+    {
+        if (!tb_demo_client_recv(client)) return tb_false;
+    }
+
+    // check the status line
+    tb_char_t const* p = (tb_char_t const*)client->data;
+    tb_check_return_val(!tb_strncmp(p, "HTTP/1.1 200 ", 13), tb_false);
+
+    // get the content size
+    tb_char_t const* s = (tb_char_t const*)tb_memmem(p, e - p, "Content-Length: ", 16);
+    tb_check_return_val(s, tb_false);
+    tb_size_t content_size = tb_s10tou32(s + 16);
+    tb_check_return_val(content_size == body_size, tb_false);
+
+    // recv the content
+    tb_size_t size = e + 4 - p + content_size;
+    tb_check_return_val(size <= sizeof(client->data), tb_false);
+    while (client->size < size)
+    {
+        if (!tb_demo_client_recv(client)) return tb_false;
+    }
+
+    // check the content
+    tb_check_return_val(!tb_memcmp(client->data + size - content_size, body, body_size), tb_false);
+
+    // remove this response
+    client->size -= size;
+    if (client->size) tb_memmov(client->data, client->data + size, client->size);
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_post(tb_demo_client_t* client)
+{
+    // the content-length body
+    static tb_char_t const s_request[] =
+        "POST /echo HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Content-Length: 10\r\n"
+        "\r\n"
+        "0123456789";
+    if (!tb_demo_client_send(client, s_request, sizeof(s_request) - 1)) return tb_false;
+    if (!tb_demo_client_response(client, "0123456789", 10)) return tb_false;
+
+    // the chunked body, it is sent in two parts
+    static tb_char_t const s_chunked[] =
+        "POST /echo HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "5;ext=1\r\nhello\r\n"
+        "1\r\n \r\n";
+    static tb_char_t const s_chunked_end[] =
+        "4\r\ntbox\r\n"
+        "0\r\n"
+        "Trailer: 1\r\n"
+        "\r\n";
+    if (!tb_demo_client_send(client, s_chunked, sizeof(s_chunked) - 1)) return tb_false;
+    tb_msleep(1);
+    if (!tb_demo_client_send(client, s_chunked_end, sizeof(s_chunked_end) - 1)) return tb_false;
+    return tb_demo_client_response(client, "hello tbox", 10);
+}
+static tb_void_t tb_demo_client_loop(tb_cpointer_t priv)
+{
+    // init client
+    tb_demo_client_t* client = tb_malloc0_type(tb_demo_client_t);
+    tb_assert_and_check_return(client);
+
+    // the pipelined requests
+    static tb_char_t const s_request[] = "GET / HTTP/1.1\r\nHost: localhost\r\nUser-Agent: tbox\r\n\r\n";
+    tb_char_t   requests[sizeof(s_request) * TB_DEMO_DEPTH_MAXN];
+    tb_size_t   i = 0;
+    for (i = 0; i < g_depth; i++)
+        tb_memcpy(requests + i * (sizeof(s_request) - 1), s_request, sizeof(s_request) - 1);
+
+    // done
+    tb_bool_t ok = tb_false;
+    tb_size_t count = 0;
+    do
+    {
+        // connect it
+        client->sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_break(client->sock);
+
+        tb_long_t real = 0;
+        while (!(real = tb_socket_connect(client->sock, &g_addr)))
+        {
+            if (tb_socket_wait(client->sock, TB_SOCKET_EVENT_CONN, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        tb_check_break(real > 0);
+
+        // send the pipelined requests and check the responses
+        while (count < g_requests)
+        {
+            tb_size_t n = tb_min(g_depth, g_requests - count);
+            if (!tb_demo_client_send(client, requests, n * (sizeof(s_request) - 1))) break;
+            for (i = 0; i < n; i++)
+            {
+                if (!tb_demo_client_response(client, TB_DEMO_HELLO, sizeof(TB_DEMO_HELLO) - 1)) break;
+            }
+            tb_check_break(i == n);
+            count += n;
+        }
+        tb_check_break(count == g_requests);
+
+        // post the bodies
+        if (!tb_demo_client_post(client)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit client
+    if (client->sock) tb_socket_exit(client->sock);
+    tb_free(client);
+
+    // save the result
+    g_succeeded += count;
+    if (!ok) g_failed++;
+
+    // the last client? stop the server
+    if (++g_finished == g_clients) tb_http_server_stop(g_server);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_coroutine_http_server_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the client count, the request count of each client and the pipeline depth
+    if (argc > 1 && argv[1]) g_clients = tb_atoi(argv[1]);
+    if (argc > 2 && argv[2]) g_requests = tb_atoi(argv[2]);
+    if (argc > 3 && argv[3]) g_depth = tb_atoi(argv[3]);
+    g_depth = tb_max(tb_min(g_depth, TB_DEMO_DEPTH_MAXN), 1);
+
+    // done
+    tb_co_scheduler_ref_t scheduler = tb_null;
+    do
+    {
+        // init scheduler
+        scheduler = tb_co_scheduler_init();
+        tb_assert_and_check_break(scheduler);
+
+        // init server
+        g_server = tb_http_server_init(tb_demo_server_on_request, tb_null);
+        tb_assert_and_check_break(g_server);
+
+        // bind a random port
+        tb_ipaddr_set(&g_addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+        if (!tb_http_server_bind(g_server, &g_addr)) break;
+        if (!tb_http_server_addr(g_server, &g_addr)) break;
+        tb_trace_i("server: %{ipaddr}", &g_addr);
+
+        // start server
+        if (!tb_http_server_start(g_server, scheduler)) break;
+
+        // start clients
+        tb_size_t i = 0;
+        for (i = 0; i < g_clients; i++)
+            tb_coroutine_start(scheduler, tb_demo_client_loop, tb_null, 0);
+
+        // run scheduler
+        tb_hong_t t = tb_mclock();
+        tb_co_scheduler_loop(scheduler, tb_true);
+        t = tb_mclock() - t;
+
+        // trace
+        tb_trace_i("%lu clients x %lu requests, depth: %lu, %lld ms, %lld requests/s, failed: %lu"
+            , g_clients, g_requests, g_depth, t, t > 0? (tb_hong_t)g_succeeded * 1000 / t : 0, g_failed);
+
+    } while (0);
+
+    // exit server
+    if (g_server) tb_http_server_exit(g_server);
+    g_server = tb_null;
+
+    // exit scheduler
+    if (scheduler) tb_co_scheduler_exit(scheduler);
+    return 0;
+}
@@ -0,0 +1,239 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the echo data size
+#define TB_DEMO_SIZE        (64)
+
+// the default echo count
+#define TB_DEMO_COUNT       (100000)
+
+// the default connections count
+#define TB_DEMO_CONNS       (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo type
+typedef struct __tb_demo_iouring_t
+{
+    // the listened socket
+    tb_socket_ref_t     sock;
+
+    // the listened address
+    tb_ipaddr_t         addr;
+
+    // the echo count of each connection
+    tb_size_t           count;
+
+    // the connections count
+    tb_size_t           conns;
+
+    // the finished echo count
+    tb_size_t           finished;
+
+    // the alive clients count
+    tb_size_t           alive;
+
+    // the start time
+    tb_hong_t           time;
+
+}tb_demo_iouring_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_demo_iouring_brecv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size)
+{
+    tb_size_t recv = 0;
+    while (recv < size)
+    {
+        tb_long_t real = tb_coroutine_recv(sock, data + recv, size - recv, -1);
+        tb_check_break(real > 0);
+        recv += real;
+    }
+    return recv == size;
+}
+static tb_bool_t tb_demo_iouring_bsend(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size)
+{
+    tb_size_t send = 0;
+    while (send < size)
+    {
+        tb_long_t real = tb_coroutine_send(sock, data + send, size - send, -1);
+        tb_check_break(real > 0);
+        send += real;
+    }
+    return send == size;
+}
+static tb_void_t tb_demo_iouring_echo(tb_cpointer_t priv)
+{
+    // echo until the client is closed
+    tb_socket_ref_t sock = (tb_socket_ref_t)priv;
+    tb_byte_t       data[TB_DEMO_SIZE];
+    while (tb_demo_iouring_brecv(sock, data, sizeof(data)))
+    {
+        if (!tb_demo_iouring_bsend(sock, data, sizeof(data))) break;
+    }
+    tb_socket_exit(sock);
+}
+static tb_void_t tb_demo_iouring_client(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_iouring_t* demo = (tb_demo_iouring_t*)priv;
+    tb_assert_and_check_return(demo);
+
+    // connect the server
+    tb_socket_ref_t sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+    tb_assert_and_check_return(sock);
+    if (tb_coroutine_connect(sock, &demo->addr, -1) > 0)
+    {
+        // echo
+        tb_size_t count = 0;
+        tb_byte_t data[TB_DEMO_SIZE];
+        tb_memset(data, 'x', sizeof(data));
+        for (count = 0; count < demo->count; count++)
+        {
+            if (!tb_demo_iouring_bsend(sock, data, sizeof(data))) break;
+            if (!tb_demo_iouring_brecv(sock, data, sizeof(data))) break;
+        }
+        demo->finished += count;
+    }
+    tb_socket_exit(sock);
+
+    // the last client? trace the result
+    if (!--demo->alive)
+    {
+        tb_hong_t time = tb_mclock() - demo->time;
+        tb_trace_i("[client]: echo %lu/%lu with %lu connections in %lld ms, %lld echo/s", demo->finished, demo->count * demo->conns, demo->conns, time, time? ((tb_hong_t)demo->finished * 1000) / time : 0);
+    }
+}
+static tb_void_t tb_demo_iouring_close(tb_cpointer_t priv)
+{
+    // close the socket while the other coroutine is receiving it
+    tb_coroutine_sleep(50);
+    tb_socket_exit((tb_socket_ref_t)priv);
+}
+static tb_void_t tb_demo_iouring_cancel(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_iouring_t* demo = (tb_demo_iouring_t*)priv;
+    tb_assert_and_check_return(demo);
+
+    // connect the server
+    tb_socket_ref_t sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+    tb_assert_and_check_return(sock);
+    if (tb_coroutine_connect(sock, &demo->addr, -1) > 0)
+    {
+        // recv timeout, the server will not send any data
+        tb_byte_t data[TB_DEMO_SIZE];
+        tb_hong_t time = tb_mclock();
+        tb_long_t real = tb_coroutine_recv(sock, data, sizeof(data), 50);
+        tb_trace_i("[client]: recv timeout: %s, %lld ms", !real? "ok" : "no", tb_mclock() - time);
+
+        // wait the server to close it
+        tb_coroutine_sleep(200);
+    }
+    tb_socket_exit(sock);
+}
+static tb_void_t tb_demo_iouring_server(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_iouring_t* demo = (tb_demo_iouring_t*)priv;
+    tb_assert_and_check_return(demo);
+
+    // accept timeout
+    tb_hong_t       time = tb_mclock();
+    tb_socket_ref_t client = tb_coroutine_accept(demo->sock, tb_null, 50);
+    tb_trace_i("[server]: accept timeout: %s, %lld ms", client? "no" : "ok", tb_mclock() - time);
+    if (client) tb_socket_exit(client);
+
+    // start the clients after the accept timeout
+    tb_size_t i = 0;
+    demo->time  = tb_mclock();
+    demo->alive = demo->conns;
+    for (i = 0; i < demo->conns; i++)
+        tb_coroutine_start(tb_null, tb_demo_iouring_client, demo, 0);
+
+    // accept the clients
+    tb_ipaddr_t addr;
+    for (i = 0; i < demo->conns; i++)
+    {
+        client = tb_coroutine_accept(demo->sock, &addr, -1);
+        tb_assert_and_check_return(client);
+        tb_coroutine_start(tb_null, tb_demo_iouring_echo, client, 0);
+    }
+
+    // trace
+    tb_trace_i("[server]: accept %lu clients, the last: %{ipaddr}", demo->conns, &addr);
+
+    // wait all clients
+    while (demo->alive) tb_coroutine_sleep(10);
+
+    // accept the next client for testing cancel
+    tb_coroutine_start(tb_null, tb_demo_iouring_cancel, demo, 0);
+    client = tb_coroutine_accept(demo->sock, tb_null, -1);
+    tb_assert_and_check_return(client);
+
+    // receive it until the socket is closed by the other coroutine
+    tb_byte_t data[TB_DEMO_SIZE];
+    tb_coroutine_start(tb_null, tb_demo_iouring_close, client, 0);
+    time = tb_mclock();
+    tb_long_t real = tb_coroutine_recv(client, data, sizeof(data), 1000);
+    tb_trace_i("[server]: recv the closed socket: %ld, %lld ms", real, tb_mclock() - time);
+}
+static tb_void_t tb_demo_iouring_test(tb_size_t mode, tb_size_t count, tb_size_t conns)
+{
+    // trace
+    tb_trace_i("==================================== %s", (mode & TB_CO_SCHEDULER_FLAG_IOURING)? "io_uring" : "default");
+
+    // init demo
+    tb_demo_iouring_t demo = {0};
+    demo.count = count;
+    demo.conns = conns;
+
+    // init the listened socket
+    demo.sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+    tb_assert_and_check_return(demo.sock);
+    tb_ipaddr_set(&demo.addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+    if (tb_socket_bind(demo.sock, &demo.addr) && tb_socket_listen(demo.sock, (tb_size_t)conns + 16) && tb_socket_local(demo.sock, &demo.addr))
+    {
+        // init scheduler
+        tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_with_mode(0, mode);
+        if (scheduler)
+        {
+            // start the server
+            tb_coroutine_start(scheduler, tb_demo_iouring_server, &demo, 0);
+
+            // run scheduler
+            tb_co_scheduler_loop(scheduler, tb_true);
+
+            // exit scheduler
+            tb_co_scheduler_exit(scheduler);
+        }
+    }
+    tb_socket_exit(demo.sock);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_coroutine_iouring_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the echo count of each connection and the connections count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_COUNT;
+    tb_size_t conns = (argv[1] && argv[2])? tb_atoi(argv[2]) : TB_DEMO_CONNS;
+    if (!conns) conns = 1;
+
+    // readiness events with the default poller
+    tb_demo_iouring_test(TB_CO_SCHEDULER_MODE_SINGLE, count, conns);
+
+    // completion-based io with the io_uring poller, it will fall back to the default poller if it's not supported
+    tb_demo_iouring_test(TB_CO_SCHEDULER_MODE_SINGLE | TB_CO_SCHEDULER_FLAG_IOURING, count, conns);
+    return 0;
+}
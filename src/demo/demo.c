@@ -37,6 +37,8 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(libc_wchar)
 ,   TB_DEMO_MAIN_ITEM(libc_string)
 ,   TB_DEMO_MAIN_ITEM(libc_stdlib)
+,   TB_DEMO_MAIN_ITEM(libc_dtoa)
+,   TB_DEMO_MAIN_ITEM(libc_strsearch)
 ,   TB_DEMO_MAIN_ITEM(libc_wcstombs)
 ,   TB_DEMO_MAIN_ITEM(libc_mbstowcs)
 
@@ -79,6 +81,7 @@ static tb_demo_t g_demo[] =
 #endif
 ,   TB_DEMO_MAIN_ITEM(utils_base32)
 ,   TB_DEMO_MAIN_ITEM(utils_base64)
+,   TB_DEMO_MAIN_ITEM(utils_trace)
 
     // hash
 #ifdef TB_CONFIG_MODULE_HAVE_HASH
@@ -101,12 +104,15 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(other_test_cpp)
 #ifdef TB_CONFIG_MODULE_HAVE_CHARSET
 ,   TB_DEMO_MAIN_ITEM(other_charset)
+,   TB_DEMO_MAIN_ITEM(other_charset_benchmark)
 #endif
 
     // object
 #ifdef TB_CONFIG_MODULE_HAVE_OBJECT
 ,   TB_DEMO_MAIN_ITEM(object_jcat)
 ,   TB_DEMO_MAIN_ITEM(object_json)
+,   TB_DEMO_MAIN_ITEM(object_json_benchmark)
+,   TB_DEMO_MAIN_ITEM(object_json_reader)
 ,   TB_DEMO_MAIN_ITEM(object_bin)
 ,   TB_DEMO_MAIN_ITEM(object_xml)
 ,   TB_DEMO_MAIN_ITEM(object_bplist)
@@ -120,6 +126,8 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(stream_null)
 ,   TB_DEMO_MAIN_ITEM(stream_cache)
 ,   TB_DEMO_MAIN_ITEM(stream_charset)
+,   TB_DEMO_MAIN_ITEM(stream_mmap)
+,   TB_DEMO_MAIN_ITEM(stream_splice)
 ,   TB_DEMO_MAIN_ITEM(stream_zip)
 
     // string
@@ -133,7 +141,9 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(memory_large_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_small_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_default_allocator)
+,   TB_DEMO_MAIN_ITEM(memory_arena_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_memops)
+,   TB_DEMO_MAIN_ITEM(memory_memops_benchmark)
 ,   TB_DEMO_MAIN_ITEM(memory_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_queue_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_static_buffer)
@@ -141,6 +151,8 @@ static tb_demo_t g_demo[] =
 
     // network
 ,   TB_DEMO_MAIN_ITEM(network_dns)
+,   TB_DEMO_MAIN_ITEM(network_dns_cache)
+,   TB_DEMO_MAIN_ITEM(network_dns_batch)
 ,   TB_DEMO_MAIN_ITEM(network_url)
 ,   TB_DEMO_MAIN_ITEM(network_ipv4)
 ,   TB_DEMO_MAIN_ITEM(network_ipv6)
@@ -201,6 +213,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(container_stack)
 ,   TB_DEMO_MAIN_ITEM(container_vector)
 ,   TB_DEMO_MAIN_ITEM(container_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_flat_hash_map)
 ,   TB_DEMO_MAIN_ITEM(container_hash_set)
 ,   TB_DEMO_MAIN_ITEM(container_queue)
 ,   TB_DEMO_MAIN_ITEM(container_circle_queue)
@@ -237,6 +250,9 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(coroutine_file_server)
 ,   TB_DEMO_MAIN_ITEM(coroutine_file_client)
 ,   TB_DEMO_MAIN_ITEM(coroutine_http_server)
+,   TB_DEMO_MAIN_ITEM(coroutine_http_server_benchmark)
+,   TB_DEMO_MAIN_ITEM(coroutine_http_pool)
+,   TB_DEMO_MAIN_ITEM(coroutine_iouring)
 ,   TB_DEMO_MAIN_ITEM(coroutine_spider)
 
     // stackless coroutine
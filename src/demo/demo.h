@@ -55,6 +55,8 @@ TB_DEMO_MAIN_DECL(libc_time);
 TB_DEMO_MAIN_DECL(libc_wchar);
 TB_DEMO_MAIN_DECL(libc_string);
 TB_DEMO_MAIN_DECL(libc_stdlib);
+TB_DEMO_MAIN_DECL(libc_dtoa);
+TB_DEMO_MAIN_DECL(libc_strsearch);
 TB_DEMO_MAIN_DECL(libc_mbstowcs);
 TB_DEMO_MAIN_DECL(libc_wcstombs);
 
@@ -74,6 +76,7 @@ TB_DEMO_MAIN_DECL(utils_dump);
 TB_DEMO_MAIN_DECL(utils_option);
 TB_DEMO_MAIN_DECL(utils_base32);
 TB_DEMO_MAIN_DECL(utils_base64);
+TB_DEMO_MAIN_DECL(utils_trace);
 
 // hash
 TB_DEMO_MAIN_DECL(hash_md5);
@@ -93,10 +96,13 @@ TB_DEMO_MAIN_DECL(hash_benchmark);
 TB_DEMO_MAIN_DECL(other_test);
 TB_DEMO_MAIN_DECL(other_test_cpp);
 TB_DEMO_MAIN_DECL(other_charset);
+TB_DEMO_MAIN_DECL(other_charset_benchmark);
 
 // object
 TB_DEMO_MAIN_DECL(object_jcat);
 TB_DEMO_MAIN_DECL(object_json);
+TB_DEMO_MAIN_DECL(object_json_benchmark);
+TB_DEMO_MAIN_DECL(object_json_reader);
 TB_DEMO_MAIN_DECL(object_bin);
 TB_DEMO_MAIN_DECL(object_xml);
 TB_DEMO_MAIN_DECL(object_xplist);
@@ -113,6 +119,8 @@ TB_DEMO_MAIN_DECL(stream_zip);
 TB_DEMO_MAIN_DECL(stream_null);
 TB_DEMO_MAIN_DECL(stream_cache);
 TB_DEMO_MAIN_DECL(stream_charset);
+TB_DEMO_MAIN_DECL(stream_mmap);
+TB_DEMO_MAIN_DECL(stream_splice);
 TB_DEMO_MAIN_DECL(stream_async_stream_zip);
 TB_DEMO_MAIN_DECL(stream_async_stream_null);
 TB_DEMO_MAIN_DECL(stream_async_stream_cache);
@@ -129,7 +137,9 @@ TB_DEMO_MAIN_DECL(memory_string_pool);
 TB_DEMO_MAIN_DECL(memory_large_allocator);
 TB_DEMO_MAIN_DECL(memory_small_allocator);
 TB_DEMO_MAIN_DECL(memory_default_allocator);
+TB_DEMO_MAIN_DECL(memory_arena_allocator);
 TB_DEMO_MAIN_DECL(memory_memops);
+TB_DEMO_MAIN_DECL(memory_memops_benchmark);
 TB_DEMO_MAIN_DECL(memory_buffer);
 TB_DEMO_MAIN_DECL(memory_queue_buffer);
 TB_DEMO_MAIN_DECL(memory_static_buffer);
@@ -137,6 +147,8 @@ TB_DEMO_MAIN_DECL(memory_impl_static_fixed_pool);
 
 // network
 TB_DEMO_MAIN_DECL(network_dns);
+TB_DEMO_MAIN_DECL(network_dns_cache);
+TB_DEMO_MAIN_DECL(network_dns_batch);
 TB_DEMO_MAIN_DECL(network_url);
 TB_DEMO_MAIN_DECL(network_ipv4);
 TB_DEMO_MAIN_DECL(network_ipv6);
@@ -193,6 +205,7 @@ TB_DEMO_MAIN_DECL(container_heap);
 TB_DEMO_MAIN_DECL(container_stack);
 TB_DEMO_MAIN_DECL(container_vector);
 TB_DEMO_MAIN_DECL(container_hash_map);
+TB_DEMO_MAIN_DECL(container_flat_hash_map);
 TB_DEMO_MAIN_DECL(container_hash_set);
 TB_DEMO_MAIN_DECL(container_queue);
 TB_DEMO_MAIN_DECL(container_circle_queue);
@@ -229,6 +242,9 @@ TB_DEMO_MAIN_DECL(coroutine_unix_echo_server);
 TB_DEMO_MAIN_DECL(coroutine_file_client);
 TB_DEMO_MAIN_DECL(coroutine_file_server);
 TB_DEMO_MAIN_DECL(coroutine_http_server);
+TB_DEMO_MAIN_DECL(coroutine_http_server_benchmark);
+TB_DEMO_MAIN_DECL(coroutine_http_pool);
+TB_DEMO_MAIN_DECL(coroutine_iouring);
 
 // stackless coroutine
 TB_DEMO_MAIN_DECL(lo_coroutine_nest);
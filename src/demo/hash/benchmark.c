@@ -49,6 +49,14 @@ static tb_uint32_t tb_demo_blizzard_make(tb_byte_t const* data, tb_size_t size,
 {
     return (tb_uint32_t)tb_blizzard_make(data, size, seed);
 }
+static tb_uint32_t tb_demo_fnv64_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    return (tb_uint32_t)tb_fnv64_1a_make(data, size, seed);
+}
+static tb_uint32_t tb_demo_xxh3_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    return (tb_uint32_t)tb_xxh3_make(data, size, seed);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
@@ -64,15 +72,24 @@ static tb_demo_hash32_entry_t g_hash32_entries[] =
 ,   { "adler32 ",   tb_adler32_make         }
 ,   { "crc32   ",   tb_crc32_make           }
 ,   { "crc32-le",   tb_crc32_le_make        }
+,   { "crc32c  ",   tb_crc32c_make          }
 ,   { "bkdr    ",   tb_demo_bkdr_make       }
 ,   { "murmur  ",   tb_demo_murmur_make     }
 ,   { "blizzard",   tb_demo_blizzard_make   }
+,   { "fnv64-1a",   tb_demo_fnv64_make      }
+,   { "xxh3    ",   tb_demo_xxh3_make       }
 ,   { tb_null,      tb_null                 }
 };
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * test
  */
+static tb_void_t tb_demo_hash32_trace(tb_char_t const* name, tb_char_t const* entry, tb_uint32_t v, tb_hong_t t, tb_hize_t size)
+{
+    // the speed, GB/s
+    tb_hize_t speed = t > 0? size * 100 / ((tb_hize_t)t * 1000000) : 0;
+    tb_trace_i("[hash(%s)]: %s: %08x %lld ms, %llu.%02llu GB/s", name, entry, v, t, speed / 100, speed % 100);
+}
 static tb_void_t tb_demo_hash32_test()
 {
     // init data
@@ -98,7 +115,7 @@ static tb_void_t tb_demo_hash32_test()
         t = tb_mclock() - t;
 
         // trace
-        tb_trace_i("[hash(1K)]: %s: %08x %ld ms", entry->name, v, t);
+        tb_demo_hash32_trace("1K", entry->name, v, t, (tb_hize_t)1024 * 1000000);
     }
 
     // trace
@@ -118,12 +135,141 @@ static tb_void_t tb_demo_hash32_test()
         t = tb_mclock() - t;
 
         // trace
-        tb_trace_i("[hash(1M)]: %s: %08x %ld ms", entry->name, v, t);
+        tb_demo_hash32_trace("1M", entry->name, v, t, (tb_hize_t)size * 1000);
     }
 
     // exit data
     tb_free(data);
 }
+static tb_void_t tb_demo_hash32_keys_test()
+{
+    // the keys count and the buckets count
+    tb_size_t const count = 1 << 16;
+    tb_size_t const mask = count - 1;
+
+    // init keys and buckets
+    tb_char_t*  keys = (tb_char_t*)tb_malloc(count * 16);
+    tb_size_t*  sizes = tb_nalloc_type(count, tb_size_t);
+    tb_uint8_t* buckets = tb_malloc_bytes(count);
+    if (keys && sizes && buckets)
+    {
+        // make the short string keys, e.g. "key_12345"
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) sizes[i] = tb_snprintf(keys + (i << 4), 16, "key_%lu", i);
+
+        // done
+        tb_demo_hash32_entry_ref_t entry = g_hash32_entries;
+        for (; entry && entry->name; entry++)
+        {
+            // hash the keys
+            __tb_volatile__ tb_uint32_t v = 0;
+            __tb_volatile__ tb_size_t   n = 100;
+            __tb_volatile__ tb_hong_t   t = tb_mclock();
+            while (n--)
+            {
+                for (i = 0; i < count; i++) v += entry->hash((tb_byte_t const*)keys + (i << 4), sizes[i], 0);
+            }
+            t = tb_mclock() - t;
+
+            // the empty buckets and the longest chain, about 36.8% empty buckets for the uniform hash
+            tb_size_t empty = 0;
+            tb_size_t longest = 0;
+            tb_memset(buckets, 0, count);
+            for (i = 0; i < count; i++)
+            {
+                tb_uint8_t* bucket = &buckets[entry->hash((tb_byte_t const*)keys + (i << 4), sizes[i], 0) & mask];
+                if (*bucket < 0xff) (*bucket)++;
+            }
+            for (i = 0; i < count; i++)
+            {
+                if (!buckets[i]) empty++;
+                if (buckets[i] > longest) longest = buckets[i];
+            }
+
+            // trace
+            tb_trace_i("[hash(keys)]: %s: %08x %lld ms, %lu keys/us, empty: %lu.%lu%%, longest: %lu", entry->name, v, t
+                    , t > 0? (tb_size_t)(count * 100 / (t * 1000)) : 0, empty * 100 / count, (empty * 1000 / count) % 10, longest);
+        }
+    }
+
+    // exit data
+    if (keys) tb_free(keys);
+    if (sizes) tb_free(sizes);
+    if (buckets) tb_free(buckets);
+}
+static tb_size_t tb_demo_digest_make(tb_size_t mode, tb_byte_t const* data, tb_size_t size, tb_byte_t* digest)
+{
+    return mode? tb_sha_make(mode, data, size, digest, 32) : tb_md5_make(data, size, digest, 32);
+}
+static tb_size_t tb_demo_digest_make_multi(tb_size_t mode, tb_byte_t const** data, tb_size_t const* size, tb_byte_t** digest, tb_size_t count)
+{
+    return mode? tb_sha_make_multi(mode, data, size, digest, count) : tb_md5_make_multi(data, size, digest, count);
+}
+static tb_void_t tb_demo_digest_test()
+{
+    // the small messages count and size
+    tb_size_t const count = 4096;
+    tb_size_t const small = 64;
+
+    // init data
+    tb_size_t           size = 1024 * 1024;
+    tb_byte_t*          data = tb_malloc_bytes(size);
+    tb_byte_t*          digests = tb_malloc_bytes(count * 32);
+    tb_byte_t const**   ib = tb_nalloc_type(count, tb_byte_t const*);
+    tb_size_t*          in = tb_nalloc_type(count, tb_size_t);
+    tb_byte_t**         ob = tb_nalloc_type(count, tb_byte_t*);
+    if (data && digests && ib && in && ob)
+    {
+        // make data
+        tb_size_t i = 0;
+        for (i = 0; i < size; i++) data[i] = (tb_byte_t)tb_random_range(0, 0xff);
+        for (i = 0; i < count; i++)
+        {
+            ib[i] = data + i * small;
+            in[i] = small;
+            ob[i] = digests + i * 32;
+        }
+
+        // done
+        static tb_size_t const      modes[] = {0, TB_SHA_MODE_SHA1_160, TB_SHA_MODE_SHA2_256};
+        static tb_char_t const*     names[] = {"md5     ", "sha1    ", "sha256  "};
+        for (i = 0; i < tb_arrayn(modes); i++)
+        {
+            // 1M
+            tb_byte_t   digest[32];
+            tb_size_t   n = 100;
+            tb_hong_t   t = tb_mclock();
+            while (n--) tb_demo_digest_make(modes[i], data, size, digest);
+            t = tb_mclock() - t;
+            tb_demo_hash32_trace("1M", names[i], tb_bits_get_u32_be(digest), t, (tb_hize_t)size * 100);
+
+            // the small messages one by one
+            tb_size_t j = 0;
+            n = 100;
+            t = tb_mclock();
+            while (n--)
+            {
+                for (j = 0; j < count; j++) tb_demo_digest_make(modes[i], ib[j], small, ob[j]);
+            }
+            t = tb_mclock() - t;
+            tb_demo_hash32_trace("64B", names[i], tb_bits_get_u32_be(ob[count - 1]), t, (tb_hize_t)small * count * 100);
+
+            // the small messages with the multi-buffer
+            n = 100;
+            t = tb_mclock();
+            while (n--) tb_demo_digest_make_multi(modes[i], ib, in, ob, count);
+            t = tb_mclock() - t;
+            tb_demo_hash32_trace("64Bx", names[i], tb_bits_get_u32_be(ob[count - 1]), t, (tb_hize_t)small * count * 100);
+        }
+    }
+
+    // exit data
+    if (data) tb_free(data);
+    if (digests) tb_free(digests);
+    if (ib) tb_free(ib);
+    if (in) tb_free(in);
+    if (ob) tb_free(ob);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -131,5 +277,9 @@ static tb_void_t tb_demo_hash32_test()
 tb_int_t tb_demo_hash_benchmark_main(tb_int_t argc, tb_char_t** argv)
 {
     tb_demo_hash32_test();
+    tb_trace_i("");
+    tb_demo_hash32_keys_test();
+    tb_trace_i("");
+    tb_demo_digest_test();
     return 0;
 }
@@ -0,0 +1,229 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <stdio.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default count of the random numbers
+#define TB_DEMO_DTOA_COUNT          (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the random seed
+static tb_uint64_t g_seed = 88172645463325252ULL;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_uint64_t tb_demo_dtoa_random()
+{
+    // xorshift64
+    g_seed ^= g_seed << 13;
+    g_seed ^= g_seed >> 7;
+    g_seed ^= g_seed << 17;
+    return g_seed;
+}
+static tb_double_t tb_demo_dtoa_make(tb_size_t i)
+{
+    // make the random double with the random exponent, the small exponent or the subnormal number
+    tb_uint64_t bits = tb_demo_dtoa_random();
+    switch (i & 3)
+    {
+    case 1:
+        bits = (bits & 0x800fffffffffffffULL) | ((tb_uint64_t)(1023 + (tb_long_t)(tb_demo_dtoa_random() % 64) - 32) << 52);
+        break;
+    case 2:
+        bits &= 0x800fffffffffffffULL;
+        break;
+    case 3:
+        bits = (tb_uint64_t)(tb_long_t)(tb_demo_dtoa_random() % 2000000 - 1000000);
+        break;
+    default:
+        break;
+    }
+
+    // make double, we only use the finite number
+    tb_double_t value = 0;
+    if ((i & 3) == 3) value = (tb_double_t)(tb_long_t)bits / 100;
+    else tb_memcpy_(&value, &bits, sizeof(value));
+    return (tb_isnan(value) || tb_isinf(value))? 0 : value;
+}
+static tb_bool_t tb_demo_dtoa_equal(tb_double_t a, tb_double_t b)
+{
+    return !tb_memcmp(&a, &b, sizeof(tb_double_t));
+}
+static tb_void_t tb_demo_dtoa_check_cases()
+{
+    // the hard cases of the string to double
+    static tb_char_t const* s_cases[] =
+    {
+        "0.1"
+    ,   "-2.5e3"
+    ,   "1e23"
+    ,   ".5"
+    ,   "9007199254740993"
+    ,   "2.2250738585072011e-308"
+    ,   "2.2250738585072012e-308"
+    ,   "4.9e-324"
+    ,   "2.4703282292062327e-324"
+    ,   "2.4703282292062328e-324"
+    ,   "1.7976931348623157e308"
+    ,   "1.7976931348623159e308"
+    ,   "0.1000000000000000055511151231257827021181583404541015625"
+    ,   "123456789012345678901234567890e-20"
+    ,   "0.000000000000000000000000000000000000000000001e45"
+    ,   "1e-400"
+    ,   "1e400"
+    };
+    tb_size_t i = 0;
+    tb_size_t failed = 0;
+    for (i = 0; i < tb_arrayn(s_cases); i++)
+    {
+        tb_double_t value = tb_s10tod(s_cases[i]);
+        tb_double_t expected = strtod(s_cases[i], tb_null);
+        if (!tb_demo_dtoa_equal(value, expected))
+        {
+            tb_trace_e("s10tod(%s): %.17lg != %.17lg", s_cases[i], value, expected);
+            failed++;
+        }
+    }
+
+    // the shortest strings
+    static tb_double_t s_values[] = {0.1, 1.0, -1500.25, 1e21, 1.5e-7, 5e-324, 1.7976931348623157e308, 1.0 / 3};
+    for (i = 0; i < tb_arrayn(s_values); i++)
+    {
+        tb_char_t data[64];
+        tb_dtoa(s_values[i], data, sizeof(data));
+        tb_trace_i("dtoa(%.17lg): %s", s_values[i], data);
+    }
+    tb_trace_i("cases: %s", failed? "failed" : "ok");
+}
+static tb_void_t tb_demo_dtoa_check_roundtrip(tb_size_t count)
+{
+    tb_size_t i = 0;
+    tb_size_t failed = 0;
+    tb_size_t longer = 0;
+    tb_char_t data[64];
+    tb_char_t digits[32];
+    for (i = 0; i < count; i++)
+    {
+        // double => string => double
+        tb_double_t value = tb_demo_dtoa_make(i);
+        tb_dtoa(value, data, sizeof(data));
+        if (!tb_demo_dtoa_equal(tb_s10tod(data), value) || !tb_demo_dtoa_equal(strtod(data, tb_null), value))
+        {
+            if (failed++ < 10) tb_trace_e("dtoa: %.17lg => %s", value, data);
+        }
+
+        // is the shortest? compare it with the shortest precision of the libc
+        tb_long_t exp = 0;
+        tb_size_t n = tb_dtoa_digits(value, digits, sizeof(digits), &exp);
+        tb_int_t  p = 1;
+        for (p = 1; p < 17; p++)
+        {
+            snprintf(data, sizeof(data), "%.*g", p, value);
+            if (strtod(data, tb_null) == value) break;
+        }
+        if ((tb_int_t)n > p) longer++;
+
+        // the string with the random precision => double
+        snprintf(data, sizeof(data), "%.*e", (tb_int_t)(tb_demo_dtoa_random() % 25), value);
+        if (!tb_demo_dtoa_equal(tb_s10tod(data), strtod(data, tb_null)))
+        {
+            if (failed++ < 10) tb_trace_e("s10tod: %s => %.17lg", data, tb_s10tod(data));
+        }
+
+        // float => string => float
+        tb_uint32_t bits = (tb_uint32_t)tb_demo_dtoa_random();
+        tb_float_t  fvalue = 0;
+        tb_memcpy_(&fvalue, &bits, sizeof(fvalue));
+        if (!tb_isnanf(fvalue) && !tb_isinff(fvalue))
+        {
+            tb_ftoa(fvalue, data, sizeof(data));
+            if (strtof(data, tb_null) != fvalue)
+            {
+                if (failed++ < 10) tb_trace_e("ftoa: %.9g => %s", fvalue, data);
+            }
+        }
+    }
+    tb_trace_i("roundtrip: %lu numbers, not shortest: %lu, %s", count, longer, failed? "failed" : "ok");
+}
+static tb_void_t tb_demo_dtoa_benchmark(tb_size_t count)
+{
+    // make the numbers and strings
+    tb_size_t       i = 0;
+    tb_double_t*    values = tb_nalloc_type(count, tb_double_t);
+    tb_char_t*      strings = (tb_char_t*)tb_malloc(count * 32);
+    tb_assert_and_check_return(values && strings);
+    for (i = 0; i < count; i++) values[i] = tb_demo_dtoa_make(i);
+
+    // tb_dtoa
+    tb_char_t   data[512];
+    tb_size_t   size = 0;
+    tb_hong_t   time = tb_mclock();
+    for (i = 0; i < count; i++) size += tb_dtoa(values[i], strings + i * 32, 32);
+    time = tb_mclock() - time;
+    tb_trace_i("dtoa:   tb_dtoa: %lld ms, %lu bytes", time, size);
+
+    // snprintf(%.17g)
+    size = 0;
+    time = tb_mclock();
+    for (i = 0; i < count; i++) size += snprintf(data, sizeof(data), "%.17g", values[i]);
+    time = tb_mclock() - time;
+    tb_trace_i("dtoa:   libc snprintf(%%.17g): %lld ms, %lu bytes", time, size);
+
+    // tb_snprintf(%lf)
+    size = 0;
+    time = tb_mclock();
+    for (i = 0; i < count; i++) size += tb_snprintf(data, sizeof(data), "%lf", values[i]);
+    time = tb_mclock() - time;
+    tb_trace_i("dtoa:   tb_snprintf(%%lf): %lld ms, %lu bytes", time, size);
+
+    // snprintf(%f)
+    size = 0;
+    time = tb_mclock();
+    for (i = 0; i < count; i++) size += snprintf(data, sizeof(data), "%f", values[i]);
+    time = tb_mclock() - time;
+    tb_trace_i("dtoa:   libc snprintf(%%f): %lld ms, %lu bytes", time, size);
+
+    // tb_s10tod
+    tb_double_t sum = 0;
+    time = tb_mclock();
+    for (i = 0; i < count; i++) sum += tb_s10tod(strings + i * 32);
+    time = tb_mclock() - time;
+    tb_trace_i("strtod: tb_s10tod: %lld ms, sum: %lg", time, sum);
+
+    // strtod
+    sum = 0;
+    time = tb_mclock();
+    for (i = 0; i < count; i++) sum += strtod(strings + i * 32, tb_null);
+    time = tb_mclock() - time;
+    tb_trace_i("strtod: libc strtod: %lld ms, sum: %lg", time, sum);
+
+    // exit data
+    tb_free(values);
+    tb_free(strings);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_libc_dtoa_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the numbers count
+    tb_size_t count = argc > 1 && argv[1]? tb_atoi(argv[1]) : TB_DEMO_DTOA_COUNT;
+
+    // check the hard cases and the round-trip
+    tb_demo_dtoa_check_cases();
+    tb_demo_dtoa_check_roundtrip(count);
+
+    // benchmark
+    tb_demo_dtoa_benchmark(count);
+    return 0;
+}
@@ -0,0 +1,314 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <string.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default count of the fuzz rounds
+#define TB_DEMO_STRSEARCH_COUNT         (100000)
+
+// the max data size
+#define TB_DEMO_STRSEARCH_MAXN          (8192)
+
+// check the result with the reference result
+#define tb_demo_strsearch_check(name, call, ref) \
+    real = tb_demo_strsearch_offset(s, call); \
+    expected = tb_demo_strsearch_offset(s, ref); \
+    if (real != expected) tb_demo_strsearch_fail(name, s, n, real, expected);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the random seed
+static tb_uint64_t g_seed = 88172645463325252ULL;
+
+// the alphabet, few letters with both cases make many partial matches
+static tb_char_t const g_alphabet[] = "aAbBcC-_\xe1 ";
+
+// the failed count
+static tb_size_t g_failed = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t tb_demo_strsearch_random(tb_size_t n)
+{
+    // xorshift64
+    g_seed ^= g_seed << 13;
+    g_seed ^= g_seed >> 7;
+    g_seed ^= g_seed << 17;
+    return n? (tb_size_t)(g_seed % n) : 0;
+}
+static tb_size_t tb_demo_strsearch_size(tb_size_t maxn)
+{
+    // most sizes are small, but we also need to cover the vector loops
+    tb_size_t n = 0;
+    switch (tb_demo_strsearch_random(4))
+    {
+    case 0: n = tb_demo_strsearch_random(17); break;
+    case 1: n = tb_demo_strsearch_random(80); break;
+    case 2: n = tb_demo_strsearch_random(300); break;
+    default: n = tb_demo_strsearch_random(maxn); break;
+    }
+    return tb_min(n, maxn);
+}
+static tb_void_t tb_demo_strsearch_fail(tb_char_t const* name, tb_char_t const* s, tb_size_t n, tb_long_t real, tb_long_t expected)
+{
+    if (g_failed++ < 10) tb_trace_e("%s: size: %lu, %ld != %ld, data: %.*s", name, n, real, expected, (tb_int_t)tb_min(n, 64), s);
+}
+static tb_long_t tb_demo_strsearch_offset(tb_char_t const* s, tb_char_t const* p)
+{
+    return p? (tb_long_t)(p - s) : -1;
+}
+static tb_bool_t tb_demo_strsearch_equal(tb_char_t const* s1, tb_char_t const* s2, tb_size_t n, tb_bool_t icase)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_byte_t a = (tb_byte_t)s1[i];
+        tb_byte_t b = (tb_byte_t)s2[i];
+        if (a != b && (!icase || tb_tolower(a) != tb_tolower(b))) return tb_false;
+    }
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the reference implementation, the plain scalar loops
+ */
+static tb_size_t tb_demo_ref_strnlen(tb_char_t const* s, tb_size_t n)
+{
+    tb_size_t i = 0;
+    while (i < n && s[i]) i++;
+    return i;
+}
+static tb_char_t const* tb_demo_ref_strnchr(tb_char_t const* s, tb_size_t n, tb_char_t c, tb_bool_t icase, tb_bool_t reverse)
+{
+    tb_size_t           i = 0;
+    tb_char_t const*    p = tb_null;
+    n = tb_demo_ref_strnlen(s, n);
+    for (i = 0; i < n; i++)
+    {
+        if (tb_demo_strsearch_equal(s + i, &c, 1, icase))
+        {
+            if (!reverse) return s + i;
+            p = s + i;
+        }
+    }
+    return p;
+}
+static tb_char_t const* tb_demo_ref_memmem(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2, tb_bool_t icase, tb_bool_t reverse)
+{
+    tb_size_t           i = 0;
+    tb_char_t const*    p = tb_null;
+    if (!n2) return reverse? s1 + n1 : s1;
+    for (i = 0; i + n2 <= n1; i++)
+    {
+        if (tb_demo_strsearch_equal(s1 + i, s2, n2, icase))
+        {
+            if (!reverse) return s1 + i;
+            p = s1 + i;
+        }
+    }
+    return p;
+}
+static tb_char_t const* tb_demo_ref_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_bool_t icase, tb_bool_t reverse)
+{
+    return tb_demo_ref_memmem(s1, tb_demo_ref_strnlen(s1, n1), s2, tb_demo_ref_strnlen(s2, -1), icase, reverse);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * fuzz
+ */
+static tb_void_t tb_demo_strsearch_check_chr(tb_char_t* s, tb_size_t n)
+{
+    // the character, it may be not in the data
+    tb_char_t c = g_alphabet[tb_demo_strsearch_random(sizeof(g_alphabet) - 1)];
+    if (!tb_demo_strsearch_random(8)) c = 'z';
+    tb_size_t k = tb_demo_strsearch_random(n + 1);
+
+    // check memchr
+    tb_long_t real = tb_demo_strsearch_offset(s, (tb_char_t const*)tb_memchr(s, (tb_byte_t)c, n));
+    tb_long_t expected = tb_demo_strsearch_offset(s, (tb_char_t const*)memchr(s, c, n));
+    if (real != expected) tb_demo_strsearch_fail("memchr", s, n, real, expected);
+
+    // make the c-string with the random length
+    tb_char_t saved = s[k];
+    s[k] = '\0';
+
+    // check strlen and strnlen
+    real = tb_strlen(s);
+    if (real != (tb_long_t)k) tb_demo_strsearch_fail("strlen", s, n, real, k);
+    real = tb_strnlen(s, n);
+    expected = tb_demo_ref_strnlen(s, n);
+    if (real != expected) tb_demo_strsearch_fail("strnlen", s, n, real, expected);
+
+    // check strchr, strichr, strrchr and strirchr
+    tb_demo_strsearch_check("strchr", tb_strchr(s, c), tb_demo_ref_strnchr(s, -1, c, tb_false, tb_false));
+    tb_demo_strsearch_check("strichr", tb_strichr(s, c), tb_demo_ref_strnchr(s, -1, c, tb_true, tb_false));
+    tb_demo_strsearch_check("strrchr", tb_strrchr(s, c), tb_demo_ref_strnchr(s, -1, c, tb_false, tb_true));
+    tb_demo_strsearch_check("strirchr", tb_strirchr(s, c), tb_demo_ref_strnchr(s, -1, c, tb_true, tb_true));
+
+    // check strnchr, strnichr, strnrchr and strnirchr, the string may be terminated before or after the size
+    tb_size_t m = tb_demo_strsearch_random(n + 1);
+    tb_demo_strsearch_check("strnchr", tb_strnchr(s, m, c), tb_demo_ref_strnchr(s, m, c, tb_false, tb_false));
+    tb_demo_strsearch_check("strnichr", tb_strnichr(s, m, c), tb_demo_ref_strnchr(s, m, c, tb_true, tb_false));
+    tb_demo_strsearch_check("strnrchr", tb_strnrchr(s, m, c), tb_demo_ref_strnchr(s, m, c, tb_false, tb_true));
+    tb_demo_strsearch_check("strnirchr", tb_strnirchr(s, m, c), tb_demo_ref_strnchr(s, m, c, tb_true, tb_true));
+
+    // restore the data
+    s[k] = saved;
+}
+static tb_void_t tb_demo_strsearch_check_str(tb_char_t* s, tb_size_t n)
+{
+    // make the pattern from the data with the random case or the random pattern
+    tb_char_t   p[128];
+    tb_size_t   i = 0;
+    tb_size_t   m = tb_demo_strsearch_size(sizeof(p) - 1);
+    tb_size_t   o = tb_demo_strsearch_random(n + 1);
+    if (o + m <= n && tb_demo_strsearch_random(4))
+    {
+        for (i = 0; i < m; i++)
+        {
+            p[i] = s[o + i];
+            if (tb_isalpha((tb_byte_t)p[i]) && !tb_demo_strsearch_random(4)) p[i] ^= 0x20;
+        }
+    }
+    else
+    {
+        m = tb_demo_strsearch_random(8);
+        for (i = 0; i < m; i++) p[i] = g_alphabet[tb_demo_strsearch_random(sizeof(g_alphabet) - 1)];
+    }
+    p[m] = '\0';
+
+    // check memmem, the data and the pattern are nul-free
+    tb_long_t real = tb_demo_strsearch_offset(s, (tb_char_t const*)tb_memmem(s, n, p, m));
+    tb_long_t expected = tb_demo_strsearch_offset(s, tb_demo_ref_memmem(s, n, p, m, tb_false, tb_false));
+    if (real != expected) tb_demo_strsearch_fail("memmem", s, n, real, expected);
+
+    // make the c-string with the random length
+    tb_size_t k = tb_demo_strsearch_random(n + 1);
+    tb_char_t saved = s[k];
+    s[k] = '\0';
+
+    // check strstr, stristr, strrstr and strirstr
+    tb_demo_strsearch_check("strstr", tb_strstr(s, p), tb_demo_ref_strnstr(s, -1, p, tb_false, tb_false));
+    tb_demo_strsearch_check("stristr", tb_stristr(s, p), tb_demo_ref_strnstr(s, -1, p, tb_true, tb_false));
+    tb_demo_strsearch_check("strrstr", tb_strrstr(s, p), tb_demo_ref_strnstr(s, -1, p, tb_false, tb_true));
+    tb_demo_strsearch_check("strirstr", tb_strirstr(s, p), tb_demo_ref_strnstr(s, -1, p, tb_true, tb_true));
+
+    // check strnstr, strnistr, strnrstr and strnirstr, the string may be terminated before or after the size
+    tb_size_t l = tb_demo_strsearch_random(n) + 1;
+    tb_demo_strsearch_check("strnstr", tb_strnstr(s, l, p), tb_demo_ref_strnstr(s, l, p, tb_false, tb_false));
+    tb_demo_strsearch_check("strnistr", tb_strnistr(s, l, p), tb_demo_ref_strnstr(s, l, p, tb_true, tb_false));
+    tb_demo_strsearch_check("strnrstr", tb_strnrstr(s, l, p), tb_demo_ref_strnstr(s, l, p, tb_false, tb_true));
+    tb_demo_strsearch_check("strnirstr", tb_strnirstr(s, l, p), tb_demo_ref_strnstr(s, l, p, tb_true, tb_true));
+
+    // restore the data
+    s[k] = saved;
+}
+static tb_void_t tb_demo_strsearch_fuzz(tb_size_t count)
+{
+    // init data, the data is placed at the end of the buffer to check the overflow
+    tb_char_t* data = (tb_char_t*)tb_malloc(TB_DEMO_STRSEARCH_MAXN + 1);
+    tb_assert_and_check_return(data);
+
+    // fuzz it
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // make the nul-free data with the random size and alignment
+        tb_size_t   j = 0;
+        tb_size_t   n = tb_demo_strsearch_size(TB_DEMO_STRSEARCH_MAXN);
+        tb_char_t*  s = data + TB_DEMO_STRSEARCH_MAXN - n;
+        for (j = 0; j < n; j++) s[j] = g_alphabet[tb_demo_strsearch_random(sizeof(g_alphabet) - 1)];
+        s[n] = '\0';
+
+        // check them
+        tb_demo_strsearch_check_chr(s, n);
+        tb_demo_strsearch_check_str(s, n);
+    }
+    tb_trace_i("fuzz: %lu rounds, %s", count, g_failed? "failed" : "ok");
+
+    // exit data
+    tb_free(data);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * benchmark
+ */
+static tb_void_t tb_demo_strsearch_benchmark(tb_size_t size)
+{
+    // make the text data without the pattern, the pattern is appended to the end
+    tb_size_t   i = 0;
+    tb_char_t*  s = (tb_char_t*)tb_malloc(size + 1);
+    tb_assert_and_check_return(s);
+    for (i = 0; i < size; i++) s[i] = "abcdefghijklmnopqrstuvwxyz ,.\r\n"[tb_demo_strsearch_random(31)];
+    tb_memcpy(s + size - 16, "Content-Length: ", 16);
+    s[size] = '\0';
+
+    // the count of the rounds, about 256MB
+    tb_size_t   count = tb_max((256 << 20) / size, 1);
+    tb_char_t const* p = "content-length: ";
+    tb_size_t   sum = 0;
+    tb_hong_t   t = 0;
+
+    // reload the data from the volatile pointer, the compiler cannot hoist the pure libc calls out of the loop
+    tb_char_t* __tb_volatile__  data = s;
+
+#define tb_demo_strsearch_bench(name, call) \
+    sum = 0; \
+    t = tb_uclock(); \
+    for (i = 0; i < count; i++) { s = data; sum += (tb_size_t)(call); } \
+    t = tb_uclock() - t; \
+    tb_trace_i("[%6lu]: %-24s %8lld us, %5lld MB/s, %lx", size, name, t, t > 0? (tb_hong_t)size * count / t : 0, sum);
+
+    tb_demo_strsearch_bench("tb_memchr", tb_memchr(s, '#', size));
+    tb_demo_strsearch_bench("libc memchr", memchr(s, '#', size));
+    tb_demo_strsearch_bench("tb_strnchr", tb_strnchr(s, size, '#'));
+    tb_demo_strsearch_bench("tb_strichr", tb_strichr(s, '#'));
+    tb_demo_strsearch_bench("ref strichr", tb_demo_ref_strnchr(s, size, '#', tb_true, tb_false));
+    tb_demo_strsearch_bench("tb_strnrchr", tb_strnrchr(s, size, '#'));
+    tb_demo_strsearch_bench("tb_strstr", tb_strstr(s, p));
+    tb_demo_strsearch_bench("tb_strnstr", tb_strnstr(s, size, p));
+    tb_demo_strsearch_bench("libc strstr", strstr(s, p));
+    tb_demo_strsearch_bench("ref strstr", tb_demo_ref_strnstr(s, size, p, tb_false, tb_false));
+    tb_demo_strsearch_bench("tb_stristr", tb_stristr(s, p));
+    tb_demo_strsearch_bench("tb_strnistr", tb_strnistr(s, size, p));
+#ifdef TB_CONFIG_LIBC_HAVE_STRCASESTR
+    tb_demo_strsearch_bench("libc strcasestr", strcasestr(s, p));
+#endif
+    tb_demo_strsearch_bench("ref stristr", tb_demo_ref_strnstr(s, size, p, tb_true, tb_false));
+    tb_demo_strsearch_bench("tb_strnirstr", tb_strnirstr(s, size, "Content-Length: "));
+    tb_demo_strsearch_bench("tb_memmem", tb_memmem(s, size, "Content-Length: ", 16));
+#ifdef TB_CONFIG_LIBC_HAVE_MEMMEM
+    tb_demo_strsearch_bench("libc memmem", memmem(s, size, "Content-Length: ", 16));
+#endif
+
+#undef tb_demo_strsearch_bench
+
+    // exit data
+    tb_free(data);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_libc_strsearch_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the fuzz rounds
+    tb_size_t count = argc > 1 && argv[1]? tb_atoi(argv[1]) : TB_DEMO_STRSEARCH_COUNT;
+
+    // fuzz the search functions against the scalar loops
+    tb_demo_strsearch_fuzz(count);
+
+    // benchmark
+    tb_demo_strsearch_benchmark(64);
+    tb_demo_strsearch_benchmark(1024);
+    tb_demo_strsearch_benchmark(64 * 1024);
+    return 0;
+}
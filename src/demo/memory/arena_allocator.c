@@ -0,0 +1,212 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the test count
+#define TB_DEMO_ARENA_TEST_COUNT    (2000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * demo
+ */
+static tb_void_t tb_demo_arena_allocator_base()
+{
+    // done
+    tb_allocator_ref_t arena_allocator = tb_null;
+    do
+    {
+        // init arena allocator
+        arena_allocator = tb_arena_allocator_init(tb_null, 4096);
+        tb_assert_and_check_break(arena_allocator);
+
+        // make data
+        tb_char_t* data0 = (tb_char_t*)tb_allocator_malloc(arena_allocator, 10);
+        tb_char_t* data1 = (tb_char_t*)tb_allocator_malloc(arena_allocator, 20);
+        tb_assert_and_check_break(data0 && data1);
+        tb_strlcpy(data0, "hello", 10);
+        tb_strlcpy(data1, "world", 20);
+
+        // grow the last data in place
+        tb_char_t* data2 = (tb_char_t*)tb_allocator_ralloc(arena_allocator, data1, 100);
+        tb_assert_and_check_break(data2 && data2 == data1 && !tb_strcmp(data2, "world"));
+
+        // grow the middle data
+        tb_char_t* data3 = (tb_char_t*)tb_allocator_ralloc(arena_allocator, data0, 200);
+        tb_assert_and_check_break(data3 && data3 != data0 && !tb_strcmp(data3, "hello"));
+
+        // free the last data
+        tb_size_t size = tb_arena_allocator_size(arena_allocator);
+        tb_allocator_free(arena_allocator, data3);
+        tb_assert_and_check_break(tb_arena_allocator_size(arena_allocator) < size);
+
+        // save it
+        tb_arena_allocator_savepoint_t savepoint;
+        tb_arena_allocator_save(arena_allocator, &savepoint);
+        size = tb_arena_allocator_size(arena_allocator);
+
+        // make a lot of data across the chunks
+        tb_size_t i = 0;
+        for (i = 0; i < 1000; i++)
+        {
+            tb_pointer_t data = tb_allocator_malloc(arena_allocator, (i & 255) + 1);
+            tb_assert_and_check_break(data);
+        }
+        tb_assert_and_check_break(i == 1000);
+
+        // make a large data
+        tb_pointer_t large = tb_allocator_malloc(arena_allocator, 100000);
+        tb_assert_and_check_break(large);
+
+#ifdef __tb_debug__
+        // dump arena allocator
+        tb_allocator_dump(arena_allocator);
+#endif
+
+        // rewind it
+        tb_arena_allocator_rewind(arena_allocator, &savepoint);
+        tb_assert_and_check_break(tb_arena_allocator_size(arena_allocator) == size);
+        tb_assert_and_check_break(!tb_strcmp(data2, "world"));
+
+        // free the last data before the savepoint, it cannot be reclaimed across the savepoint
+        tb_pointer_t last = tb_allocator_malloc(arena_allocator, 64);
+        tb_assert_and_check_break(last);
+        tb_arena_allocator_save(arena_allocator, &savepoint);
+        size = tb_arena_allocator_size(arena_allocator);
+        tb_allocator_free(arena_allocator, last);
+        tb_arena_allocator_rewind(arena_allocator, &savepoint);
+        tb_assert_and_check_break(tb_arena_allocator_size(arena_allocator) == size);
+
+        // rewind it after resetting, the savepoint chunk may be reused with the less used size
+        tb_arena_allocator_reset(arena_allocator);
+        last = tb_allocator_malloc(arena_allocator, 16);
+        tb_assert_and_check_break(last);
+        size = tb_arena_allocator_size(arena_allocator);
+        tb_arena_allocator_rewind(arena_allocator, &savepoint);
+        tb_assert_and_check_break(tb_arena_allocator_size(arena_allocator) <= size);
+
+        // reset it
+        tb_arena_allocator_reset(arena_allocator);
+        tb_assert_and_check_break(!tb_arena_allocator_size(arena_allocator));
+
+        // trace
+        tb_trace_i("base: ok");
+
+    } while (0);
+
+    // exit arena allocator
+    if (arena_allocator) tb_allocator_exit(arena_allocator);
+    arena_allocator = tb_null;
+}
+static tb_size_t tb_demo_arena_allocator_vector(tb_size_t count)
+{
+    // init vector
+    tb_size_t       size = 0;
+    tb_vector_ref_t vector = tb_vector_init(0, tb_element_str(tb_true));
+    if (vector)
+    {
+        // insert strings
+        tb_size_t i = 0;
+        tb_char_t s[64];
+        for (i = 0; i < count; i++)
+        {
+            tb_snprintf(s, sizeof(s), "string: %lu", i);
+            tb_vector_insert_tail(vector, s);
+        }
+        size = tb_vector_size(vector);
+
+        // exit vector
+        tb_vector_exit(vector);
+    }
+    return size;
+}
+#ifdef TB_CONFIG_MODULE_HAVE_OBJECT
+static tb_bool_t tb_demo_arena_allocator_json(tb_char_t const* json, tb_size_t size, tb_bool_t exit)
+{
+    // read object
+    tb_object_ref_t object = tb_object_read_from_data((tb_byte_t const*)json, size);
+    tb_check_return_val(object, tb_false);
+
+    // exit object, we need not exit it for the arena allocator
+    if (exit) tb_object_exit(object);
+    return tb_true;
+}
+#endif
+static tb_void_t tb_demo_arena_allocator_perf()
+{
+#ifdef TB_CONFIG_MODULE_HAVE_OBJECT
+    // make json
+    tb_char_t json[8192];
+    tb_size_t size = 0;
+    tb_size_t i = 0;
+    size += tb_snprintf(json + size, sizeof(json) - size, "{\"items\":[");
+    for (i = 0; i < 64 && size + 128 < sizeof(json); i++)
+        size += tb_snprintf(json + size, sizeof(json) - size, "%s{\"id\":%lu,\"name\":\"item%lu\",\"tags\":[\"a\",\"b\"]}", i? "," : "", i, i);
+    size += tb_snprintf(json + size, sizeof(json) - size, "]}");
+#endif
+
+    // done
+    tb_allocator_ref_t arena_allocator = tb_null;
+    do
+    {
+        // init arena allocator
+        arena_allocator = tb_arena_allocator_init(tb_null, 0);
+        tb_assert_and_check_break(arena_allocator);
+
+        // using the global allocator
+        tb_size_t n = 0;
+        tb_hong_t t = tb_mclock();
+        for (n = 0; n < TB_DEMO_ARENA_TEST_COUNT; n++)
+        {
+            tb_demo_arena_allocator_vector(100);
+#ifdef TB_CONFIG_MODULE_HAVE_OBJECT
+            tb_demo_arena_allocator_json(json, size, tb_true);
+#endif
+        }
+        t = tb_mclock() - t;
+        tb_trace_i("global: %lld ms", t);
+
+        // using the arena allocator
+        t = tb_mclock();
+        for (n = 0; n < TB_DEMO_ARENA_TEST_COUNT; n++)
+        {
+            // enter it
+            tb_allocator_ref_t previous = tb_allocator_scope_enter(arena_allocator);
+
+            // parse and discard all data at once
+            tb_demo_arena_allocator_vector(100);
+#ifdef TB_CONFIG_MODULE_HAVE_OBJECT
+            tb_demo_arena_allocator_json(json, size, tb_false);
+#endif
+
+            // leave it
+            tb_allocator_scope_leave(previous);
+            tb_arena_allocator_reset(arena_allocator);
+        }
+        t = tb_mclock() - t;
+        tb_trace_i("arena: %lld ms", t);
+
+#ifdef __tb_debug__
+        // dump arena allocator
+        tb_allocator_dump(arena_allocator);
+#endif
+
+    } while (0);
+
+    // exit arena allocator
+    if (arena_allocator) tb_allocator_exit(arena_allocator);
+    arena_allocator = tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_arena_allocator_main(tb_int_t argc, tb_char_t** argv)
+{
+    tb_demo_arena_allocator_base();
+    tb_demo_arena_allocator_perf();
+    return 0;
+}
@@ -214,11 +214,124 @@ tb_void_t tb_demo_default_allocator_perf()
     large_allocator = tb_null;
 }
 
+// the threads perf context
+typedef struct __tb_demo_default_allocator_threads_t
+{
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
+    // the exchanged data, it will be freed by the other thread
+    tb_atomic_t             exchanged;
+
+}tb_demo_default_allocator_threads_t;
+
+static tb_int_t tb_demo_default_allocator_threads_worker(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_default_allocator_threads_t* threads = (tb_demo_default_allocator_threads_t*)priv;
+    tb_assert_and_check_return_val(threads && threads->allocator, -1);
+
+    // done
+    tb_size_t           i = 0;
+    tb_size_t           j = 0;
+    tb_size_t           rand = (tb_size_t)tb_thread_self();
+    tb_pointer_t        list[64];
+    tb_allocator_ref_t  allocator = threads->allocator;
+    for (i = 0; i < 100000; i++)
+    {
+        // make a batch of small data
+        for (j = 0; j < tb_arrayn(list); j++)
+        {
+            rand = (rand * 10807 + 1) & 0xffffffff;
+            list[j] = tb_allocator_malloc(allocator, (rand & 511) + 1);
+        }
+
+        // exchange one data with the other threads and free the previous one
+        tb_pointer_t data = (tb_pointer_t)tb_atomic_fetch_and_set(&threads->exchanged, (tb_long_t)list[0]);
+        if (data) tb_allocator_free(allocator, data);
+
+        // free the others
+        for (j = 1; j < tb_arrayn(list); j++)
+            tb_allocator_free(allocator, list[j]);
+    }
+    return 0;
+}
+tb_void_t tb_demo_default_allocator_threads(tb_size_t mode, tb_size_t count);
+tb_void_t tb_demo_default_allocator_threads(tb_size_t mode, tb_size_t count)
+{
+    // done
+    tb_size_t               i = 0;
+    tb_thread_ref_t         workers[16] = {0};
+    tb_allocator_ref_t      allocator = tb_null;
+    tb_allocator_ref_t      large_allocator = tb_null;
+    do
+    {
+        // init large allocator
+        large_allocator = tb_large_allocator_init(tb_null, 0);
+        tb_assert_and_check_break(large_allocator);
+
+        // init allocator
+        allocator = tb_default_allocator_init_with_mode(large_allocator, mode);
+        tb_assert_and_check_break(allocator);
+
+        // start workers
+        tb_demo_default_allocator_threads_t threads;
+        threads.allocator = allocator;
+        threads.exchanged = 0;
+        count = tb_min(count, tb_arrayn(workers));
+        tb_hong_t time = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            workers[i] = tb_thread_init(tb_null, tb_demo_default_allocator_threads_worker, &threads, 0);
+            tb_assert_and_check_break(workers[i]);
+        }
+
+        // wait workers
+        for (i = 0; i < count; i++)
+        {
+            if (workers[i])
+            {
+                tb_thread_wait(workers[i], -1, tb_null);
+                tb_thread_exit(workers[i]);
+            }
+        }
+        time = tb_mclock() - time;
+
+        // free the last exchanged data
+        if (threads.exchanged) tb_allocator_free(allocator, (tb_pointer_t)threads.exchanged);
+
+#ifdef __tb_debug__
+        // dump allocator
+        tb_allocator_dump(allocator);
+#endif
+
+        // trace
+        tb_trace_i("%s: %lu threads, time: %lld ms", mode == TB_DEFAULT_ALLOCATOR_MODE_TCACHE? "tcache" : "normal", count, time);
+
+    } while (0);
+
+    // exit allocator
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+
+    // exit large allocator
+    if (large_allocator) tb_allocator_exit(large_allocator);
+    large_allocator = tb_null;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
 tb_int_t tb_demo_memory_default_allocator_main(tb_int_t argc, tb_char_t** argv)
 {
+    // multi-threads perf, e.g. demo memory_default_allocator tcache 4
+    if (argc > 1)
+    {
+        tb_size_t mode = !tb_strcmp(argv[1], "tcache")? TB_DEFAULT_ALLOCATOR_MODE_TCACHE : TB_DEFAULT_ALLOCATOR_MODE_NORMAL;
+        tb_demo_default_allocator_threads(mode, argc > 2? tb_atoi(argv[2]) : 4);
+        return 0;
+    }
+
 #if 1
     tb_demo_default_allocator_perf();
 #endif
@@ -0,0 +1,158 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <string.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max size
+#define TB_DEMO_MEMOPS_MAXN         (64 << 20)
+
+#ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the memops entry type
+typedef struct __tb_demo_memops_entry_t
+{
+    // the name
+    tb_char_t const*        name;
+
+    // the tbox operation
+    tb_long_t               (*tbox)(tb_byte_t* d, tb_byte_t const* s, tb_size_t n);
+
+    // the libc operation
+    tb_long_t               (*libc)(tb_byte_t* d, tb_byte_t const* s, tb_size_t n);
+
+}tb_demo_memops_entry_t, *tb_demo_memops_entry_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * wrapers
+ */
+static tb_long_t tb_demo_tbox_memcpy(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    return (tb_long_t)tb_memcpy_simd(d, s, n);
+}
+static tb_long_t tb_demo_libc_memcpy(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    return (tb_long_t)memcpy(d, s, n);
+}
+static tb_long_t tb_demo_tbox_memmov(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // move it backward with overlap
+    return (tb_long_t)tb_memmov_simd(d + 64, d, n);
+}
+static tb_long_t tb_demo_libc_memmov(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    return (tb_long_t)memmove(d + 64, d, n);
+}
+static tb_long_t tb_demo_tbox_memset(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    return (tb_long_t)tb_memset_simd(d, 0xbe, n);
+}
+static tb_long_t tb_demo_libc_memset(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    return (tb_long_t)memset(d, 0xbe, n);
+}
+static tb_long_t tb_demo_tbox_memcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // compare the equal data, the source data is never changed
+    return tb_memcmp_simd(s + 64, s, n);
+}
+static tb_long_t tb_demo_libc_memcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    return memcmp(s + 64, s, n);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+static tb_demo_memops_entry_t g_memops_entries[] =
+{
+    { "memcpy",     tb_demo_tbox_memcpy,    tb_demo_libc_memcpy }
+,   { "memmov",     tb_demo_tbox_memmov,    tb_demo_libc_memmov }
+,   { "memset",     tb_demo_tbox_memset,    tb_demo_libc_memset }
+,   { "memcmp",     tb_demo_tbox_memcmp,    tb_demo_libc_memcmp }
+,   { tb_null,      tb_null,                tb_null             }
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_hong_t tb_demo_memops_test(tb_long_t (*func)(tb_byte_t* d, tb_byte_t const* s, tb_size_t n), tb_byte_t* d, tb_byte_t const* s, tb_size_t n, tb_size_t count)
+{
+    // get the best time (ps) of the 3 rounds
+    tb_hong_t best = -1;
+    tb_size_t i = 0;
+    tb_size_t r = 0;
+    __tb_volatile__ tb_long_t v = 0;
+    for (r = 0; r < 3; r++)
+    {
+        tb_hong_t t = tb_uclock();
+        for (i = 0; i < count; i++) v += func(d + (i & 7), s + (i & 3), n);
+        t = tb_uclock() - t;
+        if (best < 0 || t < best) best = t;
+    }
+    return best * 1000000 / count;
+}
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_memops_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+    // the max size
+    tb_size_t maxn = argc > 1 && argv[1]? tb_atoi(argv[1]) : TB_DEMO_MEMOPS_MAXN;
+
+    // init data
+    tb_byte_t* d = tb_malloc_bytes(maxn + 128);
+    tb_byte_t* s = tb_malloc_bytes(maxn + 128);
+    if (d && s)
+    {
+        tb_memset_(d, 0x5a, maxn + 128);
+        tb_memset_(s, 0x5a, maxn + 128);
+
+        /* the builtin simd implementation of tbox
+         *
+         * tb_memcpy() and the others use libc if the memops of libc have been detected,
+         * so we call the builtin ones directly for comparing them
+         */
+        tb_trace_i("tbox: simd, cpu features: %lx", tb_cpu_features());
+
+        // sweep the sizes
+        tb_demo_memops_entry_ref_t entry = g_memops_entries;
+        for (; entry && entry->name; entry++)
+        {
+            tb_size_t n = 1;
+            for (n = 1; n <= maxn; n <<= 1)
+            {
+                // about 64MB for the large size and 4M calls for the small size
+                tb_size_t count = tb_max(tb_min((tb_size_t)TB_DEMO_MEMOPS_MAXN / n, 1 << 22), 4);
+                tb_size_t size = n > 8? n - (n >> 3) + 1 : n;
+                tb_hong_t t1 = tb_demo_memops_test(entry->tbox, d, s, size, count);
+                tb_hong_t t2 = tb_demo_memops_test(entry->libc, d, s, size, count);
+
+                // trace
+                tb_trace_i("[%s]: %10lu: tbox: %8lld.%02lld ns, %6lld MB/s, libc: %8lld.%02lld ns, %6lld MB/s, %3lld%%", entry->name, size
+                    , t1 / 1000, (t1 % 1000) / 10, t1 > 0? (tb_hong_t)size * 1000000 / t1 : 0
+                    , t2 / 1000, (t2 % 1000) / 10, t2 > 0? (tb_hong_t)size * 1000000 / t2 : 0, t1 > 0? t2 * 100 / t1 : 0);
+            }
+            tb_trace_i("");
+        }
+    }
+
+    // exit data
+    if (d) tb_free(d);
+    if (s) tb_free(s);
+#else
+    tb_trace_i("the builtin simd memops are not supported on this platform");
+#endif
+    return 0;
+}
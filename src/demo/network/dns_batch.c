@@ -0,0 +1,381 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the stub server count
+#define TB_DEMO_STUBS           (2)
+
+// the coroutine count
+#define TB_DEMO_COROUTINES      (2)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo stub type
+typedef struct __tb_demo_stub_t
+{
+    // the socket
+    tb_socket_ref_t     sock;
+
+    // the thread
+    tb_thread_ref_t     thread;
+
+    // the query count
+    tb_atomic32_t       queries;
+
+}tb_demo_stub_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the stub servers
+static tb_demo_stub_t   g_stubs[TB_DEMO_STUBS];
+
+// is stopped?
+static tb_atomic32_t    g_stop = 0;
+
+// the lost names, the first query of them will be dropped
+static tb_hash_set_ref_t g_lost = tb_null;
+static tb_spinlock_t    g_lost_lock = TB_SPINLOCK_INIT;
+
+// the name count
+static tb_size_t        g_count = 10000;
+
+// the result count
+static tb_size_t        g_results[3];
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * stub
+ */
+static tb_size_t tb_demo_stub_answer(tb_byte_t* data, tb_size_t size, tb_size_t maxn)
+{
+    // check
+    tb_check_return_val(size > TB_DNS_HEADER_SIZE + 4 && maxn >= size + 64, 0);
+
+    // get the question name
+    tb_char_t           name[TB_DNS_NAME_MAXN];
+    tb_char_t*          q = name;
+    tb_byte_t const*    p = data + TB_DNS_HEADER_SIZE;
+    tb_byte_t const*    e = data + size - 4;
+    while (p < e && *p && q + *p + 1 < name + sizeof(name))
+    {
+        tb_size_t n = *p++;
+        if (q > name) *q++ = '.';
+        while (n-- && p < e) *q++ = *p++;
+    }
+    *q = '\0';
+    tb_check_return_val(p + 1 == e && !*p, 0);
+    tb_uint16_t type = tb_bits_get_u16_be(e);
+
+    // drop the first query of the lost name
+    if (!tb_strncmp(name, "lost", 4))
+    {
+        tb_bool_t drop = tb_false;
+        tb_spinlock_enter(&g_lost_lock);
+        if (!tb_hash_set_get(g_lost, name))
+        {
+            tb_hash_set_insert(g_lost, name);
+            drop = tb_true;
+        }
+        tb_spinlock_leave(&g_lost_lock);
+        tb_check_return_val(!drop, 0);
+    }
+
+    // make response header, keep id and question
+    tb_bool_t   nx = !tb_strncmp(name, "nx", 2);
+    tb_size_t   rsize = type == 28? 16 : 4;
+    tb_byte_t*  w = data + size;
+    data[2] = 0x81;
+    data[3] = nx? 0x83 : 0x80;
+    data[6] = 0; data[7] = nx? 0 : 1;
+    data[8] = 0; data[9] = nx? 1 : 0;
+    data[10] = 0; data[11] = 0;
+    if (!nx)
+    {
+        // answer: name(ptr) + type + class(in) + ttl + size + address, the address is the hash of the name
+        tb_size_t hash = tb_bkdr_make_from_cstr(name, 0);
+        *w++ = 0xc0; *w++ = TB_DNS_HEADER_SIZE;
+        tb_bits_set_u16_be(w, type); w += 2;
+        *w++ = 0; *w++ = 1;
+        *w++ = 0; *w++ = 0; *w++ = 0; *w++ = 60;
+        *w++ = 0; *w++ = (tb_byte_t)rsize;
+        tb_memset(w, 0, rsize);
+        w[0] = type == 28? 0xfd : 10;
+        tb_bits_set_u16_be(w + rsize - 2, (tb_uint16_t)hash);
+        w += rsize;
+    }
+    else
+    {
+        // authority: name(ptr) + type(soa) + class(in) + ttl + size + mname + rname + serial + refresh + retry + expire + minimum
+        *w++ = 0xc0; *w++ = TB_DNS_HEADER_SIZE;
+        *w++ = 0; *w++ = 6;
+        *w++ = 0; *w++ = 1;
+        *w++ = 0; *w++ = 0; *w++ = 0; *w++ = 60;
+        *w++ = 0; *w++ = 22;
+        *w++ = 0;
+        *w++ = 0;
+        tb_memset(w, 0, 16); w += 16;
+        *w++ = 0; *w++ = 0; *w++ = 0; *w++ = 30;
+    }
+    return w - data;
+}
+static tb_int_t tb_demo_stub_loop(tb_cpointer_t priv)
+{
+    tb_demo_stub_t* stub = (tb_demo_stub_t*)priv;
+    tb_byte_t       data[TB_DNS_RPKT_MAXN];
+    tb_ipaddr_t     addr;
+    while (!tb_atomic32_get(&g_stop))
+    {
+        // recv query
+        tb_long_t real = tb_socket_urecv(stub->sock, &addr, data, 512);
+        if (real > 0)
+        {
+            // send answer
+            tb_atomic32_fetch_and_add(&stub->queries, 1);
+            tb_size_t size = tb_demo_stub_answer(data, real, sizeof(data));
+            if (size) tb_socket_usend(stub->sock, &addr, data, size);
+        }
+        else if (!real)
+        {
+            // wait it
+            if (tb_socket_wait(stub->sock, TB_SOCKET_EVENT_RECV, 100) < 0) break;
+        }
+        else break;
+    }
+    return 0;
+}
+static tb_bool_t tb_demo_stub_init(tb_noarg_t)
+{
+    // init the lost names
+    g_lost = tb_hash_set_init(0, tb_element_str(tb_true));
+    tb_assert_and_check_return_val(g_lost, tb_false);
+
+    // init the stub servers
+    tb_size_t i = 0;
+    tb_dns_server_exit();
+    for (i = 0; i < TB_DEMO_STUBS; i++)
+    {
+        // init socket
+        tb_ipaddr_t addr;
+        tb_demo_stub_t* stub = &g_stubs[i];
+        tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+        stub->sock = tb_socket_init(TB_SOCKET_TYPE_UDP, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_return_val(stub->sock, tb_false);
+        if (!tb_socket_bind(stub->sock, &addr) || !tb_socket_local(stub->sock, &addr)) return tb_false;
+
+        // init thread
+        stub->thread = tb_thread_init(tb_null, tb_demo_stub_loop, stub, 0);
+        tb_assert_and_check_return_val(stub->thread, tb_false);
+
+        // use the stub server only
+        tb_char_t server[64];
+        tb_snprintf(server, sizeof(server), "127.0.0.1:%u", tb_ipaddr_port(&addr));
+        tb_dns_server_add(server);
+        tb_trace_i("server: %s", server);
+    }
+    tb_dns_server_sort();
+    return tb_true;
+}
+static tb_void_t tb_demo_stub_exit(tb_noarg_t)
+{
+    tb_size_t i = 0;
+    tb_atomic32_set(&g_stop, 1);
+    for (i = 0; i < TB_DEMO_STUBS; i++)
+    {
+        tb_demo_stub_t* stub = &g_stubs[i];
+        if (stub->thread)
+        {
+            tb_thread_wait(stub->thread, -1, tb_null);
+            tb_thread_exit(stub->thread);
+        }
+        stub->thread = tb_null;
+        if (stub->sock) tb_socket_exit(stub->sock);
+        stub->sock = tb_null;
+    }
+    if (g_lost) tb_hash_set_exit(g_lost);
+    g_lost = tb_null;
+}
+static tb_size_t tb_demo_stub_queries(tb_noarg_t)
+{
+    tb_size_t i = 0;
+    tb_size_t n = 0;
+    for (i = 0; i < TB_DEMO_STUBS; i++) n += tb_atomic32_get(&g_stubs[i].queries);
+    return n;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_batch_func(tb_dns_batch_ref_t batch, tb_dns_batch_result_ref_t result, tb_cpointer_t priv)
+{
+    // save state
+    if (result->state < tb_arrayn(g_results)) g_results[result->state]++;
+
+    // trace
+    if (result->priv) tb_trace_i("result: %s => %{ipaddr}, %{ipaddr}, state: %lu, ttl: %u", result->name, &result->ipv4, &result->ipv6, result->state, result->ttl);
+}
+static tb_void_t tb_demo_batch_post(tb_dns_batch_ref_t batch, tb_char_t const* prefix, tb_size_t from, tb_size_t count)
+{
+    tb_size_t i = 0;
+    tb_char_t name[64];
+    for (i = from; i < from + count; i++)
+    {
+        tb_snprintf(name, sizeof(name), "%s%lu.batch.test", prefix, i);
+        tb_dns_batch_post(batch, name, tb_null);
+    }
+}
+static tb_void_t tb_demo_trace(tb_char_t const* tag, tb_size_t count, tb_size_t queries, tb_hong_t time)
+{
+    tb_trace_i("%s: %lu names, %lu queries, %lld ms, %lld names/s, ok: %lu, notfound: %lu, failed: %lu"
+        , tag, count, tb_demo_stub_queries() - queries, time, time? (tb_hong_t)count * 1000 / time : 0
+        , g_results[TB_DNS_BATCH_STATE_OK], g_results[TB_DNS_BATCH_STATE_NOTFOUND], g_results[TB_DNS_BATCH_STATE_FAILED]);
+    tb_memset(g_results, 0, sizeof(g_results));
+}
+static tb_void_t tb_demo_test_states(tb_noarg_t)
+{
+    tb_dns_batch_ref_t batch = tb_dns_batch_init(TB_IPADDR_FAMILY_NONE, tb_demo_batch_func, tb_null);
+    if (batch)
+    {
+        // the first query of the lost name will be dropped and retransmitted to the next server
+        tb_hong_t time = tb_mclock();
+        tb_dns_batch_post(batch, "www.batch.test", (tb_cpointer_t)1);
+        tb_dns_batch_post(batch, "nx.batch.test", (tb_cpointer_t)1);
+        tb_dns_batch_post(batch, "lost.batch.test", (tb_cpointer_t)1);
+        tb_dns_batch_post(batch, "localhost", (tb_cpointer_t)1);
+        tb_dns_batch_post(batch, "10.0.0.1", (tb_cpointer_t)1);
+        tb_dns_batch_done(batch);
+        tb_demo_trace("states", 5, 0, tb_mclock() - time);
+        tb_dns_batch_exit(batch);
+    }
+}
+static tb_void_t tb_demo_test_looker(tb_noarg_t)
+{
+    // look names one by one
+    tb_size_t   i = 0;
+    tb_size_t   n = tb_min(g_count, 1000);
+    tb_size_t   queries = tb_demo_stub_queries();
+    tb_char_t   name[64];
+    tb_ipaddr_t addr;
+    tb_hong_t   time = tb_mclock();
+    for (i = 0; i < n; i++)
+    {
+        tb_snprintf(name, sizeof(name), "looker%lu.batch.test", i);
+        g_results[tb_dns_looker_done(name, &addr)? TB_DNS_BATCH_STATE_OK : TB_DNS_BATCH_STATE_FAILED]++;
+    }
+    tb_demo_trace("looker", n, queries, tb_mclock() - time);
+}
+static tb_void_t tb_demo_test_batch(tb_noarg_t)
+{
+    tb_dns_batch_ref_t batch = tb_dns_batch_init(TB_IPADDR_FAMILY_NONE, tb_demo_batch_func, tb_null);
+    if (batch)
+    {
+        tb_size_t queries = tb_demo_stub_queries();
+        tb_hong_t time = tb_mclock();
+        tb_demo_batch_post(batch, "batch", 0, g_count);
+        tb_dns_batch_done(batch);
+        tb_demo_trace("batch(A+AAAA)", g_count, queries, tb_mclock() - time);
+        tb_dns_batch_exit(batch);
+    }
+}
+static tb_void_t tb_demo_poller_event(tb_poller_ref_t poller, tb_poller_object_ref_t object, tb_long_t events, tb_cpointer_t priv)
+{
+    tb_dns_batch_spak((tb_dns_batch_ref_t)priv);
+}
+static tb_void_t tb_demo_test_poller(tb_noarg_t)
+{
+    tb_poller_ref_t     poller = tb_null;
+    tb_dns_batch_ref_t  batch = tb_null;
+    do
+    {
+        // init poller and batch
+        poller = tb_poller_init(tb_null);
+        tb_assert_and_check_break(poller);
+        batch = tb_dns_batch_init(TB_IPADDR_FAMILY_IPV4, tb_demo_batch_func, tb_null);
+        tb_assert_and_check_break(batch);
+
+        // post names and send them
+        tb_size_t queries = tb_demo_stub_queries();
+        tb_hong_t time = tb_mclock();
+        tb_demo_batch_post(batch, "poller", 0, g_count);
+        if (tb_dns_batch_spak(batch) < 0) break;
+
+        // wait the responses in poller, and spak it for retransmission if timeout
+        if (!tb_poller_insert_sock(poller, tb_dns_batch_sock(batch), TB_POLLER_EVENT_RECV, batch)) break;
+        while (tb_dns_batch_size(batch))
+        {
+            if (tb_poller_wait(poller, tb_demo_poller_event, tb_dns_batch_timeout(batch)) < 0) break;
+            if (tb_dns_batch_spak(batch) < 0) break;
+        }
+        tb_poller_remove_sock(poller, tb_dns_batch_sock(batch));
+        tb_demo_trace("poller(A)", g_count, queries, tb_mclock() - time);
+
+    } while (0);
+
+    // exit batch and poller
+    if (batch) tb_dns_batch_exit(batch);
+    if (poller) tb_poller_exit(poller);
+}
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+static tb_void_t tb_demo_coroutine_func(tb_cpointer_t priv)
+{
+    // every coroutine looks a part of names with its batch, the waiting will be switched to other coroutines
+    tb_size_t           n = g_count / TB_DEMO_COROUTINES;
+    tb_dns_batch_ref_t  batch = tb_dns_batch_init(TB_IPADDR_FAMILY_NONE, tb_demo_batch_func, tb_null);
+    if (batch)
+    {
+        tb_demo_batch_post(batch, "coroutine", (tb_size_t)priv * n, n);
+        tb_dns_batch_done(batch);
+        tb_dns_batch_exit(batch);
+    }
+}
+static tb_void_t tb_demo_test_coroutine(tb_noarg_t)
+{
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        tb_size_t i = 0;
+        tb_size_t queries = tb_demo_stub_queries();
+        tb_hong_t time = tb_mclock();
+        for (i = 0; i < TB_DEMO_COROUTINES; i++)
+            tb_coroutine_start(scheduler, tb_demo_coroutine_func, (tb_cpointer_t)i, 0);
+        tb_co_scheduler_loop(scheduler, tb_true);
+        tb_demo_trace("coroutine(A+AAAA)", g_count / TB_DEMO_COROUTINES * TB_DEMO_COROUTINES, queries, tb_mclock() - time);
+        tb_co_scheduler_exit(scheduler);
+    }
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_dns_batch_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the name count
+    if (argc > 1 && argv[1]) g_count = tb_atoi(argv[1]);
+
+    // init the stub servers
+    if (tb_demo_stub_init())
+    {
+        // test the result states
+        tb_demo_test_states();
+
+        // test looker, batch, poller and coroutine
+        tb_demo_test_looker();
+        tb_demo_test_batch();
+        tb_demo_test_poller();
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+        tb_demo_test_coroutine();
+#endif
+    }
+
+    // exit the stub servers
+    tb_demo_stub_exit();
+    return 0;
+}
@@ -0,0 +1,260 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the ttl (s) of the stub answers
+#define TB_DEMO_TTL             (2)
+
+// the negative ttl (s) of the stub answers
+#define TB_DEMO_NEGATIVE_TTL    (1)
+
+// the benchmark thread count
+#define TB_DEMO_THREADS         (4)
+
+// the benchmark name count
+#define TB_DEMO_NAMES           (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the stub socket
+static tb_socket_ref_t  g_sock = tb_null;
+
+// is stopped?
+static tb_atomic32_t    g_stop = 0;
+
+// the query count of the stub
+static tb_atomic32_t    g_queries = 0;
+
+// the benchmark count
+static tb_size_t        g_count = 1000000;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * stub
+ */
+static tb_size_t tb_demo_stub_answer(tb_byte_t* data, tb_size_t size, tb_size_t maxn)
+{
+    // check
+    tb_check_return_val(size > TB_DNS_HEADER_SIZE + 4 && maxn >= size + 64, 0);
+
+    // get the first label of the question name
+    tb_byte_t const*    p = data + TB_DNS_HEADER_SIZE;
+    tb_byte_t const*    e = data + size - 4;
+    tb_bool_t           nx = p[0] >= 2 && p[1] == 'n' && p[2] == 'x';
+    while (p < e && *p) p += *p + 1;
+    tb_check_return_val(p + 1 == e && !*p, 0);
+
+    // the ip of the answer, it changes for every query
+    tb_size_t           n = (tb_size_t)tb_atomic32_fetch_and_add(&g_queries, 1) + 1;
+
+    // make response header, keep id and question
+    tb_byte_t*          q = data + size;
+    data[2] = 0x81;
+    data[3] = nx? 0x83 : 0x80;
+    data[6] = 0; data[7] = nx? 0 : 1;
+    data[8] = 0; data[9] = nx? 1 : 0;
+    data[10] = 0; data[11] = 0;
+    if (!nx)
+    {
+        // answer: name(ptr) + type(a) + class(in) + ttl + size + ipv4
+        *q++ = 0xc0; *q++ = TB_DNS_HEADER_SIZE;
+        *q++ = 0; *q++ = 1;
+        *q++ = 0; *q++ = 1;
+        *q++ = 0; *q++ = 0; *q++ = 0; *q++ = TB_DEMO_TTL;
+        *q++ = 0; *q++ = 4;
+        *q++ = 10; *q++ = 0; *q++ = (tb_byte_t)(n >> 8); *q++ = (tb_byte_t)n;
+    }
+    else
+    {
+        // authority: name(ptr) + type(soa) + class(in) + ttl + size + mname + rname + serial + refresh + retry + expire + minimum
+        *q++ = 0xc0; *q++ = TB_DNS_HEADER_SIZE;
+        *q++ = 0; *q++ = 6;
+        *q++ = 0; *q++ = 1;
+        *q++ = 0; *q++ = 0; *q++ = 0; *q++ = 60;
+        *q++ = 0; *q++ = 22;
+        *q++ = 0;
+        *q++ = 0;
+        tb_memset(q, 0, 16); q += 16;
+        *q++ = 0; *q++ = 0; *q++ = 0; *q++ = TB_DEMO_NEGATIVE_TTL;
+    }
+    return q - data;
+}
+static tb_int_t tb_demo_stub_loop(tb_cpointer_t priv)
+{
+    tb_byte_t   data[TB_DNS_RPKT_MAXN];
+    tb_ipaddr_t addr;
+    while (!tb_atomic32_get(&g_stop))
+    {
+        // recv query
+        tb_long_t real = tb_socket_urecv(g_sock, &addr, data, 512);
+        if (real > 0)
+        {
+            // send answer
+            tb_size_t size = tb_demo_stub_answer(data, real, sizeof(data));
+            if (size) tb_socket_usend(g_sock, &addr, data, size);
+        }
+        else if (!real)
+        {
+            // wait it
+            if (tb_socket_wait(g_sock, TB_SOCKET_EVENT_RECV, 100) < 0) break;
+        }
+        else break;
+    }
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_lookup(tb_char_t const* name)
+{
+    tb_ipaddr_t addr;
+    tb_size_t   queries = tb_atomic32_get(&g_queries);
+    tb_hong_t   time = tb_mclock();
+    tb_bool_t   ok = tb_dns_looker_done(name, &addr);
+    time = tb_mclock() - time;
+    if (ok) tb_trace_i("lookup: %s => %{ipaddr}, %lld ms, queries: +%lu", name, &addr, time, tb_atomic32_get(&g_queries) - queries);
+    else tb_trace_i("lookup: %s failed, %lld ms, queries: +%lu", name, time, tb_atomic32_get(&g_queries) - queries);
+}
+static tb_void_t tb_demo_stat(tb_char_t const* tag)
+{
+    tb_dns_cache_stat_t stat;
+    tb_dns_cache_stat(&stat);
+    tb_trace_i("stat: %s: size: %lu, hits: %llu, misses: %llu, stale: %llu, negative: %llu, refresh: %llu, evicted: %llu, queries: %lu"
+        , tag, stat.size, stat.hits, stat.misses, stat.stale, stat.negative, stat.refresh, stat.evicted, tb_atomic32_get(&g_queries));
+}
+static tb_int_t tb_demo_bench_loop(tb_cpointer_t priv)
+{
+    // look the cached names
+    tb_size_t   i = 0;
+    tb_size_t   n = g_count / TB_DEMO_THREADS;
+    tb_size_t   ok = 0;
+    tb_size_t   seed = (tb_size_t)priv;
+    tb_char_t   name[64];
+    tb_ipaddr_t addr;
+    for (i = 0; i < n; i++)
+    {
+        tb_snprintf(name, sizeof(name), "host%lu.bench.test", (i * 7 + seed) % TB_DEMO_NAMES);
+        if (tb_dns_cache_look(name, &addr) > 0) ok++;
+    }
+    return ok == n? 0 : -1;
+}
+static tb_void_t tb_demo_bench(tb_noarg_t)
+{
+    // save names
+    tb_size_t   i = 0;
+    tb_char_t   name[64];
+    tb_ipaddr_t addr;
+    for (i = 0; i < TB_DEMO_NAMES; i++)
+    {
+        tb_snprintf(name, sizeof(name), "host%lu.bench.test", i);
+        tb_ipaddr_ip_cstr_set(&addr, "10.1.0.1", TB_IPADDR_FAMILY_IPV4);
+        tb_dns_cache_save(name, &addr, 3600);
+    }
+
+    // look them concurrently
+    tb_thread_ref_t threads[TB_DEMO_THREADS];
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < TB_DEMO_THREADS; i++)
+        threads[i] = tb_thread_init(tb_null, tb_demo_bench_loop, (tb_cpointer_t)i, 0);
+    tb_size_t failed = 0;
+    for (i = 0; i < TB_DEMO_THREADS; i++)
+    {
+        tb_int_t retval = -1;
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, &retval);
+            tb_thread_exit(threads[i]);
+        }
+        if (retval) failed++;
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("bench: %lu looks, %lu threads, %lld ms, failed: %lu", g_count, (tb_size_t)TB_DEMO_THREADS, time, failed);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_dns_cache_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the benchmark count
+    if (argc > 1 && argv[1]) g_count = tb_atoi(argv[1]);
+
+    // done
+    tb_thread_ref_t thread = tb_null;
+    do
+    {
+        // init the stub server
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+        g_sock = tb_socket_init(TB_SOCKET_TYPE_UDP, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_break(g_sock);
+        if (!tb_socket_bind(g_sock, &addr) || !tb_socket_local(g_sock, &addr)) break;
+        thread = tb_thread_init(tb_null, tb_demo_stub_loop, tb_null, 0);
+        tb_assert_and_check_break(thread);
+
+        // use the stub server only
+        tb_char_t server[64];
+        tb_snprintf(server, sizeof(server), "127.0.0.1:%u", tb_ipaddr_port(&addr));
+        tb_trace_i("server: %s", server);
+        tb_dns_server_exit();
+        tb_dns_server_add(server);
+        tb_dns_server_sort();
+        tb_dns_cache_clear();
+
+        // miss and hit, the name is case-insensitive
+        tb_demo_lookup("www.tboox.test");
+        tb_demo_lookup("www.tboox.test");
+        tb_demo_lookup("WWW.TBOOX.test.");
+        tb_demo_stat("hit");
+
+        // the negative cache
+        tb_demo_lookup("nx.tboox.test");
+        tb_demo_lookup("nx.tboox.test");
+        tb_demo_stat("negative");
+
+        // the expired name will be served and refreshed in background
+        tb_msleep(TB_DEMO_TTL * 1000 + 100);
+        tb_demo_lookup("www.tboox.test");
+        tb_msleep(100);
+        tb_demo_lookup("www.tboox.test");
+        tb_demo_stat("stale");
+
+        // the hot name will be prefetched before expiring
+        tb_demo_lookup("hot.tboox.test");
+        tb_demo_lookup("hot.tboox.test");
+        tb_msleep(TB_DEMO_TTL * 1000 - 150);
+        tb_demo_lookup("hot.tboox.test");
+        tb_msleep(200);
+        tb_demo_lookup("hot.tboox.test");
+        tb_demo_stat("prefetch");
+
+        // the negative cache is expired
+        tb_demo_lookup("nx.tboox.test");
+        tb_demo_stat("expired");
+
+        // the concurrent looks
+        tb_demo_bench();
+        tb_demo_stat("bench");
+
+    } while (0);
+
+    // exit the stub server
+    tb_atomic32_set(&g_stop, 1);
+    if (thread)
+    {
+        tb_thread_wait(thread, -1, tb_null);
+        tb_thread_exit(thread);
+    }
+    if (g_sock) tb_socket_exit(g_sock);
+    g_sock = tb_null;
+    return 0;
+}
@@ -67,6 +67,14 @@ tb_int_t tb_demo_network_http_main(tb_int_t argc, tb_char_t** argv)
         t = tb_mclock() - t;
         tb_trace_i("open: %llu ms", t);
 
+        // dump the response heads
+        tb_size_t               i = 0;
+        tb_size_t               heads_count = 0;
+        tb_http_head_t const*   heads = tb_http_response_heads(http, &heads_count);
+        for (i = 0; i < heads_count; i++)
+            tb_trace_i("response: %s(%lu): %s", heads[i].name, heads[i].id, heads[i].value);
+        tb_trace_i("response: content-type: %s", tb_http_response_head(http, "content-type"));
+
         // read data
         tb_byte_t       data[8192];
         tb_size_t       read = 0;
@@ -0,0 +1,217 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default record count
+#define TB_DEMO_JSON_RECORD_COUNT       (100000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_demo_json_make(tb_char_t const* path, tb_size_t count)
+{
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_file(path, TB_FILE_MODE_WO | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+    tb_assert_and_check_return_val(stream, tb_false);
+
+    // make the records
+    tb_bool_t ok = tb_false;
+    if (tb_stream_open(stream))
+    {
+        tb_size_t i = 0;
+        tb_stream_printf(stream, "{\n    \"name\": \"benchmark\",\n    \"records\": [\n");
+        for (i = 0; i < count; i++)
+        {
+            tb_stream_printf(stream, "        %s{\"id\": %lu, \"offset\": -%lu, \"price\": %lu.%02lu, \"ok\": %s, \"none\": null"
+                , i? "," : "", i, i * 7, i % 1000, i % 100, (i & 1)? "true" : "false");
+            tb_stream_printf(stream, ", \"name\": \"record %lu\", \"tags\": [\"alpha\", \"beta\", \"gamma\"]", i);
+            tb_stream_printf(stream, ", \"text\": \"The quick brown fox jumps over the lazy dog, \\\"%lu\\\"\\n caf\xc3\xa9 \\u4e2d\\u6587 \xe4\xb8\xad\xe6\x96\x87\"}\n", i);
+        }
+        tb_stream_printf(stream, "    ]\n}\n");
+        ok = tb_stream_sync(stream, tb_true);
+    }
+
+    // exit stream
+    tb_stream_exit(stream);
+    return ok;
+}
+static tb_bool_t tb_demo_json_equal(tb_object_ref_t a, tb_object_ref_t b)
+{
+    // check
+    tb_check_return_val(a && b && tb_object_type(a) == tb_object_type(b), tb_false);
+
+    // compare them
+    switch (tb_object_type(a))
+    {
+    case TB_OBJECT_TYPE_ARRAY:
+        {
+            tb_size_t i = 0;
+            tb_size_t n = tb_oc_array_size(a);
+            tb_check_return_val(n == tb_oc_array_size(b), tb_false);
+            for (i = 0; i < n; i++)
+            {
+                if (!tb_demo_json_equal(tb_oc_array_item(a, i), tb_oc_array_item(b, i)))
+                    return tb_false;
+            }
+        }
+        break;
+    case TB_OBJECT_TYPE_DICTIONARY:
+        {
+            tb_check_return_val(tb_oc_dictionary_size(a) == tb_oc_dictionary_size(b), tb_false);
+            tb_for_all (tb_oc_dictionary_item_t*, item, tb_oc_dictionary_itor(a))
+            {
+                if (!item || !tb_demo_json_equal(item->val, tb_oc_dictionary_value(b, item->key)))
+                    return tb_false;
+            }
+        }
+        break;
+    case TB_OBJECT_TYPE_STRING:
+        return !tb_strcmp(tb_oc_string_cstr(a), tb_oc_string_cstr(b));
+    case TB_OBJECT_TYPE_NUMBER:
+        tb_check_return_val(tb_oc_number_type(a) == tb_oc_number_type(b), tb_false);
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+        if (tb_oc_number_type(a) == TB_OC_NUMBER_TYPE_FLOAT || tb_oc_number_type(a) == TB_OC_NUMBER_TYPE_DOUBLE)
+            return tb_oc_number_double(a) == tb_oc_number_double(b);
+#endif
+        return tb_oc_number_sint64(a) == tb_oc_number_sint64(b);
+    case TB_OBJECT_TYPE_BOOLEAN:
+        return tb_oc_boolean_bool(a) == tb_oc_boolean_bool(b);
+    default:
+        break;
+    }
+    return tb_true;
+}
+static tb_object_ref_t tb_demo_json_read(tb_char_t const* name, tb_char_t const* path, tb_bool_t fast)
+{
+    // read it
+    tb_object_json_fast_enable(fast);
+    tb_hong_t       time = tb_mclock();
+    tb_object_ref_t object = tb_object_read_from_url(path);
+    time = tb_mclock() - time;
+    tb_object_json_fast_enable(tb_true);
+
+    // trace
+    tb_hong_t       size = 0;
+    tb_file_info_t  info;
+    if (tb_file_info(path, &info)) size = (tb_hong_t)info.size;
+    tb_trace_i("%s: %lld ms, %lld MB/s, %s", name, time, time? ((size * 1000 / time) >> 20) : 0, object? "ok" : "failed");
+    return object;
+}
+static tb_object_ref_t tb_demo_json_document(tb_char_t const* path, tb_object_ref_t object)
+{
+    // parse the document
+    tb_hong_t               time = tb_mclock();
+    tb_json_document_ref_t  document = tb_json_document_init_from_url(path);
+    time = tb_mclock() - time;
+    tb_trace_i("document: %lld ms, %s", time, document? "ok" : "failed");
+    tb_check_return_val(document, tb_null);
+
+    // seek some fields of the middle record
+    tb_char_t   seek[64];
+    tb_char_t   name[64];
+    tb_size_t   count = tb_json_document_size(document, tb_json_document_seek(document, tb_json_document_root(document), ".records"));
+    tb_snprintf(seek, sizeof(seek), ".records[%lu]", count >> 1);
+    time = tb_mclock();
+    tb_size_t   record = tb_json_document_seek(document, tb_json_document_root(document), seek);
+    tb_sint64_t id = tb_json_document_sint64(document, tb_json_document_value(document, record, "id"));
+    tb_long_t   size = tb_json_document_string(document, tb_json_document_value(document, record, "name"), name, sizeof(name));
+    time = tb_mclock() - time;
+    tb_trace_i("document: seek %s: %lld ms, id: %lld, name: %s", seek, time, id, size >= 0? name : "");
+
+    // check the object of the middle record
+    tb_object_ref_t item = tb_json_document_object(document, record);
+    tb_trace_i("document: record: %s", tb_demo_json_equal(item, tb_object_seek(object, seek, tb_false))? "ok" : "no");
+    if (item) tb_object_exit(item);
+
+    // make the whole object tree
+    time = tb_mclock();
+    tb_object_ref_t root = tb_json_document_object(document, tb_json_document_root(document));
+    time = tb_mclock() - time;
+    tb_trace_i("document: object: %lld ms, %s", time, root? "ok" : "failed");
+
+    // exit document
+    tb_json_document_exit(document);
+    return root;
+}
+
+static tb_void_t tb_demo_json_reader(tb_char_t const* path)
+{
+    // init reader
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    tb_assert_and_check_return(reader);
+
+    // read all ids by the pull reader
+    tb_hong_t   time = tb_mclock();
+    tb_size_t   count = 0;
+    tb_sint64_t total = 0;
+    if (tb_json_reader_open(reader, tb_stream_init_from_url(path), tb_true))
+    {
+        tb_size_t event = TB_JSON_READER_EVENT_NONE;
+        while ((event = tb_json_reader_next(reader)))
+        {
+            if (event == TB_JSON_READER_EVENT_KEY && !tb_strcmp(tb_json_reader_string(reader), "id"))
+            {
+                if (tb_json_reader_next(reader) == TB_JSON_READER_EVENT_NUMBER)
+                {
+                    total += tb_json_reader_sint64(reader);
+                    count++;
+                }
+            }
+        }
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("reader: %lld ms, ids: %lu, sum: %lld, %s", time, count, total, tb_json_reader_error(reader)? "failed" : "ok");
+
+    // exit reader
+    tb_json_reader_exit(reader);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_object_json_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the json file
+    tb_char_t path[TB_PATH_MAXN] = {0};
+    tb_bool_t temp = tb_false;
+    if (argc > 1 && argv[1]) tb_strlcpy(path, argv[1], sizeof(path));
+    else
+    {
+        // make a temporary json file
+        tb_size_t n = tb_directory_temporary(path, sizeof(path));
+        tb_assert_and_check_return_val(n, -1);
+        tb_snprintf(path + n, sizeof(path) - n, "/tbox_json_benchmark.json");
+        if (!tb_demo_json_make(path, TB_DEMO_JSON_RECORD_COUNT)) return -1;
+        temp = tb_true;
+    }
+
+    // read it by the stream reader and the fast reader
+    tb_object_ref_t object1 = tb_demo_json_read("stream", path, tb_false);
+    tb_object_ref_t object2 = tb_demo_json_read("fast  ", path, tb_true);
+
+    // the same object tree?
+    tb_trace_i("equal: %s", tb_demo_json_equal(object1, object2)? "ok" : "no");
+
+    // read it by the lazy document
+    tb_object_ref_t object3 = tb_demo_json_document(path, object1);
+    tb_trace_i("equal: %s", tb_demo_json_equal(object1, object3)? "ok" : "no");
+
+    // read it by the pull reader
+    tb_demo_json_reader(path);
+
+    // exit objects
+    if (object1) tb_object_exit(object1);
+    if (object2) tb_object_exit(object2);
+    if (object3) tb_object_exit(object3);
+
+    // remove the temporary file
+    if (temp) tb_file_remove(path);
+    return 0;
+}
@@ -0,0 +1,85 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_object_json_reader_main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    tb_assert_and_check_return_val(argc > 1 && argv[1], -1);
+
+    // init reader
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_json_reader_open(reader, tb_stream_init_from_url(argv[1]), tb_true))
+        {
+            // walk
+            tb_size_t event = TB_JSON_READER_EVENT_NONE;
+            while ((event = tb_json_reader_next(reader)))
+            {
+                // the key? only print the values of this key
+                if (argv[2])
+                {
+                    if (event == TB_JSON_READER_EVENT_KEY && !tb_strcmp(tb_json_reader_string(reader), argv[2]))
+                    {
+                        event = tb_json_reader_next(reader);
+                        if (event == TB_JSON_READER_EVENT_STRING || event == TB_JSON_READER_EVENT_NUMBER)
+                            tb_printf("%s\n", tb_json_reader_string(reader));
+                        else if (event == TB_JSON_READER_EVENT_BOOLEAN)
+                            tb_printf("%s\n", tb_json_reader_bool(reader)? "true" : "false");
+                    }
+                    continue;
+                }
+
+                // print the event
+                tb_size_t t = tb_json_reader_level(reader);
+                if (event == TB_JSON_READER_EVENT_DICTIONARY_BEG || event == TB_JSON_READER_EVENT_ARRAY_BEG) t--;
+                while (t--) tb_printf("\t");
+                switch (event)
+                {
+                case TB_JSON_READER_EVENT_DICTIONARY_BEG:
+                    tb_printf("{\n");
+                    break;
+                case TB_JSON_READER_EVENT_DICTIONARY_END:
+                    tb_printf("}\n");
+                    break;
+                case TB_JSON_READER_EVENT_ARRAY_BEG:
+                    tb_printf("[\n");
+                    break;
+                case TB_JSON_READER_EVENT_ARRAY_END:
+                    tb_printf("]\n");
+                    break;
+                case TB_JSON_READER_EVENT_KEY:
+                    tb_printf("key: %s\n", tb_json_reader_string(reader));
+                    break;
+                case TB_JSON_READER_EVENT_STRING:
+                    tb_printf("string: %s\n", tb_json_reader_string(reader));
+                    break;
+                case TB_JSON_READER_EVENT_NUMBER:
+                    tb_printf("number: %s\n", tb_json_reader_string(reader));
+                    break;
+                case TB_JSON_READER_EVENT_BOOLEAN:
+                    tb_printf("boolean: %s\n", tb_json_reader_bool(reader)? "true" : "false");
+                    break;
+                case TB_JSON_READER_EVENT_NULL:
+                    tb_printf("null\n");
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // failed?
+            if (tb_json_reader_error(reader)) tb_trace_e("invalid json data!");
+        }
+
+        // exit reader
+        tb_json_reader_exit(reader);
+    }
+    return 0;
+}
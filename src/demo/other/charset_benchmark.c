@@ -0,0 +1,157 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the test data size
+#define TB_DEMO_CHARSET_DATA_SIZE       (4 << 20)
+
+// the test loop count
+#define TB_DEMO_CHARSET_LOOP_COUNT      (5)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// convert charset by the get/set interfaces of charsets, one character at a time
+static tb_long_t tb_demo_charset_conv_scalar(tb_size_t ftype, tb_size_t ttype, tb_byte_t const* idata, tb_size_t isize, tb_byte_t* odata, tb_size_t osize)
+{
+    // init charsets
+    tb_charset_ref_t fr = tb_charset_find(ftype);
+    tb_charset_ref_t to = tb_charset_find(ttype);
+    tb_assert_and_check_return_val(fr && to, -1);
+
+    // init static streams
+    tb_static_stream_t ist;
+    tb_static_stream_t ost;
+    tb_static_stream_init(&ist, (tb_byte_t*)idata, isize);
+    tb_static_stream_init(&ost, odata, osize);
+
+    // walk
+    tb_uint32_t ch;
+    tb_bool_t   fbe = !(ftype & TB_CHARSET_TYPE_LE)? tb_true : tb_false;
+    tb_bool_t   tbe = !(ttype & TB_CHARSET_TYPE_LE)? tb_true : tb_false;
+    while (tb_static_stream_left(&ist) && tb_static_stream_left(&ost))
+    {
+        tb_long_t ok = fr->get(&ist, fbe, &ch);
+        if (ok > 0)
+        {
+            if (to->set(&ost, tbe, ch) < 0) break;
+        }
+        else if (ok < 0) break;
+    }
+    return tb_static_stream_pos(&ost) - odata;
+}
+static tb_void_t tb_demo_charset_test(tb_char_t const* name, tb_size_t ftype, tb_size_t ttype, tb_byte_t const* idata, tb_size_t isize, tb_byte_t* odata, tb_byte_t* sdata, tb_size_t osize)
+{
+    // convert it by the scalar path
+    tb_size_t n = 0;
+    tb_long_t ssize = 0;
+    tb_hong_t stime = tb_mclock();
+    for (n = 0; n < TB_DEMO_CHARSET_LOOP_COUNT; n++)
+        ssize = tb_demo_charset_conv_scalar(ftype, ttype, idata, isize, sdata, osize);
+    stime = tb_mclock() - stime;
+
+    // convert it by tb_charset_conv_data
+    tb_long_t real = 0;
+    tb_hong_t time = tb_mclock();
+    for (n = 0; n < TB_DEMO_CHARSET_LOOP_COUNT; n++)
+        real = tb_charset_conv_data(ftype, ttype, idata, isize, odata, osize);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_hize_t total = (tb_hize_t)isize * TB_DEMO_CHARSET_LOOP_COUNT;
+    tb_trace_i("%s: scalar: %lld ms, %llu MB/s, conv: %lld ms, %llu MB/s, %s"
+        , name
+        , stime, stime? (total * 1000 / stime) >> 20 : 0
+        , time, time? (total * 1000 / time) >> 20 : 0
+        , (real == ssize && real > 0 && !tb_memcmp(odata, sdata, real))? "ok" : "failed");
+}
+static tb_size_t tb_demo_charset_make(tb_byte_t* data, tb_size_t size, tb_size_t rate)
+{
+    // make the mostly-ascii text with some non-ascii characters
+    static tb_char_t const* words[] = {"café", "中文", "naïve", "😀"};
+    tb_size_t n = 0;
+    while (n + 64 < size)
+    {
+        if (rate && !tb_random_range(0, rate))
+            n += tb_snprintf((tb_char_t*)data + n, size - n, "%s ", words[tb_random_range(0, tb_arrayn(words))]);
+        else
+        {
+            tb_size_t i = 0;
+            tb_size_t m = tb_random_range(1, 12);
+            for (i = 0; i < m; i++) data[n++] = (tb_byte_t)tb_random_range('a', 'z' + 1);
+            data[n] = (n & 0xff)? ' ' : '\n';
+            n++;
+        }
+    }
+    return n;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_other_charset_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init data
+    tb_size_t   osize = TB_DEMO_CHARSET_DATA_SIZE << 2;
+    tb_byte_t*  data = tb_malloc_bytes(TB_DEMO_CHARSET_DATA_SIZE);
+    tb_byte_t*  data16 = tb_malloc_bytes(osize);
+    tb_byte_t*  data32 = tb_malloc_bytes(osize);
+    tb_byte_t*  odata = tb_malloc_bytes(osize);
+    tb_byte_t*  sdata = tb_malloc_bytes(osize);
+    if (data && data16 && data32 && odata && sdata)
+    {
+        // the pure ascii text and the mostly-ascii text with 1% and 25% non-ascii words
+        tb_size_t rates[] = {0, 100, 4};
+        tb_size_t i = 0;
+        for (i = 0; i < tb_arrayn(rates); i++)
+        {
+            // make data
+            tb_size_t size = tb_demo_charset_make(data, TB_DEMO_CHARSET_DATA_SIZE, rates[i]);
+            tb_trace_i("==================================================================");
+            tb_trace_i("data: %lu bytes, non-ascii rate: %s", size, !rates[i]? "0" : (rates[i] == 100? "1%" : "25%"));
+
+            // make utf16 and utf32 data
+            tb_long_t size16 = tb_charset_conv_data(TB_CHARSET_TYPE_UTF8, TB_CHARSET_TYPE_UTF16 | TB_CHARSET_TYPE_LE, data, size, data16, osize);
+            tb_long_t size32 = tb_charset_conv_data(TB_CHARSET_TYPE_UTF8, TB_CHARSET_TYPE_UTF32 | TB_CHARSET_TYPE_LE, data, size, data32, osize);
+            tb_assert_and_check_break(size16 > 0 && size32 > 0);
+
+            // test it
+            tb_demo_charset_test("utf8    => utf16le", TB_CHARSET_TYPE_UTF8, TB_CHARSET_TYPE_UTF16 | TB_CHARSET_TYPE_LE, data, size, odata, sdata, osize);
+            tb_demo_charset_test("utf8    => utf16be", TB_CHARSET_TYPE_UTF8, TB_CHARSET_TYPE_UTF16, data, size, odata, sdata, osize);
+            tb_demo_charset_test("utf8    => utf32le", TB_CHARSET_TYPE_UTF8, TB_CHARSET_TYPE_UTF32 | TB_CHARSET_TYPE_LE, data, size, odata, sdata, osize);
+            tb_demo_charset_test("utf16le => utf8   ", TB_CHARSET_TYPE_UTF16 | TB_CHARSET_TYPE_LE, TB_CHARSET_TYPE_UTF8, data16, size16, odata, sdata, osize);
+            tb_demo_charset_test("utf32le => utf8   ", TB_CHARSET_TYPE_UTF32 | TB_CHARSET_TYPE_LE, TB_CHARSET_TYPE_UTF8, data32, size32, odata, sdata, osize);
+            tb_demo_charset_test("utf32le => utf16le", TB_CHARSET_TYPE_UTF32 | TB_CHARSET_TYPE_LE, TB_CHARSET_TYPE_UTF16 | TB_CHARSET_TYPE_LE, data32, size32, odata, sdata, osize);
+
+            // check utf8
+            tb_size_t n = 0;
+            tb_bool_t ok = tb_true;
+            tb_hong_t time = tb_mclock();
+            for (n = 0; n < TB_DEMO_CHARSET_LOOP_COUNT; n++)
+                ok = ok && tb_charset_utf8_valid(data, size);
+            time = tb_mclock() - time;
+            tb_trace_i("utf8 valid        : %lld ms, %llu MB/s, %s", time, time? (((tb_hize_t)size * TB_DEMO_CHARSET_LOOP_COUNT * 1000 / time) >> 20) : 0, ok? "ok" : "failed");
+        }
+
+        // check the invalid utf8 data
+        tb_assert(!tb_charset_utf8_valid((tb_byte_t const*)"\xc0\xaf", 2));
+        tb_assert(!tb_charset_utf8_valid((tb_byte_t const*)"\xed\xa0\x80", 3));
+        tb_assert(!tb_charset_utf8_valid((tb_byte_t const*)"\xf4\x90\x80\x80", 4));
+        tb_assert(!tb_charset_utf8_valid((tb_byte_t const*)"hello\xe4\xb8", 7));
+        tb_assert(tb_charset_utf8_valid((tb_byte_t const*)"hello \xe4\xb8\xad\xf0\x9f\x98\x80", 13));
+    }
+
+    // exit data
+    if (data) tb_free(data);
+    if (data16) tb_free(data16);
+    if (data32) tb_free(data32);
+    if (odata) tb_free(odata);
+    if (sdata) tb_free(sdata);
+    return 0;
+}
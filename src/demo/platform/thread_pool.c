@@ -19,12 +19,58 @@ static tb_void_t tb_demo_task_time_exit(tb_thread_pool_worker_ref_t worker, tb_c
     // trace
     tb_trace_i("exit: %u ms", tb_p2u32(priv));
 }
+static tb_void_t tb_demo_task_count_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // count it
+    tb_atomic_fetch_and_add((tb_atomic_t*)priv, 1);
+}
+static tb_void_t tb_demo_task_fanout_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // post some sub-tasks from the worker
+    tb_size_t               i = 0;
+    tb_cpointer_t const*    args = (tb_cpointer_t const*)priv;
+    for (i = 0; i < 64; i++)
+        tb_thread_pool_task_post((tb_thread_pool_ref_t)args[0], tb_null, tb_demo_task_count_done, tb_null, args[1], tb_false);
+}
+static tb_void_t tb_demo_thread_pool_perf(tb_size_t mode)
+{
+    // init pool
+    tb_thread_pool_ref_t pool = tb_thread_pool_init_with_mode(tb_cpu_count(), 0, mode);
+    tb_assert_and_check_return(pool);
+
+    // post many small tasks from the main thread and the workers
+    tb_atomic_t count = 0;
+    tb_cpointer_t args[2] = {pool, (tb_cpointer_t)&count};
+    tb_size_t   i = 0;
+    tb_hong_t   time = tb_mclock();
+    for (i = 0; i < 100000; i++)
+        tb_thread_pool_task_post(pool, tb_null, tb_demo_task_count_done, tb_null, (tb_cpointer_t)&count, tb_false);
+    for (i = 0; i < 2000; i++)
+        tb_thread_pool_task_post(pool, tb_null, tb_demo_task_fanout_done, tb_null, args, tb_false);
+
+    // wait all
+    tb_thread_pool_task_wait_all(pool, -1);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("perf: %s: %ld tasks, %lld ms", mode == TB_THREAD_POOL_MODE_STEALING? "stealing" : "normal", tb_atomic_get(&count), time);
+
+    // exit pool
+    tb_thread_pool_exit(pool);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
 tb_int_t tb_demo_platform_thread_pool_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the throughput of many small tasks, e.g. demo platform_thread_pool stealing
+    if (argc > 1 && (!tb_strcmp(argv[1], "stealing") || !tb_strcmp(argv[1], "normal")))
+    {
+        tb_demo_thread_pool_perf(!tb_strcmp(argv[1], "stealing")? TB_THREAD_POOL_MODE_STEALING : TB_THREAD_POOL_MODE_NORMAL);
+        return 0;
+    }
+
 #if 0
     // post task: 60s
     tb_thread_pool_task_post(tb_thread_pool(), "60000ms", tb_demo_task_time_done, tb_null, (tb_cpointer_t)60000, tb_false);
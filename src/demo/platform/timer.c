@@ -20,11 +20,156 @@ static tb_void_t tb_demo_timer_task_func(tb_bool_t killed, tb_cpointer_t priv)
     }
 }
 
+static tb_void_t tb_demo_timer_count_func(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // count it
+    (*((tb_size_t*)priv))++;
+}
+static tb_void_t tb_demo_timer_check_func(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // the expected time and the max lateness
+    tb_hong_t* check = (tb_hong_t*)priv;
+
+    // expired too early?
+    tb_hong_t now = tb_mclock();
+    tb_assert(now >= check[0]);
+
+    // update the lateness
+    if (now - check[0] > check[1]) check[1] = now - check[0];
+}
+static tb_void_t tb_demo_timer_test_check(tb_size_t mode)
+{
+    // init timer
+    tb_timer_ref_t timer = tb_timer_init_with_mode(0, tb_false, mode);
+    tb_assert_and_check_return(timer);
+
+    // post tasks across the first and second levels
+    tb_size_t i = 0;
+    tb_hong_t check[64][2];
+    for (i = 0; i < tb_arrayn(check); i++)
+    {
+        tb_size_t delay = tb_random_range(0, 700);
+        check[i][0] = tb_mclock() + delay;
+        check[i][1] = 0;
+        tb_timer_task_post(timer, delay, tb_false, tb_demo_timer_check_func, check[i]);
+    }
+
+    // spak it
+    tb_hong_t time = tb_mclock();
+    while (tb_mclock() < time + 800)
+    {
+        tb_msleep(tb_min(tb_timer_delay(timer), 10));
+        tb_timer_spak(timer);
+    }
+
+    // the max lateness
+    tb_hong_t late = 0;
+    for (i = 0; i < tb_arrayn(check); i++)
+        if (check[i][1] > late) late = check[i][1];
+
+    // trace
+    tb_trace_i("check: %s: max lateness: %lld ms", mode == TB_TIMER_MODE_WHEEL? "wheel" : "heap", late);
+
+    // exit timer
+    tb_timer_exit(timer);
+}
+static tb_void_t tb_demo_timer_test_wrap(tb_size_t mode)
+{
+    // init timer
+    tb_timer_ref_t timer = tb_timer_init_with_mode(0, tb_false, mode);
+    tb_assert_and_check_return(timer);
+
+    // wait the start of a root round of the wheel, 256ms for each round
+    tb_timeval_t tv = {0};
+    while (tb_gettimeofday(&tv, tb_null) && ((tv.tv_sec * 1000 + tv.tv_usec / 1000) & 255) >= 16) tb_msleep(1);
+
+    // post a task to the higher level, it will be cascaded at the next round
+    tb_hong_t check[2][2];
+    check[0][0] = tb_mclock() + 300;
+    check[0][1] = 0;
+    tb_timer_task_post(timer, 300, tb_false, tb_demo_timer_check_func, check[0]);
+
+    // post a task to the wrapped root slot near the end of this round, it expires after the first task
+    tb_msleep(200);
+    tb_timer_spak(timer);
+    check[1][0] = tb_mclock() + 200;
+    check[1][1] = 0;
+    tb_timer_task_post(timer, 200, tb_false, tb_demo_timer_check_func, check[1]);
+
+    // the delay must not exceed the first task
+    tb_size_t delay = tb_timer_delay(timer);
+    tb_hong_t due   = check[0][0] - tb_mclock();
+    tb_assert(delay <= due + 1);
+
+    // spak it with the exact delay
+    tb_hong_t time = tb_mclock();
+    while (tb_mclock() < time + 300)
+    {
+        tb_msleep(tb_min(tb_timer_delay(timer), 300));
+        tb_timer_spak(timer);
+    }
+
+    // trace
+    tb_trace_i("wrap: %s: delay: %lu ms, due: %lld ms, lateness: %lld, %lld ms", mode == TB_TIMER_MODE_WHEEL? "wheel" : "heap", delay, due, check[0][1], check[1][1]);
+
+    // exit timer
+    tb_timer_exit(timer);
+}
+static tb_void_t tb_demo_timer_test_perf(tb_size_t mode)
+{
+    // init timer
+    tb_timer_ref_t timer = tb_timer_init_with_mode(4096, tb_true, mode);
+    tb_assert_and_check_return(timer);
+
+    // arm and cancel many timeout tasks, only few tasks will be expired
+    tb_size_t           i = 0;
+    tb_size_t           count = 0;
+    tb_timer_task_ref_t tasks[64];
+    tb_hong_t           time = tb_mclock();
+    for (i = 0; i < 1000000; i++)
+    {
+        // arm it
+        tb_size_t index = i & 63;
+        if (i >= 64) tb_timer_task_exit(timer, tasks[index]);
+        tasks[index] = tb_timer_task_init(timer, 1000 + (i % 30000), tb_false, tb_demo_timer_count_func, &count);
+
+        // keep some long-lived tasks
+        if (!(i & 1023)) tb_timer_task_post(timer, 1000 + (i % 60000), tb_false, tb_demo_timer_count_func, &count);
+
+        // spak it sometimes
+        if (!(i & 255))
+        {
+            tb_cache_time_spak();
+            tb_timer_spak(timer);
+        }
+    }
+    for (i = 0; i < 64; i++) tb_timer_task_exit(timer, tasks[i]);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("perf: %s: arm and cancel 1000000 tasks: %lld ms, expired: %lu", mode == TB_TIMER_MODE_WHEEL? "wheel" : "heap", time, count);
+
+    // exit timer
+    tb_timer_exit(timer);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
 tb_int_t tb_demo_platform_timer_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the heap and wheel mode
+    if (argc > 1 && !tb_strcmp(argv[1], "perf"))
+    {
+        tb_demo_timer_test_check(TB_TIMER_MODE_HEAP);
+        tb_demo_timer_test_check(TB_TIMER_MODE_WHEEL);
+        tb_demo_timer_test_wrap(TB_TIMER_MODE_HEAP);
+        tb_demo_timer_test_wrap(TB_TIMER_MODE_WHEEL);
+        tb_demo_timer_test_perf(TB_TIMER_MODE_HEAP);
+        tb_demo_timer_test_perf(TB_TIMER_MODE_WHEEL);
+        return 0;
+    }
+
     // add task: every
     tb_timer_task_post(tb_timer(), 1000, tb_true, tb_demo_timer_task_func, "every");
 
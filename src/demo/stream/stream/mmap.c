@@ -0,0 +1,68 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_demo_stream_mmap_test(tb_char_t const* path, tb_size_t mmap)
+{
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_file(path, TB_FILE_MODE_RO);
+    tb_assert_and_check_return_val(stream, tb_false);
+
+    // set mmap mode
+    tb_bool_t ok = tb_false;
+    if (tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_SET_MMAP, mmap) && tb_stream_open(stream))
+    {
+        // peek data and compute the checksum
+        tb_hong_t   time = tb_mclock();
+        tb_hize_t   size = 0;
+        tb_uint32_t sum = 0;
+        tb_byte_t*  data = tb_null;
+        while (1)
+        {
+            tb_long_t real = tb_stream_peek(stream, &data, TB_STREAM_BLOCK_MAXN);
+            if (real > 0)
+            {
+                tb_long_t i = 0;
+                for (i = 0; i < real; i++) sum += data[i];
+                size += real;
+                if (!tb_stream_skip(stream, real)) break;
+            }
+            else if (!real)
+            {
+                real = tb_stream_wait(stream, TB_STREAM_WAIT_READ, -1);
+                tb_check_break(real > 0);
+            }
+            else break;
+        }
+        time = tb_mclock() - time;
+
+        // need the first 16 bytes again
+        ok = size == tb_stream_size(stream) && tb_stream_seek(stream, 0) && tb_stream_need(stream, &data, 16);
+
+        // trace
+        tb_trace_i("mmap(%lu): size: %llu, sum: %x, time: %lld ms, ok: %s", mmap, size, sum, time, ok? "ok" : "no");
+    }
+
+    // exit stream
+    tb_stream_exit(stream);
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_stream_mmap_main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    tb_assert_and_check_return_val(argc > 1 && argv[1], -1);
+
+    // test it
+    tb_demo_stream_mmap_test(argv[1], TB_STREAM_FILE_MMAP_NONE);
+    tb_demo_stream_mmap_test(argv[1], TB_STREAM_FILE_MMAP_SEQUENTIAL);
+    tb_demo_stream_mmap_test(argv[1], TB_STREAM_FILE_MMAP_RANDOM);
+    return 0;
+}
@@ -0,0 +1,156 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the sent data size
+#define TB_DEMO_SIZE        (4 << 20)
+
+// the file head
+#define TB_DEMO_HEAD        "head"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_byte_t tb_demo_stream_splice_byte(tb_size_t i)
+{
+    return (tb_byte_t)((i * 31 + (i >> 8)) & 0xff);
+}
+static tb_int_t tb_demo_stream_splice_server(tb_cpointer_t priv)
+{
+    // accept one client
+    tb_socket_ref_t sock = (tb_socket_ref_t)priv;
+    tb_socket_ref_t client = tb_null;
+    while (!(client = tb_socket_accept(sock, tb_null)))
+    {
+        if (tb_socket_wait(sock, TB_SOCKET_EVENT_ACPT, -1) <= 0) return -1;
+    }
+
+    // send data and close it
+    tb_byte_t data[8192];
+    tb_size_t send = 0;
+    while (send < TB_DEMO_SIZE)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < sizeof(data); i++) data[i] = tb_demo_stream_splice_byte(send + i);
+        if (!tb_socket_bsend(client, data, sizeof(data))) break;
+        send += sizeof(data);
+    }
+    tb_socket_exit(client);
+    return 0;
+}
+static tb_bool_t tb_demo_stream_splice_check(tb_char_t const* path, tb_bool_t append)
+{
+    // init file
+    tb_file_ref_t file = tb_file_init(path, TB_FILE_MODE_RO);
+    tb_assert_and_check_return_val(file, tb_false);
+
+    // check the file size
+    tb_size_t head = append? tb_strlen(TB_DEMO_HEAD) : 0;
+    tb_bool_t ok = tb_file_size(file) == head + TB_DEMO_SIZE;
+
+    // check the file head
+    tb_byte_t data[8192];
+    if (ok && head) ok = tb_file_read(file, data, head) == head && !tb_memcmp(data, TB_DEMO_HEAD, head);
+
+    // check the received data
+    tb_size_t read = 0;
+    while (ok && read < TB_DEMO_SIZE)
+    {
+        tb_long_t real = tb_file_read(file, data, sizeof(data));
+        tb_check_break(real > 0);
+
+        tb_long_t i = 0;
+        for (i = 0; i < real && ok; i++) ok = data[i] == tb_demo_stream_splice_byte(read + i);
+        read += real;
+    }
+
+    // exit file
+    tb_file_exit(file);
+    return ok && read == TB_DEMO_SIZE;
+}
+static tb_bool_t tb_demo_stream_splice_test(tb_char_t const* path, tb_bool_t append)
+{
+    // init the listened socket
+    tb_bool_t       ok = tb_false;
+    tb_thread_ref_t thread = tb_null;
+    tb_stream_ref_t istream = tb_null;
+    tb_stream_ref_t ostream = tb_null;
+    tb_socket_ref_t sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+    do
+    {
+        // bind and listen it
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+        tb_assert_and_check_break(sock && tb_socket_bind(sock, &addr) && tb_socket_listen(sock, 5) && tb_socket_local(sock, &addr));
+
+        // start the server
+        thread = tb_thread_init(tb_null, tb_demo_stream_splice_server, sock, 0);
+        tb_assert_and_check_break(thread);
+
+        // write the file head for appending
+        tb_file_ref_t file = tb_file_init(path, TB_FILE_MODE_WO | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+        tb_assert_and_check_break(file);
+        if (append) tb_file_writ(file, (tb_byte_t const*)TB_DEMO_HEAD, tb_strlen(TB_DEMO_HEAD));
+        tb_file_exit(file);
+
+        // init the input socket stream
+        tb_char_t url[256];
+        tb_snprintf(url, sizeof(url), "sock://127.0.0.1:%u", tb_ipaddr_port(&addr));
+        istream = tb_stream_init_from_url(url);
+        tb_assert_and_check_break(istream);
+
+        // init the output file stream, splice() does not support the appended file
+        ostream = tb_stream_init_from_file(path, append? (TB_FILE_MODE_WO | TB_FILE_MODE_APPEND) : (TB_FILE_MODE_WO | TB_FILE_MODE_TRUNC));
+        tb_assert_and_check_break(ostream);
+
+        // transfer it
+        tb_hong_t time = tb_mclock();
+        tb_hong_t size = tb_transfer(istream, ostream, 0, tb_null, tb_null);
+        time = tb_mclock() - time;
+        tb_stream_clos(ostream);
+
+        // check it
+        ok = size == TB_DEMO_SIZE && tb_demo_stream_splice_check(path, append);
+
+        // trace
+        tb_trace_i("splice(%s): size: %lld, time: %lld ms, ok: %s", append? "append" : "trunc", size, time, ok? "ok" : "no");
+
+    } while (0);
+
+    // exit it
+    if (istream) tb_stream_exit(istream);
+    if (ostream) tb_stream_exit(ostream);
+    if (thread)
+    {
+        tb_thread_wait(thread, -1, tb_null);
+        tb_thread_exit(thread);
+    }
+    if (sock) tb_socket_exit(sock);
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_stream_splice_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the temporary file path
+    tb_char_t path[TB_PATH_MAXN];
+    if (!tb_directory_temporary(path, sizeof(path))) return -1;
+    tb_strncat(path, "/tbox_demo_splice", sizeof(path) - tb_strlen(path) - 1);
+
+    // socket => file
+    tb_demo_stream_splice_test(path, tb_false);
+
+    // socket => appended file, it will fall back to the buffered transfer
+    tb_demo_stream_splice_test(path, tb_true);
+
+    // remove the temporary file
+    tb_file_remove(path);
+    return 0;
+}
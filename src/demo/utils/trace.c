@@ -0,0 +1,176 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max thread count
+#define TB_DEMO_TRACE_THREAD_MAXN       (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the line count of each thread
+static tb_size_t    g_count = 100000;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_int_t tb_demo_trace_loop(tb_cpointer_t priv)
+{
+    // write lines
+    tb_size_t id = (tb_size_t)priv;
+    tb_size_t i = 0;
+    for (i = 0; i < g_count; i++)
+        tb_trace_done(tb_null, "demo", "%lu %lu" __tb_newline__, id, i);
+    return 0;
+}
+static tb_bool_t tb_demo_trace_check(tb_char_t const* path, tb_size_t thread_count, tb_hize_t expected)
+{
+    // read the trace file
+    tb_bool_t   ok = tb_false;
+    tb_file_ref_t file = tb_null;
+    tb_char_t*  data = tb_null;
+    tb_size_t*  next = tb_null;
+    do
+    {
+        file = tb_file_init(path, TB_FILE_MODE_RO);
+        tb_assert_and_check_break(file);
+
+        tb_size_t size = (tb_size_t)tb_file_size(file);
+        data = tb_malloc_cstr(size + 1);
+        next = tb_nalloc0_type(thread_count, tb_size_t);
+        tb_assert_and_check_break(data && next);
+
+        tb_size_t read = 0;
+        while (read < size)
+        {
+            tb_long_t real = tb_file_read(file, (tb_byte_t*)data + read, size - read);
+            tb_check_break(real > 0);
+            read += real;
+        }
+        tb_assert_and_check_break(read == size);
+        data[size] = '\0';
+
+        // check lines, the lines of the same thread must be ordered, but may be dropped
+        tb_hize_t   count = 0;
+        tb_char_t*  p = data;
+        tb_char_t*  e = data + size;
+        while (p < e)
+        {
+            // the line: "[time]: [thread]: [demo]: id i"
+            tb_char_t* end = tb_strchr(p, '\n');
+            tb_assert_and_check_break(end);
+            *end = '\0';
+
+            tb_char_t* s = tb_strstr(p, "[demo]: ");
+            tb_assert_and_check_break(s);
+            s += 8;
+
+            tb_size_t id = tb_s10tou32(s);
+            s = tb_strchr(s, ' ');
+            tb_assert_and_check_break(s && id < thread_count);
+
+            tb_size_t i = tb_s10tou32(s + 1);
+            tb_assert_and_check_break(i >= next[id]);
+            next[id] = i + 1;
+
+            count++;
+            p = end + 1;
+        }
+        tb_check_break(p >= e);
+
+        // check count
+        if (count != expected)
+        {
+            tb_trace_e("lines: %llu != %llu", count, expected);
+            break;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit data
+    if (file) tb_file_exit(file);
+    if (data) tb_free(data);
+    if (next) tb_free(next);
+    return ok;
+}
+static tb_void_t tb_demo_trace_test(tb_char_t const* name, tb_char_t const* path, tb_size_t mode, tb_size_t thread_count)
+{
+    // set the trace file and mode
+    if (!tb_trace_file_set_path(path, tb_false)) return ;
+    tb_trace_stat_t stat0;
+    tb_trace_stat(&stat0);
+    if (!tb_trace_mode_set(mode)) return ;
+
+    // start threads
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_TRACE_THREAD_MAXN] = {0};
+    tb_hong_t       t = tb_mclock();
+    for (i = 0; i < thread_count; i++)
+        threads[i] = tb_thread_init(tb_null, tb_demo_trace_loop, (tb_cpointer_t)i, 0);
+
+    // wait threads
+    for (i = 0; i < thread_count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    tb_hong_t f = tb_mclock();
+    t = f - t;
+
+    // write all lines and restore the print mode
+    tb_trace_mode_set(TB_TRACE_MODE_PRINT);
+    f = tb_mclock() - f;
+
+    // the stat
+    tb_trace_stat_t stat;
+    tb_trace_stat(&stat);
+    stat.writ -= stat0.writ;
+    stat.drop -= stat0.drop;
+    stat.wait -= stat0.wait;
+
+    // check lines
+    tb_hize_t total = (tb_hize_t)g_count * thread_count;
+    tb_bool_t ok = tb_demo_trace_check(path, thread_count, total - stat.drop);
+
+    // trace
+    tb_trace_i("[%s]: %lu threads x %lu lines: %lld ms, %lld lines/s, flush: %lld ms, writ: %llu, drop: %llu, wait: %llu, check: %s"
+        , name, thread_count, g_count, t, t > 0? (tb_hong_t)total * 1000 / t : 0, f, stat.writ, stat.drop, stat.wait, ok? "ok" : "failed");
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_utils_trace_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the thread count and the line count of each thread
+    tb_size_t thread_count = argc > 1 && argv[1]? tb_atoi(argv[1]) : 4;
+    if (argc > 2 && argv[2]) g_count = tb_atoi(argv[2]);
+    thread_count = tb_min(thread_count, TB_DEMO_TRACE_THREAD_MAXN);
+
+    // the trace file
+    tb_char_t path[TB_PATH_MAXN];
+    tb_size_t n = tb_directory_temporary(path, sizeof(path));
+    tb_assert_and_check_return_val(n, -1);
+    tb_snprintf(path + n, sizeof(path) - n, "/tbox_trace_demo.log");
+
+    // test the sync and async modes
+    tb_demo_trace_test("sync",          path, TB_TRACE_MODE_FILE, thread_count);
+    tb_demo_trace_test("async: drop",   path, TB_TRACE_MODE_FILE | TB_TRACE_MODE_ASYNC, thread_count);
+    tb_demo_trace_test("async: block",  path, TB_TRACE_MODE_FILE | TB_TRACE_MODE_ASYNC | TB_TRACE_MODE_BLOCK, thread_count);
+
+    // remove the trace file
+    tb_file_remove(path);
+    return 0;
+}
@@ -17,7 +17,7 @@ target("demo")
     add_files("libm/integer.c")
     add_files("math/random.c")
     add_files("utils/*.c|option.c")
-    add_files("other/*.c|charset.c", "other/*.cpp")
+    add_files("other/*.c|charset.c|charset_benchmark.c", "other/*.cpp")
     add_files("string/*.c")
     add_files("memory/**.c")
     add_files("platform/*.c|exception.c|context.c")
@@ -70,7 +70,7 @@ target("demo")
     add_options("force-utf8")
 
     -- add the source files for the charset module
-    if has_config("charset") then add_files("other/charset.c") end
+    if has_config("charset") then add_files("other/charset.c", "other/charset_benchmark.c") end
 
     -- add the source files for the database module
     if has_config("database") then add_files("database/sql.c") end
@@ -15,6 +15,7 @@ target "demo"
     add_files "utils/bits.c"
     add_files "utils/dump.c"
     add_files "utils/url.c"
+    add_files "utils/trace.c"
     add_files "other/test.c"
     add_files "other/test.cpp"
     add_files "string/*.c"
@@ -100,6 +101,7 @@ target "demo"
     # add the source files for the charset module
     if has_config "charset"; then
         add_files "other/charset.c"
+        add_files "other/charset_benchmark.c"
     fi
 
     # add the source files for the database module
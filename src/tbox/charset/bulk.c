@@ -0,0 +1,376 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        bulk.c
+ * @ingroup     charset
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "charset.h"
+#include "../utils/utils.h"
+#include "../libc/libc.h"
+#if !defined(TB_WORDS_BIGENDIAN)
+#   if defined(TB_ARCH_AVX2)
+#       include <immintrin.h>
+#       define TB_CHARSET_BULK_SSE2
+#       define TB_CHARSET_BULK_AVX2
+#   elif defined(TB_ARCH_SSE2)
+#       include <emmintrin.h>
+#       define TB_CHARSET_BULK_SSE2
+#   elif defined(TB_ARCH_ARM_NEON) && defined(TB_ARCH_ARM64)
+#       include <arm_neon.h>
+#       define TB_CHARSET_BULK_NEON
+#   endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+/* the unit width of the given charset
+ *
+ * only the unicode charsets which keep the ascii characters as is can be converted in bulk,
+ * e.g. ascii, utf8, utf16, utf32, ucs2 and ucs4
+ */
+static __tb_inline__ tb_size_t tb_charset_bulk_width(tb_size_t type)
+{
+    switch (TB_CHARSET_TYPE(type))
+    {
+    case TB_CHARSET_TYPE_ASCII:
+    case TB_CHARSET_TYPE_UTF8:
+        return 1;
+    case TB_CHARSET_TYPE_UCS2:
+    case TB_CHARSET_TYPE_UTF16:
+        return 2;
+    case TB_CHARSET_TYPE_UCS4:
+    case TB_CHARSET_TYPE_UTF32:
+        return 4;
+    default:
+        break;
+    }
+    return 0;
+}
+static __tb_inline__ tb_uint32_t tb_charset_bulk_get(tb_byte_t const* p, tb_size_t width, tb_bool_t be)
+{
+    switch (width)
+    {
+    case 1: return *p;
+    case 2: return be? tb_bits_get_u16_be(p) : tb_bits_get_u16_le(p);
+    default: return be? tb_bits_get_u32_be(p) : tb_bits_get_u32_le(p);
+    }
+}
+static __tb_inline__ tb_void_t tb_charset_bulk_set(tb_byte_t* p, tb_size_t width, tb_bool_t be, tb_uint32_t ch)
+{
+    switch (width)
+    {
+    case 1: *p = (tb_byte_t)ch; break;
+    case 2: if (be) tb_bits_set_u16_be(p, ch); else tb_bits_set_u16_le(p, ch); break;
+    default: if (be) tb_bits_set_u32_be(p, ch); else tb_bits_set_u32_le(p, ch); break;
+    }
+}
+#if defined(TB_CHARSET_BULK_SSE2)
+/* convert the ascii characters by 16 units
+ *
+ * the ascii units of the big endian charsets are loaded as (ch << 8) and (ch << 24)
+ * on the little endian host, so we need only shift them
+ */
+static tb_size_t tb_charset_bulk_conv_simd(tb_byte_t const* ip, tb_size_t fw, tb_bool_t fbe, tb_byte_t* op, tb_size_t tw, tb_bool_t tbe, tb_size_t n)
+{
+    tb_size_t   i = 0;
+    __m128i     z = _mm_setzero_si128();
+    if (fw == 1)
+    {
+#ifdef TB_CHARSET_BULK_AVX2
+        // the fast path for avx2
+        while (tw == 1 && i + 32 <= n)
+        {
+            __m256i v = _mm256_loadu_si256((__m256i const*)(ip + i));
+            if (_mm256_movemask_epi8(v)) break;
+            _mm256_storeu_si256((__m256i*)(op + i), v);
+            i += 32;
+        }
+        while (tw == 2 && i + 16 <= n)
+        {
+            __m128i v = _mm_loadu_si128((__m128i const*)(ip + i));
+            if (_mm_movemask_epi8(v)) break;
+            __m256i w = _mm256_cvtepu8_epi16(v);
+            if (tbe) w = _mm256_slli_epi16(w, 8);
+            _mm256_storeu_si256((__m256i*)(op + (i << 1)), w);
+            i += 16;
+        }
+#endif
+        while (i + 16 <= n)
+        {
+            // has non-ascii characters?
+            __m128i v = _mm_loadu_si128((__m128i const*)(ip + i));
+            if (_mm_movemask_epi8(v)) break;
+
+            // widen them
+            if (tw == 1) _mm_storeu_si128((__m128i*)(op + i), v);
+            else
+            {
+                __m128i lo = _mm_unpacklo_epi8(v, z);
+                __m128i hi = _mm_unpackhi_epi8(v, z);
+                if (tw == 2)
+                {
+                    if (tbe)
+                    {
+                        lo = _mm_slli_epi16(lo, 8);
+                        hi = _mm_slli_epi16(hi, 8);
+                    }
+                    _mm_storeu_si128((__m128i*)(op + (i << 1)), lo);
+                    _mm_storeu_si128((__m128i*)(op + (i << 1) + 16), hi);
+                }
+                else
+                {
+                    __m128i w[4];
+                    w[0] = _mm_unpacklo_epi16(lo, z);
+                    w[1] = _mm_unpackhi_epi16(lo, z);
+                    w[2] = _mm_unpacklo_epi16(hi, z);
+                    w[3] = _mm_unpackhi_epi16(hi, z);
+                    tb_size_t k = 0;
+                    for (k = 0; k < 4; k++)
+                        _mm_storeu_si128((__m128i*)(op + (i << 2) + (k << 4)), tbe? _mm_slli_epi32(w[k], 24) : w[k]);
+                }
+            }
+            i += 16;
+        }
+    }
+    else if (fw == 2 && (tw == 1 || (tw == 2 && fbe == tbe)))
+    {
+        __m128i mask = _mm_set1_epi16(fbe? (tb_int16_t)0x80ff : (tb_int16_t)0xff80);
+        while (i + 16 <= n)
+        {
+            // has non-ascii characters?
+            __m128i a = _mm_loadu_si128((__m128i const*)(ip + (i << 1)));
+            __m128i b = _mm_loadu_si128((__m128i const*)(ip + (i << 1) + 16));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_or_si128(a, b), mask), z)) != 0xffff) break;
+
+            // narrow them
+            if (tw == 1)
+            {
+                if (fbe)
+                {
+                    a = _mm_srli_epi16(a, 8);
+                    b = _mm_srli_epi16(b, 8);
+                }
+                _mm_storeu_si128((__m128i*)(op + i), _mm_packus_epi16(a, b));
+            }
+            else
+            {
+                _mm_storeu_si128((__m128i*)(op + (i << 1)), a);
+                _mm_storeu_si128((__m128i*)(op + (i << 1) + 16), b);
+            }
+            i += 16;
+        }
+    }
+    else if (fw == 4 && (tw == 1 || (tw == 4 && fbe == tbe)))
+    {
+        __m128i mask = _mm_set1_epi32(fbe? (tb_int32_t)0x80ffffff : (tb_int32_t)0xffffff80);
+        while (i + 16 <= n)
+        {
+            // has non-ascii characters?
+            __m128i     w[4];
+            tb_size_t   k = 0;
+            for (k = 0; k < 4; k++) w[k] = _mm_loadu_si128((__m128i const*)(ip + (i << 2) + (k << 4)));
+            __m128i m = _mm_and_si128(_mm_or_si128(_mm_or_si128(w[0], w[1]), _mm_or_si128(w[2], w[3])), mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(m, z)) != 0xffff) break;
+
+            // narrow them
+            if (tw == 1)
+            {
+                if (fbe) for (k = 0; k < 4; k++) w[k] = _mm_srli_epi32(w[k], 24);
+                _mm_storeu_si128((__m128i*)(op + i), _mm_packus_epi16(_mm_packs_epi32(w[0], w[1]), _mm_packs_epi32(w[2], w[3])));
+            }
+            else for (k = 0; k < 4; k++) _mm_storeu_si128((__m128i*)(op + (i << 2) + (k << 4)), w[k]);
+            i += 16;
+        }
+    }
+    return i;
+}
+#elif defined(TB_CHARSET_BULK_NEON)
+static tb_size_t tb_charset_bulk_conv_simd(tb_byte_t const* ip, tb_size_t fw, tb_bool_t fbe, tb_byte_t* op, tb_size_t tw, tb_bool_t tbe, tb_size_t n)
+{
+    tb_size_t i = 0;
+    if (fw == 1)
+    {
+        while (i + 16 <= n)
+        {
+            // has non-ascii characters?
+            uint8x16_t v = vld1q_u8(ip + i);
+            if (vmaxvq_u8(v) & 0x80) break;
+
+            // widen them
+            if (tw == 1) vst1q_u8(op + i, v);
+            else
+            {
+                uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+                uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+                if (tw == 2)
+                {
+                    if (tbe)
+                    {
+                        lo = vshlq_n_u16(lo, 8);
+                        hi = vshlq_n_u16(hi, 8);
+                    }
+                    vst1q_u8(op + (i << 1), vreinterpretq_u8_u16(lo));
+                    vst1q_u8(op + (i << 1) + 16, vreinterpretq_u8_u16(hi));
+                }
+                else
+                {
+                    uint32x4_t w[4];
+                    w[0] = vmovl_u16(vget_low_u16(lo));
+                    w[1] = vmovl_u16(vget_high_u16(lo));
+                    w[2] = vmovl_u16(vget_low_u16(hi));
+                    w[3] = vmovl_u16(vget_high_u16(hi));
+                    tb_size_t k = 0;
+                    for (k = 0; k < 4; k++)
+                        vst1q_u8(op + (i << 2) + (k << 4), vreinterpretq_u8_u32(tbe? vshlq_n_u32(w[k], 24) : w[k]));
+                }
+            }
+            i += 16;
+        }
+    }
+    else if (fw == 2 && (tw == 1 || (tw == 2 && fbe == tbe)))
+    {
+        uint16x8_t mask = vdupq_n_u16(fbe? 0x80ff : 0xff80);
+        while (i + 16 <= n)
+        {
+            // has non-ascii characters?
+            uint16x8_t a = vreinterpretq_u16_u8(vld1q_u8(ip + (i << 1)));
+            uint16x8_t b = vreinterpretq_u16_u8(vld1q_u8(ip + (i << 1) + 16));
+            if (vmaxvq_u16(vandq_u16(vorrq_u16(a, b), mask))) break;
+
+            // narrow them
+            if (tw == 1)
+            {
+                if (fbe)
+                {
+                    a = vshrq_n_u16(a, 8);
+                    b = vshrq_n_u16(b, 8);
+                }
+                vst1q_u8(op + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+            }
+            else
+            {
+                vst1q_u8(op + (i << 1), vreinterpretq_u8_u16(a));
+                vst1q_u8(op + (i << 1) + 16, vreinterpretq_u8_u16(b));
+            }
+            i += 16;
+        }
+    }
+    else if (fw == 4 && (tw == 1 || (tw == 4 && fbe == tbe)))
+    {
+        uint32x4_t mask = vdupq_n_u32(fbe? 0x80ffffff : 0xffffff80);
+        while (i + 16 <= n)
+        {
+            // has non-ascii characters?
+            uint32x4_t  w[4];
+            tb_size_t   k = 0;
+            for (k = 0; k < 4; k++) w[k] = vreinterpretq_u32_u8(vld1q_u8(ip + (i << 2) + (k << 4)));
+            if (vmaxvq_u32(vandq_u32(vorrq_u32(vorrq_u32(w[0], w[1]), vorrq_u32(w[2], w[3])), mask))) break;
+
+            // narrow them
+            if (tw == 1)
+            {
+                if (fbe) for (k = 0; k < 4; k++) w[k] = vshrq_n_u32(w[k], 24);
+                uint16x8_t lo = vcombine_u16(vmovn_u32(w[0]), vmovn_u32(w[1]));
+                uint16x8_t hi = vcombine_u16(vmovn_u32(w[2]), vmovn_u32(w[3]));
+                vst1q_u8(op + i, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+            }
+            else for (k = 0; k < 4; k++) vst1q_u8(op + (i << 2) + (k << 4), vreinterpretq_u8_u32(w[k]));
+            i += 16;
+        }
+    }
+    return i;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t tb_charset_bulk_ascii(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert(data || !size);
+
+    // find the first non-ascii character
+    tb_size_t i = 0;
+#if defined(TB_CHARSET_BULK_AVX2)
+    for (; i + 32 <= size; i += 32)
+    {
+        tb_uint32_t mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((__m256i const*)(data + i)));
+        if (mask) return i + tb_bits_cl0_u32_le(mask);
+    }
+#endif
+#if defined(TB_CHARSET_BULK_SSE2)
+    for (; i + 16 <= size; i += 16)
+    {
+        tb_uint32_t mask = (tb_uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)(data + i)));
+        if (mask) return i + tb_bits_cl0_u32_le(mask);
+    }
+#elif defined(TB_CHARSET_BULK_NEON)
+    for (; i + 16 <= size; i += 16)
+    {
+        if (vmaxvq_u8(vld1q_u8(data + i)) & 0x80) break;
+    }
+#endif
+    while (i < size && !(data[i] & 0x80)) i++;
+    return i;
+}
+tb_long_t tb_charset_bulk_conv(tb_size_t ftype, tb_size_t ttype, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst)
+{
+    // only for the unicode charsets
+    tb_size_t fw = tb_charset_bulk_width(ftype);
+    tb_size_t tw = tb_charset_bulk_width(ttype);
+    tb_check_return_val(fw && tw, -1);
+
+    // big endian?
+    tb_bool_t fbe = !(ftype & TB_CHARSET_TYPE_LE)? tb_true : tb_false;
+    tb_bool_t tbe = !(ttype & TB_CHARSET_TYPE_LE)? tb_true : tb_false;
+
+    // the maximum units
+    tb_byte_t const*    ip = tb_static_stream_pos(fst);
+    tb_byte_t*          op = (tb_byte_t*)tb_static_stream_pos(tst);
+    tb_size_t           n = tb_min(tb_static_stream_left(fst) / fw, tb_static_stream_left(tst) / tw);
+    tb_check_return_val(n, 0);
+
+    // convert the ascii characters by vectors
+    tb_size_t i = 0;
+#if defined(TB_CHARSET_BULK_SSE2) || defined(TB_CHARSET_BULK_NEON)
+    if (n >= 16) i = tb_charset_bulk_conv_simd(ip, fw, fbe, op, tw, tbe, n);
+#endif
+
+    // convert the left ascii characters until the first non-ascii character
+    for (; i < n; i++)
+    {
+        tb_uint32_t ch = tb_charset_bulk_get(ip + i * fw, fw, fbe);
+        tb_check_break(ch < 0x80);
+        tb_charset_bulk_set(op + i * tw, tw, tbe, ch);
+    }
+
+    // skip the converted characters
+    if (i)
+    {
+        tb_static_stream_skip(fst, i * fw);
+        tb_static_stream_skip(tst, i * tw);
+    }
+    return i;
+}
@@ -62,6 +62,10 @@ tb_long_t tb_charset_gb2312_set(tb_static_stream_ref_t sstream, tb_bool_t be, tb
 tb_long_t tb_charset_iso8859_get(tb_static_stream_ref_t sstream, tb_bool_t be, tb_uint32_t* ch);
 tb_long_t tb_charset_iso8859_set(tb_static_stream_ref_t sstream, tb_bool_t be, tb_uint32_t ch);
 
+// bulk
+tb_size_t tb_charset_bulk_ascii(tb_byte_t const* data, tb_size_t size);
+tb_long_t tb_charset_bulk_conv(tb_size_t ftype, tb_size_t ttype, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -178,9 +182,13 @@ tb_long_t tb_charset_conv_bst(tb_size_t ftype, tb_size_t ttype, tb_static_stream
 
     // walk
     tb_uint32_t         ch;
+    tb_long_t           bulk = 0;
     tb_byte_t const*    tp = tb_static_stream_pos(tst);
     while (tb_static_stream_left(fst) && tb_static_stream_left(tst))
     {
+        // convert the ascii characters in bulk first, it will be disabled if these charsets are not supported
+        if (bulk >= 0 && (bulk = tb_charset_bulk_conv(ftype, ttype, fst, tst)) > 0) continue;
+
         // get ucs4 character
         tb_long_t ok = 0;
         if ((ok = fr->get(fst, fbe, &ch)) > 0)
@@ -217,4 +225,47 @@ tb_long_t tb_charset_conv_data(tb_size_t ftype, tb_size_t ttype, tb_byte_t const
     // conv
     return tb_charset_conv_bst(ftype, ttype, &ist, &ost);
 }
+tb_bool_t tb_charset_utf8_valid(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data || !size, tb_false);
+
+    // walk
+    tb_byte_t const* p = data;
+    tb_byte_t const* e = data + size;
+    while (p < e)
+    {
+        // skip the ascii characters in bulk
+        p += tb_charset_bulk_ascii(p, e - p);
+        tb_check_break(p < e);
+
+        // 0x00000080 - 0x000007ff: 110xxxxx 10xxxxxx, no overlong
+        tb_size_t n = e - p;
+        tb_byte_t c = *p;
+        if (c >= 0xc2 && c <= 0xdf)
+        {
+            tb_check_return_val(n > 1 && (p[1] & 0xc0) == 0x80, tb_false);
+            p += 2;
+        }
+        // 0x00000800 - 0x0000ffff: 1110xxxx 10xxxxxx 10xxxxxx, no overlong and surrogates
+        else if (c >= 0xe0 && c <= 0xef)
+        {
+            tb_check_return_val(n > 2 && (p[1] & 0xc0) == 0x80 && (p[2] & 0xc0) == 0x80, tb_false);
+            tb_check_return_val(c != 0xe0 || p[1] >= 0xa0, tb_false);
+            tb_check_return_val(c != 0xed || p[1] <= 0x9f, tb_false);
+            p += 3;
+        }
+        // 0x00010000 - 0x0010ffff: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx, no overlong
+        else if (c >= 0xf0 && c <= 0xf4)
+        {
+            tb_check_return_val(n > 3 && (p[1] & 0xc0) == 0x80 && (p[2] & 0xc0) == 0x80 && (p[3] & 0xc0) == 0x80, tb_false);
+            tb_check_return_val(c != 0xf0 || p[1] >= 0x90, tb_false);
+            tb_check_return_val(c != 0xf4 || p[1] <= 0x8f, tb_false);
+            p += 4;
+        }
+        else return tb_false;
+    }
 
+    // ok
+    return tb_true;
+}
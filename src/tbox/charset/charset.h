@@ -179,6 +179,17 @@ tb_long_t           tb_charset_conv_cstr(tb_size_t ftype, tb_size_t ttype, tb_ch
  */
 tb_long_t           tb_charset_conv_data(tb_size_t ftype, tb_size_t ttype, tb_byte_t const* idata, tb_size_t isize, tb_byte_t* odata, tb_size_t osize);
 
+/*! is valid utf8 data?
+ *
+ * the overlong sequences, surrogates and the characters above 0x10ffff are invalid (rfc3629)
+ *
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_charset_utf8_valid(tb_byte_t const* data, tb_size_t size);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
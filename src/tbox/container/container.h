@@ -34,6 +34,7 @@
 #include "vector.h"
 #include "hash_set.h"
 #include "hash_map.h"
+#include "flat_hash_map.h"
 #include "queue.h"
 #include "circle_queue.h"
 #include "priority_queue.h"
@@ -0,0 +1,738 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "flat_hash_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "flat_hash_map.h"
+#include "../libc/libc.h"
+#include "../math/math.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#if defined(TB_ARCH_SSE2)
+#   include <emmintrin.h>
+#elif defined(TB_ARCH_ARM_NEON) && defined(TB_ARCH_ARM64)
+#   include <arm_neon.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the group size
+#define TB_FLAT_HASH_MAP_GROUP                      TB_FLAT_HASH_MAP_GROUP_SIZE
+
+// the default slot size
+#ifdef __tb_small__
+#   define TB_FLAT_HASH_MAP_SLOT_SIZE_DEFAULT       (16)
+#else
+#   define TB_FLAT_HASH_MAP_SLOT_SIZE_DEFAULT       (64)
+#endif
+
+// the empty tag
+#define TB_FLAT_HASH_MAP_TAG_EMPTY                  (0)
+
+// the full tag flag
+#define TB_FLAT_HASH_MAP_TAG_FULL                   (0x80)
+
+// the maximum overflow count, it will be sticky if reach it
+#define TB_FLAT_HASH_MAP_OVERFLOW_MAXN              (0xff)
+
+// the maximum load factor: 7/8
+#define tb_flat_hash_map_load_maxn(slot_size)       ((slot_size) - ((slot_size) >> 3))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the flat hash map type
+typedef struct __tb_flat_hash_map_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the control tags, 16 tags for each group
+    tb_byte_t*                      ctrl;
+
+    // the overflow counts of the groups
+    tb_byte_t*                      overflow;
+
+    // the slots
+    tb_byte_t*                      slots;
+
+    // the group count, must be pow2
+    tb_size_t                       group_size;
+
+    // the current item for iterator
+    tb_flat_hash_map_item_t         item;
+
+    // the item size
+    tb_size_t                       item_size;
+
+    // the item step
+    tb_size_t                       item_step;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_flat_hash_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_size_t tb_flat_hash_map_hash(tb_flat_hash_map_t* hash_map, tb_cpointer_t name)
+{
+    // the element hash value
+    tb_size_t hash = hash_map->element_name.hash(&hash_map->element_name, name, (tb_size_t)-1, 0);
+
+    /* mix all bits, because the element hash may be weak in the low or high bits
+     *
+     * .e.g the uint32 hash is only (value * 2654435761) >> 16
+     */
+#if TB_CPU_BIT64
+    tb_uint64_t h = (tb_uint64_t)hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (tb_size_t)h;
+#else
+    tb_uint32_t h = (tb_uint32_t)hash;
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return (tb_size_t)h;
+#endif
+}
+static __tb_inline__ tb_byte_t tb_flat_hash_map_hash_tag(tb_size_t hash)
+{
+    return (tb_byte_t)(TB_FLAT_HASH_MAP_TAG_FULL | (hash & 0x7f));
+}
+static __tb_inline__ tb_size_t tb_flat_hash_map_hash_group(tb_flat_hash_map_t* hash_map, tb_size_t hash)
+{
+    return (hash >> 7) & (hash_map->group_size - 1);
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match(tb_byte_t const* ctrl, tb_byte_t tag)
+{
+#if defined(TB_ARCH_SSE2)
+    __m128i group = _mm_loadu_si128((__m128i const*)ctrl);
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((tb_char_t)tag)));
+#elif defined(TB_ARCH_ARM_NEON) && defined(TB_ARCH_ARM64)
+    static tb_byte_t const bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t match = vandq_u8(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(tag)), vld1q_u8(bits));
+    return (tb_uint32_t)vaddv_u8(vget_low_u8(match)) | ((tb_uint32_t)vaddv_u8(vget_high_u8(match)) << 8);
+#else
+    tb_size_t   i = 0;
+    tb_uint32_t mask = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP; i++)
+        if (ctrl[i] == tag) mask |= (1 << i);
+    return mask;
+#endif
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_full(tb_byte_t const* ctrl)
+{
+#if defined(TB_ARCH_SSE2)
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)ctrl));
+#elif defined(TB_ARCH_ARM_NEON) && defined(TB_ARCH_ARM64)
+    static tb_byte_t const bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t full = vandq_u8(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl))), vld1q_u8(bits));
+    return (tb_uint32_t)vaddv_u8(vget_low_u8(full)) | ((tb_uint32_t)vaddv_u8(vget_high_u8(full)) << 8);
+#else
+    tb_size_t   i = 0;
+    tb_uint32_t mask = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP; i++)
+        if (ctrl[i] & TB_FLAT_HASH_MAP_TAG_FULL) mask |= (1 << i);
+    return mask;
+#endif
+}
+static __tb_inline__ tb_byte_t* tb_flat_hash_map_slot(tb_flat_hash_map_t* hash_map, tb_size_t slot)
+{
+    return hash_map->slots + slot * hash_map->item_step;
+}
+static tb_size_t tb_flat_hash_map_slot_find(tb_flat_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t hash)
+{
+    // check
+    tb_assert(hash_map && hash_map->ctrl && hash_map->group_size);
+
+    // find it
+    tb_byte_t   tag = tb_flat_hash_map_hash_tag(hash);
+    tb_size_t   mask = hash_map->group_size - 1;
+    tb_size_t   group = tb_flat_hash_map_hash_group(hash_map, hash);
+    tb_size_t   probe = 0;
+    tb_element_ref_t element_name = &hash_map->element_name;
+    while (probe <= mask)
+    {
+        // match the tags in this group
+        tb_byte_t const*    ctrl = hash_map->ctrl + group * TB_FLAT_HASH_MAP_GROUP;
+        tb_uint32_t         match = tb_flat_hash_map_group_match(ctrl, tag);
+        while (match)
+        {
+            // compare name
+            tb_size_t slot = group * TB_FLAT_HASH_MAP_GROUP + tb_bits_cl0_u32_le(match);
+            if (!element_name->comp(element_name, name, element_name->data(element_name, tb_flat_hash_map_slot(hash_map, slot))))
+                return slot + 1;
+
+            // clear the lowest bit
+            match &= match - 1;
+        }
+
+        // no items overflowed from this group? not found
+        tb_check_break(hash_map->overflow[group]);
+
+        // probe the next group, the triangular sequence will visit all groups
+        probe++;
+        group = (group + probe) & mask;
+    }
+
+    // not found
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_slot_alloc(tb_flat_hash_map_t* hash_map, tb_size_t hash)
+{
+    // check
+    tb_assert(hash_map && hash_map->ctrl && hash_map->group_size);
+
+    // find a free slot
+    tb_size_t   mask = hash_map->group_size - 1;
+    tb_size_t   group = tb_flat_hash_map_hash_group(hash_map, hash);
+    tb_size_t   probe = 0;
+    while (probe <= mask)
+    {
+        // have free slots in this group?
+        tb_byte_t*  ctrl = hash_map->ctrl + group * TB_FLAT_HASH_MAP_GROUP;
+        tb_uint32_t empty = ~tb_flat_hash_map_group_full(ctrl) & 0xffff;
+        if (empty)
+        {
+            // mark this slot
+            tb_size_t index = tb_bits_cl0_u32_le(empty);
+            ctrl[index] = tb_flat_hash_map_hash_tag(hash);
+            return group * TB_FLAT_HASH_MAP_GROUP + index + 1;
+        }
+
+        // this item will overflow from this group
+        if (hash_map->overflow[group] != TB_FLAT_HASH_MAP_OVERFLOW_MAXN) hash_map->overflow[group]++;
+
+        // probe the next group
+        probe++;
+        group = (group + probe) & mask;
+    }
+
+    // the load factor ensures that we always find a free slot
+    tb_assert(0);
+    return 0;
+}
+static tb_void_t tb_flat_hash_map_slot_free(tb_flat_hash_map_t* hash_map, tb_size_t slot, tb_size_t hash)
+{
+    // check
+    tb_assert(hash_map && hash_map->ctrl && slot < hash_map->group_size * TB_FLAT_HASH_MAP_GROUP);
+
+    // clear the tag, we need not a tombstone
+    hash_map->ctrl[slot] = TB_FLAT_HASH_MAP_TAG_EMPTY;
+
+    // decrease the overflow counts of all groups on the probe path of this item
+    tb_size_t   mask = hash_map->group_size - 1;
+    tb_size_t   group = tb_flat_hash_map_hash_group(hash_map, hash);
+    tb_size_t   last = slot / TB_FLAT_HASH_MAP_GROUP;
+    tb_size_t   probe = 0;
+    while (group != last && probe <= mask)
+    {
+        // the sticky overflow count will never be decreased
+        if (hash_map->overflow[group] != TB_FLAT_HASH_MAP_OVERFLOW_MAXN)
+        {
+            tb_assert(hash_map->overflow[group]);
+            hash_map->overflow[group]--;
+        }
+
+        // probe the next group
+        probe++;
+        group = (group + probe) & mask;
+    }
+}
+static tb_bool_t tb_flat_hash_map_resize(tb_flat_hash_map_t* hash_map, tb_size_t group_size)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && group_size && tb_ispow2(group_size), tb_false);
+
+    // the slot size
+    tb_size_t slot_size = group_size * TB_FLAT_HASH_MAP_GROUP;
+    tb_assert_and_check_return_val(slot_size > group_size, tb_false);
+
+    // make the new control tags and overflow counts
+    tb_byte_t* ctrl = (tb_byte_t*)tb_malloc0(slot_size + group_size);
+    tb_assert_and_check_return_val(ctrl, tb_false);
+
+    // make the new slots
+    tb_byte_t* slots = (tb_byte_t*)tb_nalloc(slot_size, hash_map->item_step);
+    if (!slots)
+    {
+        tb_free(ctrl);
+        return tb_false;
+    }
+
+    // save the old slots
+    tb_byte_t*  ctrl_old = hash_map->ctrl;
+    tb_byte_t*  slots_old = hash_map->slots;
+    tb_size_t   slot_size_old = hash_map->group_size * TB_FLAT_HASH_MAP_GROUP;
+
+    // attach the new slots
+    hash_map->ctrl          = ctrl;
+    hash_map->overflow      = ctrl + slot_size;
+    hash_map->slots         = slots;
+    hash_map->group_size    = group_size;
+
+    // move all items to the new slots
+    if (ctrl_old)
+    {
+        tb_size_t           step = hash_map->item_step;
+        tb_element_ref_t    element_name = &hash_map->element_name;
+        tb_size_t           i = 0;
+        for (i = 0; i < slot_size_old; i += TB_FLAT_HASH_MAP_GROUP)
+        {
+            tb_uint32_t full = tb_flat_hash_map_group_full(ctrl_old + i);
+            while (full)
+            {
+                // the old item
+                tb_byte_t const* item = slots_old + (i + tb_bits_cl0_u32_le(full)) * step;
+
+                // rehash it and move it to the new slot
+                tb_size_t hash = tb_flat_hash_map_hash(hash_map, element_name->data(element_name, item));
+                tb_size_t itor = tb_flat_hash_map_slot_alloc(hash_map, hash);
+                tb_assert(itor);
+                tb_memcpy(tb_flat_hash_map_slot(hash_map, itor - 1), item, step);
+
+                // clear the lowest bit
+                full &= full - 1;
+            }
+        }
+
+        // free the old slots
+        tb_free(ctrl_old);
+        if (slots_old) tb_free(slots_old);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_size_t tb_flat_hash_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // the size
+    return hash_map->item_size;
+}
+static tb_size_t tb_flat_hash_map_itor_scan(tb_flat_hash_map_t* hash_map, tb_size_t slot)
+{
+    // check
+    tb_assert(hash_map && hash_map->ctrl);
+
+    // find the next full slot from the given slot
+    tb_size_t n = hash_map->group_size * TB_FLAT_HASH_MAP_GROUP;
+    tb_size_t i = slot & ~(TB_FLAT_HASH_MAP_GROUP - 1);
+    tb_uint32_t full = tb_flat_hash_map_group_full(hash_map->ctrl + i) & (0xffff << (slot - i));
+    while (1)
+    {
+        if (full) return i + tb_bits_cl0_u32_le(full) + 1;
+
+        // the next group
+        i += TB_FLAT_HASH_MAP_GROUP;
+        tb_check_break(i < n);
+        full = tb_flat_hash_map_group_full(hash_map->ctrl + i);
+    }
+
+    // tail
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // find the head
+    return hash_map->item_size? tb_flat_hash_map_itor_scan(hash_map, 0) : 0;
+}
+static tb_size_t tb_flat_hash_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->group_size * TB_FLAT_HASH_MAP_GROUP);
+
+    // the next slot is the current itor
+    return itor < hash_map->group_size * TB_FLAT_HASH_MAP_GROUP? tb_flat_hash_map_itor_scan(hash_map, itor) : 0;
+}
+static tb_pointer_t tb_flat_hash_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert_and_check_return_val(hash_map && itor && itor <= hash_map->group_size * TB_FLAT_HASH_MAP_GROUP, tb_null);
+
+    // get item
+    tb_byte_t const* item = tb_flat_hash_map_slot(hash_map, itor - 1);
+    hash_map->item.name = hash_map->element_name.data(&hash_map->element_name, item);
+    hash_map->item.data = hash_map->element_data.data(&hash_map->element_data, item + hash_map->element_name.size);
+    return &(hash_map->item);
+}
+static tb_void_t tb_flat_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->group_size * TB_FLAT_HASH_MAP_GROUP);
+
+    // note: copy data only, will destroy hash_map index if copy name
+    hash_map->element_data.copy(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, itor - 1) + hash_map->element_name.size, item);
+}
+static tb_long_t tb_flat_hash_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && hash_map->element_name.comp && lelement && relement);
+
+    // done
+    return hash_map->element_name.comp(&hash_map->element_name, ((tb_flat_hash_map_item_ref_t)lelement)->name, ((tb_flat_hash_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_flat_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->group_size * TB_FLAT_HASH_MAP_GROUP);
+    tb_assert(hash_map->ctrl[itor - 1] & TB_FLAT_HASH_MAP_TAG_FULL);
+
+    // the item
+    tb_byte_t* item = tb_flat_hash_map_slot(hash_map, itor - 1);
+
+    // free slot, we need rehash it before freeing name
+    tb_flat_hash_map_slot_free(hash_map, itor - 1, tb_flat_hash_map_hash(hash_map, hash_map->element_name.data(&hash_map->element_name, item)));
+
+    // free item
+    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+
+    // update the item size
+    hash_map->item_size--;
+}
+static tb_void_t tb_flat_hash_map_itor_nremove(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_assert(iterator);
+
+    // no size
+    tb_check_return(size);
+
+    // remove items: [itor, next), the other items will not be moved after removing
+    tb_size_t itor = prev? tb_flat_hash_map_itor_next(iterator, prev) : tb_flat_hash_map_itor_head(iterator);
+    while (itor && itor != next && size--)
+    {
+        // the next item
+        tb_size_t item_next = tb_flat_hash_map_itor_next(iterator, itor);
+
+        // remove it
+        tb_flat_hash_map_itor_remove(iterator, itor);
+
+        // next
+        itor = item_next;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_flat_hash_map_ref_t tb_flat_hash_map_init(tb_size_t slot_size, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // check slot size
+    if (!slot_size) slot_size = TB_FLAT_HASH_MAP_SLOT_SIZE_DEFAULT;
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_flat_hash_map_t*     hash_map = tb_null;
+    do
+    {
+        // make self
+        hash_map = tb_malloc0_type(tb_flat_hash_map_t);
+        tb_assert_and_check_break(hash_map);
+
+        // init self func
+        hash_map->element_name = element_name;
+        hash_map->element_data = element_data;
+        hash_map->item_step    = element_name.size + element_data.size;
+
+        // init operation
+        static tb_iterator_op_t op =
+        {
+            tb_flat_hash_map_itor_size
+        ,   tb_flat_hash_map_itor_head
+        ,   tb_null
+        ,   tb_flat_hash_map_itor_tail
+        ,   tb_null
+        ,   tb_flat_hash_map_itor_next
+        ,   tb_flat_hash_map_itor_item
+        ,   tb_flat_hash_map_itor_comp
+        ,   tb_flat_hash_map_itor_copy
+        ,   tb_flat_hash_map_itor_remove
+        ,   tb_flat_hash_map_itor_nremove
+        };
+
+        // init iterator
+        hash_map->itor.priv = tb_null;
+        hash_map->itor.step = sizeof(tb_flat_hash_map_item_t);
+        hash_map->itor.mode = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_MUTABLE;
+        hash_map->itor.op   = &op;
+
+        // init slots
+        tb_size_t group_size = tb_align_pow2((slot_size + TB_FLAT_HASH_MAP_GROUP - 1) / TB_FLAT_HASH_MAP_GROUP);
+        if (!tb_flat_hash_map_resize(hash_map, group_size)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (hash_map) tb_flat_hash_map_exit((tb_flat_hash_map_ref_t)hash_map);
+        hash_map = tb_null;
+    }
+
+    // ok?
+    return (tb_flat_hash_map_ref_t)hash_map;
+}
+tb_void_t tb_flat_hash_map_exit(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // clear it
+    if (hash_map->ctrl) tb_flat_hash_map_clear(self);
+
+    // free slots
+    if (hash_map->ctrl) tb_free(hash_map->ctrl);
+    if (hash_map->slots) tb_free(hash_map->slots);
+
+    // free it
+    tb_free(hash_map);
+}
+tb_void_t tb_flat_hash_map_clear(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->ctrl);
+
+    // free items
+    tb_size_t slot_size = hash_map->group_size * TB_FLAT_HASH_MAP_GROUP;
+    if (hash_map->item_size && (hash_map->element_name.free || hash_map->element_data.free))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < slot_size; i += TB_FLAT_HASH_MAP_GROUP)
+        {
+            tb_uint32_t full = tb_flat_hash_map_group_full(hash_map->ctrl + i);
+            while (full)
+            {
+                tb_byte_t* item = tb_flat_hash_map_slot(hash_map, i + tb_bits_cl0_u32_le(full));
+                if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+                if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+                full &= full - 1;
+            }
+        }
+    }
+
+    // clear tags and overflow counts
+    tb_memset(hash_map->ctrl, 0, slot_size + hash_map->group_size);
+
+    // reset info
+    hash_map->item_size = 0;
+    tb_memset(&hash_map->item, 0, sizeof(tb_flat_hash_map_item_t));
+}
+tb_pointer_t tb_flat_hash_map_get(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_null);
+
+    // find it
+    tb_size_t itor = tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name));
+    tb_check_return_val(itor, tb_null);
+
+    // get data
+    return hash_map->element_data.data(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, itor - 1) + hash_map->element_name.size);
+}
+tb_size_t tb_flat_hash_map_find(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    return tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name));
+}
+tb_size_t tb_flat_hash_map_insert(tb_flat_hash_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && hash_map->ctrl, 0);
+
+    // find it
+    tb_size_t hash = tb_flat_hash_map_hash(hash_map, name);
+    tb_size_t itor = tb_flat_hash_map_slot_find(hash_map, name, hash);
+    if (itor)
+    {
+        // replace data
+        hash_map->element_data.repl(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, itor - 1) + hash_map->element_name.size, data);
+    }
+    else
+    {
+        // grow it if the load factor is too large
+        if (hash_map->item_size + 1 > tb_flat_hash_map_load_maxn(hash_map->group_size * TB_FLAT_HASH_MAP_GROUP))
+        {
+            tb_size_t group_size = hash_map->group_size << 1;
+            tb_assert_and_check_return_val(group_size > hash_map->group_size, 0);
+            if (!tb_flat_hash_map_resize(hash_map, group_size)) return 0;
+        }
+
+        // alloc a free slot
+        itor = tb_flat_hash_map_slot_alloc(hash_map, hash);
+        tb_assert_and_check_return_val(itor, 0);
+
+        // dupl item
+        tb_byte_t* item = tb_flat_hash_map_slot(hash_map, itor - 1);
+        hash_map->element_name.dupl(&hash_map->element_name, item, name);
+        hash_map->element_data.dupl(&hash_map->element_data, item + hash_map->element_name.size, data);
+
+        // update the item size
+        hash_map->item_size++;
+    }
+
+    // ok?
+    return itor;
+}
+tb_void_t tb_flat_hash_map_remove(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // find it
+    tb_size_t itor = tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name));
+    if (itor) tb_flat_hash_map_itor_remove((tb_iterator_ref_t)hash_map, itor);
+}
+tb_size_t tb_flat_hash_map_size(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the size
+    return hash_map->item_size;
+}
+tb_size_t tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the maxn
+    return hash_map->group_size * TB_FLAT_HASH_MAP_GROUP;
+}
+#ifdef __tb_debug__
+tb_void_t tb_flat_hash_map_dump(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->ctrl);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("self: size: %lu, maxn: %lu, groups: %lu", tb_flat_hash_map_size(self), tb_flat_hash_map_maxn(self), hash_map->group_size);
+
+    // done
+    tb_size_t i = 0;
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    for (i = 0; i < hash_map->group_size; i++)
+    {
+        // the group
+        tb_uint32_t full = tb_flat_hash_map_group_full(hash_map->ctrl + i * TB_FLAT_HASH_MAP_GROUP);
+        tb_check_continue(full || hash_map->overflow[i]);
+
+        // trace
+        tb_trace_i("group[%lu]: size: %lu, overflow: %u", i, tb_bits_cb1_u32(full), hash_map->overflow[i]);
+
+        // dump items
+        while (full)
+        {
+            // the item
+            tb_byte_t const* item = tb_flat_hash_map_slot(hash_map, i * TB_FLAT_HASH_MAP_GROUP + tb_bits_cl0_u32_le(full));
+
+            // the item name
+            tb_pointer_t element_name = hash_map->element_name.data(&hash_map->element_name, item);
+
+            // the item data
+            tb_pointer_t element_data = hash_map->element_data.data(&hash_map->element_data, item + hash_map->element_name.size);
+
+            // trace
+            if (hash_map->element_name.cstr && hash_map->element_data.cstr)
+            {
+                tb_trace_i("    %s => %s", hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, element_data, data, sizeof(data)));
+            }
+            else if (hash_map->element_name.cstr)
+            {
+                tb_trace_i("    %s => %p", hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), element_data);
+            }
+            else if (hash_map->element_data.cstr)
+            {
+                tb_trace_i("    %p => %s", element_name, hash_map->element_data.cstr(&hash_map->element_data, element_data, data, sizeof(data)));
+            }
+            else
+            {
+                tb_trace_i("    %p => %p", element_name, element_data);
+            }
+
+            // next
+            full &= full - 1;
+        }
+    }
+}
+#endif
@@ -0,0 +1,193 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_FLAT_HASH_MAP_H
+#define TB_CONTAINER_FLAT_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+#include "hash_map.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the flat hash map group size, the slot count probed at once
+#define TB_FLAT_HASH_MAP_GROUP_SIZE                 (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the flat hash map item type, it is compatible with the hash map item
+typedef tb_hash_map_item_t                          tb_flat_hash_map_item_t;
+
+/// the flat hash map item ref type
+typedef tb_hash_map_item_ref_t                      tb_flat_hash_map_item_ref_t;
+
+/*! the flat hash map ref type
+ *
+ * an open-addressing hash map with inline slots (swiss table),
+ * each group of 16 slots has 16 control bytes which are probed at once by sse2/neon.
+ *
+ * <pre>
+ *               group: 0            group: 1                   group: n
+ * ctrl:      |tag|tag|...|tag|  |tag|tag|...|tag|   ...   |tag|tag|...|tag|
+ *              |   |
+ * slots:     |name,data|name,data|...                      |name,data|...
+ *
+ * overflow:  |   count    |  |   count    |         ...   |   count    |
+ *
+ * tag: 0x00: empty, 0x80 | h2: full, h2 is the low 7 bits of the hash value
+ * count: the count of the items which have passed over this full group when inserting
+ *
+ * </pre>
+ *
+ * the group is found by the high bits of the hash value and probed quadratically,
+ * the lookup stops at the first group without any overflow items,
+ * so we need not tombstones and the removed slot can be reused directly.
+ *
+ * @note the itor of the same item is mutable
+ */
+typedef tb_iterator_ref_t tb_flat_hash_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init flat hash map
+ *
+ * @param slot_size     the initial slot size, using the default size if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the flat hash map
+ */
+tb_flat_hash_map_ref_t  tb_flat_hash_map_init(tb_size_t slot_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_exit(tb_flat_hash_map_ref_t hash_map);
+
+/*! clear flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_clear(tb_flat_hash_map_ref_t hash_map);
+
+/*! get item data from name
+ *
+ * @note
+ * the return value may be zero if the item type is integer
+ * so we need call tb_flat_hash_map_find for judging whether to get value successfully
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_flat_hash_map_get(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! find item from name
+ *
+ * @code
+ *
+ * // find item
+ * tb_size_t itor = tb_flat_hash_map_find(hash_map, name);
+ * if (itor != tb_iterator_tail(hash_map))
+ * {
+ *      // get data
+ *      tb_flat_hash_map_item_ref_t item = (tb_flat_hash_map_item_ref_t)tb_iterator_item(hash_map, itor);
+ *      tb_assert(item);
+ *
+ *      // remove it
+ *      tb_iterator_remove(hash_map, itor);
+ * }
+ * @endcode
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_flat_hash_map_find(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_flat_hash_map_insert(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ */
+tb_void_t               tb_flat_hash_map_remove(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! the flat hash map size
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map size
+ */
+tb_size_t               tb_flat_hash_map_size(tb_flat_hash_map_ref_t hash_map);
+
+/*! the flat hash map maxn
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map slot count
+ */
+tb_size_t               tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t hash_map);
+
+#ifdef __tb_debug__
+/*! dump flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_dump(tb_flat_hash_map_ref_t hash_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
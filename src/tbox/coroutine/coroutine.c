@@ -33,6 +33,17 @@
 #include "scheduler.h"
 #include "impl/impl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_void_t tb_coroutine_io_init(tb_poller_io_ref_t io, tb_size_t code, tb_socket_ref_t sock, tb_long_t timeout)
+{
+    tb_memset(io, 0, sizeof(tb_poller_io_t));
+    io->code    = (tb_uint8_t)code;
+    io->sock    = sock;
+    io->timeout = timeout;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -100,6 +111,134 @@ tb_long_t tb_coroutine_waitfs(tb_poller_object_ref_t object, tb_fwatcher_event_t
     // wait fwatcher event
     return scheduler? tb_co_scheduler_wait_fwatcher(scheduler, object, pevent, timeout) : -1;
 }
+tb_long_t tb_coroutine_recv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && data && size, -1);
+
+    // get current scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_check_return_val(scheduler, -1);
+
+    // recv it directly first, we need not switch the coroutine if the socket is ready
+    tb_long_t real = tb_socket_recv(sock, data, size);
+    tb_check_return_val(!real, real);
+
+    // recv it by the completion-based poller
+    tb_poller_io_t io;
+    tb_coroutine_io_init(&io, TB_POLLER_IOCODE_RECV, sock, timeout);
+    io.flags = TB_POLLER_IOFLAG_NOTREADY;
+    io.data = data;
+    io.size = size;
+    if (tb_co_scheduler_post(scheduler, &io))
+        return io.state == TB_STATE_OK? (io.result > 0? io.result : -1) : (io.state == TB_STATE_TIMEOUT? 0 : -1);
+
+    // recv it after waiting the readiness events
+    tb_poller_object_t object;
+    object.type     = TB_POLLER_OBJECT_SOCK;
+    object.ref.sock = sock;
+    tb_long_t wait = tb_co_scheduler_wait(scheduler, &object, TB_POLLER_EVENT_RECV, timeout);
+    tb_check_return_val(wait > 0, wait);
+
+    // recv it again, it has been closed if no data
+    real = tb_socket_recv(sock, data, size);
+    return real? real : -1;
+}
+tb_long_t tb_coroutine_send(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && data && size, -1);
+
+    // get current scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_check_return_val(scheduler, -1);
+
+    // send it directly first, we need not switch the coroutine if the socket is ready
+    tb_long_t real = tb_socket_send(sock, data, size);
+    tb_check_return_val(!real, real);
+
+    // send it by the completion-based poller
+    tb_poller_io_t io;
+    tb_coroutine_io_init(&io, TB_POLLER_IOCODE_SEND, sock, timeout);
+    io.flags = TB_POLLER_IOFLAG_NOTREADY;
+    io.data = (tb_byte_t*)data;
+    io.size = size;
+    if (tb_co_scheduler_post(scheduler, &io))
+        return io.state == TB_STATE_OK? (io.result > 0? io.result : -1) : (io.state == TB_STATE_TIMEOUT? 0 : -1);
+
+    // send it after waiting the readiness events
+    tb_poller_object_t object;
+    object.type     = TB_POLLER_OBJECT_SOCK;
+    object.ref.sock = sock;
+    tb_long_t wait = tb_co_scheduler_wait(scheduler, &object, TB_POLLER_EVENT_SEND, timeout);
+    tb_check_return_val(wait > 0, wait);
+
+    // send it again, it has been closed if no data
+    real = tb_socket_send(sock, data, size);
+    return real? real : -1;
+}
+tb_socket_ref_t tb_coroutine_accept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock, tb_null);
+
+    // get current scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_check_return_val(scheduler, tb_null);
+
+    // accept it directly first
+    tb_socket_ref_t client = tb_socket_accept(sock, addr);
+    tb_check_return_val(!client, client);
+
+    // accept it by the completion-based poller
+    tb_poller_io_t io;
+    tb_coroutine_io_init(&io, TB_POLLER_IOCODE_ACPT, sock, timeout);
+    if (tb_co_scheduler_post(scheduler, &io))
+    {
+        if (io.client && addr) tb_ipaddr_copy(addr, &io.addr);
+        return io.client;
+    }
+
+    // accept it after waiting the readiness events
+    tb_poller_object_t object;
+    object.type     = TB_POLLER_OBJECT_SOCK;
+    object.ref.sock = sock;
+    if (tb_co_scheduler_wait(scheduler, &object, TB_POLLER_EVENT_ACPT, timeout) > 0)
+        client = tb_socket_accept(sock, addr);
+    return client;
+}
+tb_long_t tb_coroutine_connect(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && addr && !tb_ipaddr_is_empty(addr), -1);
+
+    // get current scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_check_return_val(scheduler, -1);
+
+    // connect it by the completion-based poller
+    tb_poller_io_t io;
+    tb_coroutine_io_init(&io, TB_POLLER_IOCODE_CONN, sock, timeout);
+    tb_ipaddr_copy(&io.addr, addr);
+    if (tb_co_scheduler_post(scheduler, &io))
+        return io.state == TB_STATE_OK? 1 : (io.state == TB_STATE_TIMEOUT? 0 : -1);
+
+    // connect it after waiting the readiness events
+    tb_poller_object_t object;
+    object.type     = TB_POLLER_OBJECT_SOCK;
+    object.ref.sock = sock;
+    tb_long_t ok = tb_socket_connect(sock, addr);
+    if (!ok)
+    {
+        tb_long_t wait = tb_co_scheduler_wait(scheduler, &object, TB_POLLER_EVENT_CONN, timeout);
+        tb_check_return_val(wait > 0, wait);
+
+        // connect it again to get the result
+        ok = tb_socket_connect(sock, addr);
+        if (!ok) ok = -1;
+    }
+    return ok;
+}
 tb_coroutine_ref_t tb_coroutine_self()
 {
     // get coroutine
@@ -53,6 +53,9 @@ typedef tb_void_t       (*tb_coroutine_func_t)(tb_cpointer_t priv);
  */
 
 /*! start coroutine
+ *
+ * the new coroutine can be stolen by the other idle workers before it runs for the M:N mode,
+ * but it's bound to the worker which runs it first and will never be migrated after it has been started.
  *
  * @param scheduler     the scheduler, uses the current scheduler if be null
  * @param func          the coroutine function
@@ -64,6 +67,9 @@ typedef tb_void_t       (*tb_coroutine_func_t)(tb_cpointer_t priv);
 tb_bool_t               tb_coroutine_start(tb_co_scheduler_ref_t scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
 /*! yield the current coroutine
+ *
+ * it's only switched to the other coroutines in the same worker for the M:N mode,
+ * the started coroutine will not be stolen by the other idle workers.
  *
  * @return              tb_true(yield ok) or tb_false(yield failed, no more coroutines)
  */
@@ -75,6 +81,9 @@ tb_bool_t               tb_coroutine_yield(tb_noarg_t);
  * @param priv          the user private data as the return value of suspend() or sleep()
  *
  * @return              the user private data from suspend(priv)
+ *
+ * @note it will be resumed asynchronously in its worker if it belongs to the other worker for the M:N mode,
+ * so it always returns tb_null and we cannot get the user private data from suspend(priv) synchronously.
  */
 tb_pointer_t            tb_coroutine_resume(tb_coroutine_ref_t coroutine, tb_cpointer_t priv);
 
@@ -124,6 +133,51 @@ tb_long_t               tb_coroutine_waitproc(tb_poller_object_ref_t object, tb_
  */
 tb_long_t               tb_coroutine_waitfs(tb_poller_object_ref_t object, tb_fwatcher_event_t* pevent, tb_long_t timeout);
 
+/*! recv the socket data
+ *
+ * it will be completed by the kernel directly if the scheduler uses the io_uring poller (TB_CO_SCHEDULER_FLAG_IOURING),
+ * otherwise we wait the readiness events and recv it.
+ *
+ * @param sock          the socket
+ * @param data          the data
+ * @param size          the size
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              > 0: the real size, 0: timeout, -1: failed or closed
+ */
+tb_long_t               tb_coroutine_recv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size, tb_long_t timeout);
+
+/*! send the socket data
+ *
+ * @param sock          the socket
+ * @param data          the data
+ * @param size          the size
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              > 0: the real size, 0: timeout, -1: failed
+ */
+tb_long_t               tb_coroutine_send(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size, tb_long_t timeout);
+
+/*! accept the client socket
+ *
+ * @param sock          the listened socket
+ * @param addr          the client address, maybe null
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              the client socket, it will return tb_null if timeout or failed
+ */
+tb_socket_ref_t         tb_coroutine_accept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout);
+
+/*! connect to the given address
+ *
+ * @param sock          the socket
+ * @param addr          the address
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              1: ok, 0: timeout, -1: failed
+ */
+tb_long_t               tb_coroutine_connect(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout);
+
 /*! get the current coroutine
  *
  * @return              the current coroutine
@@ -123,6 +123,11 @@ tb_coroutine_t* tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_coroutine_
         // save scheduler
         coroutine->scheduler = scheduler;
 
+        // init the inbox for the M:N mode
+        coroutine->inbox_next = tb_null;
+        coroutine->inbox_priv = tb_null;
+        coroutine->is_grouped = 0;
+
         // init stack
         coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
         coroutine->stacksize = stacksize;
@@ -199,6 +204,11 @@ tb_coroutine_t* tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func
         else stacksize = coroutine->stacksize;
         tb_assert_and_check_break(coroutine && coroutine->scheduler);
 
+        // reset the inbox for the M:N mode
+        coroutine->inbox_next = tb_null;
+        coroutine->inbox_priv = tb_null;
+        coroutine->is_grouped = 0;
+
         // init stack
         coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
         coroutine->stacksize = stacksize;
@@ -63,7 +63,7 @@ typedef struct __tb_coroutine_rs_wait_t
     // the waited poller object
     tb_poller_object_t              object;
 
-    // the timer task pointer for ltimer or timer
+    // the timer task pointer
     tb_cpointer_t                   task;
 
     // the object event, (process status or fwatcher event)
@@ -75,9 +75,6 @@ typedef struct __tb_coroutine_rs_wait_t
     // waiting process?
     tb_uint16_t                     object_waiting  : 1;
 
-    // is ltimer?
-    tb_uint16_t                     is_ltimer     : 1;
-
 }tb_coroutine_rs_wait_t;
 
 // the coroutine type
@@ -118,6 +115,18 @@ typedef struct __tb_coroutine_t
 
     }                               rs;
 
+    // the next coroutine in the inbox of the scheduler, only for the M:N mode
+    struct __tb_coroutine_t*        inbox_next;
+
+    // the user private data passed by resume(priv) from the other scheduler, only for the M:N mode
+    tb_cpointer_t                   inbox_priv;
+
+    // the sent data of the waiting coroutine in the channel, it's only accessed with the channel lock
+    tb_cpointer_t                   channel_data;
+
+    // is counted by the scheduler group? only for the M:N mode
+    tb_uint16_t                     is_grouped;
+
     // the guard
     tb_uint16_t                     guard;
 
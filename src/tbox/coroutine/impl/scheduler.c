@@ -44,6 +44,12 @@
 #   define TB_SCHEDULER_DEAD_CACHE_MAXN     (256)
 #endif
 
+// the ready coroutines minimum count, we only pull the new coroutines from the local deque if be less than it
+#define TB_SCHEDULER_READY_MINN             (16)
+
+// the maximum count of the pulled or stolen coroutines at once
+#define TB_SCHEDULER_PULL_MAXN              (64)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -92,6 +98,375 @@ static tb_void_t tb_co_scheduler_make_suspend(tb_co_scheduler_t* scheduler, tb_c
     // append this coroutine to suspend coroutines
     tb_list_entry_insert_tail(&scheduler->coroutines_suspend, (tb_list_entry_ref_t)coroutine);
 }
+static tb_coroutine_t* tb_co_scheduler_make(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_assert(scheduler && func);
+
+    // reuses dead coroutines in init function
+    tb_coroutine_t* coroutine = tb_null;
+    if (tb_list_entry_size(&scheduler->coroutines_dead))
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+        tb_assert_and_check_return_val(entry, tb_null);
+
+        // remove it from the ready coroutines
+        tb_list_entry_remove_head(&scheduler->coroutines_dead);
+
+        // get the dead coroutine
+        tb_coroutine_t* coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
+
+        // reinit this coroutine
+        coroutine = tb_coroutine_reinit(coroutine_dead, func, priv, stacksize);
+
+        // failed? exit this coroutine
+        if (!coroutine) tb_coroutine_exit(coroutine_dead);
+    }
+
+    // init coroutine
+    if (!coroutine) coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize);
+    tb_assert_and_check_return_val(coroutine, tb_null);
+
+    // the dead coroutines is too much? free some coroutines
+    while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+        tb_assert(entry);
+
+        // remove it from the ready coroutines
+        tb_list_entry_remove_head(&scheduler->coroutines_dead);
+
+        // exit this coroutine
+        tb_coroutine_exit((tb_coroutine_t*)tb_list_entry0(entry));
+    }
+
+    // ok
+    return coroutine;
+}
+static __tb_inline__ tb_long_t tb_co_scheduler_deque_size(tb_co_scheduler_t* scheduler)
+{
+    tb_long_t size = tb_atomic_get_explicit(&scheduler->deque_bottom, TB_ATOMIC_ACQUIRE) - tb_atomic_get_explicit(&scheduler->deque_top, TB_ATOMIC_ACQUIRE);
+    return size > 0? size : 0;
+}
+static tb_bool_t tb_co_scheduler_deque_push(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check, only the owner scheduler can push it
+    tb_assert(scheduler && scheduler->deque && coroutine);
+
+    // full?
+    tb_long_t bottom = tb_atomic_get_explicit(&scheduler->deque_bottom, TB_ATOMIC_RELAXED);
+    tb_long_t top = tb_atomic_get_explicit(&scheduler->deque_top, TB_ATOMIC_ACQUIRE);
+    tb_check_return_val(bottom - top < TB_SCHEDULER_DEQUE_MAXN, tb_false);
+
+    // push it to the bottom and publish it to the thieves
+    tb_atomic_set_explicit(&scheduler->deque[bottom & (TB_SCHEDULER_DEQUE_MAXN - 1)], (tb_long_t)coroutine, TB_ATOMIC_RELAXED);
+    tb_atomic_set_explicit(&scheduler->deque_bottom, bottom + 1, TB_ATOMIC_RELEASE);
+    return tb_true;
+}
+static tb_coroutine_t* tb_co_scheduler_deque_pop(tb_co_scheduler_t* scheduler)
+{
+    // check, only the owner scheduler can pop it
+    tb_assert(scheduler && scheduler->deque);
+
+    // reserve the bottom coroutine first
+    tb_long_t bottom = tb_atomic_get_explicit(&scheduler->deque_bottom, TB_ATOMIC_RELAXED) - 1;
+    tb_atomic_set_explicit(&scheduler->deque_bottom, bottom, TB_ATOMIC_RELAXED);
+    tb_memory_barrier();
+    tb_long_t top = tb_atomic_get_explicit(&scheduler->deque_top, TB_ATOMIC_RELAXED);
+
+    // empty?
+    tb_coroutine_t* coroutine = tb_null;
+    if (top <= bottom)
+    {
+        // get the bottom coroutine
+        coroutine = (tb_coroutine_t*)tb_atomic_get_explicit(&scheduler->deque[bottom & (TB_SCHEDULER_DEQUE_MAXN - 1)], TB_ATOMIC_RELAXED);
+
+        // the last coroutine? we need race with the thieves
+        if (top == bottom)
+        {
+            if (!tb_atomic_compare_and_swap_explicit(&scheduler->deque_top, &top, top + 1, TB_ATOMIC_SEQ_CST, TB_ATOMIC_RELAXED))
+                coroutine = tb_null;
+            tb_atomic_set_explicit(&scheduler->deque_bottom, bottom + 1, TB_ATOMIC_RELAXED);
+        }
+    }
+    else tb_atomic_set_explicit(&scheduler->deque_bottom, bottom + 1, TB_ATOMIC_RELAXED);
+
+    // ok?
+    return coroutine;
+}
+static tb_coroutine_t* tb_co_scheduler_deque_steal(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler && scheduler->deque);
+
+    // empty?
+    tb_long_t top = tb_atomic_get_explicit(&scheduler->deque_top, TB_ATOMIC_ACQUIRE);
+    tb_memory_barrier();
+    tb_long_t bottom = tb_atomic_get_explicit(&scheduler->deque_bottom, TB_ATOMIC_ACQUIRE);
+    tb_check_return_val(top < bottom, tb_null);
+
+    // steal the top coroutine, it may be failed if other thieves or the owner has taken it
+    tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_atomic_get_explicit(&scheduler->deque[top & (TB_SCHEDULER_DEQUE_MAXN - 1)], TB_ATOMIC_RELAXED);
+    return tb_atomic_compare_and_swap_explicit(&scheduler->deque_top, &top, top + 1, TB_ATOMIC_SEQ_CST, TB_ATOMIC_RELAXED)? coroutine : tb_null;
+}
+static tb_void_t tb_co_scheduler_wakeup(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // spak the poller of this scheduler
+    tb_co_scheduler_io_ref_t scheduler_io = (tb_co_scheduler_io_ref_t)scheduler->scheduler_io;
+    if (scheduler_io && scheduler_io->poller) tb_poller_spak(scheduler_io->poller);
+}
+static tb_void_t tb_co_scheduler_wakeup_idle(tb_co_scheduler_group_t* group)
+{
+    // check
+    tb_assert(group);
+
+    // no idle schedulers?
+    tb_check_return(tb_atomic32_get(&group->idle) > 0);
+
+    // wake up one idle scheduler to pull the new coroutines
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        tb_co_scheduler_t* scheduler = group->schedulers[i];
+        tb_int32_t idle = 1;
+        if (tb_atomic32_compare_and_swap(&scheduler->idle, &idle, 0))
+        {
+            tb_atomic32_fetch_and_sub(&group->idle, 1);
+            tb_co_scheduler_wakeup(scheduler);
+            break;
+        }
+    }
+}
+static tb_void_t tb_co_scheduler_adopt(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(scheduler && coroutine);
+
+    /* bind this new coroutine to the current scheduler, it will never be migrated after running
+     *
+     * its sockets are added to the poller of this scheduler and its timers are in this scheduler,
+     * so we only balance the new coroutines and the started coroutines cannot be stolen.
+     */
+    coroutine->scheduler = (tb_co_scheduler_ref_t)scheduler;
+
+    // ready coroutine
+    tb_co_scheduler_make_ready(scheduler, coroutine);
+}
+static tb_size_t tb_co_scheduler_pull_global(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler->group;
+    tb_assert(group);
+
+    // enter
+    tb_spinlock_enter(&group->lock);
+
+    // pull some new coroutines from the global coroutines
+    tb_size_t count = 0;
+    while (count < TB_SCHEDULER_PULL_MAXN && tb_list_entry_size(&group->coroutines_global))
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&group->coroutines_global);
+        tb_assert(entry);
+
+        // remove it from the global coroutines
+        tb_list_entry_remove_head(&group->coroutines_global);
+
+        // adopt this coroutine
+        tb_co_scheduler_adopt(scheduler, (tb_coroutine_t*)tb_list_entry0(entry));
+        count++;
+    }
+
+    // has more coroutines?
+    tb_bool_t more = tb_list_entry_size(&group->coroutines_global) > 0;
+
+    // leave
+    tb_spinlock_leave(&group->lock);
+
+    // wake up the other idle scheduler to pull the left coroutines
+    if (more) tb_co_scheduler_wakeup_idle(group);
+    return count;
+}
+static tb_size_t tb_co_scheduler_steal(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler->group;
+    tb_assert(group);
+
+    // pull the global coroutines first
+    tb_size_t count = tb_co_scheduler_pull_global(scheduler);
+    tb_check_return_val(!count, count);
+
+    // steal the half of the new coroutines from the other schedulers, we start from the next scheduler
+    tb_size_t i = 0;
+    tb_size_t n = group->count;
+    tb_size_t self = 0;
+    while (self < n && group->schedulers[self] != scheduler) self++;
+    for (i = 1; i < n && !count; i++)
+    {
+        // steal one coroutine at least
+        tb_co_scheduler_t* victim = group->schedulers[(self + i) % n];
+        tb_coroutine_t* coroutine = tb_co_scheduler_deque_steal(victim);
+        tb_check_continue(coroutine);
+
+        // adopt it
+        tb_co_scheduler_adopt(scheduler, coroutine);
+        count++;
+
+        // steal more coroutines
+        tb_long_t half = tb_co_scheduler_deque_size(victim) >> 1;
+        while (half-- > 0 && count < TB_SCHEDULER_PULL_MAXN)
+        {
+            coroutine = tb_co_scheduler_deque_steal(victim);
+            tb_check_break(coroutine);
+            tb_co_scheduler_adopt(scheduler, coroutine);
+            count++;
+        }
+
+        // this victim has more coroutines? wake up the other idle scheduler to steal them
+        if (tb_co_scheduler_deque_size(victim)) tb_co_scheduler_wakeup_idle(group);
+    }
+
+    // trace
+    if (count) tb_trace_d("[steal]: %lu coroutines for scheduler(%p)", count, scheduler);
+    return count;
+}
+/* resume the coroutine of the other scheduler for the M:N mode
+ *
+ * we cannot return the private data from suspend(priv) here,
+ * because its scheduler may be still suspending it and writing it now.
+ */
+static tb_void_t tb_co_scheduler_resume_remote(tb_coroutine_t* coroutine, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(coroutine);
+
+    // get the scheduler of this coroutine
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine);
+    tb_assert(scheduler && scheduler->group);
+
+    // trace
+    tb_trace_d("resume coroutine(%p) of scheduler(%p) remotely", coroutine, scheduler);
+
+    // save the user private data, it will be passed to suspend() in its scheduler
+    coroutine->inbox_priv = priv;
+
+    // push it to the inbox of its scheduler
+    tb_long_t head = tb_atomic_get_explicit(&scheduler->inbox, TB_ATOMIC_RELAXED);
+    do
+    {
+        coroutine->inbox_next = (tb_coroutine_t*)head;
+
+    } while (!tb_atomic_compare_and_swap_explicit(&scheduler->inbox, &head, (tb_long_t)coroutine, TB_ATOMIC_RELEASE, TB_ATOMIC_RELAXED));
+
+    // the inbox was empty? wake up this scheduler
+    if (!head) tb_co_scheduler_wakeup(scheduler);
+}
+static tb_size_t tb_co_scheduler_pull_inbox(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // take all resumed coroutines
+    tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_atomic_fetch_and_set(&scheduler->inbox, 0);
+    tb_check_return_val(coroutine, 0);
+    tb_memory_barrier();
+
+    // reverse them to resume them in order
+    tb_coroutine_t* prev = tb_null;
+    while (coroutine)
+    {
+        tb_coroutine_t* next = coroutine->inbox_next;
+        coroutine->inbox_next = prev;
+        prev = coroutine;
+        coroutine = next;
+    }
+
+    // resume them
+    tb_size_t count = 0;
+    coroutine = prev;
+    while (coroutine)
+    {
+        tb_coroutine_t* next = coroutine->inbox_next;
+        coroutine->inbox_next = tb_null;
+        tb_co_scheduler_resume(scheduler, coroutine, coroutine->inbox_priv);
+        coroutine = next;
+        count++;
+    }
+    return count;
+}
+static tb_bool_t tb_co_scheduler_start_group(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler->group;
+    tb_assert(group && func);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_coroutine_t* coroutine = tb_null;
+    do
+    {
+        // have been stopped? do not continue to start new coroutines
+        tb_check_break(!scheduler->stopped);
+
+        // get the current scheduler
+        tb_co_scheduler_t* self = (tb_co_scheduler_t*)tb_co_scheduler_self();
+
+        // in the scheduler of this group? start it locally and it may be stolen by the other idle schedulers
+        if (self && self->group == group)
+        {
+            // make coroutine
+            coroutine = tb_co_scheduler_make(self, func, priv, stacksize);
+            tb_assert_and_check_break(coroutine);
+
+            // count it
+            coroutine->is_grouped = 1;
+            tb_atomic_fetch_and_add(&group->alive, 1);
+
+            // push it to the deque or ready it directly if the deque is full
+            if (tb_co_scheduler_deque_push(self, coroutine))
+            {
+                tb_memory_barrier();
+                tb_co_scheduler_wakeup_idle(group);
+            }
+            else tb_co_scheduler_make_ready(self, coroutine);
+        }
+        // in the other thread, e.g. before loop()
+        else
+        {
+            // init coroutine, we cannot reuse the dead coroutines of the other thread
+            coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize);
+            tb_assert_and_check_break(coroutine);
+
+            // count it
+            coroutine->is_grouped = 1;
+            tb_atomic_fetch_and_add(&group->alive, 1);
+
+            // push it to the global coroutines
+            tb_spinlock_enter(&group->lock);
+            tb_list_entry_insert_tail(&group->coroutines_global, (tb_list_entry_ref_t)coroutine);
+            tb_spinlock_leave(&group->lock);
+
+            // wake up one idle scheduler to pull it
+            tb_co_scheduler_wakeup_idle(group);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // trace
+    tb_trace_d("start %p in group %s", coroutine, ok? "ok" : "no");
+
+    // ok?
+    return ok;
+}
 static __tb_inline__ tb_coroutine_t* tb_co_scheduler_next_ready(tb_co_scheduler_t* scheduler)
 {
     // check
@@ -117,6 +492,21 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
     // check
     tb_assert(func);
 
+    // uses the current scheduler if be null
+    if (!scheduler) scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_assert_and_check_return_val(scheduler, tb_false);
+
+    // start it in the scheduler group for the M:N mode
+    if (scheduler->group) return tb_co_scheduler_start_group(scheduler, func, priv, stacksize);
+
+    // start it directly
+    return tb_co_scheduler_start_local(scheduler, func, priv, stacksize);
+}
+tb_bool_t tb_co_scheduler_start_local(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_assert(func);
+
     // done
     tb_bool_t       ok = tb_false;
     tb_coroutine_t* coroutine = tb_null;
@@ -132,47 +522,13 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         // have been stopped? do not continue to start new coroutines
         tb_check_break(!scheduler->stopped);
 
-        // reuses dead coroutines in init function
-        if (tb_list_entry_size(&scheduler->coroutines_dead))
-        {
-            // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
-            tb_assert_and_check_break(entry);
-
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
-
-            // get the dead coroutine
-            tb_coroutine_t* coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
-
-            // reinit this coroutine
-            coroutine = tb_coroutine_reinit(coroutine_dead, func, priv, stacksize);
-
-            // failed? exit this coroutine
-            if (!coroutine) tb_coroutine_exit(coroutine_dead);
-        }
-
-        // init coroutine
-        if (!coroutine) coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize);
+        // make coroutine
+        coroutine = tb_co_scheduler_make(scheduler, func, priv, stacksize);
         tb_assert_and_check_break(coroutine);
 
         // ready coroutine
         tb_co_scheduler_make_ready(scheduler, coroutine);
 
-        // the dead coroutines is too much? free some coroutines
-        while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
-        {
-            // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
-            tb_assert(entry);
-
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
-
-            // exit this coroutine
-            tb_coroutine_exit((tb_coroutine_t*)tb_list_entry0(entry));
-        }
-
         // ok
         ok = tb_true;
 
@@ -184,6 +540,75 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
     // ok?
     return ok;
 }
+tb_size_t tb_co_scheduler_pull(tb_co_scheduler_t* scheduler, tb_bool_t steal)
+{
+    // check
+    tb_assert(scheduler && scheduler->group);
+
+    // resume the coroutines which have been resumed by the other schedulers
+    tb_size_t count = tb_co_scheduler_pull_inbox(scheduler);
+
+    // ready some new coroutines from the local deque, the left coroutines can be stolen by the other idle schedulers
+    while (tb_co_scheduler_ready_count(scheduler) < TB_SCHEDULER_READY_MINN)
+    {
+        tb_coroutine_t* coroutine = tb_co_scheduler_deque_pop(scheduler);
+        tb_check_break(coroutine);
+
+        tb_co_scheduler_make_ready(scheduler, coroutine);
+        count++;
+    }
+
+    // no more local coroutines? pull or steal the new coroutines from the others
+    if (!count && steal) count = tb_co_scheduler_steal(scheduler);
+
+    // ok
+    return count;
+}
+tb_bool_t tb_co_scheduler_idle_enter(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler->group;
+    tb_assert(group);
+
+    // mark it as idle first
+    tb_atomic32_set(&scheduler->idle, 1);
+    tb_atomic32_fetch_and_add(&group->idle, 1);
+    tb_memory_barrier();
+
+    // check it again, the coroutines may be pushed before marking idle
+    tb_bool_t idle = tb_true;
+    if (tb_atomic_get(&scheduler->inbox) || !tb_co_scheduler_group_alive(group)) idle = tb_false;
+    else
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count && idle; i++)
+        {
+            if (tb_co_scheduler_deque_size(group->schedulers[i]))
+                idle = tb_false;
+        }
+        if (idle)
+        {
+            tb_spinlock_enter(&group->lock);
+            if (tb_list_entry_size(&group->coroutines_global)) idle = tb_false;
+            tb_spinlock_leave(&group->lock);
+        }
+    }
+
+    // leave idle if there are some coroutines
+    if (!idle) tb_co_scheduler_idle_leave(scheduler);
+    return idle;
+}
+tb_void_t tb_co_scheduler_idle_leave(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler->group;
+    tb_assert(group);
+
+    // leave idle if it has been not waked up by the others
+    tb_int32_t idle = 1;
+    if (tb_atomic32_compare_and_swap(&scheduler->idle, &idle, 0))
+        tb_atomic32_fetch_and_sub(&group->idle, 1);
+}
 tb_bool_t tb_co_scheduler_yield(tb_co_scheduler_t* scheduler)
 {
     // check
@@ -226,6 +651,13 @@ tb_pointer_t tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t
     // check
     tb_assert(scheduler && coroutine);
 
+    // the coroutine of the other scheduler? we need resume it in its scheduler for the M:N mode
+    if (scheduler->group && tb_coroutine_scheduler(coroutine) != (tb_co_scheduler_ref_t)scheduler)
+    {
+        tb_co_scheduler_resume_remote(coroutine, priv);
+        return tb_null;
+    }
+
     // trace
     tb_trace_d("resume coroutine(%p)", coroutine);
 
@@ -302,6 +734,21 @@ tb_void_t tb_co_scheduler_finish(tb_co_scheduler_t* scheduler)
     tb_coroutine_check(scheduler->running);
 #endif
 
+    // the last alive coroutine in the scheduler group? wake up all schedulers to stop them
+    if (scheduler->running->is_grouped)
+    {
+        tb_co_scheduler_group_t* group = scheduler->group;
+        tb_assert(group);
+
+        scheduler->running->is_grouped = 0;
+        if (tb_atomic_fetch_and_sub(&group->alive, 1) == 1)
+        {
+            tb_size_t i = 0;
+            for (i = 0; i < group->count; i++)
+                tb_co_scheduler_wakeup(group->schedulers[i]);
+        }
+    }
+
     // get the next ready coroutine first
     tb_coroutine_t* coroutine_next = tb_co_scheduler_next_ready(scheduler);
 
@@ -410,3 +857,18 @@ tb_long_t tb_co_scheduler_wait_fwatcher(tb_co_scheduler_t* scheduler, tb_poller_
     // wait it
     return tb_co_scheduler_io_wait_fwatcher(scheduler->scheduler_io, object, pevent, timeout);
 }
+tb_bool_t tb_co_scheduler_post(tb_co_scheduler_t* scheduler, tb_poller_io_ref_t io)
+{
+    // check
+    tb_assert(scheduler && scheduler->running);
+    tb_assert(scheduler->running == (tb_coroutine_t*)tb_coroutine_self());
+
+    // have been stopped? return it directly
+    tb_check_return_val(!scheduler->stopped, tb_false);
+
+    // need io scheduler
+    if (!tb_co_scheduler_io_need(scheduler)) return tb_false;
+
+    // post it
+    return tb_co_scheduler_io_post(scheduler->scheduler_io, io);
+}
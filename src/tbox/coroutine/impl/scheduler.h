@@ -37,6 +37,13 @@ __tb_extern_c_enter__
  * macros
  */
 
+// the deque maxn of the new coroutines for the M:N mode, must be pow2
+#ifdef __tb_small__
+#   define TB_SCHEDULER_DEQUE_MAXN                     (256)
+#else
+#   define TB_SCHEDULER_DEQUE_MAXN                     (4096)
+#endif
+
 // get the running coroutine
 #define tb_co_scheduler_running(scheduler)             ((scheduler)->running)
 
@@ -49,6 +56,9 @@ __tb_extern_c_enter__
 // get the io scheduler
 #define tb_co_scheduler_io(scheduler)                  ((scheduler)->scheduler_io)
 
+// get the alive coroutines count of the scheduler group
+#define tb_co_scheduler_group_alive(group)             ((tb_size_t)tb_atomic_get(&(group)->alive))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -56,6 +66,46 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_co_scheduler_io_t;
 
+// the scheduler type
+struct __tb_co_scheduler_t;
+
+/* the scheduler group type for the M:N mode
+ *
+ *                    global coroutines (not started)
+ *                                 |
+ *          ---------------------------------------------
+ *         |                       |                     |
+ * worker: scheduler0 <- steal -> scheduler1 <- steal -> schedulerN
+ *         - deque (new)           - deque               - deque
+ *         - inbox (resumed)       - inbox               - inbox
+ *         - poller, timer         - poller, timer       - poller, timer
+ *         - ready, suspend        - ready, suspend      - ready, suspend
+ */
+typedef struct __tb_co_scheduler_group_t
+{
+    // the schedulers, the first scheduler runs on the thread of loop()
+    struct __tb_co_scheduler_t**    schedulers;
+
+    // the schedulers count
+    tb_size_t                       count;
+
+    // the worker threads of the other schedulers
+    tb_thread_ref_t*                threads;
+
+    // the alive coroutines count, all schedulers will be stopped if it becomes zero
+    tb_atomic_t                     alive;
+
+    // the idle schedulers count
+    tb_atomic32_t                   idle;
+
+    // the lock for the global coroutines
+    tb_spinlock_t                   lock;
+
+    // the global coroutines which have been not started, e.g. started before loop() or from the other threads
+    tb_list_entry_head_t            coroutines_global;
+
+}tb_co_scheduler_group_t;
+
 // the scheduler type
 typedef struct __tb_co_scheduler_t
 {
@@ -74,6 +124,9 @@ typedef struct __tb_co_scheduler_t
     // the io scheduler
     struct __tb_co_scheduler_io_t*  scheduler_io;
 
+    // the poller type of the io scheduler, e.g. TB_POLLER_TYPE_IOURING, use the default poller if be TB_POLLER_TYPE_NONE
+    tb_size_t                       poller_type;
+
     // the dead coroutines
     tb_list_entry_head_t            coroutines_dead;
 
@@ -88,6 +141,28 @@ typedef struct __tb_co_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+    // the scheduler group, only for the M:N mode
+    tb_co_scheduler_group_t*        group;
+
+    /* the new coroutines which have been not started, only for the M:N mode
+     *
+     * it's a lock-free work-stealing deque, only this scheduler can push and pop them,
+     * and the other idle schedulers can steal them
+     */
+    tb_atomic_t*                    deque;
+
+    // the top index of the deque, it will be changed by the thieves
+    tb_atomic_t                     deque_top;
+
+    // the bottom index of the deque, it will be changed by this scheduler
+    tb_atomic_t                     deque_bottom;
+
+    // the lock-free inbox stack of the coroutines resumed by the other schedulers, only for the M:N mode
+    tb_atomic_t                     inbox;
+
+    // is idle? it's waiting for the new coroutines, only for the M:N mode
+    tb_atomic32_t                   idle;
+
 }tb_co_scheduler_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -105,6 +180,42 @@ typedef struct __tb_co_scheduler_t
  */
 tb_bool_t                   tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
+/* start the coroutine function on the given scheduler directly
+ *
+ * it will not be stolen by the other schedulers and counted in the scheduler group, e.g. the io loop coroutine
+ *
+ * @param scheduler         the scheduler, uses the default scheduler if be null
+ * @param func              the coroutine function
+ * @param priv              the passed user private data as the argument of function
+ * @param stacksize         the stack size
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_co_scheduler_start_local(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+
+/* pull the resumed and new coroutines to the ready coroutines, only for the M:N mode
+ *
+ * @param scheduler         the scheduler
+ * @param steal             steal the new coroutines from the other schedulers if no local coroutines?
+ *
+ * @return                  the count of the new ready coroutines
+ */
+tb_size_t                   tb_co_scheduler_pull(tb_co_scheduler_t* scheduler, tb_bool_t steal);
+
+/* enter the idle state before waiting the poller, only for the M:N mode
+ *
+ * @param scheduler         the scheduler
+ *
+ * @return                  tb_true or tb_false (there are some coroutines to be pulled)
+ */
+tb_bool_t                   tb_co_scheduler_idle_enter(tb_co_scheduler_t* scheduler);
+
+/* leave the idle state after waiting the poller, only for the M:N mode
+ *
+ * @param scheduler         the scheduler
+ */
+tb_void_t                   tb_co_scheduler_idle_leave(tb_co_scheduler_t* scheduler);
+
 /* yield the current coroutine
  *
  * @param scheduler         the scheduler
@@ -119,7 +230,7 @@ tb_bool_t                   tb_co_scheduler_yield(tb_co_scheduler_t* scheduler);
  * @param coroutine         the suspended coroutine
  * @param priv              the user private data as the return value of suspend() or sleep()
  *
- * @return                  the user private data from suspend(priv)
+ * @return                  the user private data from suspend(priv), always tb_null for the coroutine of the other scheduler (M:N mode)
  */
 tb_pointer_t                tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv);
 
@@ -187,6 +298,15 @@ tb_long_t                   tb_co_scheduler_wait_proc(tb_co_scheduler_t* schedul
  */
 tb_long_t                   tb_co_scheduler_wait_fwatcher(tb_co_scheduler_t* scheduler, tb_poller_object_ref_t object, tb_fwatcher_event_t* pevent, tb_long_t timeout);
 
+/* post a completion-based io and wait it
+ *
+ * @param scheduler         the scheduler
+ * @param io                the io
+ *
+ * @return                  tb_true or tb_false, it will return tb_false if the io poller does not support it
+ */
+tb_bool_t                   tb_co_scheduler_post(tb_co_scheduler_t* scheduler, tb_poller_io_ref_t io);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -36,16 +36,13 @@
  * macros
  */
 
-// the ltimer grow
+// the timer grow
 #ifdef __tb_small__
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (64)
+#   define TB_SCHEDULER_IO_TIMER_GROW       (64)
 #else
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (4096)
+#   define TB_SCHEDULER_IO_TIMER_GROW       (4096)
 #endif
 
-// the timer grow
-#define TB_SCHEDULER_IO_TIMER_GROW          (TB_SCHEDULER_IO_LTIMER_GROW >> 4)
-
 // the poller object data grow
 #ifdef __tb_small__
 #   define TB_SCHEDULER_IO_POLLERDATA_GROW    (64)
@@ -67,8 +64,7 @@ static tb_void_t tb_co_scheduler_io_resume(tb_co_scheduler_t* scheduler, tb_coro
         tb_assert(scheduler_io && scheduler_io->poller);
 
         // remove the timer task
-        if (coroutine->rs.wait.is_ltimer) tb_ltimer_task_exit(scheduler_io->ltimer, (tb_ltimer_task_ref_t)task);
-        else tb_timer_task_exit(scheduler_io->timer, (tb_timer_task_ref_t)task);
+        tb_timer_task_exit(scheduler_io->timer, (tb_timer_task_ref_t)task);
         coroutine->rs.wait.task = tb_null;
     }
 
@@ -194,10 +190,22 @@ static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_poller_obj
         }
     }
 }
+static tb_void_t tb_co_scheduler_io_complete(tb_poller_ref_t poller, tb_poller_io_ref_t io)
+{
+    // check
+    tb_co_scheduler_io_ref_t scheduler_io = (tb_co_scheduler_io_ref_t)tb_poller_priv(poller);
+    tb_assert(scheduler_io && scheduler_io->scheduler && io && io->priv);
+
+    // trace
+    tb_trace_d("coroutine(%p): io(%p) completed, state: %s, result: %ld", io->priv, io, tb_state_cstr(io->state), io->result);
+
+    // resume the waiting coroutine
+    tb_co_scheduler_resume(scheduler_io->scheduler, (tb_coroutine_t*)io->priv, io);
+}
 static tb_bool_t tb_co_scheduler_io_timer_spak(tb_co_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->timer);
 
     // spak ctime
     tb_cache_time_spak();
@@ -205,9 +213,6 @@ static tb_bool_t tb_co_scheduler_io_timer_spak(tb_co_scheduler_io_ref_t schedule
     // spak timer
     if (!tb_timer_spak(scheduler_io->timer)) return tb_false;
 
-    // spak ltimer
-    if (!tb_ltimer_spak(scheduler_io->ltimer)) return tb_false;
-
     // pk
     return tb_true;
 }
@@ -215,7 +220,7 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
 {
     // check
     tb_co_scheduler_io_ref_t scheduler_io = (tb_co_scheduler_io_ref_t)priv;
-    tb_assert_and_check_return(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert_and_check_return(scheduler_io && scheduler_io->timer);
 
     // the scheduler
     tb_co_scheduler_t* scheduler = scheduler_io->scheduler;
@@ -225,30 +230,55 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
     tb_poller_ref_t poller = scheduler_io->poller;
     tb_assert_and_check_return(poller);
 
+    // the scheduler group for the M:N mode
+    tb_co_scheduler_group_t* group = scheduler->group;
+
     // loop
     while (!scheduler->stopped)
     {
+        // pull the resumed and new coroutines for the M:N mode
+        if (group) tb_co_scheduler_pull(scheduler, tb_false);
+
         // finish all other ready coroutines first
         while (tb_co_scheduler_yield(scheduler))
         {
             // spak timer
             if (!tb_co_scheduler_io_timer_spak(scheduler_io)) break;
+
+            // pull the resumed and new coroutines for the M:N mode
+            if (group) tb_co_scheduler_pull(scheduler, tb_false);
         }
 
-        // no more suspended coroutines? loop end
-        tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+        // pull or steal more coroutines for the M:N mode if no more ready coroutines
+        tb_bool_t pulled = tb_false;
+        if (group)
+        {
+            pulled = tb_co_scheduler_pull(scheduler, tb_true) > 0;
 
-        // the delay
-        tb_size_t delay = tb_timer_delay(scheduler_io->timer);
+            // all coroutines of the scheduler group are finished? loop end
+            tb_check_break(pulled || tb_co_scheduler_group_alive(group));
+        }
+        // no more suspended coroutines? loop end
+        else tb_check_break(tb_co_scheduler_suspend_count(scheduler));
 
-        // the ldelay
-        tb_size_t ldelay = tb_ltimer_delay(scheduler_io->ltimer);
+        // the delay, we only poll io events if some coroutines have been pulled
+        tb_size_t delay = pulled? 0 : tb_timer_delay(scheduler_io->timer);
 
         // trace
-        tb_trace_d("loop: wait %lu ms, %lu pending coroutines ..", tb_min(delay, ldelay), tb_co_scheduler_suspend_count(scheduler));
+        tb_trace_d("loop: wait %lu ms, %lu pending coroutines ..", delay, tb_co_scheduler_suspend_count(scheduler));
+
+        // enter idle for the M:N mode, we need not wait poller if some new coroutines are coming
+        tb_bool_t idle = group && !pulled;
+        if (idle && !tb_co_scheduler_idle_enter(scheduler)) continue;
 
         // no more ready coroutines? wait io events and timers
-        if (tb_poller_wait(poller, tb_co_scheduler_io_events, tb_min(delay, ldelay)) < 0)
+        tb_long_t wait = tb_poller_wait(poller, tb_co_scheduler_io_events, delay);
+
+        // leave idle for the M:N mode
+        if (idle) tb_co_scheduler_idle_leave(scheduler);
+
+        // wait failed?
+        if (wait < 0)
         {
             tb_trace_e("loop: wait poller failed!");
             break;
@@ -279,16 +309,15 @@ tb_co_scheduler_io_ref_t tb_co_scheduler_io_init(tb_co_scheduler_t* scheduler)
         // save scheduler
         scheduler_io->scheduler = (tb_co_scheduler_t*)scheduler;
 
-        // init timer and using cache time
-        scheduler_io->timer = tb_timer_init(TB_SCHEDULER_IO_TIMER_GROW, tb_true);
+        /* init timer and using cache time
+         *
+         * we use the timing wheel because we need arm and cancel a timeout for each socket operation
+         */
+        scheduler_io->timer = tb_timer_init_with_mode(TB_SCHEDULER_IO_TIMER_GROW, tb_true, TB_TIMER_MODE_WHEEL);
         tb_assert_and_check_break(scheduler_io->timer);
 
-        // init ltimer and using cache time
-        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_S, tb_true);
-        tb_assert_and_check_break(scheduler_io->ltimer);
-
         // init poller
-        scheduler_io->poller = tb_poller_init(scheduler_io);
+        scheduler_io->poller = tb_poller_init_with_type(scheduler_io, scheduler->poller_type);
         tb_assert_and_check_break(scheduler_io->poller);
 
         // attach poller
@@ -301,8 +330,8 @@ tb_co_scheduler_io_ref_t tb_co_scheduler_io_init(tb_co_scheduler_t* scheduler)
         // init poller object data
         tb_pollerdata_init(&scheduler_io->pollerdata);
 
-        // start the io loop coroutine
-        if (!tb_co_scheduler_start(scheduler_io->scheduler, tb_co_scheduler_io_loop, scheduler_io, 0)) break;
+        // start the io loop coroutine, it's always bound to this scheduler
+        if (!tb_co_scheduler_start_local(scheduler_io->scheduler, tb_co_scheduler_io_loop, scheduler_io, 0)) break;
 
         // ok
         ok = tb_true;
@@ -340,10 +369,6 @@ tb_void_t tb_co_scheduler_io_exit(tb_co_scheduler_io_ref_t scheduler_io)
     if (scheduler_io->timer) tb_timer_exit(scheduler_io->timer);
     scheduler_io->timer = tb_null;
 
-    // exit ltimer
-    if (scheduler_io->ltimer) tb_ltimer_exit(scheduler_io->ltimer);
-    scheduler_io->ltimer = tb_null;
-
     // clear scheduler
     scheduler_io->scheduler = tb_null;
 
@@ -376,9 +401,6 @@ tb_void_t tb_co_scheduler_io_kill(tb_co_scheduler_io_ref_t scheduler_io)
     // kill timer
     if (scheduler_io->timer) tb_timer_kill(scheduler_io->timer);
 
-    // kill ltimer
-    if (scheduler_io->ltimer) tb_ltimer_kill(scheduler_io->ltimer);
-
     // kill poller
     if (scheduler_io->poller) tb_poller_kill(scheduler_io->poller);
 }
@@ -404,18 +426,8 @@ tb_pointer_t tb_co_scheduler_io_sleep(tb_co_scheduler_io_ref_t scheduler_io, tb_
     // infinity?
     if (interval > 0)
     {
-        // high-precision interval?
-        if (interval % 1000)
-        {
-            // post task to timer
-            tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
-        // low-precision interval?
-        else
-        {
-            // post task to ltimer (faster)
-            tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
+        // post task to timer
+        tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
     }
 
     // suspend it
@@ -511,32 +523,16 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_poll
 
     // exists timeout?
     tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        // init task for timer
+        task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
+        tb_assert_and_check_return_val(task, tb_false);
     }
 
     // save the timer task to coroutine
     coroutine->rs.wait.task         = task;
     coroutine->rs.wait.object       = *object;
-    coroutine->rs.wait.is_ltimer    = is_ltimer;
 
     // save waiting events
     pollerdata->poller_events_wait = (tb_uint16_t)events_wait;
@@ -584,32 +580,16 @@ tb_long_t tb_co_scheduler_io_wait_proc(tb_co_scheduler_io_ref_t scheduler_io, tb
 
     // exists timeout?
     tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        // init task for timer
+        task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
+        tb_assert_and_check_return_val(task, tb_false);
     }
 
     // save the timer task to coroutine
     coroutine->rs.wait.task           = task;
     coroutine->rs.wait.object         = *object;
-    coroutine->rs.wait.is_ltimer      = is_ltimer;
     coroutine->rs.wait.object_event   = 0;
     coroutine->rs.wait.object_pending = 0;
     coroutine->rs.wait.object_waiting = 1;
@@ -654,32 +634,16 @@ tb_long_t tb_co_scheduler_io_wait_fwatcher(tb_co_scheduler_io_ref_t scheduler_io
 
     // exists timeout?
     tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        // init task for timer
+        task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
+        tb_assert_and_check_return_val(task, tb_false);
     }
 
     // save the timer task to coroutine
     coroutine->rs.wait.task           = task;
     coroutine->rs.wait.object         = *object;
-    coroutine->rs.wait.is_ltimer      = is_ltimer;
     coroutine->rs.wait.object_event   = 0;
     coroutine->rs.wait.object_pending = 0;
     coroutine->rs.wait.object_waiting = 1;
@@ -689,6 +653,66 @@ tb_long_t tb_co_scheduler_io_wait_fwatcher(tb_co_scheduler_io_ref_t scheduler_io
     if (ok > 0 && pevent) *pevent = *((tb_fwatcher_event_t*)coroutine->rs.wait.object_event);
     return ok;
 }
+tb_bool_t tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_io_ref_t io)
+{
+    // check
+    tb_assert(scheduler_io && scheduler_io->poller && scheduler_io->scheduler && io && io->sock);
+
+    // get the current coroutine
+    tb_coroutine_t* coroutine = tb_co_scheduler_running(scheduler_io->scheduler);
+    tb_assert(coroutine);
+
+    // the poller does not support the completion-based io? we need wait the readiness events
+    tb_poller_ref_t poller = scheduler_io->poller;
+    tb_check_return_val(tb_poller_type(poller) == TB_POLLER_TYPE_IOURING, tb_false);
+
+    // trace
+    tb_trace_d("coroutine(%p): post io(%p) code(%u) with %ld ms for socket(%p) ..", coroutine, io, io->code, io->timeout, io->sock);
+
+    // get and allocate a poller object data
+    tb_poller_object_t object;
+    object.type     = TB_POLLER_OBJECT_SOCK;
+    object.ref.sock = io->sock;
+    tb_co_pollerdata_io_ref_t pollerdata = (tb_co_pollerdata_io_ref_t)tb_pollerdata_get(&scheduler_io->pollerdata, &object);
+    if (!pollerdata)
+    {
+        tb_assert(scheduler_io->pollerdata_pool);
+        pollerdata = (tb_co_pollerdata_io_ref_t)tb_fixed_pool_malloc0(scheduler_io->pollerdata_pool);
+        tb_pollerdata_set(&scheduler_io->pollerdata, &object, pollerdata);
+    }
+    tb_assert_and_check_return_val(pollerdata, tb_false);
+
+    // only one pending io for each direction
+    tb_bool_t is_recv = io->code == TB_POLLER_IOCODE_RECV || io->code == TB_POLLER_IOCODE_ACPT;
+    tb_assert_and_check_return_val(!(is_recv? pollerdata->io_recv : pollerdata->io_send), tb_false);
+
+    // post it, it will be submitted in the next poller wait
+    io->func = tb_co_scheduler_io_complete;
+    io->priv = coroutine;
+    if (!tb_poller_post(poller, io))
+    {
+        // trace
+        tb_trace_e("failed to post io(%p) to poller on coroutine(%p)!", io, coroutine);
+        return tb_false;
+    }
+
+    // save the pending io, it will be canceled if the socket is closed
+    if (is_recv) pollerdata->io_recv = io;
+    else pollerdata->io_send = io;
+
+    // suspend the current coroutine until the io is completed, the timeout is done by the kernel
+    coroutine->rs.wait.task = tb_null;
+    tb_co_scheduler_suspend(scheduler_io->scheduler, tb_null);
+
+    // clear the pending io, the poller object data may be reset after canceling
+    pollerdata = (tb_co_pollerdata_io_ref_t)tb_pollerdata_get(&scheduler_io->pollerdata, &object);
+    if (pollerdata)
+    {
+        if (pollerdata->io_recv == io) pollerdata->io_recv = tb_null;
+        if (pollerdata->io_send == io) pollerdata->io_send = tb_null;
+    }
+    return tb_true;
+}
 tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_object_ref_t object)
 {
     // check
@@ -727,6 +751,21 @@ tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_po
         pollerdata->co_recv = tb_null;
         pollerdata->co_send = tb_null;
 
+        // cancel the pending completion-based io, the waiting coroutines will be resumed with TB_STATE_KILLED
+        tb_bool_t canceled = tb_false;
+        if (pollerdata->io_recv)
+        {
+            tb_poller_cancel(scheduler_io->poller, pollerdata->io_recv);
+            pollerdata->io_recv = tb_null;
+            canceled = tb_true;
+        }
+        if (pollerdata->io_send)
+        {
+            tb_poller_cancel(scheduler_io->poller, pollerdata->io_send);
+            pollerdata->io_send = tb_null;
+            canceled = tb_true;
+        }
+
         // remove the this poller object from poller
         if (pollerdata->poller_events_wait)
         {
@@ -743,6 +782,9 @@ tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_po
             pollerdata->poller_events_save = 0;
             return tb_true;
         }
+
+        // only the completion-based io has been canceled?
+        if (canceled) return tb_true;
     }
 
     // no this poller object
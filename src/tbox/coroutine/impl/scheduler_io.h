@@ -48,6 +48,12 @@ typedef struct __tb_co_pollerdata_io_t
     // the suspended coroutine for waiting poller/send
     tb_coroutine_t*     co_send;
 
+    // the pending completion-based io for recv/accept
+    tb_poller_io_ref_t  io_recv;
+
+    // the pending completion-based io for send/connect
+    tb_poller_io_ref_t  io_send;
+
     // the waited events for poller
     tb_uint16_t         poller_events_wait;
 
@@ -71,9 +77,6 @@ typedef struct __tb_co_scheduler_io_t
     // the timer
     tb_timer_ref_t      timer;
 
-    // the low-precision timer (faster)
-    tb_ltimer_ref_t     ltimer;
-
     // the poller data
     tb_pollerdata_t     pollerdata;
 
@@ -158,6 +161,17 @@ tb_long_t                   tb_co_scheduler_io_wait_proc(tb_co_scheduler_io_ref_
  */
 tb_long_t                   tb_co_scheduler_io_wait_fwatcher(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_object_ref_t object, tb_fwatcher_event_t* pevent, tb_long_t timeout);
 
+/*! post a completion-based io and wait it
+ *
+ * the current coroutine will be resumed after the io is completed by the kernel, see io->state and io->result
+ *
+ * @param scheduler_io      the io scheduler
+ * @param io                the io
+ *
+ * @return                  tb_true or tb_false, it will return tb_false if the poller does not support it
+ */
+tb_bool_t                   tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_io_ref_t io);
+
 /*! cancel io events for the given poller object
  *
  * @param scheduler_io      the io scheduler
@@ -33,6 +33,17 @@
 #include "impl/impl.h"
 #include "../algorithm/algorithm.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the worker maximum count for the M:N mode
+#ifdef __tb_small__
+#   define TB_SCHEDULER_WORKER_MAXN         (16)
+#else
+#   define TB_SCHEDULER_WORKER_MAXN         (64)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -72,10 +83,7 @@ static tb_void_t tb_co_scheduler_free(tb_list_entry_head_ref_t coroutines)
     }
 }
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
- */
-tb_co_scheduler_ref_t tb_co_scheduler_init()
+static tb_co_scheduler_t* tb_co_scheduler_init_one(tb_noarg_t)
 {
     // done
     tb_bool_t           ok = tb_false;
@@ -110,17 +118,16 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
     if (!ok)
     {
         // exit it
-        if (scheduler) tb_co_scheduler_exit((tb_co_scheduler_ref_t)scheduler);
+        if (scheduler) tb_free(scheduler);
         scheduler = tb_null;
     }
 
     // ok?
-    return (tb_co_scheduler_ref_t)scheduler;
+    return scheduler;
 }
-tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
+static tb_void_t tb_co_scheduler_exit_one(tb_co_scheduler_t* scheduler)
 {
     // check
-    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
     // must be stopped
@@ -155,25 +162,23 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+    // exit the new coroutines which have been not started
+    if (scheduler->deque)
+    {
+        tb_long_t top = tb_atomic_get(&scheduler->deque_top);
+        tb_long_t bottom = tb_atomic_get(&scheduler->deque_bottom);
+        for (; top < bottom; top++)
+            tb_coroutine_exit((tb_coroutine_t*)tb_atomic_get(&scheduler->deque[top & (TB_SCHEDULER_DEQUE_MAXN - 1)]));
+        tb_free(scheduler->deque);
+    }
+    scheduler->deque = tb_null;
+
     // exit the scheduler
     tb_free(scheduler);
 }
-tb_void_t tb_co_scheduler_kill(tb_co_scheduler_ref_t self)
-{
-    // check
-    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
-    tb_assert_and_check_return(scheduler);
-
-    // stop it
-    scheduler->stopped = tb_true;
-
-    // kill the io scheduler
-    if (scheduler->scheduler_io) tb_co_scheduler_io_kill(scheduler->scheduler_io);
-}
-tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
+static tb_void_t tb_co_scheduler_loop_one(tb_co_scheduler_t* scheduler, tb_bool_t exclusive)
 {
     // check
-    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
 #ifdef __tb_thread_local__
@@ -187,13 +192,16 @@ tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
         if (!tb_thread_local_init(&g_scheduler_self, tb_null)) return ;
 
         // update and overide the current scheduler
-        tb_thread_local_set(&g_scheduler_self, self);
+        tb_thread_local_set(&g_scheduler_self, scheduler);
     }
 #endif
 
+    // we need attach the poller of this worker in the current thread for the M:N mode
+    if (scheduler->group && scheduler->scheduler_io)
+        tb_poller_attach(((tb_co_scheduler_io_ref_t)scheduler->scheduler_io)->poller);
 #ifdef TB_CONFIG_OS_WINDOWS
     // we need attach poller in the current thread first for iocp/windows
-    tb_co_scheduler_io_need(scheduler);
+    else tb_co_scheduler_io_need(scheduler);
 #endif
 
     // schedule all ready coroutines
@@ -228,6 +236,256 @@ tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
     }
 #endif
 }
+static tb_int_t tb_co_scheduler_group_worker(tb_cpointer_t priv)
+{
+    // run the scheduler loop of this worker
+    tb_co_scheduler_loop_one((tb_co_scheduler_t*)priv, tb_false);
+    return 0;
+}
+static tb_void_t tb_co_scheduler_group_exit(tb_co_scheduler_group_t* group)
+{
+    // check
+    tb_assert_and_check_return(group);
+
+    // exit all schedulers
+    if (group->schedulers)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            if (group->schedulers[i]) tb_co_scheduler_exit_one(group->schedulers[i]);
+            group->schedulers[i] = tb_null;
+        }
+        tb_free(group->schedulers);
+    }
+    group->schedulers = tb_null;
+
+    // exit threads
+    if (group->threads) tb_free(group->threads);
+    group->threads = tb_null;
+
+    // free all global coroutines which have been not started
+    tb_co_scheduler_free(&group->coroutines_global);
+
+    // exit global coroutines
+    tb_list_entry_exit(&group->coroutines_global);
+
+    // exit lock
+    tb_spinlock_exit(&group->lock);
+
+    // exit the group
+    tb_free(group);
+}
+static tb_co_scheduler_t* tb_co_scheduler_group_init(tb_size_t worker_maxn)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_co_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // init worker count
+        if (!worker_maxn) worker_maxn = tb_cpu_count();
+        if (!worker_maxn) worker_maxn = 1;
+        if (worker_maxn > TB_SCHEDULER_WORKER_MAXN) worker_maxn = TB_SCHEDULER_WORKER_MAXN;
+
+        // make group
+        group = tb_malloc0_type(tb_co_scheduler_group_t);
+        tb_assert_and_check_break(group);
+
+        // init lock
+        if (!tb_spinlock_init(&group->lock)) break;
+
+        // init global coroutines
+        tb_list_entry_init(&group->coroutines_global, tb_coroutine_t, entry, tb_null);
+
+        // make schedulers
+        group->schedulers = tb_nalloc0_type(worker_maxn, tb_co_scheduler_t*);
+        tb_assert_and_check_break(group->schedulers);
+
+        // make threads
+        group->threads = tb_nalloc0_type(worker_maxn, tb_thread_ref_t);
+        tb_assert_and_check_break(group->threads);
+
+        // init schedulers
+        tb_size_t i = 0;
+        for (i = 0; i < worker_maxn; i++)
+        {
+            // init scheduler
+            tb_co_scheduler_t* scheduler = tb_co_scheduler_init_one();
+            tb_assert_and_check_break(scheduler);
+            group->schedulers[group->count++] = scheduler;
+
+            // init group
+            scheduler->group = group;
+
+            // init deque
+            scheduler->deque = tb_nalloc0_type(TB_SCHEDULER_DEQUE_MAXN, tb_atomic_t);
+            tb_assert_and_check_break(scheduler->deque);
+        }
+        tb_assert_and_check_break(i == worker_maxn);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (group)
+        {
+            tb_size_t i = 0;
+            for (i = 0; i < group->count; i++)
+                group->schedulers[i]->stopped = tb_true;
+            tb_co_scheduler_group_exit(group);
+        }
+        group = tb_null;
+    }
+
+    // ok?
+    return group? group->schedulers[0] : tb_null;
+}
+static tb_void_t tb_co_scheduler_group_loop(tb_co_scheduler_group_t* group)
+{
+    // check
+    tb_assert_and_check_return(group && group->count && group->schedulers);
+
+    // init the io schedulers of all workers first, the io loop coroutine will pull the coroutines for each worker
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        if (!tb_co_scheduler_io_need(group->schedulers[i])) return ;
+    }
+
+    // start the other workers
+    for (i = 1; i < group->count; i++)
+    {
+        group->threads[i] = tb_thread_init(__tb_lstring__("co_scheduler"), tb_co_scheduler_group_worker, group->schedulers[i], 0);
+        if (!group->threads[i])
+        {
+            // trace
+            tb_trace_e("[loop]: start worker(%lu) failed!", i);
+        }
+    }
+
+    // run the first worker in the current thread
+    tb_co_scheduler_loop_one(group->schedulers[0], tb_false);
+
+    // wait all workers
+    for (i = 1; i < group->count; i++)
+    {
+        if (group->threads[i])
+        {
+            tb_thread_wait(group->threads[i], -1, tb_null);
+            tb_thread_exit(group->threads[i]);
+            group->threads[i] = tb_null;
+        }
+    }
+
+    // stop all schedulers, some workers may be not started
+    for (i = 0; i < group->count; i++)
+        group->schedulers[i]->stopped = tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_scheduler_ref_t tb_co_scheduler_init()
+{
+    return tb_co_scheduler_init_with_mode(0, TB_CO_SCHEDULER_MODE_SINGLE);
+}
+tb_co_scheduler_ref_t tb_co_scheduler_init_with_mode(tb_size_t worker_maxn, tb_size_t mode)
+{
+    // get the flags
+    tb_size_t flags = mode & ~0xff;
+    mode &= 0xff;
+
+    // init the multi-workers or single scheduler
+    tb_co_scheduler_t* scheduler = (mode == TB_CO_SCHEDULER_MODE_MULTI)? tb_co_scheduler_group_init(worker_maxn) : tb_co_scheduler_init_one();
+    tb_check_return_val(scheduler, tb_null);
+
+    // select the io_uring poller for all workers, it will be used when the io scheduler is initialized
+    if (flags & TB_CO_SCHEDULER_FLAG_IOURING)
+    {
+        tb_co_scheduler_group_t* group = scheduler->group;
+        if (group)
+        {
+            tb_size_t i = 0;
+            for (i = 0; i < group->count; i++)
+                group->schedulers[i]->poller_type = TB_POLLER_TYPE_IOURING;
+        }
+        else scheduler->poller_type = TB_POLLER_TYPE_IOURING;
+    }
+
+    // ok
+    return (tb_co_scheduler_ref_t)scheduler;
+}
+tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
+{
+    // check
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
+    tb_assert_and_check_return(scheduler);
+
+    // exit the scheduler group
+    if (scheduler->group)
+    {
+        // check, we can only exit the first scheduler
+        tb_assert_and_check_return(scheduler->group->schedulers[0] == scheduler);
+
+        // exit it
+        tb_co_scheduler_group_exit(scheduler->group);
+    }
+    // exit the single scheduler
+    else tb_co_scheduler_exit_one(scheduler);
+}
+tb_void_t tb_co_scheduler_kill(tb_co_scheduler_ref_t self)
+{
+    // check
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
+    tb_assert_and_check_return(scheduler);
+
+    // kill all schedulers in the group
+    tb_co_scheduler_group_t* group = scheduler->group;
+    if (group)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            // stop it
+            tb_co_scheduler_t* worker = group->schedulers[i];
+            worker->stopped = tb_true;
+
+            // kill the io scheduler
+            if (worker->scheduler_io) tb_co_scheduler_io_kill(worker->scheduler_io);
+        }
+        return ;
+    }
+
+    // stop it
+    scheduler->stopped = tb_true;
+
+    // kill the io scheduler
+    if (scheduler->scheduler_io) tb_co_scheduler_io_kill(scheduler->scheduler_io);
+}
+tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
+{
+    // check
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
+    tb_assert_and_check_return(scheduler);
+
+    // run all workers in the scheduler group
+    if (scheduler->group)
+    {
+        // check, we can only run the first scheduler
+        tb_assert_and_check_return(scheduler->group->schedulers[0] == scheduler);
+
+        // loop it
+        tb_co_scheduler_group_loop(scheduler->group);
+    }
+    // run the single scheduler
+    else tb_co_scheduler_loop_one(scheduler, exclusive);
+}
 tb_co_scheduler_ref_t tb_co_scheduler_self()
 {
     // get self scheduler on the current thread
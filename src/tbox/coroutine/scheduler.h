@@ -39,6 +39,22 @@ __tb_extern_c_enter__
 /// the coroutine scheduler ref type
 typedef __tb_typeref__(co_scheduler);
 
+/// the coroutine scheduler mode enum
+typedef enum __tb_co_scheduler_mode_e
+{
+    TB_CO_SCHEDULER_MODE_SINGLE     = 0     //!< run all coroutines on the thread which calls loop()
+,   TB_CO_SCHEDULER_MODE_MULTI      = 1     //!< run coroutines on multiple worker threads (M:N), each worker has its own io poller, only the new coroutines are balanced
+
+}tb_co_scheduler_mode_e;
+
+/// the coroutine scheduler flag enum, it can be combined with the mode
+typedef enum __tb_co_scheduler_flag_e
+{
+    TB_CO_SCHEDULER_FLAG_NONE       = 0
+,   TB_CO_SCHEDULER_FLAG_IOURING    = 0x0100    //!< use the io_uring poller if be supported, tb_coroutine_recv/send/accept/connect will be completed by the kernel
+
+}tb_co_scheduler_flag_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -49,6 +65,35 @@ typedef __tb_typeref__(co_scheduler);
  */
 tb_co_scheduler_ref_t   tb_co_scheduler_init(tb_noarg_t);
 
+/*! init scheduler with the given mode
+ *
+ * the multi mode runs coroutines on multiple worker schedulers,
+ * the thread which calls loop() runs the first worker and the other workers run on the new threads.
+ *
+ * the new coroutines can be stolen by the other idle workers before they run,
+ * but a coroutine is bound to its worker after it has been started because its io and timers are waited in this worker.
+ *
+ * @note only the new coroutines are load balanced, a started coroutine will never be stolen or migrated
+ * even if it's ready after yield() or resume(), so the long-lived coroutines (e.g. the network connections)
+ * stay on the workers which run them first. we can start a new coroutine for each long-lived task to spread them,
+ * e.g. the server accepts connections and starts a new coroutine for each one, the idle workers will steal them before they run.
+ *
+ * tb_co_channel_t, tb_co_lock_t and tb_co_semaphore_t can be used between the coroutines of the different workers,
+ * the waiting coroutine is always resumed in its worker.
+ *
+ * tb_coroutine_resume() for the coroutine of the other worker only posts it to this worker and returns tb_null,
+ * it does not return the user private data from suspend(priv) synchronously.
+ *
+ * the io_uring poller is opt-in, e.g. TB_CO_SCHEDULER_MODE_SINGLE | TB_CO_SCHEDULER_FLAG_IOURING,
+ * it will fall back to the default poller (epoll) if it's not supported by the kernel.
+ *
+ * @param worker_maxn   the worker maximum count, uses the cpu count if be zero, only for the multi mode
+ * @param mode          the scheduler mode, e.g. TB_CO_SCHEDULER_MODE_SINGLE, TB_CO_SCHEDULER_MODE_MULTI, and the optional flags
+ *
+ * @return              the scheduler
+ */
+tb_co_scheduler_ref_t   tb_co_scheduler_init_with_mode(tb_size_t worker_maxn, tb_size_t mode);
+
 /*! exit scheduler
  *
  * @param scheduler     the scheduler
@@ -62,10 +107,13 @@ tb_void_t               tb_co_scheduler_exit(tb_co_scheduler_ref_t scheduler);
 tb_void_t               tb_co_scheduler_kill(tb_co_scheduler_ref_t scheduler);
 
 /*! run the scheduler loop
+ *
+ * it will start the other worker threads and wait them for the multi mode
  *
  * @param schedule      the scheduler
  * @param exclusive     enable exclusive mode, we need ensure only one loop() be called at the same time,
- *                      but it will be faster using thr global scheduler instead of TLS storage
+ *                      but it will be faster using thr global scheduler instead of TLS storage,
+ *                      it will be ignored for the multi mode
  */
 tb_void_t               tb_co_scheduler_loop(tb_co_scheduler_ref_t schedule, tb_bool_t exclusive);
 
@@ -39,17 +39,81 @@
  * types
  */
 
-// the coroutine semaphore type
+// the coroutine semaphore waiter state enum
+typedef enum __tb_co_semaphore_waiter_state_e
+{
+    TB_CO_SEMAPHORE_WAITER_STATE_WAITING    = 0
+,   TB_CO_SEMAPHORE_WAITER_STATE_POSTED     = 1
+,   TB_CO_SEMAPHORE_WAITER_STATE_TIMEOUT    = 2
+
+}tb_co_semaphore_waiter_state_e;
+
+// the coroutine semaphore waiter type, it's placed in the stack of the waiting coroutine
+typedef struct __tb_co_semaphore_waiter_t
+{
+    // the list entry
+    tb_list_entry_t                         entry;
+
+    // the waiting coroutine
+    tb_coroutine_ref_t                      coroutine;
+
+    // the semaphore
+    struct __tb_co_semaphore_t*             semaphore;
+
+    // the next posted waiter
+    struct __tb_co_semaphore_waiter_t*      next;
+
+    // the state
+    tb_size_t                               state;
+
+}tb_co_semaphore_waiter_t;
+
+/* the coroutine semaphore type
+ *
+ * the waiting coroutines may be in the different schedulers for the M:N mode,
+ * so we need protect it by the lock and resume them in their schedulers
+ */
 typedef struct __tb_co_semaphore_t
 {
+    // the lock
+    tb_spinlock_t                           lock;
+
     // the semaphore value
-    tb_size_t                       value;
+    tb_size_t                               value;
 
-    // the waiting coroutines
-    tb_single_list_entry_head_t     waiting;
+    // the waiters
+    tb_list_entry_head_t                    waiting;
 
 }tb_co_semaphore_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_co_semaphore_timeout(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // check
+    tb_co_semaphore_waiter_t* waiter = (tb_co_semaphore_waiter_t*)priv;
+    tb_assert(waiter && waiter->semaphore);
+
+    // killed?
+    tb_check_return(!killed);
+
+    // timeout if it has been not posted
+    tb_co_semaphore_t* semaphore = waiter->semaphore;
+    tb_bool_t timeout = tb_false;
+    tb_spinlock_enter(&semaphore->lock);
+    if (waiter->state == TB_CO_SEMAPHORE_WAITER_STATE_WAITING)
+    {
+        tb_list_entry_remove(&semaphore->waiting, &waiter->entry);
+        waiter->state = TB_CO_SEMAPHORE_WAITER_STATE_TIMEOUT;
+        timeout = tb_true;
+    }
+    tb_spinlock_leave(&semaphore->lock);
+
+    // resume the waiting coroutine, the timer is always spaked in its scheduler
+    if (timeout) tb_coroutine_resume(waiter->coroutine, (tb_cpointer_t)tb_false);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -64,11 +128,14 @@ tb_co_semaphore_ref_t tb_co_semaphore_init(tb_size_t value)
         semaphore = tb_malloc0_type(tb_co_semaphore_t);
         tb_assert_and_check_break(semaphore);
 
+        // init lock
+        if (!tb_spinlock_init(&semaphore->lock)) break;
+
         // init value
         semaphore->value = value;
 
         // init waiting coroutines
-        tb_single_list_entry_init(&semaphore->waiting, tb_coroutine_t, rs.single_entry, tb_null);
+        tb_list_entry_init(&semaphore->waiting, tb_co_semaphore_waiter_t, entry, tb_null);
 
         // ok
         ok = tb_true;
@@ -93,10 +160,13 @@ tb_void_t tb_co_semaphore_exit(tb_co_semaphore_ref_t self)
     tb_assert_and_check_return(semaphore);
 
     // check waiting coroutines
-    tb_assert(!tb_single_list_entry_size(&semaphore->waiting));
+    tb_assert(!tb_list_entry_size(&semaphore->waiting));
 
     // exit waiting coroutines
-    tb_single_list_entry_exit(&semaphore->waiting);
+    tb_list_entry_exit(&semaphore->waiting);
+
+    // exit lock
+    tb_spinlock_exit(&semaphore->lock);
 
     // exit the semaphore
     tb_free(semaphore);
@@ -107,24 +177,31 @@ tb_void_t tb_co_semaphore_post(tb_co_semaphore_ref_t self, tb_size_t post)
     tb_co_semaphore_t* semaphore = (tb_co_semaphore_t*)self;
     tb_assert_and_check_return(semaphore);
 
+    // enter
+    tb_spinlock_enter(&semaphore->lock);
+
     // add the semaphore value
     tb_size_t value = semaphore->value + post;
 
-    // resume the waiting coroutines
-    while (value && tb_single_list_entry_size(&semaphore->waiting))
+    // take the waiting coroutines
+    tb_co_semaphore_waiter_t* posted = tb_null;
+    tb_co_semaphore_waiter_t* last = tb_null;
+    while (value && tb_list_entry_size(&semaphore->waiting))
     {
         // get the next entry from head
-        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&semaphore->waiting);
+        tb_list_entry_ref_t entry = tb_list_entry_head(&semaphore->waiting);
         tb_assert_and_check_break(entry);
 
         // remove it from the waiting coroutines
-        tb_single_list_entry_remove_head(&semaphore->waiting);
+        tb_list_entry_remove_head(&semaphore->waiting);
 
-        // get the waiting coroutine
-        tb_coroutine_ref_t coroutine = (tb_coroutine_ref_t)tb_single_list_entry(&semaphore->waiting, entry);
-
-        // resume this coroutine
-        tb_coroutine_resume(coroutine, (tb_cpointer_t)tb_true);
+        // get the waiter and mark it as posted
+        tb_co_semaphore_waiter_t* waiter = (tb_co_semaphore_waiter_t*)tb_list_entry(&semaphore->waiting, entry);
+        waiter->state = TB_CO_SEMAPHORE_WAITER_STATE_POSTED;
+        waiter->next = tb_null;
+        if (last) last->next = waiter;
+        else posted = waiter;
+        last = waiter;
 
         // decrease the semaphore value
         value--;
@@ -132,6 +209,18 @@ tb_void_t tb_co_semaphore_post(tb_co_semaphore_ref_t self, tb_size_t post)
 
     // update the semaphore value
     semaphore->value = value;
+
+    // leave
+    tb_spinlock_leave(&semaphore->lock);
+
+    // resume the posted coroutines
+    while (posted)
+    {
+        // the waiter will be invalid after resuming it, so we need get the next waiter first
+        tb_co_semaphore_waiter_t* next = posted->next;
+        tb_coroutine_resume(posted->coroutine, (tb_cpointer_t)tb_true);
+        posted = next;
+    }
 }
 tb_size_t tb_co_semaphore_value(tb_co_semaphore_ref_t self)
 {
@@ -148,25 +237,67 @@ tb_long_t tb_co_semaphore_wait(tb_co_semaphore_ref_t self, tb_long_t timeout)
     tb_co_semaphore_t* semaphore = (tb_co_semaphore_t*)self;
     tb_assert_and_check_return_val(semaphore, -1);
 
+    // enter
+    tb_spinlock_enter(&semaphore->lock);
+
     // attempt to get the semaphore value
-    tb_long_t ok = 1;
-    if (semaphore->value) semaphore->value--;
-    // no semaphore?
-    else if (timeout)
+    if (semaphore->value)
+    {
+        semaphore->value--;
+        tb_spinlock_leave(&semaphore->lock);
+        return 1;
+    }
+
+    // timeout and no waiting
+    if (!timeout)
     {
-        // get the running coroutine
-        tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
-        tb_assert(running);
+        tb_spinlock_leave(&semaphore->lock);
+        return 0;
+    }
+
+    // get the running coroutine
+    tb_coroutine_ref_t running = tb_coroutine_self();
+    tb_assert(running);
 
-        // save this coroutine to the waiting coroutines
-        tb_single_list_entry_insert_tail(&semaphore->waiting, &running->rs.single_entry);
+    // save this coroutine to the waiting coroutines
+    tb_co_semaphore_waiter_t waiter;
+    waiter.coroutine = running;
+    waiter.semaphore = semaphore;
+    waiter.next      = tb_null;
+    waiter.state     = TB_CO_SEMAPHORE_WAITER_STATE_WAITING;
+    tb_list_entry_insert_tail(&semaphore->waiting, &waiter.entry);
 
-        // wait semaphore
-        ok = (tb_long_t)tb_coroutine_sleep(timeout);
+    // leave
+    tb_spinlock_leave(&semaphore->lock);
+
+    // post a timer task for timeout
+    tb_timer_ref_t      timer = tb_null;
+    tb_timer_task_ref_t task = tb_null;
+    if (timeout > 0)
+    {
+        tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io_need(tb_null);
+        if (scheduler_io)
+        {
+            timer = scheduler_io->timer;
+            task = tb_timer_task_init(timer, timeout, tb_false, tb_co_semaphore_timeout, &waiter);
+        }
     }
-    // timeout and no waiting
-    else ok = 0;
 
-    // ok?
-    return ok;
+    // wait semaphore
+    tb_coroutine_suspend(tb_null);
+
+    // exit the timer task
+    if (task) tb_timer_task_exit(timer, task);
+
+    // the scheduler has been stopped? remove it from the waiting coroutines
+    tb_spinlock_enter(&semaphore->lock);
+    if (waiter.state == TB_CO_SEMAPHORE_WAITER_STATE_WAITING)
+    {
+        tb_list_entry_remove(&semaphore->waiting, &waiter.entry);
+        waiter.state = TB_CO_SEMAPHORE_WAITER_STATE_TIMEOUT;
+    }
+    tb_spinlock_leave(&semaphore->lock);
+
+    // posted?
+    return waiter.state == TB_CO_SEMAPHORE_WAITER_STATE_POSTED? 1 : 0;
 }
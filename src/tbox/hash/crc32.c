@@ -24,6 +24,25 @@
  * includes
  */
 #include "crc32.h"
+#include "../platform/cpu.h"
+#if defined(TB_ARCH_x64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(TB_COMPILER_IS_MSVC) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   include <emmintrin.h>
+#   include <tmmintrin.h>
+#   include <wmmintrin.h>
+#   define TB_CRC32_PCLMUL_ENABLE
+#elif defined(TB_ARCH_ARM64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#   include <arm_neon.h>
+#   define TB_CRC32_PMULL_ENABLE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum size for folding with the carry-less multiplication
+#define TB_CRC32_FOLD_MINN          (64)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
@@ -132,10 +151,31 @@ tb_uint32_t const g_crc32_le_table[] =
 ,	0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
+#if defined(TB_CRC32_PCLMUL_ENABLE) || defined(TB_CRC32_PMULL_ENABLE)
+/* the folding constants, {x^(512+32), x^(512-32), x^(128+32), x^(128-32)} mod P, bit-reflected
+ *
+ * @see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel, 2009
+ */
+static tb_uint64_t const g_crc32_le_fold[] =
+{
+    0x154442bd4ULL, 0x1c6e41596ULL, 0x1751997d0ULL, 0x0ccaa009eULL
+};
+
+// the folding constants, {x^512, x^(512+64), x^128, x^(128+64)} mod P
+static tb_uint64_t const g_crc32_fold[] =
+{
+    0x0e6228b11ULL, 0x08833794cULL, 0x0e8a45605ULL, 0x0c5b9cd4cULL
+};
+
+// the byte order of the loaded data, the bit-reflected crc uses the little-endian order
+static tb_byte_t const g_crc32_le_order[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+static tb_byte_t const g_crc32_order[] = { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint32_t const table[])
+static tb_uint32_t tb_crc32_make_table(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint32_t const table[])
 {
     // done
 #if defined(TB_ARCH_ARM) && !defined(TB_ARCH_ARM64)
@@ -149,6 +189,147 @@ static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data,
     // ok
     return crc32;
 }
+#if defined(TB_CRC32_PCLMUL_ENABLE)
+/* fold x by the constants k and add the next 128 bits y
+ *
+ * x = x.lo * k.lo + x.hi * k.hi + y
+ */
+#   define tb_crc32_fold_pclmul_step(x, k, y) \
+    _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11)), y)
+
+/* fold the data with pclmulqdq, the size must be aligned by 16 and not less than 64 bytes
+ *
+ * we xor the initial crc into the first 4 bytes, fold 512 bits per loop,
+ * and compute the crc of the last 128 bits by the table.
+ */
+static __tb_target__("ssse3,pclmul") tb_uint32_t tb_crc32_fold_pclmul(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint64_t const fold[4], tb_byte_t const order[16], tb_uint32_t const table[])
+{
+    // load the first 512 bits
+    __m128i o = _mm_loadu_si128((__m128i const*)order);
+    __m128i x0 = _mm_shuffle_epi8(_mm_xor_si128(_mm_loadu_si128((__m128i const*)data), _mm_cvtsi32_si128((tb_int_t)crc32)), o);
+    __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + 16)), o);
+    __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + 32)), o);
+    __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + 48)), o);
+    data += 64;
+    size -= 64;
+
+    // fold 512 bits per loop
+    __m128i k = _mm_loadu_si128((__m128i const*)fold);
+    while (size >= 64)
+    {
+        x0 = tb_crc32_fold_pclmul_step(x0, k, _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)data), o));
+        x1 = tb_crc32_fold_pclmul_step(x1, k, _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + 16)), o));
+        x2 = tb_crc32_fold_pclmul_step(x2, k, _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + 32)), o));
+        x3 = tb_crc32_fold_pclmul_step(x3, k, _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + 48)), o));
+        data += 64;
+        size -= 64;
+    }
+
+    // fold 512 bits to 128 bits
+    k = _mm_loadu_si128((__m128i const*)(fold + 2));
+    x0 = tb_crc32_fold_pclmul_step(x0, k, x1);
+    x0 = tb_crc32_fold_pclmul_step(x0, k, x2);
+    x0 = tb_crc32_fold_pclmul_step(x0, k, x3);
+
+    // fold the left 128 bits blocks
+    while (size >= 16)
+    {
+        x0 = tb_crc32_fold_pclmul_step(x0, k, _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)data), o));
+        data += 16;
+        size -= 16;
+    }
+
+    // compute the crc of the last 128 bits
+    tb_byte_t last[16];
+    _mm_storeu_si128((__m128i*)last, _mm_shuffle_epi8(x0, o));
+    return tb_crc32_make_table(0, last, sizeof(last), table);
+}
+#elif defined(TB_CRC32_PMULL_ENABLE)
+/* fold x by the constants k and add the next 128 bits y
+ *
+ * x = x.lo * k.lo + x.hi * k.hi + y
+ */
+#   define tb_crc32_fold_pmull_step(x, k, y) \
+    veorq_u64(veorq_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(x, 0), (poly64_t)vgetq_lane_u64(k, 0))) \
+                      , vreinterpretq_u64_p128(vmull_high_p64(vreinterpretq_p64_u64(x), vreinterpretq_p64_u64(k)))), y)
+
+// load 128 bits with the given byte order
+#   define tb_crc32_fold_pmull_load(p, o)   vreinterpretq_u64_u8(vqtbl1q_u8(vld1q_u8(p), o))
+
+/* fold the data with pmull, the size must be aligned by 16 and not less than 64 bytes
+ *
+ * it is the same as tb_crc32_fold_pclmul()
+ */
+static tb_uint32_t tb_crc32_fold_pmull(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint64_t const fold[4], tb_byte_t const order[16], tb_uint32_t const table[])
+{
+    // load the first 512 bits
+    uint8x16_t  o = vld1q_u8(order);
+    uint64x2_t  x0 = vreinterpretq_u64_u8(vqtbl1q_u8(veorq_u8(vld1q_u8(data), vreinterpretq_u8_u32(vsetq_lane_u32(crc32, vdupq_n_u32(0), 0))), o));
+    uint64x2_t  x1 = tb_crc32_fold_pmull_load(data + 16, o);
+    uint64x2_t  x2 = tb_crc32_fold_pmull_load(data + 32, o);
+    uint64x2_t  x3 = tb_crc32_fold_pmull_load(data + 48, o);
+    data += 64;
+    size -= 64;
+
+    // fold 512 bits per loop
+    uint64x2_t k = vld1q_u64(fold);
+    while (size >= 64)
+    {
+        x0 = tb_crc32_fold_pmull_step(x0, k, tb_crc32_fold_pmull_load(data, o));
+        x1 = tb_crc32_fold_pmull_step(x1, k, tb_crc32_fold_pmull_load(data + 16, o));
+        x2 = tb_crc32_fold_pmull_step(x2, k, tb_crc32_fold_pmull_load(data + 32, o));
+        x3 = tb_crc32_fold_pmull_step(x3, k, tb_crc32_fold_pmull_load(data + 48, o));
+        data += 64;
+        size -= 64;
+    }
+
+    // fold 512 bits to 128 bits
+    k = vld1q_u64(fold + 2);
+    x0 = tb_crc32_fold_pmull_step(x0, k, x1);
+    x0 = tb_crc32_fold_pmull_step(x0, k, x2);
+    x0 = tb_crc32_fold_pmull_step(x0, k, x3);
+
+    // fold the left 128 bits blocks
+    while (size >= 16)
+    {
+        x0 = tb_crc32_fold_pmull_step(x0, k, tb_crc32_fold_pmull_load(data, o));
+        data += 16;
+        size -= 16;
+    }
+
+    // compute the crc of the last 128 bits
+    tb_byte_t last[16];
+    vst1q_u8(last, vqtbl1q_u8(vreinterpretq_u8_u64(x0), o));
+    return tb_crc32_make_table(0, last, sizeof(last), table);
+}
+#endif
+static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_bool_t le)
+{
+    // the table
+    tb_uint32_t const* table = le? g_crc32_le_table : g_crc32_table;
+
+    // fold the aligned blocks first
+#if defined(TB_CRC32_PCLMUL_ENABLE)
+    if (size >= TB_CRC32_FOLD_MINN && (tb_cpu_features() & TB_CPU_FEATURE_PCLMUL))
+    {
+        tb_size_t n = size & ~(tb_size_t)15;
+        crc32 = tb_crc32_fold_pclmul(crc32, data, n, le? g_crc32_le_fold : g_crc32_fold, le? g_crc32_le_order : g_crc32_order, table);
+        data += n;
+        size -= n;
+    }
+#elif defined(TB_CRC32_PMULL_ENABLE)
+    if (size >= TB_CRC32_FOLD_MINN && (tb_cpu_features() & TB_CPU_FEATURE_PMULL))
+    {
+        tb_size_t n = size & ~(tb_size_t)15;
+        crc32 = tb_crc32_fold_pmull(crc32, data, n, le? g_crc32_le_fold : g_crc32_fold, le? g_crc32_le_order : g_crc32_order, table);
+        data += n;
+        size -= n;
+    }
+#endif
+
+    // compute the left data
+    return tb_crc32_make_table(crc32, data, size, table);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -160,7 +341,7 @@ tb_uint32_t tb_crc32_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t see
     tb_assert_and_check_return_val(data, 0);
 
     // calculate it
-    return tb_crc32_make_impl(seed, data, size, g_crc32_table);
+    return tb_crc32_make_impl(seed, data, size, tb_false);
 }
 tb_uint32_t tb_crc32_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
 {
@@ -176,7 +357,7 @@ tb_uint32_t tb_crc32_le_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t
     tb_assert_and_check_return_val(data, 0);
 
     // calculate it
-    return tb_crc32_make_impl(seed, data, size, g_crc32_le_table);
+    return tb_crc32_make_impl(seed, data, size, tb_true);
 }
 tb_uint32_t tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
 {
@@ -0,0 +1,68 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        crc32c.h
+ * @ingroup     hash
+ *
+ */
+#ifndef TB_HASH_CRC32C_H
+#define TB_HASH_CRC32C_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! make crc32c (Castagnoli)
+ *
+ * the bit-reflected crc32 with the polynomial 0x1edc6f41, it uses the crc32 instruction of sse4.2 or armv8 if be supported.
+ *
+ * the seed and result are not inverted, like tb_crc32_le_make(),
+ * so the standard crc32c (iSCSI) is tb_crc32c_make(data, size, 0xffffffff) ^ 0xffffffff
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param seed      uses this seed if be non-zero
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32c_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed);
+
+/*! make crc32c (Castagnoli) for cstr
+ *
+ * @param cstr      the input cstr
+ * @param seed      uses this seed if be non-zero
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32c_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
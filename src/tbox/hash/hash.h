@@ -37,6 +37,8 @@
 #include "crc8.h"
 #include "crc16.h"
 #include "crc32.h"
+#include "crc32c.h"
+#include "xxh3.h"
 #include "fnv32.h"
 #include "fnv64.h"
 #include "murmur.h"
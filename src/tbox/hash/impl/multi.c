@@ -0,0 +1,266 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        multi.c
+ * @ingroup     hash
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "multi.h"
+#include "../../utils/bits.h"
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+#   include <immintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* finish the left messages one by one if the busy lanes are not more than it
+ *
+ * the idle lanes are computed with the dummy blocks, it will waste too much time if only a few lanes are busy.
+ */
+#define TB_HASH_MULTI_LANES_MIN         (2)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the lane type
+typedef struct __tb_hash_multi_lane_t
+{
+    // the message index
+    tb_size_t           index;
+
+    // the message data
+    tb_byte_t const*    data;
+
+    // the current block
+    tb_size_t           block;
+
+    // the full blocks count of the message data
+    tb_size_t           full;
+
+    // the all blocks count, including the padding blocks
+    tb_size_t           count;
+
+    // the padding blocks with the last partial block of data
+    tb_byte_t           tail[128];
+
+}tb_hash_multi_lane_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_hash_multi_lane_init(tb_hash_multi_t const* hash, tb_hash_multi_lane_t* lane, tb_size_t index, tb_byte_t const* data, tb_size_t size)
+{
+    // init lane
+    lane->index = index;
+    lane->data  = data;
+    lane->block = 0;
+    lane->full  = size >> 6;
+
+    // make the padding blocks: data + 0x80 + 0x00... + bits
+    tb_size_t left = size & 63;
+    tb_size_t tail = left + 9 <= 64? 64 : 128;
+    tb_memset(lane->tail, 0, tail);
+    if (left) tb_memcpy(lane->tail, data + (lane->full << 6), left);
+    lane->tail[left] = 0x80;
+    if (hash->le) tb_bits_set_u64_le(lane->tail + tail - 8, (tb_hize_t)size << 3);
+    else tb_bits_set_u64_be(lane->tail + tail - 8, (tb_hize_t)size << 3);
+    lane->count = lane->full + (tail >> 6);
+}
+static __tb_inline__ tb_byte_t const* tb_hash_multi_lane_block(tb_hash_multi_lane_t const* lane)
+{
+    return lane->block < lane->full? lane->data + (lane->block << 6) : lane->tail + ((lane->block - lane->full) << 6);
+}
+static tb_void_t tb_hash_multi_lane_done(tb_hash_multi_t const* hash, tb_hash_multi_lane_t* lane, tb_uint32_t* state, tb_byte_t* digest)
+{
+    // transform the left blocks
+    for (; lane->block < lane->count; lane->block++)
+        hash->transform(state, tb_hash_multi_lane_block(lane));
+
+    // save digest
+    tb_size_t i = 0;
+    for (i = 0; i < hash->digest_n; i++)
+    {
+        if (hash->le) tb_bits_set_u32_le(digest + (i << 2), state[i]);
+        else tb_bits_set_u32_be(digest + (i << 2), state[i]);
+    }
+}
+static tb_size_t tb_hash_multi_make_lanes(tb_hash_multi_t const* hash, tb_byte_t const** ib, tb_size_t const* in, tb_byte_t** ob, tb_size_t count)
+{
+    // init lanes
+    tb_size_t               i = 0;
+    tb_size_t               j = 0;
+    tb_size_t               next = 0;
+    tb_size_t               busy = 0;
+    tb_byte_t               used[TB_HASH_MULTI_LANES] = {0};
+    tb_byte_t const*        blocks[TB_HASH_MULTI_LANES];
+    tb_uint32_t             state[8][TB_HASH_MULTI_LANES];
+    tb_hash_multi_lane_t    lanes[TB_HASH_MULTI_LANES];
+    static tb_byte_t const  dummy[64] = {0};
+    while (1)
+    {
+        // fill the idle lanes with the next messages
+        for (j = 0; j < TB_HASH_MULTI_LANES && next < count; j++)
+        {
+            if (!used[j])
+            {
+                tb_hash_multi_lane_init(hash, &lanes[j], next, ib[next], in[next]);
+                for (i = 0; i < hash->state_n; i++) state[i][j] = hash->iv[i];
+                used[j] = 1;
+                busy++;
+                next++;
+            }
+        }
+
+        // only a few lanes are busy? finish them one by one
+        if (next == count && busy <= TB_HASH_MULTI_LANES_MIN) break;
+
+        // transform the blocks of all lanes
+        for (j = 0; j < TB_HASH_MULTI_LANES; j++)
+            blocks[j] = used[j]? tb_hash_multi_lane_block(&lanes[j]) : dummy;
+        hash->transform_lanes(state, blocks);
+
+        // save the digests of the finished lanes
+        for (j = 0; j < TB_HASH_MULTI_LANES; j++)
+        {
+            if (used[j] && ++lanes[j].block == lanes[j].count)
+            {
+                tb_uint32_t digest[8];
+                for (i = 0; i < hash->state_n; i++) digest[i] = state[i][j];
+                tb_hash_multi_lane_done(hash, &lanes[j], digest, ob[lanes[j].index]);
+                used[j] = 0;
+                busy--;
+            }
+        }
+    }
+
+    // finish the left busy lanes
+    for (j = 0; j < TB_HASH_MULTI_LANES; j++)
+    {
+        if (used[j])
+        {
+            tb_uint32_t digest[8];
+            for (i = 0; i < hash->state_n; i++) digest[i] = state[i][j];
+            tb_hash_multi_lane_done(hash, &lanes[j], digest, ob[lanes[j].index]);
+        }
+    }
+    return next;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_hash_multi_make(tb_hash_multi_t const* hash, tb_byte_t const** ib, tb_size_t const* in, tb_byte_t** ob, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return(hash && hash->transform && hash->state_n <= 8 && ib && in && ob);
+
+    // hash the messages in the parallel lanes
+    tb_size_t i = 0;
+    if (hash->transform_lanes && count > TB_HASH_MULTI_LANES_MIN)
+        i = tb_hash_multi_make_lanes(hash, ib, in, ob, count);
+
+    // hash the left messages one by one
+    for (; i < count; i++)
+    {
+        tb_uint32_t             state[8];
+        tb_hash_multi_lane_t    lane;
+        tb_hash_multi_lane_init(hash, &lane, i, ib[i], in[i]);
+        tb_memcpy(state, hash->iv, hash->state_n << 2);
+        tb_hash_multi_lane_done(hash, &lane, state, ob[i]);
+    }
+}
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+__tb_target__("avx2") tb_void_t tb_hash_multi_load_avx2(tb_uint32_t words[16][TB_HASH_MULTI_LANES], tb_byte_t const* blocks[TB_HASH_MULTI_LANES], tb_bool_t be)
+{
+    // the byte order of the big-endian words
+    __m256i order = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+                                ,   12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    // transpose the 8x8 words twice
+    tb_size_t i = 0;
+    for (i = 0; i < 64; i += 32)
+    {
+        __m256i r0 = _mm256_loadu_si256((__m256i const*)(blocks[0] + i));
+        __m256i r1 = _mm256_loadu_si256((__m256i const*)(blocks[1] + i));
+        __m256i r2 = _mm256_loadu_si256((__m256i const*)(blocks[2] + i));
+        __m256i r3 = _mm256_loadu_si256((__m256i const*)(blocks[3] + i));
+        __m256i r4 = _mm256_loadu_si256((__m256i const*)(blocks[4] + i));
+        __m256i r5 = _mm256_loadu_si256((__m256i const*)(blocks[5] + i));
+        __m256i r6 = _mm256_loadu_si256((__m256i const*)(blocks[6] + i));
+        __m256i r7 = _mm256_loadu_si256((__m256i const*)(blocks[7] + i));
+
+        // [r0.0 r1.0 r0.1 r1.1 | r0.4 r1.4 r0.5 r1.5], ...
+        __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+        __m256i t1 = _mm256_unpackhi_epi32(r0, r1);
+        __m256i t2 = _mm256_unpacklo_epi32(r2, r3);
+        __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+        __m256i t4 = _mm256_unpacklo_epi32(r4, r5);
+        __m256i t5 = _mm256_unpackhi_epi32(r4, r5);
+        __m256i t6 = _mm256_unpacklo_epi32(r6, r7);
+        __m256i t7 = _mm256_unpackhi_epi32(r6, r7);
+
+        // [r0.0 r1.0 r2.0 r3.0 | r0.4 r1.4 r2.4 r3.4], ...
+        r0 = _mm256_unpacklo_epi64(t0, t2);
+        r1 = _mm256_unpackhi_epi64(t0, t2);
+        r2 = _mm256_unpacklo_epi64(t1, t3);
+        r3 = _mm256_unpackhi_epi64(t1, t3);
+        r4 = _mm256_unpacklo_epi64(t4, t6);
+        r5 = _mm256_unpackhi_epi64(t4, t6);
+        r6 = _mm256_unpacklo_epi64(t5, t7);
+        r7 = _mm256_unpackhi_epi64(t5, t7);
+
+        // [r0.0 r1.0 r2.0 r3.0 r4.0 r5.0 r6.0 r7.0], ...
+        t0 = _mm256_permute2x128_si256(r0, r4, 0x20);
+        t1 = _mm256_permute2x128_si256(r1, r5, 0x20);
+        t2 = _mm256_permute2x128_si256(r2, r6, 0x20);
+        t3 = _mm256_permute2x128_si256(r3, r7, 0x20);
+        t4 = _mm256_permute2x128_si256(r0, r4, 0x31);
+        t5 = _mm256_permute2x128_si256(r1, r5, 0x31);
+        t6 = _mm256_permute2x128_si256(r2, r6, 0x31);
+        t7 = _mm256_permute2x128_si256(r3, r7, 0x31);
+        if (be)
+        {
+            t0 = _mm256_shuffle_epi8(t0, order);
+            t1 = _mm256_shuffle_epi8(t1, order);
+            t2 = _mm256_shuffle_epi8(t2, order);
+            t3 = _mm256_shuffle_epi8(t3, order);
+            t4 = _mm256_shuffle_epi8(t4, order);
+            t5 = _mm256_shuffle_epi8(t5, order);
+            t6 = _mm256_shuffle_epi8(t6, order);
+            t7 = _mm256_shuffle_epi8(t7, order);
+        }
+
+        // save words
+        tb_uint32_t (*w)[TB_HASH_MULTI_LANES] = words + (i >> 2);
+        _mm256_storeu_si256((__m256i*)w[0], t0);
+        _mm256_storeu_si256((__m256i*)w[1], t1);
+        _mm256_storeu_si256((__m256i*)w[2], t2);
+        _mm256_storeu_si256((__m256i*)w[3], t3);
+        _mm256_storeu_si256((__m256i*)w[4], t4);
+        _mm256_storeu_si256((__m256i*)w[5], t5);
+        _mm256_storeu_si256((__m256i*)w[6], t6);
+        _mm256_storeu_si256((__m256i*)w[7], t7);
+    }
+}
+#endif
@@ -0,0 +1,110 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        multi.h
+ * @ingroup     hash
+ *
+ */
+#ifndef TB_HASH_IMPL_MULTI_H
+#define TB_HASH_IMPL_MULTI_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the avx2 lanes?
+#if defined(TB_ARCH_x64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(TB_COMPILER_IS_MSVC) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   define TB_HASH_MULTI_AVX2_ENABLE
+#endif
+
+// the lanes count
+#define TB_HASH_MULTI_LANES             (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the multi-buffer hash type
+ *
+ * the md-style hash with 64 bytes blocks and the 64-bit message length, e.g. md5, sha1 and sha2
+ */
+typedef struct __tb_hash_multi_t
+{
+    /// the state words count
+    tb_uint8_t          state_n;
+
+    /// the digest words count
+    tb_uint8_t          digest_n;
+
+    /// the words of the block, length and digest are little-endian? (e.g. md5)
+    tb_uint8_t          le;
+
+    /// the initial state
+    tb_uint32_t const*  iv;
+
+    /// transform one block
+    tb_void_t           (*transform)(tb_uint32_t* state, tb_byte_t const block[64]);
+
+    /// transform the blocks of all lanes, the state is transposed: state[word][lane], optional
+    tb_void_t           (*transform_lanes)(tb_uint32_t state[][TB_HASH_MULTI_LANES], tb_byte_t const* blocks[TB_HASH_MULTI_LANES]);
+
+}tb_hash_multi_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* make the digests of the multiple messages
+ *
+ * the messages are hashed in the parallel lanes if hash->transform_lanes is not null,
+ * and the idle lane will be filled with the next message immediately.
+ *
+ * @param hash          the hash
+ * @param ib            the input data list
+ * @param in            the input size list
+ * @param ob            the output data list
+ * @param count         the messages count
+ */
+tb_void_t               tb_hash_multi_make(tb_hash_multi_t const* hash, tb_byte_t const** ib, tb_size_t const* in, tb_byte_t** ob, tb_size_t count);
+
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+/* load the 32-bit words of all lane blocks with avx2, words[i][lane] = block[lane][i]
+ *
+ * @param words         the transposed words
+ * @param blocks        the lane blocks
+ * @param be            the words are big-endian?
+ */
+tb_void_t               tb_hash_multi_load_avx2(tb_uint32_t words[16][TB_HASH_MULTI_LANES], tb_byte_t const* blocks[TB_HASH_MULTI_LANES], tb_bool_t be);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -24,6 +24,12 @@
  * includes
  */
 #include "md5.h"
+#include "impl/multi.h"
+#include "../utils/bits.h"
+#include "../platform/cpu.h"
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+#   include <immintrin.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -63,6 +69,18 @@
 #define TB_MD5_S43 15
 #define TB_MD5_S44 21
 
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+// the md5 steps of the avx2 lanes
+#   define TB_MD5_AVX2_ROL(x, n)        _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#   define TB_MD5_AVX2_STEP(f, a, b, x, s, ac) \
+    a = _mm256_add_epi32(_mm256_add_epi32(a, f), _mm256_add_epi32(x, _mm256_set1_epi32((tb_int_t)(ac)))); \
+    a = _mm256_add_epi32(TB_MD5_AVX2_ROL(a, s), b)
+#   define TB_MD5_AVX2_FF(a, b, c, d, x, s, ac) TB_MD5_AVX2_STEP(_mm256_or_si256(_mm256_and_si256(b, c), _mm256_andnot_si256(b, d)), a, b, x, s, ac)
+#   define TB_MD5_AVX2_GG(a, b, c, d, x, s, ac) TB_MD5_AVX2_STEP(_mm256_or_si256(_mm256_and_si256(b, d), _mm256_andnot_si256(d, c)), a, b, x, s, ac)
+#   define TB_MD5_AVX2_HH(a, b, c, d, x, s, ac) TB_MD5_AVX2_STEP(_mm256_xor_si256(_mm256_xor_si256(b, c), d), a, b, x, s, ac)
+#   define TB_MD5_AVX2_II(a, b, c, d, x, s, ac) TB_MD5_AVX2_STEP(_mm256_xor_si256(c, _mm256_or_si256(b, _mm256_xor_si256(d, ones))), a, b, x, s, ac)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -80,6 +98,12 @@ static tb_byte_t g_md5_padding[64] =
 ,   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+// the initial state
+static tb_uint32_t const g_md5_iv[4] =
+{
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476
+};
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementaion
  */
@@ -171,6 +195,114 @@ static tb_void_t tb_md5_transform(tb_uint32_t* sp, tb_uint32_t* ip)
     sp[3] += d;
 }
 
+// transform one block of the multi-buffer hash
+static tb_void_t tb_md5_transform_block(tb_uint32_t* sp, tb_byte_t const block[64])
+{
+    tb_uint32_t ip[16];
+    tb_size_t   i = 0;
+    for (i = 0; i < 16; i++) ip[i] = tb_bits_get_u32_le(block + (i << 2));
+    tb_md5_transform(sp, ip);
+}
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+static __tb_target__("avx2") tb_void_t tb_md5_transform_lanes(tb_uint32_t sp[][TB_HASH_MULTI_LANES], tb_byte_t const* blocks[TB_HASH_MULTI_LANES])
+{
+    // load the transposed words of all lanes
+    tb_uint32_t words[16][TB_HASH_MULTI_LANES];
+    tb_hash_multi_load_avx2(words, blocks, tb_false);
+
+    // init
+    __m256i     w[16];
+    __m256i     ones = _mm256_set1_epi32(-1);
+    __m256i     a = _mm256_loadu_si256((__m256i const*)sp[0]);
+    __m256i     b = _mm256_loadu_si256((__m256i const*)sp[1]);
+    __m256i     c = _mm256_loadu_si256((__m256i const*)sp[2]);
+    __m256i     d = _mm256_loadu_si256((__m256i const*)sp[3]);
+    tb_size_t   i = 0;
+    for (i = 0; i < 16; i++) w[i] = _mm256_loadu_si256((__m256i const*)words[i]);
+
+    // round 1
+    TB_MD5_AVX2_FF(a, b, c, d, w[ 0], TB_MD5_S11, 3614090360u); /* 1 */
+    TB_MD5_AVX2_FF(d, a, b, c, w[ 1], TB_MD5_S12, 3905402710u); /* 2 */
+    TB_MD5_AVX2_FF(c, d, a, b, w[ 2], TB_MD5_S13,  606105819u); /* 3 */
+    TB_MD5_AVX2_FF(b, c, d, a, w[ 3], TB_MD5_S14, 3250441966u); /* 4 */
+    TB_MD5_AVX2_FF(a, b, c, d, w[ 4], TB_MD5_S11, 4118548399u); /* 5 */
+    TB_MD5_AVX2_FF(d, a, b, c, w[ 5], TB_MD5_S12, 1200080426u); /* 6 */
+    TB_MD5_AVX2_FF(c, d, a, b, w[ 6], TB_MD5_S13, 2821735955u); /* 7 */
+    TB_MD5_AVX2_FF(b, c, d, a, w[ 7], TB_MD5_S14, 4249261313u); /* 8 */
+    TB_MD5_AVX2_FF(a, b, c, d, w[ 8], TB_MD5_S11, 1770035416u); /* 9 */
+    TB_MD5_AVX2_FF(d, a, b, c, w[ 9], TB_MD5_S12, 2336552879u); /* 10 */
+    TB_MD5_AVX2_FF(c, d, a, b, w[10], TB_MD5_S13, 4294925233u); /* 11 */
+    TB_MD5_AVX2_FF(b, c, d, a, w[11], TB_MD5_S14, 2304563134u); /* 12 */
+    TB_MD5_AVX2_FF(a, b, c, d, w[12], TB_MD5_S11, 1804603682u); /* 13 */
+    TB_MD5_AVX2_FF(d, a, b, c, w[13], TB_MD5_S12, 4254626195u); /* 14 */
+    TB_MD5_AVX2_FF(c, d, a, b, w[14], TB_MD5_S13, 2792965006u); /* 15 */
+    TB_MD5_AVX2_FF(b, c, d, a, w[15], TB_MD5_S14, 1236535329u); /* 16 */
+
+    // round 2
+    TB_MD5_AVX2_GG(a, b, c, d, w[ 1], TB_MD5_S21, 4129170786u); /* 17 */
+    TB_MD5_AVX2_GG(d, a, b, c, w[ 6], TB_MD5_S22, 3225465664u); /* 18 */
+    TB_MD5_AVX2_GG(c, d, a, b, w[11], TB_MD5_S23,  643717713u); /* 19 */
+    TB_MD5_AVX2_GG(b, c, d, a, w[ 0], TB_MD5_S24, 3921069994u); /* 20 */
+    TB_MD5_AVX2_GG(a, b, c, d, w[ 5], TB_MD5_S21, 3593408605u); /* 21 */
+    TB_MD5_AVX2_GG(d, a, b, c, w[10], TB_MD5_S22,   38016083u); /* 22 */
+    TB_MD5_AVX2_GG(c, d, a, b, w[15], TB_MD5_S23, 3634488961u); /* 23 */
+    TB_MD5_AVX2_GG(b, c, d, a, w[ 4], TB_MD5_S24, 3889429448u); /* 24 */
+    TB_MD5_AVX2_GG(a, b, c, d, w[ 9], TB_MD5_S21,  568446438u); /* 25 */
+    TB_MD5_AVX2_GG(d, a, b, c, w[14], TB_MD5_S22, 3275163606u); /* 26 */
+    TB_MD5_AVX2_GG(c, d, a, b, w[ 3], TB_MD5_S23, 4107603335u); /* 27 */
+    TB_MD5_AVX2_GG(b, c, d, a, w[ 8], TB_MD5_S24, 1163531501u); /* 28 */
+    TB_MD5_AVX2_GG(a, b, c, d, w[13], TB_MD5_S21, 2850285829u); /* 29 */
+    TB_MD5_AVX2_GG(d, a, b, c, w[ 2], TB_MD5_S22, 4243563512u); /* 30 */
+    TB_MD5_AVX2_GG(c, d, a, b, w[ 7], TB_MD5_S23, 1735328473u); /* 31 */
+    TB_MD5_AVX2_GG(b, c, d, a, w[12], TB_MD5_S24, 2368359562u); /* 32 */
+
+    // round 3
+    TB_MD5_AVX2_HH(a, b, c, d, w[ 5], TB_MD5_S31, 4294588738u); /* 33 */
+    TB_MD5_AVX2_HH(d, a, b, c, w[ 8], TB_MD5_S32, 2272392833u); /* 34 */
+    TB_MD5_AVX2_HH(c, d, a, b, w[11], TB_MD5_S33, 1839030562u); /* 35 */
+    TB_MD5_AVX2_HH(b, c, d, a, w[14], TB_MD5_S34, 4259657740u); /* 36 */
+    TB_MD5_AVX2_HH(a, b, c, d, w[ 1], TB_MD5_S31, 2763975236u); /* 37 */
+    TB_MD5_AVX2_HH(d, a, b, c, w[ 4], TB_MD5_S32, 1272893353u); /* 38 */
+    TB_MD5_AVX2_HH(c, d, a, b, w[ 7], TB_MD5_S33, 4139469664u); /* 39 */
+    TB_MD5_AVX2_HH(b, c, d, a, w[10], TB_MD5_S34, 3200236656u); /* 40 */
+    TB_MD5_AVX2_HH(a, b, c, d, w[13], TB_MD5_S31,  681279174u); /* 41 */
+    TB_MD5_AVX2_HH(d, a, b, c, w[ 0], TB_MD5_S32, 3936430074u); /* 42 */
+    TB_MD5_AVX2_HH(c, d, a, b, w[ 3], TB_MD5_S33, 3572445317u); /* 43 */
+    TB_MD5_AVX2_HH(b, c, d, a, w[ 6], TB_MD5_S34,   76029189u); /* 44 */
+    TB_MD5_AVX2_HH(a, b, c, d, w[ 9], TB_MD5_S31, 3654602809u); /* 45 */
+    TB_MD5_AVX2_HH(d, a, b, c, w[12], TB_MD5_S32, 3873151461u); /* 46 */
+    TB_MD5_AVX2_HH(c, d, a, b, w[15], TB_MD5_S33,  530742520u); /* 47 */
+    TB_MD5_AVX2_HH(b, c, d, a, w[ 2], TB_MD5_S34, 3299628645u); /* 48 */
+
+    // round 4
+    TB_MD5_AVX2_II(a, b, c, d, w[ 0], TB_MD5_S41, 4096336452u); /* 49 */
+    TB_MD5_AVX2_II(d, a, b, c, w[ 7], TB_MD5_S42, 1126891415u); /* 50 */
+    TB_MD5_AVX2_II(c, d, a, b, w[14], TB_MD5_S43, 2878612391u); /* 51 */
+    TB_MD5_AVX2_II(b, c, d, a, w[ 5], TB_MD5_S44, 4237533241u); /* 52 */
+    TB_MD5_AVX2_II(a, b, c, d, w[12], TB_MD5_S41, 1700485571u); /* 53 */
+    TB_MD5_AVX2_II(d, a, b, c, w[ 3], TB_MD5_S42, 2399980690u); /* 54 */
+    TB_MD5_AVX2_II(c, d, a, b, w[10], TB_MD5_S43, 4293915773u); /* 55 */
+    TB_MD5_AVX2_II(b, c, d, a, w[ 1], TB_MD5_S44, 2240044497u); /* 56 */
+    TB_MD5_AVX2_II(a, b, c, d, w[ 8], TB_MD5_S41, 1873313359u); /* 57 */
+    TB_MD5_AVX2_II(d, a, b, c, w[15], TB_MD5_S42, 4264355552u); /* 58 */
+    TB_MD5_AVX2_II(c, d, a, b, w[ 6], TB_MD5_S43, 2734768916u); /* 59 */
+    TB_MD5_AVX2_II(b, c, d, a, w[13], TB_MD5_S44, 1309151649u); /* 60 */
+    TB_MD5_AVX2_II(a, b, c, d, w[ 4], TB_MD5_S41, 4149444226u); /* 61 */
+    TB_MD5_AVX2_II(d, a, b, c, w[11], TB_MD5_S42, 3174756917u); /* 62 */
+    TB_MD5_AVX2_II(c, d, a, b, w[ 2], TB_MD5_S43,  718787259u); /* 63 */
+    TB_MD5_AVX2_II(b, c, d, a, w[ 9], TB_MD5_S44, 3951481745u); /* 64 */
+
+    // update state
+    _mm256_storeu_si256((__m256i*)sp[0], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)sp[0]), a));
+    _mm256_storeu_si256((__m256i*)sp[1], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)sp[1]), b));
+    _mm256_storeu_si256((__m256i*)sp[2], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)sp[2]), c));
+    _mm256_storeu_si256((__m256i*)sp[3], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)sp[3]), d));
+
+    // leave the avx state
+    tb_avx_leave();
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -295,4 +427,23 @@ tb_size_t tb_md5_make(tb_byte_t const* ib, tb_size_t in, tb_byte_t* ob, tb_size_
     // ok
     return 16;
 }
-
+tb_size_t tb_md5_make_multi(tb_byte_t const** ib, tb_size_t const* in, tb_byte_t** ob, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(ib && in && ob, 0);
+
+    // init hash
+    tb_hash_multi_t hash = {0};
+    hash.state_n    = 4;
+    hash.digest_n   = 4;
+    hash.le         = 1;
+    hash.iv         = g_md5_iv;
+    hash.transform  = tb_md5_transform_block;
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+    if (tb_cpu_features() & TB_CPU_FEATURE_AVX2) hash.transform_lanes = tb_md5_transform_lanes;
+#endif
+
+    // make digests
+    tb_hash_multi_make(&hash, ib, in, ob, count);
+    return 16;
+}
@@ -84,6 +84,20 @@ tb_void_t               tb_md5_spak(tb_md5_t* md5, tb_byte_t const* data, tb_siz
  */
 tb_size_t               tb_md5_make(tb_byte_t const* ib, tb_size_t in, tb_byte_t* ob, tb_size_t on);
 
+/*! make md5 of the multiple messages
+ *
+ * the small messages are hashed in the parallel avx2 lanes if the cpu supports it,
+ * it is faster than calling tb_md5_make() for each message.
+ *
+ * @param ib            the input data list
+ * @param in            the input size list
+ * @param ob            the output data list, each output buffer must be not less than 16 bytes
+ * @param count         the messages count
+ *
+ * @return              the digest size
+ */
+tb_size_t               tb_md5_make_multi(tb_byte_t const** ib, tb_size_t const* in, tb_byte_t** ob, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -24,7 +24,18 @@
  * includes
  */
 #include "sha.h"
+#include "impl/multi.h"
 #include "../utils/bits.h"
+#include "../platform/cpu.h"
+#if defined(TB_ARCH_x64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(TB_COMPILER_IS_MSVC) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   include <immintrin.h>
+#   define TB_SHA_NI_ENABLE
+#elif defined(TB_ARCH_ARM64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#   include <arm_neon.h>
+#   define TB_SHA_ARMV8_ENABLE
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -69,9 +80,47 @@
     T1 = TB_SHA_BLK_(i); \
     TB_SHA_ROUND256(a,b,c,d,e,f,g,h)
 
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+// rol and ror for the avx2 lanes
+#   define TB_SHA_AVX2_ROL(x, n)        _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#   define TB_SHA_AVX2_ROR(x, n)        _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the transform type
+typedef tb_void_t (*tb_sha_transform_t)(tb_uint32_t* state, tb_byte_t const buffer[64]);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
+
+// the initial state of sha1
+static tb_uint32_t const g_sha_iv160[5] =
+{
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+// the initial state of sha224
+static tb_uint32_t const g_sha_iv224[8] =
+{
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+};
+
+// the initial state of sha256
+static tb_uint32_t const g_sha_iv256[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// the round constants of sha1
+static tb_uint32_t const g_sha_k160[4] =
+{
+    0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6
+};
+
 static tb_uint32_t const g_sha_k256[64] =
 {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
@@ -261,6 +310,620 @@ static tb_void_t tb_sha_transform_sha2(tb_uint32_t* state, tb_byte_t const buffe
     state[7] += h;
 }
 
+#if defined(TB_SHA_NI_ENABLE)
+// rounds 4 * i ~ 4 * i + 3 of sha1, e is the input e, n is the next e
+#   define TB_SHA1_NI_ROUNDS(abcd, e, n, m, f) \
+    e = _mm_sha1nexte_epu32(e, m); n = abcd; abcd = _mm_sha1rnds4_epu32(abcd, e, f)
+
+// rounds 4 * i ~ 4 * i + 3 of sha256
+#   define TB_SHA256_NI_ROUNDS(s0, s1, m, i) \
+    t = _mm_add_epi32(m, _mm_loadu_si128((__m128i const*)(g_sha_k256 + ((i) << 2)))); \
+    s1 = _mm_sha256rnds2_epu32(s1, s0, t)
+#   define TB_SHA256_NI_ROUNDS_END(s0, s1) \
+    t = _mm_shuffle_epi32(t, 0x0e); \
+    s0 = _mm_sha256rnds2_epu32(s0, s1, t)
+
+// the message schedule of sha256: m0 += (m3 + m2 << 32) and m2 = sigma(m3), ...
+#   define TB_SHA256_NI_MSG2(n, c, p) \
+    n = _mm_sha256msg2_epu32(_mm_add_epi32(n, _mm_alignr_epi8(c, p, 4)), c)
+
+static __tb_target__("sha,sse4.1") tb_void_t tb_sha_transform_sha1_ni(tb_uint32_t* state, tb_byte_t const buffer[64])
+{
+    // load state
+    __m128i order = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)state), 0x1b);
+    __m128i e0 = _mm_set_epi32((tb_int_t)state[4], 0, 0, 0);
+    __m128i abcd_save = abcd;
+    __m128i e0_save = e0;
+    __m128i e1;
+
+    // load block
+    __m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)buffer), order);
+    __m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(buffer + 16)), order);
+    __m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(buffer + 32)), order);
+    __m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(buffer + 48)), order);
+
+    // rounds 0-3
+    e0 = _mm_add_epi32(e0, m0);
+    e1 = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+
+    // rounds 4-7
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m1, 0);
+    m0 = _mm_sha1msg1_epu32(m0, m1);
+
+    // rounds 8-11
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m2, 0);
+    m1 = _mm_sha1msg1_epu32(m1, m2);
+    m0 = _mm_xor_si128(m0, m2);
+
+    // rounds 12-15
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m3, 0);
+    m0 = _mm_sha1msg2_epu32(m0, m3);
+    m2 = _mm_sha1msg1_epu32(m2, m3);
+    m1 = _mm_xor_si128(m1, m3);
+
+    // rounds 16-19
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m0, 0);
+    m1 = _mm_sha1msg2_epu32(m1, m0);
+    m3 = _mm_sha1msg1_epu32(m3, m0);
+    m2 = _mm_xor_si128(m2, m0);
+
+    // rounds 20-23
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m1, 1);
+    m2 = _mm_sha1msg2_epu32(m2, m1);
+    m0 = _mm_sha1msg1_epu32(m0, m1);
+    m3 = _mm_xor_si128(m3, m1);
+
+    // rounds 24-27
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m2, 1);
+    m3 = _mm_sha1msg2_epu32(m3, m2);
+    m1 = _mm_sha1msg1_epu32(m1, m2);
+    m0 = _mm_xor_si128(m0, m2);
+
+    // rounds 28-31
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m3, 1);
+    m0 = _mm_sha1msg2_epu32(m0, m3);
+    m2 = _mm_sha1msg1_epu32(m2, m3);
+    m1 = _mm_xor_si128(m1, m3);
+
+    // rounds 32-35
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m0, 1);
+    m1 = _mm_sha1msg2_epu32(m1, m0);
+    m3 = _mm_sha1msg1_epu32(m3, m0);
+    m2 = _mm_xor_si128(m2, m0);
+
+    // rounds 36-39
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m1, 1);
+    m2 = _mm_sha1msg2_epu32(m2, m1);
+    m0 = _mm_sha1msg1_epu32(m0, m1);
+    m3 = _mm_xor_si128(m3, m1);
+
+    // rounds 40-43
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m2, 2);
+    m3 = _mm_sha1msg2_epu32(m3, m2);
+    m1 = _mm_sha1msg1_epu32(m1, m2);
+    m0 = _mm_xor_si128(m0, m2);
+
+    // rounds 44-47
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m3, 2);
+    m0 = _mm_sha1msg2_epu32(m0, m3);
+    m2 = _mm_sha1msg1_epu32(m2, m3);
+    m1 = _mm_xor_si128(m1, m3);
+
+    // rounds 48-51
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m0, 2);
+    m1 = _mm_sha1msg2_epu32(m1, m0);
+    m3 = _mm_sha1msg1_epu32(m3, m0);
+    m2 = _mm_xor_si128(m2, m0);
+
+    // rounds 52-55
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m1, 2);
+    m2 = _mm_sha1msg2_epu32(m2, m1);
+    m0 = _mm_sha1msg1_epu32(m0, m1);
+    m3 = _mm_xor_si128(m3, m1);
+
+    // rounds 56-59
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m2, 2);
+    m3 = _mm_sha1msg2_epu32(m3, m2);
+    m1 = _mm_sha1msg1_epu32(m1, m2);
+    m0 = _mm_xor_si128(m0, m2);
+
+    // rounds 60-63
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m3, 3);
+    m0 = _mm_sha1msg2_epu32(m0, m3);
+    m2 = _mm_sha1msg1_epu32(m2, m3);
+    m1 = _mm_xor_si128(m1, m3);
+
+    // rounds 64-67
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m0, 3);
+    m1 = _mm_sha1msg2_epu32(m1, m0);
+    m3 = _mm_sha1msg1_epu32(m3, m0);
+    m2 = _mm_xor_si128(m2, m0);
+
+    // rounds 68-71
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m1, 3);
+    m2 = _mm_sha1msg2_epu32(m2, m1);
+    m3 = _mm_xor_si128(m3, m1);
+
+    // rounds 72-75
+    TB_SHA1_NI_ROUNDS(abcd, e0, e1, m2, 3);
+    m3 = _mm_sha1msg2_epu32(m3, m2);
+
+    // rounds 76-79
+    TB_SHA1_NI_ROUNDS(abcd, e1, e0, m3, 3);
+
+    // update state
+    e0 = _mm_sha1nexte_epu32(e0, e0_save);
+    abcd = _mm_add_epi32(abcd, abcd_save);
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = (tb_uint32_t)_mm_extract_epi32(e0, 3);
+}
+static __tb_target__("sha,sse4.1") tb_void_t tb_sha_transform_sha2_ni(tb_uint32_t* state, tb_byte_t const buffer[64])
+{
+    // load state, s0: abef, s1: cdgh
+    __m128i order = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i t = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)state), 0xb1);
+    __m128i s1 = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)(state + 4)), 0x1b);
+    __m128i s0 = _mm_alignr_epi8(t, s1, 8);
+    s1 = _mm_blend_epi16(s1, t, 0xf0);
+    __m128i s0_save = s0;
+    __m128i s1_save = s1;
+
+    // load block
+    __m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)buffer), order);
+    __m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(buffer + 16)), order);
+    __m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(buffer + 32)), order);
+    __m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(buffer + 48)), order);
+
+    // rounds 0-3
+    TB_SHA256_NI_ROUNDS(s0, s1, m0, 0);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+
+    // rounds 4-7
+    TB_SHA256_NI_ROUNDS(s0, s1, m1, 1);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m0 = _mm_sha256msg1_epu32(m0, m1);
+
+    // rounds 8-11
+    TB_SHA256_NI_ROUNDS(s0, s1, m2, 2);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m1 = _mm_sha256msg1_epu32(m1, m2);
+
+    // rounds 12-15
+    TB_SHA256_NI_ROUNDS(s0, s1, m3, 3);
+    TB_SHA256_NI_MSG2(m0, m3, m2);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m2 = _mm_sha256msg1_epu32(m2, m3);
+
+    // rounds 16-19
+    TB_SHA256_NI_ROUNDS(s0, s1, m0, 4);
+    TB_SHA256_NI_MSG2(m1, m0, m3);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m3 = _mm_sha256msg1_epu32(m3, m0);
+
+    // rounds 20-23
+    TB_SHA256_NI_ROUNDS(s0, s1, m1, 5);
+    TB_SHA256_NI_MSG2(m2, m1, m0);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m0 = _mm_sha256msg1_epu32(m0, m1);
+
+    // rounds 24-27
+    TB_SHA256_NI_ROUNDS(s0, s1, m2, 6);
+    TB_SHA256_NI_MSG2(m3, m2, m1);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m1 = _mm_sha256msg1_epu32(m1, m2);
+
+    // rounds 28-31
+    TB_SHA256_NI_ROUNDS(s0, s1, m3, 7);
+    TB_SHA256_NI_MSG2(m0, m3, m2);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m2 = _mm_sha256msg1_epu32(m2, m3);
+
+    // rounds 32-35
+    TB_SHA256_NI_ROUNDS(s0, s1, m0, 8);
+    TB_SHA256_NI_MSG2(m1, m0, m3);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m3 = _mm_sha256msg1_epu32(m3, m0);
+
+    // rounds 36-39
+    TB_SHA256_NI_ROUNDS(s0, s1, m1, 9);
+    TB_SHA256_NI_MSG2(m2, m1, m0);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m0 = _mm_sha256msg1_epu32(m0, m1);
+
+    // rounds 40-43
+    TB_SHA256_NI_ROUNDS(s0, s1, m2, 10);
+    TB_SHA256_NI_MSG2(m3, m2, m1);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m1 = _mm_sha256msg1_epu32(m1, m2);
+
+    // rounds 44-47
+    TB_SHA256_NI_ROUNDS(s0, s1, m3, 11);
+    TB_SHA256_NI_MSG2(m0, m3, m2);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m2 = _mm_sha256msg1_epu32(m2, m3);
+
+    // rounds 48-51
+    TB_SHA256_NI_ROUNDS(s0, s1, m0, 12);
+    TB_SHA256_NI_MSG2(m1, m0, m3);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+    m3 = _mm_sha256msg1_epu32(m3, m0);
+
+    // rounds 52-55
+    TB_SHA256_NI_ROUNDS(s0, s1, m1, 13);
+    TB_SHA256_NI_MSG2(m2, m1, m0);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+
+    // rounds 56-59
+    TB_SHA256_NI_ROUNDS(s0, s1, m2, 14);
+    TB_SHA256_NI_MSG2(m3, m2, m1);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+
+    // rounds 60-63
+    TB_SHA256_NI_ROUNDS(s0, s1, m3, 15);
+    TB_SHA256_NI_ROUNDS_END(s0, s1);
+
+    // update state
+    s0 = _mm_add_epi32(s0, s0_save);
+    s1 = _mm_add_epi32(s1, s1_save);
+    t = _mm_shuffle_epi32(s0, 0x1b);
+    s1 = _mm_shuffle_epi32(s1, 0xb1);
+    _mm_storeu_si128((__m128i*)state, _mm_blend_epi16(t, s1, 0xf0));
+    _mm_storeu_si128((__m128i*)(state + 4), _mm_alignr_epi8(s1, t, 8));
+}
+#elif defined(TB_SHA_ARMV8_ENABLE)
+// load 4 words of the big-endian block
+#   define TB_SHA_ARMV8_LOAD(p)             vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p)))
+
+// rounds 4 * i ~ 4 * i + 3 of sha1
+#   define TB_SHA1_ARMV8_ROUNDS(op, m, i) \
+    t = vaddq_u32(m, vdupq_n_u32(g_sha_k160[(i) / 5])); \
+    n = vsha1h_u32(vgetq_lane_u32(abcd, 0)); \
+    abcd = op(abcd, e, t); \
+    e = n
+
+// rounds 4 * i ~ 4 * i + 3 of sha256
+#   define TB_SHA256_ARMV8_ROUNDS(m, i) \
+    t = vaddq_u32(m, vld1q_u32(g_sha_k256 + ((i) << 2))); \
+    p = s0; \
+    s0 = vsha256hq_u32(s0, s1, t); \
+    s1 = vsha256h2q_u32(s1, p, t)
+
+static tb_void_t tb_sha_transform_sha1_armv8(tb_uint32_t* state, tb_byte_t const buffer[64])
+{
+    // load state
+    uint32x4_t  abcd = vld1q_u32(state);
+    uint32x4_t  abcd_save = abcd;
+    tb_uint32_t e = state[4];
+    tb_uint32_t n;
+    uint32x4_t  t;
+
+    // load block
+    uint32x4_t m0 = TB_SHA_ARMV8_LOAD(buffer);
+    uint32x4_t m1 = TB_SHA_ARMV8_LOAD(buffer + 16);
+    uint32x4_t m2 = TB_SHA_ARMV8_LOAD(buffer + 32);
+    uint32x4_t m3 = TB_SHA_ARMV8_LOAD(buffer + 48);
+
+    // rounds 0-3
+    TB_SHA1_ARMV8_ROUNDS(vsha1cq_u32, m0, 0);
+    m0 = vsha1su1q_u32(vsha1su0q_u32(m0, m1, m2), m3);
+
+    // rounds 4-7
+    TB_SHA1_ARMV8_ROUNDS(vsha1cq_u32, m1, 1);
+    m1 = vsha1su1q_u32(vsha1su0q_u32(m1, m2, m3), m0);
+
+    // rounds 8-11
+    TB_SHA1_ARMV8_ROUNDS(vsha1cq_u32, m2, 2);
+    m2 = vsha1su1q_u32(vsha1su0q_u32(m2, m3, m0), m1);
+
+    // rounds 12-15
+    TB_SHA1_ARMV8_ROUNDS(vsha1cq_u32, m3, 3);
+    m3 = vsha1su1q_u32(vsha1su0q_u32(m3, m0, m1), m2);
+
+    // rounds 16-19
+    TB_SHA1_ARMV8_ROUNDS(vsha1cq_u32, m0, 4);
+    m0 = vsha1su1q_u32(vsha1su0q_u32(m0, m1, m2), m3);
+
+    // rounds 20-23
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m1, 5);
+    m1 = vsha1su1q_u32(vsha1su0q_u32(m1, m2, m3), m0);
+
+    // rounds 24-27
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m2, 6);
+    m2 = vsha1su1q_u32(vsha1su0q_u32(m2, m3, m0), m1);
+
+    // rounds 28-31
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m3, 7);
+    m3 = vsha1su1q_u32(vsha1su0q_u32(m3, m0, m1), m2);
+
+    // rounds 32-35
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m0, 8);
+    m0 = vsha1su1q_u32(vsha1su0q_u32(m0, m1, m2), m3);
+
+    // rounds 36-39
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m1, 9);
+    m1 = vsha1su1q_u32(vsha1su0q_u32(m1, m2, m3), m0);
+
+    // rounds 40-43
+    TB_SHA1_ARMV8_ROUNDS(vsha1mq_u32, m2, 10);
+    m2 = vsha1su1q_u32(vsha1su0q_u32(m2, m3, m0), m1);
+
+    // rounds 44-47
+    TB_SHA1_ARMV8_ROUNDS(vsha1mq_u32, m3, 11);
+    m3 = vsha1su1q_u32(vsha1su0q_u32(m3, m0, m1), m2);
+
+    // rounds 48-51
+    TB_SHA1_ARMV8_ROUNDS(vsha1mq_u32, m0, 12);
+    m0 = vsha1su1q_u32(vsha1su0q_u32(m0, m1, m2), m3);
+
+    // rounds 52-55
+    TB_SHA1_ARMV8_ROUNDS(vsha1mq_u32, m1, 13);
+    m1 = vsha1su1q_u32(vsha1su0q_u32(m1, m2, m3), m0);
+
+    // rounds 56-59
+    TB_SHA1_ARMV8_ROUNDS(vsha1mq_u32, m2, 14);
+    m2 = vsha1su1q_u32(vsha1su0q_u32(m2, m3, m0), m1);
+
+    // rounds 60-63
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m3, 15);
+    m3 = vsha1su1q_u32(vsha1su0q_u32(m3, m0, m1), m2);
+
+    // rounds 64-67
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m0, 16);
+
+    // rounds 68-71
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m1, 17);
+
+    // rounds 72-75
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m2, 18);
+
+    // rounds 76-79
+    TB_SHA1_ARMV8_ROUNDS(vsha1pq_u32, m3, 19);
+
+    // update state
+    vst1q_u32(state, vaddq_u32(abcd, abcd_save));
+    state[4] += e;
+}
+static tb_void_t tb_sha_transform_sha2_armv8(tb_uint32_t* state, tb_byte_t const buffer[64])
+{
+    // load state
+    uint32x4_t s0 = vld1q_u32(state);
+    uint32x4_t s1 = vld1q_u32(state + 4);
+    uint32x4_t s0_save = s0;
+    uint32x4_t s1_save = s1;
+    uint32x4_t t;
+    uint32x4_t p;
+
+    // load block
+    uint32x4_t m0 = TB_SHA_ARMV8_LOAD(buffer);
+    uint32x4_t m1 = TB_SHA_ARMV8_LOAD(buffer + 16);
+    uint32x4_t m2 = TB_SHA_ARMV8_LOAD(buffer + 32);
+    uint32x4_t m3 = TB_SHA_ARMV8_LOAD(buffer + 48);
+
+    // rounds 0-3
+    TB_SHA256_ARMV8_ROUNDS(m0, 0);
+    m0 = vsha256su1q_u32(vsha256su0q_u32(m0, m1), m2, m3);
+
+    // rounds 4-7
+    TB_SHA256_ARMV8_ROUNDS(m1, 1);
+    m1 = vsha256su1q_u32(vsha256su0q_u32(m1, m2), m3, m0);
+
+    // rounds 8-11
+    TB_SHA256_ARMV8_ROUNDS(m2, 2);
+    m2 = vsha256su1q_u32(vsha256su0q_u32(m2, m3), m0, m1);
+
+    // rounds 12-15
+    TB_SHA256_ARMV8_ROUNDS(m3, 3);
+    m3 = vsha256su1q_u32(vsha256su0q_u32(m3, m0), m1, m2);
+
+    // rounds 16-19
+    TB_SHA256_ARMV8_ROUNDS(m0, 4);
+    m0 = vsha256su1q_u32(vsha256su0q_u32(m0, m1), m2, m3);
+
+    // rounds 20-23
+    TB_SHA256_ARMV8_ROUNDS(m1, 5);
+    m1 = vsha256su1q_u32(vsha256su0q_u32(m1, m2), m3, m0);
+
+    // rounds 24-27
+    TB_SHA256_ARMV8_ROUNDS(m2, 6);
+    m2 = vsha256su1q_u32(vsha256su0q_u32(m2, m3), m0, m1);
+
+    // rounds 28-31
+    TB_SHA256_ARMV8_ROUNDS(m3, 7);
+    m3 = vsha256su1q_u32(vsha256su0q_u32(m3, m0), m1, m2);
+
+    // rounds 32-35
+    TB_SHA256_ARMV8_ROUNDS(m0, 8);
+    m0 = vsha256su1q_u32(vsha256su0q_u32(m0, m1), m2, m3);
+
+    // rounds 36-39
+    TB_SHA256_ARMV8_ROUNDS(m1, 9);
+    m1 = vsha256su1q_u32(vsha256su0q_u32(m1, m2), m3, m0);
+
+    // rounds 40-43
+    TB_SHA256_ARMV8_ROUNDS(m2, 10);
+    m2 = vsha256su1q_u32(vsha256su0q_u32(m2, m3), m0, m1);
+
+    // rounds 44-47
+    TB_SHA256_ARMV8_ROUNDS(m3, 11);
+    m3 = vsha256su1q_u32(vsha256su0q_u32(m3, m0), m1, m2);
+
+    // rounds 48-51
+    TB_SHA256_ARMV8_ROUNDS(m0, 12);
+
+    // rounds 52-55
+    TB_SHA256_ARMV8_ROUNDS(m1, 13);
+
+    // rounds 56-59
+    TB_SHA256_ARMV8_ROUNDS(m2, 14);
+
+    // rounds 60-63
+    TB_SHA256_ARMV8_ROUNDS(m3, 15);
+
+    // update state
+    vst1q_u32(state, vaddq_u32(s0, s0_save));
+    vst1q_u32(state + 4, vaddq_u32(s1, s1_save));
+}
+#endif
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+static __tb_target__("avx2") tb_void_t tb_sha_transform_sha1_lanes(tb_uint32_t state[][TB_HASH_MULTI_LANES], tb_byte_t const* blocks[TB_HASH_MULTI_LANES])
+{
+    // load the transposed words of all lanes
+    tb_uint32_t words[16][TB_HASH_MULTI_LANES];
+    tb_hash_multi_load_avx2(words, blocks, tb_true);
+
+    // init
+    __m256i     w[16];
+    __m256i     t;
+    __m256i     k;
+    __m256i     a = _mm256_loadu_si256((__m256i const*)state[0]);
+    __m256i     b = _mm256_loadu_si256((__m256i const*)state[1]);
+    __m256i     c = _mm256_loadu_si256((__m256i const*)state[2]);
+    __m256i     d = _mm256_loadu_si256((__m256i const*)state[3]);
+    __m256i     e = _mm256_loadu_si256((__m256i const*)state[4]);
+    tb_size_t   i = 0;
+    for (i = 0; i < 16; i++) w[i] = _mm256_loadu_si256((__m256i const*)words[i]);
+
+    // the rounds with the ring buffer of the message words
+#define TB_SHA1_AVX2_ROUND(f) \
+    if (i >= 16) \
+    { \
+        t = _mm256_xor_si256(_mm256_xor_si256(w[(i - 3) & 15], w[(i - 8) & 15]), _mm256_xor_si256(w[(i - 14) & 15], w[i & 15])); \
+        w[i & 15] = TB_SHA_AVX2_ROL(t, 1); \
+    } \
+    t = _mm256_add_epi32(_mm256_add_epi32(TB_SHA_AVX2_ROL(a, 5), f), _mm256_add_epi32(_mm256_add_epi32(e, k), w[i & 15])); \
+    e = d; \
+    d = c; \
+    c = TB_SHA_AVX2_ROL(b, 30); \
+    b = a; \
+    a = t
+
+    k = _mm256_set1_epi32((tb_int_t)g_sha_k160[0]);
+    for (i = 0; i < 20; i++)
+    {
+        TB_SHA1_AVX2_ROUND(_mm256_xor_si256(_mm256_and_si256(b, _mm256_xor_si256(c, d)), d));
+    }
+    k = _mm256_set1_epi32((tb_int_t)g_sha_k160[1]);
+    for (; i < 40; i++)
+    {
+        TB_SHA1_AVX2_ROUND(_mm256_xor_si256(_mm256_xor_si256(b, c), d));
+    }
+    k = _mm256_set1_epi32((tb_int_t)g_sha_k160[2]);
+    for (; i < 60; i++)
+    {
+        TB_SHA1_AVX2_ROUND(_mm256_or_si256(_mm256_and_si256(_mm256_or_si256(b, c), d), _mm256_and_si256(b, c)));
+    }
+    k = _mm256_set1_epi32((tb_int_t)g_sha_k160[3]);
+    for (; i < 80; i++)
+    {
+        TB_SHA1_AVX2_ROUND(_mm256_xor_si256(_mm256_xor_si256(b, c), d));
+    }
+#undef TB_SHA1_AVX2_ROUND
+
+    // update state
+    _mm256_storeu_si256((__m256i*)state[0], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)state[0]), a));
+    _mm256_storeu_si256((__m256i*)state[1], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)state[1]), b));
+    _mm256_storeu_si256((__m256i*)state[2], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)state[2]), c));
+    _mm256_storeu_si256((__m256i*)state[3], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)state[3]), d));
+    _mm256_storeu_si256((__m256i*)state[4], _mm256_add_epi32(_mm256_loadu_si256((__m256i const*)state[4]), e));
+
+    // leave the avx state
+    tb_avx_leave();
+}
+static __tb_target__("avx2") tb_void_t tb_sha_transform_sha2_lanes(tb_uint32_t state[][TB_HASH_MULTI_LANES], tb_byte_t const* blocks[TB_HASH_MULTI_LANES])
+{
+    // load the transposed words of all lanes
+    tb_uint32_t words[16][TB_HASH_MULTI_LANES];
+    tb_hash_multi_load_avx2(words, blocks, tb_true);
+
+    // init
+    __m256i     w[16];
+    __m256i     t1;
+    __m256i     t2;
+    __m256i     v[8];
+    tb_size_t   i = 0;
+    for (i = 0; i < 8; i++) v[i] = _mm256_loadu_si256((__m256i const*)state[i]);
+    for (i = 0; i < 16; i++) w[i] = _mm256_loadu_si256((__m256i const*)words[i]);
+
+    // done
+    __m256i a = v[0];
+    __m256i b = v[1];
+    __m256i c = v[2];
+    __m256i d = v[3];
+    __m256i e = v[4];
+    __m256i f = v[5];
+    __m256i g = v[6];
+    __m256i h = v[7];
+    for (i = 0; i < 64; i++)
+    {
+        // w[i] = w[i - 16] + sigma0(w[i - 15]) + w[i - 7] + sigma1(w[i - 2])
+        if (i >= 16)
+        {
+            __m256i x = w[(i - 15) & 15];
+            __m256i y = w[(i - 2) & 15];
+            t1 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_AVX2_ROR(x, 7), TB_SHA_AVX2_ROR(x, 18)), _mm256_srli_epi32(x, 3));
+            t2 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_AVX2_ROR(y, 17), TB_SHA_AVX2_ROR(y, 19)), _mm256_srli_epi32(y, 10));
+            w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], t1), _mm256_add_epi32(w[(i - 7) & 15], t2));
+        }
+
+        // t1 = h + Sigma1(e) + ch(e, f, g) + k[i] + w[i]
+        t1 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_AVX2_ROR(e, 6), TB_SHA_AVX2_ROR(e, 11)), TB_SHA_AVX2_ROR(e, 25));
+        t1 = _mm256_add_epi32(_mm256_add_epi32(h, t1), _mm256_xor_si256(_mm256_and_si256(e, _mm256_xor_si256(f, g)), g));
+        t1 = _mm256_add_epi32(t1, _mm256_add_epi32(_mm256_set1_epi32((tb_int_t)g_sha_k256[i]), w[i & 15]));
+
+        // t2 = Sigma0(a) + maj(a, b, c)
+        t2 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_AVX2_ROR(a, 2), TB_SHA_AVX2_ROR(a, 13)), TB_SHA_AVX2_ROR(a, 22));
+        t2 = _mm256_add_epi32(t2, _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), c), _mm256_and_si256(a, b)));
+
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, t2);
+    }
+
+    // update state
+    _mm256_storeu_si256((__m256i*)state[0], _mm256_add_epi32(v[0], a));
+    _mm256_storeu_si256((__m256i*)state[1], _mm256_add_epi32(v[1], b));
+    _mm256_storeu_si256((__m256i*)state[2], _mm256_add_epi32(v[2], c));
+    _mm256_storeu_si256((__m256i*)state[3], _mm256_add_epi32(v[3], d));
+    _mm256_storeu_si256((__m256i*)state[4], _mm256_add_epi32(v[4], e));
+    _mm256_storeu_si256((__m256i*)state[5], _mm256_add_epi32(v[5], f));
+    _mm256_storeu_si256((__m256i*)state[6], _mm256_add_epi32(v[6], g));
+    _mm256_storeu_si256((__m256i*)state[7], _mm256_add_epi32(v[7], h));
+
+    // leave the avx state
+    tb_avx_leave();
+}
+#endif
+static tb_sha_transform_t tb_sha_transform_sha1_best()
+{
+#if defined(TB_SHA_NI_ENABLE)
+    if ((tb_cpu_features() & (TB_CPU_FEATURE_SHA | TB_CPU_FEATURE_SSE41)) == (TB_CPU_FEATURE_SHA | TB_CPU_FEATURE_SSE41))
+        return tb_sha_transform_sha1_ni;
+#elif defined(TB_SHA_ARMV8_ENABLE)
+    if (tb_cpu_features() & TB_CPU_FEATURE_SHA1)
+        return tb_sha_transform_sha1_armv8;
+#endif
+    return tb_sha_transform_sha1;
+}
+static tb_sha_transform_t tb_sha_transform_sha2_best()
+{
+#if defined(TB_SHA_NI_ENABLE)
+    if ((tb_cpu_features() & (TB_CPU_FEATURE_SHA | TB_CPU_FEATURE_SSE41)) == (TB_CPU_FEATURE_SHA | TB_CPU_FEATURE_SSE41))
+        return tb_sha_transform_sha2_ni;
+#elif defined(TB_SHA_ARMV8_ENABLE)
+    if (tb_cpu_features() & TB_CPU_FEATURE_SHA2)
+        return tb_sha_transform_sha2_armv8;
+#endif
+    return tb_sha_transform_sha2;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -277,34 +940,16 @@ tb_void_t tb_sha_init(tb_sha_t* sha, tb_size_t mode)
     switch (mode)
     {
     case TB_SHA_MODE_SHA1_160:
-        sha->state[0] = 0x67452301;
-        sha->state[1] = 0xefcdab89;
-        sha->state[2] = 0x98badcfe;
-        sha->state[3] = 0x10325476;
-        sha->state[4] = 0xc3d2e1f0;
-        sha->transform = tb_sha_transform_sha1;
+        tb_memcpy(sha->state, g_sha_iv160, sizeof(g_sha_iv160));
+        sha->transform = tb_sha_transform_sha1_best();
         break;
     case TB_SHA_MODE_SHA2_224:
-        sha->state[0] = 0xc1059ed8;
-        sha->state[1] = 0x367cd507;
-        sha->state[2] = 0x3070dd17;
-        sha->state[3] = 0xf70e5939;
-        sha->state[4] = 0xffc00b31;
-        sha->state[5] = 0x68581511;
-        sha->state[6] = 0x64f98fa7;
-        sha->state[7] = 0xbefa4fa4;
-        sha->transform = tb_sha_transform_sha2;
+        tb_memcpy(sha->state, g_sha_iv224, sizeof(g_sha_iv224));
+        sha->transform = tb_sha_transform_sha2_best();
         break;
     case TB_SHA_MODE_SHA2_256:
-        sha->state[0] = 0x6a09e667;
-        sha->state[1] = 0xbb67ae85;
-        sha->state[2] = 0x3c6ef372;
-        sha->state[3] = 0xa54ff53a;
-        sha->state[4] = 0x510e527f;
-        sha->state[5] = 0x9b05688c;
-        sha->state[6] = 0x1f83d9ab;
-        sha->state[7] = 0x5be0cd19;
-        sha->transform = tb_sha_transform_sha2;
+        tb_memcpy(sha->state, g_sha_iv256, sizeof(g_sha_iv256));
+        sha->transform = tb_sha_transform_sha2_best();
         break;
     default:
         tb_assert(0);
@@ -383,4 +1028,46 @@ tb_size_t tb_sha_make(tb_size_t mode, tb_byte_t const* ib, tb_size_t in, tb_byte
     // ok?
     return (sha.digest_len << 2);
 }
+tb_size_t tb_sha_make_multi(tb_size_t mode, tb_byte_t const** ib, tb_size_t const* in, tb_byte_t** ob, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(ib && in && ob, 0);
 
+    // init hash
+    tb_hash_multi_t hash = {0};
+    hash.digest_n = (tb_uint8_t)((mode >> 5) & 0xff);
+    switch (mode)
+    {
+    case TB_SHA_MODE_SHA1_160:
+        hash.state_n    = 5;
+        hash.iv         = g_sha_iv160;
+        hash.transform  = tb_sha_transform_sha1_best();
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+        if (hash.transform == tb_sha_transform_sha1) hash.transform_lanes = tb_sha_transform_sha1_lanes;
+#endif
+        break;
+    case TB_SHA_MODE_SHA2_224:
+    case TB_SHA_MODE_SHA2_256:
+        hash.state_n    = 8;
+        hash.iv         = mode == TB_SHA_MODE_SHA2_224? g_sha_iv224 : g_sha_iv256;
+        hash.transform  = tb_sha_transform_sha2_best();
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+        if (hash.transform == tb_sha_transform_sha2) hash.transform_lanes = tb_sha_transform_sha2_lanes;
+#endif
+        break;
+    default:
+        tb_assert_and_check_return_val(0, 0);
+        break;
+    }
+
+    /* the avx2 lanes are only used if no sha instructions,
+     * the sha instructions of one message are faster than the eight avx2 lanes
+     */
+#ifdef TB_HASH_MULTI_AVX2_ENABLE
+    if (!(tb_cpu_features() & TB_CPU_FEATURE_AVX2)) hash.transform_lanes = tb_null;
+#endif
+
+    // make digests
+    tb_hash_multi_make(&hash, ib, in, ob, count);
+    return (hash.digest_n << 2);
+}
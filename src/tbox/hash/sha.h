@@ -95,6 +95,21 @@ tb_void_t               tb_sha_spak(tb_sha_t* sha, tb_byte_t const* data, tb_siz
  */
 tb_size_t               tb_sha_make(tb_size_t mode, tb_byte_t const* ib, tb_size_t ip, tb_byte_t* ob, tb_size_t on);
 
+/*! make sha of the multiple messages
+ *
+ * the messages are hashed with the sha instructions (x86 sha-ni or armv8) if the cpu supports it,
+ * otherwise the small messages are hashed in the parallel avx2 lanes.
+ *
+ * @param mode          the mode
+ * @param ib            the input data list
+ * @param in            the input size list
+ * @param ob            the output data list, each output buffer must be not less than the digest size
+ * @param count         the messages count
+ *
+ * @return              the digest size
+ */
+tb_size_t               tb_sha_make_multi(tb_size_t mode, tb_byte_t const** ib, tb_size_t const* in, tb_byte_t** ob, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,394 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        xxh3.c
+ * @ingroup     hash
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "xxh3.h"
+#include "../utils/bits.h"
+#include "../platform/cpu.h"
+#if defined(TB_ARCH_x64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(TB_COMPILER_IS_MSVC) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   include <immintrin.h>
+#   define TB_XXH3_SIMD_ENABLE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the primes
+#define TB_XXH3_PRIME32_1           (0x9e3779b1u)
+#define TB_XXH3_PRIME32_2           (0x85ebca77u)
+#define TB_XXH3_PRIME32_3           (0xc2b2ae3du)
+#define TB_XXH3_PRIME64_1           (0x9e3779b185ebca87ull)
+#define TB_XXH3_PRIME64_2           (0xc2b2ae3d27d4eb4full)
+#define TB_XXH3_PRIME64_3           (0x165667b19e3779f9ull)
+#define TB_XXH3_PRIME64_4           (0x85ebca77c2b2ae63ull)
+#define TB_XXH3_PRIME64_5           (0x27d4eb2f165667c5ull)
+#define TB_XXH3_PRIME_MX1           (0x165667919e3779f9ull)
+#define TB_XXH3_PRIME_MX2           (0x9fb21c651e98df25ull)
+
+// the secret size
+#define TB_XXH3_SECRET_SIZE         (192)
+
+// the stripe size and the stripes count of one block
+#define TB_XXH3_STRIPE_SIZE         (64)
+#define TB_XXH3_STRIPES             ((TB_XXH3_SECRET_SIZE - TB_XXH3_STRIPE_SIZE) >> 3)
+#define TB_XXH3_BLOCK_SIZE          (TB_XXH3_STRIPE_SIZE * TB_XXH3_STRIPES)
+
+// the max size of the short input without the stripes
+#define TB_XXH3_MIDSIZE_MAX         (240)
+
+// read the little-endian words
+#define tb_xxh3_read32(p)           tb_bits_get_u32_le(p)
+#define tb_xxh3_read64(p)           tb_bits_get_u64_le(p)
+
+// rotate left
+#define tb_xxh3_rotl64(x, n)        (((x) << (n)) | ((x) >> (64 - (n))))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// accumulate the stripes of one block
+typedef tb_void_t (*tb_xxh3_accumulate_t)(tb_uint64_t* acc, tb_byte_t const* data, tb_byte_t const* secret, tb_size_t stripes);
+
+// scramble the accumulators
+typedef tb_void_t (*tb_xxh3_scramble_t)(tb_uint64_t* acc, tb_byte_t const* secret);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the default secret
+static tb_byte_t const g_xxh3_secret[TB_XXH3_SECRET_SIZE] =
+{
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c
+,   0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f
+,   0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21
+,   0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c
+,   0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3
+,   0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8
+,   0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d
+,   0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64
+,   0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb
+,   0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e
+,   0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce
+,   0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_uint64_t tb_xxh3_mul128_fold64(tb_uint64_t a, tb_uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)a * b;
+    return (tb_uint64_t)p ^ (tb_uint64_t)(p >> 64);
+#else
+    // the 64x64 => 128 multiplication with the 32-bit parts
+    tb_uint64_t lo_lo = (a & 0xffffffff) * (b & 0xffffffff);
+    tb_uint64_t hi_lo = (a >> 32) * (b & 0xffffffff);
+    tb_uint64_t lo_hi = (a & 0xffffffff) * (b >> 32);
+    tb_uint64_t hi_hi = (a >> 32) * (b >> 32);
+    tb_uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+    tb_uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    tb_uint64_t lower = (cross << 32) | (lo_lo & 0xffffffff);
+    return lower ^ upper;
+#endif
+}
+static __tb_inline__ tb_uint64_t tb_xxh3_avalanche(tb_uint64_t h)
+{
+    h ^= h >> 37;
+    h *= TB_XXH3_PRIME_MX1;
+    h ^= h >> 32;
+    return h;
+}
+static __tb_inline__ tb_uint64_t tb_xxh3_avalanche_xxh64(tb_uint64_t h)
+{
+    h ^= h >> 33;
+    h *= TB_XXH3_PRIME64_2;
+    h ^= h >> 29;
+    h *= TB_XXH3_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+static __tb_inline__ tb_uint64_t tb_xxh3_rrmxmx(tb_uint64_t h, tb_uint64_t size)
+{
+    h ^= tb_xxh3_rotl64(h, 49) ^ tb_xxh3_rotl64(h, 24);
+    h *= TB_XXH3_PRIME_MX2;
+    h ^= (h >> 35) + size;
+    h *= TB_XXH3_PRIME_MX2;
+    h ^= h >> 28;
+    return h;
+}
+static __tb_inline__ tb_uint64_t tb_xxh3_mix16(tb_byte_t const* data, tb_byte_t const* secret, tb_uint64_t seed)
+{
+    tb_uint64_t lo = tb_xxh3_read64(data);
+    tb_uint64_t hi = tb_xxh3_read64(data + 8);
+    return tb_xxh3_mul128_fold64(lo ^ (tb_xxh3_read64(secret) + seed), hi ^ (tb_xxh3_read64(secret + 8) - seed));
+}
+static tb_uint64_t tb_xxh3_make_0to16(tb_byte_t const* data, tb_size_t size, tb_byte_t const* secret, tb_uint64_t seed)
+{
+    // 9 ~ 16 bytes
+    if (size > 8)
+    {
+        tb_uint64_t flip1 = (tb_xxh3_read64(secret + 24) ^ tb_xxh3_read64(secret + 32)) + seed;
+        tb_uint64_t flip2 = (tb_xxh3_read64(secret + 40) ^ tb_xxh3_read64(secret + 48)) - seed;
+        tb_uint64_t lo = tb_xxh3_read64(data) ^ flip1;
+        tb_uint64_t hi = tb_xxh3_read64(data + size - 8) ^ flip2;
+        return tb_xxh3_avalanche(size + tb_bits_swap_u64(lo) + hi + tb_xxh3_mul128_fold64(lo, hi));
+    }
+    // 4 ~ 8 bytes
+    else if (size >= 4)
+    {
+        seed ^= (tb_uint64_t)tb_bits_swap_u32((tb_uint32_t)seed) << 32;
+        tb_uint64_t flip = (tb_xxh3_read64(secret + 8) ^ tb_xxh3_read64(secret + 16)) - seed;
+        tb_uint64_t v = tb_xxh3_read32(data + size - 4) + ((tb_uint64_t)tb_xxh3_read32(data) << 32);
+        return tb_xxh3_rrmxmx(v ^ flip, size);
+    }
+    // 1 ~ 3 bytes
+    else if (size)
+    {
+        tb_uint32_t v = ((tb_uint32_t)data[0] << 16) | ((tb_uint32_t)data[size >> 1] << 24) | data[size - 1] | ((tb_uint32_t)size << 8);
+        tb_uint64_t flip = (tb_xxh3_read32(secret) ^ tb_xxh3_read32(secret + 4)) + seed;
+        return tb_xxh3_avalanche_xxh64((tb_uint64_t)v ^ flip);
+    }
+    return tb_xxh3_avalanche_xxh64(seed ^ tb_xxh3_read64(secret + 56) ^ tb_xxh3_read64(secret + 64));
+}
+static tb_uint64_t tb_xxh3_make_17to128(tb_byte_t const* data, tb_size_t size, tb_byte_t const* secret, tb_uint64_t seed)
+{
+    tb_uint64_t acc = size * TB_XXH3_PRIME64_1;
+    if (size > 32)
+    {
+        if (size > 64)
+        {
+            if (size > 96)
+            {
+                acc += tb_xxh3_mix16(data + 48, secret + 96, seed);
+                acc += tb_xxh3_mix16(data + size - 64, secret + 112, seed);
+            }
+            acc += tb_xxh3_mix16(data + 32, secret + 64, seed);
+            acc += tb_xxh3_mix16(data + size - 48, secret + 80, seed);
+        }
+        acc += tb_xxh3_mix16(data + 16, secret + 32, seed);
+        acc += tb_xxh3_mix16(data + size - 32, secret + 48, seed);
+    }
+    acc += tb_xxh3_mix16(data, secret, seed);
+    acc += tb_xxh3_mix16(data + size - 16, secret + 16, seed);
+    return tb_xxh3_avalanche(acc);
+}
+static tb_uint64_t tb_xxh3_make_129to240(tb_byte_t const* data, tb_size_t size, tb_byte_t const* secret, tb_uint64_t seed)
+{
+    tb_size_t   i = 0;
+    tb_size_t   n = size >> 4;
+    tb_uint64_t acc = size * TB_XXH3_PRIME64_1;
+    for (i = 0; i < 8; i++)
+        acc += tb_xxh3_mix16(data + (i << 4), secret + (i << 4), seed);
+    acc = tb_xxh3_avalanche(acc);
+    for (i = 8; i < n; i++)
+        acc += tb_xxh3_mix16(data + (i << 4), secret + ((i - 8) << 4) + 3, seed);
+    acc += tb_xxh3_mix16(data + size - 16, secret + 136 - 17, seed);
+    return tb_xxh3_avalanche(acc);
+}
+static tb_void_t tb_xxh3_accumulate(tb_uint64_t* acc, tb_byte_t const* data, tb_byte_t const* secret, tb_size_t stripes)
+{
+    tb_size_t i = 0;
+    for (; stripes--; data += TB_XXH3_STRIPE_SIZE, secret += 8)
+    {
+        for (i = 0; i < 8; i++)
+        {
+            tb_uint64_t v = tb_xxh3_read64(data + (i << 3));
+            tb_uint64_t k = v ^ tb_xxh3_read64(secret + (i << 3));
+            acc[i ^ 1] += v;
+            acc[i] += (k & 0xffffffff) * (k >> 32);
+        }
+    }
+}
+static tb_void_t tb_xxh3_scramble(tb_uint64_t* acc, tb_byte_t const* secret)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < 8; i++)
+    {
+        tb_uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= tb_xxh3_read64(secret + (i << 3));
+        acc[i] = a * TB_XXH3_PRIME32_1;
+    }
+}
+#ifdef TB_XXH3_SIMD_ENABLE
+static tb_void_t tb_xxh3_accumulate_sse2(tb_uint64_t* acc, tb_byte_t const* data, tb_byte_t const* secret, tb_size_t stripes)
+{
+    tb_size_t   i = 0;
+    __m128i*    p = (__m128i*)acc;
+    __m128i     a[4];
+    for (i = 0; i < 4; i++) a[i] = _mm_loadu_si128(p + i);
+    for (; stripes--; data += TB_XXH3_STRIPE_SIZE, secret += 8)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            // acc[i ^ 1] += v, acc[i] += lo32(v ^ k) * hi32(v ^ k)
+            __m128i v = _mm_loadu_si128((__m128i const*)data + i);
+            __m128i k = _mm_xor_si128(v, _mm_loadu_si128((__m128i const*)secret + i));
+            __m128i m = _mm_mul_epu32(k, _mm_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+            a[i] = _mm_add_epi64(a[i], _mm_add_epi64(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), m));
+        }
+    }
+    for (i = 0; i < 4; i++) _mm_storeu_si128(p + i, a[i]);
+}
+static tb_void_t tb_xxh3_scramble_sse2(tb_uint64_t* acc, tb_byte_t const* secret)
+{
+    tb_size_t   i = 0;
+    __m128i*    p = (__m128i*)acc;
+    __m128i     prime = _mm_set1_epi32((tb_int_t)TB_XXH3_PRIME32_1);
+    for (i = 0; i < 4; i++)
+    {
+        // acc = (acc ^ (acc >> 47) ^ k) * prime32
+        __m128i a = _mm_loadu_si128(p + i);
+        a = _mm_xor_si128(_mm_xor_si128(a, _mm_srli_epi64(a, 47)), _mm_loadu_si128((__m128i const*)secret + i));
+        __m128i lo = _mm_mul_epu32(a, prime);
+        __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128(p + i, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+    }
+}
+static __tb_target__("avx2") tb_void_t tb_xxh3_accumulate_avx2(tb_uint64_t* acc, tb_byte_t const* data, tb_byte_t const* secret, tb_size_t stripes)
+{
+    __m256i* p = (__m256i*)acc;
+    __m256i  a0 = _mm256_loadu_si256(p);
+    __m256i  a1 = _mm256_loadu_si256(p + 1);
+    for (; stripes--; data += TB_XXH3_STRIPE_SIZE, secret += 8)
+    {
+        // acc[i ^ 1] += v, acc[i] += lo32(v ^ k) * hi32(v ^ k)
+        __m256i v0 = _mm256_loadu_si256((__m256i const*)data);
+        __m256i v1 = _mm256_loadu_si256((__m256i const*)data + 1);
+        __m256i k0 = _mm256_xor_si256(v0, _mm256_loadu_si256((__m256i const*)secret));
+        __m256i k1 = _mm256_xor_si256(v1, _mm256_loadu_si256((__m256i const*)secret + 1));
+        __m256i m0 = _mm256_mul_epu32(k0, _mm256_srli_epi64(k0, 32));
+        __m256i m1 = _mm256_mul_epu32(k1, _mm256_srli_epi64(k1, 32));
+        a0 = _mm256_add_epi64(a0, _mm256_add_epi64(_mm256_shuffle_epi32(v0, _MM_SHUFFLE(1, 0, 3, 2)), m0));
+        a1 = _mm256_add_epi64(a1, _mm256_add_epi64(_mm256_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2)), m1));
+    }
+    _mm256_storeu_si256(p, a0);
+    _mm256_storeu_si256(p + 1, a1);
+
+    // leave the avx state
+    tb_avx_leave();
+}
+static __tb_target__("avx2") tb_void_t tb_xxh3_scramble_avx2(tb_uint64_t* acc, tb_byte_t const* secret)
+{
+    tb_size_t   i = 0;
+    __m256i*    p = (__m256i*)acc;
+    __m256i     prime = _mm256_set1_epi32((tb_int_t)TB_XXH3_PRIME32_1);
+    for (i = 0; i < 2; i++)
+    {
+        // acc = (acc ^ (acc >> 47) ^ k) * prime32
+        __m256i a = _mm256_loadu_si256(p + i);
+        a = _mm256_xor_si256(_mm256_xor_si256(a, _mm256_srli_epi64(a, 47)), _mm256_loadu_si256((__m256i const*)secret + i));
+        __m256i lo = _mm256_mul_epu32(a, prime);
+        __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+        _mm256_storeu_si256(p + i, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+    }
+
+    // leave the avx state
+    tb_avx_leave();
+}
+#endif
+static tb_uint64_t tb_xxh3_make_long(tb_byte_t const* data, tb_size_t size, tb_uint64_t seed)
+{
+    // init the secret, the seed is mixed into the whole secret
+    tb_byte_t           custom[TB_XXH3_SECRET_SIZE];
+    tb_byte_t const*    secret = g_xxh3_secret;
+    tb_size_t           i = 0;
+    if (seed)
+    {
+        for (i = 0; i < TB_XXH3_SECRET_SIZE; i += 16)
+        {
+            tb_bits_set_u64_le(custom + i, tb_xxh3_read64(secret + i) + seed);
+            tb_bits_set_u64_le(custom + i + 8, tb_xxh3_read64(secret + i + 8) - seed);
+        }
+        secret = custom;
+    }
+
+    // select the stripes implementation
+    tb_xxh3_accumulate_t    accumulate = tb_xxh3_accumulate;
+    tb_xxh3_scramble_t      scramble = tb_xxh3_scramble;
+#ifdef TB_XXH3_SIMD_ENABLE
+    if (tb_cpu_features() & TB_CPU_FEATURE_AVX2)
+    {
+        accumulate = tb_xxh3_accumulate_avx2;
+        scramble = tb_xxh3_scramble_avx2;
+    }
+    else
+    {
+        accumulate = tb_xxh3_accumulate_sse2;
+        scramble = tb_xxh3_scramble_sse2;
+    }
+#endif
+
+    // accumulate the full blocks
+    tb_uint64_t acc[8] =
+    {
+        TB_XXH3_PRIME32_3, TB_XXH3_PRIME64_1, TB_XXH3_PRIME64_2, TB_XXH3_PRIME64_3
+    ,   TB_XXH3_PRIME64_4, TB_XXH3_PRIME32_2, TB_XXH3_PRIME64_5, TB_XXH3_PRIME32_1
+    };
+    tb_size_t blocks = (size - 1) / TB_XXH3_BLOCK_SIZE;
+    for (i = 0; i < blocks; i++)
+    {
+        accumulate(acc, data + i * TB_XXH3_BLOCK_SIZE, secret, TB_XXH3_STRIPES);
+        scramble(acc, secret + TB_XXH3_SECRET_SIZE - TB_XXH3_STRIPE_SIZE);
+    }
+
+    // accumulate the last partial block and the last stripe
+    tb_size_t stripes = ((size - 1) - blocks * TB_XXH3_BLOCK_SIZE) / TB_XXH3_STRIPE_SIZE;
+    accumulate(acc, data + blocks * TB_XXH3_BLOCK_SIZE, secret, stripes);
+    accumulate(acc, data + size - TB_XXH3_STRIPE_SIZE, secret + TB_XXH3_SECRET_SIZE - TB_XXH3_STRIPE_SIZE - 7, 1);
+
+    // merge the accumulators
+    tb_uint64_t result = size * TB_XXH3_PRIME64_1;
+    for (i = 0; i < 4; i++)
+        result += tb_xxh3_mul128_fold64(acc[i << 1] ^ tb_xxh3_read64(secret + 11 + (i << 4)), acc[(i << 1) + 1] ^ tb_xxh3_read64(secret + 11 + (i << 4) + 8));
+    return tb_xxh3_avalanche(result);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_uint64_t tb_xxh3_make(tb_byte_t const* data, tb_size_t size, tb_uint64_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(data || !size, 0);
+
+    // make it
+    if (size <= 16) return tb_xxh3_make_0to16(data, size, g_xxh3_secret, seed);
+    else if (size <= 128) return tb_xxh3_make_17to128(data, size, g_xxh3_secret, seed);
+    else if (size <= TB_XXH3_MIDSIZE_MAX) return tb_xxh3_make_129to240(data, size, g_xxh3_secret, seed);
+    return tb_xxh3_make_long(data, size, seed);
+}
+tb_uint64_t tb_xxh3_make_from_cstr(tb_char_t const* cstr, tb_uint64_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(cstr, 0);
+
+    // make it
+    return tb_xxh3_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
+}
@@ -0,0 +1,68 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        xxh3.h
+ * @ingroup     hash
+ *
+ */
+#ifndef TB_HASH_XXH3_H
+#define TB_HASH_XXH3_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! make xxh3 hash (64-bits)
+ *
+ * the 64-bit xxh3 hash of xxhash, the result is the same as XXH3_64bits_withSeed().
+ *
+ * the input larger than 240 bytes is computed with 32-byte avx2 or 16-byte sse2 stripes if be supported,
+ * and the seed is mixed into the whole secret, so a random secret seed makes the hash flooding harder.
+ *
+ * @param data      the data
+ * @param size      the size
+ * @param seed      the seed, zero is the default hash
+ *
+ * @return          the hash value
+ */
+tb_uint64_t         tb_xxh3_make(tb_byte_t const* data, tb_size_t size, tb_uint64_t seed);
+
+/*! make xxh3 hash (64-bits) from c-string
+ *
+ * @param cstr      the c-string
+ * @param seed      the seed, zero is the default hash
+ *
+ * @return          the hash value
+ */
+tb_uint64_t         tb_xxh3_make_from_cstr(tb_char_t const* cstr, tb_uint64_t seed);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
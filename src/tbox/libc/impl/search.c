@@ -0,0 +1,780 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        search.c
+ * @ingroup     libc
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "search.h"
+#include "../string/string.h"
+#include "../../utils/bits.h"
+#include "../../platform/cpu.h"
+#if defined(TB_LIBC_SEARCH_SIMD_ENABLE) && defined(TB_ARCH_x64)
+#   include <immintrin.h>
+#   define TB_LIBC_SEARCH_x64
+#elif defined(TB_LIBC_SEARCH_SIMD_ENABLE) && defined(TB_ARCH_ARM64)
+#   include <arm_neon.h>
+#   define TB_LIBC_SEARCH_NEON
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the min page size
+#define TB_LIBC_SEARCH_PAGE                 (4096)
+
+// the min size to use avx2, the small data is faster with sse2
+#define TB_LIBC_SEARCH_AVX2_MINN            (128)
+
+/* the block [p, p + n) does not cross the page?
+ *
+ * we can read the whole block if it contains a valid byte, even if it exceeds the data.
+ * the vectorized functions which do this are not instrumented for the address sanitizer.
+ */
+#define tb_libc_search_page_safe(p, n)      ((((tb_size_t)(p)) & (TB_LIBC_SEARCH_PAGE - 1)) <= TB_LIBC_SEARCH_PAGE - (n))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_libc_search_equal(tb_byte_t const* p, tb_byte_t const* q, tb_size_t n, tb_bool_t icase)
+{
+    // case-sensitive? most candidates will be rejected by the first byte, so we check it before calling memcmp
+    if (!icase) return !n || (*p == *q && !tb_memcmp_(p, q, n));
+
+    // case-insensitive
+    for (; n; n--, p++, q++)
+    {
+        if (*p != *q && tb_tolower(*p) != tb_tolower(*q)) return tb_false;
+    }
+    return tb_true;
+}
+static tb_byte_t const* tb_libc_search_chr_generic(tb_byte_t const* s, tb_size_t n, tb_byte_t c1, tb_byte_t c2, tb_byte_t m)
+{
+    tb_byte_t const* e = s + n;
+    for (; s < e; s++)
+    {
+        if ((*s | m) == c1 || *s == c2) return s;
+    }
+    return tb_null;
+}
+#ifndef TB_LIBC_SEARCH_SIMD_ENABLE
+static tb_byte_t const* tb_libc_search_strchr_generic(tb_byte_t const* s, tb_byte_t c, tb_byte_t m)
+{
+    while (*s && (*s | m) != c) s++;
+    return s;
+}
+#endif
+static tb_byte_t const* tb_libc_search_rchr_generic(tb_byte_t const* s, tb_size_t n, tb_byte_t c, tb_byte_t m)
+{
+    while (n--)
+    {
+        if ((s[n] | m) == c) return s + n;
+    }
+    return tb_null;
+}
+static tb_byte_t const* tb_libc_search_str_generic(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // init the first and the last bytes, n2 >= 2 and n1 >= n2
+    tb_byte_t           mf = icase? tb_libc_search_cmask(s2[0]) : 0;
+    tb_byte_t           ml = icase? tb_libc_search_cmask(s2[n2 - 1]) : 0;
+    tb_byte_t           f = s2[0] | mf;
+    tb_byte_t           l = s2[n2 - 1] | ml;
+    tb_byte_t const*    p = s1;
+    tb_byte_t const*    e = s1 + n1 - n2;
+
+    // find it
+    for (; p <= e; p++)
+    {
+        if ((p[0] | mf) == f && (p[n2 - 1] | ml) == l && tb_libc_search_equal(p + 1, s2 + 1, n2 - 2, icase))
+            return p;
+    }
+    return tb_null;
+}
+#if defined(TB_LIBC_SEARCH_x64)
+static __tb_inline_force__ __m128i tb_libc_search_eq_sse2(__m128i x, __m128i c1, __m128i c2, __m128i m)
+{
+    return _mm_or_si128(_mm_cmpeq_epi8(_mm_or_si128(x, m), c1), _mm_cmpeq_epi8(x, c2));
+}
+static __tb_inline_force__ tb_uint32_t tb_libc_search_mask_sse2(__m128i x)
+{
+    return (tb_uint32_t)_mm_movemask_epi8(x);
+}
+static __tb_inline_force__ tb_uint64_t tb_libc_search_mask4_sse2(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+    return (tb_uint64_t)tb_libc_search_mask_sse2(a) | ((tb_uint64_t)tb_libc_search_mask_sse2(b) << 16)
+        | ((tb_uint64_t)tb_libc_search_mask_sse2(c) << 32) | ((tb_uint64_t)tb_libc_search_mask_sse2(d) << 48);
+}
+static __tb_no_sanitize_address__ tb_byte_t const* tb_libc_search_chr_sse2(tb_byte_t const* s, tb_size_t n, tb_byte_t c1, tb_byte_t c2, tb_byte_t m)
+{
+    // init
+    __m128i             v1 = _mm_set1_epi8((tb_char_t)c1);
+    __m128i             v2 = _mm_set1_epi8((tb_char_t)c2);
+    __m128i             vm = _mm_set1_epi8((tb_char_t)m);
+    tb_byte_t const*    e = s + n;
+    tb_uint32_t         mask;
+
+    // the small data? we read the whole block if it does not cross the page
+    if (n < 16)
+    {
+        if (!n || !tb_libc_search_page_safe(s, 16)) return tb_libc_search_chr_generic(s, n, c1, c2, m);
+        mask = tb_libc_search_mask_sse2(tb_libc_search_eq_sse2(_mm_loadu_si128((__m128i const*)s), v1, v2, vm)) & ((1 << n) - 1);
+        return mask? s + tb_bits_cl0_u32_le(mask) : tb_null;
+    }
+
+    // find it, 64 bytes per loop
+    while (e - s >= 64)
+    {
+        __m128i a = tb_libc_search_eq_sse2(_mm_loadu_si128((__m128i const*)s), v1, v2, vm);
+        __m128i b = tb_libc_search_eq_sse2(_mm_loadu_si128((__m128i const*)(s + 16)), v1, v2, vm);
+        __m128i c = tb_libc_search_eq_sse2(_mm_loadu_si128((__m128i const*)(s + 32)), v1, v2, vm);
+        __m128i d = tb_libc_search_eq_sse2(_mm_loadu_si128((__m128i const*)(s + 48)), v1, v2, vm);
+        if (tb_libc_search_mask_sse2(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))))
+            return s + tb_bits_cl0_u64_le(tb_libc_search_mask4_sse2(a, b, c, d));
+        s += 64;
+    }
+
+    // find it, 16 bytes per loop
+    while (e - s >= 16)
+    {
+        mask = tb_libc_search_mask_sse2(tb_libc_search_eq_sse2(_mm_loadu_si128((__m128i const*)s), v1, v2, vm));
+        if (mask) return s + tb_bits_cl0_u32_le(mask);
+        s += 16;
+    }
+
+    // find it in the last block, it overlaps with the checked bytes
+    if (s < e)
+    {
+        s = e - 16;
+        mask = tb_libc_search_mask_sse2(tb_libc_search_eq_sse2(_mm_loadu_si128((__m128i const*)s), v1, v2, vm));
+        if (mask) return s + tb_bits_cl0_u32_le(mask);
+    }
+    return tb_null;
+}
+static __tb_no_sanitize_address__ tb_byte_t const* tb_libc_search_strchr_sse2(tb_byte_t const* s, tb_byte_t c, tb_byte_t m)
+{
+    // init
+    __m128i             v1 = _mm_set1_epi8((tb_char_t)c);
+    __m128i             v0 = _mm_setzero_si128();
+    __m128i             vm = _mm_set1_epi8((tb_char_t)m);
+    tb_size_t           o = (tb_size_t)s & 15;
+    tb_byte_t const*    p = s - o;
+
+    // find it in the first aligned block and skip the leading bytes, the aligned block never crosses the page
+    tb_uint32_t mask = tb_libc_search_mask_sse2(tb_libc_search_eq_sse2(_mm_load_si128((__m128i const*)p), v1, v0, vm)) >> o;
+    if (mask) return s + tb_bits_cl0_u32_le(mask);
+    p += 16;
+
+    // find it until p is aligned by 64 bytes
+    while ((tb_size_t)p & 63)
+    {
+        mask = tb_libc_search_mask_sse2(tb_libc_search_eq_sse2(_mm_load_si128((__m128i const*)p), v1, v0, vm));
+        if (mask) return p + tb_bits_cl0_u32_le(mask);
+        p += 16;
+    }
+
+    // find it, 64 bytes per loop
+    while (1)
+    {
+        __m128i a = tb_libc_search_eq_sse2(_mm_load_si128((__m128i const*)p), v1, v0, vm);
+        __m128i b = tb_libc_search_eq_sse2(_mm_load_si128((__m128i const*)(p + 16)), v1, v0, vm);
+        __m128i c = tb_libc_search_eq_sse2(_mm_load_si128((__m128i const*)(p + 32)), v1, v0, vm);
+        __m128i d = tb_libc_search_eq_sse2(_mm_load_si128((__m128i const*)(p + 48)), v1, v0, vm);
+        if (tb_libc_search_mask_sse2(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))))
+            return p + tb_bits_cl0_u64_le(tb_libc_search_mask4_sse2(a, b, c, d));
+        p += 64;
+    }
+    return tb_null;
+}
+static __tb_no_sanitize_address__ tb_byte_t const* tb_libc_search_rchr_sse2(tb_byte_t const* s, tb_size_t n, tb_byte_t c, tb_byte_t m)
+{
+    // init
+    __m128i             v1 = _mm_set1_epi8((tb_char_t)c);
+    __m128i             vm = _mm_set1_epi8((tb_char_t)m);
+    tb_byte_t const*    e = s + n;
+    tb_uint32_t         mask;
+
+    // the small data? we read the whole block which ends at e if it does not cross the page
+    if (n < 16)
+    {
+        if (!n || !tb_libc_search_page_safe(e - 16, 16)) return tb_libc_search_rchr_generic(s, n, c, m);
+        mask = tb_libc_search_mask_sse2(_mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)(e - 16)), vm), v1)) >> (16 - n);
+        return mask? s + 31 - tb_bits_cl0_u32_be(mask) : tb_null;
+    }
+
+    // find it from the end, 64 bytes per loop
+    while (e - s >= 64)
+    {
+        e -= 64;
+        __m128i a = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)e), vm), v1);
+        __m128i b = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)(e + 16)), vm), v1);
+        __m128i c = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)(e + 32)), vm), v1);
+        __m128i d = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)(e + 48)), vm), v1);
+        if (tb_libc_search_mask_sse2(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))))
+            return e + 63 - tb_bits_cl0_u64_be(tb_libc_search_mask4_sse2(a, b, c, d));
+    }
+
+    // find it from the end, 16 bytes per loop
+    while (e - s >= 16)
+    {
+        e -= 16;
+        mask = tb_libc_search_mask_sse2(_mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)e), vm), v1));
+        if (mask) return e + 31 - tb_bits_cl0_u32_be(mask);
+    }
+
+    // find it in the first block, it overlaps with the checked bytes
+    if (e > s)
+    {
+        mask = tb_libc_search_mask_sse2(_mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)s), vm), v1)) & ((1 << (e - s)) - 1);
+        if (mask) return s + 31 - tb_bits_cl0_u32_be(mask);
+    }
+    return tb_null;
+}
+static tb_byte_t const* tb_libc_search_str_sse2(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // too few positions?
+    tb_size_t count = n1 - n2 + 1;
+    if (count < 16) return tb_libc_search_str_generic(s1, n1, s2, n2, icase);
+
+    // init the first and the last bytes, n2 >= 2
+    tb_byte_t   mf = icase? tb_libc_search_cmask(s2[0]) : 0;
+    tb_byte_t   ml = icase? tb_libc_search_cmask(s2[n2 - 1]) : 0;
+    __m128i     vf = _mm_set1_epi8((tb_char_t)(s2[0] | mf));
+    __m128i     vl = _mm_set1_epi8((tb_char_t)(s2[n2 - 1] | ml));
+    __m128i     vmf = _mm_set1_epi8((tb_char_t)mf);
+    __m128i     vml = _mm_set1_epi8((tb_char_t)ml);
+
+    // filter the positions by the first and the last bytes, 16 positions per loop
+    tb_size_t i = 0;
+    for (i = 0; i < count; i += 16)
+    {
+        // the last positions? it overlaps with the checked positions
+        tb_size_t skip = 0;
+        if (i + 16 > count)
+        {
+            skip = i + 16 - count;
+            i = count - 16;
+        }
+
+        // compare the first and the last bytes
+        tb_byte_t const*    p = s1 + i;
+        __m128i             f = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)p), vmf), vf);
+        __m128i             l = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((__m128i const*)(p + n2 - 1)), vml), vl);
+        tb_uint32_t         mask = (tb_libc_search_mask_sse2(_mm_and_si128(f, l)) >> skip) << skip;
+
+        // verify the candidates
+        while (mask)
+        {
+            tb_size_t j = tb_bits_cl0_u32_le(mask);
+            if (tb_libc_search_equal(p + j + 1, s2 + 1, n2 - 2, icase)) return p + j;
+            mask &= mask - 1;
+        }
+    }
+    return tb_null;
+}
+static __tb_inline_force__ __tb_target__("avx2") __m256i tb_libc_search_eq_avx2(__m256i x, __m256i c1, __m256i c2, __m256i m)
+{
+    return _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_or_si256(x, m), c1), _mm256_cmpeq_epi8(x, c2));
+}
+static __tb_inline_force__ __tb_target__("avx2") __m256i tb_libc_search_eqx_avx2(__m256i x, __m256i c1, __m256i c2, __m256i m, tb_bool_t single)
+{
+    return single? _mm256_cmpeq_epi8(x, c1) : tb_libc_search_eq_avx2(x, c1, c2, m);
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_uint32_t tb_libc_search_mask_avx2(__m256i x)
+{
+    return (tb_uint32_t)_mm256_movemask_epi8(x);
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_size_t tb_libc_search_first4_avx2(__m256i a, __m256i b, __m256i c, __m256i d)
+{
+    tb_uint64_t lo = (tb_uint64_t)tb_libc_search_mask_avx2(a) | ((tb_uint64_t)tb_libc_search_mask_avx2(b) << 32);
+    if (lo) return tb_bits_cl0_u64_le(lo);
+    tb_uint64_t hi = (tb_uint64_t)tb_libc_search_mask_avx2(c) | ((tb_uint64_t)tb_libc_search_mask_avx2(d) << 32);
+    return 64 + tb_bits_cl0_u64_le(hi);
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_size_t tb_libc_search_last4_avx2(__m256i a, __m256i b, __m256i c, __m256i d)
+{
+    tb_uint64_t hi = (tb_uint64_t)tb_libc_search_mask_avx2(c) | ((tb_uint64_t)tb_libc_search_mask_avx2(d) << 32);
+    if (hi) return 127 - tb_bits_cl0_u64_be(hi);
+    tb_uint64_t lo = (tb_uint64_t)tb_libc_search_mask_avx2(a) | ((tb_uint64_t)tb_libc_search_mask_avx2(b) << 32);
+    return 63 - tb_bits_cl0_u64_be(lo);
+}
+static __tb_inline_force__ __tb_no_sanitize_address__ __tb_target__("avx2") tb_byte_t const* tb_libc_search_chr_avx2_impl(tb_byte_t const* s, tb_size_t n, tb_byte_t c1, tb_byte_t c2, tb_byte_t m, tb_bool_t single)
+{
+    // init
+    __m256i             v1 = _mm256_set1_epi8((tb_char_t)c1);
+    __m256i             v2 = _mm256_set1_epi8((tb_char_t)c2);
+    __m256i             vm = _mm256_set1_epi8((tb_char_t)m);
+    tb_byte_t const*    e = s + n;
+    tb_byte_t const*    r = tb_null;
+
+    // find it in the first block and align the data by 32 bytes, n >= 128
+    tb_uint32_t mask = tb_libc_search_mask_avx2(tb_libc_search_eqx_avx2(_mm256_loadu_si256((__m256i const*)s), v1, v2, vm, single));
+    if (mask) r = s + tb_bits_cl0_u32_le(mask);
+    s = (tb_byte_t const*)(((tb_size_t)s + 32) & ~(tb_size_t)31);
+
+    // find it, 128 bytes per loop
+    while (!r && e - s >= 128)
+    {
+        __m256i a = tb_libc_search_eqx_avx2(_mm256_load_si256((__m256i const*)s), v1, v2, vm, single);
+        __m256i b = tb_libc_search_eqx_avx2(_mm256_load_si256((__m256i const*)(s + 32)), v1, v2, vm, single);
+        __m256i c = tb_libc_search_eqx_avx2(_mm256_load_si256((__m256i const*)(s + 64)), v1, v2, vm, single);
+        __m256i d = tb_libc_search_eqx_avx2(_mm256_load_si256((__m256i const*)(s + 96)), v1, v2, vm, single);
+        if (tb_libc_search_mask_avx2(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))))
+        {
+            r = s + tb_libc_search_first4_avx2(a, b, c, d);
+            break;
+        }
+        s += 128;
+    }
+
+    // find it in the left bytes, 32 bytes per loop
+    while (!r && e - s >= 32)
+    {
+        mask = tb_libc_search_mask_avx2(tb_libc_search_eqx_avx2(_mm256_load_si256((__m256i const*)s), v1, v2, vm, single));
+        if (mask) r = s + tb_bits_cl0_u32_le(mask);
+        s += 32;
+    }
+
+    // find it in the last block, it overlaps with the checked bytes
+    if (!r && s < e)
+    {
+        s = e - 32;
+        mask = tb_libc_search_mask_avx2(tb_libc_search_eqx_avx2(_mm256_loadu_si256((__m256i const*)s), v1, v2, vm, single));
+        if (mask) r = s + tb_bits_cl0_u32_le(mask);
+    }
+
+    // leave the avx state
+    tb_avx_leave();
+    return r;
+}
+static __tb_no_sanitize_address__ __tb_target__("avx2") tb_byte_t const* tb_libc_search_chr_avx2(tb_byte_t const* s, tb_size_t n, tb_byte_t c1, tb_byte_t c2, tb_byte_t m)
+{
+    // only one byte without the case mask? e.g. memchr, we need only one comparison per vector
+    return (c1 == c2 && !m)? tb_libc_search_chr_avx2_impl(s, n, c1, c2, m, tb_true) : tb_libc_search_chr_avx2_impl(s, n, c1, c2, m, tb_false);
+}
+static __tb_inline_force__ __tb_no_sanitize_address__ __tb_target__("avx2") tb_byte_t const* tb_libc_search_strchr_avx2_impl(tb_byte_t const* s, tb_byte_t c, tb_byte_t m)
+{
+    // init
+    __m256i             v1 = _mm256_set1_epi8((tb_char_t)c);
+    __m256i             v0 = _mm256_setzero_si256();
+    __m256i             vm = _mm256_set1_epi8((tb_char_t)m);
+    tb_size_t           o = (tb_size_t)s & 31;
+    tb_byte_t const*    p = s - o;
+
+    // find it in the first aligned block and skip the leading bytes, the aligned block never crosses the page
+    tb_uint32_t mask = tb_libc_search_mask_avx2(tb_libc_search_eq_avx2(_mm256_load_si256((__m256i const*)p), v1, v0, vm)) >> o;
+    if (mask) return s + tb_bits_cl0_u32_le(mask);
+    p += 32;
+
+    // find it until p is aligned by 128 bytes
+    while ((tb_size_t)p & 127)
+    {
+        mask = tb_libc_search_mask_avx2(tb_libc_search_eq_avx2(_mm256_load_si256((__m256i const*)p), v1, v0, vm));
+        if (mask) return p + tb_bits_cl0_u32_le(mask);
+        p += 32;
+    }
+
+    // find it, 128 bytes per loop
+    while (1)
+    {
+        __m256i a = tb_libc_search_eq_avx2(_mm256_load_si256((__m256i const*)p), v1, v0, vm);
+        __m256i b = tb_libc_search_eq_avx2(_mm256_load_si256((__m256i const*)(p + 32)), v1, v0, vm);
+        __m256i c = tb_libc_search_eq_avx2(_mm256_load_si256((__m256i const*)(p + 64)), v1, v0, vm);
+        __m256i d = tb_libc_search_eq_avx2(_mm256_load_si256((__m256i const*)(p + 96)), v1, v0, vm);
+        if (tb_libc_search_mask_avx2(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))))
+            return p + tb_libc_search_first4_avx2(a, b, c, d);
+        p += 128;
+    }
+    return tb_null;
+}
+static __tb_no_sanitize_address__ __tb_target__("avx2") tb_byte_t const* tb_libc_search_strchr_avx2(tb_byte_t const* s, tb_byte_t c, tb_byte_t m)
+{
+    // find it
+    tb_byte_t const* p = tb_libc_search_strchr_avx2_impl(s, c, m);
+
+    // leave the avx state
+    tb_avx_leave();
+    return p;
+}
+static __tb_no_sanitize_address__ __tb_target__("avx2") tb_byte_t const* tb_libc_search_rchr_avx2(tb_byte_t const* s, tb_size_t n, tb_byte_t c, tb_byte_t m)
+{
+    // init
+    __m256i             v1 = _mm256_set1_epi8((tb_char_t)c);
+    __m256i             vm = _mm256_set1_epi8((tb_char_t)m);
+    tb_byte_t const*    e = s + n;
+    tb_byte_t const*    r = tb_null;
+
+    // find it from the end, 128 bytes per loop
+    while (e - s >= 128)
+    {
+        e -= 128;
+        __m256i a = _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256((__m256i const*)e), vm), v1);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256((__m256i const*)(e + 32)), vm), v1);
+        __m256i c = _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256((__m256i const*)(e + 64)), vm), v1);
+        __m256i d = _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256((__m256i const*)(e + 96)), vm), v1);
+        if (tb_libc_search_mask_avx2(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))))
+        {
+            r = e + tb_libc_search_last4_avx2(a, b, c, d);
+            break;
+        }
+    }
+
+    // leave the avx state before running the sse2 code
+    tb_avx_leave();
+
+    // find it in the left bytes
+    return r? r : tb_libc_search_rchr_sse2(s, e - s, c, m);
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_uint32_t tb_libc_search_pair_avx2(tb_byte_t const* p, tb_size_t n2, __m256i vf, __m256i vl, __m256i vmf, __m256i vml, tb_bool_t icase)
+{
+    // compare the first and the last bytes of the 32 positions
+    __m256i f = _mm256_loadu_si256((__m256i const*)p);
+    __m256i l = _mm256_loadu_si256((__m256i const*)(p + n2 - 1));
+    if (icase)
+    {
+        f = _mm256_or_si256(f, vmf);
+        l = _mm256_or_si256(l, vml);
+    }
+    return tb_libc_search_mask_avx2(_mm256_and_si256(_mm256_cmpeq_epi8(f, vf), _mm256_cmpeq_epi8(l, vl)));
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_byte_t const* tb_libc_search_str_avx2_impl(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // init the first and the last bytes, n2 >= 2
+    tb_byte_t   mf = icase? tb_libc_search_cmask(s2[0]) : 0;
+    tb_byte_t   ml = icase? tb_libc_search_cmask(s2[n2 - 1]) : 0;
+    __m256i     vf = _mm256_set1_epi8((tb_char_t)(s2[0] | mf));
+    __m256i     vl = _mm256_set1_epi8((tb_char_t)(s2[n2 - 1] | ml));
+    __m256i     vmf = _mm256_set1_epi8((tb_char_t)mf);
+    __m256i     vml = _mm256_set1_epi8((tb_char_t)ml);
+
+    // filter the positions by the first and the last bytes, 64 positions per loop
+    tb_size_t           i = 0;
+    tb_size_t           count = n1 - n2 + 1;
+    tb_byte_t const*    r = tb_null;
+    for (i = 0; !r && i + 64 <= count; i += 64)
+    {
+        tb_byte_t const*    p = s1 + i;
+        tb_uint64_t         mask = (tb_uint64_t)tb_libc_search_pair_avx2(p, n2, vf, vl, vmf, vml, icase)
+                                | ((tb_uint64_t)tb_libc_search_pair_avx2(p + 32, n2, vf, vl, vmf, vml, icase) << 32);
+
+        // verify the candidates
+        while (mask)
+        {
+            tb_size_t j = tb_bits_cl0_u64_le(mask);
+            if (tb_libc_search_equal(p + j + 1, s2 + 1, n2 - 2, icase))
+            {
+                r = p + j;
+                break;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    // leave the avx state before running the sse2 code
+    tb_avx_leave();
+
+    // find it in the left positions
+    if (r) return r;
+    return i < count? tb_libc_search_str_sse2(s1 + i, n1 - i, s2, n2, icase) : tb_null;
+}
+static __tb_target__("avx2") tb_byte_t const* tb_libc_search_str_avx2(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // we need not the case masks if the case is sensitive
+    return icase? tb_libc_search_str_avx2_impl(s1, n1, s2, n2, tb_true) : tb_libc_search_str_avx2_impl(s1, n1, s2, n2, tb_false);
+}
+static __tb_inline__ tb_bool_t tb_libc_search_avx2()
+{
+    // the cpu features have been detected in tb_init()
+    static tb_long_t s_avx2 = -1;
+    if (s_avx2 < 0) s_avx2 = (tb_cpu_features() & TB_CPU_FEATURE_AVX2)? 1 : 0;
+    return (tb_bool_t)s_avx2;
+}
+#elif defined(TB_LIBC_SEARCH_NEON)
+static __tb_inline_force__ uint8x16_t tb_libc_search_eq_neon(uint8x16_t x, uint8x16_t c1, uint8x16_t c2, uint8x16_t m)
+{
+    return vorrq_u8(vceqq_u8(vorrq_u8(x, m), c1), vceqq_u8(x, c2));
+}
+static __tb_inline_force__ tb_uint64_t tb_libc_search_mask_neon(uint8x16_t x)
+{
+    // narrow the 0xff/0x00 bytes to 4 bits per byte, there is no movemask on neon
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(x), 4)), 0);
+}
+static __tb_inline_force__ tb_bool_t tb_libc_search_any4_neon(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d)
+{
+    return vmaxvq_u8(vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d))) != 0;
+}
+static __tb_inline_force__ tb_size_t tb_libc_search_first4_neon(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d)
+{
+    tb_uint64_t mask;
+    if ((mask = tb_libc_search_mask_neon(a))) return tb_bits_cl0_u64_le(mask) >> 2;
+    if ((mask = tb_libc_search_mask_neon(b))) return 16 + (tb_bits_cl0_u64_le(mask) >> 2);
+    if ((mask = tb_libc_search_mask_neon(c))) return 32 + (tb_bits_cl0_u64_le(mask) >> 2);
+    return 48 + (tb_bits_cl0_u64_le(tb_libc_search_mask_neon(d)) >> 2);
+}
+static __tb_inline_force__ tb_size_t tb_libc_search_last4_neon(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d)
+{
+    tb_uint64_t mask;
+    if ((mask = tb_libc_search_mask_neon(d))) return 63 - (tb_bits_cl0_u64_be(mask) >> 2);
+    if ((mask = tb_libc_search_mask_neon(c))) return 47 - (tb_bits_cl0_u64_be(mask) >> 2);
+    if ((mask = tb_libc_search_mask_neon(b))) return 31 - (tb_bits_cl0_u64_be(mask) >> 2);
+    return 15 - (tb_bits_cl0_u64_be(tb_libc_search_mask_neon(a)) >> 2);
+}
+static __tb_no_sanitize_address__ tb_byte_t const* tb_libc_search_chr_neon(tb_byte_t const* s, tb_size_t n, tb_byte_t c1, tb_byte_t c2, tb_byte_t m)
+{
+    // init
+    uint8x16_t          v1 = vdupq_n_u8(c1);
+    uint8x16_t          v2 = vdupq_n_u8(c2);
+    uint8x16_t          vm = vdupq_n_u8(m);
+    tb_byte_t const*    e = s + n;
+    tb_uint64_t         mask;
+
+    // the small data? we read the whole block if it does not cross the page
+    if (n < 16)
+    {
+        if (!n || !tb_libc_search_page_safe(s, 16)) return tb_libc_search_chr_generic(s, n, c1, c2, m);
+        mask = tb_libc_search_mask_neon(tb_libc_search_eq_neon(vld1q_u8(s), v1, v2, vm)) & ((1ULL << (n << 2)) - 1);
+        return mask? s + (tb_bits_cl0_u64_le(mask) >> 2) : tb_null;
+    }
+
+    // find it, 64 bytes per loop
+    while (e - s >= 64)
+    {
+        uint8x16_t a = tb_libc_search_eq_neon(vld1q_u8(s), v1, v2, vm);
+        uint8x16_t b = tb_libc_search_eq_neon(vld1q_u8(s + 16), v1, v2, vm);
+        uint8x16_t c = tb_libc_search_eq_neon(vld1q_u8(s + 32), v1, v2, vm);
+        uint8x16_t d = tb_libc_search_eq_neon(vld1q_u8(s + 48), v1, v2, vm);
+        if (tb_libc_search_any4_neon(a, b, c, d)) return s + tb_libc_search_first4_neon(a, b, c, d);
+        s += 64;
+    }
+
+    // find it, 16 bytes per loop
+    while (e - s >= 16)
+    {
+        mask = tb_libc_search_mask_neon(tb_libc_search_eq_neon(vld1q_u8(s), v1, v2, vm));
+        if (mask) return s + (tb_bits_cl0_u64_le(mask) >> 2);
+        s += 16;
+    }
+
+    // find it in the last block, it overlaps with the checked bytes
+    if (s < e)
+    {
+        s = e - 16;
+        mask = tb_libc_search_mask_neon(tb_libc_search_eq_neon(vld1q_u8(s), v1, v2, vm));
+        if (mask) return s + (tb_bits_cl0_u64_le(mask) >> 2);
+    }
+    return tb_null;
+}
+static __tb_no_sanitize_address__ tb_byte_t const* tb_libc_search_strchr_neon(tb_byte_t const* s, tb_byte_t c, tb_byte_t m)
+{
+    // init
+    uint8x16_t          v1 = vdupq_n_u8(c);
+    uint8x16_t          v0 = vdupq_n_u8(0);
+    uint8x16_t          vm = vdupq_n_u8(m);
+    tb_size_t           o = (tb_size_t)s & 15;
+    tb_byte_t const*    p = s - o;
+
+    // find it in the first aligned block and skip the leading bytes, the aligned block never crosses the page
+    tb_uint64_t mask = tb_libc_search_mask_neon(tb_libc_search_eq_neon(vld1q_u8(p), v1, v0, vm)) >> (o << 2);
+    if (mask) return s + (tb_bits_cl0_u64_le(mask) >> 2);
+    p += 16;
+
+    // find it until p is aligned by 64 bytes
+    while ((tb_size_t)p & 63)
+    {
+        mask = tb_libc_search_mask_neon(tb_libc_search_eq_neon(vld1q_u8(p), v1, v0, vm));
+        if (mask) return p + (tb_bits_cl0_u64_le(mask) >> 2);
+        p += 16;
+    }
+
+    // find it, 64 bytes per loop
+    while (1)
+    {
+        uint8x16_t a = tb_libc_search_eq_neon(vld1q_u8(p), v1, v0, vm);
+        uint8x16_t b = tb_libc_search_eq_neon(vld1q_u8(p + 16), v1, v0, vm);
+        uint8x16_t c = tb_libc_search_eq_neon(vld1q_u8(p + 32), v1, v0, vm);
+        uint8x16_t d = tb_libc_search_eq_neon(vld1q_u8(p + 48), v1, v0, vm);
+        if (tb_libc_search_any4_neon(a, b, c, d)) return p + tb_libc_search_first4_neon(a, b, c, d);
+        p += 64;
+    }
+    return tb_null;
+}
+static __tb_no_sanitize_address__ tb_byte_t const* tb_libc_search_rchr_neon(tb_byte_t const* s, tb_size_t n, tb_byte_t c, tb_byte_t m)
+{
+    // init
+    uint8x16_t          v1 = vdupq_n_u8(c);
+    uint8x16_t          vm = vdupq_n_u8(m);
+    tb_byte_t const*    e = s + n;
+    tb_uint64_t         mask;
+
+    // the small data? we read the whole block which ends at e if it does not cross the page
+    if (n < 16)
+    {
+        if (!n || !tb_libc_search_page_safe(e - 16, 16)) return tb_libc_search_rchr_generic(s, n, c, m);
+        mask = tb_libc_search_mask_neon(vceqq_u8(vorrq_u8(vld1q_u8(e - 16), vm), v1)) >> ((16 - n) << 2);
+        return mask? s + 15 - (tb_bits_cl0_u64_be(mask) >> 2) : tb_null;
+    }
+
+    // find it from the end, 64 bytes per loop
+    while (e - s >= 64)
+    {
+        e -= 64;
+        uint8x16_t a = vceqq_u8(vorrq_u8(vld1q_u8(e), vm), v1);
+        uint8x16_t b = vceqq_u8(vorrq_u8(vld1q_u8(e + 16), vm), v1);
+        uint8x16_t c = vceqq_u8(vorrq_u8(vld1q_u8(e + 32), vm), v1);
+        uint8x16_t d = vceqq_u8(vorrq_u8(vld1q_u8(e + 48), vm), v1);
+        if (tb_libc_search_any4_neon(a, b, c, d)) return e + tb_libc_search_last4_neon(a, b, c, d);
+    }
+
+    // find it from the end, 16 bytes per loop
+    while (e - s >= 16)
+    {
+        e -= 16;
+        mask = tb_libc_search_mask_neon(vceqq_u8(vorrq_u8(vld1q_u8(e), vm), v1));
+        if (mask) return e + 15 - (tb_bits_cl0_u64_be(mask) >> 2);
+    }
+
+    // find it in the first block, it overlaps with the checked bytes
+    if (e > s)
+    {
+        mask = tb_libc_search_mask_neon(vceqq_u8(vorrq_u8(vld1q_u8(s), vm), v1)) & ((1ULL << ((e - s) << 2)) - 1);
+        if (mask) return s + 15 - (tb_bits_cl0_u64_be(mask) >> 2);
+    }
+    return tb_null;
+}
+static tb_byte_t const* tb_libc_search_str_neon(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // too few positions?
+    tb_size_t count = n1 - n2 + 1;
+    if (count < 16) return tb_libc_search_str_generic(s1, n1, s2, n2, icase);
+
+    // init the first and the last bytes, n2 >= 2
+    tb_byte_t   mf = icase? tb_libc_search_cmask(s2[0]) : 0;
+    tb_byte_t   ml = icase? tb_libc_search_cmask(s2[n2 - 1]) : 0;
+    uint8x16_t  vf = vdupq_n_u8(s2[0] | mf);
+    uint8x16_t  vl = vdupq_n_u8(s2[n2 - 1] | ml);
+    uint8x16_t  vmf = vdupq_n_u8(mf);
+    uint8x16_t  vml = vdupq_n_u8(ml);
+
+    // filter the positions by the first and the last bytes, 16 positions per loop
+    tb_size_t i = 0;
+    for (i = 0; i < count; i += 16)
+    {
+        // the last positions? it overlaps with the checked positions
+        tb_size_t skip = 0;
+        if (i + 16 > count)
+        {
+            skip = i + 16 - count;
+            i = count - 16;
+        }
+
+        // compare the first and the last bytes
+        tb_byte_t const*    p = s1 + i;
+        uint8x16_t          f = vceqq_u8(vorrq_u8(vld1q_u8(p), vmf), vf);
+        uint8x16_t          l = vceqq_u8(vorrq_u8(vld1q_u8(p + n2 - 1), vml), vl);
+        tb_uint64_t         mask = (tb_libc_search_mask_neon(vandq_u8(f, l)) >> (skip << 2)) << (skip << 2);
+
+        // verify the candidates
+        while (mask)
+        {
+            tb_size_t j = tb_bits_cl0_u64_le(mask) >> 2;
+            if (tb_libc_search_equal(p + j + 1, s2 + 1, n2 - 2, icase)) return p + j;
+            mask &= ~((tb_uint64_t)0xf << (j << 2));
+        }
+    }
+    return tb_null;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_byte_t const* tb_libc_search_chr(tb_byte_t const* s, tb_size_t n, tb_byte_t c1, tb_byte_t c2, tb_byte_t m)
+{
+#if defined(TB_LIBC_SEARCH_x64)
+    if (n >= TB_LIBC_SEARCH_AVX2_MINN && tb_libc_search_avx2()) return tb_libc_search_chr_avx2(s, n, c1, c2, m);
+    return tb_libc_search_chr_sse2(s, n, c1, c2, m);
+#elif defined(TB_LIBC_SEARCH_NEON)
+    return tb_libc_search_chr_neon(s, n, c1, c2, m);
+#else
+    return tb_libc_search_chr_generic(s, n, c1, c2, m);
+#endif
+}
+tb_byte_t const* tb_libc_search_strchr(tb_byte_t const* s, tb_byte_t c, tb_byte_t m)
+{
+#if defined(TB_LIBC_SEARCH_x64)
+    return tb_libc_search_avx2()? tb_libc_search_strchr_avx2(s, c, m) : tb_libc_search_strchr_sse2(s, c, m);
+#elif defined(TB_LIBC_SEARCH_NEON)
+    return tb_libc_search_strchr_neon(s, c, m);
+#else
+    return tb_libc_search_strchr_generic(s, c, m);
+#endif
+}
+tb_byte_t const* tb_libc_search_rchr(tb_byte_t const* s, tb_size_t n, tb_byte_t c, tb_byte_t m)
+{
+#if defined(TB_LIBC_SEARCH_x64)
+    if (n >= TB_LIBC_SEARCH_AVX2_MINN && tb_libc_search_avx2()) return tb_libc_search_rchr_avx2(s, n, c, m);
+    return tb_libc_search_rchr_sse2(s, n, c, m);
+#elif defined(TB_LIBC_SEARCH_NEON)
+    return tb_libc_search_rchr_neon(s, n, c, m);
+#else
+    return tb_libc_search_rchr_generic(s, n, c, m);
+#endif
+}
+tb_byte_t const* tb_libc_search_str(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // empty pattern? too long pattern?
+    tb_check_return_val(n2, s1);
+    tb_check_return_val(n1 >= n2, tb_null);
+
+    // only one byte? find it directly
+    if (n2 == 1)
+    {
+        tb_byte_t m = icase? tb_libc_search_cmask(s2[0]) : 0;
+        return tb_libc_search_chr(s1, n1, s2[0] | m, s2[0] | m, m);
+    }
+
+    // find it
+#if defined(TB_LIBC_SEARCH_x64)
+    if (n1 - n2 >= TB_LIBC_SEARCH_AVX2_MINN && tb_libc_search_avx2()) return tb_libc_search_str_avx2(s1, n1, s2, n2, icase);
+    return tb_libc_search_str_sse2(s1, n1, s2, n2, icase);
+#elif defined(TB_LIBC_SEARCH_NEON)
+    return tb_libc_search_str_neon(s1, n1, s2, n2, icase);
+#else
+    return tb_libc_search_str_generic(s1, n1, s2, n2, icase);
+#endif
+}
+tb_byte_t const* tb_libc_search_rstr(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // empty pattern? too long pattern?
+    tb_check_return_val(n2, s1 + n1);
+    tb_check_return_val(n1 >= n2, tb_null);
+
+    // find the first byte from the end and verify the left bytes
+    tb_byte_t           m = icase? tb_libc_search_cmask(s2[0]) : 0;
+    tb_byte_t const*    p = s1;
+    tb_size_t           n = n1 - n2 + 1;
+    while (n && (p = tb_libc_search_rchr(s1, n, s2[0] | m, m)))
+    {
+        if (tb_libc_search_equal(p + 1, s2 + 1, n2 - 1, icase)) return p;
+        n = p - s1;
+    }
+    return tb_null;
+}
@@ -0,0 +1,120 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        search.h
+ * @ingroup     libc
+ *
+ */
+#ifndef TB_LIBC_IMPL_SEARCH_H
+#define TB_LIBC_IMPL_SEARCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the vectorized search is enabled? sse2/avx2 on x64 and neon on arm64
+#if defined(TB_ARCH_x64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(TB_COMPILER_IS_MSVC) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   define TB_LIBC_SEARCH_SIMD_ENABLE
+#elif defined(TB_ARCH_ARM64) && !defined(TB_WORDS_BIGENDIAN)
+#   define TB_LIBC_SEARCH_SIMD_ENABLE
+#endif
+
+/*! the case mask of the byte
+ *
+ * (b | 0x20) is the lower case of the ascii letter b, so we can find the letter
+ * case-insensitively with m = tb_libc_search_cmask(c) and c = c | m
+ */
+#define tb_libc_search_cmask(c)         (tb_isalpha((tb_byte_t)(c))? 0x20 : 0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* find the first byte b in [s, s + n) where (b | m) == c1 or b == c2
+ *
+ * @param s         the data
+ * @param n         the data size
+ * @param c1        the first byte, it has been or-ed with m
+ * @param c2        the second byte
+ * @param m         the case mask
+ *
+ * @return          the found position or tb_null
+ */
+tb_byte_t const*    tb_libc_search_chr(tb_byte_t const* s, tb_size_t n, tb_byte_t c1, tb_byte_t c2, tb_byte_t m);
+
+/* find the first byte b in the c-string s where (b | m) == c or b == '\0'
+ *
+ * @param s         the c-string
+ * @param c         the byte, it has been or-ed with m
+ * @param m         the case mask
+ *
+ * @return          the found position, it points to '\0' if c is not found
+ */
+tb_byte_t const*    tb_libc_search_strchr(tb_byte_t const* s, tb_byte_t c, tb_byte_t m);
+
+/* find the last byte b in [s, s + n) where (b | m) == c
+ *
+ * @param s         the data
+ * @param n         the data size
+ * @param c         the byte, it has been or-ed with m
+ * @param m         the case mask
+ *
+ * @return          the found position or tb_null
+ */
+tb_byte_t const*    tb_libc_search_rchr(tb_byte_t const* s, tb_size_t n, tb_byte_t c, tb_byte_t m);
+
+/* find the first s2 in [s1, s1 + n1)
+ *
+ * @param s1        the data
+ * @param n1        the data size
+ * @param s2        the pattern
+ * @param n2        the pattern size
+ * @param icase     ignore the case of the ascii letters?
+ *
+ * @return          the found position or tb_null, returns s1 if n2 == 0
+ */
+tb_byte_t const*    tb_libc_search_str(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase);
+
+/* find the last s2 in [s1, s1 + n1)
+ *
+ * @param s1        the data
+ * @param n1        the data size
+ * @param s2        the pattern
+ * @param n2        the pattern size
+ * @param icase     ignore the case of the ascii letters?
+ *
+ * @return          the found position or tb_null, returns s1 + n1 if n2 == 0
+ */
+tb_byte_t const*    tb_libc_search_rstr(tb_byte_t const* s1, tb_size_t n1, tb_byte_t const* s2, tb_size_t n2, tb_bool_t icase);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
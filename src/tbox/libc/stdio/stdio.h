@@ -167,14 +167,18 @@ tb_long_t           tb_wputs(tb_wchar_t const* string);
  *              This type differs slightly from fixed-point notation in
  *              that insignificant zeroes to the right of the decimal point are not included.
  *              Also, the decimal point is not included on whole numbers.
+ *              The precision is the count of significant digits, it is 6 if the precision is not given, e.g. tb_printf("%lg", 0.1) => 0.1.
+ *              The '#' flag keeps the trailing zeroes and the decimal point, e.g. tb_printf("%#lg", 1.0) => 1.00000.
+ *              Please use tb_dtoa() to get the shortest digits which can be converted back to the same value.
  *   - c:       print a char (character).
  *   - s:       print a character string
  *   - p:       print a void * (pointer to void) in an implementation-defined format.
  *   - n:       print nothing, but write number of characters successfully written so far into an integer pointer parameter.
  *   - %:       %
  *
- * @note support        d, i, u, o, u, x/X, b/B, f/F, c, s
- * @note not support    e/E, g/G, p, n
+ * @note support        d, i, u, o, u, x/X, b/B, f/F, e/E, g/G, c, s
+ * @note not support    p, n
+ * @note the float number is printed by %f, %e, %g, and the double number need the 'l' qualifier, e.g. %lf, %le, %lg
  *
  * @code
  * tb_printf("|hello world|\n");
@@ -191,6 +195,8 @@ tb_long_t           tb_wputs(tb_wchar_t const* string);
  * tb_printf("|%016.9f|\n", 3.14159);
  * tb_printf("|%lf|\n", 1.0 / 6.0);
  * tb_printf("|%lf|\n", 0.0003141596);
+ * tb_printf("|%le|%.3le|\n", 0.0003141596, 1e100);
+ * tb_printf("|%lg|%lg|%.3lg|\n", 0.1, 1e21, 3.1415926);
  * tb_printf("|%F|\n", tb_float_to_fixed(3.1415));
  * tb_printf("|%{object_name}|\n", object);
  * @endcode
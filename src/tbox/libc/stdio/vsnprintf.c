@@ -29,6 +29,7 @@
 #include "../../libm/libm.h"
 #include "../../utils/utils.h"
 #include "../string/string.h"
+#include "../stdlib/stdlib.h"
 #include "printf_object.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -60,6 +61,7 @@ typedef enum __tb_printf_extra_t
 ,   TB_PRINTF_EXTRA_UPPER           = 2     // upper case for %X %B
 ,   TB_PRINTF_EXTRA_PERCENT         = 4     // percent char: %
 ,   TB_PRINTF_EXTRA_EXP             = 8     // exponent form: [-]d.ddd e[+/-]ddd
+,   TB_PRINTF_EXTRA_GENERAL         = 16    // general form: %g, the fixed or exponent form
 
 }tb_printf_extra_t;
 
@@ -483,264 +485,333 @@ static tb_char_t* tb_printf_int32(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_
     return pb;
 }
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-static tb_char_t* tb_printf_float(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_float_t num)
+static tb_char_t* tb_printf_fpad(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_char_t sign, tb_char_t const* text, tb_size_t size, tb_bool_t zero)
 {
-    // digits
-    tb_char_t   ints[32] = {0};
-    tb_char_t   decs[32] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
+    // the padding width
+    tb_int_t pads = e.width - (tb_int_t)size - (sign? 1 : 0);
+    zero = (zero && (e.flags & TB_PRINTF_FLAG_ZERO))? tb_true : tb_false;
 
-    // for inf nan
-    if (tb_isinff(num))
-    {
-        if (pb < pe && num < 0) *pb++ = '-';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'I' : 'i';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'F' : 'f';
-        return pb;
-    }
-    else if (tb_isnanf(num))
+    // fill spaces at left side, e.g. "   3.14"
+    if (!(e.flags & TB_PRINTF_FLAG_LEFT) && !zero)
     {
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'A' : 'a';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        return pb;
+        while (pads-- > 0)
+            if (pb < pe) *pb++ = ' ';
     }
 
-    // sign: + -
-    tb_char_t sign = 0;
-    if (e.extra & TB_PRINTF_EXTRA_SIGNED)
+    // append sign: + / -
+    if (sign && (pb < pe)) *pb++ = sign;
+
+    // fill 0, e.g. "-0003.14"
+    if (!(e.flags & TB_PRINTF_FLAG_LEFT) && zero)
     {
-        if (num < 0)
-        {
-            sign = '-';
-            --e.width;
-        }
-        else if (e.flags & TB_PRINTF_FLAG_PLUS)
-        {
-            sign = '+';
-            --e.width;
-        }
+        while (pads-- > 0)
+            if (pb < pe) *pb++ = '0';
     }
 
-    // adjust sign
-    if (num < 0) num = -num;
+    // append text
+    while (size-- && pb < pe) *pb++ = *text++;
 
-    // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint32_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint32_t)(num * p * 10) % 10) > 4)
-        num += 1.0f / (tb_float_t)p;
+    // trailing space padding for left-justified flags, e.g. "3.14   "
+    while (pads-- > 0)
+        if (pb < pe) *pb++ = ' ';
 
-    // get integer & decimal
-    tb_int32_t integer = (tb_int32_t)num;
-    tb_float_t decimal = num - integer;
+    return pb;
+}
+static tb_void_t tb_printf_fround(tb_char_t* digits, tb_size_t* pn, tb_long_t* ppos, tb_long_t keep)
+{
+    // need not round it?
+    tb_long_t n = (tb_long_t)*pn;
+    tb_check_return(keep < n);
 
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = '0';
-    else
+    // round it to even if it is the halfway, e.g. 0.125 => 0.12, 0.375 => 0.38
+    tb_bool_t up = tb_false;
+    if (keep >= 0)
     {
-        if (integer < 0) integer = -integer;
-        do
-        {
-            ints[ints_i++] = (integer % 10) + '0';
-            integer /= 10;
-        }
-        while (integer);
+        tb_char_t d = digits[keep];
+        if (d > '5' || (d == '5' && (keep + 1 < n || (keep > 0 && ((digits[keep - 1] - '0') & 1))))) up = tb_true;
     }
 
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = '0';
-    else
+    // round up, e.g. 0.0996 => 0.1
+    if (up)
     {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do
+        tb_long_t i = keep - 1;
+        while (i >= 0 && digits[i] == '9') i--;
+        if (i >= 0)
+        {
+            digits[i]++;
+            *pn = (tb_size_t)(i + 1);
+        }
+        else
         {
-            decs[decs_i++] = (tb_char_t)(d + (tb_long_t)'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
+            digits[0] = '1';
+            *pn = 1;
+            (*ppos)++;
         }
-        while (decs_i < e.precision);
     }
-
-    // adjust precision
-    if (decs_i > e.precision)
-        decs_i = e.precision;
-
-    // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= (tb_int_t)(ints_i + 1 + e.precision);
-    if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
+    // round down
+    else if (keep > 0)
     {
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = ' ';
+        while (keep > 1 && digits[keep - 1] == '0') keep--;
+        *pn = (tb_size_t)keep;
     }
-
-    // append sign: + / -
-    if (sign && (pb < pe)) *pb++ = sign;
-
-    // fill 0 or spaces, e.g. "00003.1415926"
-    if (!(e.flags & TB_PRINTF_FLAG_LEFT))
+    // zero
+    else
     {
-        tb_char_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? '0' : ' ';
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = c;
+        digits[0] = '0';
+        *pn = 1;
+        *ppos = 1;
     }
-
-    // append integer
-    while (--ints_i >= 0)
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = '.';
-
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0)
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
-
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision)
-        if (pb < pe) *pb++ = '0';
-
-    // trailing space padding for left-justified flags, e.g. "0.31415926   "
-    while (--e.width >= 0)
-        if (pb < pe) *pb++ = ' ';
-
-    return pb;
 }
-static tb_char_t* tb_printf_double(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_double_t num)
+static tb_size_t tb_printf_fdigits_large(tb_uint64_t m, tb_long_t e, tb_char_t* digits)
 {
-    // digits
-    tb_char_t   ints[64] = {0};
-    tb_char_t   decs[64] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
+    // the limbs with base 1e9, value = m * 2^e < 2^1024 needs 35 limbs at most
+    tb_uint32_t limbs[40];
+    tb_size_t   count = 0;
+    for (; m; m /= 1000000000) limbs[count++] = (tb_uint32_t)(m % 1000000000);
 
-    // for inf nan
-    if (tb_isinf(num))
+    // multiply it by 2^28 every time, limb * 2^28 + carry always fits in 64-bits
+    while (e > 0)
     {
-        if (pb < pe && num < 0) *pb++ = '-';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'I' : 'i';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'F' : 'f';
-        return pb;
+        tb_size_t   i = 0;
+        tb_size_t   shift = (tb_size_t)tb_min(e, 28);
+        tb_uint64_t carry = 0;
+        for (i = 0; i < count; i++)
+        {
+            tb_uint64_t t = ((tb_uint64_t)limbs[i] << shift) + carry;
+            limbs[i] = (tb_uint32_t)(t % 1000000000);
+            carry = t / 1000000000;
+        }
+        for (; carry; carry /= 1000000000) limbs[count++] = (tb_uint32_t)(carry % 1000000000);
+        e -= (tb_long_t)shift;
     }
-    else if (tb_isnan(num))
+
+    // make digits, the highest limb has no leading zeros
+    tb_size_t   n = 0;
+    tb_size_t   i = 0;
+    tb_char_t   temp[10];
+    tb_uint32_t v = limbs[count - 1];
+    for (; v; v /= 10) temp[i++] = (tb_char_t)('0' + v % 10);
+    while (i) digits[n++] = temp[--i];
+    while (--count)
     {
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'A' : 'a';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'N' : 'n';
-        return pb;
+        v = limbs[count - 1];
+        for (i = 9; i; v /= 10) digits[n + --i] = (tb_char_t)('0' + v % 10);
+        n += 9;
     }
+    return n;
+}
+/* get the fixed-point digits for %f, value = 0.digits * 10^pos
+ *
+ * value = m * 2^e, we make the integer digits by 64-bits or the 1e9-based limbs for the large value,
+ * and make the fraction digits by multiplying the binary fraction by 10 (or by 5 and decreasing the binary point),
+ * so all these digits are exact and we need not the big decimal in tb_dtoa_exact_digits().
+ *
+ * we only make the fraction digits to the precision + 1 and append a non-zero sticky digit if the rest is not zero,
+ * so tb_printf_fround() can still round them correctly. it returns 0 for the subnormal value with a large precision.
+ */
+static tb_size_t tb_printf_fdigits(tb_double_t num, tb_long_t precision, tb_char_t* digits, tb_size_t maxn, tb_long_t* ppos)
+{
+    // check
+    tb_assert_and_check_return_val(precision >= 0 && maxn > (tb_size_t)precision + 340, 0);
 
-
-    // sign: + -
-    tb_char_t sign = 0;
-    if (e.extra & TB_PRINTF_EXTRA_SIGNED)
+    // the tiny value will be rounded to zero, value < 0.25 * 10^-precision, 10^precision is exact if precision <= 22
+    tb_long_t k = 0;
+    if (precision <= 22)
     {
-        if (num < 0)
+        tb_double_t scale = 1;
+        for (k = 0; k < precision; k++) scale *= 10;
+        if (tb_fabs(num) * scale < 0.25)
         {
-            sign = '-';
-            --e.width;
-        }
-        else if (e.flags & TB_PRINTF_FLAG_PLUS)
-        {
-            sign = '+';
-            --e.width;
+            digits[0] = '0';
+            *ppos = 1;
+            return 1;
         }
     }
 
-    // adjust sign
-    if (num < 0) num = -num;
-
-    // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint64_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint64_t)(num * p * 10) % 10) > 4)
-        num += 1. / (tb_double_t)p;
-
-    // get integer & decimal
-    tb_int64_t integer = (tb_int64_t)num;
-    tb_double_t decimal = num - integer;
+    // get the significand and exponent of the normal value
+    tb_ieee_double_t    ieee; ieee.d = num;
+    tb_uint64_t         bits = ((tb_uint64_t)ieee.i.h << 32) | ieee.i.l;
+    tb_long_t           e = (tb_long_t)((bits >> 52) & 0x7ff);
+    tb_check_return_val(e, 0);
+    tb_uint64_t         m = (bits & ((1ULL << 52) - 1)) | (1ULL << 52);
+    e -= 1075;
+
+    // the large value? it has no fraction part
+    tb_size_t n = 0;
+    if (e > 11)
+    {
+        n = tb_printf_fdigits_large(m, e, digits);
+        *ppos = (tb_long_t)n;
+        while (n > 1 && digits[n - 1] == '0') n--;
+        return n;
+    }
 
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = '0';
-    else
+    // make the integer digits
+    tb_size_t   point = e < 0? (tb_size_t)-e : 0;
+    tb_uint64_t ip = e < 0? (point < 64? (m >> point) : 0) : (m << e);
+    tb_size_t   i = 0;
+    tb_char_t   temp[24];
+    for (; ip; ip /= 10) temp[i++] = (tb_char_t)('0' + ip % 10);
+    while (i) digits[n++] = temp[--i];
+
+    // make the fraction digits, we skip the leading zeros if there is no integer part
+    tb_long_t   pos = (tb_long_t)n;
+    tb_bool_t   sticky = tb_false;
+    if (point <= 61)
     {
-        if (integer < 0) integer = -integer;
-        do
+        // frac / 2^point, frac * 5 always fits in 64-bits
+        tb_uint64_t frac = m & ((1ULL << point) - 1);
+        for (k = 0; k <= precision && frac; k++)
         {
-            ints[ints_i++] = (integer % 10) + '0';
-            integer /= 10;
+            frac *= 5;
+            point--;
+            tb_char_t d = (tb_char_t)(frac >> point);
+            frac &= (1ULL << point) - 1;
+            if (n || d) digits[n++] = (tb_char_t)('0' + d);
+            else pos--;
         }
-        while (integer);
+        sticky = frac? tb_true : tb_false;
     }
-
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = '0';
     else
     {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do
+        // frac / 2^(32 * count) with the 32-bits limbs, the value is less than 1 here (point > 52)
+        tb_uint32_t limbs[36];
+        tb_size_t   count = (point + 31) >> 5;
+        tb_size_t   shift = (count << 5) - point;
+        tb_uint64_t high = shift? (m >> (32 - shift)) : (m >> 32);
+        tb_memset_(limbs, 0, sizeof(limbs));
+        limbs[0] = (tb_uint32_t)(m << shift);
+        limbs[1] = (tb_uint32_t)high;
+        limbs[2] = (tb_uint32_t)(high >> 32);
+
+        // multiply it by 10 and get the carry digit
+        tb_size_t low = 0;
+        for (k = 0; k <= precision && low < count; k++)
         {
-            decs[decs_i++] = (tb_char_t)(d + (tb_long_t)'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
+            tb_uint64_t carry = 0;
+            for (i = low; i < count; i++)
+            {
+                tb_uint64_t t = (tb_uint64_t)limbs[i] * 10 + carry;
+                limbs[i] = (tb_uint32_t)t;
+                carry = t >> 32;
+            }
+            tb_char_t d = (tb_char_t)carry;
+            if (n || d) digits[n++] = (tb_char_t)('0' + d);
+            else pos--;
+
+            // skip the zero limbs at the low side
+            while (low < count && !limbs[low]) low++;
         }
-        while (decs_i < e.precision);
+        sticky = low < count? tb_true : tb_false;
     }
 
-    // adjust precision
-    if (decs_i > e.precision)
-        decs_i = e.precision;
+    // append the sticky digit
+    if (sticky) digits[n++] = '1';
 
-    // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= (tb_int_t)(ints_i + 1 + e.precision);
-    if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
-    {
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = ' ';
-    }
+    // remove the trailing zeros
+    while (n > 1 && digits[n - 1] == '0') n--;
 
-    // append sign: + / -
-    if (sign && (pb < pe)) *pb++ = sign;
+    // ok
+    *ppos = pos;
+    return n;
+}
+static tb_char_t* tb_printf_fnum(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_double_t num)
+{
+    // for inf nan
+    tb_bool_t upper = (e.extra & TB_PRINTF_EXTRA_UPPER)? tb_true : tb_false;
+    if (tb_isinf(num)) return tb_printf_fpad(pb, pe, e, num < 0? '-' : 0, upper? "INF" : "inf", 3, tb_false);
+    else if (tb_isnan(num)) return tb_printf_fpad(pb, pe, e, 0, upper? "NAN" : "nan", 3, tb_false);
 
-    // fill 0 or spaces, e.g. "00003.1415926"
-    if (!(e.flags & TB_PRINTF_FLAG_LEFT))
+    // sign: + -
+    tb_char_t sign = 0;
+    if (e.extra & TB_PRINTF_EXTRA_SIGNED)
     {
-        tb_char_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? '0' : ' ';
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = c;
+        if (num < 0) sign = '-';
+        else if (e.flags & TB_PRINTF_FLAG_PLUS) sign = '+';
     }
 
-    // append integer
-    while (--ints_i >= 0)
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = '.';
+    /* get the digits, value = 0.digits * 10^pos
+     *
+     * we use the exact digits and round them like libc, the default precision is 6 for %f, %e and %g,
+     * please use tb_dtoa() or tb_ftoa() for the shortest digits which can be converted back to the same value.
+     *
+     * %f uses the fixed-point digits and only falls back to the big decimal for the subnormal value with a large precision.
+     */
+    tb_long_t   exp = 0;
+    tb_size_t   n = 0;
+    tb_long_t   precision = tb_min(e.precision, 128);
+    tb_long_t   pos = 0;
+    tb_char_t   digits[800];
+    if (!(e.extra & (TB_PRINTF_EXTRA_GENERAL | TB_PRINTF_EXTRA_EXP)))
+        n = tb_printf_fdigits(num, precision < 0? 6 : precision, digits, sizeof(digits), &pos);
+    if (!n)
+    {
+        n = tb_dtoa_exact_digits(num, digits, sizeof(digits), &exp);
+        tb_assert_and_check_return_val(n, pb);
+        pos = (tb_long_t)n + exp;
+    }
 
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0)
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
+    // format it
+    tb_bool_t bexp = (e.extra & TB_PRINTF_EXTRA_EXP)? tb_true : tb_false;
+    if (e.extra & TB_PRINTF_EXTRA_GENERAL)
+    {
+        /* %g: round it to the given significant digits (6 by default),
+         * and use the exponent form if the exponent is less than -4 or not less than the precision
+         */
+        tb_long_t p = precision < 0? 6 : (precision? precision : 1);
+        tb_printf_fround(digits, &n, &pos, p);
+        tb_long_t x = (digits[0] != '0')? pos - 1 : 0;
+        bexp = (x < -4 || x >= p)? tb_true : tb_false;
+
+        // remove the trailing zeros if no '#', the alternate form keeps them and the decimal point
+        if (e.flags & TB_PRINTF_FLAG_PFIX) precision = bexp? p - 1 : p - 1 - x;
+        else precision = bexp? (tb_long_t)n - 1 : tb_max((tb_long_t)n - pos, 0);
+    }
+    else
+    {
+        // default precision: 6
+        if (precision < 0) precision = 6;
+        tb_printf_fround(digits, &n, &pos, bexp? precision + 1 : pos + precision);
+    }
 
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision)
-        if (pb < pe) *pb++ = '0';
+    // make text
+    tb_char_t   text[512];
+    tb_char_t*  p = text;
+    tb_char_t*  tail = text + sizeof(text) - 8;
+    tb_long_t   i = 0;
+    if (bexp)
+    {
+        // d.ddde+xx
+        *p++ = digits[0];
+        if (precision > 0 || (e.flags & TB_PRINTF_FLAG_PFIX)) *p++ = '.';
+        for (i = 1; i <= precision && p < tail; i++) *p++ = i < (tb_long_t)n? digits[i] : '0';
+
+        // the exponent, at least two digits
+        tb_long_t x = (digits[0] != '0')? pos - 1 : 0;
+        *p++ = upper? 'E' : 'e';
+        *p++ = x < 0? '-' : '+';
+        if (x < 0) x = -x;
+        if (x >= 100) *p++ = (tb_char_t)('0' + x / 100);
+        *p++ = (tb_char_t)('0' + (x / 10) % 10);
+        *p++ = (tb_char_t)('0' + x % 10);
+    }
+    else
+    {
+        // the integer part
+        if (pos <= 0) *p++ = '0';
+        else for (i = 0; i < pos && p < tail; i++) *p++ = i < (tb_long_t)n? digits[i] : '0';
 
-    // trailing space padding for left-justified flags, e.g. "0.31415926   "
-    while (--e.width >= 0)
-        if (pb < pe) *pb++ = ' ';
+        // the decimal part
+        if (precision > 0 || (e.flags & TB_PRINTF_FLAG_PFIX)) *p++ = '.';
+        for (i = 0; i < precision && p < tail; i++)
+        {
+            tb_long_t j = pos + i;
+            *p++ = (j >= 0 && j < (tb_long_t)n)? digits[j] : '0';
+        }
+    }
 
-    return pb;
+    // fill it
+    return tb_printf_fpad(pb, pe, e, sign, text, p - text, tb_true);
 }
 #endif
 // get a printf format entry
@@ -938,6 +1009,13 @@ get_qualifier:
         e->extra |= TB_PRINTF_EXTRA_SIGNED;
         e->extra |= TB_PRINTF_EXTRA_EXP;
         break;
+    case 'G':
+        e->extra |= TB_PRINTF_EXTRA_UPPER;
+    case 'g':
+        e->type = TB_PRINTF_TYPE_FLOAT;
+        e->extra |= TB_PRINTF_EXTRA_SIGNED;
+        e->extra |= TB_PRINTF_EXTRA_GENERAL;
+        break;
 #endif
     case '{':
         {
@@ -1097,13 +1175,13 @@ tb_long_t tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_va_li
                 if (e.qual == TB_PRINTF_QUAL_L)
                 {
                     tb_double_t num = tb_va_arg(args, tb_double_t);
-                    pb = tb_printf_double(pb, pe, e, num);
+                    pb = tb_printf_fnum(pb, pe, e, num);
                 }
                 // float?
                 else
                 {
                     tb_float_t num = (tb_float_t)tb_va_arg(args, tb_double_t);
-                    pb = tb_printf_float(pb, pe, e, num);
+                    pb = tb_printf_fnum(pb, pe, e, num);
                 }
                 break;
             }
@@ -60,6 +60,7 @@ typedef enum __tb_printf_extra_t
 ,   TB_PRINTF_EXTRA_UPPER           = 2     // upper case for %X %B
 ,   TB_PRINTF_EXTRA_PERCENT         = 4     // percent char: %
 ,   TB_PRINTF_EXTRA_EXP             = 8     // exponent form: [-]d.ddd e[+/-]ddd
+,   TB_PRINTF_EXTRA_GENERAL         = 16    // general form: %g, the fixed or exponent form
 
 }tb_printf_extra_t;
 
@@ -489,263 +490,29 @@ static tb_wchar_t* tb_printf_int32(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_ent
     return pb;
 }
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-static tb_wchar_t* tb_printf_float(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_entry_t e, tb_float_t num)
+static tb_wchar_t* tb_printf_fnum(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_entry_t e, tb_double_t num, tb_bool_t bfloat)
 {
-    // digits
-    tb_wchar_t  ints[32] = {0};
-    tb_wchar_t  decs[32] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
-
-    // for inf nan
-    if (tb_isinff(num))
-    {
-        if (pb < pe && num < 0) *pb++ = L'-';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'I' : L'i';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'F' : L'f';
-        return pb;
-    }
-    else if (tb_isnanf(num))
-    {
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'A' : L'a';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        return pb;
-    }
-
-    // sign: + -
-    tb_wchar_t sign = 0;
-    if (e.extra & TB_PRINTF_EXTRA_SIGNED)
-    {
-        if (num < 0)
-        {
-            sign = L'-';
-            --e.width;
-        }
-        else if (e.flags & TB_PRINTF_FLAG_PLUS)
-        {
-            sign = L'+';
-            --e.width;
-        }
-    }
-
-    // adjust sign
-    if (num < 0) num = -num;
-
-    // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint32_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint32_t)(num * p * 10) % 10) > 4)
-        num += 1.0f / (tb_float_t)p;
-
-    // get integer & decimal
-    tb_int32_t integer = (tb_int32_t)num;
-    tb_float_t decimal = num - integer;
-
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = L'0';
-    else
-    {
-        if (integer < 0) integer = -integer;
-        do
-        {
-            ints[ints_i++] = (integer % 10) + L'0';
-            integer /= 10;
-        }
-        while (integer);
-    }
-
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = L'0';
-    else
-    {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do
-        {
-            decs[decs_i++] = (tb_wchar_t)(d + (tb_long_t)L'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
-        }
-        while (decs_i < e.precision);
-    }
-
-    // adjust precision
-    if (decs_i > e.precision)
-        decs_i = e.precision;
-
-    // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= ints_i + 1 + e.precision;
-    if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
-    {
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = L' ';
-    }
-
-    // append sign: + / -
-    if (sign && (pb < pe)) *pb++ = sign;
-
-    // fill 0 or spaces, e.g. "00003.1415926"
-    if (!(e.flags & TB_PRINTF_FLAG_LEFT))
-    {
-        tb_wchar_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? L'0' : L' ';
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = c;
-    }
-
-    // append integer
-    while (--ints_i >= 0)
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = L'.';
-
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0)
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
-
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision)
-        if (pb < pe) *pb++ = L'0';
-
-    // trailing space padding for left-justified flags, e.g. "0.31415926   "
-    while (--e.width >= 0)
-        if (pb < pe) *pb++ = L' ';
-
-    return pb;
-}
-static tb_wchar_t* tb_printf_double(tb_wchar_t* pb, tb_wchar_t* pe, tb_printf_entry_t e, tb_double_t num)
-{
-    // digits
-    tb_wchar_t  ints[64] = {0};
-    tb_wchar_t  decs[64] = {0};
-    tb_int_t    ints_i = 0, decs_i = 0;
-
-    // for inf nan
-    if (tb_isinf(num))
-    {
-        if (pb < pe && num < 0) *pb++ = L'-';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'I' : L'i';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'F' : L'f';
-        return pb;
-    }
-    else if (tb_isnan(num))
-    {
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'A' : L'a';
-        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? L'N' : L'n';
-        return pb;
-    }
-
-
-    // sign: + -
-    tb_wchar_t sign = 0;
-    if (e.extra & TB_PRINTF_EXTRA_SIGNED)
-    {
-        if (num < 0)
-        {
-            sign = L'-';
-            --e.width;
-        }
-        else if (e.flags & TB_PRINTF_FLAG_PLUS)
-        {
-            sign = L'+';
-            --e.width;
-        }
-    }
-
-    // adjust sign
-    if (num < 0) num = -num;
-
-    // default precision: 6
-    if (e.precision <= 0) e.precision = 6;
-
-    // round? i.dddddddd5 => i.ddddddde
-    tb_uint64_t p = 1;
-    tb_size_t   n = e.precision;
-    while (n--) p *= 10;
-    if (((tb_uint64_t)(num * p * 10) % 10) > 4)
-        num += 1. / (tb_double_t)p;
-
-    // get integer & decimal
-    tb_int64_t integer = (tb_int64_t)num;
-    tb_double_t decimal = num - integer;
-
-    // convert integer => digits string in reverse order
-    if (integer == 0) ints[ints_i++] = L'0';
-    else
-    {
-        if (integer < 0) integer = -integer;
-        do
-        {
-            ints[ints_i++] = (integer % 10) + L'0';
-            integer /= 10;
-        }
-        while (integer);
-    }
-
-    // convert decimal => digits string in positive order
-    if (decimal == 0) decs[decs_i++] = L'0';
-    else
-    {
-        tb_long_t d = (tb_long_t)(decimal * 10);
-        do
-        {
-            decs[decs_i++] = (tb_wchar_t)(d + (tb_long_t)L'0');
-            decimal = decimal * 10 - d;
-            d = (tb_long_t)(decimal * 10);
-        }
-        while (decs_i < e.precision);
-    }
-
-    // adjust precision
-    if (decs_i > e.precision)
-        decs_i = e.precision;
-
-    // fill spaces at left side, e.g. "   0.31415926"
-    e.width -= ints_i + 1 + e.precision;
-    if (!(e.flags & (TB_PRINTF_FLAG_LEFT + TB_PRINTF_FLAG_ZERO)))
-    {
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = L' ';
-    }
-
-    // append sign: + / -
-    if (sign && (pb < pe)) *pb++ = sign;
-
-    // fill 0 or spaces, e.g. "00003.1415926"
-    if (!(e.flags & TB_PRINTF_FLAG_LEFT))
-    {
-        tb_wchar_t c = (e.flags & TB_PRINTF_FLAG_ZERO)? L'0' : L' ';
-        while (--e.width >= 0)
-            if (pb < pe) *pb++ = c;
-    }
-
-    // append integer
-    while (--ints_i >= 0)
-        if (pb < pe) *pb++ = ints[ints_i];
-
-    // append .
-    if (pb < pe) *pb++ = L'.';
-
-    // append decimal
-    tb_int_t decs_n = decs_i;
-    while (--decs_i >= 0)
-        if (pb < pe) *pb++ = decs[decs_n - decs_i - 1];
-
-    // fill 0 if precision is larger, e.g. "0.3140000"
-    while (decs_n <= --e.precision)
-        if (pb < pe) *pb++ = L'0';
-
-    // trailing space padding for left-justified flags, e.g. "0.31415926   "
-    while (--e.width >= 0)
-        if (pb < pe) *pb++ = L' ';
-
+    // make the format string, e.g. "%-08.3lf"
+    tb_char_t   format[64];
+    tb_char_t*  p = format;
+    *p++ = '%';
+    if (e.flags & TB_PRINTF_FLAG_PLUS) *p++ = '+';
+    if (e.flags & TB_PRINTF_FLAG_LEFT) *p++ = '-';
+    if (e.flags & TB_PRINTF_FLAG_ZERO) *p++ = '0';
+    if (e.flags & TB_PRINTF_FLAG_PFIX) *p++ = '#';
+    if (e.width >= 0) p += tb_snprintf(p, format + sizeof(format) - p, "%d", e.width);
+    if (e.precision >= 0) p += tb_snprintf(p, format + sizeof(format) - p, ".%d", e.precision);
+    if (!bfloat) *p++ = 'l';
+    if (e.extra & TB_PRINTF_EXTRA_GENERAL) *p++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'G' : 'g';
+    else if (e.extra & TB_PRINTF_EXTRA_EXP) *p++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'E' : 'e';
+    else *p++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? 'F' : 'f';
+    *p = '\0';
+
+    // format it by tb_snprintf
+    tb_char_t data[512];
+    tb_long_t size = tb_snprintf(data, sizeof(data), format, num);
+    tb_long_t i = 0;
+    for (i = 0; i < size && i < (tb_long_t)sizeof(data) - 1 && pb < pe; i++) *pb++ = (tb_wchar_t)data[i];
     return pb;
 }
 #endif
@@ -946,6 +713,13 @@ get_qualifier:
         e->extra |= TB_PRINTF_EXTRA_SIGNED;
         e->extra |= TB_PRINTF_EXTRA_EXP;
         break;
+    case L'G':
+        e->extra |= TB_PRINTF_EXTRA_UPPER;
+    case L'g':
+        e->type = TB_PRINTF_TYPE_FLOAT;
+        e->extra |= TB_PRINTF_EXTRA_SIGNED;
+        e->extra |= TB_PRINTF_EXTRA_GENERAL;
+        break;
 #endif
     case L'{':
         {
@@ -1101,13 +875,13 @@ tb_long_t tb_vswprintf(tb_wchar_t* s, tb_size_t n, tb_wchar_t const* fmt, tb_va_
                 if (e.qual == TB_PRINTF_QUAL_L)
                 {
                     tb_double_t num = tb_va_arg(args, tb_double_t);
-                    pb = tb_printf_double(pb, pe, e, num);
+                    pb = tb_printf_fnum(pb, pe, e, num, tb_false);
                 }
                 // float?
                 else
                 {
                     tb_float_t num = (tb_float_t)tb_va_arg(args, tb_double_t);
-                    pb = tb_printf_float(pb, pe, e, num);
+                    pb = tb_printf_fnum(pb, pe, e, num, tb_true);
                 }
                 break;
             }
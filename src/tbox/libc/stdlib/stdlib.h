@@ -214,7 +214,15 @@ tb_double_t         tb_s8tod(tb_char_t const* s);
 
 /*! convert the decimal string to double
  *
- * .e.g "9" => 9
+ * <pre>
+ * .e.g
+ *
+ * "9"      => 9
+ * "-2.5e3" => -2500
+ * </pre>
+ *
+ * the result is rounded correctly, it uses the eisel-lemire algorithm
+ * and fallback to the big decimal arithmetic for the rare hard cases.
  *
  * @param s         the string
  *
@@ -262,6 +270,91 @@ tb_double_t         tb_stod(tb_char_t const* s);
  */
 tb_double_t         tb_sbtod(tb_char_t const* s, tb_int_t base);
 
+/*! convert double to the shortest decimal digits which can be converted back to the same double
+ *
+ * <pre>
+ * .e.g
+ *
+ * 0.3      => "3",     exp: -1
+ * -1500    => "15",    exp: 2
+ * 0        => "0",     exp: 0
+ * </pre>
+ *
+ * it uses the grisu2 algorithm, the digits always round-trip and are the shortest in most cases.
+ *
+ * @param value     the double value, it must be finite and the sign will be ignored
+ * @param data      the digits data
+ * @param maxn      the digits maxn, it must be larger than 24
+ * @param exp       the decimal exponent, value = digits * 10^exp
+ *
+ * @return          the digits count
+ */
+tb_size_t           tb_dtoa_digits(tb_double_t value, tb_char_t* data, tb_size_t maxn, tb_long_t* exp);
+
+/*! convert float to the shortest decimal digits which can be converted back to the same float
+ *
+ * @param value     the float value, it must be finite and the sign will be ignored
+ * @param data      the digits data
+ * @param maxn      the digits maxn, it must be larger than 24
+ * @param exp       the decimal exponent, value = digits * 10^exp
+ *
+ * @return          the digits count
+ */
+tb_size_t           tb_ftoa_digits(tb_float_t value, tb_char_t* data, tb_size_t maxn, tb_long_t* exp);
+
+/*! convert double to the exact decimal digits
+ *
+ * <pre>
+ * .e.g
+ *
+ * 0.1      => "1000000000000000055511151231257827021181583404541015625", exp: -55
+ * </pre>
+ *
+ * the exact value of double has 767 significant digits at most,
+ * if the data is too small, the last digit will be a non-zero sticky digit for rounding at the previous digits.
+ *
+ * @param value     the double value, it must be finite and the sign will be ignored
+ * @param data      the digits data
+ * @param maxn      the digits maxn, it must be larger than 24
+ * @param exp       the decimal exponent, value = digits * 10^exp
+ *
+ * @return          the digits count
+ */
+tb_size_t           tb_dtoa_exact_digits(tb_double_t value, tb_char_t* data, tb_size_t maxn, tb_long_t* exp);
+
+/*! convert double to the shortest string which can be converted back to the same double
+ *
+ * <pre>
+ * .e.g
+ *
+ * 0.1          => "0.1"
+ * 1            => "1.0"
+ * -1500.25     => "-1500.25"
+ * 1e21         => "1e+21"
+ * 1.5e-7       => "1.5e-7"
+ * </pre>
+ *
+ * the fixed notation is used if the decimal exponent is in [-6, 21), and it always has a decimal point,
+ * so it will be still read as a float number by the json or xml reader.
+ *
+ * @param value     the double value
+ * @param data      the string data
+ * @param maxn      the string maxn, 32 bytes is enough
+ *
+ * @return          the string size, return 0 if the data is too small
+ */
+tb_size_t           tb_dtoa(tb_double_t value, tb_char_t* data, tb_size_t maxn);
+
+/*! convert float to the shortest string which can be converted back to the same float
+ *
+ * @param value     the float value
+ * @param data      the string data
+ * @param maxn      the string maxn, 32 bytes is enough
+ *
+ * @return          the string size, return 0 if the data is too small
+ */
+tb_size_t           tb_ftoa(tb_float_t value, tb_char_t* data, tb_size_t maxn);
+
 #endif
 
 /*! mbstowcs, convert string to wstring
@@ -27,17 +27,206 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
-//#     define TB_LIBC_STRING_IMPL_MEMCMP
+#if defined(TB_LIBC_STRING_IMPL_x64_SIMD) && !defined(TB_CONFIG_LIBC_HAVE_MEMCMP)
+#   define TB_LIBC_STRING_IMPL_MEMCMP
 #endif
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+
+// the memcmp implementation type
+typedef tb_long_t   (*tb_memcmp_impl_t)(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n);
+
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
-static tb_long_t tb_memcmp_impl(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+static __tb_inline_force__ tb_long_t tb_memcmp_impl_diff(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t i)
+{
+    return (tb_long_t)p1[i] - (tb_long_t)p2[i];
+}
+static __tb_inline_force__ tb_long_t tb_memcmp_impl_small(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // compare the head and the tail, the lowest different bit is the first different byte for little-endian
+    if (n >= 8)
+    {
+        tb_uint64_t x = tb_bits_get_u64_ne_impl(p1) ^ tb_bits_get_u64_ne_impl(p2);
+        if (x) return tb_memcmp_impl_diff(p1, p2, tb_bits_cl0_u64_le(x) >> 3);
+        x = tb_bits_get_u64_ne_impl(p1 + n - 8) ^ tb_bits_get_u64_ne_impl(p2 + n - 8);
+        if (x) return tb_memcmp_impl_diff(p1, p2, n - 8 + (tb_bits_cl0_u64_le(x) >> 3));
+    }
+    else if (n >= 4)
+    {
+        tb_uint32_t x = tb_bits_get_u32_ne_impl(p1) ^ tb_bits_get_u32_ne_impl(p2);
+        if (x) return tb_memcmp_impl_diff(p1, p2, tb_bits_cl0_u32_le(x) >> 3);
+        x = tb_bits_get_u32_ne_impl(p1 + n - 4) ^ tb_bits_get_u32_ne_impl(p2 + n - 4);
+        if (x) return tb_memcmp_impl_diff(p1, p2, n - 4 + (tb_bits_cl0_u32_le(x) >> 3));
+    }
+    else
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < n; i++)
+        {
+            if (p1[i] != p2[i]) return tb_memcmp_impl_diff(p1, p2, i);
+        }
+    }
+    return 0;
+}
+static __tb_inline_force__ tb_uint32_t tb_memcmp_impl_mask_sse2(tb_byte_t const* p1, tb_byte_t const* p2)
+{
+    // get the mask of the different bytes
+    __m128i a = _mm_loadu_si128((__m128i const*)p1);
+    __m128i b = _mm_loadu_si128((__m128i const*)p2);
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xffff;
+}
+static tb_long_t tb_memcmp_impl_sse2(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // the small size
+    if (n < 16) return tb_memcmp_impl_small(p1, p2, n);
+
+    // compare 4 x 16 bytes
+    tb_size_t   i = 0;
+    tb_uint32_t m = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i)), _mm_loadu_si128((__m128i const*)(p2 + i)));
+        __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i + 16)), _mm_loadu_si128((__m128i const*)(p2 + i + 16)));
+        __m128i e2 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i + 32)), _mm_loadu_si128((__m128i const*)(p2 + i + 32)));
+        __m128i e3 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i + 48)), _mm_loadu_si128((__m128i const*)(p2 + i + 48)));
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(e0, e1), _mm_and_si128(e2, e3))) != 0xffff) break;
+    }
+
+    // compare 16 bytes
+    for (; i + 16 <= n; i += 16)
+    {
+        if ((m = tb_memcmp_impl_mask_sse2(p1 + i, p2 + i))) return tb_memcmp_impl_diff(p1, p2, i + tb_bits_cl0_u32_le(m));
+    }
+
+    // compare the tail, it may be overlapped with the last block
+    if (i < n && (m = tb_memcmp_impl_mask_sse2(p1 + n - 16, p2 + n - 16)))
+        return tb_memcmp_impl_diff(p1, p2, n - 16 + tb_bits_cl0_u32_le(m));
+    return 0;
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_long_t tb_memcmp_impl_avx2_body(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // the small size
+    if (n < 32) return tb_memcmp_impl_sse2(p1, p2, n);
+
+    // compare 4 x 32 bytes
+    tb_size_t   i = 0;
+    tb_uint32_t m = 0;
+    for (; i + 128 <= n; i += 128)
+    {
+        __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i)), _mm256_loadu_si256((__m256i const*)(p2 + i)));
+        __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i + 32)), _mm256_loadu_si256((__m256i const*)(p2 + i + 32)));
+        __m256i e2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i + 64)), _mm256_loadu_si256((__m256i const*)(p2 + i + 64)));
+        __m256i e3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i + 96)), _mm256_loadu_si256((__m256i const*)(p2 + i + 96)));
+        if ((tb_uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(e0, e1), _mm256_and_si256(e2, e3))) != 0xffffffff) break;
+    }
+
+    // compare 32 bytes
+    for (; i + 32 <= n; i += 32)
+    {
+        m = ~(tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i)), _mm256_loadu_si256((__m256i const*)(p2 + i))));
+        if (m) return tb_memcmp_impl_diff(p1, p2, i + tb_bits_cl0_u32_le(m));
+    }
+
+    // compare the tail, it may be overlapped with the last block
+    if (i < n)
+    {
+        i = n - 32;
+        m = ~(tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i)), _mm256_loadu_si256((__m256i const*)(p2 + i))));
+        if (m) return tb_memcmp_impl_diff(p1, p2, i + tb_bits_cl0_u32_le(m));
+    }
+    return 0;
+}
+static __tb_target__("avx2") tb_long_t tb_memcmp_impl_avx2(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // done
+    tb_long_t r = tb_memcmp_impl_avx2_body(p1, p2, n);
+
+    // leave the avx state
+    tb_avx_leave();
+    return r;
+}
+#   ifdef TB_LIBC_STRING_IMPL_x64_AVX512
+static __tb_inline_force__ __tb_target__("avx512f,avx512bw") tb_long_t tb_memcmp_impl_avx512_body(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // compare 4 x 64 bytes
+    tb_size_t   i = 0;
+    tb_uint64_t m = 0;
+    for (; i + 256 <= n; i += 256)
+    {
+        __mmask64 m0 = _mm512_cmpneq_epu8_mask(_mm512_loadu_si512((__m512i const*)(p1 + i)), _mm512_loadu_si512((__m512i const*)(p2 + i)));
+        __mmask64 m1 = _mm512_cmpneq_epu8_mask(_mm512_loadu_si512((__m512i const*)(p1 + i + 64)), _mm512_loadu_si512((__m512i const*)(p2 + i + 64)));
+        __mmask64 m2 = _mm512_cmpneq_epu8_mask(_mm512_loadu_si512((__m512i const*)(p1 + i + 128)), _mm512_loadu_si512((__m512i const*)(p2 + i + 128)));
+        __mmask64 m3 = _mm512_cmpneq_epu8_mask(_mm512_loadu_si512((__m512i const*)(p1 + i + 192)), _mm512_loadu_si512((__m512i const*)(p2 + i + 192)));
+        if (m0 | m1 | m2 | m3) break;
+    }
+
+    // compare 64 bytes
+    for (; i + 64 <= n; i += 64)
+    {
+        m = _mm512_cmpneq_epu8_mask(_mm512_loadu_si512((__m512i const*)(p1 + i)), _mm512_loadu_si512((__m512i const*)(p2 + i)));
+        if (m) return tb_memcmp_impl_diff(p1, p2, i + tb_bits_cl0_u64_le(m));
+    }
+
+    /* compare the tail by the masked loads, n % 64 bytes
+     *
+     * the masked bytes will not be loaded, so it will not cross the page boundary
+     */
+    if (i < n)
+    {
+        __mmask64 k = (__mmask64)(~0ULL >> (64 - (n - i)));
+        m = _mm512_mask_cmpneq_epu8_mask(k, _mm512_maskz_loadu_epi8(k, p1 + i), _mm512_maskz_loadu_epi8(k, p2 + i));
+        if (m) return tb_memcmp_impl_diff(p1, p2, i + tb_bits_cl0_u64_le(m));
+    }
+    return 0;
+}
+static __tb_target__("avx512f,avx512bw") tb_long_t tb_memcmp_impl_avx512(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
 {
+    // done
+    tb_long_t r = tb_memcmp_impl_avx512_body(p1, p2, n);
 
+    // leave the avx state
+    tb_avx_leave();
+    return r;
+}
+#   endif
+static tb_long_t tb_memcmp_impl_init(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n);
+static tb_memcmp_impl_t g_memcmp_impl = tb_memcmp_impl_init;
+static tb_long_t tb_memcmp_impl_init(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // select the implementation by the cpu features, they have been detected in tb_init()
+    tb_size_t           features = tb_cpu_features();
+    tb_memcmp_impl_t    impl = tb_memcmp_impl_sse2;
+#   ifdef TB_LIBC_STRING_IMPL_x64_AVX512
+    if (features & TB_CPU_FEATURE_AVX512) impl = tb_memcmp_impl_avx512;
+    else
+#   endif
+    if (features & TB_CPU_FEATURE_AVX2) impl = tb_memcmp_impl_avx2;
+    g_memcmp_impl = impl;
+
+    // done
+    return impl(p1, p2, n);
+}
+static tb_long_t tb_memcmp_impl_simd(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, 0);
+
+    // done
+    if (n < 16) return tb_memcmp_impl_small((tb_byte_t const*)s1, (tb_byte_t const*)s2, n);
+    return s1 != s2? g_memcmp_impl((tb_byte_t const*)s1, (tb_byte_t const*)s2, n) : 0;
+}
+#   ifdef TB_LIBC_STRING_IMPL_MEMCMP
+static tb_long_t tb_memcmp_impl(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    return tb_memcmp_impl_simd(s1, s2, n);
 }
+#   endif
 #endif
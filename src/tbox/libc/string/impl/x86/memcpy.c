@@ -27,15 +27,16 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_ASSEMBLER_IS_GAS) && defined(TB_ARCH_x86)
+#   define TB_LIBC_STRING_IMPL_MEMCPY
+#elif defined(TB_LIBC_STRING_IMPL_x64_SIMD) && !defined(TB_CONFIG_LIBC_HAVE_MEMCPY)
 #   define TB_LIBC_STRING_IMPL_MEMCPY
 #endif
 
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_ASSEMBLER_IS_GAS) && defined(TB_ARCH_x86)
 static tb_pointer_t tb_memcpy_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
 {
     tb_assert_and_check_return_val(s1 && s2, tb_null);
@@ -58,4 +59,28 @@ static tb_pointer_t tb_memcpy_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t
     );
     return s1;
 }
+#elif defined(TB_LIBC_STRING_IMPL_x64_SIMD)
+static tb_pointer_t tb_memcpy_impl_simd(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+
+    // the small size? copy it directly
+    if (n <= 32)
+    {
+        tb_memmov_impl_small((tb_byte_t*)s1, (tb_byte_t const*)s2, n);
+        return s1;
+    }
+
+    /* the x64 memmov family loads the head and the tail before storing them,
+     * so it costs nothing for the non-overlapped memory, we use it directly.
+     */
+    return tb_memmov_simd(s1, s2, n);
+}
+#   ifdef TB_LIBC_STRING_IMPL_MEMCPY
+static tb_pointer_t tb_memcpy_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    return tb_memcpy_impl_simd(s1, s2, n);
+}
+#   endif
 #endif
@@ -27,14 +27,39 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_ASSEMBLER_IS_GAS) && defined(TB_ARCH_x86)
+#   define TB_LIBC_STRING_IMPL_MEMMOV
+#elif defined(TB_LIBC_STRING_IMPL_x64_SIMD) && !defined(TB_CONFIG_LIBC_HAVE_MEMMOVE)
 #   define TB_LIBC_STRING_IMPL_MEMMOV
 #endif
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+
+// the memmov implementation type
+typedef tb_void_t   (*tb_memmov_impl_t)(tb_byte_t* d, tb_byte_t const* s, tb_size_t n);
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+
+// has enhanced rep movsb?
+static tb_bool_t    g_memmov_erms = tb_false;
+
+// the min size of the non-temporal stores
+static tb_size_t    g_memmov_stream_minn = TB_LIBC_STRING_x64_STREAM_MINN;
+
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_ASSEMBLER_IS_GAS) && defined(TB_ARCH_x86)
 static tb_pointer_t tb_memmov_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
 {
     tb_assert_and_check_return_val(s1 && s2, tb_null);
@@ -59,4 +84,505 @@ static tb_pointer_t tb_memmov_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t
     );
     return (tb_pointer_t)eax;
 }
+#elif defined(TB_LIBC_STRING_IMPL_x64_SIMD)
+static __tb_inline_force__ tb_void_t tb_memmov_impl_rep(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+#   ifdef TB_COMPILER_IS_MSVC
+    __movsb(d, s, n);
+#   else
+    __tb_asm__ __tb_volatile__ ("rep movsb" : "+D" (d), "+S" (s), "+c" (n) : : "memory");
+#   endif
+}
+static tb_void_t tb_memmov_impl_sse2(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // the small size, n <= 32
+    if (n <= 32)
+    {
+        tb_memmov_impl_small(d, s, n);
+        return ;
+    }
+
+    // the medium size, n <= 128, load all and store all
+    if (n <= 128)
+    {
+        __m128i a0 = _mm_loadu_si128((__m128i const*)s);
+        __m128i a1 = _mm_loadu_si128((__m128i const*)(s + 16));
+        __m128i b0 = _mm_loadu_si128((__m128i const*)(s + n - 32));
+        __m128i b1 = _mm_loadu_si128((__m128i const*)(s + n - 16));
+        if (n > 64)
+        {
+            __m128i a2 = _mm_loadu_si128((__m128i const*)(s + 32));
+            __m128i a3 = _mm_loadu_si128((__m128i const*)(s + 48));
+            __m128i b2 = _mm_loadu_si128((__m128i const*)(s + n - 64));
+            __m128i b3 = _mm_loadu_si128((__m128i const*)(s + n - 48));
+            _mm_storeu_si128((__m128i*)(d + 32), a2);
+            _mm_storeu_si128((__m128i*)(d + 48), a3);
+            _mm_storeu_si128((__m128i*)(d + n - 64), b2);
+            _mm_storeu_si128((__m128i*)(d + n - 48), b3);
+        }
+        _mm_storeu_si128((__m128i*)d, a0);
+        _mm_storeu_si128((__m128i*)(d + 16), a1);
+        _mm_storeu_si128((__m128i*)(d + n - 32), b0);
+        _mm_storeu_si128((__m128i*)(d + n - 16), b1);
+        return ;
+    }
+
+    // copy forward? d < s or no overlap
+    if ((tb_size_t)(d - s) >= n)
+    {
+        // no overlap? we can use rep movsb or the non-temporal stores
+        tb_bool_t overlap = (tb_size_t)(s - d) < n;
+        if (!overlap && g_memmov_erms && n >= TB_LIBC_STRING_x64_REP_MINN && n < g_memmov_stream_minn)
+        {
+            tb_memmov_impl_rep(d, s, n);
+            return ;
+        }
+
+        // load the head and the tail first
+        __m128i     h = _mm_loadu_si128((__m128i const*)s);
+        __m128i     t0 = _mm_loadu_si128((__m128i const*)(s + n - 64));
+        __m128i     t1 = _mm_loadu_si128((__m128i const*)(s + n - 48));
+        __m128i     t2 = _mm_loadu_si128((__m128i const*)(s + n - 32));
+        __m128i     t3 = _mm_loadu_si128((__m128i const*)(s + n - 16));
+        tb_byte_t*  p = d;
+        tb_byte_t*  e = d + n;
+
+        // align the destination
+        tb_size_t skip = 16 - ((tb_size_t)d & 15);
+        d += skip; s += skip; n -= skip;
+
+        // copy 4 x 16 bytes
+        if (!overlap && n >= g_memmov_stream_minn)
+        {
+            for (; n > 64; n -= 64, s += 64, d += 64)
+            {
+                _mm_prefetch((tb_char_t const*)s + 512, _MM_HINT_T0);
+                __m128i a0 = _mm_loadu_si128((__m128i const*)s);
+                __m128i a1 = _mm_loadu_si128((__m128i const*)(s + 16));
+                __m128i a2 = _mm_loadu_si128((__m128i const*)(s + 32));
+                __m128i a3 = _mm_loadu_si128((__m128i const*)(s + 48));
+                _mm_stream_si128((__m128i*)d, a0);
+                _mm_stream_si128((__m128i*)(d + 16), a1);
+                _mm_stream_si128((__m128i*)(d + 32), a2);
+                _mm_stream_si128((__m128i*)(d + 48), a3);
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; n > 64; n -= 64, s += 64, d += 64)
+            {
+                __m128i a0 = _mm_loadu_si128((__m128i const*)s);
+                __m128i a1 = _mm_loadu_si128((__m128i const*)(s + 16));
+                __m128i a2 = _mm_loadu_si128((__m128i const*)(s + 32));
+                __m128i a3 = _mm_loadu_si128((__m128i const*)(s + 48));
+                _mm_store_si128((__m128i*)d, a0);
+                _mm_store_si128((__m128i*)(d + 16), a1);
+                _mm_store_si128((__m128i*)(d + 32), a2);
+                _mm_store_si128((__m128i*)(d + 48), a3);
+            }
+        }
+
+        // store the tail and the head
+        _mm_storeu_si128((__m128i*)(e - 64), t0);
+        _mm_storeu_si128((__m128i*)(e - 48), t1);
+        _mm_storeu_si128((__m128i*)(e - 32), t2);
+        _mm_storeu_si128((__m128i*)(e - 16), t3);
+        _mm_storeu_si128((__m128i*)p, h);
+    }
+    // copy backward, s < d < s + n
+    else
+    {
+        // load the head and the tail first
+        __m128i     h0 = _mm_loadu_si128((__m128i const*)s);
+        __m128i     h1 = _mm_loadu_si128((__m128i const*)(s + 16));
+        __m128i     h2 = _mm_loadu_si128((__m128i const*)(s + 32));
+        __m128i     h3 = _mm_loadu_si128((__m128i const*)(s + 48));
+        __m128i     t = _mm_loadu_si128((__m128i const*)(s + n - 16));
+        tb_byte_t*  p = d;
+        tb_byte_t*  e = d + n;
+
+        // align the destination end
+        tb_size_t           skip = (tb_size_t)e & 15;
+        tb_byte_t*          de = e - skip;
+        tb_byte_t const*    se = s + n - skip;
+        n -= skip;
+
+        // copy 4 x 16 bytes
+        for (; n > 64; n -= 64)
+        {
+            se -= 64; de -= 64;
+            __m128i a0 = _mm_loadu_si128((__m128i const*)se);
+            __m128i a1 = _mm_loadu_si128((__m128i const*)(se + 16));
+            __m128i a2 = _mm_loadu_si128((__m128i const*)(se + 32));
+            __m128i a3 = _mm_loadu_si128((__m128i const*)(se + 48));
+            _mm_store_si128((__m128i*)de, a0);
+            _mm_store_si128((__m128i*)(de + 16), a1);
+            _mm_store_si128((__m128i*)(de + 32), a2);
+            _mm_store_si128((__m128i*)(de + 48), a3);
+        }
+
+        // store the head and the tail
+        _mm_storeu_si128((__m128i*)p, h0);
+        _mm_storeu_si128((__m128i*)(p + 16), h1);
+        _mm_storeu_si128((__m128i*)(p + 32), h2);
+        _mm_storeu_si128((__m128i*)(p + 48), h3);
+        _mm_storeu_si128((__m128i*)(e - 16), t);
+    }
+
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_void_t tb_memmov_impl_avx2_body(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // the small size, n <= 32
+    if (n <= 32)
+    {
+        tb_memmov_impl_small(d, s, n);
+        return ;
+    }
+
+    // the medium size, n <= 256, load all and store all
+    if (n <= 64)
+    {
+        __m256i a = _mm256_loadu_si256((__m256i const*)s);
+        __m256i b = _mm256_loadu_si256((__m256i const*)(s + n - 32));
+        _mm256_storeu_si256((__m256i*)d, a);
+        _mm256_storeu_si256((__m256i*)(d + n - 32), b);
+        return ;
+    }
+    if (n <= 256)
+    {
+        __m256i a0 = _mm256_loadu_si256((__m256i const*)s);
+        __m256i a1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+        __m256i b0 = _mm256_loadu_si256((__m256i const*)(s + n - 64));
+        __m256i b1 = _mm256_loadu_si256((__m256i const*)(s + n - 32));
+        if (n > 128)
+        {
+            __m256i a2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+            __m256i a3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+            __m256i b2 = _mm256_loadu_si256((__m256i const*)(s + n - 128));
+            __m256i b3 = _mm256_loadu_si256((__m256i const*)(s + n - 96));
+            _mm256_storeu_si256((__m256i*)(d + 64), a2);
+            _mm256_storeu_si256((__m256i*)(d + 96), a3);
+            _mm256_storeu_si256((__m256i*)(d + n - 128), b2);
+            _mm256_storeu_si256((__m256i*)(d + n - 96), b3);
+        }
+        _mm256_storeu_si256((__m256i*)d, a0);
+        _mm256_storeu_si256((__m256i*)(d + 32), a1);
+        _mm256_storeu_si256((__m256i*)(d + n - 64), b0);
+        _mm256_storeu_si256((__m256i*)(d + n - 32), b1);
+        return ;
+    }
+
+    // copy forward? d < s or no overlap
+    if ((tb_size_t)(d - s) >= n)
+    {
+        // no overlap? we can use rep movsb or the non-temporal stores
+        tb_bool_t overlap = (tb_size_t)(s - d) < n;
+        if (!overlap && g_memmov_erms && n >= TB_LIBC_STRING_x64_REP_MINN && n < g_memmov_stream_minn)
+        {
+            tb_memmov_impl_rep(d, s, n);
+            return ;
+        }
+
+        // load the head and the tail first
+        __m256i     h = _mm256_loadu_si256((__m256i const*)s);
+        __m256i     t0 = _mm256_loadu_si256((__m256i const*)(s + n - 128));
+        __m256i     t1 = _mm256_loadu_si256((__m256i const*)(s + n - 96));
+        __m256i     t2 = _mm256_loadu_si256((__m256i const*)(s + n - 64));
+        __m256i     t3 = _mm256_loadu_si256((__m256i const*)(s + n - 32));
+        tb_byte_t*  p = d;
+        tb_byte_t*  e = d + n;
+
+        // align the destination
+        tb_size_t skip = 32 - ((tb_size_t)d & 31);
+        d += skip; s += skip; n -= skip;
+
+        // copy 4 x 32 bytes
+        if (!overlap && n >= g_memmov_stream_minn)
+        {
+            for (; n > 128; n -= 128, s += 128, d += 128)
+            {
+                _mm_prefetch((tb_char_t const*)s + 512, _MM_HINT_T0);
+                __m256i a0 = _mm256_loadu_si256((__m256i const*)s);
+                __m256i a1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+                __m256i a2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+                __m256i a3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+                _mm256_stream_si256((__m256i*)d, a0);
+                _mm256_stream_si256((__m256i*)(d + 32), a1);
+                _mm256_stream_si256((__m256i*)(d + 64), a2);
+                _mm256_stream_si256((__m256i*)(d + 96), a3);
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; n > 128; n -= 128, s += 128, d += 128)
+            {
+                __m256i a0 = _mm256_loadu_si256((__m256i const*)s);
+                __m256i a1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+                __m256i a2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+                __m256i a3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+                _mm256_store_si256((__m256i*)d, a0);
+                _mm256_store_si256((__m256i*)(d + 32), a1);
+                _mm256_store_si256((__m256i*)(d + 64), a2);
+                _mm256_store_si256((__m256i*)(d + 96), a3);
+            }
+        }
+
+        // store the tail and the head
+        _mm256_storeu_si256((__m256i*)(e - 128), t0);
+        _mm256_storeu_si256((__m256i*)(e - 96), t1);
+        _mm256_storeu_si256((__m256i*)(e - 64), t2);
+        _mm256_storeu_si256((__m256i*)(e - 32), t3);
+        _mm256_storeu_si256((__m256i*)p, h);
+    }
+    // copy backward, s < d < s + n
+    else
+    {
+        // load the head and the tail first
+        __m256i     h0 = _mm256_loadu_si256((__m256i const*)s);
+        __m256i     h1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+        __m256i     h2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+        __m256i     h3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+        __m256i     t = _mm256_loadu_si256((__m256i const*)(s + n - 32));
+        tb_byte_t*  p = d;
+        tb_byte_t*  e = d + n;
+
+        // align the destination end
+        tb_size_t           skip = (tb_size_t)e & 31;
+        tb_byte_t*          de = e - skip;
+        tb_byte_t const*    se = s + n - skip;
+        n -= skip;
+
+        // copy 4 x 32 bytes
+        for (; n > 128; n -= 128)
+        {
+            se -= 128; de -= 128;
+            __m256i a0 = _mm256_loadu_si256((__m256i const*)se);
+            __m256i a1 = _mm256_loadu_si256((__m256i const*)(se + 32));
+            __m256i a2 = _mm256_loadu_si256((__m256i const*)(se + 64));
+            __m256i a3 = _mm256_loadu_si256((__m256i const*)(se + 96));
+            _mm256_store_si256((__m256i*)de, a0);
+            _mm256_store_si256((__m256i*)(de + 32), a1);
+            _mm256_store_si256((__m256i*)(de + 64), a2);
+            _mm256_store_si256((__m256i*)(de + 96), a3);
+        }
+
+        // store the head and the tail
+        _mm256_storeu_si256((__m256i*)p, h0);
+        _mm256_storeu_si256((__m256i*)(p + 32), h1);
+        _mm256_storeu_si256((__m256i*)(p + 64), h2);
+        _mm256_storeu_si256((__m256i*)(p + 96), h3);
+        _mm256_storeu_si256((__m256i*)(e - 32), t);
+    }
+
+}
+static __tb_target__("avx2") tb_void_t tb_memmov_impl_avx2(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // done
+    tb_memmov_impl_avx2_body(d, s, n);
+
+    // leave the avx state
+    tb_avx_leave();
+}
+#   ifdef TB_LIBC_STRING_IMPL_x64_AVX512
+static __tb_inline_force__ __tb_target__("avx512f,avx512bw") tb_void_t tb_memmov_impl_avx512_body(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // the small size, n <= 32
+    if (n <= 32)
+    {
+        tb_memmov_impl_small(d, s, n);
+        return ;
+    }
+
+    // the medium size, n <= 512, load all and store all
+    if (n <= 64)
+    {
+        __m256i a = _mm256_loadu_si256((__m256i const*)s);
+        __m256i b = _mm256_loadu_si256((__m256i const*)(s + n - 32));
+        _mm256_storeu_si256((__m256i*)d, a);
+        _mm256_storeu_si256((__m256i*)(d + n - 32), b);
+        return ;
+    }
+    if (n <= 128)
+    {
+        __m512i a = _mm512_loadu_si512((__m512i const*)s);
+        __m512i b = _mm512_loadu_si512((__m512i const*)(s + n - 64));
+        _mm512_storeu_si512((__m512i*)d, a);
+        _mm512_storeu_si512((__m512i*)(d + n - 64), b);
+        return ;
+    }
+    if (n <= 512)
+    {
+        __m512i a0 = _mm512_loadu_si512((__m512i const*)s);
+        __m512i a1 = _mm512_loadu_si512((__m512i const*)(s + 64));
+        __m512i b0 = _mm512_loadu_si512((__m512i const*)(s + n - 128));
+        __m512i b1 = _mm512_loadu_si512((__m512i const*)(s + n - 64));
+        if (n > 256)
+        {
+            __m512i a2 = _mm512_loadu_si512((__m512i const*)(s + 128));
+            __m512i a3 = _mm512_loadu_si512((__m512i const*)(s + 192));
+            __m512i b2 = _mm512_loadu_si512((__m512i const*)(s + n - 256));
+            __m512i b3 = _mm512_loadu_si512((__m512i const*)(s + n - 192));
+            _mm512_storeu_si512((__m512i*)(d + 128), a2);
+            _mm512_storeu_si512((__m512i*)(d + 192), a3);
+            _mm512_storeu_si512((__m512i*)(d + n - 256), b2);
+            _mm512_storeu_si512((__m512i*)(d + n - 192), b3);
+        }
+        _mm512_storeu_si512((__m512i*)d, a0);
+        _mm512_storeu_si512((__m512i*)(d + 64), a1);
+        _mm512_storeu_si512((__m512i*)(d + n - 128), b0);
+        _mm512_storeu_si512((__m512i*)(d + n - 64), b1);
+        return ;
+    }
+
+    // copy forward? d < s or no overlap
+    if ((tb_size_t)(d - s) >= n)
+    {
+        // no overlap? we can use rep movsb or the non-temporal stores
+        tb_bool_t overlap = (tb_size_t)(s - d) < n;
+        if (!overlap && g_memmov_erms && n >= TB_LIBC_STRING_x64_REP_MINN && n < g_memmov_stream_minn)
+        {
+            tb_memmov_impl_rep(d, s, n);
+            return ;
+        }
+
+        // load the head and the tail first
+        __m512i     h = _mm512_loadu_si512((__m512i const*)s);
+        __m512i     t0 = _mm512_loadu_si512((__m512i const*)(s + n - 256));
+        __m512i     t1 = _mm512_loadu_si512((__m512i const*)(s + n - 192));
+        __m512i     t2 = _mm512_loadu_si512((__m512i const*)(s + n - 128));
+        __m512i     t3 = _mm512_loadu_si512((__m512i const*)(s + n - 64));
+        tb_byte_t*  p = d;
+        tb_byte_t*  e = d + n;
+
+        // align the destination
+        tb_size_t skip = 64 - ((tb_size_t)d & 63);
+        d += skip; s += skip; n -= skip;
+
+        // copy 4 x 64 bytes
+        if (!overlap && n >= g_memmov_stream_minn)
+        {
+            for (; n > 256; n -= 256, s += 256, d += 256)
+            {
+                _mm_prefetch((tb_char_t const*)s + 512, _MM_HINT_T0);
+                __m512i a0 = _mm512_loadu_si512((__m512i const*)s);
+                __m512i a1 = _mm512_loadu_si512((__m512i const*)(s + 64));
+                __m512i a2 = _mm512_loadu_si512((__m512i const*)(s + 128));
+                __m512i a3 = _mm512_loadu_si512((__m512i const*)(s + 192));
+                _mm512_stream_si512((__m512i*)d, a0);
+                _mm512_stream_si512((__m512i*)(d + 64), a1);
+                _mm512_stream_si512((__m512i*)(d + 128), a2);
+                _mm512_stream_si512((__m512i*)(d + 192), a3);
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; n > 256; n -= 256, s += 256, d += 256)
+            {
+                __m512i a0 = _mm512_loadu_si512((__m512i const*)s);
+                __m512i a1 = _mm512_loadu_si512((__m512i const*)(s + 64));
+                __m512i a2 = _mm512_loadu_si512((__m512i const*)(s + 128));
+                __m512i a3 = _mm512_loadu_si512((__m512i const*)(s + 192));
+                _mm512_store_si512((__m512i*)d, a0);
+                _mm512_store_si512((__m512i*)(d + 64), a1);
+                _mm512_store_si512((__m512i*)(d + 128), a2);
+                _mm512_store_si512((__m512i*)(d + 192), a3);
+            }
+        }
+
+        // store the tail and the head
+        _mm512_storeu_si512((__m512i*)(e - 256), t0);
+        _mm512_storeu_si512((__m512i*)(e - 192), t1);
+        _mm512_storeu_si512((__m512i*)(e - 128), t2);
+        _mm512_storeu_si512((__m512i*)(e - 64), t3);
+        _mm512_storeu_si512((__m512i*)p, h);
+    }
+    // copy backward, s < d < s + n
+    else
+    {
+        // load the head and the tail first
+        __m512i     h0 = _mm512_loadu_si512((__m512i const*)s);
+        __m512i     h1 = _mm512_loadu_si512((__m512i const*)(s + 64));
+        __m512i     h2 = _mm512_loadu_si512((__m512i const*)(s + 128));
+        __m512i     h3 = _mm512_loadu_si512((__m512i const*)(s + 192));
+        __m512i     t = _mm512_loadu_si512((__m512i const*)(s + n - 64));
+        tb_byte_t*  p = d;
+        tb_byte_t*  e = d + n;
+
+        // align the destination end
+        tb_size_t           skip = (tb_size_t)e & 63;
+        tb_byte_t*          de = e - skip;
+        tb_byte_t const*    se = s + n - skip;
+        n -= skip;
+
+        // copy 4 x 64 bytes
+        for (; n > 256; n -= 256)
+        {
+            se -= 256; de -= 256;
+            __m512i a0 = _mm512_loadu_si512((__m512i const*)se);
+            __m512i a1 = _mm512_loadu_si512((__m512i const*)(se + 64));
+            __m512i a2 = _mm512_loadu_si512((__m512i const*)(se + 128));
+            __m512i a3 = _mm512_loadu_si512((__m512i const*)(se + 192));
+            _mm512_store_si512((__m512i*)de, a0);
+            _mm512_store_si512((__m512i*)(de + 64), a1);
+            _mm512_store_si512((__m512i*)(de + 128), a2);
+            _mm512_store_si512((__m512i*)(de + 192), a3);
+        }
+
+        // store the head and the tail
+        _mm512_storeu_si512((__m512i*)p, h0);
+        _mm512_storeu_si512((__m512i*)(p + 64), h1);
+        _mm512_storeu_si512((__m512i*)(p + 128), h2);
+        _mm512_storeu_si512((__m512i*)(p + 192), h3);
+        _mm512_storeu_si512((__m512i*)(e - 64), t);
+    }
+
+}
+static __tb_target__("avx512f,avx512bw") tb_void_t tb_memmov_impl_avx512(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // done
+    tb_memmov_impl_avx512_body(d, s, n);
+
+    // leave the avx state
+    tb_avx_leave();
+}
+#   endif
+static tb_void_t tb_memmov_impl_init(tb_byte_t* d, tb_byte_t const* s, tb_size_t n);
+static tb_memmov_impl_t g_memmov_impl = tb_memmov_impl_init;
+static tb_void_t tb_memmov_impl_init(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // select the implementation by the cpu features, they have been detected in tb_init()
+    tb_size_t           features = tb_cpu_features();
+    tb_memmov_impl_t    impl = tb_memmov_impl_sse2;
+#   ifdef TB_LIBC_STRING_IMPL_x64_AVX512
+    if (features & TB_CPU_FEATURE_AVX512) impl = tb_memmov_impl_avx512;
+    else
+#   endif
+    if (features & TB_CPU_FEATURE_AVX2) impl = tb_memmov_impl_avx2;
+    tb_size_t           cache_size = tb_cpu_cache_size();
+    if (cache_size) g_memmov_stream_minn = (cache_size >> 2) * 3;
+    g_memmov_erms = (features & TB_CPU_FEATURE_ERMS)? tb_true : tb_false;
+    g_memmov_impl = impl;
+
+    // done
+    impl(d, s, n);
+}
+static tb_pointer_t tb_memmov_impl_simd(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+
+    // the small size? copy it directly
+    if (n <= 32) tb_memmov_impl_small((tb_byte_t*)s1, (tb_byte_t const*)s2, n);
+    else if (s1 != s2) g_memmov_impl((tb_byte_t*)s1, (tb_byte_t const*)s2, n);
+    return s1;
+}
+#   ifdef TB_LIBC_STRING_IMPL_MEMMOV
+static tb_pointer_t tb_memmov_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    return tb_memmov_impl_simd(s1, s2, n);
+}
+#   endif
 #endif
@@ -31,12 +31,37 @@
  * macros
  */
 
-#if (defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32) || \
+#if defined(TB_CONFIG_LIBC_HAVE_MEMSET)
+    // only the builtin simd implementation on x64
+#elif (defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32) || \
         defined(TB_ARCH_SSE2)
 #   define TB_LIBC_STRING_IMPL_MEMSET_U8
 #   define TB_LIBC_STRING_IMPL_MEMSET_U16
 #   define TB_LIBC_STRING_IMPL_MEMSET_U32
+#elif defined(TB_LIBC_STRING_IMPL_x64_SIMD)
+#   define TB_LIBC_STRING_IMPL_MEMSET_U8
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+
+// the memset implementation type
+typedef tb_void_t   (*tb_memset_impl_t)(tb_byte_t* s, tb_byte_t c, tb_size_t n);
+
 #endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+
+// has enhanced rep stosb?
+static tb_bool_t    g_memset_erms = tb_false;
+
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -98,21 +123,269 @@ static __tb_inline__ tb_void_t tb_memset_impl_u8_opt_v2(tb_byte_t* s, tb_byte_t
 }
 #endif
 
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+static __tb_inline_force__ tb_void_t tb_memset_impl_rep(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+#   ifdef TB_COMPILER_IS_MSVC
+    __stosb(s, c, n);
+#   else
+    __tb_asm__ __tb_volatile__ ("rep stosb" : "+D" (s), "+c" (n) : "a" (c) : "memory");
+#   endif
+}
+static __tb_inline_force__ tb_void_t tb_memset_impl_small(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+    // fill the head and the tail, they may be overlapped
+    tb_uint64_t v = (tb_uint64_t)c * 0x0101010101010101ULL;
+    if (n >= 16)
+    {
+        __m128i x = _mm_set1_epi8((tb_char_t)c);
+        _mm_storeu_si128((__m128i*)s, x);
+        _mm_storeu_si128((__m128i*)(s + n - 16), x);
+    }
+    else if (n >= 8)
+    {
+        tb_bits_set_u64_ne_impl(s, v);
+        tb_bits_set_u64_ne_impl(s + n - 8, v);
+    }
+    else if (n >= 4)
+    {
+        tb_bits_set_u32_ne_impl(s, (tb_uint32_t)v);
+        tb_bits_set_u32_ne_impl(s + n - 4, (tb_uint32_t)v);
+    }
+    else if (n)
+    {
+        s[0] = c;
+        s[n >> 1] = c;
+        s[n - 1] = c;
+    }
+}
+static tb_void_t tb_memset_impl_sse2(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+    // the small size, n <= 32
+    if (n <= 32)
+    {
+        tb_memset_impl_small(s, c, n);
+        return ;
+    }
+
+    // the medium size, n <= 64, the stores may be overlapped
+    __m128i v = _mm_set1_epi8((tb_char_t)c);
+    if (n <= 64)
+    {
+        _mm_storeu_si128((__m128i*)s, v);
+        _mm_storeu_si128((__m128i*)(s + 16), v);
+        _mm_storeu_si128((__m128i*)(s + n - 32), v);
+        _mm_storeu_si128((__m128i*)(s + n - 16), v);
+        return ;
+    }
+
+    // has enhanced rep stosb?
+    if (g_memset_erms && n >= TB_LIBC_STRING_x64_REP_MINN)
+    {
+        tb_memset_impl_rep(s, c, n);
+        return ;
+    }
+
+    // store the head and the tail
+    tb_byte_t* e = s + n;
+    _mm_storeu_si128((__m128i*)s, v);
+    _mm_storeu_si128((__m128i*)(e - 64), v);
+    _mm_storeu_si128((__m128i*)(e - 48), v);
+    _mm_storeu_si128((__m128i*)(e - 32), v);
+    _mm_storeu_si128((__m128i*)(e - 16), v);
+
+    // align the destination
+    tb_byte_t* p = (tb_byte_t*)(((tb_size_t)s + 16) & ~(tb_size_t)15);
+
+    // fill 4 x 16 bytes
+    for (; p + 64 < e; p += 64)
+    {
+        _mm_store_si128((__m128i*)p, v);
+        _mm_store_si128((__m128i*)(p + 16), v);
+        _mm_store_si128((__m128i*)(p + 32), v);
+        _mm_store_si128((__m128i*)(p + 48), v);
+    }
+}
+static __tb_inline_force__ __tb_target__("avx2") tb_void_t tb_memset_impl_avx2_body(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+    // the small size, n <= 32
+    if (n <= 32)
+    {
+        tb_memset_impl_small(s, c, n);
+        return ;
+    }
+
+    // the medium size, n <= 128, the stores may be overlapped
+    __m256i v = _mm256_set1_epi8((tb_char_t)c);
+    if (n <= 64)
+    {
+        _mm256_storeu_si256((__m256i*)s, v);
+        _mm256_storeu_si256((__m256i*)(s + n - 32), v);
+        return ;
+    }
+    if (n <= 128)
+    {
+        _mm256_storeu_si256((__m256i*)s, v);
+        _mm256_storeu_si256((__m256i*)(s + 32), v);
+        _mm256_storeu_si256((__m256i*)(s + n - 64), v);
+        _mm256_storeu_si256((__m256i*)(s + n - 32), v);
+        return ;
+    }
+
+    // has enhanced rep stosb?
+    if (g_memset_erms && n >= TB_LIBC_STRING_x64_REP_MINN)
+    {
+        tb_memset_impl_rep(s, c, n);
+        return ;
+    }
+
+    // store the head and the tail
+    tb_byte_t* e = s + n;
+    _mm256_storeu_si256((__m256i*)s, v);
+    _mm256_storeu_si256((__m256i*)(e - 128), v);
+    _mm256_storeu_si256((__m256i*)(e - 96), v);
+    _mm256_storeu_si256((__m256i*)(e - 64), v);
+    _mm256_storeu_si256((__m256i*)(e - 32), v);
+
+    // align the destination
+    tb_byte_t* p = (tb_byte_t*)(((tb_size_t)s + 32) & ~(tb_size_t)31);
+
+    // fill 4 x 32 bytes
+    for (; p + 128 < e; p += 128)
+    {
+        _mm256_store_si256((__m256i*)p, v);
+        _mm256_store_si256((__m256i*)(p + 32), v);
+        _mm256_store_si256((__m256i*)(p + 64), v);
+        _mm256_store_si256((__m256i*)(p + 96), v);
+    }
+}
+static __tb_target__("avx2") tb_void_t tb_memset_impl_avx2(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+    // done
+    tb_memset_impl_avx2_body(s, c, n);
+
+    // leave the avx state
+    tb_avx_leave();
+}
+#   ifdef TB_LIBC_STRING_IMPL_x64_AVX512
+static __tb_inline_force__ __tb_target__("avx512f,avx512bw") tb_void_t tb_memset_impl_avx512_body(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+    // the small size, n <= 32
+    if (n <= 32)
+    {
+        tb_memset_impl_small(s, c, n);
+        return ;
+    }
+
+    // the medium size, n <= 256, the stores may be overlapped
+    __m512i v = _mm512_set1_epi8((tb_char_t)c);
+    if (n <= 64)
+    {
+        __m256i y = _mm512_castsi512_si256(v);
+        _mm256_storeu_si256((__m256i*)s, y);
+        _mm256_storeu_si256((__m256i*)(s + n - 32), y);
+        return ;
+    }
+    if (n <= 128)
+    {
+        _mm512_storeu_si512((__m512i*)s, v);
+        _mm512_storeu_si512((__m512i*)(s + n - 64), v);
+        return ;
+    }
+    if (n <= 256)
+    {
+        _mm512_storeu_si512((__m512i*)s, v);
+        _mm512_storeu_si512((__m512i*)(s + 64), v);
+        _mm512_storeu_si512((__m512i*)(s + n - 128), v);
+        _mm512_storeu_si512((__m512i*)(s + n - 64), v);
+        return ;
+    }
+
+    // has enhanced rep stosb?
+    if (g_memset_erms && n >= TB_LIBC_STRING_x64_REP_MINN)
+    {
+        tb_memset_impl_rep(s, c, n);
+        return ;
+    }
+
+    // store the head and the tail
+    tb_byte_t* e = s + n;
+    _mm512_storeu_si512((__m512i*)s, v);
+    _mm512_storeu_si512((__m512i*)(e - 256), v);
+    _mm512_storeu_si512((__m512i*)(e - 192), v);
+    _mm512_storeu_si512((__m512i*)(e - 128), v);
+    _mm512_storeu_si512((__m512i*)(e - 64), v);
+
+    // align the destination
+    tb_byte_t* p = (tb_byte_t*)(((tb_size_t)s + 64) & ~(tb_size_t)63);
+
+    // fill 4 x 64 bytes
+    for (; p + 256 < e; p += 256)
+    {
+        _mm512_store_si512((__m512i*)p, v);
+        _mm512_store_si512((__m512i*)(p + 64), v);
+        _mm512_store_si512((__m512i*)(p + 128), v);
+        _mm512_store_si512((__m512i*)(p + 192), v);
+    }
+}
+static __tb_target__("avx512f,avx512bw") tb_void_t tb_memset_impl_avx512(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+    // done
+    tb_memset_impl_avx512_body(s, c, n);
+
+    // leave the avx state
+    tb_avx_leave();
+}
+#   endif
+
+static tb_void_t tb_memset_impl_init(tb_byte_t* s, tb_byte_t c, tb_size_t n);
+static tb_memset_impl_t g_memset_impl = tb_memset_impl_init;
+static tb_void_t tb_memset_impl_init(tb_byte_t* s, tb_byte_t c, tb_size_t n)
+{
+    // select the implementation by the cpu features, they have been detected in tb_init()
+    tb_size_t           features = tb_cpu_features();
+    tb_memset_impl_t    impl = tb_memset_impl_sse2;
+#   ifdef TB_LIBC_STRING_IMPL_x64_AVX512
+    if (features & TB_CPU_FEATURE_AVX512) impl = tb_memset_impl_avx512;
+    else
+#   endif
+    if (features & TB_CPU_FEATURE_AVX2) impl = tb_memset_impl_avx2;
+    g_memset_erms = (features & TB_CPU_FEATURE_ERMS)? tb_true : tb_false;
+    g_memset_impl = impl;
+
+    // done
+    impl(s, c, n);
+}
+static tb_pointer_t tb_memset_impl_simd(tb_pointer_t s, tb_byte_t c, tb_size_t n)
+{
+    tb_assert_and_check_return_val(s, tb_null);
+    if (!n) return s;
+
+    if (n <= 32) tb_memset_impl_small((tb_byte_t*)s, c, n);
+    else g_memset_impl((tb_byte_t*)s, c, n);
+    return s;
+}
+#endif
+
 #ifdef TB_LIBC_STRING_IMPL_MEMSET_U8
 static tb_pointer_t tb_memset_impl(tb_pointer_t s, tb_byte_t c, tb_size_t n)
 {
+#   if defined(TB_LIBC_STRING_IMPL_x64_SIMD)
+    return tb_memset_impl_simd(s, c, n);
+#   else
     tb_assert_and_check_return_val(s, tb_null);
     if (!n) return s;
 
-#   if defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32
+#       if defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32
     tb_memset_impl_u8_opt_v1(s, c, n);
-#   elif defined(TB_ARCH_SSE2)
+#       elif defined(TB_ARCH_SSE2)
     tb_memset_impl_u8_opt_v2(s, c, n);
-#   else
-#       error
-#   endif
+#       else
+#           error
+#       endif
 
     return s;
+#   endif
 }
 #endif
 
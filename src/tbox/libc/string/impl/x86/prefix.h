@@ -25,6 +25,77 @@
  * includes
  */
 #include "../prefix.h"
+#include "../../../../utils/bits.h"
+#include "../../../../platform/cpu.h"
+#ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+#   include <immintrin.h>
+#   define TB_LIBC_STRING_IMPL_x64_SIMD
+#   if defined(TB_COMPILER_IS_MSVC) || TB_COMPILER_VERSION_BE(5, 0)
+#       define TB_LIBC_STRING_IMPL_x64_AVX512
+#   endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the min size of rep movsb/stosb if the cpu has erms
+ *
+ * the startup cost of the microcode is higher than the vector loop for the small size,
+ * it is faster only for the large size (about 8K on skylake and later).
+ */
+#define TB_LIBC_STRING_x64_REP_MINN         (8192)
+
+/* the default min size of the non-temporal stores if the cache size is unknown
+ *
+ * we use 3/4 of the last level cache, the larger copy will evict all the hot data,
+ * so we bypass the cache and write to the memory directly.
+ */
+#define TB_LIBC_STRING_x64_STREAM_MINN      (4 << 20)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+#ifdef TB_LIBC_STRING_IMPL_x64_SIMD
+static __tb_inline_force__ tb_void_t tb_memmov_impl_small(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    /* load the head and the tail first and store them later, they may be overlapped,
+     * so it is also safe for the overlapped memory
+     *
+     * the unaligned access is always supported on x64, so we access the words directly
+     */
+    if (n >= 16)
+    {
+        __m128i a = _mm_loadu_si128((__m128i const*)s);
+        __m128i b = _mm_loadu_si128((__m128i const*)(s + n - 16));
+        _mm_storeu_si128((__m128i*)d, a);
+        _mm_storeu_si128((__m128i*)(d + n - 16), b);
+    }
+    else if (n >= 8)
+    {
+        tb_uint64_t a = tb_bits_get_u64_ne_impl(s);
+        tb_uint64_t b = tb_bits_get_u64_ne_impl(s + n - 8);
+        tb_bits_set_u64_ne_impl(d, a);
+        tb_bits_set_u64_ne_impl(d + n - 8, b);
+    }
+    else if (n >= 4)
+    {
+        tb_uint32_t a = tb_bits_get_u32_ne_impl(s);
+        tb_uint32_t b = tb_bits_get_u32_ne_impl(s + n - 4);
+        tb_bits_set_u32_ne_impl(d, a);
+        tb_bits_set_u32_ne_impl(d + n - 4, b);
+    }
+    else if (n)
+    {
+        tb_byte_t a = s[0];
+        tb_byte_t b = s[n >> 1];
+        tb_byte_t c = s[n - 1];
+        d[0] = a;
+        d[n >> 1] = b;
+        d[n - 1] = c;
+    }
+}
+#endif
 
 
 #endif
@@ -0,0 +1,84 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        memchr.c
+ * @ingroup     libc
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "string.h"
+#include "../../memory/impl/prefix.h"
+#ifdef TB_CONFIG_LIBC_HAVE_MEMCHR
+#   include <string.h>
+#else
+#   include "../impl/search.h"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#if defined(TB_CONFIG_LIBC_HAVE_MEMCHR)
+static tb_pointer_t tb_memchr_impl(tb_cpointer_t s, tb_byte_t c, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s, tb_null);
+
+    // done
+    return (tb_pointer_t)memchr(s, c, n);
+}
+#else
+static tb_pointer_t tb_memchr_impl(tb_cpointer_t s, tb_byte_t c, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s, tb_null);
+
+    // done
+    return (tb_pointer_t)tb_libc_search_chr((tb_byte_t const*)s, n, c, c, 0);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_pointer_t tb_memchr_(tb_cpointer_t s, tb_byte_t c, tb_size_t n)
+{
+    // done
+    return tb_memchr_impl(s, c, n);
+}
+tb_pointer_t tb_memchr(tb_cpointer_t s, tb_byte_t c, tb_size_t n)
+{
+    // check
+#ifdef __tb_debug__
+    {
+        // overflow?
+        tb_size_t size = tb_pool_data_size(s);
+        if (size && n > size)
+        {
+            tb_trace_i("[memchr]: [overflow]: [%#x x %lu] in [%p, %lu]", c, n, s, size);
+            tb_backtrace_dump("[memchr]: [overflow]: ", tb_null, 10);
+            tb_pool_data_dump(s, tb_true, "\t[malloc]: [from]: ");
+            tb_abort();
+        }
+    }
+#endif
+
+    // done
+    return tb_memchr_(s, c, n);
+}
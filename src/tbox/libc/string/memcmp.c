@@ -28,6 +28,8 @@
 #ifndef TB_CONFIG_LIBC_HAVE_MEMCMP
 #   if defined(TB_ARCH_x86)
 #       include "impl/x86/memcmp.c"
+#   elif defined(TB_ARCH_x64)
+#       include "impl/x86/memcmp.c"
 #   elif defined(TB_ARCH_ARM)
 #       include "impl/arm/memcmp.c"
 #   elif defined(TB_ARCH_SH4)
@@ -35,6 +37,9 @@
 #   endif
 #else
 #   include <string.h>
+#   ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+#       include "impl/x86/memcmp.c"
+#   endif
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -75,6 +80,13 @@ tb_long_t tb_memcmp_(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
     // done
     return tb_memcmp_impl(s1, s2, n);
 }
+#ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+tb_long_t tb_memcmp_simd(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // done
+    return tb_memcmp_impl_simd(s1, s2, n);
+}
+#endif
 tb_long_t tb_memcmp(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
 {
     // check
@@ -28,6 +28,8 @@
 #ifndef TB_CONFIG_LIBC_HAVE_MEMCPY
 #   if defined(TB_ARCH_x86)
 #       include "impl/x86/memcpy.c"
+#   elif defined(TB_ARCH_x64)
+#       include "impl/x86/memcpy.c"
 #   elif defined(TB_ARCH_ARM)
 #       include "impl/arm/memcpy.c"
 #   elif defined(TB_ARCH_SH4)
@@ -35,6 +37,9 @@
 #   endif
 #else
 #   include <string.h>
+#   ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+#       include "impl/x86/memcpy.c"
+#   endif
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -87,6 +92,13 @@ tb_pointer_t tb_memcpy_(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
     // done
     return tb_memcpy_impl(s1, s2, n);
 }
+#ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+tb_pointer_t tb_memcpy_simd(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // done
+    return tb_memcpy_impl_simd(s1, s2, n);
+}
+#endif
 tb_pointer_t tb_memcpy(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
 {
     // check
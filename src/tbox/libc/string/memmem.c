@@ -27,6 +27,8 @@
 #include "../../memory/impl/prefix.h"
 #ifdef TB_CONFIG_LIBC_HAVE_MEMMEM
 #   include <string.h>
+#else
+#   include "../impl/search.h"
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -47,30 +49,8 @@ static tb_pointer_t tb_memmem_impl(tb_cpointer_t s1, tb_size_t n1, tb_cpointer_t
     // check
     tb_assert_and_check_return_val(s1 && s2, tb_null);
 
-    // find empty data?
-	if (!n2) return (tb_pointer_t)s1;
-
     // done
-	if (n1 >= n2)
-    {
-        tb_size_t           n = 0;
-		tb_byte_t const*    ph = (tb_byte_t const*)s1;
-		tb_byte_t const*    pn = (tb_byte_t const*)s2;
-		tb_byte_t const*    plast = ph + (n1 - n2);
-		do
-        {
-			n = 0;
-			while (ph[n] == pn[n])
-            {
-                // found?
-				if (++n == n2) return (tb_pointer_t)ph;
-			}
-
-		} while (++ph <= plast);
-	}
-
-    // not found?
-	return tb_null;
+    return (tb_pointer_t)tb_libc_search_str((tb_byte_t const*)s1, n1, (tb_byte_t const*)s2, n2, tb_false);
 }
 #endif
 
@@ -38,6 +38,9 @@
 #   endif
 #else
 #   include <string.h>
+#   ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+#       include "impl/x86/memset.c"
+#   endif
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -238,6 +241,13 @@ tb_pointer_t tb_memset_(tb_pointer_t s, tb_byte_t c, tb_size_t n)
     // done
     return tb_memset_impl(s, c, n);
 }
+#ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+tb_pointer_t tb_memset_simd(tb_pointer_t s, tb_byte_t c, tb_size_t n)
+{
+    // done
+    return tb_memset_impl_simd(s, c, n);
+}
+#endif
 tb_pointer_t tb_memset(tb_pointer_t s, tb_byte_t c, tb_size_t n)
 {
     // check
@@ -26,5 +26,14 @@
  */
 #include "../prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// have the builtin simd implementation of the memory operations on x64? e.g. tb_memcpy_simd()
+#if defined(TB_ARCH_x64) && !defined(TB_WORDS_BIGENDIAN) && \
+        (defined(TB_COMPILER_IS_MSVC) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   define TB_LIBC_STRING_HAVE_x64_SIMD
+#endif
 
 #endif
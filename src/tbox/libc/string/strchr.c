@@ -26,6 +26,8 @@
 #include "string.h"
 #ifdef TB_CONFIG_LIBC_HAVE_STRCHR
 #   include <string.h>
+#else
+#   include "../impl/search.h"
 #endif
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -41,13 +43,10 @@ tb_char_t* tb_strchr(tb_char_t const* s, tb_char_t c)
 tb_char_t* tb_strchr(tb_char_t const* s, tb_char_t c)
 {
     tb_assert_and_check_return_val(s, tb_null);
-    while (*s)
-    {
-        if (*s == c) return (tb_char_t* )s;
-        s++;
 
-    }
-    return tb_null;
+    // find c or '\0'
+    tb_byte_t const* p = tb_libc_search_strchr((tb_byte_t const*)s, (tb_byte_t)c, 0);
+    return *p? (tb_char_t*)p : tb_null;
 }
 #endif
 
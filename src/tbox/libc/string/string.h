@@ -71,10 +71,26 @@ tb_pointer_t        tb_memmov_(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n);
 tb_long_t           tb_memcmp(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n);
 tb_long_t           tb_memcmp_(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n);
 
+#ifdef TB_LIBC_STRING_HAVE_x64_SIMD
+/* the builtin simd memory operations on x64, they are dispatched by the cpu features
+ *
+ * tb_memcpy() and the others use them only if the libc ones have not been detected,
+ * e.g. for the micro and freestanding builds.
+ */
+tb_pointer_t        tb_memcpy_simd(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n);
+tb_pointer_t        tb_memmov_simd(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n);
+tb_pointer_t        tb_memset_simd(tb_pointer_t s, tb_byte_t c, tb_size_t n);
+tb_long_t           tb_memcmp_simd(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n);
+#endif
+
 // memmem
 tb_pointer_t        tb_memmem(tb_cpointer_t s1, tb_size_t n1, tb_cpointer_t s2, tb_size_t n2);
 tb_pointer_t        tb_memmem_(tb_cpointer_t s1, tb_size_t n1, tb_cpointer_t s2, tb_size_t n2);
 
+// memchr
+tb_pointer_t        tb_memchr(tb_cpointer_t s, tb_byte_t c, tb_size_t n);
+tb_pointer_t        tb_memchr_(tb_cpointer_t s, tb_byte_t c, tb_size_t n);
+
 // strlen
 tb_size_t           tb_strlen(tb_char_t const* s);
 tb_size_t           tb_strnlen(tb_char_t const* s, tb_size_t n);
@@ -24,7 +24,8 @@
  * includes
  */
 #include "string.h"
-#ifdef TB_CONFIG_LIBC_HAVE_STRCASESTR
+#include "../impl/search.h"
+#if defined(TB_CONFIG_LIBC_HAVE_STRCASESTR) && !defined(TB_LIBC_SEARCH_SIMD_ENABLE)
 #   include <string.h>
 #endif
 
@@ -32,7 +33,8 @@
  * interfaces
  */
 
-#ifdef TB_CONFIG_LIBC_HAVE_STRCASESTR
+// the vectorized search is much faster than strcasestr of glibc, so we prefer it
+#if defined(TB_CONFIG_LIBC_HAVE_STRCASESTR) && !defined(TB_LIBC_SEARCH_SIMD_ENABLE)
 tb_char_t* tb_stristr(tb_char_t const* s1, tb_char_t const* s2)
 {
     // check
@@ -45,30 +47,7 @@ tb_char_t* tb_stristr(tb_char_t const* s1, tb_char_t const* s2)
     // check
     tb_assert_and_check_return_val(s1 && s2, tb_null);
 
-    // init
-    __tb_register__ tb_char_t const* s = s1;
-    __tb_register__ tb_char_t const* p = s2;
-
-    // done
-    do
-    {
-        if (!*p) return (tb_char_t* )s1;
-        if ((*p == *s)  || (tb_tolower(*((tb_byte_t*)p)) == tb_tolower(*((tb_byte_t*)s))))
-        {
-            ++p;
-            ++s;
-        }
-        else
-        {
-            p = s2;
-            if (!*s) return tb_null;
-            s = ++s1;
-        }
-
-    } while (1);
-
-    // no found
-    return tb_null;
+    // find it
+    return (tb_char_t*)tb_libc_search_str((tb_byte_t const*)s1, tb_strlen(s1), (tb_byte_t const*)s2, tb_strlen(s2), tb_true);
 }
 #endif
-
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 #include "../../memory/impl/prefix.h"
 #ifndef TB_CONFIG_LIBC_HAVE_STRLEN
 #   if defined(TB_ARCH_x86)
@@ -46,6 +47,15 @@ static tb_size_t tb_strlen_impl(tb_char_t const* s)
     tb_assert_and_check_return_val(s, 0);
     return strlen(s);
 }
+#elif !defined(TB_LIBC_STRING_IMPL_STRLEN) && defined(TB_LIBC_SEARCH_SIMD_ENABLE)
+static tb_size_t tb_strlen_impl(tb_char_t const* s)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+
+    // find '\0'
+    return tb_libc_search_strchr((tb_byte_t const*)s, 0, 0) - (tb_byte_t const*)s;
+}
 #elif !defined(TB_LIBC_STRING_IMPL_STRLEN)
 static tb_size_t tb_strlen_impl(tb_char_t const* s)
 {
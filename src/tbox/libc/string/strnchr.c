@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -34,13 +35,7 @@ tb_char_t* tb_strnchr(tb_char_t const* s, tb_size_t n, tb_char_t c)
     // check
     tb_assert_and_check_return_val(s, tb_null);
 
-    // find
-    tb_char_t const* e = s + n;
-    while (s < e && *s)
-    {
-        if (*s == c) return (tb_char_t* )s;
-        s++;
-
-    }
-    return tb_null;
+    // find c or '\0'
+    tb_byte_t const* p = tb_libc_search_chr((tb_byte_t const*)s, n, (tb_byte_t)c, 0, 0);
+    return (p && *p)? (tb_char_t*)p : tb_null;
 }
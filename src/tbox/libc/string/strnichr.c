@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -34,17 +35,8 @@ tb_char_t* tb_strnichr(tb_char_t const* s, tb_size_t n, tb_char_t c)
     // check
     tb_assert_and_check_return_val(s, tb_null);
 
-    // init
-    tb_byte_t const*    p = (tb_byte_t const*)s;
-    tb_byte_t const*    e = p + n;
-    tb_byte_t           b = tb_tolower((tb_byte_t)c);
-
-    // find
-    while (p < e && *p)
-    {
-        if (tb_tolower(*p) == b) return (tb_char_t*)p;
-        p++;
-
-    }
-    return tb_null;
+    // find the lower or upper case of c or '\0'
+    tb_byte_t           m = tb_libc_search_cmask(c);
+    tb_byte_t const*    p = tb_libc_search_chr((tb_byte_t const*)s, n, (tb_byte_t)c | m, 0, m);
+    return (p && *p)? (tb_char_t*)p : tb_null;
 }
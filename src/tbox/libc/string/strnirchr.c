@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -34,13 +35,11 @@ tb_char_t* tb_strnirchr(tb_char_t const* s, tb_size_t n, tb_char_t c)
     // check
     tb_assert_and_check_return_val(s, tb_null);
 
-    // done
-    tb_byte_t const*    p = (tb_byte_t const*)s + n - 1;
-    tb_byte_t           b = tb_tolower((tb_byte_t)c);
-    while (p >= (tb_byte_t const*)s && *p)
-    {
-        if (tb_tolower(*p) == b) return (tb_char_t*)p;
-        p--;
-    }
-    return tb_null;
+    // the string may be terminated before n
+    tb_byte_t const* e = tb_libc_search_chr((tb_byte_t const*)s, n, 0, 0, 0);
+    if (e) n = e - (tb_byte_t const*)s;
+
+    // find the lower or upper case of c from the end
+    tb_byte_t m = tb_libc_search_cmask(c);
+    return (tb_char_t*)tb_libc_search_rchr((tb_byte_t const*)s, n, (tb_byte_t)c | m, m);
 }
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 #include "../../memory/impl/prefix.h"
 #ifndef TB_CONFIG_LIBC_HAVE_STRNLEN
 #   if defined(TB_ARCH_x86)
@@ -56,6 +57,16 @@ static tb_size_t tb_strnlen_impl(tb_char_t const* s, tb_size_t n)
     return strnlen(s, n);
 #endif
 }
+#elif !defined(TB_LIBC_STRING_IMPL_STRNLEN) && defined(TB_LIBC_SEARCH_SIMD_ENABLE)
+static tb_size_t tb_strnlen_impl(tb_char_t const* s, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+
+    // find '\0'
+    tb_byte_t const* p = tb_libc_search_chr((tb_byte_t const*)s, n, 0, 0, 0);
+    return p? p - (tb_byte_t const*)s : n;
+}
 #elif !defined(TB_LIBC_STRING_IMPL_STRNLEN)
 static tb_size_t tb_strnlen_impl(tb_char_t const* s, tb_size_t n)
 {
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -33,12 +34,10 @@ tb_char_t* tb_strnrchr(tb_char_t const* s, tb_size_t n, tb_char_t c)
     // check
     tb_assert_and_check_return_val(s, tb_null);
 
-    // done
-    tb_char_t const* p = s + n - 1;
-    while (p >= s && *p)
-    {
-        if (*p == c) return (tb_char_t*)p;
-        p--;
-    }
-    return tb_null;
+    // the string may be terminated before n
+    tb_byte_t const* e = tb_libc_search_chr((tb_byte_t const*)s, n, 0, 0, 0);
+    if (e) n = e - (tb_byte_t const*)s;
+
+    // find it from the end
+    return (tb_char_t*)tb_libc_search_rchr((tb_byte_t const*)s, n, (tb_byte_t)c, 0);
 }
@@ -24,15 +24,20 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
-
 tb_char_t* tb_strnrstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2)
 {
-    tb_assert_and_check_return_val(s1, tb_null);
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+
+    // the string may be terminated before n1
+    tb_byte_t const* e = tb_libc_search_chr((tb_byte_t const*)s1, n1, 0, 0, 0);
+    if (e) n1 = e - (tb_byte_t const*)s1;
 
-    tb_trace_noimpl();
-    return tb_null;
+    // find the last s2
+    return (tb_char_t*)tb_libc_search_rstr((tb_byte_t const*)s1, n1, (tb_byte_t const*)s2, tb_strlen(s2), tb_false);
 }
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "../impl/search.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -33,32 +34,10 @@ tb_char_t* tb_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2)
     // check
     tb_assert_and_check_return_val(s1 && s2 && n1, tb_null);
 
-    // init
-    __tb_register__ tb_char_t const*    s = s1;
-    __tb_register__ tb_char_t const*    p = s2;
-    __tb_register__ tb_size_t           n = n1;
+    // the string may be terminated before n1
+    tb_byte_t const* e = tb_libc_search_chr((tb_byte_t const*)s1, n1, 0, 0, 0);
+    if (e) n1 = e - (tb_byte_t const*)s1;
 
-    // done
-    do
-    {
-        if (!*p) return (tb_char_t *)s1;
-        if (n && *p == *s)
-        {
-            ++p;
-            ++s;
-            --n;
-        }
-        else
-        {
-            p = s2;
-            if (!*s || !n) return tb_null;
-            s = ++s1;
-            n = --n1;
-        }
-
-    } while (1);
-
-    // no found
-    return tb_null;
+    // find the first s2
+    return (tb_char_t*)tb_libc_search_str((tb_byte_t const*)s1, n1, (tb_byte_t const*)s2, tb_strlen(s2), tb_false);
 }
-
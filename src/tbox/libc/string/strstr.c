@@ -26,6 +26,8 @@
 #include "string.h"
 #ifdef TB_CONFIG_LIBC_HAVE_STRSTR
 #   include <string.h>
+#else
+#   include "../impl/search.h"
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -44,29 +46,7 @@ tb_char_t* tb_strstr(tb_char_t const* s1, tb_char_t const* s2)
     // check
     tb_assert_and_check_return_val(s1 && s2, tb_null);
 
-    // init
-    __tb_register__ tb_char_t const* s = s1;
-    __tb_register__ tb_char_t const* p = s2;
-
-    // done
-    do
-    {
-        if (!*p) return (tb_char_t *)s1;
-        if (*p == *s)
-        {
-            ++p;
-            ++s;
-        }
-        else
-        {
-            p = s2;
-            if (!*s) return tb_null;
-            s = ++s1;
-        }
-
-    } while (1);
-
-    // no found
-    return tb_null;
+    // find it
+    return (tb_char_t*)tb_libc_search_str((tb_byte_t const*)s1, tb_strlen(s1), (tb_byte_t const*)s2, tb_strlen(s2), tb_false);
 }
 #endif
@@ -42,12 +42,61 @@
 // the allocator
 __tb_extern_c__ tb_allocator_ref_t  g_allocator = tb_null;
 
+// the scoped allocator of the current thread
+#ifdef __tb_thread_local__
+static __tb_thread_local__ tb_allocator_ref_t   g_allocator_scoped = tb_null;
+#else
+static tb_thread_local_t                        g_allocator_scoped = TB_THREAD_LOCAL_INIT;
+#endif
+
+// the entered scopes count of all threads, we need not get the scoped allocator from the thread local storage if it's zero
+static tb_atomic32_t                            g_allocator_scopes = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 tb_allocator_ref_t tb_allocator()
 {
-    return g_allocator;
+    // no scoped allocators? it's the common case
+    if (!tb_atomic32_get_explicit(&g_allocator_scopes, TB_ATOMIC_RELAXED)) return g_allocator;
+
+    // uses the scoped allocator first
+#ifdef __tb_thread_local__
+    tb_allocator_ref_t allocator = g_allocator_scoped;
+#else
+    tb_allocator_ref_t allocator = (tb_allocator_ref_t)tb_thread_local_get(&g_allocator_scoped);
+#endif
+    return allocator? allocator : g_allocator;
+}
+tb_allocator_ref_t tb_allocator_scope_enter(tb_allocator_ref_t allocator)
+{
+    // enter it, the current thread will see it in tb_allocator() because the scopes count is increased first
+    tb_atomic32_fetch_and_add(&g_allocator_scopes, 1);
+#ifdef __tb_thread_local__
+    tb_allocator_ref_t previous = g_allocator_scoped;
+    g_allocator_scoped = allocator;
+#else
+    tb_allocator_ref_t previous = tb_null;
+    if (tb_thread_local_init(&g_allocator_scoped, tb_null))
+    {
+        previous = (tb_allocator_ref_t)tb_thread_local_get(&g_allocator_scoped);
+        tb_thread_local_set(&g_allocator_scoped, allocator);
+    }
+#endif
+    return previous;
+}
+tb_void_t tb_allocator_scope_leave(tb_allocator_ref_t previous)
+{
+    // restore the previous scoped allocator
+#ifdef __tb_thread_local__
+    g_allocator_scoped = previous;
+#else
+    if (tb_thread_local_init(&g_allocator_scoped, tb_null))
+        tb_thread_local_set(&g_allocator_scoped, previous);
+#endif
+
+    // leave it
+    tb_atomic32_fetch_and_sub(&g_allocator_scopes, 1);
 }
 tb_size_t tb_allocator_type(tb_allocator_ref_t allocator)
 {
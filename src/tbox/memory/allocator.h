@@ -77,6 +77,7 @@ typedef enum __tb_allocator_type_e
 ,   TB_ALLOCATOR_TYPE_STATIC     = 4
 ,   TB_ALLOCATOR_TYPE_LARGE      = 5
 ,   TB_ALLOCATOR_TYPE_SMALL      = 6
+,   TB_ALLOCATOR_TYPE_ARENA      = 7
 
 }tb_allocator_type_e;
 
@@ -199,6 +200,29 @@ typedef struct __tb_allocator_t
  */
 tb_allocator_ref_t      tb_allocator(tb_noarg_t);
 
+/*! enter the scoped allocator of the current thread
+ *
+ * tb_malloc(), tb_free() and all containers will use this allocator on the current thread until leaving it,
+ * e.g. we can parse and discard a lot of objects with the arena allocator.
+ *
+ * the lazily created singletons (tb_singleton_instance) are always allocated from the global allocator,
+ * but the other data cached for the process or thread lifetime, e.g. by a static pointer in the user code,
+ * will be discarded with the arena if it's first created in this scope, so we need create it before entering.
+ *
+ * @note the data allocated in this scope cannot be freed by the global allocator after leaving it
+ *
+ * @param allocator     the scoped allocator, uses the global allocator in this scope if be null
+ *
+ * @return              the previous scoped allocator, it may be null
+ */
+tb_allocator_ref_t      tb_allocator_scope_enter(tb_allocator_ref_t allocator);
+
+/*! leave the scoped allocator of the current thread
+ *
+ * @param previous      the previous scoped allocator returned by tb_allocator_scope_enter()
+ */
+tb_void_t               tb_allocator_scope_leave(tb_allocator_ref_t previous);
+
 /*! the native allocator
  *
  * uses system memory directly
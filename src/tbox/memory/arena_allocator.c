@@ -0,0 +1,452 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena_allocator.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "arena_allocator"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena_allocator.h"
+#include "impl/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default chunk size
+#ifdef __tb_small__
+#   define TB_ARENA_ALLOCATOR_CHUNK_SIZE        (8192)
+#else
+#   define TB_ARENA_ALLOCATOR_CHUNK_SIZE        (65536)
+#endif
+
+// the data space with the data head
+#define tb_arena_allocator_data_space(size)     (sizeof(tb_pool_data_head_t) + tb_align((size), TB_POOL_DATA_ALIGN))
+
+// the chunk data
+#define tb_arena_allocator_chunk_data(chunk)    ((tb_byte_t*)&(chunk)[1])
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the arena allocator chunk type
+typedef struct __tb_arena_allocator_chunk_t
+{
+    // the next chunk
+    struct __tb_arena_allocator_chunk_t*    next;
+
+    // the data size
+    tb_size_t                               size;
+
+    // the used size
+    tb_size_t                               used;
+
+}tb_arena_allocator_chunk_t;
+
+// the arena allocator type
+typedef struct __tb_arena_allocator_t
+{
+    // the base
+    tb_allocator_t                  base;
+
+    // the backing allocator
+    tb_allocator_ref_t              allocator;
+
+    // the chunk size
+    tb_size_t                       chunk_size;
+
+    // the used chunks, the first chunk is the current chunk
+    tb_arena_allocator_chunk_t*     chunks;
+
+    // the spare chunks
+    tb_arena_allocator_chunk_t*     spares;
+
+    // the last data, it can be freed or grown in place
+    tb_pointer_t                    last;
+
+#ifdef __tb_debug__
+    // the peak size
+    tb_size_t                       peak_size;
+
+    // the malloc count
+    tb_size_t                       malloc_count;
+
+    // the chunk count
+    tb_size_t                       chunk_count;
+#endif
+
+}tb_arena_allocator_t, *tb_arena_allocator_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_arena_allocator_chunk_t* tb_arena_allocator_chunk_find(tb_arena_allocator_ref_t allocator, tb_cpointer_t data)
+{
+    // check
+    tb_assert(allocator);
+
+    // find the used chunk of this data, the current chunk will be found first in most cases
+    tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+    while (chunk)
+    {
+        tb_byte_t const* head = tb_arena_allocator_chunk_data(chunk);
+        if ((tb_byte_t const*)data > head && (tb_byte_t const*)data < head + chunk->used) break;
+        chunk = chunk->next;
+    }
+    return chunk;
+}
+static tb_arena_allocator_chunk_t* tb_arena_allocator_chunk_make(tb_arena_allocator_ref_t allocator, tb_size_t space __tb_debug_decl__)
+{
+    // check
+    tb_assert(allocator && allocator->allocator && space);
+
+    // get a spare chunk if it's large enough
+    tb_arena_allocator_chunk_t* chunk = allocator->spares;
+    if (chunk && chunk->size >= space) allocator->spares = chunk->next;
+    else
+    {
+        // make a new chunk
+        tb_size_t real = 0;
+        tb_size_t need = sizeof(tb_arena_allocator_chunk_t) + tb_max(space, allocator->chunk_size);
+        chunk = (tb_arena_allocator_chunk_t*)tb_allocator_large_malloc_(allocator->allocator, need, &real __tb_debug_args__);
+        tb_assert_and_check_return_val(chunk && real >= need, tb_null);
+
+        // init it
+        chunk->size = real - sizeof(tb_arena_allocator_chunk_t);
+
+#ifdef __tb_debug__
+        // update the chunk count
+        allocator->chunk_count++;
+#endif
+    }
+
+#ifdef __tb_debug__
+    // update the peak size
+    tb_size_t used = tb_arena_allocator_size((tb_allocator_ref_t)allocator);
+    if (used > allocator->peak_size) allocator->peak_size = used;
+#endif
+
+    // use it as the current chunk
+    chunk->used         = 0;
+    chunk->next         = allocator->chunks;
+    allocator->chunks   = chunk;
+    return chunk;
+}
+static tb_void_t tb_arena_allocator_chunk_free(tb_arena_allocator_ref_t allocator, tb_arena_allocator_chunk_t* chunk)
+{
+    // check
+    tb_assert(allocator && chunk);
+
+    // reserve it if it's not too large
+    if (chunk->size < (allocator->chunk_size << 1))
+    {
+        chunk->next         = allocator->spares;
+        allocator->spares   = chunk;
+    }
+    else
+    {
+        // free it
+        tb_allocator_large_free(allocator->allocator, chunk);
+
+#ifdef __tb_debug__
+        // update the chunk count
+        allocator->chunk_count--;
+#endif
+    }
+}
+static tb_pointer_t tb_arena_allocator_malloc(tb_allocator_ref_t self, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && size, tb_null);
+
+    // no enough space in the current chunk? make a new chunk
+    tb_size_t                   space = tb_arena_allocator_data_space(size);
+    tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+    if (!chunk || chunk->used + space > chunk->size)
+    {
+        chunk = tb_arena_allocator_chunk_make(allocator, space __tb_debug_args__);
+        tb_assert_and_check_return_val(chunk, tb_null);
+    }
+
+    // bump it
+    tb_pool_data_head_t* data_head = (tb_pool_data_head_t*)(tb_arena_allocator_chunk_data(chunk) + chunk->used);
+    chunk->used += space;
+
+    // init the data head
+    data_head->size = size;
+#ifdef __tb_debug__
+    data_head->debug.magic  = TB_POOL_DATA_MAGIC;
+    data_head->debug.file   = file_;
+    data_head->debug.func   = func_;
+    data_head->debug.line   = (tb_uint16_t)line_;
+    data_head->debug.backtrace[0] = tb_null;
+
+    // update the malloc count
+    allocator->malloc_count++;
+#endif
+
+    // save the last data
+    allocator->last = (tb_pointer_t)&data_head[1];
+    return allocator->last;
+}
+static tb_pointer_t tb_arena_allocator_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && data && size, tb_null);
+
+    // the data is allocated from the other allocator? ralloc it from the backing allocator
+    tb_arena_allocator_chunk_t* chunk = tb_arena_allocator_chunk_find(allocator, data);
+    if (!chunk) return tb_allocator_ralloc_(allocator->allocator, data, size __tb_debug_args__);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "ralloc invalid data: %p", data);
+
+    // grow or shrink the last data in place if there is enough space
+    tb_size_t size_old = data_head->size;
+    if (data == allocator->last)
+    {
+        tb_size_t used = chunk->used - tb_arena_allocator_data_space(size_old) + tb_arena_allocator_data_space(size);
+        if (used <= chunk->size)
+        {
+            chunk->used     = used;
+            data_head->size = size;
+            return data;
+        }
+    }
+    // shrink it in place
+    else if (size <= size_old)
+    {
+        data_head->size = size;
+        return data;
+    }
+
+    // make a new data
+    tb_pointer_t data_new = tb_arena_allocator_malloc(self, size __tb_debug_args__);
+    tb_assert_and_check_return_val(data_new, tb_null);
+
+    // copy the old data, the old data will be discarded when resetting
+    tb_memcpy_(data_new, data, tb_min(size_old, size));
+    return data_new;
+}
+static tb_bool_t tb_arena_allocator_free(tb_allocator_ref_t self, tb_pointer_t data __tb_debug_decl__)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && data, tb_false);
+
+    // the last data? reclaim it
+    if (data == allocator->last)
+    {
+        tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+        allocator->chunks->used -= tb_arena_allocator_data_space(data_head->size);
+        allocator->last = tb_null;
+        return tb_true;
+    }
+
+    // the data is allocated from the other allocator? free it to the backing allocator
+    if (!tb_arena_allocator_chunk_find(allocator, data))
+        return tb_allocator_free_(allocator->allocator, data __tb_debug_args__);
+
+    // it will be reclaimed when resetting
+    return tb_true;
+}
+static tb_void_t tb_arena_allocator_clear(tb_allocator_ref_t self)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // free all used chunks
+    while (allocator->chunks)
+    {
+        tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+        allocator->chunks = chunk->next;
+        tb_arena_allocator_chunk_free(allocator, chunk);
+    }
+    allocator->last = tb_null;
+}
+static tb_void_t tb_arena_allocator_exit(tb_allocator_ref_t self)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->allocator);
+
+    // clear it first
+    tb_arena_allocator_clear(self);
+
+    // free all spare chunks
+    while (allocator->spares)
+    {
+        tb_arena_allocator_chunk_t* chunk = allocator->spares;
+        allocator->spares = chunk->next;
+        tb_allocator_large_free(allocator->allocator, chunk);
+    }
+
+    // exit lock
+    tb_spinlock_exit(&allocator->base.lock);
+
+    // exit it
+    tb_allocator_free(allocator->allocator, allocator);
+}
+#ifdef __tb_debug__
+static tb_void_t tb_arena_allocator_dump(tb_allocator_ref_t self)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("used_size: %lu", tb_arena_allocator_size(self));
+    tb_trace_i("peak_size: %lu", allocator->peak_size);
+    tb_trace_i("chunk_size: %lu", allocator->chunk_size);
+    tb_trace_i("chunk_count: %lu", allocator->chunk_count);
+    tb_trace_i("malloc_count: %lu", allocator->malloc_count);
+}
+static tb_bool_t tb_arena_allocator_have(tb_allocator_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator, tb_false);
+
+    // have it?
+    return tb_arena_allocator_chunk_find(allocator, data) != tb_null;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_allocator_ref_t tb_arena_allocator_init(tb_allocator_ref_t backing, tb_size_t chunk_size)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_arena_allocator_ref_t    allocator = tb_null;
+    do
+    {
+        // no allocator? uses the global allocator
+        if (!backing) backing = tb_allocator();
+        tb_assert_and_check_break(backing);
+
+        // make allocator
+        allocator = (tb_arena_allocator_ref_t)tb_allocator_malloc0(backing, sizeof(tb_arena_allocator_t));
+        tb_assert_and_check_break(allocator);
+
+        // init allocator
+        allocator->allocator            = backing;
+        allocator->chunk_size           = chunk_size? chunk_size : TB_ARENA_ALLOCATOR_CHUNK_SIZE;
+
+        // init base, it's not thread-safe
+        allocator->base.type            = TB_ALLOCATOR_TYPE_ARENA;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
+        allocator->base.malloc          = tb_arena_allocator_malloc;
+        allocator->base.ralloc          = tb_arena_allocator_ralloc;
+        allocator->base.free            = tb_arena_allocator_free;
+        allocator->base.clear           = tb_arena_allocator_clear;
+        allocator->base.exit            = tb_arena_allocator_exit;
+#ifdef __tb_debug__
+        allocator->base.dump            = tb_arena_allocator_dump;
+        allocator->base.have            = tb_arena_allocator_have;
+#endif
+
+        // init lock
+        if (!tb_spinlock_init(&allocator->base.lock)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (allocator) tb_arena_allocator_exit((tb_allocator_ref_t)allocator);
+        allocator = tb_null;
+    }
+
+    // ok?
+    return (tb_allocator_ref_t)allocator;
+}
+tb_void_t tb_arena_allocator_reset(tb_allocator_ref_t self)
+{
+    // check
+    tb_assert_and_check_return(self && self->type == TB_ALLOCATOR_TYPE_ARENA);
+
+    // clear it
+    tb_arena_allocator_clear(self);
+}
+tb_void_t tb_arena_allocator_save(tb_allocator_ref_t self, tb_arena_allocator_savepoint_ref_t savepoint)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->base.type == TB_ALLOCATOR_TYPE_ARENA && savepoint);
+
+    // save the current position
+    savepoint->chunk    = allocator->chunks;
+    savepoint->used     = allocator->chunks? allocator->chunks->used : 0;
+
+    // the last data cannot be freed or grown in place after saving, otherwise it will cross the savepoint
+    allocator->last     = tb_null;
+}
+tb_void_t tb_arena_allocator_rewind(tb_allocator_ref_t self, tb_arena_allocator_savepoint_ref_t savepoint)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->base.type == TB_ALLOCATOR_TYPE_ARENA && savepoint);
+
+    // free all chunks after the savepoint
+    while (allocator->chunks && (tb_cpointer_t)allocator->chunks != savepoint->chunk)
+    {
+        tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+        allocator->chunks = chunk->next;
+        tb_arena_allocator_chunk_free(allocator, chunk);
+    }
+
+    /* restore the used size of the current chunk
+     *
+     * the used size may be less than the savepoint if this chunk has been reset and reused,
+     * all data have been discarded after the savepoint in this case
+     */
+    if (allocator->chunks && savepoint->used < allocator->chunks->used)
+        allocator->chunks->used = savepoint->used;
+    allocator->last = tb_null;
+}
+tb_size_t tb_arena_allocator_size(tb_allocator_ref_t self)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->base.type == TB_ALLOCATOR_TYPE_ARENA, 0);
+
+    // compute the used size of all chunks
+    tb_size_t                   size = 0;
+    tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+    for (; chunk; chunk = chunk->next) size += chunk->used;
+    return size;
+}
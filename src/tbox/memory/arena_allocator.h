@@ -0,0 +1,147 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena_allocator.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_ARENA_ALLOCATOR_H
+#define TB_MEMORY_ARENA_ALLOCATOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the arena allocator savepoint type
+typedef struct __tb_arena_allocator_savepoint_t
+{
+    /// the current chunk
+    tb_cpointer_t           chunk;
+
+    /// the used size of the current chunk
+    tb_size_t               used;
+
+}tb_arena_allocator_savepoint_t, *tb_arena_allocator_savepoint_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the arena allocator
+ *
+ * all data are bump-allocated from the chunks and will be freed at once by reset or rewind.
+ *
+ * <pre>
+ *
+ *  -------------------------------      -------------------------------
+ * | chunk: |data|data|...|  free  | <- | chunk: |data|data|data|...|   | <- ...
+ *  -------------------------------      -------------------------------
+ *                         |
+ *                        bump
+ *
+ * </pre>
+ *
+ * - free: only the last data will be reclaimed, the others will be reclaimed by reset or rewind
+ * - ralloc: the last data will be grown in place if there is enough space in the current chunk
+ * - the data allocated from the other allocator will be freed to the backing allocator
+ *
+ * we can also enter it as the scoped allocator of the current thread,
+ * and the tb_vector, tb_string, object and xml readers will allocate memory from it, e.g.
+ *
+ * @code
+ *
+    // init arena allocator
+    tb_allocator_ref_t arena = tb_arena_allocator_init(tb_null, 0);
+    if (arena)
+    {
+        // enter it
+        tb_allocator_ref_t previous = tb_allocator_scope_enter(arena);
+
+        // parse and discard a lot of objects
+        tb_object_ref_t object = tb_object_read_from_data(data, size);
+        if (object)
+        {
+            // ...
+        }
+
+        // leave it and discard all data at once, we need not exit the object
+        tb_allocator_scope_leave(previous);
+        tb_arena_allocator_reset(arena);
+
+        // exit arena allocator
+        tb_allocator_exit(arena);
+    }
+ * @endcode
+ *
+ * @note it is not thread-safe
+ *
+ * @param backing       the backing allocator for the chunks, uses the global allocator if be null
+ * @param chunk_size    the chunk size, uses the default size if be zero
+ *
+ * @return              the allocator
+ */
+tb_allocator_ref_t      tb_arena_allocator_init(tb_allocator_ref_t backing, tb_size_t chunk_size);
+
+/*! reset the arena allocator to empty, all allocated data will be discarded
+ *
+ * the chunks will be reserved for the next allocation, it's the same as tb_allocator_clear()
+ *
+ * @param allocator     the arena allocator
+ */
+tb_void_t               tb_arena_allocator_reset(tb_allocator_ref_t allocator);
+
+/*! save the current position of the arena allocator
+ *
+ * @param allocator     the arena allocator
+ * @param savepoint     the savepoint
+ */
+tb_void_t               tb_arena_allocator_save(tb_allocator_ref_t allocator, tb_arena_allocator_savepoint_ref_t savepoint);
+
+/*! rewind the arena allocator to the given savepoint
+ *
+ * all data allocated after this savepoint will be discarded
+ *
+ * @param allocator     the arena allocator
+ * @param savepoint     the savepoint
+ */
+tb_void_t               tb_arena_allocator_rewind(tb_allocator_ref_t allocator, tb_arena_allocator_savepoint_ref_t savepoint);
+
+/*! the used size of the arena allocator
+ *
+ * @param allocator     the arena allocator
+ *
+ * @return              the used size of all chunks
+ */
+tb_size_t               tb_arena_allocator_size(tb_allocator_ref_t allocator);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
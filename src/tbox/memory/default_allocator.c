@@ -53,6 +53,11 @@ typedef struct __tb_default_allocator_t
 
 }tb_default_allocator_t, *tb_default_allocator_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c__ tb_allocator_ref_t tb_small_allocator_init_(tb_allocator_ref_t large_allocator, tb_bool_t tcache);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -302,6 +307,10 @@ tb_allocator_ref_t tb_default_allocator(tb_byte_t* data, tb_size_t size)
     return (tb_allocator_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_DEFAULT_ALLOCATOR, tb_default_allocator_instance_init, tb_default_allocator_instance_exit, tb_null, tuple);
 }
 tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
+{
+    return tb_default_allocator_init_with_mode(large_allocator, TB_DEFAULT_ALLOCATOR_MODE_NORMAL);
+}
+tb_allocator_ref_t tb_default_allocator_init_with_mode(tb_allocator_ref_t large_allocator, tb_size_t mode)
 {
     // check
     tb_assert_and_check_return_val(large_allocator, tb_null);
@@ -332,9 +341,14 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init allocator
         allocator->large_allocator = large_allocator;
-        allocator->small_allocator = tb_small_allocator_init(large_allocator);
+        allocator->small_allocator = tb_small_allocator_init_(large_allocator, mode == TB_DEFAULT_ALLOCATOR_MODE_TCACHE);
         tb_assert_and_check_break(allocator->small_allocator);
 
+        /* the small and large allocators have their own locks,
+         * so we need not the global lock for the tcache mode
+         */
+        if (mode == TB_DEFAULT_ALLOCATOR_MODE_TCACHE) allocator->base.flag = TB_ALLOCATOR_FLAG_NOLOCK;
+
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
         tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&allocator->base.lock, TB_TRACE_MODULE_NAME);
@@ -34,6 +34,18 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the default allocator mode enum
+typedef enum __tb_default_allocator_mode_e
+{
+    TB_DEFAULT_ALLOCATOR_MODE_NORMAL    = 0     //!< all allocations are serialized by the allocator lock
+,   TB_DEFAULT_ALLOCATOR_MODE_TCACHE    = 1     //!< the small allocations use the per-thread caches without the global lock
+
+}tb_default_allocator_mode_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -79,6 +91,30 @@ tb_allocator_ref_t          tb_default_allocator(tb_byte_t* data, tb_size_t size
  */
 tb_allocator_ref_t          tb_default_allocator_init(tb_allocator_ref_t large_allocator);
 
+/*! init the default allocator with the given mode
+ *
+ * the tcache mode is more scalable for the multi-threaded workloads with many small allocations.
+ *
+ * - each thread has a magazine of the free items for each size class of the small allocator (<=3KB)
+ * - the magazine is refilled/flushed in batches from/to the shared fixed pools with the lock
+ * - the data freed by the other thread is cached in the current thread directly, they belong to the shared pools
+ * - the cached items will be flushed when the tbox thread exits, so the other threads may keep a few cached items
+ * - the large allocations (>3KB) still use the large allocator with its lock
+ *
+ * @code
+ *
+    // init tbox with the tcache mode
+    tb_init(tb_null, tb_default_allocator_init_with_mode(tb_large_allocator_init(tb_null, 0), TB_DEFAULT_ALLOCATOR_MODE_TCACHE));
+ *
+ * @endcode
+ *
+ * @param large_allocator   the large allocator, cannot be null
+ * @param mode              the allocator mode, e.g. TB_DEFAULT_ALLOCATOR_MODE_TCACHE
+ *
+ * @return                  the allocator
+ */
+tb_allocator_ref_t          tb_default_allocator_init_with_mode(tb_allocator_ref_t large_allocator, tb_size_t mode);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -29,6 +29,7 @@
 #include "buffer.h"
 #include "allocator.h"
 #include "fixed_pool.h"
+#include "arena_allocator.h"
 #include "string_pool.h"
 #include "queue_buffer.h"
 #include "static_buffer.h"
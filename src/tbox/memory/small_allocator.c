@@ -33,11 +33,63 @@
 #include "large_allocator.h"
 #include "fixed_pool.h"
 #include "impl/prefix.h"
+#include "../container/list_entry.h"
+#include "../platform/spinlock.h"
+#include "../platform/thread_local.h"
+#include "../platform/native_memory.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the fixed pool count
+#define TB_SMALL_ALLOCATOR_FIXED_MAXN       (12)
+
+// the items maximum count of the thread cache for each fixed pool
+#ifdef __tb_small__
+#   define TB_SMALL_ALLOCATOR_TCACHE_MAXN   (16)
+#else
+#   define TB_SMALL_ALLOCATOR_TCACHE_MAXN   (64)
+#endif
+
+// the items maximum space of the thread cache for each fixed pool
+#ifdef __tb_small__
+#   define TB_SMALL_ALLOCATOR_TCACHE_SPACE  (8192)
+#else
+#   define TB_SMALL_ALLOCATOR_TCACHE_SPACE  (32768)
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+/* the thread cache type
+ *
+ * each thread has a magazine of the free items for each fixed pool,
+ * we refill/flush it in batches from/to the shared fixed pool with the allocator lock.
+ *
+ * the items belong to the shared fixed pools instead of the threads,
+ * so the item freed by the other thread can be cached in the current thread directly.
+ */
+typedef struct __tb_small_allocator_tcache_t
+{
+    // the list entry
+    tb_list_entry_t                     entry;
+
+    // the attached allocator, it will be detached if the allocator has been exited
+    struct __tb_small_allocator_t*      allocator;
+
+    // is dead? the owner thread is exiting
+    tb_bool_t                           is_dead;
+
+    // the cached items count
+    tb_uint16_t                         count[TB_SMALL_ALLOCATOR_FIXED_MAXN];
+
+    // the cached items
+    tb_pointer_t                        items[TB_SMALL_ALLOCATOR_FIXED_MAXN][TB_SMALL_ALLOCATOR_TCACHE_MAXN];
+
+}tb_small_allocator_tcache_t;
+
 // the small allocator type
 typedef struct __tb_small_allocator_t
 {
@@ -48,105 +100,135 @@ typedef struct __tb_small_allocator_t
     tb_allocator_ref_t      large_allocator;
 
     // the fixed pool
-    tb_fixed_pool_ref_t     fixed_pool[12];
+    tb_fixed_pool_ref_t     fixed_pool[TB_SMALL_ALLOCATOR_FIXED_MAXN];
+
+    // the attached thread caches
+    tb_list_entry_head_t    tcaches;
+
+    // enable the thread caches?
+    tb_bool_t               tcache;
 
 }tb_small_allocator_t, *tb_small_allocator_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the thread cache of the current thread
+static tb_thread_local_t    g_tcache_local = TB_THREAD_LOCAL_INIT;
+
+// the lock of attaching or detaching the thread caches
+static tb_spinlock_t        g_tcache_lock = TB_SPINLOCK_INIT;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
+__tb_extern_c__ tb_allocator_ref_t tb_small_allocator_init_(tb_allocator_ref_t large_allocator, tb_bool_t tcache);
 __tb_extern_c__ tb_fixed_pool_ref_t tb_fixed_pool_init_(tb_allocator_ref_t large_allocator, tb_size_t slot_size, tb_size_t item_size, tb_bool_t for_small_allocator, tb_fixed_pool_item_init_func_t item_init, tb_fixed_pool_item_exit_func_t item_exit, tb_cpointer_t priv);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_t allocator, tb_size_t size)
+static tb_size_t tb_small_allocator_find_index(tb_size_t size, tb_size_t* pspace)
 {
     // check
-    tb_assert(allocator && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+    tb_assert(size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN && pspace);
 
-    // done
-    tb_fixed_pool_ref_t fixed_pool = tb_null;
-    do
+    // the fixed pool index
+    tb_size_t index = 0;
+    tb_size_t space = 0;
+    if (size > 64 && size < 193)
     {
-        // the fixed pool index
-        tb_size_t index = 0;
-        tb_size_t space = 0;
-        if (size > 64 && size < 193)
+        if (size < 97)
+        {
+            index = 3;
+            space = 96;
+        }
+        else if (size > 128)
+        {
+            index = 5;
+            space = 192;
+        }
+        else
+        {
+            index = 4;
+            space = 128;
+        }
+    }
+    else if (size > 192 && size < 513)
+    {
+        if (size < 257)
+        {
+            index = 6;
+            space = 256;
+        }
+        else if (size > 384)
         {
-            if (size < 97)
-            {
-                index = 3;
-                space = 96;
-            }
-            else if (size > 128)
-            {
-                index = 5;
-                space = 192;
-            }
-            else
-            {
-                index = 4;
-                space = 128;
-            }
+            index = 8;
+            space = 512;
         }
-        else if (size > 192 && size < 513)
+        else
+        {
+            index = 7;
+            space = 384;
+        }
+    }
+    else if (size < 65)
+    {
+        if (size < 17)
+        {
+            index = 0;
+            space = 16;
+        }
+        else if (size > 32)
+        {
+            index = 2;
+            space = 64;
+        }
+        else
+        {
+            index = 1;
+            space = 32;
+        }
+    }
+    else
+    {
+        if (size < 1025)
         {
-            if (size < 257)
-            {
-                index = 6;
-                space = 256;
-            }
-            else if (size > 384)
-            {
-                index = 8;
-                space = 512;
-            }
-            else
-            {
-                index = 7;
-                space = 384;
-            }
+            index = 9;
+            space = 1024;
         }
-        else if (size < 65)
+        else if (size > 2048)
         {
-            if (size < 17)
-            {
-                index = 0;
-                space = 16;
-            }
-            else if (size > 32)
-            {
-                index = 2;
-                space = 64;
-            }
-            else
-            {
-                index = 1;
-                space = 32;
-            }
+            index = 11;
+            space = 3072;
         }
         else
         {
-            if (size < 1025)
-            {
-                index = 9;
-                space = 1024;
-            }
-            else if (size > 2048)
-            {
-                index = 11;
-                space = 3072;
-            }
-            else
-            {
-                index = 10;
-                space = 2048;
-            }
+            index = 10;
+            space = 2048;
         }
+    }
+
+    // trace
+    tb_trace_d("find: size: %lu => index: %lu, space: %lu", size, index, space);
+
+    // ok
+    *pspace = space;
+    return index;
+}
+static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_t allocator, tb_size_t size)
+{
+    // check
+    tb_assert(allocator && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
 
-        // trace
-        tb_trace_d("find: size: %lu => index: %lu, space: %lu", size, index, space);
+    // done
+    tb_fixed_pool_ref_t fixed_pool = tb_null;
+    do
+    {
+        // the fixed pool index
+        tb_size_t space = 0;
+        tb_size_t index = tb_small_allocator_find_index(size, &space);
 
         // make fixed pool if not exists
         if (!allocator->fixed_pool[index]) allocator->fixed_pool[index] = tb_fixed_pool_init_(allocator->large_allocator, 0, space, tb_true, tb_null, tb_null, tb_null);
@@ -414,10 +496,374 @@ static tb_void_t tb_small_allocator_dump(tb_allocator_ref_t self)
 }
 #endif
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * thread cache implementation
+ */
+
+// the dead thread cache, the current thread has been exited
+#define TB_SMALL_ALLOCATOR_TCACHE_DEAD          ((tb_small_allocator_tcache_t*)(tb_size_t)1)
+
+static __tb_inline__ tb_size_t tb_small_allocator_tcache_maxn(tb_size_t space)
+{
+    // the larger items will be cached less
+    tb_size_t maxn = TB_SMALL_ALLOCATOR_TCACHE_SPACE / space;
+    return tb_max(tb_min(maxn, TB_SMALL_ALLOCATOR_TCACHE_MAXN), 4);
+}
+static tb_void_t tb_small_allocator_tcache_flush(tb_small_allocator_ref_t allocator, tb_small_allocator_tcache_t* tcache, tb_size_t index, tb_size_t keep __tb_debug_decl__)
+{
+    // check, we need hold the allocator lock
+    tb_assert(allocator && tcache && index < TB_SMALL_ALLOCATOR_FIXED_MAXN && keep <= tcache->count[index]);
+
+    // the fixed pool, it must exist if there are cached items
+    tb_fixed_pool_ref_t fixed_pool = allocator->fixed_pool[index];
+    tb_assert_and_check_return(fixed_pool);
+
+    // free the oldest items to the fixed pool
+    tb_size_t       i = 0;
+    tb_size_t       n = tcache->count[index] - keep;
+    tb_pointer_t*   items = tcache->items[index];
+    for (i = 0; i < n; i++) tb_fixed_pool_free_(fixed_pool, items[i] __tb_debug_args__);
+
+    // move the recent items to the bottom
+    if (n && keep) tb_memmov_(items, items + n, keep * sizeof(tb_pointer_t));
+    tcache->count[index] = (tb_uint16_t)keep;
+}
+static tb_bool_t tb_small_allocator_tcache_refill(tb_small_allocator_ref_t allocator, tb_small_allocator_tcache_t* tcache, tb_size_t size __tb_debug_decl__)
+{
+    // check, we need hold the allocator lock
+    tb_assert(allocator && tcache && size);
+
+    // the fixed pool
+    tb_fixed_pool_ref_t fixed_pool = tb_small_allocator_find_fixed(allocator, size);
+    tb_assert_and_check_return_val(fixed_pool, tb_false);
+
+    // the fixed pool index
+    tb_size_t space = 0;
+    tb_size_t index = tb_small_allocator_find_index(size, &space);
+
+    // refill the half of the thread cache
+    tb_size_t       n = tb_small_allocator_tcache_maxn(space) >> 1;
+    tb_size_t       count = tcache->count[index];
+    tb_pointer_t*   items = tcache->items[index];
+    while (count < n)
+    {
+        tb_pointer_t data = tb_fixed_pool_malloc_(fixed_pool __tb_debug_args__);
+        tb_check_break(data);
+        items[count++] = data;
+    }
+    tcache->count[index] = (tb_uint16_t)count;
+
+    // ok?
+    return count > 0;
+}
+static tb_void_t tb_small_allocator_tcache_detach(tb_small_allocator_tcache_t* tcache, tb_bool_t flush)
+{
+    // check, we need hold the global thread cache lock
+    tb_assert(tcache);
+
+    // the attached allocator
+    tb_small_allocator_ref_t allocator = tcache->allocator;
+    tb_check_return(allocator);
+
+    // flush all cached items to the fixed pools
+    tb_size_t i = 0;
+    if (flush)
+    {
+        tb_spinlock_enter(&allocator->base.lock);
+        for (i = 0; i < TB_SMALL_ALLOCATOR_FIXED_MAXN; i++)
+        {
+            if (tcache->count[i]) tb_small_allocator_tcache_flush(allocator, tcache, i, 0 __tb_debug_vals__);
+        }
+        tb_spinlock_leave(&allocator->base.lock);
+    }
+    // discard all cached items, e.g. the fixed pools will be exited or cleared
+    else tb_memset_(tcache->count, 0, sizeof(tcache->count));
+
+    // detach it
+    tb_list_entry_remove(&allocator->tcaches, &tcache->entry);
+    tcache->allocator = tb_null;
+}
+static tb_void_t tb_small_allocator_tcache_local_free(tb_cpointer_t priv)
+{
+    // check
+    tb_small_allocator_tcache_t* tcache = (tb_small_allocator_tcache_t*)priv;
+    tb_check_return(tcache && tcache != TB_SMALL_ALLOCATOR_TCACHE_DEAD);
+
+    // it's being freed now? we will enter here again when marking it as dead
+    tb_check_return(!tcache->is_dead);
+
+    // flush all cached items and detach it
+    tb_spinlock_enter(&g_tcache_lock);
+    tb_small_allocator_tcache_detach(tcache, tb_true);
+    tb_spinlock_leave(&g_tcache_lock);
+
+    /* mark the thread cache of the current thread as dead
+     *
+     * the current thread is exiting, but it may still malloc or free some data,
+     * so we use the shared fixed pools directly instead of making a new thread cache.
+     */
+    tcache->is_dead = tb_true;
+    tb_thread_local_set(&g_tcache_local, TB_SMALL_ALLOCATOR_TCACHE_DEAD);
+
+    // free it
+    tb_native_memory_free(tcache);
+}
+static tb_small_allocator_tcache_t* tb_small_allocator_tcache(tb_small_allocator_ref_t allocator)
+{
+    // check
+    tb_assert(allocator);
+
+    // the thread local is not available now? e.g. be called before tb_init() or after tb_exit()
+    if (!g_tcache_local.inited && !tb_thread_local_init(&g_tcache_local, tb_small_allocator_tcache_local_free))
+        return tb_null;
+
+    // get the thread cache of the current thread
+    tb_small_allocator_tcache_t* tcache = (tb_small_allocator_tcache_t*)tb_thread_local_get(&g_tcache_local);
+    tb_check_return_val(tcache != TB_SMALL_ALLOCATOR_TCACHE_DEAD, tb_null);
+    if (tcache && tcache->allocator == allocator) return tcache;
+
+    // make a new thread cache from the native memory, it may be freed after the allocator has been exited
+    if (!tcache)
+    {
+        tcache = (tb_small_allocator_tcache_t*)tb_native_memory_malloc0(sizeof(tb_small_allocator_tcache_t));
+        tb_assert_and_check_return_val(tcache, tb_null);
+
+        // save it to the current thread
+        if (!tb_thread_local_set(&g_tcache_local, tcache))
+        {
+            tb_native_memory_free(tcache);
+            return tb_null;
+        }
+    }
+
+    // attach it to this allocator if it's detached, only one allocator can use the thread cache of each thread
+    tb_spinlock_enter(&g_tcache_lock);
+    if (!tcache->allocator)
+    {
+        tb_list_entry_insert_tail(&allocator->tcaches, &tcache->entry);
+        tcache->allocator = allocator;
+    }
+    tb_spinlock_leave(&g_tcache_lock);
+
+    // ok?
+    return tcache->allocator == allocator? tcache : tb_null;
+}
+static tb_void_t tb_small_allocator_tcache_detach_all(tb_small_allocator_ref_t allocator)
+{
+    // check
+    tb_assert(allocator);
+
+    // detach all thread caches and discard the cached items
+    tb_spinlock_enter(&g_tcache_lock);
+    while (!tb_list_entry_is_null(&allocator->tcaches))
+        tb_small_allocator_tcache_detach((tb_small_allocator_tcache_t*)tb_list_entry_head(&allocator->tcaches), tb_false);
+    tb_spinlock_leave(&g_tcache_lock);
+}
+static tb_void_t tb_small_allocator_tcache_exit(tb_allocator_ref_t self)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // detach all thread caches first, the cached items will be freed with the fixed pools
+    tb_small_allocator_tcache_detach_all(allocator);
+
+    // exit it
+    tb_small_allocator_exit(self);
+}
+static tb_void_t tb_small_allocator_tcache_clear(tb_allocator_ref_t self)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // detach all thread caches first, the cached items will be cleared with the fixed pools
+    tb_small_allocator_tcache_detach_all(allocator);
+
+    // clear it
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_small_allocator_clear(self);
+    tb_spinlock_leave(&allocator->base.lock);
+}
+static tb_pointer_t tb_small_allocator_tcache_malloc(tb_allocator_ref_t self, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && size, tb_null);
+    tb_assert_and_check_return_val(size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
+
+    // no thread cache? malloc it from the shared fixed pools directly
+    tb_pointer_t                    data = tb_null;
+    tb_small_allocator_tcache_t*    tcache = tb_small_allocator_tcache(allocator);
+    if (!tcache)
+    {
+        tb_spinlock_enter(&allocator->base.lock);
+        data = tb_small_allocator_malloc(self, size __tb_debug_args__);
+        tb_spinlock_leave(&allocator->base.lock);
+        return data;
+    }
+
+    // the fixed pool index
+    tb_size_t space = 0;
+    tb_size_t index = tb_small_allocator_find_index(size, &space);
+
+    // no cached items? refill them from the fixed pool
+    if (!tcache->count[index])
+    {
+        tb_spinlock_enter(&allocator->base.lock);
+        tb_bool_t ok = tb_small_allocator_tcache_refill(allocator, tcache, size __tb_debug_args__);
+        tb_spinlock_leave(&allocator->base.lock);
+        tb_assertf_and_check_return_val(ok, tb_null, "malloc(%lu) failed!", size);
+    }
+
+    // get a cached item
+    data = tcache->items[index][--tcache->count[index]];
+    tb_assert(data);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assert(data_head->debug.magic == TB_POOL_DATA_MAGIC);
+
+#ifdef __tb_debug__
+    // update the debug info
+    data_head->debug.file = file_;
+    data_head->debug.func = func_;
+    data_head->debug.line = (tb_uint16_t)line_;
+
+    // fill the patch bytes
+    if (space > size) tb_memset_((tb_byte_t*)data + size, TB_POOL_DATA_PATCH, space - size);
+#endif
+
+    // update size
+    data_head->size = size;
+
+    // ok
+    return data;
+}
+static tb_bool_t tb_small_allocator_tcache_free(tb_allocator_ref_t self, tb_pointer_t data __tb_debug_decl__)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && data, tb_false);
+
+    // no thread cache? free it to the shared fixed pools directly
+    tb_small_allocator_tcache_t* tcache = tb_small_allocator_tcache(allocator);
+    if (!tcache)
+    {
+        tb_spinlock_enter(&allocator->base.lock);
+        tb_bool_t ok = tb_small_allocator_free(self, data __tb_debug_args__);
+        tb_spinlock_leave(&allocator->base.lock);
+        return ok;
+    }
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
+    tb_assert_and_check_return_val(data_head->size && data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_false);
+
+    // the fixed pool index
+    tb_size_t space = 0;
+    tb_size_t index = tb_small_allocator_find_index(data_head->size, &space);
+
+    // check underflow
+    tb_assertf(space == data_head->size || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
+
+#ifdef __tb_debug__
+    // check double free
+    tb_size_t i = 0;
+    for (i = 0; i < tcache->count[index]; i++)
+    {
+        tb_assertf(tcache->items[index][i] != data, "double free data: %p", data);
+    }
+#endif
+
+    // the thread cache is full? flush the half of it to the fixed pool
+    tb_size_t maxn = tb_small_allocator_tcache_maxn(space);
+    if (tcache->count[index] >= maxn)
+    {
+        tb_spinlock_enter(&allocator->base.lock);
+        tb_small_allocator_tcache_flush(allocator, tcache, index, maxn >> 1 __tb_debug_args__);
+        tb_spinlock_leave(&allocator->base.lock);
+    }
+
+    // cache it
+    tcache->items[index][tcache->count[index]++] = data;
+
+    // ok
+    return tb_true;
+}
+static tb_pointer_t tb_small_allocator_tcache_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && data && size, tb_null);
+    tb_assert_and_check_return_val(size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
+
+    // the old data head
+    tb_pool_data_head_t* data_head_old = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head_old->debug.magic == TB_POOL_DATA_MAGIC, "ralloc invalid data: %p", data);
+    tb_assert_and_check_return_val(data_head_old->size && data_head_old->size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
+
+    // the old and new fixed pool index
+    tb_size_t space_old = 0;
+    tb_size_t space_new = 0;
+    tb_size_t index_old = tb_small_allocator_find_index(data_head_old->size, &space_old);
+    tb_size_t index_new = tb_small_allocator_find_index(size, &space_new);
+
+    // check underflow
+    tb_assertf(space_old == data_head_old->size || ((tb_byte_t*)data)[data_head_old->size] == TB_POOL_DATA_PATCH, "data underflow");
+
+    // same space? only update size
+    if (index_old == index_new)
+    {
+#ifdef __tb_debug__
+        // fill the patch bytes
+        if (data_head_old->size > size) tb_memset_((tb_byte_t*)data + size, TB_POOL_DATA_PATCH, data_head_old->size - size);
+#endif
+        data_head_old->size = size;
+        return data;
+    }
+
+    // make the new data
+    tb_pointer_t data_new = tb_small_allocator_tcache_malloc(self, size __tb_debug_args__);
+    tb_assert_and_check_return_val(data_new, tb_null);
+
+    // copy the old data
+    tb_memcpy_(data_new, data, tb_min(data_head_old->size, size));
+
+    // free the old data
+    tb_small_allocator_tcache_free(self, data __tb_debug_args__);
+
+    // ok
+    return data_new;
+}
+#ifdef __tb_debug__
+static tb_void_t tb_small_allocator_tcache_dump(tb_allocator_ref_t self)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // flush the thread cache of the current thread first, we need not report them as leaks
+    tb_small_allocator_tcache_t* tcache = tb_small_allocator_tcache(allocator);
+    if (tcache)
+    {
+        tb_spinlock_enter(&g_tcache_lock);
+        tb_small_allocator_tcache_detach(tcache, tb_true);
+        tb_spinlock_leave(&g_tcache_lock);
+    }
+
+    // dump it
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_small_allocator_dump(self);
+    tb_spinlock_leave(&allocator->base.lock);
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
+tb_allocator_ref_t tb_small_allocator_init_(tb_allocator_ref_t large_allocator, tb_bool_t tcache)
 {
     // done
     tb_bool_t                   ok = tb_false;
@@ -435,6 +881,9 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
         // init large allocator
         allocator->large_allocator      = large_allocator;
 
+        // init the thread caches
+        tb_list_entry_init(&allocator->tcaches, tb_small_allocator_tcache_t, entry, tb_null);
+
         // init base
         allocator->base.type            = TB_ALLOCATOR_TYPE_SMALL;
         allocator->base.flag            = TB_ALLOCATOR_FLAG_NONE;
@@ -448,6 +897,21 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
         allocator->base.have            = tb_small_allocator_have;
 #endif
 
+        // enable the thread caches? we need not the global lock
+        if (tcache)
+        {
+            allocator->tcache           = tb_true;
+            allocator->base.flag        = TB_ALLOCATOR_FLAG_NOLOCK;
+            allocator->base.malloc      = tb_small_allocator_tcache_malloc;
+            allocator->base.ralloc      = tb_small_allocator_tcache_ralloc;
+            allocator->base.free        = tb_small_allocator_tcache_free;
+            allocator->base.clear       = tb_small_allocator_tcache_clear;
+            allocator->base.exit        = tb_small_allocator_tcache_exit;
+#ifdef __tb_debug__
+            allocator->base.dump        = tb_small_allocator_tcache_dump;
+#endif
+        }
+
         // init lock
         if (!tb_spinlock_init(&allocator->base.lock)) break;
 
@@ -467,3 +931,7 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
     return (tb_allocator_ref_t)allocator;
 }
 
+tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
+{
+    return tb_small_allocator_init_(large_allocator, tb_false);
+}
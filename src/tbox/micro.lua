@@ -46,6 +46,7 @@ target("tbox")
     add_files("libc/stdio/printf.c")
     add_files("libc/stdlib/stdlib.c")
     add_files("libc/impl/libc.c")
+    add_files("libc/impl/search.c")
     add_files("libm/impl/libm.c")
     add_files("math/impl/math.c")
     add_files("utils/used.c")
@@ -64,6 +65,7 @@ target("tbox")
     add_files("network/unixaddr.c")
     add_files("network/ipaddr.c")
     add_files("network/impl/network.c")
+    add_files("platform/cpu.c")
     add_files("platform/page.c")
     add_files("platform/time.c")
     add_files("platform/file.c")
@@ -99,6 +101,7 @@ target("tbox")
         add_files("libm/isinff.c")
         add_files("libm/isnan.c")
         add_files("libm/isnanf.c")
+        add_files("libc/stdlib/dtoa.c")
     end
 
     -- add the source for the windows
@@ -0,0 +1,732 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        batch.c
+ * @ingroup     network
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "dns_batch"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "batch.h"
+#include "cache.h"
+#include "server.h"
+#include "../../libc/libc.h"
+#include "../../math/math.h"
+#include "../../utils/utils.h"
+#include "../../memory/memory.h"
+#include "../../container/container.h"
+#include "../../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max in-flight query count, the query id is (seqn * window + slot index)
+#ifdef __tb_small__
+#   define TB_DNS_BATCH_WINDOW          (64)
+#else
+#   define TB_DNS_BATCH_WINDOW          (128)
+#endif
+
+// the timeout (ms) of every try
+#define TB_DNS_BATCH_TIMEOUT            (1000)
+
+// the max try count, it will try the next server for every retransmission
+#define TB_DNS_BATCH_TRYN               (3)
+
+// the query types
+#define TB_DNS_BATCH_TYPE_A             (1)
+#define TB_DNS_BATCH_TYPE_AAAA          (2)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the dns batch query type
+typedef struct __tb_dns_batch_query_t
+{
+    // the list entry
+    tb_single_list_entry_t  entry;
+
+    // the result
+    tb_dns_batch_result_t   result;
+
+    // the types need be sent
+    tb_uint8_t              types;
+
+    // the unfinished type count
+    tb_uint8_t              pending;
+
+    // has any server answered it?
+    tb_uint8_t              answered;
+
+    // the encoded name size
+    tb_uint16_t             qsize;
+
+    // the encoded name
+    tb_byte_t               qname[TB_DNS_NAME_MAXN];
+
+}tb_dns_batch_query_t;
+
+// the dns batch slot type
+typedef struct __tb_dns_batch_slot_t
+{
+    // the list entry, the slot is in the sending or waiting list
+    tb_list_entry_t         entry;
+
+    // the query, it is null if this slot is free
+    tb_dns_batch_query_t*   query;
+
+    // the deadline (ms), it is 0 if not be sent
+    tb_hong_t               deadline;
+
+    // the query id
+    tb_uint16_t             id;
+
+    // the query type
+    tb_uint8_t              type;
+
+    // the try count
+    tb_uint8_t              tryn;
+
+    // the server index
+    tb_uint8_t              server;
+
+}tb_dns_batch_slot_t;
+
+// the dns batch type
+typedef struct __tb_dns_batch_t
+{
+    // the socket
+    tb_socket_ref_t             sock;
+
+    // the family
+    tb_size_t                   family;
+
+    // the func
+    tb_dns_batch_func_t         func;
+
+    // the user private data
+    tb_cpointer_t               priv;
+
+    // the server list
+    tb_ipaddr_t                 list[2];
+
+    // the server count
+    tb_size_t                   maxn;
+
+    // the pending queries
+    tb_single_list_entry_head_t pending;
+
+    // the unfinished query count
+    tb_size_t                   size;
+
+    // the sending slots
+    tb_list_entry_head_t        sending;
+
+    /* the waiting slots, they are sorted by the deadline
+     * because the timeout of every try is same
+     */
+    tb_list_entry_head_t        waiting;
+
+    // the sequence number of the query id
+    tb_uint16_t                 seqn;
+
+    // is the socket blocked for sending?
+    tb_uint16_t                 blocked;
+
+    // the free slot count
+    tb_size_t                   frees_count;
+
+    // the free slots
+    tb_uint16_t                 frees[TB_DNS_BATCH_WINDOW];
+
+    // the slots
+    tb_dns_batch_slot_t         slots[TB_DNS_BATCH_WINDOW];
+
+    // the packet data
+    tb_byte_t                   data[TB_DNS_RPKT_MAXN];
+
+}tb_dns_batch_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// size + data, e.g. www.google.com => 3www6google3com0
+static tb_size_t tb_dns_batch_encode(tb_char_t const* name, tb_byte_t* data, tb_size_t maxn)
+{
+    tb_size_t           n = 0;
+    tb_char_t const*    p = name;
+    while (*p)
+    {
+        // get label
+        tb_char_t const* b = p;
+        while (*p && *p != '.') p++;
+        tb_size_t size = p - b;
+        tb_check_return_val(size && size < 64 && n + size + 2 <= maxn, 0);
+
+        // save label
+        data[n++] = (tb_byte_t)size;
+        tb_memcpy(data + n, b, size);
+        n += size;
+
+        // skip '.'
+        if (*p) p++;
+    }
+    tb_check_return_val(n, 0);
+
+    // end
+    data[n++] = 0;
+    return n;
+}
+static tb_byte_t const* tb_dns_batch_skip_name(tb_byte_t const* p, tb_byte_t const* e)
+{
+    while (p < e)
+    {
+        tb_byte_t c = *p++;
+        if (!c) return p;
+        // is pointer? 11xxxxxx xxxxxxxx
+        else if (c >= 0xc0) return p + 1 <= e? p + 1 : tb_null;
+        else p += c;
+    }
+    return tb_null;
+}
+static __tb_inline__ tb_uint16_t tb_dns_batch_id(tb_dns_batch_t* batch, tb_size_t index)
+{
+    return (tb_uint16_t)(++batch->seqn * TB_DNS_BATCH_WINDOW + index);
+}
+static tb_void_t tb_dns_batch_finish(tb_dns_batch_t* batch, tb_dns_batch_query_t* query)
+{
+    // the result
+    tb_dns_batch_result_ref_t result = &query->result;
+    if (!tb_ipaddr_ip_is_empty(&result->ipv4) || !tb_ipaddr_ip_is_empty(&result->ipv6))
+        result->state = TB_DNS_BATCH_STATE_OK;
+    else result->state = query->answered? TB_DNS_BATCH_STATE_NOTFOUND : TB_DNS_BATCH_STATE_FAILED;
+    if (result->ttl == TB_MAXU32) result->ttl = 0;
+
+    // trace
+    tb_trace_d("finish: %s => %{ipaddr}, %{ipaddr}, state: %lu, ttl: %u", result->name, &result->ipv4, &result->ipv6, result->state, result->ttl);
+
+    // notify it
+    tb_assert(batch->size);
+    batch->size--;
+    if (batch->func) batch->func((tb_dns_batch_ref_t)batch, result, batch->priv);
+
+    // exit it
+    tb_free(query);
+}
+static tb_void_t tb_dns_batch_slot_done(tb_dns_batch_t* batch, tb_size_t index, tb_bool_t answered)
+{
+    // the slot
+    tb_dns_batch_slot_t*    slot = &batch->slots[index];
+    tb_dns_batch_query_t*   query = slot->query;
+    tb_assert_and_check_return(query && query->pending);
+
+    // free slot
+    slot->query = tb_null;
+    slot->deadline = 0;
+    batch->frees[batch->frees_count++] = (tb_uint16_t)index;
+
+    // finish the query if all types are finished
+    if (answered) query->answered = 1;
+    if (!--query->pending) tb_dns_batch_finish(batch, query);
+}
+static tb_long_t tb_dns_batch_slot_send(tb_dns_batch_t* batch, tb_size_t index, tb_hong_t now)
+{
+    // the slot
+    tb_dns_batch_slot_t*    slot = &batch->slots[index];
+    tb_dns_batch_query_t*   query = slot->query;
+    tb_assert_and_check_return_val(query && slot->server < batch->maxn, -1);
+
+    // make query, id + flags(recursion desired) + 1 question + name + type + class(in)
+    tb_byte_t* data = batch->data;
+    tb_bits_set_u16_be(data, slot->id);
+    tb_bits_set_u16_be(data + 2, 0x0100);
+    tb_bits_set_u16_be(data + 4, 1);
+    tb_bits_set_u16_be(data + 6, 0);
+    tb_bits_set_u16_be(data + 8, 0);
+    tb_bits_set_u16_be(data + 10, 0);
+    tb_memcpy(data + TB_DNS_HEADER_SIZE, query->qname, query->qsize);
+    tb_size_t size = TB_DNS_HEADER_SIZE + query->qsize;
+    tb_bits_set_u16_be(data + size, slot->type == TB_DNS_BATCH_TYPE_A? 1 : 28);
+    tb_bits_set_u16_be(data + size + 2, 1);
+    size += 4;
+
+    // send it
+    tb_long_t real = tb_socket_usend(batch->sock, &batch->list[slot->server], data, size);
+    tb_check_return_val(real > 0, real);
+
+    // trace
+    tb_trace_d("send: %s, id: %u, type: %u, tryn: %u, server: %{ipaddr}", query->result.name, slot->id, slot->type, slot->tryn, &batch->list[slot->server]);
+
+    // wait it
+    slot->deadline = now + TB_DNS_BATCH_TIMEOUT;
+    return 1;
+}
+static tb_void_t tb_dns_batch_slot_retry(tb_dns_batch_t* batch, tb_size_t index)
+{
+    // the slot
+    tb_dns_batch_slot_t* slot = &batch->slots[index];
+    tb_assert_and_check_return(slot->query);
+
+    // too many tries? finish it
+    if (++slot->tryn >= TB_DNS_BATCH_TRYN)
+    {
+        tb_trace_d("timeout: %s, type: %u", slot->query->result.name, slot->type);
+        tb_dns_batch_slot_done(batch, index, tb_false);
+        return ;
+    }
+
+    // send it to the next server with a new id
+    slot->server    = (tb_uint8_t)((slot->server + 1) % batch->maxn);
+    slot->id        = tb_dns_batch_id(batch, index);
+    slot->deadline  = 0;
+    tb_list_entry_insert_tail(&batch->sending, &slot->entry);
+}
+static tb_void_t tb_dns_batch_resp(tb_dns_batch_t* batch, tb_ipaddr_ref_t addr, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_check_return(size >= TB_DNS_HEADER_SIZE);
+
+    // get header
+    tb_uint16_t id          = tb_bits_get_u16_be(data);
+    tb_uint16_t flags       = tb_bits_get_u16_be(data + 2);
+    tb_size_t   question    = tb_bits_get_u16_be(data + 4);
+    tb_size_t   answer      = tb_bits_get_u16_be(data + 6);
+    tb_size_t   authority   = tb_bits_get_u16_be(data + 8);
+    tb_size_t   rcode       = flags & 0xf;
+    tb_check_return((flags & 0x8000) && question == 1);
+
+    // match the slot by id and server
+    tb_size_t               index = id % TB_DNS_BATCH_WINDOW;
+    tb_dns_batch_slot_t*    slot = &batch->slots[index];
+    tb_dns_batch_query_t*   query = slot->query;
+    tb_check_return(query && slot->id == id && slot->deadline && tb_ipaddr_is_equal(addr, &batch->list[slot->server]));
+
+    // match the question
+    tb_byte_t const*    p = data + TB_DNS_HEADER_SIZE;
+    tb_byte_t const*    e = data + size;
+    tb_check_return(p + query->qsize + 4 <= e && !tb_strnicmp((tb_char_t const*)p, (tb_char_t const*)query->qname, query->qsize));
+    tb_uint16_t type = slot->type == TB_DNS_BATCH_TYPE_A? 1 : 28;
+    tb_check_return(tb_bits_get_u16_be(p + query->qsize) == type);
+    p += query->qsize + 4;
+
+    // trace
+    tb_trace_d("recv: %s, id: %u, type: %u, rcode: %lu, answer: %lu", query->result.name, id, type, rcode, answer);
+
+    // stop waiting it
+    tb_list_entry_remove(&batch->waiting, &slot->entry);
+
+    // server failure? try the next server at once
+    if (rcode != 0 && rcode != 3)
+    {
+        tb_dns_batch_slot_retry(batch, index);
+        return ;
+    }
+
+    // get the address, the ttl is the minimum of the alias chain
+    tb_size_t       i = 0;
+    tb_bool_t       found = tb_false;
+    tb_uint32_t     ttl = TB_MAXU32;
+    tb_ipaddr_ref_t result = type == 1? &query->result.ipv4 : &query->result.ipv6;
+    for (i = 0; i < answer && rcode == 0 && !found; i++)
+    {
+        // get resource
+        p = tb_dns_batch_skip_name(p, e);
+        tb_check_break(p && p + 10 <= e);
+        tb_uint16_t rtype = tb_bits_get_u16_be(p);
+        tb_uint32_t rttl  = tb_bits_get_u32_be(p + 4);
+        tb_size_t   rsize = tb_bits_get_u16_be(p + 8);
+        p += 10;
+        tb_check_break(p + rsize <= e);
+        if (rttl < ttl) ttl = rttl;
+
+        // save address
+        if (rtype == type && rsize == 4 && type == 1)
+        {
+            tb_ipv4_t ipv4;
+            tb_memcpy(ipv4.u8, p, 4);
+            tb_ipaddr_ipv4_set(result, &ipv4);
+            found = tb_true;
+        }
+        else if (rtype == type && rsize == 16 && type == 28)
+        {
+            tb_ipv6_t ipv6;
+            tb_memset(&ipv6, 0, sizeof(tb_ipv6_t));
+            tb_memcpy(ipv6.addr.u8, p, 16);
+            tb_ipaddr_ipv6_set(result, &ipv6);
+            found = tb_true;
+        }
+        p += rsize;
+    }
+
+    // not found? get the negative ttl from the soa record
+    if (!found)
+    {
+        ttl = TB_DNS_CACHE_NEGATIVE_TTL;
+        for (; i < answer + authority; i++)
+        {
+            p = tb_dns_batch_skip_name(p, e);
+            tb_check_break(p && p + 10 <= e);
+            tb_uint16_t rtype = tb_bits_get_u16_be(p);
+            tb_uint32_t rttl  = tb_bits_get_u32_be(p + 4);
+            tb_size_t   rsize = tb_bits_get_u16_be(p + 8);
+            p += 10;
+            tb_check_break(p + rsize <= e);
+            if (i >= answer && rtype == 6 && rsize > 20)
+            {
+                tb_uint32_t minimum = tb_bits_get_u32_be(p + rsize - 4);
+                ttl = tb_min(rttl, minimum);
+                break;
+            }
+            p += rsize;
+        }
+    }
+    if (ttl < query->result.ttl) query->result.ttl = ttl;
+
+    // save the ipv4 address to cache
+    if (type == 1) tb_dns_cache_save(query->result.name, found? result : tb_null, ttl);
+
+    // finish this slot
+    tb_dns_batch_slot_done(batch, index, tb_true);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_dns_batch_ref_t tb_dns_batch_init(tb_size_t family, tb_dns_batch_func_t func, tb_cpointer_t priv)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_dns_batch_t* batch = tb_null;
+    do
+    {
+        // make batch
+        batch = tb_malloc0_type(tb_dns_batch_t);
+        tb_assert_and_check_break(batch);
+
+        // init batch
+        batch->family   = family;
+        batch->func     = func;
+        batch->priv     = priv;
+        batch->seqn     = (tb_uint16_t)tb_random_range(0, TB_MAXU16);
+        tb_single_list_entry_init(&batch->pending, tb_dns_batch_query_t, entry, tb_null);
+        tb_list_entry_init(&batch->sending, tb_dns_batch_slot_t, entry, tb_null);
+        tb_list_entry_init(&batch->waiting, tb_dns_batch_slot_t, entry, tb_null);
+
+        // init slots
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DNS_BATCH_WINDOW; i++)
+            batch->frees[i] = (tb_uint16_t)(TB_DNS_BATCH_WINDOW - i - 1);
+        batch->frees_count = TB_DNS_BATCH_WINDOW;
+
+        // get the dns server list
+        tb_ipaddr_t list[2];
+        tb_size_t   maxn = tb_dns_server_get(list);
+        tb_check_break(maxn && maxn <= tb_arrayn(list));
+
+        // only use the servers with the same family as the first server
+        for (i = 0; i < maxn; i++)
+        {
+            if (tb_ipaddr_family(&list[i]) == tb_ipaddr_family(&list[0]))
+                batch->list[batch->maxn++] = list[i];
+        }
+
+        // init sock
+        batch->sock = tb_socket_init(TB_SOCKET_TYPE_UDP, tb_ipaddr_family(&list[0]));
+        tb_assert_and_check_break(batch->sock);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (batch) tb_dns_batch_exit((tb_dns_batch_ref_t)batch);
+        batch = tb_null;
+    }
+
+    // ok?
+    return (tb_dns_batch_ref_t)batch;
+}
+tb_void_t tb_dns_batch_exit(tb_dns_batch_ref_t self)
+{
+    // the batch
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_check_return(batch);
+
+    // exit the in-flight queries
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_BATCH_WINDOW; i++)
+    {
+        tb_dns_batch_query_t* query = batch->slots[i].query;
+        if (query && !--query->pending) tb_free(query);
+        batch->slots[i].query = tb_null;
+    }
+
+    // exit the pending queries
+    while (!tb_single_list_entry_is_null(&batch->pending))
+    {
+        tb_dns_batch_query_t* query = (tb_dns_batch_query_t*)tb_single_list_entry_head(&batch->pending);
+        tb_single_list_entry_remove_head(&batch->pending);
+        tb_free(query);
+    }
+
+    // exit sock
+    if (batch->sock) tb_socket_exit(batch->sock);
+    batch->sock = tb_null;
+
+    // exit it
+    tb_free(batch);
+}
+tb_bool_t tb_dns_batch_post(tb_dns_batch_ref_t self, tb_char_t const* name, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_assert_and_check_return_val(batch && name, tb_false);
+
+    // make query, the name is saved after it
+    tb_size_t               size = tb_strlen(name);
+    tb_dns_batch_query_t*   query = (tb_dns_batch_query_t*)tb_malloc0(sizeof(tb_dns_batch_query_t) + size + 1);
+    tb_assert_and_check_return_val(query, tb_false);
+
+    // init query
+    query->qsize = (tb_uint16_t)tb_dns_batch_encode(name, query->qname, sizeof(query->qname));
+    if (!query->qsize)
+    {
+        tb_free(query);
+        return tb_false;
+    }
+    query->result.name  = (tb_char_t const*)tb_memcpy(query + 1, name, size + 1);
+    query->result.priv  = priv;
+    query->result.ttl   = TB_MAXU32;
+    tb_ipaddr_clear(&query->result.ipv4);
+    tb_ipaddr_clear(&query->result.ipv6);
+
+    // is address?
+    tb_ipaddr_t addr;
+    if (tb_ipaddr_ip_cstr_set(&addr, name, TB_IPADDR_FAMILY_NONE))
+    {
+        if (tb_ipaddr_family(&addr) == TB_IPADDR_FAMILY_IPV6) query->result.ipv6 = addr;
+        else query->result.ipv4 = addr;
+    }
+    // is localhost?
+    else if (!tb_stricmp(name, "localhost"))
+    {
+        if (batch->family != TB_IPADDR_FAMILY_IPV6) tb_ipaddr_ip_cstr_set(&query->result.ipv4, "127.0.0.1", TB_IPADDR_FAMILY_IPV4);
+        if (batch->family != TB_IPADDR_FAMILY_IPV4) tb_ipaddr_ip_cstr_set(&query->result.ipv6, "::1", TB_IPADDR_FAMILY_IPV6);
+    }
+    // only look ipv4? try to get it from cache first
+    else if (batch->family == TB_IPADDR_FAMILY_IPV4 && tb_dns_cache_look(name, &query->result.ipv4))
+        query->answered = 1;
+    // look it
+    else
+    {
+        if (batch->family != TB_IPADDR_FAMILY_IPV6) query->types |= TB_DNS_BATCH_TYPE_A;
+        if (batch->family != TB_IPADDR_FAMILY_IPV4) query->types |= TB_DNS_BATCH_TYPE_AAAA;
+        query->pending = (query->types & TB_DNS_BATCH_TYPE_A? 1 : 0) + (query->types & TB_DNS_BATCH_TYPE_AAAA? 1 : 0);
+    }
+
+    // post it, the finished query will be notified in the next spak
+    tb_single_list_entry_insert_tail(&batch->pending, &query->entry);
+    batch->size++;
+    return tb_true;
+}
+tb_size_t tb_dns_batch_size(tb_dns_batch_ref_t self)
+{
+    // check
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_assert_and_check_return_val(batch, 0);
+
+    return batch->size;
+}
+tb_socket_ref_t tb_dns_batch_sock(tb_dns_batch_ref_t self)
+{
+    // check
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_assert_and_check_return_val(batch, tb_null);
+
+    return batch->sock;
+}
+tb_size_t tb_dns_batch_events(tb_dns_batch_ref_t self)
+{
+    // check
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_assert_and_check_return_val(batch, TB_SOCKET_EVENT_NONE);
+
+    // wait the responses of the in-flight queries and wait to send the blocked queries
+    tb_size_t events = TB_SOCKET_EVENT_NONE;
+    if (!tb_list_entry_is_null(&batch->waiting)) events |= TB_SOCKET_EVENT_RECV;
+    if (batch->blocked) events |= TB_SOCKET_EVENT_SEND;
+    return events;
+}
+tb_long_t tb_dns_batch_timeout(tb_dns_batch_ref_t self)
+{
+    // check
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_assert_and_check_return_val(batch, -1);
+
+    // need spak at once if some queries can be sent now
+    tb_check_return_val(tb_single_list_entry_is_null(&batch->pending) || !batch->frees_count, 0);
+    tb_check_return_val(tb_list_entry_is_null(&batch->sending) || batch->blocked, 0);
+
+    // no waiting query?
+    tb_check_return_val(!tb_list_entry_is_null(&batch->waiting), -1);
+
+    // get the nearest deadline
+    tb_dns_batch_slot_t const* slot = (tb_dns_batch_slot_t const*)tb_list_entry(&batch->waiting, tb_list_entry_head(&batch->waiting));
+    tb_hong_t now = tb_mclock();
+    return slot->deadline > now? (tb_long_t)(slot->deadline - now) : 0;
+}
+tb_long_t tb_dns_batch_spak(tb_dns_batch_ref_t self)
+{
+    // check
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_assert_and_check_return_val(batch && batch->sock, -1);
+
+    // recv all responses
+    tb_ipaddr_t addr;
+    while (!tb_list_entry_is_null(&batch->waiting))
+    {
+        tb_long_t real = tb_socket_urecv(batch->sock, &addr, batch->data, sizeof(batch->data));
+        tb_check_return_val(real >= 0, -1);
+        tb_check_break(real);
+
+        // done response
+        tb_dns_batch_resp(batch, &addr, batch->data, real);
+    }
+
+    // retransmit the timeout queries
+    tb_hong_t now = tb_mclock();
+    while (!tb_list_entry_is_null(&batch->waiting))
+    {
+        // the first slot has the nearest deadline
+        tb_dns_batch_slot_t* slot = (tb_dns_batch_slot_t*)tb_list_entry(&batch->waiting, tb_list_entry_head(&batch->waiting));
+        tb_check_break(now >= slot->deadline);
+
+        // try the next server
+        tb_list_entry_remove(&batch->waiting, &slot->entry);
+        tb_dns_batch_slot_retry(batch, slot - batch->slots);
+    }
+
+    // post the pending queries to the free slots
+    while (!tb_single_list_entry_is_null(&batch->pending))
+    {
+        // the query
+        tb_dns_batch_query_t* query = (tb_dns_batch_query_t*)tb_single_list_entry_head(&batch->pending);
+
+        // finished? e.g. address, localhost and cache
+        if (!query->types)
+        {
+            tb_single_list_entry_remove_head(&batch->pending);
+            tb_dns_batch_finish(batch, query);
+            continue;
+        }
+
+        // no free slot?
+        tb_check_break(batch->frees_count);
+
+        // init slot
+        tb_size_t               index = batch->frees[--batch->frees_count];
+        tb_dns_batch_slot_t*    slot = &batch->slots[index];
+        slot->query     = query;
+        slot->type      = (query->types & TB_DNS_BATCH_TYPE_A)? TB_DNS_BATCH_TYPE_A : TB_DNS_BATCH_TYPE_AAAA;
+        slot->id        = tb_dns_batch_id(batch, index);
+        slot->tryn      = 0;
+        slot->server    = 0;
+        slot->deadline  = 0;
+        tb_list_entry_insert_tail(&batch->sending, &slot->entry);
+
+        // all types have been posted? remove it from the pending queries
+        query->types &= ~slot->type;
+        if (!query->types) tb_single_list_entry_remove_head(&batch->pending);
+    }
+
+    // send queries
+    batch->blocked = 0;
+    while (!tb_list_entry_is_null(&batch->sending))
+    {
+        // send it
+        tb_dns_batch_slot_t*    slot = (tb_dns_batch_slot_t*)tb_list_entry(&batch->sending, tb_list_entry_head(&batch->sending));
+        tb_size_t               index = slot - batch->slots;
+        tb_long_t               ok = tb_dns_batch_slot_send(batch, index, now);
+
+        // blocked? wait it
+        if (!ok)
+        {
+            batch->blocked = 1;
+            break;
+        }
+
+        // wait the response, or try the next server at once if failed
+        tb_list_entry_remove(&batch->sending, &slot->entry);
+        if (ok > 0) tb_list_entry_insert_tail(&batch->waiting, &slot->entry);
+        else tb_dns_batch_slot_retry(batch, index);
+    }
+
+    // all names are finished?
+    return batch->size? 0 : 1;
+}
+tb_long_t tb_dns_batch_wait(tb_dns_batch_ref_t self, tb_long_t timeout)
+{
+    // check
+    tb_dns_batch_t* batch = (tb_dns_batch_t*)self;
+    tb_assert_and_check_return_val(batch && batch->sock, -1);
+
+    // no events? need spak
+    tb_size_t events = tb_dns_batch_events(self);
+    tb_check_return_val(events, 0);
+
+    // wait it until the next retransmission
+    tb_long_t delay = tb_dns_batch_timeout(self);
+    if (delay >= 0 && (timeout < 0 || delay < timeout)) timeout = delay;
+
+    // trace
+    tb_trace_d("waiting %p, events: %lu, timeout: %ld ..", batch->sock, events, timeout);
+
+    // wait
+    return tb_socket_wait(batch->sock, events, timeout);
+}
+tb_bool_t tb_dns_batch_done(tb_dns_batch_ref_t self)
+{
+    // check
+    tb_assert_and_check_return_val(self, tb_false);
+
+    // spak
+    tb_long_t r = -1;
+    while (!(r = tb_dns_batch_spak(self)))
+    {
+        // wait
+        r = tb_dns_batch_wait(self, -1);
+        tb_assert_and_check_break(r >= 0);
+    }
+
+    // ok?
+    return r > 0;
+}
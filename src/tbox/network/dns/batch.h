@@ -0,0 +1,182 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        batch.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_DNS_BATCH_H
+#define TB_NETWORK_DNS_BATCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../../platform/socket.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the dns batch type
+typedef __tb_typeref__(dns_batch);
+
+/// the dns batch state enum
+typedef enum __tb_dns_batch_state_e
+{
+    TB_DNS_BATCH_STATE_OK           = 0     //!< found the address
+,   TB_DNS_BATCH_STATE_NOTFOUND     = 1     //!< the name does not exist or has no address
+,   TB_DNS_BATCH_STATE_FAILED       = 2     //!< all servers are timeout or failed
+
+}tb_dns_batch_state_e;
+
+/// the dns batch result type
+typedef struct __tb_dns_batch_result_t
+{
+    /// the host name
+    tb_char_t const*        name;
+
+    /// the private data of this name
+    tb_cpointer_t           priv;
+
+    /// the state
+    tb_size_t               state;
+
+    /// the ipv4 address, it is empty if not found
+    tb_ipaddr_t             ipv4;
+
+    /// the ipv6 address, it is empty if not found
+    tb_ipaddr_t             ipv6;
+
+    /// the ttl (s)
+    tb_uint32_t             ttl;
+
+}tb_dns_batch_result_t, *tb_dns_batch_result_ref_t;
+
+/*! the dns batch result func type
+ *
+ * @param batch     the batch
+ * @param result    the result
+ * @param priv      the user private data
+ */
+typedef tb_void_t           (*tb_dns_batch_func_t)(tb_dns_batch_ref_t batch, tb_dns_batch_result_ref_t result, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init a batch for looking many host names, non-block
+ *
+ * all queries are multiplexed over one udp socket and matched by the query id,
+ * they will be retransmitted to the next server if timeout.
+ *
+ * @param family    the address family, ipv4: A, ipv6: AAAA, none: A and AAAA
+ * @param func      the result func
+ * @param priv      the user private data
+ *
+ * @return          the batch
+ */
+tb_dns_batch_ref_t  tb_dns_batch_init(tb_size_t family, tb_dns_batch_func_t func, tb_cpointer_t priv);
+
+/*! exit the batch, the unfinished names will be discarded
+ *
+ * @param batch     the batch
+ */
+tb_void_t           tb_dns_batch_exit(tb_dns_batch_ref_t batch);
+
+/*! post a host name to the batch
+ *
+ * it will be sent in the next tb_dns_batch_spak()
+ *
+ * @param batch     the batch
+ * @param name      the host name
+ * @param priv      the private data of this name
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_dns_batch_post(tb_dns_batch_ref_t batch, tb_char_t const* name, tb_cpointer_t priv);
+
+/*! the unfinished name count
+ *
+ * @param batch     the batch
+ *
+ * @return          the count
+ */
+tb_size_t           tb_dns_batch_size(tb_dns_batch_ref_t batch);
+
+/*! the socket of the batch, we can wait it in the poller
+ *
+ * @param batch     the batch
+ *
+ * @return          the socket
+ */
+tb_socket_ref_t     tb_dns_batch_sock(tb_dns_batch_ref_t batch);
+
+/*! the socket events need be waited
+ *
+ * @param batch     the batch
+ *
+ * @return          the socket events
+ */
+tb_size_t           tb_dns_batch_events(tb_dns_batch_ref_t batch);
+
+/*! the timeout of the next retransmission
+ *
+ * @param batch     the batch
+ *
+ * @return          the timeout (ms), infinity: -1
+ */
+tb_long_t           tb_dns_batch_timeout(tb_dns_batch_ref_t batch);
+
+/*! spak the batch, send queries, recv responses and retransmit the timeout queries
+ *
+ * the finished names will be notified to the result func
+ *
+ * @param batch     the batch
+ *
+ * @return          1: all names are finished, 0: continue: -1: failed
+ */
+tb_long_t           tb_dns_batch_spak(tb_dns_batch_ref_t batch);
+
+/*! wait the batch, it will be suspended if be called in coroutine
+ *
+ * @param batch     the batch
+ * @param timeout   the timeout, it will be limited to the next retransmission
+ *
+ * @return          > 0: the socket events, 0: timeout, -1: failed
+ */
+tb_long_t           tb_dns_batch_wait(tb_dns_batch_ref_t batch, tb_long_t timeout);
+
+/*! look all posted names, block
+ *
+ * @param batch     the batch
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_dns_batch_done(tb_dns_batch_ref_t batch);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
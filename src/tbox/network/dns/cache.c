@@ -30,7 +30,9 @@
  * includes
  */
 #include "cache.h"
+#include "looker.h"
 #include "../../platform/platform.h"
+#include "../../libc/libc.h"
 #include "../../container/container.h"
 #include "../../algorithm/algorithm.h"
 
@@ -40,83 +42,288 @@
 
 // the cache maxn
 #ifdef __tb_small__
-#   define TB_DNS_CACHE_MAXN        (64)
+#   define TB_DNS_CACHE_MAXN            (256)
 #else
-#   define TB_DNS_CACHE_MAXN        (256)
+#   define TB_DNS_CACHE_MAXN            (4096)
 #endif
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * types
- */
+// the shard count, the names are distributed to the shards by hash for reducing the lock contention
+#ifdef __tb_small__
+#   define TB_DNS_CACHE_SHARDS          (4)
+#else
+#   define TB_DNS_CACHE_SHARDS          (16)
+#endif
 
-// the dns cache type
-typedef struct __tb_dns_cache_t
-{
-    // the hash
-    tb_hash_map_ref_t       hash;
+// the evicted item count if the shard is full
+#ifdef __tb_small__
+#   define TB_DNS_CACHE_EVICT           (4)
+#else
+#   define TB_DNS_CACHE_EVICT           (16)
+#endif
+
+// the min and max ttl (s)
+#define TB_DNS_CACHE_TTL_MIN            (1)
+#define TB_DNS_CACHE_TTL_MAX            (86400)
+
+// the max ttl (s) of the negative cache
+#define TB_DNS_CACHE_NEGATIVE_TTL_MAX   (3600)
 
-    // the times
-    tb_hize_t               times;
+// the stale time (ms), the expired address will be served while refreshing it in this time
+#define TB_DNS_CACHE_STALE              (60000)
 
-    // the expired
-    tb_size_t               expired;
+// the hot name will be prefetched if it has been hit some times and its ttl is only left 1/8
+#define TB_DNS_CACHE_PREFETCH_HITS      (2)
+#define TB_DNS_CACHE_PREFETCH_SHIFT     (3)
 
-}tb_dns_cache_t;
+// the refresh timeout (ms)
+#define TB_DNS_CACHE_REFRESH_TIMEOUT    (5000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
 
 // the dns cache addr type
 typedef struct __tb_dns_cache_addr_t
 {
-    // the addr
+    // the addr, it is empty for the negative cache
     tb_ipaddr_t             addr;
 
-    // the time
-    tb_size_t               time;
+    // the expired time (ms)
+    tb_hong_t               expired;
+
+    // the last accessed time (ms)
+    tb_hong_t               time;
+
+    // the ttl (s)
+    tb_uint32_t             ttl;
+
+    // the hit count after saving it
+    tb_uint16_t             hits;
+
+    // is refreshing?
+    tb_uint16_t             refreshing;
 
 }tb_dns_cache_addr_t;
 
+// the dns cache shard type
+typedef struct __tb_dns_cache_shard_t
+{
+    // the lock
+    tb_spinlock_t           lock;
+
+    // the hash
+    tb_hash_map_ref_t       hash;
+
+    // the stat
+    tb_dns_cache_stat_t     stat;
+
+}tb_dns_cache_shard_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
 
-// the lock
-static tb_spinlock_t        g_lock = TB_SPINLOCK_INIT;
+// the shards
+static tb_dns_cache_shard_t g_shards[TB_DNS_CACHE_SHARDS];
 
-// the cache
-static tb_dns_cache_t       g_cache = {0};
+// is exiting? stop refreshing
+static tb_atomic32_t        g_exiting = 0;
+
+// the running refresh count
+static tb_atomic32_t        g_refreshing = 0;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * helper
  */
-static __tb_inline__ tb_size_t tb_dns_cache_now()
+static __tb_inline__ tb_hong_t tb_dns_cache_now()
+{
+    return tb_cache_time_spak();
+}
+static tb_dns_cache_shard_t* tb_dns_cache_shard(tb_char_t const* name, tb_char_t* key, tb_size_t maxn)
 {
-    return (tb_size_t)(tb_cache_time_spak() / 1000);
+    // the name is case-insensitive and "www.tboox.org." is same as "www.tboox.org"
+    tb_size_t   n = 0;
+    tb_uint32_t h = 2166136261ul;
+    for (n = 0; name[n] && n < maxn - 1; n++)
+    {
+        key[n] = tb_tolower(name[n]);
+        h = (h ^ (tb_byte_t)key[n]) * 16777619ul;
+    }
+    tb_check_return_val(!name[n], tb_null);
+    if (n && key[n - 1] == '.')
+    {
+        n--;
+        h = 2166136261ul;
+        tb_size_t i = 0;
+        for (i = 0; i < n; i++) h = (h ^ (tb_byte_t)key[i]) * 16777619ul;
+    }
+    key[n] = '\0';
+    tb_check_return_val(n, tb_null);
+
+    // get the shard
+    return &g_shards[h % TB_DNS_CACHE_SHARDS];
 }
-static tb_bool_t tb_dns_cache_clear(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_bool_t tb_dns_cache_clear_expired(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
 {
     // check
-    tb_assert(item);
+    tb_assert(item && value);
 
     // the dns cache address
     tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)((tb_hash_map_item_ref_t)item)->data;
     tb_assert(caddr);
 
-    // is expired?
-    tb_bool_t ok = tb_false;
-    if (caddr->time < g_cache.expired)
+    // is expired? the negative cache need not be served after expiring
+    tb_hong_t now = *((tb_hong_t const*)value);
+    tb_bool_t ok = now >= caddr->expired + (tb_ipaddr_ip_is_empty((tb_ipaddr_ref_t)&caddr->addr)? 0 : TB_DNS_CACHE_STALE);
+
+    // trace
+    if (ok) tb_trace_d("del: %s => %{ipaddr}, expired: %lld", (tb_char_t const*)((tb_hash_map_item_ref_t)item)->name, &caddr->addr, caddr->expired);
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_dns_cache_evict(tb_dns_cache_shard_t* shard, tb_hong_t now)
+{
+    // remove the expired items first
+    tb_size_t size = tb_hash_map_size(shard->hash);
+    tb_remove_if(shard->hash, tb_dns_cache_clear_expired, &now);
+    shard->stat.evicted += size - tb_hash_map_size(shard->hash);
+    tb_check_return(tb_hash_map_size(shard->hash) >= TB_DNS_CACHE_MAXN / TB_DNS_CACHE_SHARDS);
+
+    /* remove some least recently used items at once,
+     * so we need not scan the full shard for every inserting if it is always full
+     */
+    tb_size_t           i = 0;
+    tb_size_t           n = 0;
+    tb_hong_t           times[TB_DNS_CACHE_EVICT];
+    tb_char_t const*    names[TB_DNS_CACHE_EVICT];
+    tb_for_all (tb_hash_map_item_ref_t, item, shard->hash)
+    {
+        // sort the oldest items by the accessed time
+        tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)item->data;
+        if (n < TB_DNS_CACHE_EVICT || caddr->time < times[n - 1])
+        {
+            if (n < TB_DNS_CACHE_EVICT) n++;
+            for (i = n - 1; i && times[i - 1] > caddr->time; i--)
+            {
+                times[i] = times[i - 1];
+                names[i] = names[i - 1];
+            }
+            times[i] = caddr->time;
+            names[i] = (tb_char_t const*)item->name;
+        }
+    }
+
+    // remove them, we need copy the name because it will be freed when removing
+    tb_char_t name[TB_DNS_NAME_MAXN];
+    for (i = 0; i < n; i++)
     {
+        // trace
+        tb_trace_d("del: %s, lru", names[i]);
+
         // remove it
-        ok = tb_true;
+        tb_strlcpy(name, names[i], sizeof(name));
+        tb_hash_map_remove(shard->hash, name);
+        shard->stat.evicted++;
+    }
+}
+static tb_void_t tb_dns_cache_refresh_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_char_t const* name = (tb_char_t const*)priv;
+    tb_assert_and_check_return(name);
+
+    // running, the cache will wait it when exiting
+    tb_atomic32_fetch_and_add(&g_refreshing, 1);
+
+    // done
+    tb_long_t           r = -1;
+    tb_ipaddr_t         addr;
+    tb_dns_looker_ref_t looker = tb_null;
+    do
+    {
+        // exiting?
+        tb_check_break(!tb_atomic32_get(&g_exiting));
 
         // trace
-        tb_trace_d("del: %s => %{ipaddr}, time: %u, size: %u", (tb_char_t const*)item->name, &caddr->addr, caddr->time, tb_hash_map_size(g_cache.hash));
+        tb_trace_d("refresh: %s: ..", name);
 
-        // update times
-        tb_assert(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
+        // init looker, it will save the result to the cache
+        tb_ipaddr_clear(&addr);
+        looker = tb_dns_looker_init(name);
+        tb_check_break(looker);
+
+        // look it and we wait it in slices to stop it quickly when exiting
+        tb_long_t timeout = 0;
+        while (!(r = tb_dns_looker_spak(looker, &addr)) && !tb_atomic32_get(&g_exiting))
+        {
+            // wait
+            tb_long_t e = 0;
+            for (timeout = 0; timeout < TB_DNS_CACHE_REFRESH_TIMEOUT && !tb_atomic32_get(&g_exiting); timeout += 100)
+            {
+                e = tb_dns_looker_wait(looker, 100);
+                tb_check_break(!e);
+            }
+
+            // failed or exiting?
+            if (e < 0 || tb_atomic32_get(&g_exiting))
+            {
+                r = -1;
+                break;
+            }
+        }
+
+    } while (0);
+
+    // exit looker
+    if (looker) tb_dns_looker_exit(looker);
+
+    // trace
+    tb_trace_d("refresh: %s: %s", name, r > 0? "ok" : "failed");
+
+    // failed? allow to refresh it again
+    if (r <= 0 && !tb_atomic32_get(&g_exiting))
+    {
+        tb_char_t               key[TB_DNS_NAME_MAXN];
+        tb_dns_cache_shard_t*   shard = tb_dns_cache_shard(name, key, sizeof(key));
+        if (shard)
+        {
+            tb_spinlock_enter(&shard->lock);
+            tb_dns_cache_addr_t* caddr = shard->hash? (tb_dns_cache_addr_t*)tb_hash_map_get(shard->hash, key) : tb_null;
+            if (caddr) caddr->refreshing = 0;
+            tb_spinlock_leave(&shard->lock);
+        }
     }
 
-    // ok?
-    return ok;
+    // finished
+    tb_atomic32_fetch_and_sub(&g_refreshing, 1);
+}
+static tb_void_t tb_dns_cache_refresh_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // exit name
+    if (priv) tb_free(priv);
+}
+static tb_void_t tb_dns_cache_refresh(tb_char_t const* key)
+{
+    // post a task to refresh it in background
+    tb_char_t* name = tb_strdup(key);
+    if (name && tb_thread_pool_task_post(tb_thread_pool(), "dns_refresh", tb_dns_cache_refresh_done, tb_dns_cache_refresh_exit, name, tb_false))
+        return ;
+
+    // failed
+    if (name) tb_free(name);
+    tb_trace_w("refresh: %s: post failed!", key);
+
+    // allow to refresh it again
+    tb_char_t               data[TB_DNS_NAME_MAXN];
+    tb_dns_cache_shard_t*   shard = tb_dns_cache_shard(key, data, sizeof(data));
+    if (shard)
+    {
+        tb_spinlock_enter(&shard->lock);
+        tb_dns_cache_addr_t* caddr = shard->hash? (tb_dns_cache_addr_t*)tb_hash_map_get(shard->hash, data) : tb_null;
+        if (caddr) caddr->refreshing = 0;
+        tb_spinlock_leave(&shard->lock);
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -124,24 +331,27 @@ static tb_bool_t tb_dns_cache_clear(tb_iterator_ref_t iterator, tb_cpointer_t it
  */
 tb_bool_t tb_dns_cache_init()
 {
-    // enter
-    tb_spinlock_enter(&g_lock);
-
     // done
-    tb_bool_t ok = tb_false;
-    do
+    tb_bool_t ok = tb_true;
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDS; i++)
     {
-        // init hash
-        if (!g_cache.hash) g_cache.hash = tb_hash_map_init(tb_align8(tb_isqrti(TB_DNS_CACHE_MAXN) + 1), tb_element_str(tb_false), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
-        tb_assert_and_check_break(g_cache.hash);
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
 
-        // ok
-        ok = tb_true;
+        // enter
+        tb_spinlock_enter(&shard->lock);
 
-    } while (0);
+        // init hash
+        if (!shard->hash) shard->hash = tb_hash_map_init(tb_align8(tb_isqrti(TB_DNS_CACHE_MAXN / TB_DNS_CACHE_SHARDS) + 1), tb_element_str(tb_true), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
+        if (!shard->hash) ok = tb_false;
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+        // leave
+        tb_spinlock_leave(&shard->lock);
+    }
+
+    // init exiting
+    tb_atomic32_set(&g_exiting, 0);
 
     // failed? exit it
     if (!ok) tb_dns_cache_exit();
@@ -151,32 +361,59 @@ tb_bool_t tb_dns_cache_init()
 }
 tb_void_t tb_dns_cache_exit()
 {
-    // enter
-    tb_spinlock_enter(&g_lock);
+    // stop and wait the running refresh tasks
+    tb_atomic32_set(&g_exiting, 1);
+    while (tb_atomic32_get(&g_refreshing)) tb_msleep(10);
 
-    // exit hash
-    if (g_cache.hash) tb_hash_map_exit(g_cache.hash);
-    g_cache.hash = tb_null;
+    // exit shards
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDS; i++)
+    {
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
 
-    // exit times
-    g_cache.times = 0;
+        // enter
+        tb_spinlock_enter(&shard->lock);
 
-    // exit expired
-    g_cache.expired = 0;
+        // exit hash
+        if (shard->hash) tb_hash_map_exit(shard->hash);
+        shard->hash = tb_null;
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+        // exit stat
+        tb_memset(&shard->stat, 0, sizeof(tb_dns_cache_stat_t));
+
+        // leave
+        tb_spinlock_leave(&shard->lock);
+    }
+}
+tb_void_t tb_dns_cache_clear()
+{
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDS; i++)
+    {
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
+
+        // clear it
+        tb_spinlock_enter(&shard->lock);
+        if (shard->hash) tb_hash_map_clear(shard->hash);
+        tb_spinlock_leave(&shard->lock);
+    }
 }
 tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
+{
+    return tb_dns_cache_look(name, addr) > 0;
+}
+tb_long_t tb_dns_cache_look(tb_char_t const* name, tb_ipaddr_ref_t addr)
 {
     // check
-    tb_assert_and_check_return_val(name && addr, tb_false);
+    tb_assert_and_check_return_val(name && addr, 0);
 
     // trace
     tb_trace_d("get: %s", name);
 
     // is addr?
-    tb_check_return_val(!tb_ipaddr_ip_cstr_set(addr, name, TB_IPADDR_FAMILY_NONE), tb_true);
+    tb_check_return_val(!tb_ipaddr_ip_cstr_set(addr, name, TB_IPADDR_FAMILY_NONE), 1);
 
     // is localhost?
     if (!tb_stricmp(name, "localhost"))
@@ -185,45 +422,99 @@ tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
         tb_ipaddr_ip_cstr_set(addr, "127.0.0.1", TB_IPADDR_FAMILY_IPV4);
 
         // ok
-        return tb_true;
+        return 1;
     }
 
     // clear address
     tb_ipaddr_clear(addr);
 
+    // get the shard
+    tb_char_t               key[TB_DNS_NAME_MAXN];
+    tb_dns_cache_shard_t*   shard = tb_dns_cache_shard(name, key, sizeof(key));
+    tb_check_return_val(shard, 0);
+
     // enter
-    tb_spinlock_enter(&g_lock);
+    tb_hong_t now = tb_dns_cache_now();
+    tb_spinlock_enter(&shard->lock);
 
     // done
-    tb_bool_t ok = tb_false;
+    tb_long_t ok = 0;
+    tb_bool_t refresh = tb_false;
     do
     {
         // check
-        tb_assert_and_check_break(g_cache.hash);
+        tb_assert_and_check_break(shard->hash);
 
         // get the host address
-        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(g_cache.hash, name);
-        tb_check_break(caddr);
+        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(shard->hash, key);
+        if (!caddr)
+        {
+            shard->stat.misses++;
+            break;
+        }
 
         // trace
-        tb_trace_d("get: %s => %{ipaddr}, time: %u => %u, size: %u", name, &caddr->addr, caddr->time, tb_dns_cache_now(), tb_hash_map_size(g_cache.hash));
+        tb_trace_d("get: %s => %{ipaddr}, ttl: %u, expired: %lld, now: %lld", key, &caddr->addr, caddr->ttl, caddr->expired, now);
 
         // update time
-        tb_assert_and_check_break(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
-        caddr->time = tb_dns_cache_now();
-        g_cache.times += caddr->time;
+        caddr->time = now;
+
+        // the negative cache?
+        tb_bool_t negative = tb_ipaddr_ip_is_empty(&caddr->addr);
+
+        // fresh?
+        if (now < caddr->expired)
+        {
+            // hit it
+            if (negative)
+            {
+                shard->stat.negative++;
+                ok = -1;
+                break;
+            }
+            shard->stat.hits++;
+
+            // prefetch it if the hot name will be expired soon
+            if (caddr->hits < TB_MAXU16) caddr->hits++;
+            if (    !caddr->refreshing && caddr->hits >= TB_DNS_CACHE_PREFETCH_HITS
+                &&  caddr->expired - now <= (((tb_hong_t)caddr->ttl * 1000) >> TB_DNS_CACHE_PREFETCH_SHIFT))
+                refresh = tb_true;
+        }
+        // stale? serve it and refresh it
+        else if (!negative && now < caddr->expired + TB_DNS_CACHE_STALE)
+        {
+            shard->stat.stale++;
+            if (!caddr->refreshing) refresh = tb_true;
+        }
+        // expired
+        else
+        {
+            tb_hash_map_remove(shard->hash, key);
+            shard->stat.misses++;
+            shard->stat.evicted++;
+            break;
+        }
+
+        // refresh it
+        if (refresh)
+        {
+            caddr->refreshing = 1;
+            shard->stat.refresh++;
+        }
 
         // save address
         tb_ipaddr_copy(addr, &caddr->addr);
 
         // ok
-        ok = tb_true;
+        ok = 1;
 
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave(&shard->lock);
+
+    // refresh it in background
+    if (refresh) tb_dns_cache_refresh(key);
 
     // ok?
     return ok;
@@ -231,58 +522,93 @@ tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
 tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
 {
     // check
-    tb_assert_and_check_return(name && addr);
+    tb_assert_and_check_return(addr);
+
+    // save it
+    tb_dns_cache_save(name, addr, TB_DNS_CACHE_TTL_MAX);
+}
+tb_void_t tb_dns_cache_save(tb_char_t const* name, tb_ipaddr_ref_t addr, tb_uint32_t ttl)
+{
+    // check
+    tb_assert_and_check_return(name);
 
     // check address
-    tb_assert(!tb_ipaddr_ip_is_empty(addr));
+    tb_assert(!addr || !tb_ipaddr_ip_is_empty(addr));
 
     // trace
-    tb_trace_d("set: %s => %{ipaddr}", name, addr);
+    tb_trace_d("set: %s => %{ipaddr}, ttl: %u", name, addr, ttl);
+
+    // get the shard
+    tb_char_t               key[TB_DNS_NAME_MAXN];
+    tb_dns_cache_shard_t*   shard = tb_dns_cache_shard(name, key, sizeof(key));
+    tb_check_return(shard);
 
     // init addr
     tb_dns_cache_addr_t caddr;
-    caddr.time = tb_dns_cache_now();
-    tb_ipaddr_copy(&caddr.addr, addr);
+    tb_memset(&caddr, 0, sizeof(tb_dns_cache_addr_t));
+    if (addr)
+    {
+        tb_ipaddr_copy(&caddr.addr, addr);
+        caddr.ttl = tb_max(tb_min(ttl, TB_DNS_CACHE_TTL_MAX), TB_DNS_CACHE_TTL_MIN);
+    }
+    else
+    {
+        tb_ipaddr_clear(&caddr.addr);
+        caddr.ttl = tb_max(tb_min(ttl, TB_DNS_CACHE_NEGATIVE_TTL_MAX), TB_DNS_CACHE_TTL_MIN);
+    }
+    caddr.time      = tb_dns_cache_now();
+    caddr.expired   = caddr.time + (tb_hong_t)caddr.ttl * 1000;
 
     // enter
-    tb_spinlock_enter(&g_lock);
+    tb_spinlock_enter(&shard->lock);
 
     // done
     do
     {
         // check
-        tb_assert_and_check_break(g_cache.hash);
-
-        // remove the expired items if full
-        if (tb_hash_map_size(g_cache.hash) >= TB_DNS_CACHE_MAXN)
-        {
-            // the expired time
-            g_cache.expired = ((tb_size_t)(g_cache.times / tb_hash_map_size(g_cache.hash)) + 1);
+        tb_check_break(shard->hash);
 
-            // check
-            tb_assert_and_check_break(g_cache.expired);
-
-            // trace
-            tb_trace_d("expired: %lu", g_cache.expired);
-
-            // remove the expired times
-            tb_remove_if(g_cache.hash, tb_dns_cache_clear, tb_null);
-        }
-
-        // check
-        tb_assert_and_check_break(tb_hash_map_size(g_cache.hash) < TB_DNS_CACHE_MAXN);
+        // remove the expired or least recently used items if full
+        if (tb_hash_map_size(shard->hash) >= TB_DNS_CACHE_MAXN / TB_DNS_CACHE_SHARDS && !tb_hash_map_get(shard->hash, key))
+            tb_dns_cache_evict(shard, caddr.time);
 
         // save addr
-        tb_hash_map_insert(g_cache.hash, name, &caddr);
-
-        // update times
-        g_cache.times += caddr.time;
+        tb_hash_map_insert(shard->hash, key, &caddr);
 
         // trace
-        tb_trace_d("set: %s => %{ipaddr}, time: %u, size: %u", name, &caddr.addr, caddr.time, tb_hash_map_size(g_cache.hash));
+        tb_trace_d("set: %s => %{ipaddr}, expired: %lld, size: %u", key, &caddr.addr, caddr.expired, tb_hash_map_size(shard->hash));
 
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave(&shard->lock);
+}
+tb_void_t tb_dns_cache_stat(tb_dns_cache_stat_t* stat)
+{
+    // check
+    tb_assert_and_check_return(stat);
+
+    // sum the stat of all shards
+    tb_size_t i = 0;
+    tb_memset(stat, 0, sizeof(tb_dns_cache_stat_t));
+    for (i = 0; i < TB_DNS_CACHE_SHARDS; i++)
+    {
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
+
+        // enter
+        tb_spinlock_enter(&shard->lock);
+
+        // sum it
+        if (shard->hash) stat->size += tb_hash_map_size(shard->hash);
+        stat->hits      += shard->stat.hits;
+        stat->misses    += shard->stat.misses;
+        stat->stale     += shard->stat.stale;
+        stat->negative  += shard->stat.negative;
+        stat->refresh   += shard->stat.refresh;
+        stat->evicted   += shard->stat.evicted;
+
+        // leave
+        tb_spinlock_leave(&shard->lock);
+    }
 }
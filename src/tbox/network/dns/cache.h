@@ -32,6 +32,43 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default ttl (s) of the negative cache if the response has no soa record
+#define TB_DNS_CACHE_NEGATIVE_TTL       (30)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the dns cache stat type
+typedef struct __tb_dns_cache_stat_t
+{
+    /// the cached name count
+    tb_size_t           size;
+
+    /// the hit count of the fresh addresses
+    tb_hize_t           hits;
+
+    /// the missed count
+    tb_hize_t           misses;
+
+    /// the hit count of the stale addresses, they are served while refreshing
+    tb_hize_t           stale;
+
+    /// the hit count of the negative cache
+    tb_hize_t           negative;
+
+    /// the background refresh count, including the prefetch of the hot names before expiring
+    tb_hize_t           refresh;
+
+    /// the evicted count
+    tb_hize_t           evicted;
+
+}tb_dns_cache_stat_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -47,6 +84,9 @@ tb_bool_t           tb_dns_cache_init(tb_noarg_t);
 /// exit the cache list
 tb_void_t           tb_dns_cache_exit(tb_noarg_t);
 
+/// clear the cache list
+tb_void_t           tb_dns_cache_clear(tb_noarg_t);
+
 /*! get addr from cache
  *
  * @param name      the host name
@@ -56,13 +96,39 @@ tb_void_t           tb_dns_cache_exit(tb_noarg_t);
  */
 tb_bool_t           tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
-/*! set addr to cache
+/*! look addr from cache
+ *
+ * the expired address will be still returned for a while and refreshed in background,
+ * and the hot name will be also refreshed before expiring.
+ *
+ * @param name      the host name
+ * @param addr      the host addr
+ *
+ * @return          1: ok, 0: not found, -1: the name does not exist (negative cache)
+ */
+tb_long_t           tb_dns_cache_look(tb_char_t const* name, tb_ipaddr_ref_t addr);
+
+/*! set addr to cache with the max ttl
  *
  * @param name      the host name
  * @param addr      the host addr
  */
 tb_void_t           tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
+/*! save the lookup result to cache
+ *
+ * @param name      the host name
+ * @param addr      the host addr, the name does not exist if be null (negative cache)
+ * @param ttl       the ttl (s)
+ */
+tb_void_t           tb_dns_cache_save(tb_char_t const* name, tb_ipaddr_ref_t addr, tb_uint32_t ttl);
+
+/*! get the cache stat
+ *
+ * @param stat      the stat
+ */
+tb_void_t           tb_dns_cache_stat(tb_dns_cache_stat_t* stat);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -29,5 +29,6 @@
 #include "cache.h"
 #include "server.h"
 #include "looker.h"
+#include "batch.h"
 
 #endif
@@ -79,6 +79,12 @@ typedef struct __tb_dns_looker_t
     // the tryn
     tb_size_t               tryn;
 
+    // the ttl (s) of the response
+    tb_uint32_t             ttl;
+
+    // the name does not exist?
+    tb_uint8_t              negative;
+
     // the socket
     tb_socket_ref_t         sock;
 
@@ -264,12 +270,12 @@ static tb_long_t tb_dns_looker_reqt(tb_dns_looker_t* looker)
     tb_trace_d("request: ok");
     return 1;
 }
-static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_t addr)
+static tb_long_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_t addr)
 {
     // the rpkt and size
     tb_byte_t const*    rpkt = tb_static_buffer_data(&looker->rpkt);
     tb_size_t           size = tb_static_buffer_size(&looker->rpkt);
-    tb_assert_and_check_return_val(rpkt && size >= TB_DNS_HEADER_SIZE, tb_false);
+    tb_assert_and_check_return_val(rpkt && size >= TB_DNS_HEADER_SIZE, -1);
 
     // init stream
     tb_static_stream_t stream;
@@ -277,15 +283,20 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
 
     // init header
     tb_dns_header_t header;
-    header.id           = tb_static_stream_read_u16_be(&stream); tb_static_stream_skip(&stream, 2);
+    header.id           = tb_static_stream_read_u16_be(&stream);
+    tb_size_t flags     = tb_static_stream_read_u16_be(&stream);
     header.question     = tb_static_stream_read_u16_be(&stream);
     header.answer       = tb_static_stream_read_u16_be(&stream);
     header.authority    = tb_static_stream_read_u16_be(&stream);
     header.resource     = tb_static_stream_read_u16_be(&stream);
 
+    // the response code, 0: no error, 3: the name does not exist
+    tb_size_t rcode = flags & 0xf;
+
     // trace
     tb_trace_d("response: size: %u",        size);
     tb_trace_d("response: id: 0x%04x",      header.id);
+    tb_trace_d("response: rcode: %lu",      rcode);
     tb_trace_d("response: question: %d",    header.question);
     tb_trace_d("response: answer: %d",      header.answer);
     tb_trace_d("response: authority: %d",   header.authority);
@@ -293,26 +304,30 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
     tb_trace_d("");
 
     // check header
-    tb_assert_and_check_return_val(header.id == TB_DNS_HEADER_MAGIC, tb_false);
+    tb_assert_and_check_return_val(header.id == TB_DNS_HEADER_MAGIC, -1);
+
+    // failed? try the next server
+    tb_check_return_val(rcode == 0 || rcode == 3, -1);
 
     // skip questions, only one question now.
     // name + question1 + question2 + ...
-    tb_assert_and_check_return_val(header.question == 1, tb_false);
+    tb_assert_and_check_return_val(header.question == 1, -1);
 #if 1
     tb_static_stream_skip_cstr(&stream);
     tb_static_stream_skip(&stream, 4);
 #else
     tb_char_t* name = tb_static_stream_read_cstr(&stream);
     //name = tb_dns_decode_name(name);
-    tb_assert_and_check_return_val(name, tb_false);
+    tb_assert_and_check_return_val(name, -1);
     tb_static_stream_skip(&stream, 4);
     tb_trace_d("response: name: %s", name);
 #endif
 
     // decode answers
-    tb_size_t i = 0;
-    tb_size_t found = 0;
-    for (i = 0; i < header.answer; i++)
+    tb_size_t   i = 0;
+    tb_size_t   found = 0;
+    tb_uint32_t ttl = TB_MAXU32;
+    for (i = 0; i < header.answer && rcode == 0 && tb_static_stream_left(&stream) >= 10; i++)
     {
         // decode answer
         tb_dns_answer_t answer;
@@ -332,8 +347,14 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
         tb_trace_d("response: ttl: %d",     answer.res.ttl);
         tb_trace_d("response: size: %d",    answer.res.size);
 
+        // check
+        tb_assert_and_check_return_val(tb_static_stream_left(&stream) >= answer.res.size, -1);
+
+        // the address is valid until any record of the alias chain is expired
+        if (answer.res.ttl < ttl) ttl = answer.res.ttl;
+
         // is ipv4?
-        if (answer.res.type == 1)
+        if (answer.res.type == 1 && answer.res.size == 4)
         {
             // get ipv4
             tb_byte_t b1 = tb_static_stream_read_u8(&stream);
@@ -371,11 +392,16 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
         }
         else
         {
-            // decode rdata
-            answer.rdata = (tb_byte_t*)tb_dns_decode_name(&stream, answer.name);
+            // skip rdata
+            tb_byte_t const* rdata = tb_static_stream_pos(&stream);
 
-            // trace
-            tb_trace_d("response: alias: %s", answer.rdata? (tb_char_t const*)answer.rdata : "");
+            // decode the alias
+            if (answer.res.type == 5)
+            {
+                answer.rdata = (tb_byte_t*)tb_dns_decode_name(&stream, answer.name);
+                tb_trace_d("response: alias: %s", answer.rdata? (tb_char_t const*)answer.rdata : "");
+            }
+            tb_static_stream_goto(&stream, (tb_byte_t*)rdata + answer.res.size);
         }
 
         // trace
@@ -383,89 +409,60 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
     }
 
     // found it?
-    tb_check_return_val(found, tb_false);
-
-#if 0
-    // decode authorities
-    for (i = 0; i < header.authority; i++)
+    if (found)
     {
-        // decode answer
-        tb_dns_answer_t answer;
-        tb_trace_d("response: authority: %d", i);
-
-        // decode dns name
-        tb_char_t* name = tb_dns_decode_name(&stream, answer.name);
-        tb_trace_d("response: name: %s", name? name : "");
-
-        // decode resource
-        answer.res.type =   tb_static_stream_read_u16_be(&stream);
-        answer.res.class_ = tb_static_stream_read_u16_be(&stream);
-        answer.res.ttl =    tb_static_stream_read_u32_be(&stream);
-        answer.res.size =   tb_static_stream_read_u16_be(&stream);
-        tb_trace_d("response: type: %d",    answer.res.type);
-        tb_trace_d("response: class: %d",   answer.res.class_);
-        tb_trace_d("response: ttl: %d",     answer.res.ttl);
-        tb_trace_d("response: size: %d",    answer.res.size);
+        looker->ttl = ttl;
+        return 1;
+    }
 
-        // is ipv4?
-        if (answer.res.type == 1)
-        {
-            tb_byte_t b1 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b2 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b3 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b4 = tb_static_stream_read_u8(&stream);
-            tb_trace_d("response: ipv4: %u.%u.%u.%u", b1, b2, b3, b4);
-        }
-        else
+    /* the name does not exist or has no ipv4 address, we cache it with the minimum of soa record
+     *
+     * soa: mname + rname + serial(4) + refresh(4) + retry(4) + expire(4) + minimum(4)
+     */
+    looker->ttl = TB_DNS_CACHE_NEGATIVE_TTL;
+    if (rcode == 0)
+    {
+        // skip the remaining answers
+        for (i++; i < header.answer && tb_static_stream_left(&stream) >= 10; i++)
         {
-            // decode data
-            answer.rdata = tb_dns_decode_name(&stream, answer.name);
-            tb_trace_d("response: server: %s", answer.rdata? answer.rdata : "");
+            tb_char_t name[TB_DNS_NAME_MAXN];
+            tb_dns_decode_name(&stream, name);
+            tb_static_stream_skip(&stream, 8);
+            tb_size_t rsize = tb_static_stream_read_u16_be(&stream);
+            tb_assert_and_check_return_val(tb_static_stream_left(&stream) >= rsize, -1);
+            tb_static_stream_skip(&stream, rsize);
         }
-        tb_trace_d("response: ");
     }
-
-    for (i = 0; i < header.resource; i++)
+    for (i = 0; i < header.authority && tb_static_stream_left(&stream) >= 10; i++)
     {
-        // decode answer
+        // decode authority
         tb_dns_answer_t answer;
-        tb_trace_d("response: resource: %d", i);
-
-        // decode dns name
-        tb_char_t* name = tb_dns_decode_name(&stream, answer.name);
-        tb_trace_d("response: name: %s", name? name : "");
-
-        // decode resource
-        answer.res.type =   tb_static_stream_read_u16_be(&stream);
-        answer.res.class_ = tb_static_stream_read_u16_be(&stream);
-        answer.res.ttl =    tb_static_stream_read_u32_be(&stream);
-        answer.res.size =   tb_static_stream_read_u16_be(&stream);
-        tb_trace_d("response: type: %d",    answer.res.type);
-        tb_trace_d("response: class: %d",   answer.res.class_);
-        tb_trace_d("response: ttl: %d",     answer.res.ttl);
-        tb_trace_d("response: size: %d",    answer.res.size);
+        tb_char_t const* name = tb_dns_decode_name(&stream, answer.name); tb_used(name);
+        answer.res.type     = tb_static_stream_read_u16_be(&stream);
+        answer.res.class_   = tb_static_stream_read_u16_be(&stream);
+        answer.res.ttl      = tb_static_stream_read_u32_be(&stream);
+        answer.res.size     = tb_static_stream_read_u16_be(&stream);
+        tb_assert_and_check_return_val(tb_static_stream_left(&stream) >= answer.res.size, -1);
 
-        // is ipv4?
-        if (answer.res.type == 1)
-        {
-            tb_byte_t b1 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b2 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b3 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b4 = tb_static_stream_read_u8(&stream);
-            tb_trace_d("response: ipv4: %u.%u.%u.%u", b1, b2, b3, b4);
-        }
-        else
+        // is soa?
+        if (answer.res.type == 6 && answer.res.size > 20)
         {
-            // decode data
-            answer.rdata = tb_dns_decode_name(&stream, answer.name);
-            tb_trace_d("response: alias: %s", answer.rdata? answer.rdata : "");
+            tb_static_stream_skip(&stream, answer.res.size - 4);
+            tb_uint32_t minimum = tb_static_stream_read_u32_be(&stream);
+            looker->ttl = tb_min(answer.res.ttl, minimum);
+
+            // trace
+            tb_trace_d("response: soa: %s, ttl: %u, minimum: %u", name, answer.res.ttl, minimum);
+            break;
         }
-        tb_trace_d("response: ");
+        else tb_static_stream_skip(&stream, answer.res.size);
     }
-#endif
 
-    // ok
-    return tb_true;
+    // trace
+    tb_trace_d("response: not found, negative ttl: %u", looker->ttl);
+
+    // not found
+    return 0;
 }
 static tb_long_t tb_dns_looker_resp(tb_dns_looker_t* looker, tb_ipaddr_ref_t addr)
 {
@@ -508,13 +505,22 @@ static tb_long_t tb_dns_looker_resp(tb_dns_looker_t* looker, tb_ipaddr_ref_t add
     }
 
     // done
-    if (!tb_dns_looker_resp_done(looker, addr)) return -1;
+    tb_long_t ok = tb_dns_looker_resp_done(looker, addr);
+    tb_check_return_val(ok >= 0, -1);
+
+    // the name does not exist? cache it and need not try the next server
+    if (!ok)
+    {
+        tb_dns_cache_save(tb_static_string_cstr(&looker->name), tb_null, looker->ttl);
+        looker->negative = 1;
+        return -1;
+    }
 
     // check
     tb_assert_and_check_return_val(tb_static_string_size(&looker->name) && !tb_ipaddr_ip_is_empty(addr), -1);
 
     // save address to cache
-    tb_dns_cache_set(tb_static_string_cstr(&looker->name), addr);
+    tb_dns_cache_save(tb_static_string_cstr(&looker->name), addr, looker->ttl);
 
     // finish it
     looker->step |= TB_DNS_LOOKER_STEP_RESP;
@@ -609,8 +615,8 @@ tb_long_t tb_dns_looker_spak(tb_dns_looker_ref_t self, tb_ipaddr_ref_t addr)
 
     } while (0);
 
-    // failed?
-    if (r < 0)
+    // failed? try the next server if the name may exist
+    if (r < 0 && !looker->negative)
     {
         // next
         if (looker->itor + 1 <= looker->maxn) looker->itor++;
@@ -685,7 +691,8 @@ tb_bool_t tb_dns_looker_done(tb_char_t const* name, tb_ipaddr_ref_t addr)
     tb_assert_and_check_return_val(name && addr, tb_false);
 
     // try to lookup it from cache first
-    if (tb_dns_cache_get(name, addr)) return tb_true;
+    tb_long_t c = tb_dns_cache_look(name, addr);
+    if (c) return c > 0;
 
     // init looker
     tb_dns_looker_ref_t looker = tb_dns_looker_init(name);
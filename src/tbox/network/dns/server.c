@@ -525,9 +525,40 @@ tb_void_t tb_dns_server_add(tb_char_t const* addr)
         // check
         tb_assert_and_check_break(g_list.list);
 
+        /* parse the port
+         *
+         * e.g.
+         * 8.8.8.8
+         * 127.0.0.1:5353
+         * [::1]:5353
+         */
+        tb_char_t           data[64];
+        tb_char_t const*    host = addr;
+        tb_uint16_t         port = TB_DNS_HOST_PORT;
+        tb_char_t const*    p = tb_strrchr(addr, ':');
+        if (p && (*addr == '[' || p == tb_strchr(addr, ':')))
+        {
+            // get host
+            tb_char_t const*    b = addr;
+            tb_char_t const*    e = p;
+            if (*b == '[')
+            {
+                b++;
+                if (e > b && e[-1] == ']') e--;
+                else e = b;
+            }
+            tb_assert_and_check_break(e > b && (tb_size_t)(e - b) < sizeof(data));
+            tb_strlcpy(data, b, e - b + 1);
+            host = data;
+
+            // get port
+            port = (tb_uint16_t)tb_stou32(p + 1);
+            tb_assert_and_check_break(port);
+        }
+
         // init server
         tb_dns_server_t server = {0};
-        if (!tb_ipaddr_set(&server.addr, addr, TB_DNS_HOST_PORT, TB_IPADDR_FAMILY_NONE)) break;
+        if (!tb_ipaddr_set(&server.addr, host, port, TB_IPADDR_FAMILY_NONE)) break;
 
         // add server
         tb_vector_insert_tail(g_list.list, &server);
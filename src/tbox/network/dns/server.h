@@ -61,7 +61,7 @@ tb_size_t           tb_dns_server_get(tb_ipaddr_t addr[2]);
 
 /*! add the server
  *
- * @param addr      the server address
+ * @param addr      the server address, e.g. "8.8.8.8", "127.0.0.1:5353" or "[::1]:5353"
  */
 tb_void_t           tb_dns_server_add(tb_char_t const* addr);
 
@@ -44,6 +44,13 @@
 #include "../algorithm/algorithm.h"
 #include "../container/container.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max size of the request data
+#define TB_HTTP_DATA_MAXN               (8192)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -72,6 +79,24 @@ typedef struct __tb_http_t
     // the head
     tb_hash_map_ref_t   head;
 
+    // the offset of the response body in the sstream, -1 if no response
+    tb_hong_t           body_offset;
+
+    // the response head data, it will be grown to option.head_maxn at most
+    tb_buffer_t         heads_data;
+
+    // the response heads (tb_http_head_t), they point to the response head data
+    tb_buffer_t         heads;
+
+    // the response head count
+    tb_size_t           heads_count;
+
+    // the response head map, it is built on demand
+    tb_hash_map_ref_t   heads_map;
+
+    // the response head map has been built?
+    tb_bool_t           heads_mapped;
+
     // is opened?
     tb_bool_t           bopened;
 
@@ -81,11 +106,44 @@ typedef struct __tb_http_t
     // the cookies
     tb_string_t         cookies;
 
-    // the request/response data for decreasing stack size
-    tb_char_t           data[8192];
+    // the request data for decreasing stack size
+    tb_char_t           data[TB_HTTP_DATA_MAXN];
 
 }tb_http_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the well-known head names, the index is the head id
+static struct
+{
+    tb_char_t const*    name;
+    tb_size_t           size;
+
+}g_http_heads[] =
+{
+    {tb_null, 0}
+,   {"Accept-Ranges", 13}
+,   {"Age", 3}
+,   {"Cache-Control", 13}
+,   {"Connection", 10}
+,   {"Content-Encoding", 16}
+,   {"Content-Length", 14}
+,   {"Content-Range", 13}
+,   {"Content-Type", 12}
+,   {"Date", 4}
+,   {"ETag", 4}
+,   {"Expires", 7}
+,   {"Keep-Alive", 10}
+,   {"Last-Modified", 13}
+,   {"Location", 8}
+,   {"Server", 6}
+,   {"Set-Cookie", 10}
+,   {"Transfer-Encoding", 17}
+,   {"Vary", 4}
+};
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -115,6 +173,9 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
         // reset keep-alive and close socket first before connecting anthor host
         if (host_changed && !tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false)) break;
 
+        // reuse the keep-alive connection from the pool
+        if (!tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SOCK_SET_POOL, http->option.pool)) break;
+
         // dump option
 #if defined(__tb_debug__) && TB_TRACE_MODULE_DEBUG
         tb_http_option_dump(&http->option);
@@ -125,6 +186,7 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
 
         // clear status
         tb_http_status_cler(&http->status, host_changed);
+        http->body_offset = -1;
 
         // open stream
         if (!tb_stream_open(http->stream)) break;
@@ -198,7 +260,7 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         tb_hash_map_insert(http->head, "Accept", "*/*");
 
         // init connection
-        tb_hash_map_insert(http->head, "Connection", http->status.balived? "keep-alive" : "close");
+        tb_hash_map_insert(http->head, "Connection", (http->status.balived || http->option.pool)? "keep-alive" : "close");
 
         // init cookies
         tb_bool_t cookie = tb_false;
@@ -392,7 +454,7 @@ static tb_bool_t tb_http_request(tb_http_t* http)
  * Connection: close
  * Content-Type: application/x-shockwave-flash
  */
-static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, tb_size_t indx)
+static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t* line, tb_size_t size, tb_size_t indx)
 {
     // check
     tb_assert_and_check_return_val(http && http->sstream && line, tb_false);
@@ -402,7 +464,7 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
     if (!indx)
     {
         // check http response
-        if (tb_strnicmp(p, "HTTP/1.", 7))
+        if (size < 8 || tb_strnicmp(p, "HTTP/1.", 7))
         {
             // failed
             tb_assert(0);
@@ -411,7 +473,6 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
 
         // seek to the http version
         p += 7;
-        tb_assert_and_check_return_val(*p, tb_false);
 
         // parse version
         tb_assert_and_check_return_val((*p - '0') < 2, tb_false);
@@ -437,6 +498,9 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
             http->status.state = TB_STATE_HTTP_RESPONSE_500 + (http->status.code - 500);
         else http->status.state = TB_STATE_HTTP_RESPONSE_UNK;
 
+        // HTTP/1.1 is keep-alive by default if we can reuse it from the pool
+        if (http->option.pool) http->status.balived = http->status.version;
+
         // check state code: 4xx & 5xx
         if (http->status.code >= 400 && http->status.code < 600) return tb_false;
     }
@@ -444,217 +508,433 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
     else
     {
         // seek to value
-        while (*p && *p != ':') p++;
-        tb_assert_and_check_return_val(*p, tb_false);
-        p++; while (*p && tb_isspace(*p)) p++;
+        tb_char_t* e = line + size;
+        tb_char_t* v = (tb_char_t*)tb_memchr(line, ':', size);
+        tb_assert_and_check_return_val(v, tb_false);
+
+        // get the name and strip the trailing spaces
+        tb_char_t* n = v;
+        while (n > line && tb_isspace(n[-1])) n--;
+        *n = '\0';
+
+        // get the value and strip the spaces
+        v++; while (v < e && tb_isspace(*v)) v++;
+        while (e > v && tb_isspace(e[-1])) e--;
+        *e = '\0';
+
+        // intern the head name
+        tb_size_t id = tb_http_head_intern(line, n - line);
+
+        /* save the head view
+         *
+         * the head views will be grown with the head data, so they are limited by option.head_maxn only
+         */
+        tb_http_head_t head;
+        head.id         = id;
+        head.name       = line;
+        head.name_size  = n - line;
+        head.value      = v;
+        head.value_size = e - v;
+        if (!tb_buffer_memncat(&http->heads, (tb_byte_t const*)&head, sizeof(tb_http_head_t))) return tb_false;
+        http->heads_count++;
 
         // no value
+        p = v;
         tb_check_return_val(*p, tb_true);
 
-        // parse content size
-        if (!tb_strnicmp(line, "Content-Length", 14))
-        {
-            http->status.content_size = tb_stou64(p);
-            if (http->status.document_size < 0)
-                http->status.document_size = http->status.content_size;
-        }
-        // parse content range: "bytes $from-$to/$document_size"
-        else if (!tb_strnicmp(line, "Content-Range", 13))
+        // parse the well-known heads
+        switch (id)
         {
-            tb_hize_t from = 0;
-            tb_hize_t to = 0;
-            tb_hize_t document_size = 0;
-            if (!tb_strncmp(p, "bytes ", 6))
+        case TB_HTTP_HEAD_CONTENT_LENGTH:
             {
-                p += 6;
-                from = tb_stou64(p);
-                while (*p && *p != '-') p++;
-                if (*p && *p++ == '-') to = tb_stou64(p);
-                while (*p && *p != '/') p++;
-                if (*p && *p++ == '/') document_size = tb_stou64(p);
+                // parse content size
+                http->status.content_size = tb_stou64(p);
+                if (http->status.document_size < 0)
+                    http->status.document_size = http->status.content_size;
             }
-            // no stream, be able to seek
-            http->status.bseeked = 1;
-            http->status.document_size = document_size;
-            if (http->status.content_size < 0)
+            break;
+        case TB_HTTP_HEAD_CONTENT_RANGE:
             {
-                if (from && to > from) http->status.content_size = to - from;
-                else if (!from && to) http->status.content_size = to;
-                else if (from && !to && document_size > from) http->status.content_size = document_size - from;
-                else http->status.content_size = document_size;
+                // parse content range: "bytes $from-$to/$document_size"
+                tb_hize_t from = 0;
+                tb_hize_t to = 0;
+                tb_hize_t document_size = 0;
+                if (!tb_strncmp(p, "bytes ", 6))
+                {
+                    p += 6;
+                    from = tb_stou64(p);
+                    while (*p && *p != '-') p++;
+                    if (*p && *p++ == '-') to = tb_stou64(p);
+                    while (*p && *p != '/') p++;
+                    if (*p && *p++ == '/') document_size = tb_stou64(p);
+                }
+                // no stream, be able to seek
+                http->status.bseeked = 1;
+                http->status.document_size = document_size;
+                if (http->status.content_size < 0)
+                {
+                    if (from && to > from) http->status.content_size = to - from;
+                    else if (!from && to) http->status.content_size = to;
+                    else if (from && !to && document_size > from) http->status.content_size = document_size - from;
+                    else http->status.content_size = document_size;
+                }
             }
-        }
-        // parse accept-ranges: "bytes "
-        else if (!tb_strnicmp(line, "Accept-Ranges", 13))
-        {
-            // no stream, be able to seek
+            break;
+        case TB_HTTP_HEAD_ACCEPT_RANGES:
+            // parse accept-ranges: "bytes ", no stream, be able to seek
             http->status.bseeked = 1;
-        }
-        // parse content type
-        else if (!tb_strnicmp(line, "Content-Type", 12))
-        {
-            tb_string_cstrcpy(&http->status.content_type, p);
+            break;
+        case TB_HTTP_HEAD_CONTENT_TYPE:
+            // parse content type
+            tb_string_cstrncpy(&http->status.content_type, p, e - p);
             tb_assert_and_check_return_val(tb_string_size(&http->status.content_type), tb_false);
-        }
-        // parse transfer encoding
-        else if (!tb_strnicmp(line, "Transfer-Encoding", 17))
-        {
+            break;
+        case TB_HTTP_HEAD_TRANSFER_ENCODING:
+            // parse transfer encoding
             if (!tb_stricmp(p, "chunked")) http->status.bchunked = 1;
-        }
-        // parse content encoding
-        else if (!tb_strnicmp(line, "Content-Encoding", 16))
-        {
+            break;
+        case TB_HTTP_HEAD_CONTENT_ENCODING:
+            // parse content encoding
             if (!tb_stricmp(p, "gzip")) http->status.bgzip = 1;
             else if (!tb_stricmp(p, "deflate")) http->status.bdeflate = 1;
-        }
-        // parse location
-        else if (!tb_strnicmp(line, "Location", 8))
-        {
-            // redirect? check code: 301 - 307
-            tb_assert_and_check_return_val(http->status.code > 300 && http->status.code < 308, tb_false);
+            break;
+        case TB_HTTP_HEAD_LOCATION:
+            {
+                // redirect? check code: 301 - 307
+                tb_assert_and_check_return_val(http->status.code > 300 && http->status.code < 308, tb_false);
 
-            // save location
-            tb_string_cstrcpy(&http->status.location, p);
-        }
-        // parse connection
-        else if (!tb_strnicmp(line, "Connection", 10))
-        {
-            // keep alive?
+                // save location
+                tb_string_cstrncpy(&http->status.location, p, e - p);
+            }
+            break;
+        case TB_HTTP_HEAD_CONNECTION:
+            // keep alive? the socket will be kept after reading the response completely
             http->status.balived = !tb_stricmp(p, "close")? 0 : 1;
+            break;
+        case TB_HTTP_HEAD_SET_COOKIE:
+            {
+                // no cookies?
+                tb_check_break(http->option.cookies);
 
-            // ctrl stream for sock
-            if (!tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, http->status.balived? tb_true : tb_false)) return tb_false;
-        }
-        // parse cookies
-        else if (http->option.cookies && !tb_strnicmp(line, "Set-Cookie", 10))
-        {
-            // the host
-            tb_char_t const* host = tb_null;
-            tb_http_ctrl((tb_http_ref_t)http, TB_HTTP_OPTION_GET_HOST, &host);
+                // the host
+                tb_char_t const* host = tb_null;
+                tb_http_ctrl((tb_http_ref_t)http, TB_HTTP_OPTION_GET_HOST, &host);
 
-            // the path
-            tb_char_t const* path = tb_null;
-            tb_http_ctrl((tb_http_ref_t)http, TB_HTTP_OPTION_GET_PATH, &path);
+                // the path
+                tb_char_t const* path = tb_null;
+                tb_http_ctrl((tb_http_ref_t)http, TB_HTTP_OPTION_GET_PATH, &path);
 
-            // is ssl?
-            tb_bool_t bssl = tb_false;
-            tb_http_ctrl((tb_http_ref_t)http, TB_HTTP_OPTION_GET_SSL, &bssl);
+                // is ssl?
+                tb_bool_t bssl = tb_false;
+                tb_http_ctrl((tb_http_ref_t)http, TB_HTTP_OPTION_GET_SSL, &bssl);
 
-            // set cookies
-            tb_cookies_set(http->option.cookies, host, path, bssl, p);
+                // set cookies
+                tb_cookies_set(http->option.cookies, host, path, bssl, p);
+            }
+            break;
+        default:
+            break;
         }
     }
 
     // ok
     return tb_true;
 }
+static tb_void_t tb_http_response_move(tb_http_t* http, tb_char_t const* head, tb_char_t* base)
+{
+    // update the head views to the new head data
+    tb_size_t       i = 0;
+    tb_http_head_t* views = (tb_http_head_t*)tb_buffer_data(&http->heads);
+    for (i = 0; i < http->heads_count; i++)
+    {
+        tb_http_head_t* view = &views[i];
+        view->name  = base + (view->name - head);
+        view->value = base + (view->value - head);
+    }
+}
 static tb_bool_t tb_http_response(tb_http_t* http)
 {
     // check
     tb_assert_and_check_return_val(http && http->stream, tb_false);
 
+    // clear heads
+    tb_buffer_clear(&http->heads);
+    http->heads_count  = 0;
+    http->heads_mapped = tb_false;
+
     // done
     tb_bool_t ok = tb_false;
     do
     {
-        // read line
-        tb_long_t real = 0;
-        tb_size_t indx = 0;
-        while ((real = tb_stream_bread_line(http->stream, http->data, sizeof(http->data) - 1)) >= 0)
+        /* read the response head to the head data in one pass
+         *
+         * we peek the stream cache and scan the lines of the new data by the vectorized memchr,
+         * each line is parsed in place and the body data is left in the stream cache.
+         *
+         * the head data will be grown to option.head_maxn at most.
+         */
+        tb_bool_t   end = tb_false;
+        tb_bool_t   failed = tb_false;
+        tb_size_t   indx = 0;
+        tb_size_t   size = 0;
+        tb_size_t   line = 0;
+        while (!end && !failed && !tb_stream_is_killed(http->stream))
         {
-            // trace
-            tb_trace_d("response: %s", http->data);
+            // peek data
+            tb_byte_t*  data = tb_null;
+            tb_long_t   real = tb_stream_peek(http->stream, &data, TB_STREAM_BLOCK_MAXN);
+            if (real > 0)
+            {
+                // the head is too large?
+                tb_size_t maxn = http->option.head_maxn;
+                tb_size_t left = maxn > size + 1? maxn - 1 - size : 0;
+                if (!left)
+                {
+                    tb_trace_e("response: the head is too large, maxn: %lu!", maxn);
+                    break;
+                }
+
+                // grow the head data
+                tb_size_t   need = tb_min((tb_size_t)real, left);
+                tb_char_t*  head = (tb_char_t*)tb_buffer_data(&http->heads_data);
+                tb_char_t*  base = (tb_char_t*)tb_buffer_resize(&http->heads_data, size + need + 1);
+                if (!base)
+                {
+                    failed = tb_true;
+                    break;
+                }
 
-            // do callback
-            if (http->option.head_func && !http->option.head_func(http->data, http->option.head_priv)) break;
+                // the head data has been moved? update the head views
+                if (base != head) tb_http_response_move(http, head, base);
 
-            // end?
-            if (!real)
-            {
-                // switch to cstream if chunked
-                if (http->status.bchunked)
+                // append the new data
+                tb_size_t scan = size;
+                tb_memcpy(base + size, data, need);
+                size += need;
+
+                // scan the lines
+                tb_char_t*  p = base + scan;
+                tb_char_t*  e = base + size;
+                tb_char_t*  n = tb_null;
+                while (p < e && (n = (tb_char_t*)tb_memchr(p, '\n', e - p)))
                 {
-                    // init cstream
-                    if (http->cstream)
+                    // get this line
+                    tb_char_t* b = base + line;
+                    tb_char_t* t = n;
+                    if (t > b && t[-1] == '\r') t--;
+                    *t = '\0';
+                    line = n + 1 - base;
+                    p = n + 1;
+
+                    // trace
+                    tb_trace_d("response: %s", b);
+
+                    // do callback
+                    if (http->option.head_func && !http->option.head_func(b, http->option.head_priv))
                     {
-                        if (!tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_SET_STREAM, http->stream)) break;
+                        failed = tb_true;
+                        break;
                     }
-                    else http->cstream = tb_stream_init_filter_from_chunked(http->stream, tb_true);
-                    tb_assert_and_check_break(http->cstream);
-
-                    // open cstream, need not async
-                    if (!tb_stream_open(http->cstream)) break;
 
-                    // using cstream
-                    http->stream = http->cstream;
+                    // end?
+                    if (t == b)
+                    {
+                        end = tb_true;
+                        break;
+                    }
 
-                    // disable seek
-                    http->status.bseeked = 0;
+                    // done it
+                    if (!tb_http_response_done(http, b, t - b, indx++))
+                    {
+                        failed = tb_true;
+                        break;
+                    }
                 }
 
-                // switch to zstream if gzip or deflate
-                if (http->option.bunzip && (http->status.bgzip || http->status.bdeflate))
-                {
+                // skip the head data and the body data is left
+                if (!tb_stream_skip(http->stream, (end? line : size) - scan)) failed = tb_true;
+            }
+            // no data? wait it
+            else if (!real)
+            {
+                real = tb_stream_wait(http->stream, TB_STREAM_WAIT_READ, tb_stream_timeout(http->stream));
+                tb_check_break(real > 0);
+            }
+            // failed or end?
+            else break;
+        }
+        tb_check_break(end && !failed);
+
+        // save the body offset
+        http->body_offset = tb_stream_offset(http->sstream);
+
+        // switch to cstream if chunked
+        if (http->status.bchunked)
+        {
+            // init cstream
+            if (http->cstream)
+            {
+                if (!tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_SET_STREAM, http->stream)) break;
+            }
+            else http->cstream = tb_stream_init_filter_from_chunked(http->stream, tb_true);
+            tb_assert_and_check_break(http->cstream);
+
+            // open cstream, need not async
+            if (!tb_stream_open(http->cstream)) break;
+
+            // using cstream
+            http->stream = http->cstream;
+
+            // disable seek
+            http->status.bseeked = 0;
+        }
+
+        // switch to zstream if gzip or deflate
+        if (http->option.bunzip && (http->status.bgzip || http->status.bdeflate))
+        {
 #if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
-                    // init zstream
-                    if (http->zstream)
-                    {
-                        if (!tb_stream_ctrl(http->zstream, TB_STREAM_CTRL_FLTR_SET_STREAM, http->stream)) break;
-                    }
-                    else http->zstream = tb_stream_init_filter_from_zip(http->stream, http->status.bgzip? TB_ZIP_ALGO_GZIP : TB_ZIP_ALGO_ZLIB, TB_ZIP_ACTION_INFLATE);
-                    tb_assert_and_check_break(http->zstream);
+            // init zstream
+            if (http->zstream)
+            {
+                if (!tb_stream_ctrl(http->zstream, TB_STREAM_CTRL_FLTR_SET_STREAM, http->stream)) break;
+            }
+            else http->zstream = tb_stream_init_filter_from_zip(http->stream, http->status.bgzip? TB_ZIP_ALGO_GZIP : TB_ZIP_ALGO_ZLIB, TB_ZIP_ACTION_INFLATE);
+            tb_assert_and_check_break(http->zstream);
 
-                    // the filter
-                    tb_filter_ref_t filter = tb_null;
-                    if (!tb_stream_ctrl(http->zstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter)) break;
-                    tb_assert_and_check_break(filter);
+            // the filter
+            tb_filter_ref_t filter = tb_null;
+            if (!tb_stream_ctrl(http->zstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter)) break;
+            tb_assert_and_check_break(filter);
 
-                    // ctrl filter
-                    if (!tb_filter_ctrl(filter, TB_FILTER_CTRL_ZIP_SET_ALGO, http->status.bgzip? TB_ZIP_ALGO_GZIP : TB_ZIP_ALGO_ZLIB, TB_ZIP_ACTION_INFLATE)) break;
+            // ctrl filter
+            if (!tb_filter_ctrl(filter, TB_FILTER_CTRL_ZIP_SET_ALGO, http->status.bgzip? TB_ZIP_ALGO_GZIP : TB_ZIP_ALGO_ZLIB, TB_ZIP_ACTION_INFLATE)) break;
 
-                    // limit the filter input size
-                    if (http->status.content_size > 0) tb_filter_limit(filter, http->status.content_size);
+            // limit the filter input size
+            if (http->status.content_size > 0) tb_filter_limit(filter, http->status.content_size);
 
-                    // open zstream, need not async
-                    if (!tb_stream_open(http->zstream)) break;
+            // open zstream, need not async
+            if (!tb_stream_open(http->zstream)) break;
 
-                    // using zstream
-                    http->stream = http->zstream;
+            // using zstream
+            http->stream = http->zstream;
 
-                    // disable seek
-                    http->status.bseeked = 0;
+            // disable seek
+            http->status.bseeked = 0;
 #else
-                    // trace
-                    tb_trace_w("gzip is not supported now! please enable it from config if you need it.");
+            // trace
+            tb_trace_w("gzip is not supported now! please enable it from config if you need it.");
 
-                    // not supported
-                    http->status.state = TB_STATE_HTTP_GZIP_NOT_SUPPORTED;
-                    break;
+            // not supported
+            http->status.state = TB_STATE_HTTP_GZIP_NOT_SUPPORTED;
+            break;
 #endif
-                }
+        }
 
-                // trace
-                tb_trace_d("response: ok");
+        // trace
+        tb_trace_d("response: ok");
 
-                // dump status
+        // dump status
 #if defined(__tb_debug__) && TB_TRACE_MODULE_DEBUG
-                tb_http_status_dump(&http->status);
+        tb_http_status_dump(&http->status);
 #endif
 
-                // ok
-                ok = tb_true;
-                break;
-            }
-
-            // done it
-            if (!tb_http_response_done(http, http->data, indx++)) break;
-        }
+        // ok
+        ok = tb_true;
 
     } while (0);
 
     // ok?
     return ok;
 }
+static tb_bool_t tb_http_alive(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http && http->sstream, tb_false);
+
+    // keep-alive and the response has been received?
+    tb_check_return_val(http->status.balived && http->body_offset >= 0, tb_false);
+
+    // killed or failed?
+    tb_check_return_val(!tb_stream_is_killed(http->sstream) && tb_stream_state(http->sstream) == TB_STATE_OK, tb_false);
+
+    // no content?
+    tb_size_t code = http->status.code;
+    if (http->option.method == TB_HTTP_METHOD_HEAD || code == 204 || code == 304 || (code >= 100 && code < 200))
+        return tb_true;
+
+    // chunked? the last chunk has been read
+    if (http->status.bchunked)
+    {
+        tb_filter_ref_t filter = tb_null;
+        return http->cstream && tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter) && filter && tb_filter_beof(filter);
+    }
+
+    // the content has been read completely?
+    return http->status.content_size >= 0 && tb_stream_offset(http->sstream) == (tb_hize_t)(http->body_offset + http->status.content_size);
+}
+static tb_bool_t tb_http_clos(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http, tb_false);
+
+    // only keep the socket alive if the response has been read completely, otherwise it can not be reused
+    if (http->sstream) tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_http_alive(http));
+    http->body_offset = -1;
+
+    // close stream
+    tb_bool_t ok = http->stream? tb_stream_clos(http->stream) : tb_true;
+
+    // switch to sstream
+    http->stream = http->sstream;
+    return ok;
+}
+static tb_bool_t tb_http_method_idempotent(tb_size_t method)
+{
+    switch (method)
+    {
+    case TB_HTTP_METHOD_GET:
+    case TB_HTTP_METHOD_HEAD:
+    case TB_HTTP_METHOD_PUT:
+    case TB_HTTP_METHOD_OPTIONS:
+    case TB_HTTP_METHOD_DELETE:
+    case TB_HTTP_METHOD_TRACE:
+        return tb_true;
+    default:
+        break;
+    }
+    return tb_false;
+}
+static tb_bool_t tb_http_exchange(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http && http->sstream, tb_false);
+
+    // connect, request and response it
+    if (tb_http_connect(http) && tb_http_request(http) && tb_http_response(http)) return tb_true;
+
+    /* the idle connection from the pool may have been closed by the server before we send the request,
+     * so we retry it once with a new connection if no response has been received
+     *
+     * we only retry the idempotent request, because the non-idempotent request (e.g. POST)
+     * may have been received and processed by the server before the connection was closed
+     */
+    tb_bool_t reused = tb_false;
+    if (    !http->status.code && tb_http_method_idempotent(http->option.method) && !tb_stream_is_killed(http->sstream)
+        &&  tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_GET_REUSED, &reused) && reused)
+    {
+        // trace
+        tb_trace_d("exchange: the reused connection has been closed, retry it");
+
+        // close the reused connection
+        tb_http_clos(http);
+
+        // retry it
+        return tb_http_connect(http) && tb_http_request(http) && tb_http_response(http);
+    }
+
+    // failed
+    return tb_false;
+}
 static tb_bool_t tb_http_redirect(tb_http_t* http)
 {
     // check
@@ -688,10 +968,7 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
         }
 
         // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        if (!tb_http_clos(http)) break;
 
         // get location url
         tb_char_t const* location = tb_string_cstr(&http->status.location);
@@ -716,14 +993,8 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
             break;
         }
 
-        // connect it
-        if (!(ok = tb_http_connect(http))) break;
-
-        // request it
-        if (!(ok = tb_http_request(http))) break;
-
-        // response it
-        if (!(ok = tb_http_response(http))) break;
+        // connect, request and response it
+        if (!(ok = tb_http_exchange(http))) break;
     }
 
     // ok?
@@ -758,6 +1029,12 @@ tb_http_ref_t tb_http_init()
         // init cookies data
         if (!tb_string_init(&http->cookies)) break;
 
+        // init the response head data
+        if (!tb_buffer_init(&http->heads_data)) break;
+
+        // init the response heads
+        if (!tb_buffer_init(&http->heads)) break;
+
         // init option
         if (!tb_http_option_init(&http->option)) break;
 
@@ -824,10 +1101,20 @@ tb_void_t tb_http_exit(tb_http_ref_t self)
     // exit request data
     tb_string_exit(&http->request);
 
+    // exit the response head data
+    tb_buffer_exit(&http->heads_data);
+
+    // exit the response heads
+    tb_buffer_exit(&http->heads);
+
     // exit head
     if (http->head) tb_hash_map_exit(http->head);
     http->head = tb_null;
 
+    // exit the response head map
+    if (http->heads_map) tb_hash_map_exit(http->heads_map);
+    http->heads_map = tb_null;
+
     // free it
     tb_free(http);
 }
@@ -862,14 +1149,8 @@ tb_bool_t tb_http_open(tb_http_ref_t self)
     tb_bool_t ok = tb_false;
     do
     {
-        // connect it
-        if (!tb_http_connect(http)) break;
-
-        // request it
-        if (!tb_http_request(http)) break;
-
-        // response it
-        if (!tb_http_response(http)) break;
+        // connect, request and response it
+        if (!tb_http_exchange(http)) break;
 
         // redirect it
         if (!tb_http_redirect(http)) break;
@@ -880,14 +1161,7 @@ tb_bool_t tb_http_open(tb_http_ref_t self)
     } while (0);
 
     // failed? close it
-    if (!ok)
-    {
-        // close stream
-        if (http->stream) tb_stream_clos(http->stream);
-
-        // switch to sstream
-        http->stream = http->sstream;
-    }
+    if (!ok) tb_http_clos(http);
 
     // is opened?
     http->bopened = ok;
@@ -905,10 +1179,7 @@ tb_bool_t tb_http_close(tb_http_ref_t self)
     tb_check_return_val(http->bopened, tb_true);
 
     // close stream
-    if (http->stream && !tb_stream_clos(http->stream)) return tb_false;
-
-    // switch to sstream
-    http->stream = http->sstream;
+    if (!tb_http_clos(http)) return tb_false;
 
     // clear opened
     http->bopened = tb_false;
@@ -933,10 +1204,7 @@ tb_bool_t tb_http_seek(tb_http_ref_t self, tb_hize_t offset)
     do
     {
         // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        if (!tb_http_clos(http)) break;
 
         // trace
         tb_trace_d("seek: %llu", offset);
@@ -945,14 +1213,8 @@ tb_bool_t tb_http_seek(tb_http_ref_t self, tb_hize_t offset)
         http->option.range.bof = offset;
         http->option.range.eof = http->status.document_size > 0? http->status.document_size - 1 : 0;
 
-        // connect it
-        if (!tb_http_connect(http)) break;
-
-        // request it
-        if (!tb_http_request(http)) break;
-
-        // response it
-        if (!tb_http_response(http)) break;
+        // connect, request and response it
+        if (!tb_http_exchange(http)) break;
 
         // ok
         ok = tb_true;
@@ -1047,4 +1309,74 @@ tb_http_status_t const* tb_http_status(tb_http_ref_t self)
     // the status
     return &http->status;
 }
+tb_http_head_t const* tb_http_response_heads(tb_http_ref_t self, tb_size_t* pcount)
+{
+    // check
+    tb_http_t* http = (tb_http_t*)self;
+    tb_assert_and_check_return_val(http, tb_null);
+
+    // the heads
+    if (pcount) *pcount = http->heads_count;
+    return http->heads_count? (tb_http_head_t const*)tb_buffer_data(&http->heads) : tb_null;
+}
+tb_char_t const* tb_http_response_head(tb_http_ref_t self, tb_char_t const* name)
+{
+    // check
+    tb_http_t* http = (tb_http_t*)self;
+    tb_assert_and_check_return_val(http && name, tb_null);
+
+    // no heads?
+    tb_check_return_val(http->heads_count, tb_null);
+
+    /* build the head map on the first lookup
+     *
+     * the hash of tb_element_str() is case-sensitive, so we use the lower names as the keys
+     */
+    tb_char_t   key[256];
+    tb_size_t   i = 0;
+    tb_size_t   n = 0;
+    if (!http->heads_mapped)
+    {
+        // init or clear the head map
+        if (!http->heads_map) http->heads_map = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_null, tb_null));
+        else tb_hash_map_clear(http->heads_map);
+        tb_assert_and_check_return_val(http->heads_map, tb_null);
+
+        // insert the heads
+        tb_http_head_t const* heads = (tb_http_head_t const*)tb_buffer_data(&http->heads);
+        for (i = 0; i < http->heads_count; i++)
+        {
+            tb_http_head_t const* head = &heads[i];
+            tb_check_continue(head->name_size < sizeof(key));
+            for (n = 0; n < head->name_size; n++) key[n] = tb_tolower(head->name[n]);
+            key[n] = '\0';
+            tb_hash_map_insert(http->heads_map, key, head->value);
+        }
+
+        // mapped
+        http->heads_mapped = tb_true;
+    }
+
+    // get the head value
+    for (n = 0; name[n] && n < sizeof(key) - 1; n++) key[n] = tb_tolower(name[n]);
+    tb_check_return_val(!name[n], tb_null);
+    key[n] = '\0';
+    return (tb_char_t const*)tb_hash_map_get(http->heads_map, key);
+}
+tb_size_t tb_http_head_intern(tb_char_t const* name, tb_size_t size)
+{
+    // check
+    tb_assert_static(tb_arrayn(g_http_heads) == TB_HTTP_HEAD_MAXN);
+    tb_assert_and_check_return_val(name, TB_HTTP_HEAD_NONE);
+
+    // the well-known heads are too few to need a hash map, we compare the size and the first character at first
+    tb_size_t id = 0;
+    tb_char_t ch = size? tb_tolower(*name) : '\0';
+    for (id = 1; id < tb_arrayn(g_http_heads); id++)
+    {
+        if (size == g_http_heads[id].size && ch == tb_tolower(g_http_heads[id].name[0]) && !tb_strnicmp(g_http_heads[id].name, name, size))
+            return id;
+    }
+    return TB_HTTP_HEAD_NONE;
+}
 
@@ -26,6 +26,7 @@
  * includes
  */
 #include "cookies.h"
+#include "http_pool.h"
 #include "url.h"
 #include "../string/string.h"
 #include "../container/container.h"
@@ -150,6 +151,8 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_GET_POST_FUNC        = TB_HTTP_OPTION_CODE_GET(18)
 ,   TB_HTTP_OPTION_GET_POST_PRIV        = TB_HTTP_OPTION_CODE_GET(19)
 ,   TB_HTTP_OPTION_GET_POST_LRATE       = TB_HTTP_OPTION_CODE_GET(20)
+,   TB_HTTP_OPTION_GET_POOL             = TB_HTTP_OPTION_CODE_GET(21)
+,   TB_HTTP_OPTION_GET_HEAD_MAXN        = TB_HTTP_OPTION_CODE_GET(22)
 
 ,   TB_HTTP_OPTION_SET_SSL              = TB_HTTP_OPTION_CODE_SET(1)
 ,   TB_HTTP_OPTION_SET_URL              = TB_HTTP_OPTION_CODE_SET(2)
@@ -171,9 +174,57 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_SET_POST_FUNC        = TB_HTTP_OPTION_CODE_SET(18)
 ,   TB_HTTP_OPTION_SET_POST_PRIV        = TB_HTTP_OPTION_CODE_SET(19)
 ,   TB_HTTP_OPTION_SET_POST_LRATE       = TB_HTTP_OPTION_CODE_SET(20)
+,   TB_HTTP_OPTION_SET_POOL             = TB_HTTP_OPTION_CODE_SET(21)
+,   TB_HTTP_OPTION_SET_HEAD_MAXN        = TB_HTTP_OPTION_CODE_SET(22)
 
 }tb_http_option_e;
 
+/// the http head enum, the well-known head names are interned
+typedef enum __tb_http_head_e
+{
+    TB_HTTP_HEAD_NONE                   = 0     //!< the unknown head
+,   TB_HTTP_HEAD_ACCEPT_RANGES          = 1
+,   TB_HTTP_HEAD_AGE                    = 2
+,   TB_HTTP_HEAD_CACHE_CONTROL          = 3
+,   TB_HTTP_HEAD_CONNECTION             = 4
+,   TB_HTTP_HEAD_CONTENT_ENCODING       = 5
+,   TB_HTTP_HEAD_CONTENT_LENGTH         = 6
+,   TB_HTTP_HEAD_CONTENT_RANGE          = 7
+,   TB_HTTP_HEAD_CONTENT_TYPE           = 8
+,   TB_HTTP_HEAD_DATE                   = 9
+,   TB_HTTP_HEAD_ETAG                   = 10
+,   TB_HTTP_HEAD_EXPIRES                = 11
+,   TB_HTTP_HEAD_KEEP_ALIVE             = 12
+,   TB_HTTP_HEAD_LAST_MODIFIED          = 13
+,   TB_HTTP_HEAD_LOCATION               = 14
+,   TB_HTTP_HEAD_SERVER                 = 15
+,   TB_HTTP_HEAD_SET_COOKIE             = 16
+,   TB_HTTP_HEAD_TRANSFER_ENCODING      = 17
+,   TB_HTTP_HEAD_VARY                   = 18
+,   TB_HTTP_HEAD_MAXN                   = 19
+
+}tb_http_head_e;
+
+/// the http head type, the name and value point to the response data and they are null-terminated
+typedef struct __tb_http_head_t
+{
+    /// the interned head id, TB_HTTP_HEAD_NONE if it is not well-known
+    tb_size_t           id;
+
+    /// the name
+    tb_char_t const*    name;
+
+    /// the name size
+    tb_size_t           name_size;
+
+    /// the value
+    tb_char_t const*    value;
+
+    /// the value size
+    tb_size_t           value_size;
+
+}tb_http_head_t;
+
 /// the http range type
 typedef struct __tb_http_range_t
 {
@@ -236,6 +287,9 @@ typedef struct __tb_http_option_t
     /// the cookies
     tb_cookies_ref_t    cookies;
 
+    /// the connection pool for reusing the keep-alive connections, disable it if be null
+    tb_http_pool_ref_t  pool;
+
     /// the priv data
     tb_pointer_t        head_priv;
 
@@ -245,6 +299,9 @@ typedef struct __tb_http_option_t
     /// the head data
     tb_buffer_t         head_data;
 
+    /// the max size of the response head
+    tb_size_t           head_maxn;
+
     /// the post url
     tb_url_t            post_url;
 
@@ -403,6 +460,38 @@ tb_bool_t               tb_http_ctrl(tb_http_ref_t http, tb_size_t option, ...);
  */
 tb_http_status_t const* tb_http_status(tb_http_ref_t http);
 
+/*! get the response heads
+ *
+ * they point to the response data of the http and are only valid until the next request,
+ * e.g. tb_http_open, tb_http_seek and tb_http_close
+ *
+ * @param http          the http
+ * @param pcount        the head count
+ *
+ * @return              the heads
+ */
+tb_http_head_t const*   tb_http_response_heads(tb_http_ref_t http, tb_size_t* pcount);
+
+/*! get the response head value
+ *
+ * the head map is only built on the first lookup of each response,
+ * the last one will be returned if there are some heads with the same name
+ *
+ * @param http          the http
+ * @param name          the head name, case-insensitive
+ *
+ * @return              the head value, it is only valid until the next request
+ */
+tb_char_t const*        tb_http_response_head(tb_http_ref_t http, tb_char_t const* name);
+
+/*! intern the head name
+ *
+ * @param name          the head name, case-insensitive
+ * @param size          the name size
+ *
+ * @return              the head id, TB_HTTP_HEAD_NONE if it is not well-known
+ */
+tb_size_t               tb_http_head_intern(tb_char_t const* name, tb_size_t size);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -0,0 +1,151 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_pool.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_HTTP_POOL_H
+#define TB_NETWORK_HTTP_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "ssl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the http pool ref type
+typedef __tb_typeref__(http_pool);
+
+/// the http pool stat type
+typedef struct __tb_http_pool_stat_t
+{
+    /// the idle connection count
+    tb_size_t               idle;
+
+    /// the reused connection count
+    tb_hize_t               hits;
+
+    /// the missed count, need connect a new connection
+    tb_hize_t               misses;
+
+    /// the dropped count of the stale connections which have been closed by the peer
+    tb_hize_t               stale;
+
+    /// the evicted count of the idle connections which are timeout or out of limit
+    tb_hize_t               evicted;
+
+}tb_http_pool_stat_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the http pool instance
+ *
+ * it is used by tb_http, tb_stream_init_from_http and tb_transfer_url* by default
+ *
+ * @return                  the http pool
+ */
+tb_http_pool_ref_t          tb_http_pool(tb_noarg_t);
+
+/*! init the http pool
+ *
+ * the idle connections are keyed by scheme, host, port and the coroutine scheduler,
+ * because the socket can only be waited in the scheduler which has used it.
+ *
+ * @param idle_maxn         the max count of all idle connections, use the default value if be zero
+ * @param host_idle_maxn    the max count of the idle connections for each host, use the default value if be zero
+ * @param idle_timeout      the idle timeout (ms), use the default value if be zero
+ *
+ * @return                  the http pool
+ */
+tb_http_pool_ref_t          tb_http_pool_init(tb_size_t idle_maxn, tb_size_t host_idle_maxn, tb_long_t idle_timeout);
+
+/*! exit the http pool and close all idle connections
+ *
+ * @param pool              the http pool
+ */
+tb_void_t                   tb_http_pool_exit(tb_http_pool_ref_t pool);
+
+/*! close all idle connections
+ *
+ * @param pool              the http pool
+ */
+tb_void_t                   tb_http_pool_clear(tb_http_pool_ref_t pool);
+
+/*! set the limits of the http pool
+ *
+ * @param pool              the http pool
+ * @param idle_maxn         the max count of all idle connections, disable the pool if be zero
+ * @param host_idle_maxn    the max count of the idle connections for each host
+ * @param idle_timeout      the idle timeout (ms)
+ */
+tb_void_t                   tb_http_pool_limit(tb_http_pool_ref_t pool, tb_size_t idle_maxn, tb_size_t host_idle_maxn, tb_long_t idle_timeout);
+
+/*! get an idle connection from the http pool
+ *
+ * the connection closed by the peer will be dropped by the health check
+ *
+ * @param pool              the http pool
+ * @param host              the host
+ * @param port              the port
+ * @param bssl              is ssl?
+ * @param psock             the socket
+ * @param pssl              the opened ssl if bssl is true
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_http_pool_get(tb_http_pool_ref_t pool, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl, tb_socket_ref_t* psock, tb_ssl_ref_t* pssl);
+
+/*! put an idle connection to the http pool
+ *
+ * the pool will own the socket and ssl if ok, otherwise the caller need close them
+ *
+ * @param pool              the http pool
+ * @param host              the host
+ * @param port              the port
+ * @param bssl              is ssl?
+ * @param sock              the socket
+ * @param ssl               the opened ssl if bssl is true
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_http_pool_put(tb_http_pool_ref_t pool, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl, tb_socket_ref_t sock, tb_ssl_ref_t ssl);
+
+/*! get the stat of the http pool
+ *
+ * @param pool              the http pool
+ * @param stat              the stat
+ */
+tb_void_t                   tb_http_pool_stat(tb_http_pool_ref_t pool, tb_http_pool_stat_t* stat);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,1170 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_server.c
+ * @ingroup     network
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "http_server"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+#include "http_server.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../platform/platform.h"
+#include "../coroutine/coroutine.h"
+#include "../container/container.h"
+#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default io timeout
+#define TB_HTTP_SERVER_TIMEOUT_DEFAULT          (30000)
+
+// the default buffer size
+#ifdef __tb_small__
+#   define TB_HTTP_SERVER_RBUF_SIZE_DEFAULT     (4096)
+#   define TB_HTTP_SERVER_WBUF_SIZE_DEFAULT     (4096)
+#else
+#   define TB_HTTP_SERVER_RBUF_SIZE_DEFAULT     (8192)
+#   define TB_HTTP_SERVER_WBUF_SIZE_DEFAULT     (8192)
+#endif
+
+// the min buffer size
+#define TB_HTTP_SERVER_BUF_SIZE_MIN             (512)
+
+// the max head count of the request
+#define TB_HTTP_SERVER_HEAD_MAXN                (64)
+
+// the max line size of the chunk size
+#define TB_HTTP_SERVER_CHUNK_LINE_MAXN          (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the chunk state enum
+typedef enum __tb_http_server_chunk_state_e
+{
+    TB_HTTP_SERVER_CHUNK_STATE_SIZE             = 0
+,   TB_HTTP_SERVER_CHUNK_STATE_DATA             = 1
+,   TB_HTTP_SERVER_CHUNK_STATE_DATA_CRLF        = 2
+,   TB_HTTP_SERVER_CHUNK_STATE_TRAILER          = 3
+
+}tb_http_server_chunk_state_e;
+
+// the http server type
+typedef struct __tb_http_server_t
+{
+    // the request func
+    tb_http_server_func_t       func;
+
+    // the private data
+    tb_cpointer_t               priv;
+
+    // the listen socket
+    tb_socket_ref_t             sock;
+
+    // the io timeout
+    tb_long_t                   timeout;
+
+    // the recv buffer size
+    tb_size_t                   rbuf_size;
+
+    // the send buffer size
+    tb_size_t                   wbuf_size;
+
+    // the stack size of the connection coroutine
+    tb_size_t                   stacksize;
+
+    // the max request count of the connection
+    tb_size_t                   alive_maxn;
+
+    // the root directory
+    tb_char_t                   rootdir[TB_PATH_MAXN];
+
+    // is stopped?
+    tb_atomic32_t               stopped;
+
+    // the connections
+    tb_list_entry_head_t        conns;
+
+    // the lock of the connections
+    tb_spinlock_t               lock;
+
+}tb_http_server_t;
+
+// the http server connection type
+typedef struct __tb_http_server_conn_t
+{
+    // the list entry
+    tb_list_entry_t             entry;
+
+    // the server
+    tb_http_server_t*           server;
+
+    // the socket
+    tb_socket_ref_t             sock;
+
+    // the recv data
+    tb_byte_t*                  rdata;
+
+    // the recv buffer size
+    tb_size_t                   rsize;
+
+    // the begin of the current request
+    tb_size_t                   rpos;
+
+    // the end of the received data
+    tb_size_t                   rend;
+
+    // the send data
+    tb_byte_t*                  wdata;
+
+    // the send buffer size
+    tb_size_t                   wsize;
+
+    // the end of the pending responses
+    tb_size_t                   wend;
+
+    // the scanned size for finding the head end, relative to rpos
+    tb_size_t                   scan;
+
+    // the head size, relative to rpos, zero if the head is not complete
+    tb_size_t                   head_size;
+
+    // the content size, -1 if no content-length
+    tb_hong_t                   content_size;
+
+    // the chunk state
+    tb_size_t                   chunk_state;
+
+    // the left size of the current chunk
+    tb_size_t                   chunk_left;
+
+    // the decoded body size
+    tb_size_t                   body_size;
+
+    // the raw body size which has been read
+    tb_size_t                   body_read;
+
+    // the head views have been parsed? they need be parsed again after moving the recv data
+    tb_uint16_t                 bparsed     : 1;
+
+    // need send "100 Continue"?
+    tb_uint16_t                 bexpect     : 1;
+
+    // "100 Continue" has been sent?
+    tb_uint16_t                 bcontinue   : 1;
+
+    // the request count
+    tb_size_t                   count;
+
+    // the request
+    tb_http_server_request_t    request;
+
+    // the heads
+    tb_http_server_head_t       heads[TB_HTTP_SERVER_HEAD_MAXN];
+
+    // the file path
+    tb_char_t                   path[TB_PATH_MAXN];
+
+}tb_http_server_conn_t, *tb_http_server_conn_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_char_t const* tb_http_server_code_cstr(tb_size_t code)
+{
+    // done
+    tb_char_t const* cstr = tb_null;
+    switch (code)
+    {
+    case TB_HTTP_CODE_CONTINUE:                 cstr = "Continue"; break;
+    case TB_HTTP_CODE_OK:                       cstr = "OK"; break;
+    case TB_HTTP_CODE_CREATED:                  cstr = "Created"; break;
+    case TB_HTTP_CODE_ACCEPTED:                 cstr = "Accepted"; break;
+    case TB_HTTP_CODE_NO_CONTENT:               cstr = "No Content"; break;
+    case TB_HTTP_CODE_PARTIAL_CONTENT:          cstr = "Partial Content"; break;
+    case TB_HTTP_CODE_MOVED_PERMANENTLY:        cstr = "Moved Permanently"; break;
+    case TB_HTTP_CODE_MOVED_TEMPORARILY:        cstr = "Found"; break;
+    case TB_HTTP_CODE_SEE_OTHER:                cstr = "See Other"; break;
+    case TB_HTTP_CODE_NOT_MODIFIED:             cstr = "Not Modified"; break;
+    case TB_HTTP_CODE_TEMPORARY_REDIRECT:       cstr = "Temporary Redirect"; break;
+    case TB_HTTP_CODE_BAD_REQUEST:              cstr = "Bad Request"; break;
+    case TB_HTTP_CODE_UNAUTHORIZED:             cstr = "Unauthorized"; break;
+    case TB_HTTP_CODE_FORBIDDEN:                cstr = "Forbidden"; break;
+    case TB_HTTP_CODE_NOT_FOUND:                cstr = "Not Found"; break;
+    case TB_HTTP_CODE_METHOD_NOT_ALLOWED:       cstr = "Method Not Allowed"; break;
+    case TB_HTTP_CODE_REQUEST_TIMEOUT:          cstr = "Request Timeout"; break;
+    case TB_HTTP_CODE_LENGTH_REQUIRED:          cstr = "Length Required"; break;
+    case TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG:  cstr = "Payload Too Large"; break;
+    case TB_HTTP_CODE_REQUEST_URI_TOO_LONG:     cstr = "URI Too Long"; break;
+    case TB_HTTP_CODE_INTERNAL_SERVER_ERROR:    cstr = "Internal Server Error"; break;
+    case TB_HTTP_CODE_NOT_IMPLEMENTED:          cstr = "Not Implemented"; break;
+    case TB_HTTP_CODE_SERVICE_UNAVAILABLE:      cstr = "Service Unavailable"; break;
+    default:                                    cstr = "Unknown"; break;
+    }
+    return cstr;
+}
+static tb_char_t const* tb_http_server_file_type(tb_char_t const* path)
+{
+    // the content types
+    static tb_char_t const* s_types[][2] =
+    {
+        { ".html",  "text/html"                 }
+    ,   { ".htm",   "text/html"                 }
+    ,   { ".css",   "text/css"                  }
+    ,   { ".js",    "application/javascript"    }
+    ,   { ".json",  "application/json"          }
+    ,   { ".xml",   "application/xml"           }
+    ,   { ".txt",   "text/plain"                }
+    ,   { ".png",   "image/png"                 }
+    ,   { ".jpg",   "image/jpeg"                }
+    ,   { ".jpeg",  "image/jpeg"                }
+    ,   { ".gif",   "image/gif"                 }
+    ,   { ".svg",   "image/svg+xml"             }
+    ,   { ".ico",   "image/x-icon"              }
+    };
+
+    // find the extension
+    tb_char_t const* ext = tb_strrchr(path, '.');
+    if (ext && !tb_strchr(ext, '/'))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < tb_arrayn(s_types); i++)
+        {
+            if (!tb_stricmp(ext, s_types[i][0])) return s_types[i][1];
+        }
+    }
+    return "application/octet-stream";
+}
+static tb_bool_t tb_http_server_head_is(tb_http_server_head_t const* head, tb_char_t const* name, tb_size_t size)
+{
+    return head->name_size == size && !tb_strnicmp(head->name, name, size);
+}
+static tb_bool_t tb_http_server_value_has(tb_char_t const* value, tb_size_t value_size, tb_char_t const* token, tb_size_t size)
+{
+    // find the token in the value list, e.g. "keep-alive, Upgrade"
+    tb_char_t const* p = value;
+    tb_char_t const* e = value + value_size;
+    while (p < e)
+    {
+        // skip spaces and commas
+        while (p < e && (*p == ' ' || *p == '\t' || *p == ',')) p++;
+
+        // get the token
+        tb_char_t const* b = p;
+        while (p < e && *p != ',' && *p != ' ' && *p != '\t') p++;
+        if ((tb_size_t)(p - b) == size && !tb_strnicmp(b, token, size)) return tb_true;
+    }
+    return tb_false;
+}
+static tb_bool_t tb_http_server_conn_wait(tb_http_server_conn_ref_t conn, tb_size_t events)
+{
+    return tb_socket_wait(conn->sock, events, conn->server->timeout) > 0;
+}
+static tb_bool_t tb_http_server_conn_sendv(tb_http_server_conn_ref_t conn, tb_iovec_t* list, tb_size_t size)
+{
+    // done
+    tb_bool_t wait = tb_false;
+    while (size)
+    {
+        // send it
+        tb_long_t real = tb_socket_sendv(conn->sock, list, size);
+
+        // has data?
+        if (real > 0)
+        {
+            // skip the sent data
+            while (size && (tb_size_t)real >= list->size)
+            {
+                real -= list->size;
+                list++;
+                size--;
+            }
+            if (size && real)
+            {
+                list->data += real;
+                list->size -= real;
+            }
+            wait = tb_false;
+        }
+        // no data? wait it
+        else if (!real && !wait)
+        {
+            if (!tb_http_server_conn_wait(conn, TB_SOCKET_EVENT_SEND)) break;
+            wait = tb_true;
+        }
+        // failed or end?
+        else break;
+    }
+
+    // ok?
+    return !size;
+}
+static tb_bool_t tb_http_server_conn_flush(tb_http_server_conn_ref_t conn, tb_byte_t const* data, tb_size_t size)
+{
+    // send the pending responses and the given data together
+    tb_iovec_t  list[2];
+    tb_size_t   count = 0;
+    if (conn->wend)
+    {
+        list[count].data = conn->wdata;
+        list[count].size = conn->wend;
+        count++;
+    }
+    if (data && size)
+    {
+        list[count].data = (tb_byte_t*)data;
+        list[count].size = size;
+        count++;
+    }
+    conn->wend = 0;
+    return count? tb_http_server_conn_sendv(conn, list, count) : tb_true;
+}
+static tb_bool_t tb_http_server_conn_sendf(tb_http_server_conn_ref_t conn, tb_file_ref_t file, tb_hize_t size)
+{
+    // send the pending responses first
+    if (!tb_http_server_conn_flush(conn, tb_null, 0)) return tb_false;
+
+    // send the file
+    tb_hize_t send = 0;
+    tb_bool_t wait = tb_false;
+    while (send < size)
+    {
+        // send it
+        tb_hong_t real = tb_socket_sendf(conn->sock, file, send, size - send);
+
+        // has data?
+        if (real > 0)
+        {
+            send += real;
+            wait = tb_false;
+        }
+        // no data? wait it
+        else if (!real && !wait)
+        {
+            if (!tb_http_server_conn_wait(conn, TB_SOCKET_EVENT_SEND)) break;
+            wait = tb_true;
+        }
+        // failed or end?
+        else break;
+    }
+
+    // ok?
+    return send == size;
+}
+static tb_long_t tb_http_server_conn_recv(tb_http_server_conn_ref_t conn)
+{
+    // done
+    tb_bool_t wait = tb_false;
+    while (1)
+    {
+        // recv it
+        tb_long_t real = tb_socket_recv(conn->sock, conn->rdata + conn->rend, conn->rsize - conn->rend);
+
+        // has data?
+        if (real > 0)
+        {
+            conn->rend += real;
+            return real;
+        }
+        // no data? wait it
+        else if (!real && !wait)
+        {
+            if (!tb_http_server_conn_wait(conn, TB_SOCKET_EVENT_RECV)) break;
+            wait = tb_true;
+        }
+        // failed or end?
+        else break;
+    }
+    return -1;
+}
+static tb_size_t tb_http_server_conn_parse_head(tb_http_server_conn_ref_t conn)
+{
+    // init
+    tb_char_t const*            p = (tb_char_t const*)conn->rdata + conn->rpos;
+    tb_char_t const*            e = p + conn->head_size - 2;
+    tb_http_server_request_ref_t request = &conn->request;
+    tb_memset(request, 0, sizeof(tb_http_server_request_t));
+    request->heads = conn->heads;
+
+    // the request line end
+    tb_char_t const* le = (tb_char_t const*)tb_memchr(p, '\n', e - p);
+    tb_assert_and_check_return_val(le, TB_HTTP_CODE_BAD_REQUEST);
+
+    // parse method
+    static tb_char_t const* s_methods[] = {"GET", "POST", "HEAD", "PUT", "OPTIONS", "DELETE", "TRACE", "CONNECT"};
+    tb_char_t const* b = p;
+    while (p < le && *p != ' ') p++;
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(s_methods); i++)
+    {
+        if (!tb_strncmp(b, s_methods[i], p - b) && !s_methods[i][p - b]) break;
+    }
+    if (i == tb_arrayn(s_methods)) return TB_HTTP_CODE_NOT_IMPLEMENTED;
+    request->method = (tb_uint16_t)(TB_HTTP_METHOD_GET + i);
+
+    // parse path and query
+    while (p < le && *p == ' ') p++;
+    b = p;
+    while (p < le && *p != ' ') p++;
+    tb_check_return_val(p > b && *b == '/', TB_HTTP_CODE_BAD_REQUEST);
+    tb_char_t const* q = (tb_char_t const*)tb_memchr(b, '?', p - b);
+    request->path       = b;
+    request->path_size  = (q? q : p) - b;
+    if (q)
+    {
+        request->query      = q + 1;
+        request->query_size = p - q - 1;
+    }
+
+    // parse version
+    while (p < le && *p == ' ') p++;
+    tb_check_return_val(le - p >= 8 && !tb_strncmp(p, "HTTP/1.", 7), TB_HTTP_CODE_BAD_REQUEST);
+    request->version = p[7] == '0'? 0 : 1;
+    request->balived = request->version;
+
+    // parse heads
+    tb_bool_t       blength = tb_false;
+    tb_hong_t       content_size = 0;
+    for (p = le + 1; p < e; p = le + 1)
+    {
+        // the line end
+        le = (tb_char_t const*)tb_memchr(p, '\n', e - p);
+        if (!le) le = e;
+
+        // the name
+        b = p;
+        tb_char_t const* c = (tb_char_t const*)tb_memchr(p, ':', le - p);
+        tb_check_return_val(c && c > b, TB_HTTP_CODE_BAD_REQUEST);
+
+        // the value, strip spaces and '\r'
+        tb_char_t const* v = c + 1;
+        tb_char_t const* ve = le;
+        while (v < ve && (*v == ' ' || *v == '\t')) v++;
+        while (ve > v && (ve[-1] == '\r' || ve[-1] == ' ' || ve[-1] == '\t')) ve--;
+
+        // save it
+        tb_check_return_val(request->heads_count < TB_HTTP_SERVER_HEAD_MAXN, TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG);
+        tb_http_server_head_ref_t head = &conn->heads[request->heads_count++];
+        head->name          = b;
+        head->name_size     = c - b;
+        head->value         = v;
+        head->value_size    = ve - v;
+
+        // parse the well-known heads
+        switch (tb_tolower(*b))
+        {
+        case 'c':
+            if (tb_http_server_head_is(head, "Content-Length", 14))
+            {
+                // the content size
+                tb_size_t n = 0;
+                for (content_size = 0; n < head->value_size && tb_isdigit(v[n]); n++)
+                {
+                    tb_check_return_val(content_size < ((tb_hong_t)1 << 52), TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG);
+                    content_size = content_size * 10 + (v[n] - '0');
+                }
+                tb_check_return_val(n && n == head->value_size && !blength, TB_HTTP_CODE_BAD_REQUEST);
+                blength = tb_true;
+            }
+            else if (tb_http_server_head_is(head, "Connection", 10))
+            {
+                if (tb_http_server_value_has(v, head->value_size, "close", 5)) request->balived = 0;
+                else if (tb_http_server_value_has(v, head->value_size, "keep-alive", 10)) request->balived = 1;
+            }
+            break;
+        case 't':
+            if (tb_http_server_head_is(head, "Transfer-Encoding", 17))
+            {
+                // only chunked is supported
+                tb_check_return_val(head->value_size == 7 && !tb_strnicmp(v, "chunked", 7), TB_HTTP_CODE_NOT_IMPLEMENTED);
+                request->bchunked = 1;
+            }
+            break;
+        case 'e':
+            if (tb_http_server_head_is(head, "Expect", 6) && head->value_size == 12 && !tb_strnicmp(v, "100-continue", 12))
+                conn->bexpect = request->version && !conn->bcontinue? 1 : 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // the content-length is ignored for the chunked body
+    conn->content_size = request->bchunked? -1 : (blength? content_size : 0);
+
+    // ok
+    return TB_HTTP_CODE_OK;
+}
+static tb_long_t tb_http_server_conn_parse_chunked(tb_http_server_conn_ref_t conn)
+{
+    // init
+    tb_byte_t*  data = conn->rdata + conn->rpos;
+    tb_size_t   size = conn->rend - conn->rpos;
+    tb_size_t   raw = conn->head_size + conn->body_read;
+    tb_size_t   dec = conn->head_size + conn->body_size;
+
+    // decode the chunked body in place
+    tb_long_t ok = 0;
+    while (!ok)
+    {
+        tb_size_t left = size - raw;
+        switch (conn->chunk_state)
+        {
+        case TB_HTTP_SERVER_CHUNK_STATE_SIZE:
+            {
+                // find the line end
+                tb_byte_t const* le = (tb_byte_t const*)tb_memchr(data + raw, '\n', left);
+                if (!le)
+                {
+                    if (left > TB_HTTP_SERVER_CHUNK_LINE_MAXN) ok = -TB_HTTP_CODE_BAD_REQUEST;
+                    else ok = 1;
+                    break;
+                }
+
+                // parse the chunk size, the chunk extensions are ignored
+                tb_byte_t const*    p = data + raw;
+                tb_size_t           n = 0;
+                tb_size_t           chunk = 0;
+                for (; p < le && tb_isdigit16(*p); p++, n++)
+                {
+                    if (chunk > (conn->rsize >> 4)) break;
+                    chunk = (chunk << 4) + (tb_isdigit(*p)? *p - '0' : (tb_tolower(*p) - 'a' + 10));
+                }
+                if (!n)
+                {
+                    ok = -TB_HTTP_CODE_BAD_REQUEST;
+                    break;
+                }
+                if (chunk > conn->rsize)
+                {
+                    ok = -TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG;
+                    break;
+                }
+                raw = le + 1 - data;
+
+                // next state
+                conn->chunk_left = chunk;
+                conn->chunk_state = chunk? TB_HTTP_SERVER_CHUNK_STATE_DATA : TB_HTTP_SERVER_CHUNK_STATE_TRAILER;
+            }
+            break;
+        case TB_HTTP_SERVER_CHUNK_STATE_DATA:
+            {
+                // move the chunk data to the end of the decoded body
+                tb_size_t n = tb_min(conn->chunk_left, left);
+                if (!n)
+                {
+                    ok = 1;
+                    break;
+                }
+                if (dec != raw) tb_memmov(data + dec, data + raw, n);
+                dec += n;
+                raw += n;
+                conn->chunk_left -= n;
+                if (!conn->chunk_left) conn->chunk_state = TB_HTTP_SERVER_CHUNK_STATE_DATA_CRLF;
+            }
+            break;
+        case TB_HTTP_SERVER_CHUNK_STATE_DATA_CRLF:
+            {
+                // skip "\r\n"
+                if (left < 2)
+                {
+                    ok = 1;
+                    break;
+                }
+                if (data[raw] != '\r' || data[raw + 1] != '\n')
+                {
+                    ok = -TB_HTTP_CODE_BAD_REQUEST;
+                    break;
+                }
+                raw += 2;
+                conn->chunk_state = TB_HTTP_SERVER_CHUNK_STATE_SIZE;
+            }
+            break;
+        case TB_HTTP_SERVER_CHUNK_STATE_TRAILER:
+            {
+                // find the line end
+                tb_byte_t const* le = (tb_byte_t const*)tb_memchr(data + raw, '\n', left);
+                if (!le)
+                {
+                    if (left > TB_HTTP_SERVER_CHUNK_LINE_MAXN) ok = -TB_HTTP_CODE_BAD_REQUEST;
+                    else ok = 1;
+                    break;
+                }
+
+                // the empty line? end
+                tb_bool_t end = le == data + raw || (le == data + raw + 1 && data[raw] == '\r');
+                raw = le + 1 - data;
+                if (end) ok = 2;
+            }
+            break;
+        default:
+            ok = -TB_HTTP_CODE_BAD_REQUEST;
+            break;
+        }
+    }
+
+    // save the state
+    conn->body_read = raw - conn->head_size;
+    conn->body_size = dec - conn->head_size;
+
+    // end? return the request size
+    return ok == 2? (tb_long_t)raw : (ok < 0? ok : 0);
+}
+static tb_long_t tb_http_server_conn_parse(tb_http_server_conn_ref_t conn)
+{
+    // find the head end
+    if (!conn->head_size)
+    {
+        // skip the empty lines between the pipelined requests
+        if (!conn->scan)
+        {
+            while (conn->rpos < conn->rend && (conn->rdata[conn->rpos] == '\r' || conn->rdata[conn->rpos] == '\n'))
+                conn->rpos++;
+        }
+
+        // find "\r\n\r\n" from the last scanned position
+        tb_byte_t const*    data = conn->rdata + conn->rpos;
+        tb_size_t           size = conn->rend - conn->rpos;
+        tb_size_t           from = conn->scan > 3? conn->scan - 3 : 0;
+        tb_byte_t const*    p = size > from? (tb_byte_t const*)tb_memmem(data + from, size - from, "\r\n\r\n", 4) : tb_null;
+        if (!p)
+        {
+            conn->scan = size;
+            return 0;
+        }
+
+        // init the body state
+        conn->head_size     = p + 4 - data;
+        conn->bparsed       = 0;
+        conn->bexpect       = 0;
+        conn->bcontinue     = 0;
+        conn->chunk_state   = TB_HTTP_SERVER_CHUNK_STATE_SIZE;
+        conn->chunk_left    = 0;
+        conn->body_size     = 0;
+        conn->body_read     = 0;
+    }
+
+    // parse the head
+    if (!conn->bparsed)
+    {
+        tb_size_t code = tb_http_server_conn_parse_head(conn);
+        if (code != TB_HTTP_CODE_OK) return -(tb_long_t)code;
+        conn->bparsed = 1;
+    }
+
+    // the request
+    tb_http_server_request_ref_t request = &conn->request;
+    tb_byte_t const* data = conn->rdata + conn->rpos;
+
+    // parse the chunked body
+    if (request->bchunked)
+    {
+        tb_long_t size = tb_http_server_conn_parse_chunked(conn);
+        if (size > 0)
+        {
+            request->body       = data + conn->head_size;
+            request->body_size  = conn->body_size;
+        }
+        return size;
+    }
+
+    // the body is too large?
+    if (conn->content_size > (tb_hong_t)(conn->rsize - conn->head_size)) return -TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG;
+
+    // the body has not been received?
+    tb_size_t size = conn->head_size + (tb_size_t)conn->content_size;
+    if (conn->rend - conn->rpos < size) return 0;
+
+    // the body
+    request->body       = conn->content_size? data + conn->head_size : tb_null;
+    request->body_size  = (tb_size_t)conn->content_size;
+    return size;
+}
+static tb_bool_t tb_http_server_conn_head(tb_http_server_conn_ref_t conn, tb_http_server_response_ref_t response, tb_hize_t content_size, tb_bool_t balived)
+{
+    // make the response head
+    tb_size_t n = 0;
+    while (n++ < 2)
+    {
+        tb_char_t*  p = (tb_char_t*)conn->wdata + conn->wend;
+        tb_size_t   left = conn->wsize - conn->wend;
+        tb_long_t   real = tb_snprintf(p, left, "HTTP/1.1 %lu %s\r\nServer: tbox\r\nContent-Length: %llu\r\n%s%s%s%s%s\r\n"
+                                    ,   response->code
+                                    ,   tb_http_server_code_cstr(response->code)
+                                    ,   content_size
+                                    ,   response->type? "Content-Type: " : ""
+                                    ,   response->type? response->type : ""
+                                    ,   response->type? "\r\n" : ""
+                                    ,   !balived? "Connection: close\r\n" : (!conn->request.version? "Connection: keep-alive\r\n" : "")
+                                    ,   response->head? response->head : "");
+
+        // ok?
+        if (real > 0 && (tb_size_t)real + 1 < left)
+        {
+            conn->wend += real;
+            return tb_true;
+        }
+
+        // the send buffer is full? flush it and try again
+        if (!conn->wend || !tb_http_server_conn_flush(conn, tb_null, 0)) break;
+    }
+    return tb_false;
+}
+static tb_bool_t tb_http_server_conn_resp(tb_http_server_conn_ref_t conn, tb_http_server_response_ref_t response, tb_bool_t balived)
+{
+    // send the file
+    tb_http_server_request_ref_t request = &conn->request;
+    if (response->file)
+    {
+        tb_file_ref_t file = tb_file_init(response->file, TB_FILE_MODE_RO);
+        if (file)
+        {
+            tb_hize_t size = tb_file_size(file);
+            tb_bool_t ok = tb_http_server_conn_head(conn, response, size, balived);
+            if (ok && request->method != TB_HTTP_METHOD_HEAD && size) ok = tb_http_server_conn_sendf(conn, file, size);
+            tb_file_exit(file);
+            return ok;
+        }
+
+        // not found
+        response->code = TB_HTTP_CODE_NOT_FOUND;
+        response->type = tb_null;
+        response->data = tb_null;
+        response->size = 0;
+    }
+
+    // make the response head
+    if (!tb_http_server_conn_head(conn, response, response->size, balived)) return tb_false;
+
+    // no data?
+    tb_check_return_val(response->data && response->size && request->method != TB_HTTP_METHOD_HEAD, tb_true);
+
+    // append the small data to the send buffer
+    if (response->size <= conn->wsize - conn->wend)
+    {
+        tb_memcpy(conn->wdata + conn->wend, response->data, response->size);
+        conn->wend += response->size;
+        return tb_true;
+    }
+
+    // send the large data with the pending responses
+    return tb_http_server_conn_flush(conn, response->data, response->size);
+}
+static tb_char_t const* tb_http_server_conn_file(tb_http_server_conn_ref_t conn)
+{
+    // the path
+    tb_http_server_t*               server = conn->server;
+    tb_http_server_request_ref_t    request = &conn->request;
+    tb_char_t const*                path = request->path;
+    tb_size_t                       size = request->path_size;
+    tb_check_return_val(server->rootdir[0], tb_null);
+
+    // the path contains ".." or '\\'? forbid it
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++)
+    {
+        if (path[i] == '\\' || (path[i] == '.' && i + 1 < size && path[i + 1] == '.')) return tb_null;
+    }
+
+    // make the file path
+    tb_long_t n = tb_snprintf(conn->path, sizeof(conn->path), "%s%.*s%s", server->rootdir, (tb_int_t)size, path, path[size - 1] == '/'? "index.html" : "");
+    tb_check_return_val(n > 0 && (tb_size_t)n + 1 < sizeof(conn->path), tb_null);
+    return conn->path;
+}
+static tb_bool_t tb_http_server_conn_done(tb_http_server_conn_ref_t conn)
+{
+    // init response
+    tb_http_server_t*           server = conn->server;
+    tb_http_server_response_t   response;
+    tb_memset(&response, 0, sizeof(tb_http_server_response_t));
+    response.code = TB_HTTP_CODE_OK;
+
+    // trace
+    tb_trace_d("request: %.*s", (tb_int_t)conn->request.path_size, conn->request.path);
+
+    // done the request
+    if (server->func && !server->func(&conn->request, &response, server->priv)) return tb_false;
+
+    // serve the static file if no content
+    if (response.code == TB_HTTP_CODE_OK && !response.data && !response.file && server->rootdir[0])
+    {
+        if (conn->request.method == TB_HTTP_METHOD_GET || conn->request.method == TB_HTTP_METHOD_HEAD)
+        {
+            response.file = tb_http_server_conn_file(conn);
+            if (response.file && !response.type) response.type = tb_http_server_file_type(response.file);
+            else if (!response.file) response.code = TB_HTTP_CODE_NOT_FOUND;
+        }
+        else response.code = TB_HTTP_CODE_METHOD_NOT_ALLOWED;
+    }
+    else if (!server->func && !server->rootdir[0]) response.code = TB_HTTP_CODE_NOT_FOUND;
+
+    // keep alive?
+    conn->count++;
+    tb_bool_t balived = conn->request.balived && !response.bclosed && !tb_atomic32_get(&server->stopped);
+    if (server->alive_maxn && conn->count >= server->alive_maxn) balived = tb_false;
+
+    // send the response
+    if (!tb_http_server_conn_resp(conn, &response, balived)) return tb_false;
+
+    // ok?
+    return balived;
+}
+static tb_void_t tb_http_server_conn_fail(tb_http_server_conn_ref_t conn, tb_size_t code)
+{
+    // make the error response
+    tb_http_server_response_t response;
+    tb_memset(&response, 0, sizeof(tb_http_server_response_t));
+    response.code = code;
+
+    // send it and close the connection
+    conn->wend = 0;
+    if (tb_http_server_conn_head(conn, &response, 0, tb_false))
+        tb_http_server_conn_flush(conn, tb_null, 0);
+}
+static tb_void_t tb_http_server_conn_exit(tb_http_server_conn_ref_t conn)
+{
+    // remove it from the server
+    tb_http_server_t* server = conn->server;
+    tb_spinlock_enter(&server->lock);
+    tb_list_entry_remove(&server->conns, &conn->entry);
+    tb_spinlock_leave(&server->lock);
+
+    // exit it
+    if (conn->sock) tb_socket_exit(conn->sock);
+    tb_free(conn);
+}
+static tb_void_t tb_http_server_conn_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_http_server_conn_ref_t conn = (tb_http_server_conn_ref_t)priv;
+    tb_assert_and_check_return(conn);
+
+    // done
+    while (1)
+    {
+        // parse the request
+        tb_long_t size = tb_http_server_conn_parse(conn);
+        if (size > 0)
+        {
+            // done the request
+            tb_bool_t balived = tb_http_server_conn_done(conn);
+
+            // next request
+            conn->rpos      += size;
+            conn->scan      = 0;
+            conn->head_size = 0;
+            conn->bparsed   = 0;
+            if (!balived) break;
+            continue;
+        }
+
+        // bad request?
+        if (size < 0)
+        {
+            tb_http_server_conn_fail(conn, (tb_size_t)-size);
+            break;
+        }
+
+        // send the pending responses of the pipelined requests before waiting the next requests
+        if (conn->wend && !tb_http_server_conn_flush(conn, tb_null, 0)) break;
+
+        // move the left data to the buffer head
+        if (conn->rpos)
+        {
+            if (conn->rend > conn->rpos) tb_memmov(conn->rdata, conn->rdata + conn->rpos, conn->rend - conn->rpos);
+            conn->rend -= conn->rpos;
+            conn->rpos = 0;
+            conn->bparsed = 0;
+        }
+
+        // the request is too large?
+        if (conn->rend == conn->rsize)
+        {
+            tb_http_server_conn_fail(conn, conn->head_size? TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG : TB_HTTP_CODE_REQUEST_URI_TOO_LONG);
+            break;
+        }
+
+        // the client wants "100 Continue" before sending the body
+        if (conn->bexpect)
+        {
+            static tb_char_t const s_continue[] = "HTTP/1.1 100 Continue\r\n\r\n";
+            conn->bexpect = 0;
+            conn->bcontinue = 1;
+            if (!tb_http_server_conn_flush(conn, (tb_byte_t const*)s_continue, sizeof(s_continue) - 1)) break;
+        }
+
+        // recv more data
+        if (tb_http_server_conn_recv(conn) <= 0) break;
+    }
+
+    // send the pending responses
+    if (conn->wend) tb_http_server_conn_flush(conn, tb_null, 0);
+
+    // exit connection
+    tb_http_server_conn_exit(conn);
+}
+static tb_http_server_conn_ref_t tb_http_server_conn_init(tb_http_server_t* server, tb_socket_ref_t sock)
+{
+    // make connection with the recv and send buffers
+    tb_http_server_conn_ref_t conn = (tb_http_server_conn_ref_t)tb_malloc(sizeof(tb_http_server_conn_t) + server->rbuf_size + server->wbuf_size);
+    tb_assert_and_check_return_val(conn, tb_null);
+
+    // init it
+    tb_memset(conn, 0, sizeof(tb_http_server_conn_t));
+    conn->server    = server;
+    conn->sock      = sock;
+    conn->rdata     = (tb_byte_t*)(conn + 1);
+    conn->rsize     = server->rbuf_size;
+    conn->wdata     = conn->rdata + conn->rsize;
+    conn->wsize     = server->wbuf_size;
+
+    // disable the nagle algorithm for the small responses
+    tb_socket_ctrl(sock, TB_SOCKET_CTRL_SET_TCP_NODELAY, tb_true);
+
+    // save it to the server
+    tb_spinlock_enter(&server->lock);
+    tb_list_entry_insert_tail(&server->conns, &conn->entry);
+    tb_spinlock_leave(&server->lock);
+
+    // stopped now? close it
+    if (tb_atomic32_get(&server->stopped)) tb_socket_kill(sock, TB_SOCKET_KILL_RW);
+
+    // ok
+    return conn;
+}
+static tb_void_t tb_http_server_listen(tb_cpointer_t priv)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)priv;
+    tb_assert_and_check_return(server && server->sock);
+
+    // accept the connections
+    tb_socket_ref_t sock = tb_null;
+    while (!tb_atomic32_get(&server->stopped))
+    {
+        // accept it
+        if ((sock = tb_socket_accept(server->sock, tb_null)))
+        {
+            // start the connection coroutine
+            tb_http_server_conn_ref_t conn = tb_http_server_conn_init(server, sock);
+            if (!conn) tb_socket_exit(sock);
+            else if (!tb_coroutine_start(tb_null, tb_http_server_conn_loop, conn, server->stacksize))
+                tb_http_server_conn_exit(conn);
+        }
+        // wait it
+        else if (tb_socket_wait(server->sock, TB_SOCKET_EVENT_ACPT, -1) <= 0) break;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_http_server_ref_t tb_http_server_init(tb_http_server_func_t func, tb_cpointer_t priv)
+{
+    // make server
+    tb_http_server_t* server = tb_malloc0_type(tb_http_server_t);
+    tb_assert_and_check_return_val(server, tb_null);
+
+    // init it
+    server->func        = func;
+    server->priv        = priv;
+    server->timeout     = TB_HTTP_SERVER_TIMEOUT_DEFAULT;
+    server->rbuf_size   = TB_HTTP_SERVER_RBUF_SIZE_DEFAULT;
+    server->wbuf_size   = TB_HTTP_SERVER_WBUF_SIZE_DEFAULT;
+    tb_spinlock_init(&server->lock);
+    tb_list_entry_init(&server->conns, tb_http_server_conn_t, entry, tb_null);
+    return (tb_http_server_ref_t)server;
+}
+tb_void_t tb_http_server_exit(tb_http_server_ref_t self)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return(server);
+
+    // all connections need be exited
+    tb_assert(!tb_list_entry_size(&server->conns));
+
+    // exit socket
+    if (server->sock) tb_socket_exit(server->sock);
+    server->sock = tb_null;
+
+    // exit it
+    tb_list_entry_exit(&server->conns);
+    tb_spinlock_exit(&server->lock);
+    tb_free(server);
+}
+tb_bool_t tb_http_server_ctrl(tb_http_server_ref_t self, tb_size_t option, ...)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return_val(server, tb_false);
+
+    // init args
+    tb_va_list_t args;
+    tb_va_start(args, option);
+
+    // done
+    tb_bool_t ok = tb_true;
+    switch (option)
+    {
+    case TB_HTTP_SERVER_OPTION_SET_TIMEOUT:
+        server->timeout = (tb_long_t)tb_va_arg(args, tb_long_t);
+        break;
+    case TB_HTTP_SERVER_OPTION_SET_RBUF_SIZE:
+        {
+            tb_size_t size = (tb_size_t)tb_va_arg(args, tb_size_t);
+            server->rbuf_size = tb_max(size, TB_HTTP_SERVER_BUF_SIZE_MIN);
+        }
+        break;
+    case TB_HTTP_SERVER_OPTION_SET_WBUF_SIZE:
+        {
+            tb_size_t size = (tb_size_t)tb_va_arg(args, tb_size_t);
+            server->wbuf_size = tb_max(size, TB_HTTP_SERVER_BUF_SIZE_MIN);
+        }
+        break;
+    case TB_HTTP_SERVER_OPTION_SET_ROOTDIR:
+        {
+            // save the root directory without the trailing '/'
+            tb_char_t const* rootdir = (tb_char_t const*)tb_va_arg(args, tb_char_t const*);
+            tb_size_t size = rootdir? tb_strlcpy(server->rootdir, rootdir, sizeof(server->rootdir)) : 0;
+            ok = size < sizeof(server->rootdir);
+            if (!ok) size = 0;
+            while (size > 1 && (server->rootdir[size - 1] == '/' || server->rootdir[size - 1] == '\\')) size--;
+            server->rootdir[size] = '\0';
+        }
+        break;
+    case TB_HTTP_SERVER_OPTION_SET_STACKSIZE:
+        server->stacksize = (tb_size_t)tb_va_arg(args, tb_size_t);
+        break;
+    case TB_HTTP_SERVER_OPTION_SET_ALIVE_MAXN:
+        server->alive_maxn = (tb_size_t)tb_va_arg(args, tb_size_t);
+        break;
+    default:
+        tb_trace_e("unknown option: %lu", option);
+        ok = tb_false;
+        break;
+    }
+
+    // exit args
+    tb_va_end(args);
+    return ok;
+}
+tb_bool_t tb_http_server_bind(tb_http_server_ref_t self, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return_val(server && addr && !server->sock, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // init socket
+        server->sock = tb_socket_init(TB_SOCKET_TYPE_TCP, tb_ipaddr_family(addr));
+        tb_assert_and_check_break(server->sock);
+
+        // bind and listen it
+        if (!tb_socket_bind(server->sock, addr)) break;
+        if (!tb_socket_listen(server->sock, 1000)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && server->sock)
+    {
+        tb_socket_exit(server->sock);
+        server->sock = tb_null;
+    }
+    return ok;
+}
+tb_bool_t tb_http_server_addr(tb_http_server_ref_t self, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return_val(server && server->sock && addr, tb_false);
+
+    // get the local address
+    return tb_socket_local(server->sock, addr);
+}
+tb_bool_t tb_http_server_start(tb_http_server_ref_t self, tb_co_scheduler_ref_t scheduler)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return_val(server && server->sock, tb_false);
+
+    // start the listen coroutine
+    tb_atomic32_set(&server->stopped, 0);
+    return tb_coroutine_start(scheduler, tb_http_server_listen, server, 0);
+}
+tb_void_t tb_http_server_stop(tb_http_server_ref_t self)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return(server);
+
+    // stop it
+    tb_atomic32_set(&server->stopped, 1);
+
+    // stop accepting
+    if (server->sock) tb_socket_kill(server->sock, TB_SOCKET_KILL_RW);
+
+    // close all connections
+    tb_spinlock_enter(&server->lock);
+    tb_for_all_if (tb_http_server_conn_ref_t, conn, tb_list_entry_itor(&server->conns), conn)
+    {
+        tb_socket_kill(conn->sock, TB_SOCKET_KILL_RW);
+    }
+    tb_spinlock_leave(&server->lock);
+}
+tb_char_t const* tb_http_server_request_head(tb_http_server_request_ref_t request, tb_char_t const* name, tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(request && name, tb_null);
+
+    // find it
+    tb_size_t size = tb_strlen(name);
+    tb_size_t i = 0;
+    for (i = 0; i < request->heads_count; i++)
+    {
+        tb_http_server_head_t const* head = &request->heads[i];
+        if (tb_http_server_head_is(head, name, size))
+        {
+            if (psize) *psize = head->value_size;
+            return head->value;
+        }
+    }
+    return tb_null;
+}
+#endif
@@ -0,0 +1,257 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_server.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_HTTP_SERVER_H
+#define TB_NETWORK_HTTP_SERVER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "http.h"
+#include "ipaddr.h"
+#include "../coroutine/scheduler.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the http server option enum
+typedef enum __tb_http_server_option_e
+{
+    TB_HTTP_SERVER_OPTION_NONE                  = 0
+,   TB_HTTP_SERVER_OPTION_SET_TIMEOUT           = 1     //!< the io timeout (ms) of the connection, default: 30s, infinity if -1
+,   TB_HTTP_SERVER_OPTION_SET_RBUF_SIZE         = 2     //!< the recv buffer size of the connection, it is also the max size of the request head and body, default: 8K
+,   TB_HTTP_SERVER_OPTION_SET_WBUF_SIZE         = 3     //!< the send buffer size of the connection, the pipelined responses are sent in batches, default: 8K
+,   TB_HTTP_SERVER_OPTION_SET_ROOTDIR           = 4     //!< the root directory of the static files, it is used if the response has no content
+,   TB_HTTP_SERVER_OPTION_SET_STACKSIZE         = 5     //!< the stack size of the connection coroutine, default: 0 (use the default stack size)
+,   TB_HTTP_SERVER_OPTION_SET_ALIVE_MAXN        = 6     //!< the max request count of the keep-alive connection, default: 0 (no limit)
+
+}tb_http_server_option_e;
+
+/// the http server head type, the name and value point to the recv buffer and they are not null-terminated
+typedef struct __tb_http_server_head_t
+{
+    /// the name
+    tb_char_t const*            name;
+
+    /// the name size
+    tb_size_t                   name_size;
+
+    /// the value
+    tb_char_t const*            value;
+
+    /// the value size
+    tb_size_t                   value_size;
+
+}tb_http_server_head_t, *tb_http_server_head_ref_t;
+
+/*! the http server request type
+ *
+ * all data point to the recv buffer of the connection and they are only valid in the request handler
+ */
+typedef struct __tb_http_server_request_t
+{
+    /// the method
+    tb_uint16_t                 method      : 4;
+
+    /// the http version, 0: HTTP/1.0, 1: HTTP/1.1
+    tb_uint16_t                 version     : 1;
+
+    /// keep alive?
+    tb_uint16_t                 balived     : 1;
+
+    /// is chunked?
+    tb_uint16_t                 bchunked    : 1;
+
+    /// the path, e.g. "/index.html"
+    tb_char_t const*            path;
+
+    /// the path size
+    tb_size_t                   path_size;
+
+    /// the query, e.g. "a=1&b=2", not including '?'
+    tb_char_t const*            query;
+
+    /// the query size
+    tb_size_t                   query_size;
+
+    /// the heads
+    tb_http_server_head_t const* heads;
+
+    /// the head count
+    tb_size_t                   heads_count;
+
+    /// the body, the chunked body has been decoded
+    tb_byte_t const*            body;
+
+    /// the body size
+    tb_size_t                   body_size;
+
+}tb_http_server_request_t, *tb_http_server_request_ref_t;
+
+/// the http server response type
+typedef struct __tb_http_server_response_t
+{
+    /// the http code, default: TB_HTTP_CODE_OK
+    tb_size_t                   code;
+
+    /// the content type, e.g. "text/html", optional
+    tb_char_t const*            type;
+
+    /// the extra head lines, e.g. "Cache-Control: no-cache\r\n", optional
+    tb_char_t const*            head;
+
+    /// the content data, it need be valid until the request handler returns
+    tb_byte_t const*            data;
+
+    /// the content size
+    tb_size_t                   size;
+
+    /// the content file path, it will be sent by sendfile
+    tb_char_t const*            file;
+
+    /// close the connection after this response?
+    tb_bool_t                   bclosed;
+
+}tb_http_server_response_t, *tb_http_server_response_ref_t;
+
+/// the http server ref type
+typedef __tb_typeref__(http_server);
+
+/*! the http server request func type
+ *
+ * @param request       the request
+ * @param response      the response, it need be filled by the handler
+ * @param priv          the private data
+ *
+ * @return              tb_true: send the response, tb_false: close the connection
+ */
+typedef tb_bool_t       (*tb_http_server_func_t)(tb_http_server_request_ref_t request, tb_http_server_response_ref_t response, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the http server
+ *
+ * @code
+    static tb_bool_t on_request(tb_http_server_request_ref_t request, tb_http_server_response_ref_t response, tb_cpointer_t priv)
+    {
+        response->type = "text/plain";
+        response->data = (tb_byte_t const*)"hello";
+        response->size = 5;
+        return tb_true;
+    }
+
+    tb_http_server_ref_t server = tb_http_server_init(on_request, tb_null);
+    if (server)
+    {
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, tb_null, 8080, TB_IPADDR_FAMILY_IPV4);
+        if (tb_http_server_bind(server, &addr) && tb_http_server_start(server, scheduler))
+            tb_co_scheduler_loop(scheduler, tb_true);
+        tb_http_server_exit(server);
+    }
+ * @endcode
+ *
+ * @param func          the request func, only serve the static files of the root directory if be null
+ * @param priv          the private data
+ *
+ * @return              the http server
+ */
+tb_http_server_ref_t    tb_http_server_init(tb_http_server_func_t func, tb_cpointer_t priv);
+
+/*! exit the http server
+ *
+ * it need be called after all coroutines of the server have been exited
+ *
+ * @param server        the http server
+ */
+tb_void_t               tb_http_server_exit(tb_http_server_ref_t server);
+
+/*! ctrl the http server option
+ *
+ * @param server        the http server
+ * @param option        the ctrl option
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_ctrl(tb_http_server_ref_t server, tb_size_t option, ...);
+
+/*! bind and listen the server address
+ *
+ * @param server        the http server
+ * @param addr          the address, we will bind a random port if the port is zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_bind(tb_http_server_ref_t server, tb_ipaddr_ref_t addr);
+
+/*! get the bound address
+ *
+ * @param server        the http server
+ * @param addr          the address
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_addr(tb_http_server_ref_t server, tb_ipaddr_ref_t addr);
+
+/*! start the http server
+ *
+ * each connection is served by a coroutine of the given scheduler
+ *
+ * @param server        the http server
+ * @param scheduler     the coroutine scheduler, use the scheduler of the current coroutine if be null
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_start(tb_http_server_ref_t server, tb_co_scheduler_ref_t scheduler);
+
+/*! stop the http server
+ *
+ * stop accepting and close all connections, it can be called in other threads
+ *
+ * @param server        the http server
+ */
+tb_void_t               tb_http_server_stop(tb_http_server_ref_t server);
+
+/*! get the request head value
+ *
+ * @param request       the request
+ * @param name          the head name, case-insensitive
+ * @param psize         the value size
+ *
+ * @return              the head value, it is not null-terminated
+ */
+tb_char_t const*        tb_http_server_request_head(tb_http_server_request_ref_t request, tb_char_t const* name, tb_size_t* psize);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
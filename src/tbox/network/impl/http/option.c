@@ -42,9 +42,11 @@ tb_bool_t tb_http_option_init(tb_http_option_t* option)
     option->method     = TB_HTTP_METHOD_GET;
     option->redirect   = TB_HTTP_DEFAULT_REDIRECT;
     option->timeout    = TB_HTTP_DEFAULT_TIMEOUT;
+    option->head_maxn  = TB_HTTP_DEFAULT_HEAD_MAXN;
     option->version    = 1; // HTTP/1.1
     option->bunzip     = 0;
     option->cookies    = tb_null;
+    option->pool       = tb_http_pool();
 
     // init url
     if (!tb_url_init(&option->url)) return tb_false;
@@ -74,6 +76,9 @@ tb_void_t tb_http_option_exit(tb_http_option_t* option)
 
     // clear cookies
     option->cookies = tb_null;
+
+    // clear pool
+    option->pool = tb_null;
 }
 tb_bool_t tb_http_option_ctrl(tb_http_option_t* option, tb_size_t code, tb_va_list_t args)
 {
@@ -412,6 +417,45 @@ tb_bool_t tb_http_option_ctrl(tb_http_option_t* option, tb_size_t code, tb_va_li
             return tb_true;
         }
         break;
+    case TB_HTTP_OPTION_SET_POOL:
+        {
+            // set pool
+            option->pool = (tb_http_pool_ref_t)tb_va_arg(args, tb_http_pool_ref_t);
+            return tb_true;
+        }
+        break;
+    case TB_HTTP_OPTION_GET_POOL:
+        {
+            // ppool
+            tb_http_pool_ref_t* ppool = (tb_http_pool_ref_t*)tb_va_arg(args, tb_http_pool_ref_t*);
+            tb_assert_and_check_return_val(ppool, tb_false);
+
+            // get pool
+            *ppool = option->pool;
+            return tb_true;
+        }
+        break;
+    case TB_HTTP_OPTION_SET_HEAD_MAXN:
+        {
+            // the head maxn
+            tb_size_t head_maxn = (tb_size_t)tb_va_arg(args, tb_size_t);
+
+            // set head maxn
+            option->head_maxn = head_maxn? head_maxn : TB_HTTP_DEFAULT_HEAD_MAXN;
+            return tb_true;
+        }
+        break;
+    case TB_HTTP_OPTION_GET_HEAD_MAXN:
+        {
+            // phead_maxn
+            tb_size_t* phead_maxn = (tb_size_t*)tb_va_arg(args, tb_size_t*);
+            tb_assert_and_check_return_val(phead_maxn, tb_false);
+
+            // get head maxn
+            *phead_maxn = option->head_maxn;
+            return tb_true;
+        }
+        break;
     case TB_HTTP_OPTION_SET_POST_URL:
         {
             // url
@@ -620,6 +664,8 @@ tb_void_t tb_http_option_dump(tb_http_option_t* option)
     tb_trace_i("option: redirect: %d",          option->redirect);
     tb_trace_i("option: range: %llu-%llu",      option->range.bof, option->range.eof);
     tb_trace_i("option: bunzip: %s",            option->bunzip? "true" : "false");
+    tb_trace_i("option: pool: %p",              option->pool);
+    tb_trace_i("option: head_maxn: %lu",        option->head_maxn);
 
     // dump head
     tb_char_t const*    head_data = (tb_char_t const*)tb_buffer_data(&option->head_data);
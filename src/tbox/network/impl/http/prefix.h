@@ -42,6 +42,13 @@
 /// the http default redirect maxn
 #define TB_HTTP_DEFAULT_REDIRECT                (10)
 
+/// the http default max size of the response head
+#ifdef __tb_small__
+#   define TB_HTTP_DEFAULT_HEAD_MAXN            (32768)
+#else
+#   define TB_HTTP_DEFAULT_HEAD_MAXN            (65536)
+#endif
+
 /// the http default port
 #define TB_HTTP_DEFAULT_PORT                    (80)
 
@@ -34,7 +34,11 @@
 #include "ipaddr.h"
 #include "hwaddr.h"
 #include "http.h"
+#include "http_pool.h"
 #include "cookies.h"
 #include "dns/dns.h"
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+#   include "http_server.h"
+#endif
 
 #endif
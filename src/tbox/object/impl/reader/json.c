@@ -31,6 +31,17 @@
  */
 #include "json.h"
 #include "reader.h"
+#if defined(TB_ARCH_AVX2)
+#   include <immintrin.h>
+#   define TB_OC_JSON_READER_SIMD_SSE2
+#   define TB_OC_JSON_READER_SIMD_AVX2
+#elif defined(TB_ARCH_SSE2)
+#   include <emmintrin.h>
+#   define TB_OC_JSON_READER_SIMD_SSE2
+#elif defined(TB_ARCH_ARM_NEON) && defined(TB_ARCH_ARM64)
+#   include <arm_neon.h>
+#   define TB_OC_JSON_READER_SIMD_NEON
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -43,9 +54,105 @@
 #   define TB_OC_JSON_READER_ARRAY_GROW             (256)
 #endif
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the fast json reader type
+typedef struct __tb_oc_json_fast_reader_t
+{
+    // the current position
+    tb_byte_t const*        p;
+
+    // the end position
+    tb_byte_t const*        e;
+
+    // the string data
+    tb_string_t             string;
+
+    // has invalid utf8 characters?
+    tb_bool_t               invalid;
+
+}tb_oc_json_fast_reader_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c_enter__
+tb_bool_t tb_stream_mapped_(tb_stream_ref_t stream);
+__tb_extern_c_leave__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// enable the fast reader?
+static tb_bool_t            g_fast = tb_true;
+
+// the reader has been hooked?
+static tb_bool_t            g_hooked = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+static tb_void_t tb_oc_json_reader_unicode(tb_string_ref_t data, tb_char_t const* unicode_str)
+{
+    // the unicode value
+    tb_uint16_t unicode_val = tb_s16toi32(unicode_str);
+
+    // the utf8 stream
+    tb_char_t           utf8_data[16] = {0};
+    tb_static_stream_t  utf8_stream;
+    tb_static_stream_init(&utf8_stream, (tb_byte_t*)utf8_data, sizeof(utf8_data));
+
+    // the unicode stream
+    tb_static_stream_t  unicode_stream = {0};
+    tb_static_stream_init(&unicode_stream, (tb_byte_t*)&unicode_val, 2);
+
+    // unicode to utf8
+    tb_long_t utf8_size = tb_charset_conv_bst(TB_CHARSET_TYPE_UCS2 | TB_CHARSET_TYPE_NE, TB_CHARSET_TYPE_UTF8, &unicode_stream, &utf8_stream);
+    if (utf8_size > 0) tb_string_cstrncat(data, utf8_data, utf8_size);
+}
+#endif
+tb_object_ref_t tb_oc_json_reader_number(tb_char_t const* cstr, tb_bool_t bs, tb_bool_t bf)
+{
+    // init number
+    tb_object_ref_t number = tb_null;
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    if (bf) number = tb_oc_number_init_from_double(tb_s10tod(cstr));
+#else
+    if (bf) tb_trace_noimpl();
+#endif
+    else if (bs)
+    {
+        tb_sint64_t value = tb_stoi64(cstr);
+        tb_size_t   bytes = tb_object_need_bytes(-value);
+        switch (bytes)
+        {
+        case 1: number = tb_oc_number_init_from_sint8((tb_sint8_t)value); break;
+        case 2: number = tb_oc_number_init_from_sint16((tb_sint16_t)value); break;
+        case 4: number = tb_oc_number_init_from_sint32((tb_sint32_t)value); break;
+        case 8: number = tb_oc_number_init_from_sint64((tb_sint64_t)value); break;
+        default: break;
+        }
+
+    }
+    else
+    {
+        tb_uint64_t value = tb_stou64(cstr);
+        tb_size_t   bytes = tb_object_need_bytes(value);
+        switch (bytes)
+        {
+        case 1: number = tb_oc_number_init_from_uint8((tb_uint8_t)value); break;
+        case 2: number = tb_oc_number_init_from_uint16((tb_uint16_t)value); break;
+        case 4: number = tb_oc_number_init_from_uint32((tb_uint32_t)value); break;
+        case 8: number = tb_oc_number_init_from_uint64((tb_uint64_t)value); break;
+        default: break;
+        }
+    }
+    return number;
+}
 static tb_object_ref_t tb_oc_json_reader_func_null(tb_oc_json_reader_t* reader, tb_char_t type)
 {
     // check
@@ -185,21 +292,8 @@ static tb_object_ref_t tb_oc_json_reader_func_string(tb_oc_json_reader_t* reader
                 if (!tb_stream_bread(reader->stream, (tb_byte_t*)unicode_str, 4)) break;
                 unicode_str[4] = '\0';
 
-                // the unicode value
-                tb_uint16_t unicode_val = tb_s16toi32(unicode_str);
-
-                // the utf8 stream
-                tb_char_t           utf8_data[16] = {0};
-                tb_static_stream_t  utf8_stream;
-                tb_static_stream_init(&utf8_stream, (tb_byte_t*)utf8_data, sizeof(utf8_data));
-
-                // the unicode stream
-                tb_static_stream_t  unicode_stream = {0};
-                tb_static_stream_init(&unicode_stream, (tb_byte_t*)&unicode_val, 2);
-
-                // unicode to utf8
-                tb_long_t utf8_size = tb_charset_conv_bst(TB_CHARSET_TYPE_UCS2 | TB_CHARSET_TYPE_NE, TB_CHARSET_TYPE_UTF8, &unicode_stream, &utf8_stream);
-                if (utf8_size > 0) tb_string_cstrncat(&data, utf8_data, utf8_size);
+                // append the unicode character
+                tb_oc_json_reader_unicode(&data, unicode_str);
 #else
                 // trace
                 tb_trace1_e("unicode type is not supported, please enable charset module config if you want to use it!");
@@ -274,6 +368,7 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
                 failed = tb_true;
                 break;
             }
+            else if (ch == 'e' || ch == 'E') bf = tb_true;
 
             // append character
             if (tb_isdigit10(ch) || ch == '.' || ch == 'e' || ch == 'E' || ch == '-' || ch == '+')
@@ -294,38 +389,7 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
         tb_trace_d("number: %s", tb_static_string_cstr(&data));
 
         // init number
-#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-        if (bf) number = tb_oc_number_init_from_float(tb_stof(tb_static_string_cstr(&data)));
-#else
-        if (bf) tb_trace_noimpl();
-#endif
-        else if (bs)
-        {
-            tb_sint64_t value = tb_stoi64(tb_static_string_cstr(&data));
-            tb_size_t   bytes = tb_object_need_bytes(-value);
-            switch (bytes)
-            {
-            case 1: number = tb_oc_number_init_from_sint8((tb_sint8_t)value); break;
-            case 2: number = tb_oc_number_init_from_sint16((tb_sint16_t)value); break;
-            case 4: number = tb_oc_number_init_from_sint32((tb_sint32_t)value); break;
-            case 8: number = tb_oc_number_init_from_sint64((tb_sint64_t)value); break;
-            default: break;
-            }
-
-        }
-        else
-        {
-            tb_uint64_t value = tb_stou64(tb_static_string_cstr(&data));
-            tb_size_t   bytes = tb_object_need_bytes(value);
-            switch (bytes)
-            {
-            case 1: number = tb_oc_number_init_from_uint8((tb_uint8_t)value); break;
-            case 2: number = tb_oc_number_init_from_uint16((tb_uint16_t)value); break;
-            case 4: number = tb_oc_number_init_from_uint32((tb_uint32_t)value); break;
-            case 8: number = tb_oc_number_init_from_uint64((tb_uint64_t)value); break;
-            default: break;
-            }
-        }
+        number = tb_oc_json_reader_number(tb_static_string_cstr(&data), bs, bf);
 
     } while (0);
 
@@ -475,11 +539,462 @@ static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* re
     // ok?
     return dictionary;
 }
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * fast reader
+ */
+
+/* get the size of the utf8 character at p, the overlong sequences, surrogates
+ * and the characters above 0x10ffff are invalid (rfc3629)
+ *
+ * @return the character size or 0 if it's invalid
+ */
+static __tb_inline__ tb_size_t tb_oc_json_reader_fast_utf8(tb_byte_t const* p, tb_byte_t const* e)
+{
+    tb_size_t n = e - p;
+    tb_byte_t c = *p;
+    if (c < 0x80) return 1;
+    else if (c >= 0xc2 && c <= 0xdf)
+    {
+        if (n > 1 && (p[1] & 0xc0) == 0x80) return 2;
+    }
+    else if (c >= 0xe0 && c <= 0xef)
+    {
+        if (n > 2 && (p[1] & 0xc0) == 0x80 && (p[2] & 0xc0) == 0x80
+            && (c != 0xe0 || p[1] >= 0xa0) && (c != 0xed || p[1] <= 0x9f)) return 3;
+    }
+    else if (c >= 0xf0 && c <= 0xf4)
+    {
+        if (n > 3 && (p[1] & 0xc0) == 0x80 && (p[2] & 0xc0) == 0x80 && (p[3] & 0xc0) == 0x80
+            && (c != 0xf0 || p[1] >= 0x90) && (c != 0xf4 || p[1] <= 0x8f)) return 4;
+    }
+    return 0;
+}
+static tb_bool_t tb_oc_json_reader_fast_utf8_valid(tb_byte_t const* p, tb_size_t size)
+{
+    tb_byte_t const* e = p + size;
+    while (p < e)
+    {
+        tb_size_t n = tb_oc_json_reader_fast_utf8(p, e);
+        tb_check_return_val(n, tb_false);
+        p += n;
+    }
+    return tb_true;
+}
+
+/* find the first quote or backslash and validate the utf8 characters in one pass
+ *
+ * the simd loop only stops at the bitmask of quotes, backslashes and non-ascii bytes,
+ * the non-ascii character is validated in place and then we continue to scan after it,
+ * so each byte is visited only once.
+ *
+ * @return the position of the quote or backslash, or tb_null if there are invalid utf8 characters
+ */
+static __tb_inline__ tb_byte_t const* tb_oc_json_reader_fast_scan(tb_byte_t const* p, tb_byte_t const* e)
+{
+#if defined(TB_OC_JSON_READER_SIMD_SSE2)
+#   if defined(TB_OC_JSON_READER_SIMD_AVX2)
+    __m256i dq32 = _mm256_set1_epi8('\"');
+    __m256i sq32 = _mm256_set1_epi8('\'');
+    __m256i bs32 = _mm256_set1_epi8('\\');
+#   endif
+    __m128i dq = _mm_set1_epi8('\"');
+    __m128i sq = _mm_set1_epi8('\'');
+    __m128i bs = _mm_set1_epi8('\\');
+#elif defined(TB_OC_JSON_READER_SIMD_NEON)
+    uint8x16_t dq = vdupq_n_u8('\"');
+    uint8x16_t sq = vdupq_n_u8('\'');
+    uint8x16_t bs = vdupq_n_u8('\\');
+    uint8x16_t hi = vdupq_n_u8(0x80);
+#endif
+    while (p < e)
+    {
+#if defined(TB_OC_JSON_READER_SIMD_SSE2)
+#   if defined(TB_OC_JSON_READER_SIMD_AVX2)
+        while (p + 32 <= e)
+        {
+            __m256i     v = _mm256_loadu_si256((__m256i const*)p);
+            tb_uint32_t m = (tb_uint32_t)_mm256_movemask_epi8(v) | (tb_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, dq32), _mm256_cmpeq_epi8(v, sq32)), _mm256_cmpeq_epi8(v, bs32)));
+            if (m)
+            {
+                p += tb_bits_cl0_u32_le(m);
+                break;
+            }
+            p += 32;
+        }
+#   endif
+        while (p + 16 <= e)
+        {
+            __m128i     v = _mm_loadu_si128((__m128i const*)p);
+            tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(v) | (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, dq), _mm_cmpeq_epi8(v, sq)), _mm_cmpeq_epi8(v, bs)));
+            if (m)
+            {
+                p += tb_bits_cl0_u32_le(m);
+                break;
+            }
+            p += 16;
+        }
+#elif defined(TB_OC_JSON_READER_SIMD_NEON)
+        while (p + 16 <= e)
+        {
+            uint8x16_t v = vld1q_u8(p);
+            if (vmaxvq_u8(vorrq_u8(vorrq_u8(vorrq_u8(vceqq_u8(v, dq), vceqq_u8(v, sq)), vceqq_u8(v, bs)), vcgeq_u8(v, hi)))) break;
+            p += 16;
+        }
+#endif
+
+        // find the left ascii characters
+        while (p < e && *p < 0x80 && *p != '\"' && *p != '\'' && *p != '\\') p++;
+        tb_check_break(p < e);
+
+        // is quote or backslash?
+        if (*p < 0x80) break;
+
+        // validate the non-ascii character
+        tb_size_t n = tb_oc_json_reader_fast_utf8(p, e);
+        tb_check_return_val(n, tb_null);
+        p += n;
+    }
+    return p;
+}
+static tb_object_ref_t tb_oc_json_reader_fast_value(tb_oc_json_fast_reader_t* reader, tb_char_t type);
+static tb_size_t tb_oc_json_reader_fast_alpha(tb_oc_json_fast_reader_t* reader, tb_char_t type, tb_char_t* data, tb_size_t maxn)
+{
+    // get the alpha characters
+    tb_size_t n = 0;
+    data[n++] = type;
+    while (reader->p < reader->e && tb_isalpha(*reader->p))
+    {
+        if (n + 1 < maxn) data[n++] = (tb_char_t)*reader->p;
+        reader->p++;
+    }
+    data[n] = '\0';
+    return n;
+}
+static tb_object_ref_t tb_oc_json_reader_fast_null(tb_oc_json_fast_reader_t* reader, tb_char_t type)
+{
+    // get the null string
+    tb_char_t data[256];
+    tb_oc_json_reader_fast_alpha(reader, type, data, sizeof(data));
+
+    // null?
+    return !tb_stricmp(data, "null")? tb_oc_null_init() : tb_null;
+}
+static tb_object_ref_t tb_oc_json_reader_fast_boolean(tb_oc_json_fast_reader_t* reader, tb_char_t type)
+{
+    // get the boolean string
+    tb_char_t data[256];
+    tb_oc_json_reader_fast_alpha(reader, type, data, sizeof(data));
+
+    // true or false?
+    if (!tb_stricmp(data, "true")) return tb_oc_boolean_init(tb_true);
+    else if (!tb_stricmp(data, "false")) return tb_oc_boolean_init(tb_false);
+    return tb_null;
+}
+static tb_object_ref_t tb_oc_json_reader_fast_number(tb_oc_json_fast_reader_t* reader, tb_char_t type)
+{
+    // get the number string
+    tb_char_t data[256];
+    tb_size_t n = 0;
+    tb_bool_t bs = (type == '-')? tb_true : tb_false;
+    tb_bool_t bf = (type == '.')? tb_true : tb_false;
+    data[n++] = type;
+    while (reader->p < reader->e)
+    {
+        // is float?
+        tb_char_t ch = (tb_char_t)*reader->p;
+        if (ch == '.')
+        {
+            tb_check_return_val(!bf, tb_null);
+            bf = tb_true;
+        }
+        else if (ch == 'e' || ch == 'E') bf = tb_true;
+
+        // append character
+        if (tb_isdigit10(ch) || ch == '.' || ch == 'e' || ch == 'E' || ch == '-' || ch == '+')
+        {
+            if (n + 1 < sizeof(data)) data[n++] = ch;
+            reader->p++;
+        }
+        else break;
+    }
+    data[n] = '\0';
+
+    // init number
+    return tb_oc_json_reader_number(data, bs, bf);
+}
+static tb_void_t tb_oc_json_reader_fast_append(tb_string_ref_t data, tb_byte_t const* p, tb_size_t n)
+{
+    /* append characters without tb_string_cstrncat
+     *
+     * @note the input data may be mapped from file directly,
+     * so we cannot copy it by the checked tb_memcpy() in debug mode
+     */
+    tb_size_t   size = tb_string_size(data);
+    tb_byte_t*  cstr = tb_buffer_resize(data, size + n + 1);
+    if (cstr)
+    {
+        tb_memcpy_(cstr + size, p, n);
+        cstr[size + n] = '\0';
+    }
+}
+static tb_object_ref_t tb_oc_json_reader_fast_string(tb_oc_json_fast_reader_t* reader, tb_char_t type)
+{
+    // clear the string data
+    tb_string_ref_t data = &reader->string;
+    tb_string_clear(data);
+
+    // walk
+    tb_byte_t const* p = reader->p;
+    tb_byte_t const* e = reader->e;
+    while (p < e)
+    {
+        // find the end or the escaped character
+        tb_byte_t const* q = tb_oc_json_reader_fast_scan(p, e);
+
+        // invalid utf8? we will read it by the stream reader
+        if (!q)
+        {
+            reader->invalid = tb_true;
+            return tb_null;
+        }
+
+        // append characters
+        if (q > p) tb_oc_json_reader_fast_append(data, p, q - p);
+        p = q;
+        tb_check_break(p < e);
+
+        // end?
+        tb_char_t ch = (tb_char_t)*p++;
+        if (ch == '\"' || ch == '\'') break;
+
+        // the escaped character
+        tb_check_break(p < e);
+        ch = (tb_char_t)*p++;
+
+        // unicode?
+        if (ch == 'u')
+        {
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+            // the unicode string
+            tb_char_t unicode_str[5];
+            if (e - p < 4)
+            {
+                p = e;
+                break;
+            }
+            tb_memcpy_(unicode_str, p, 4);
+            unicode_str[4] = '\0';
+            p += 4;
+
+            // append the unicode character
+            tb_oc_json_reader_unicode(data, unicode_str);
+#else
+            tb_string_chrcat(data, ch);
+#endif
+        }
+        else if (ch == 'n') tb_string_chrcat(data, '\n');
+        else if (ch == 't') tb_string_chrcat(data, '\t');
+        else tb_string_chrcat(data, ch);
+    }
+    reader->p = p;
+
+    // init string
+    return tb_oc_string_init_from_cstr(tb_string_cstr(data));
+}
+static tb_object_ref_t tb_oc_json_reader_fast_array(tb_oc_json_fast_reader_t* reader, tb_char_t type)
+{
+    // init array
+    tb_object_ref_t array = tb_oc_array_init(TB_OC_JSON_READER_ARRAY_GROW, tb_false);
+    tb_assert_and_check_return_val(array, tb_null);
+
+    // done
+    tb_bool_t ok = tb_true;
+    while (reader->p < reader->e)
+    {
+        // end?
+        tb_char_t ch = (tb_char_t)*reader->p++;
+        if (ch == ']') break;
+        // no space? skip ','
+        else if (!tb_isspace(ch) && ch != ',')
+        {
+            // read item
+            tb_object_ref_t item = tb_oc_json_reader_fast_value(reader, ch);
+            tb_check_break_state(item, ok, tb_false);
+
+            // append item
+            tb_oc_array_append(array, item);
+        }
+    }
+
+    // failed?
+    if (!ok)
+    {
+        tb_object_exit(array);
+        array = tb_null;
+    }
+    return array;
+}
+static tb_object_ref_t tb_oc_json_reader_fast_dictionary(tb_oc_json_fast_reader_t* reader, tb_char_t type)
+{
+    // init key name
+    tb_static_string_t  kname;
+    tb_char_t           kdata[8192];
+    if (!tb_static_string_init(&kname, kdata, 8192)) return tb_null;
+
+    // init dictionary
+    tb_object_ref_t dictionary = tb_oc_dictionary_init(0, tb_false);
+    tb_assert_and_check_return_val(dictionary, tb_null);
+
+    // walk, the key is parsed in the same way as the stream reader
+    tb_bool_t ok = tb_true;
+    tb_bool_t bkey = tb_false;
+    tb_bool_t high = tb_false;
+    tb_size_t bstr = 0;
+    while (reader->p < reader->e)
+    {
+        // end?
+        tb_char_t ch = (tb_char_t)*reader->p++;
+        if (ch == '}') break;
+        // no space? skip ','
+        else if (!tb_isspace(ch) && ch != ',')
+        {
+            // no key?
+            if (!bkey)
+            {
+                // is str?
+                if (ch == '\"' || ch == '\'') bstr = !bstr;
+                // is key end?
+                else if (!bstr && ch == ':') bkey = tb_true;
+                // append key
+                else if (bstr)
+                {
+                    tb_static_string_chrcat(&kname, ch);
+                    if (ch & 0x80) high = tb_true;
+                }
+            }
+            // key ok? read val
+            else
+            {
+                // invalid utf8 key?
+                if (high && !tb_oc_json_reader_fast_utf8_valid((tb_byte_t const*)tb_static_string_cstr(&kname), tb_static_string_size(&kname)))
+                {
+                    reader->invalid = tb_true;
+                    ok = tb_false;
+                    break;
+                }
+
+                // read val
+                tb_object_ref_t val = tb_oc_json_reader_fast_value(reader, ch);
+                tb_check_break_state(val, ok, tb_false);
+
+                // set key => val
+                tb_oc_dictionary_insert(dictionary, tb_static_string_cstr(&kname), val);
+
+                // reset key
+                bstr = 0;
+                bkey = tb_false;
+                high = tb_false;
+                tb_static_string_clear(&kname);
+            }
+        }
+    }
+
+    // failed?
+    if (!ok)
+    {
+        tb_object_exit(dictionary);
+        dictionary = tb_null;
+    }
+
+    // exit key name
+    tb_static_string_exit(&kname);
+    return dictionary;
+}
+static tb_object_ref_t tb_oc_json_reader_fast_value(tb_oc_json_fast_reader_t* reader, tb_char_t type)
+{
+    switch (type)
+    {
+    case '{':
+        return tb_oc_json_reader_fast_dictionary(reader, type);
+    case '[':
+        return tb_oc_json_reader_fast_array(reader, type);
+    case '\"':
+    case '\'':
+        return tb_oc_json_reader_fast_string(reader, type);
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+    case '.': case '-': case '+': case 'e': case 'E':
+        return tb_oc_json_reader_fast_number(reader, type);
+    case 't': case 'T': case 'f': case 'F':
+        return tb_oc_json_reader_fast_boolean(reader, type);
+    case 'n': case 'N':
+        return tb_oc_json_reader_fast_null(reader, type);
+    default:
+        break;
+    }
+    return tb_null;
+}
+static tb_bool_t tb_oc_json_reader_fast_done(tb_stream_ref_t stream, tb_object_ref_t* pobject)
+{
+    /* only for the mapped or in-memory input,
+     * otherwise tb_stream_need() will grow the stream cache to the whole document
+     */
+    tb_check_return_val(tb_stream_type(stream) == TB_STREAM_TYPE_DATA || tb_stream_mapped_(stream), tb_false);
+
+    // the input size is unknown?
+    tb_hize_t left = tb_stream_left(stream);
+    tb_check_return_val(left && left != (tb_hize_t)-1 && left <= TB_MAXS32, tb_false);
+
+    // get all data, it will be mapped directly if the file stream is mapped
+    tb_byte_t* data = tb_null;
+    if (!tb_stream_need(stream, &data, (tb_size_t)left) || !data) return tb_false;
+
+    // init reader
+    tb_oc_json_fast_reader_t reader;
+    reader.p        = data;
+    reader.e        = data + left;
+    reader.invalid  = tb_false;
+    if (!tb_string_init(&reader.string)) return tb_false;
+
+    // skip spaces
+    while (reader.p < reader.e && tb_isspace(*reader.p)) reader.p++;
+
+    // read it
+    tb_object_ref_t object = tb_null;
+    if (reader.p < reader.e)
+    {
+        tb_char_t type = (tb_char_t)*reader.p++;
+        object = tb_oc_json_reader_fast_value(&reader, type);
+    }
+
+    // exit reader
+    tb_string_exit(&reader.string);
+
+    // failed or invalid utf8? we read it again by the stream reader
+    if (reader.invalid) tb_trace_d("invalid utf8 characters, read it by the stream reader");
+    tb_check_return_val(object, tb_false);
+
+    // skip the read data
+    if (!tb_stream_skip(stream, reader.p - data))
+    {
+        tb_object_exit(object);
+        return tb_false;
+    }
+
+    // ok
+    *pobject = object;
+    return tb_true;
+}
+
 static tb_object_ref_t tb_oc_json_reader_done(tb_stream_ref_t stream)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
 
+    // read it by the fast reader first
+    tb_object_ref_t object = tb_null;
+    if (g_fast && !g_hooked && tb_oc_json_reader_fast_done(stream, &object)) return object;
+
     // init reader
     tb_oc_json_reader_t reader = {0};
     reader.stream = stream;
@@ -591,6 +1106,9 @@ tb_bool_t tb_oc_json_reader_hook(tb_char_t type, tb_oc_json_reader_func_t func)
     // hook it
     tb_hash_map_insert(reader->hooker, (tb_pointer_t)(tb_size_t)type, func);
 
+    // the fast reader will be disabled after hooking
+    g_hooked = tb_true;
+
     // ok
     return tb_true;
 }
@@ -606,4 +1124,69 @@ tb_oc_json_reader_func_t tb_oc_json_reader_func(tb_char_t type)
     // the func
     return (tb_oc_json_reader_func_t)tb_hash_map_get(reader->hooker, (tb_pointer_t)(tb_size_t)type);
 }
+tb_void_t tb_oc_json_reader_fast_enable(tb_bool_t enable)
+{
+    g_fast = enable;
+}
+tb_byte_t const* tb_oc_json_reader_scan(tb_byte_t const* p, tb_byte_t const* e, tb_bool_t* phigh)
+{
+    // check
+    tb_assert_and_check_return_val(p && e && phigh, e);
+
+    // scan it
+    tb_uint32_t high = 0;
+#if defined(TB_OC_JSON_READER_SIMD_SSE2)
+#   if defined(TB_OC_JSON_READER_SIMD_AVX2)
+    __m256i dq32 = _mm256_set1_epi8('\"');
+    __m256i sq32 = _mm256_set1_epi8('\'');
+    __m256i bs32 = _mm256_set1_epi8('\\');
+    while (p + 32 <= e)
+    {
+        __m256i     v = _mm256_loadu_si256((__m256i const*)p);
+        tb_uint32_t h = (tb_uint32_t)_mm256_movemask_epi8(v);
+        tb_uint32_t m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, dq32), _mm256_cmpeq_epi8(v, sq32)), _mm256_cmpeq_epi8(v, bs32)));
+        if (m)
+        {
+            tb_size_t n = tb_bits_cl0_u32_le(m);
+            *phigh = (high | (h & (((tb_uint32_t)1 << n) - 1)))? tb_true : tb_false;
+            return p + n;
+        }
+        high |= h;
+        p += 32;
+    }
+#   endif
+    __m128i dq = _mm_set1_epi8('\"');
+    __m128i sq = _mm_set1_epi8('\'');
+    __m128i bs = _mm_set1_epi8('\\');
+    while (p + 16 <= e)
+    {
+        __m128i     v = _mm_loadu_si128((__m128i const*)p);
+        tb_uint32_t h = (tb_uint32_t)_mm_movemask_epi8(v);
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, dq), _mm_cmpeq_epi8(v, sq)), _mm_cmpeq_epi8(v, bs)));
+        if (m)
+        {
+            tb_size_t n = tb_bits_cl0_u32_le(m);
+            *phigh = (high | (h & (((tb_uint32_t)1 << n) - 1)))? tb_true : tb_false;
+            return p + n;
+        }
+        high |= h;
+        p += 16;
+    }
+#elif defined(TB_OC_JSON_READER_SIMD_NEON)
+    uint8x16_t dq = vdupq_n_u8('\"');
+    uint8x16_t sq = vdupq_n_u8('\'');
+    uint8x16_t bs = vdupq_n_u8('\\');
+    while (p + 16 <= e)
+    {
+        uint8x16_t v = vld1q_u8(p);
+        if (vmaxvq_u8(vorrq_u8(vorrq_u8(vceqq_u8(v, dq), vceqq_u8(v, sq)), vceqq_u8(v, bs)))) break;
+        high |= vmaxvq_u8(v) & 0x80;
+        p += 16;
+    }
+#endif
 
+    // find the left characters
+    while (p < e && *p != '\"' && *p != '\'' && *p != '\\') high |= *p++ & 0x80;
+    *phigh = high? tb_true : tb_false;
+    return p;
+}
@@ -74,6 +74,32 @@ tb_bool_t                       tb_oc_json_reader_hook(tb_char_t type, tb_oc_jso
  */
 tb_oc_json_reader_func_t        tb_oc_json_reader_func(tb_char_t type);
 
+/*! enable or disable the fast json reader
+ *
+ * @param enable                enable it?
+ */
+tb_void_t                       tb_oc_json_reader_fast_enable(tb_bool_t enable);
+
+/*! init number object from the json number string
+ *
+ * @param cstr                  the number string
+ * @param bs                    is signed number?
+ * @param bf                    is float number?
+ *
+ * @return                      the number object
+ */
+tb_object_ref_t                 tb_oc_json_reader_number(tb_char_t const* cstr, tb_bool_t bs, tb_bool_t bf);
+
+/*! find the first quote or backslash character in the string data
+ *
+ * @param data                  the data
+ * @param tail                  the data tail
+ * @param phigh                 will be set if there are non-ascii characters before the found position
+ *
+ * @return                      the found position or tail
+ */
+tb_byte_t const*                tb_oc_json_reader_scan(tb_byte_t const* data, tb_byte_t const* tail, tb_bool_t* phigh);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
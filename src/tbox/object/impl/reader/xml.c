@@ -385,7 +385,7 @@ static tb_object_ref_t tb_oc_xml_reader_func_number(tb_oc_xml_reader_t* reader,
                 for (; *p; p++)
                 {
                     if (!s && *p == '-') s = 1;
-                    if (!f && *p == '.') f = 1;
+                    if (!f && (*p == '.' || *p == 'e' || *p == 'E')) f = 1;
                     if (s && f) break;
                 }
 
@@ -376,7 +376,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_number(tb_oc_xplist_reader_t* re
                 for (; *p; p++)
                 {
                     if (!s && *p == '-') s = 1;
-                    if (!f && *p == '.') f = 1;
+                    if (!f && (*p == '.' || *p == 'e' || *p == 'E')) f = 1;
                     if (s && f) break;
                 }
 
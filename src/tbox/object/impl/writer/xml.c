@@ -261,14 +261,22 @@ static tb_bool_t tb_oc_xml_writer_func_number(tb_oc_xml_writer_t* writer, tb_obj
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_OC_NUMBER_TYPE_FLOAT:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%f</number>", tb_oc_number_float(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        {
+            tb_char_t data[64];
+            if (!tb_ftoa(tb_oc_number_float(object), data, sizeof(data))) return tb_false;
+            if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
+            if (tb_stream_printf(writer->stream, "<number>%s</number>", data) < 0) return tb_false;
+            if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        }
         break;
     case TB_OC_NUMBER_TYPE_DOUBLE:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%lf</number>", tb_oc_number_double(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        {
+            tb_char_t data[64];
+            if (!tb_dtoa(tb_oc_number_double(object), data, sizeof(data))) return tb_false;
+            if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
+            if (tb_stream_printf(writer->stream, "<number>%s</number>", data) < 0) return tb_false;
+            if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        }
         break;
 #endif
     default:
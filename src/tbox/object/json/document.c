@@ -0,0 +1,993 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        document.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "json_document"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "document.h"
+#include "../object.h"
+#include "../impl/reader/json.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the nodes grow
+#ifdef __tb_small__
+#   define TB_JSON_DOCUMENT_NODES_GROW          (256)
+#else
+#   define TB_JSON_DOCUMENT_NODES_GROW          (4096)
+#endif
+
+// the max depth of the nested values
+#define TB_JSON_DOCUMENT_DEPTH_MAXN             (512)
+
+// the max count of the node, it will be counted again if be saturated
+#define TB_JSON_DOCUMENT_COUNT_MAXN             (0xffff)
+
+// the node flags
+#define TB_JSON_DOCUMENT_FLAG_ESCAPED           (1)     //!< the string has escaped characters
+#define TB_JSON_DOCUMENT_FLAG_SIGNED            (2)     //!< the number is signed
+#define TB_JSON_DOCUMENT_FLAG_FLOAT             (4)     //!< the number is float
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the json document node type, 16 bytes
+typedef struct __tb_json_document_node_t
+{
+    // the offset of the value in the data
+    tb_uint32_t                 offset;
+
+    // the raw size of the value in the data
+    tb_uint32_t                 size;
+
+    // the index of the next sibling node
+    tb_uint32_t                 next;
+
+    // the object type
+    tb_uint8_t                  type;
+
+    // the flags
+    tb_uint8_t                  flags;
+
+    // the children count of array or dictionary
+    tb_uint16_t                 count;
+
+}tb_json_document_node_t;
+
+// the json document type
+typedef struct __tb_json_document_t
+{
+    // the data
+    tb_byte_t const*            data;
+
+    // the data size
+    tb_size_t                   size;
+
+    // the nodes
+    tb_json_document_node_t*    nodes;
+
+    // the nodes size
+    tb_size_t                   nodes_size;
+
+    // the nodes maxn
+    tb_size_t                   nodes_maxn;
+
+    // the stream of the mapped data
+    tb_stream_ref_t             stream;
+
+    // the owned data
+    tb_byte_t*                  owned;
+
+}tb_json_document_t;
+
+// the json document parser type
+typedef struct __tb_json_document_parser_t
+{
+    // the document
+    tb_json_document_t*         document;
+
+    // the current position
+    tb_byte_t const*            p;
+
+    // the end position
+    tb_byte_t const*            e;
+
+}tb_json_document_parser_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * parser
+ */
+static __tb_inline__ tb_void_t tb_json_document_parser_skip(tb_json_document_parser_t* parser)
+{
+    tb_byte_t const* p = parser->p;
+    tb_byte_t const* e = parser->e;
+    while (p < e && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    parser->p = p;
+}
+static tb_size_t tb_json_document_parser_node(tb_json_document_parser_t* parser, tb_size_t type)
+{
+    // grow nodes
+    tb_json_document_t* document = parser->document;
+    if (document->nodes_size >= document->nodes_maxn)
+    {
+        // the node index must be less than TB_MAXU32
+        tb_size_t maxn = document->nodes_maxn + TB_JSON_DOCUMENT_NODES_GROW + (document->nodes_maxn >> 1);
+        tb_check_return_val(maxn < TB_MAXU32, TB_JSON_DOCUMENT_CURSOR_NONE);
+
+        // resize nodes
+        document->nodes = tb_ralloc_type(document->nodes, maxn, tb_json_document_node_t);
+        tb_assert_and_check_return_val(document->nodes, TB_JSON_DOCUMENT_CURSOR_NONE);
+        document->nodes_maxn = maxn;
+    }
+
+    // make node
+    tb_size_t                   index = document->nodes_size++;
+    tb_json_document_node_t*    node = document->nodes + index;
+    node->offset    = (tb_uint32_t)(parser->p - document->data);
+    node->size      = 0;
+    node->next      = 0;
+    node->type      = (tb_uint8_t)type;
+    node->flags     = 0;
+    node->count     = 0;
+    return index;
+}
+static tb_bool_t tb_json_document_parser_literal(tb_json_document_parser_t* parser, tb_char_t const* literal, tb_size_t size)
+{
+    // check
+    tb_check_return_val(parser->p + size <= parser->e && !tb_memcmp(parser->p, literal, size), tb_false);
+
+    // skip it
+    parser->p += size;
+    return tb_true;
+}
+static tb_bool_t tb_json_document_parser_string(tb_json_document_parser_t* parser, tb_size_t index)
+{
+    // skip '\"'
+    tb_byte_t const* p = parser->p + 1;
+    tb_byte_t const* e = parser->e;
+
+    // walk
+    tb_bool_t ok = tb_false;
+    while (p < e)
+    {
+        // find the end or the escaped character
+        tb_bool_t           high = tb_false;
+        tb_byte_t const*    q = tb_oc_json_reader_scan(p, e, &high);
+
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+        // invalid utf8?
+        if (high && !tb_charset_utf8_valid(p, q - p)) break;
+#endif
+
+        // end?
+        p = q;
+        tb_check_break(p < e);
+        if (*p == '\"')
+        {
+            p++;
+            ok = tb_true;
+            break;
+        }
+        // single quote? continue it
+        else if (*p == '\'')
+        {
+            p++;
+            continue;
+        }
+
+        // the escaped character
+        parser->document->nodes[index].flags |= TB_JSON_DOCUMENT_FLAG_ESCAPED;
+        tb_check_break(++p < e);
+        switch (*p++)
+        {
+        case '\"': case '\\': case '/': case 'b':
+        case 'f': case 'n': case 'r': case 't':
+            break;
+        case 'u':
+            if (p + 4 <= e && tb_isdigit16(p[0]) && tb_isdigit16(p[1]) && tb_isdigit16(p[2]) && tb_isdigit16(p[3]))
+                p += 4;
+            else p = e;
+            break;
+        default:
+            p = e;
+            break;
+        }
+    }
+
+    // update position
+    parser->p = p;
+    return ok;
+}
+static tb_bool_t tb_json_document_parser_number(tb_json_document_parser_t* parser, tb_size_t index)
+{
+    // the flags
+    tb_byte_t           flags = 0;
+    tb_byte_t const*    p = parser->p;
+    tb_byte_t const*    e = parser->e;
+
+    // the sign
+    if (p < e && *p == '-')
+    {
+        flags |= TB_JSON_DOCUMENT_FLAG_SIGNED;
+        p++;
+    }
+
+    // the integer part
+    if (p < e && *p == '0') p++;
+    else if (p < e && *p >= '1' && *p <= '9')
+    {
+        while (p < e && tb_isdigit10(*p)) p++;
+    }
+    else return tb_false;
+
+    // the fraction part
+    if (p < e && *p == '.')
+    {
+        flags |= TB_JSON_DOCUMENT_FLAG_FLOAT;
+        tb_check_return_val(++p < e && tb_isdigit10(*p), tb_false);
+        while (p < e && tb_isdigit10(*p)) p++;
+    }
+
+    // the exponent part
+    if (p < e && (*p == 'e' || *p == 'E'))
+    {
+        flags |= TB_JSON_DOCUMENT_FLAG_FLOAT;
+        if (++p < e && (*p == '+' || *p == '-')) p++;
+        tb_check_return_val(p < e && tb_isdigit10(*p), tb_false);
+        while (p < e && tb_isdigit10(*p)) p++;
+    }
+
+    // update position
+    parser->document->nodes[index].flags = flags;
+    parser->p = p;
+    return tb_true;
+}
+static tb_bool_t tb_json_document_parser_value(tb_json_document_parser_t* parser, tb_size_t depth);
+static tb_bool_t tb_json_document_parser_array(tb_json_document_parser_t* parser, tb_size_t index, tb_size_t depth)
+{
+    // skip '['
+    parser->p++;
+
+    // empty?
+    tb_json_document_parser_skip(parser);
+    if (parser->p < parser->e && *parser->p == ']')
+    {
+        parser->p++;
+        return tb_true;
+    }
+
+    // walk
+    tb_size_t count = 0;
+    while (1)
+    {
+        // parse item
+        if (!tb_json_document_parser_value(parser, depth + 1)) return tb_false;
+        count++;
+
+        // the next item or end
+        tb_json_document_parser_skip(parser);
+        tb_check_return_val(parser->p < parser->e, tb_false);
+        tb_char_t ch = (tb_char_t)*parser->p++;
+        if (ch == ']') break;
+        else if (ch != ',') return tb_false;
+    }
+
+    // save count
+    parser->document->nodes[index].count = (tb_uint16_t)tb_min(count, TB_JSON_DOCUMENT_COUNT_MAXN);
+    return tb_true;
+}
+static tb_bool_t tb_json_document_parser_dictionary(tb_json_document_parser_t* parser, tb_size_t index, tb_size_t depth)
+{
+    // skip '{'
+    parser->p++;
+
+    // empty?
+    tb_json_document_parser_skip(parser);
+    if (parser->p < parser->e && *parser->p == '}')
+    {
+        parser->p++;
+        return tb_true;
+    }
+
+    // walk
+    tb_size_t count = 0;
+    while (1)
+    {
+        // parse key
+        tb_json_document_parser_skip(parser);
+        tb_check_return_val(parser->p < parser->e && *parser->p == '\"', tb_false);
+        if (!tb_json_document_parser_value(parser, depth + 1)) return tb_false;
+
+        // skip ':'
+        tb_json_document_parser_skip(parser);
+        tb_check_return_val(parser->p < parser->e && *parser->p == ':', tb_false);
+        parser->p++;
+
+        // parse value
+        if (!tb_json_document_parser_value(parser, depth + 1)) return tb_false;
+        count++;
+
+        // the next member or end
+        tb_json_document_parser_skip(parser);
+        tb_check_return_val(parser->p < parser->e, tb_false);
+        tb_char_t ch = (tb_char_t)*parser->p++;
+        if (ch == '}') break;
+        else if (ch != ',') return tb_false;
+    }
+
+    // save count
+    parser->document->nodes[index].count = (tb_uint16_t)tb_min(count, TB_JSON_DOCUMENT_COUNT_MAXN);
+    return tb_true;
+}
+static tb_bool_t tb_json_document_parser_value(tb_json_document_parser_t* parser, tb_size_t depth)
+{
+    // too deep?
+    tb_check_return_val(depth < TB_JSON_DOCUMENT_DEPTH_MAXN, tb_false);
+
+    // skip spaces
+    tb_json_document_parser_skip(parser);
+    tb_check_return_val(parser->p < parser->e, tb_false);
+
+    // the object type
+    tb_size_t type = TB_OBJECT_TYPE_NONE;
+    switch (*parser->p)
+    {
+    case '{':   type = TB_OBJECT_TYPE_DICTIONARY;   break;
+    case '[':   type = TB_OBJECT_TYPE_ARRAY;        break;
+    case '\"':  type = TB_OBJECT_TYPE_STRING;       break;
+    case 't':
+    case 'f':   type = TB_OBJECT_TYPE_BOOLEAN;      break;
+    case 'n':   type = TB_OBJECT_TYPE_NULL;         break;
+    default:    type = TB_OBJECT_TYPE_NUMBER;       break;
+    }
+
+    // make node
+    tb_size_t index = tb_json_document_parser_node(parser, type);
+    tb_check_return_val(index != TB_JSON_DOCUMENT_CURSOR_NONE, tb_false);
+
+    // parse it
+    tb_bool_t           ok = tb_false;
+    tb_byte_t const*    b = parser->p;
+    switch (type)
+    {
+    case TB_OBJECT_TYPE_DICTIONARY:
+        ok = tb_json_document_parser_dictionary(parser, index, depth);
+        break;
+    case TB_OBJECT_TYPE_ARRAY:
+        ok = tb_json_document_parser_array(parser, index, depth);
+        break;
+    case TB_OBJECT_TYPE_STRING:
+        ok = tb_json_document_parser_string(parser, index);
+        break;
+    case TB_OBJECT_TYPE_BOOLEAN:
+        ok = *b == 't'? tb_json_document_parser_literal(parser, "true", 4) : tb_json_document_parser_literal(parser, "false", 5);
+        break;
+    case TB_OBJECT_TYPE_NULL:
+        ok = tb_json_document_parser_literal(parser, "null", 4);
+        break;
+    default:
+        ok = tb_json_document_parser_number(parser, index);
+        break;
+    }
+    tb_check_return_val(ok, tb_false);
+
+    // save the raw size and the next sibling
+    tb_json_document_node_t* node = parser->document->nodes + index;
+    node->size  = (tb_uint32_t)(parser->p - b);
+    node->next  = (tb_uint32_t)parser->document->nodes_size;
+    return tb_true;
+}
+static tb_bool_t tb_json_document_parse(tb_json_document_t* document)
+{
+    // init parser
+    tb_json_document_parser_t parser;
+    parser.document = document;
+    parser.p        = document->data;
+    parser.e        = document->data + document->size;
+
+    // skip the utf8 bom
+    if (document->size >= 3 && parser.p[0] == 0xef && parser.p[1] == 0xbb && parser.p[2] == 0xbf) parser.p += 3;
+
+    // parse the root value
+    tb_check_return_val(tb_json_document_parser_value(&parser, 0), tb_false);
+
+    // only spaces are left?
+    tb_json_document_parser_skip(&parser);
+    return parser.p == parser.e;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_json_document_node_t* tb_json_document_node(tb_json_document_t* document, tb_size_t cursor)
+{
+    return (document && cursor < document->nodes_size)? document->nodes + cursor : tb_null;
+}
+/* decode the string node, the decoded size is not larger than the raw size
+ *
+ * @return the decoded size
+ */
+static tb_size_t tb_json_document_decode(tb_json_document_t* document, tb_json_document_node_t const* node, tb_char_t* data)
+{
+    // the raw string without quotes, it has been validated when parsing it
+    tb_byte_t const*    p = document->data + node->offset + 1;
+    tb_byte_t const*    e = document->data + node->offset + node->size - 1;
+    tb_char_t*          q = data;
+
+    // no escaped characters?
+    if (!(node->flags & TB_JSON_DOCUMENT_FLAG_ESCAPED))
+    {
+        tb_memcpy_(q, p, e - p);
+        return e - p;
+    }
+
+    // walk
+    while (p < e)
+    {
+        // copy the normal characters
+        tb_byte_t const* b = p;
+        while (p < e && *p != '\\') p++;
+        if (p > b)
+        {
+            tb_memcpy_(q, b, p - b);
+            q += p - b;
+        }
+        tb_check_break(p < e);
+
+        // the escaped character
+        p++;
+        tb_byte_t ch = *p++;
+        switch (ch)
+        {
+        case 'b': *q++ = '\b'; break;
+        case 'f': *q++ = '\f'; break;
+        case 'n': *q++ = '\n'; break;
+        case 'r': *q++ = '\r'; break;
+        case 't': *q++ = '\t'; break;
+        case 'u':
+            {
+                // the unicode character
+                tb_uint32_t uc = tb_json_hex4(p);
+                p += 4;
+
+                // the surrogate pair?
+                if (uc >= 0xd800 && uc < 0xdc00 && p + 6 <= e && p[0] == '\\' && p[1] == 'u')
+                {
+                    tb_uint32_t lc = tb_json_hex4(p + 2);
+                    if (lc >= 0xdc00 && lc < 0xe000)
+                    {
+                        uc = 0x10000 + ((uc - 0xd800) << 10) + (lc - 0xdc00);
+                        p += 6;
+                    }
+                }
+
+                // the lone surrogate will be replaced with U+FFFD
+                if (uc >= 0xd800 && uc < 0xe000) uc = 0xfffd;
+
+                // the utf8 size is always not larger than the escaped size
+                q += tb_json_utf8_encode(uc, q);
+            }
+            break;
+        default:
+            *q++ = (tb_char_t)ch;
+            break;
+        }
+    }
+    return q - data;
+}
+static tb_bool_t tb_json_document_equal(tb_json_document_t* document, tb_json_document_node_t const* node, tb_char_t const* key, tb_size_t size)
+{
+    // the raw string without quotes
+    tb_byte_t const*    data = document->data + node->offset + 1;
+    tb_size_t           rawn = node->size - 2;
+
+    // no escaped characters? compare it directly
+    if (!(node->flags & TB_JSON_DOCUMENT_FLAG_ESCAPED))
+        return rawn == size && !tb_memcmp(data, key, size);
+
+    // the decoded string cannot be longer than the raw string
+    tb_check_return_val(size <= rawn, tb_false);
+
+    // decode and compare it
+    tb_char_t   temp[256];
+    tb_char_t*  cstr = rawn <= sizeof(temp)? temp : tb_malloc_cstr(rawn);
+    tb_check_return_val(cstr, tb_false);
+    tb_bool_t ok = tb_json_document_decode(document, node, cstr) == size && !tb_memcmp(cstr, key, size);
+    if (cstr != temp) tb_free(cstr);
+    return ok;
+}
+static tb_size_t tb_json_document_count(tb_json_document_t* document, tb_size_t cursor)
+{
+    // the node
+    tb_json_document_node_t* node = tb_json_document_node(document, cursor);
+    tb_check_return_val(node && (node->type == TB_OBJECT_TYPE_ARRAY || node->type == TB_OBJECT_TYPE_DICTIONARY), 0);
+
+    // the count has been saturated? count it again
+    tb_size_t count = node->count;
+    if (count == TB_JSON_DOCUMENT_COUNT_MAXN)
+    {
+        count = 0;
+        tb_size_t next = cursor + 1;
+        for (; next < node->next; next = document->nodes[next].next) count++;
+        if (node->type == TB_OBJECT_TYPE_DICTIONARY) count >>= 1;
+    }
+    return count;
+}
+static tb_char_t const* tb_json_document_number(tb_json_document_t* document, tb_json_document_node_t const* node, tb_char_t* data, tb_size_t maxn)
+{
+    // check
+    tb_check_return_val(node && node->type == TB_OBJECT_TYPE_NUMBER && node->size < maxn, tb_null);
+
+    // copy the number string
+    tb_memcpy_(data, document->data + node->offset, node->size);
+    data[node->size] = '\0';
+    return data;
+}
+static tb_object_ref_t tb_json_document_make(tb_json_document_t* document, tb_size_t cursor)
+{
+    // the node
+    tb_json_document_node_t* node = tb_json_document_node(document, cursor);
+    tb_check_return_val(node, tb_null);
+
+    // make object
+    tb_object_ref_t object = tb_null;
+    switch (node->type)
+    {
+    case TB_OBJECT_TYPE_NULL:
+        object = tb_oc_null_init();
+        break;
+    case TB_OBJECT_TYPE_BOOLEAN:
+        object = tb_oc_boolean_init(document->data[node->offset] == 't');
+        break;
+    case TB_OBJECT_TYPE_NUMBER:
+        {
+            tb_char_t data[64];
+            if (tb_json_document_number(document, node, data, sizeof(data)))
+                object = tb_oc_json_reader_number(data, (node->flags & TB_JSON_DOCUMENT_FLAG_SIGNED)? tb_true : tb_false
+                                                        , (node->flags & TB_JSON_DOCUMENT_FLAG_FLOAT)? tb_true : tb_false);
+        }
+        break;
+    case TB_OBJECT_TYPE_STRING:
+        {
+            tb_char_t* cstr = tb_malloc_cstr(node->size);
+            if (cstr)
+            {
+                cstr[tb_json_document_decode(document, node, cstr)] = '\0';
+                object = tb_oc_string_init_from_cstr(cstr);
+                tb_free(cstr);
+            }
+        }
+        break;
+    case TB_OBJECT_TYPE_ARRAY:
+        {
+            object = tb_oc_array_init(tb_max(tb_json_document_count(document, cursor), 16), tb_false);
+            tb_check_break(object);
+
+            tb_size_t item = cursor + 1;
+            for (; item < node->next; item = document->nodes[item].next)
+            {
+                tb_object_ref_t value = tb_json_document_make(document, item);
+                if (!value)
+                {
+                    tb_object_exit(object);
+                    object = tb_null;
+                    break;
+                }
+                tb_oc_array_append(object, value);
+            }
+        }
+        break;
+    case TB_OBJECT_TYPE_DICTIONARY:
+        {
+            tb_size_t count = tb_json_document_count(document, cursor);
+            object = tb_oc_dictionary_init(count <= TB_OC_DICTIONARY_SIZE_MICRO? TB_OC_DICTIONARY_SIZE_MICRO : 0, tb_false);
+            tb_check_break(object);
+
+            tb_size_t key = cursor + 1;
+            while (key < node->next)
+            {
+                // make key and value
+                tb_json_document_node_t const*  knode = document->nodes + key;
+                tb_size_t                       value = knode->next;
+                tb_char_t*                      kdata = tb_malloc_cstr(knode->size);
+                tb_object_ref_t                 vdata = kdata? tb_json_document_make(document, value) : tb_null;
+                if (vdata)
+                {
+                    kdata[tb_json_document_decode(document, knode, kdata)] = '\0';
+                    tb_oc_dictionary_insert(object, kdata, vdata);
+                }
+                if (kdata) tb_free(kdata);
+
+                // failed?
+                if (!vdata)
+                {
+                    tb_object_exit(object);
+                    object = tb_null;
+                    break;
+                }
+
+                // the next key
+                key = document->nodes[value].next;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return object;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_json_document_ref_t tb_json_document_init(tb_byte_t const* data, tb_size_t size)
+{
+    // check, the offset of node is 32bits
+    tb_assert_and_check_return_val(data && size && size < TB_MAXU32, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_json_document_t* document = tb_null;
+    do
+    {
+        // make document
+        document = tb_malloc0_type(tb_json_document_t);
+        tb_assert_and_check_break(document);
+
+        // init document
+        document->data = data;
+        document->size = size;
+
+        // reserve nodes, we assume that a value uses 8 bytes at least
+        document->nodes_maxn = tb_max(size >> 3, TB_JSON_DOCUMENT_NODES_GROW);
+        document->nodes = tb_nalloc_type(document->nodes_maxn, tb_json_document_node_t);
+        tb_assert_and_check_break(document->nodes);
+
+        // parse it
+        if (!tb_json_document_parse(document))
+        {
+            tb_trace_d("invalid json data at node(%lu)", document->nodes_size);
+            break;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (document) tb_json_document_exit((tb_json_document_ref_t)document);
+        document = tb_null;
+    }
+    return (tb_json_document_ref_t)document;
+}
+tb_json_document_ref_t tb_json_document_init_from_url(tb_char_t const* url)
+{
+    // check
+    tb_assert_and_check_return_val(url, tb_null);
+
+    // done
+    tb_stream_ref_t         stream = tb_null;
+    tb_byte_t*              owned = tb_null;
+    tb_json_document_ref_t  document = tb_null;
+    do
+    {
+        // init stream
+        stream = tb_stream_init_from_url(url);
+        tb_assert_and_check_break(stream);
+
+        // map the file data
+        if (tb_stream_type(stream) == TB_STREAM_TYPE_FILE)
+            tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_SET_MMAP, TB_STREAM_FILE_MMAP_SEQUENTIAL);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // get all data, it will be mapped directly if the file stream is mapped
+        tb_byte_t*  data = tb_null;
+        tb_hize_t   size = tb_stream_left(stream);
+        if (size && size != (tb_hize_t)-1 && size < TB_MAXU32)
+        {
+            if (!tb_stream_need(stream, &data, (tb_size_t)size)) break;
+        }
+        // the size is unknown? read all data
+        else
+        {
+            tb_size_t real = 0;
+            owned = tb_stream_bread_all(stream, tb_false, &real);
+            tb_check_break(owned);
+
+            // we need not the stream now
+            tb_stream_exit(stream);
+            stream = tb_null;
+            data = owned;
+            size = real;
+        }
+
+        // init document
+        document = tb_json_document_init(data, (tb_size_t)size);
+        tb_check_break(document);
+
+        // save the stream and data
+        ((tb_json_document_t*)document)->stream = stream;
+        ((tb_json_document_t*)document)->owned = owned;
+        stream = tb_null;
+        owned = tb_null;
+
+    } while (0);
+
+    // exit stream and data
+    if (stream) tb_stream_exit(stream);
+    if (owned) tb_free(owned);
+    return document;
+}
+tb_void_t tb_json_document_exit(tb_json_document_ref_t self)
+{
+    // check
+    tb_json_document_t* document = (tb_json_document_t*)self;
+    tb_assert_and_check_return(document);
+
+    // exit nodes
+    if (document->nodes) tb_free(document->nodes);
+    document->nodes = tb_null;
+
+    // exit stream
+    if (document->stream) tb_stream_exit(document->stream);
+    document->stream = tb_null;
+
+    // exit data
+    if (document->owned) tb_free(document->owned);
+    document->owned = tb_null;
+
+    // exit it
+    tb_free(document);
+}
+tb_size_t tb_json_document_root(tb_json_document_ref_t self)
+{
+    // check
+    tb_json_document_t* document = (tb_json_document_t*)self;
+    tb_assert_and_check_return_val(document && document->nodes_size, TB_JSON_DOCUMENT_CURSOR_NONE);
+
+    // the root is always the first node
+    return 0;
+}
+tb_size_t tb_json_document_type(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    tb_json_document_node_t* node = tb_json_document_node((tb_json_document_t*)self, cursor);
+    return node? node->type : TB_OBJECT_TYPE_NONE;
+}
+tb_size_t tb_json_document_size(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    return tb_json_document_count((tb_json_document_t*)self, cursor);
+}
+tb_size_t tb_json_document_head(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    // the node
+    tb_json_document_node_t* node = tb_json_document_node((tb_json_document_t*)self, cursor);
+    tb_check_return_val(node && (node->type == TB_OBJECT_TYPE_ARRAY || node->type == TB_OBJECT_TYPE_DICTIONARY), TB_JSON_DOCUMENT_CURSOR_NONE);
+
+    // the first child
+    return cursor + 1;
+}
+tb_size_t tb_json_document_tail(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    // the node
+    tb_json_document_node_t* node = tb_json_document_node((tb_json_document_t*)self, cursor);
+    tb_check_return_val(node && (node->type == TB_OBJECT_TYPE_ARRAY || node->type == TB_OBJECT_TYPE_DICTIONARY), TB_JSON_DOCUMENT_CURSOR_NONE);
+
+    // the tail is the next node of the last child
+    return node->next;
+}
+tb_size_t tb_json_document_next(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    // the node
+    tb_json_document_node_t* node = tb_json_document_node((tb_json_document_t*)self, cursor);
+    tb_check_return_val(node, TB_JSON_DOCUMENT_CURSOR_NONE);
+
+    // the next sibling or the tail of parent
+    return node->next;
+}
+tb_size_t tb_json_document_item(tb_json_document_ref_t self, tb_size_t cursor, tb_size_t index)
+{
+    // the node
+    tb_json_document_t*         document = (tb_json_document_t*)self;
+    tb_json_document_node_t*    node = tb_json_document_node(document, cursor);
+    tb_check_return_val(node && node->type == TB_OBJECT_TYPE_ARRAY && index < tb_json_document_count(document, cursor), TB_JSON_DOCUMENT_CURSOR_NONE);
+
+    // skip the previous items
+    tb_size_t item = cursor + 1;
+    while (index--) item = document->nodes[item].next;
+    return item;
+}
+tb_size_t tb_json_document_value(tb_json_document_ref_t self, tb_size_t cursor, tb_char_t const* key)
+{
+    // the node
+    tb_json_document_t*         document = (tb_json_document_t*)self;
+    tb_json_document_node_t*    node = tb_json_document_node(document, cursor);
+    tb_check_return_val(node && node->type == TB_OBJECT_TYPE_DICTIONARY && key, TB_JSON_DOCUMENT_CURSOR_NONE);
+
+    // find the key
+    tb_size_t size = tb_strlen(key);
+    tb_size_t item = cursor + 1;
+    while (item < node->next)
+    {
+        // the value
+        tb_size_t value = document->nodes[item].next;
+        if (tb_json_document_equal(document, document->nodes + item, key, size)) return value;
+
+        // the next key
+        item = document->nodes[value].next;
+    }
+    return TB_JSON_DOCUMENT_CURSOR_NONE;
+}
+tb_size_t tb_json_document_seek(tb_json_document_ref_t self, tb_size_t cursor, tb_char_t const* path)
+{
+    // check
+    tb_assert_and_check_return_val(self, TB_JSON_DOCUMENT_CURSOR_NONE);
+
+    // null?
+    tb_check_return_val(path, cursor);
+
+    // done
+    tb_char_t const* p = path;
+    tb_char_t const* e = path + tb_strlen(path);
+    while (p < e && cursor != TB_JSON_DOCUMENT_CURSOR_NONE)
+    {
+        // done seek
+        switch (*p)
+        {
+        case '.':
+            {
+                // skip
+                p++;
+
+                // read the key name
+                tb_char_t   key[4096] = {0};
+                tb_char_t*  kb = key;
+                tb_char_t*  ke = key + 4095;
+                for (; p < e && kb < ke && *p && (*p != '.' && *p != '[' && *p != ']'); p++, kb++)
+                {
+                    if (*p == '\\') p++;
+                    *kb = *p;
+                }
+
+                // trace
+                tb_trace_d("key: %s", key);
+
+                // the value
+                cursor = tb_json_document_value(self, cursor, key);
+            }
+            break;
+        case '[':
+            {
+                // skip
+                p++;
+
+                // read the item index
+                tb_char_t   index[32] = {0};
+                tb_char_t*  ib = index;
+                tb_char_t*  ie = index + 31;
+                for (; p < e && ib < ie && *p && tb_isdigit10(*p); p++, ib++) *ib = *p;
+
+                // trace
+                tb_trace_d("index: %s", index);
+
+                // the item
+                cursor = tb_json_document_item(self, cursor, tb_atoi(index));
+            }
+            break;
+        case ']':
+        default:
+            p++;
+            break;
+        }
+    }
+
+    // ok?
+    return cursor;
+}
+tb_bool_t tb_json_document_bool(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    // the node
+    tb_json_document_t*         document = (tb_json_document_t*)self;
+    tb_json_document_node_t*    node = tb_json_document_node(document, cursor);
+    tb_check_return_val(node && node->type == TB_OBJECT_TYPE_BOOLEAN, tb_false);
+
+    // the value
+    return document->data[node->offset] == 't';
+}
+tb_sint64_t tb_json_document_sint64(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    // the number string
+    tb_json_document_t* document = (tb_json_document_t*)self;
+    tb_char_t           data[64];
+    tb_char_t const*    cstr = tb_json_document_number(document, tb_json_document_node(document, cursor), data, sizeof(data));
+    tb_check_return_val(cstr, 0);
+
+    // the value
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    if (document->nodes[cursor].flags & TB_JSON_DOCUMENT_FLAG_FLOAT) return (tb_sint64_t)tb_s10tod(cstr);
+#endif
+    return tb_s10toi64(cstr);
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+tb_double_t tb_json_document_double(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    // the number string
+    tb_json_document_t* document = (tb_json_document_t*)self;
+    tb_char_t           data[64];
+    tb_char_t const*    cstr = tb_json_document_number(document, tb_json_document_node(document, cursor), data, sizeof(data));
+    tb_check_return_val(cstr, 0);
+
+    // the value
+    return tb_s10tod(cstr);
+}
+#endif
+tb_long_t tb_json_document_string(tb_json_document_ref_t self, tb_size_t cursor, tb_char_t* data, tb_size_t maxn)
+{
+    // check
+    tb_json_document_t*         document = (tb_json_document_t*)self;
+    tb_json_document_node_t*    node = tb_json_document_node(document, cursor);
+    tb_assert_and_check_return_val(data && maxn, -1);
+    tb_check_return_val(node && node->type == TB_OBJECT_TYPE_STRING, -1);
+
+    // too small? the decoded size is not larger than the raw size
+    if (node->size - 1 > maxn)
+    {
+        // decode it to the temporary data
+        tb_char_t* cstr = tb_malloc_cstr(node->size);
+        tb_check_return_val(cstr, -1);
+        tb_size_t size = tb_json_document_decode(document, node, cstr);
+        if (size < maxn)
+        {
+            tb_memcpy(data, cstr, size);
+            data[size] = '\0';
+        }
+        tb_free(cstr);
+        return size < maxn? (tb_long_t)size : -1;
+    }
+
+    // decode it
+    tb_size_t size = tb_json_document_decode(document, node, data);
+    data[size] = '\0';
+    return size;
+}
+tb_object_ref_t tb_json_document_object(tb_json_document_ref_t self, tb_size_t cursor)
+{
+    // check
+    tb_assert_and_check_return_val(self, tb_null);
+
+    // make object
+    return tb_json_document_make((tb_json_document_t*)self, cursor);
+}
@@ -0,0 +1,244 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        document.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_JSON_DOCUMENT_H
+#define TB_OBJECT_JSON_DOCUMENT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the invalid cursor of the json document
+#define TB_JSON_DOCUMENT_CURSOR_NONE                ((tb_size_t)-1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the json document ref type
+ *
+ * the json data is parsed once into a compact tape of nodes (16 bytes per value),
+ * and the values are referenced by cursors (the node index on the tape).
+ *
+ * we only decode strings and numbers or make objects for the accessed values,
+ * so it is faster than tb_object_read() if we only need a few fields of a large document.
+ *
+ * the members of dictionary are stored as key and value pairs on the tape:
+ *
+ * <pre>
+ * {"a": 1, "b": [true, null]}
+ *
+ * cursor: 0     1    2    3    4        5     6
+ * node:   {...} "a"  1    "b"  [...]    true  null
+ * </pre>
+ */
+typedef __tb_typeref__(json_document);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the json document from the given data
+ *
+ * @param data          the json data, it must be kept until the document is exited
+ * @param size          the data size
+ *
+ * @return              the document, return tb_null if the json data is invalid
+ */
+tb_json_document_ref_t  tb_json_document_init(tb_byte_t const* data, tb_size_t size);
+
+/*! init the json document from the given url
+ *
+ * the file data will be mapped directly and not be copied
+ *
+ * @param url           the url
+ *
+ * @return              the document, return tb_null if the json data is invalid
+ */
+tb_json_document_ref_t  tb_json_document_init_from_url(tb_char_t const* url);
+
+/*! exit the json document
+ *
+ * @param document      the document
+ */
+tb_void_t               tb_json_document_exit(tb_json_document_ref_t document);
+
+/*! the root cursor
+ *
+ * @param document      the document
+ *
+ * @return              the root cursor
+ */
+tb_size_t               tb_json_document_root(tb_json_document_ref_t document);
+
+/*! the value type
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ *
+ * @return              the object type, e.g. TB_OBJECT_TYPE_DICTIONARY, TB_OBJECT_TYPE_NONE if the cursor is invalid
+ */
+tb_size_t               tb_json_document_type(tb_json_document_ref_t document, tb_size_t cursor);
+
+/*! the item count of the array or the member count of the dictionary
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ *
+ * @return              the count
+ */
+tb_size_t               tb_json_document_size(tb_json_document_ref_t document, tb_size_t cursor);
+
+/*! the head cursor of the array or dictionary children
+ *
+ * @note the children of dictionary are the key and value nodes, e.g. key1, value1, key2, value2, ...
+ *
+ * @param document      the document
+ * @param cursor        the cursor of array or dictionary
+ *
+ * @return              the head cursor, it is equal to the tail cursor if the container is empty
+ *
+ * @code
+ *
+    tb_size_t tail = tb_json_document_tail(document, array);
+    tb_size_t item = tb_json_document_head(document, array);
+    for (; item != tail; item = tb_json_document_next(document, item))
+    {
+        // ...
+    }
+
+ * @endcode
+ */
+tb_size_t               tb_json_document_head(tb_json_document_ref_t document, tb_size_t cursor);
+
+/*! the tail cursor of the array or dictionary children
+ *
+ * @param document      the document
+ * @param cursor        the cursor of array or dictionary
+ *
+ * @return              the tail cursor
+ */
+tb_size_t               tb_json_document_tail(tb_json_document_ref_t document, tb_size_t cursor);
+
+/*! the next cursor
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ *
+ * @return              the next sibling cursor, or the tail cursor of the parent if it is the last child
+ */
+tb_size_t               tb_json_document_next(tb_json_document_ref_t document, tb_size_t cursor);
+
+/*! the array item
+ *
+ * @param document      the document
+ * @param cursor        the cursor of array
+ * @param index         the item index
+ *
+ * @return              the item cursor or TB_JSON_DOCUMENT_CURSOR_NONE
+ */
+tb_size_t               tb_json_document_item(tb_json_document_ref_t document, tb_size_t cursor, tb_size_t index);
+
+/*! the dictionary value
+ *
+ * @param document      the document
+ * @param cursor        the cursor of dictionary
+ * @param key           the key
+ *
+ * @return              the value cursor or TB_JSON_DOCUMENT_CURSOR_NONE
+ */
+tb_size_t               tb_json_document_value(tb_json_document_ref_t document, tb_size_t cursor, tb_char_t const* key);
+
+/*! seek to the value for the given path, e.g. ".array[5].string"
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ * @param path          the path, the same as tb_object_seek() without macro
+ *
+ * @return              the value cursor or TB_JSON_DOCUMENT_CURSOR_NONE
+ */
+tb_size_t               tb_json_document_seek(tb_json_document_ref_t document, tb_size_t cursor, tb_char_t const* path);
+
+/*! the boolean value
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_document_bool(tb_json_document_ref_t document, tb_size_t cursor);
+
+/*! the integer value of the number
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ *
+ * @return              the value, the float number will be truncated
+ */
+tb_sint64_t             tb_json_document_sint64(tb_json_document_ref_t document, tb_size_t cursor);
+
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+/*! the double value of the number
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ *
+ * @return              the value
+ */
+tb_double_t             tb_json_document_double(tb_json_document_ref_t document, tb_size_t cursor);
+#endif
+
+/*! the decoded string value
+ *
+ * @param document      the document
+ * @param cursor        the cursor of string
+ * @param data          the string data
+ * @param maxn          the string maxn
+ *
+ * @return              the string size, return -1 if the cursor is not string or the data is too small
+ */
+tb_long_t               tb_json_document_string(tb_json_document_ref_t document, tb_size_t cursor, tb_char_t* data, tb_size_t maxn);
+
+/*! make the object of the given value
+ *
+ * @param document      the document
+ * @param cursor        the cursor
+ *
+ * @return              the object, need to exit it by tb_object_exit()
+ */
+tb_object_ref_t         tb_json_document_object(tb_json_document_ref_t document, tb_size_t cursor);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,79 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        prefix.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_JSON_PREFIX_H
+#define TB_OBJECT_JSON_PREFIX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+#include "../../stream/stream.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+// the value of the four hex digits, e.g. "4e2d" => 0x4e2d
+static __tb_inline__ tb_uint32_t tb_json_hex4(tb_byte_t const* p)
+{
+    tb_uint32_t ch = 0;
+    tb_size_t   i = 0;
+    for (i = 0; i < 4; i++)
+    {
+        tb_byte_t c = p[i];
+        ch <<= 4;
+        if (c >= '0' && c <= '9') ch |= c - '0';
+        else if (c >= 'a' && c <= 'f') ch |= c - 'a' + 10;
+        else ch |= c - 'A' + 10;
+    }
+    return ch;
+}
+
+// encode the unicode character to utf8 and return the utf8 size
+static __tb_inline__ tb_size_t tb_json_utf8_encode(tb_uint32_t ch, tb_char_t* data)
+{
+    if (ch < 0x80)
+    {
+        data[0] = (tb_char_t)ch;
+        return 1;
+    }
+    else if (ch < 0x800)
+    {
+        data[0] = (tb_char_t)(0xc0 | (ch >> 6));
+        data[1] = (tb_char_t)(0x80 | (ch & 0x3f));
+        return 2;
+    }
+    else if (ch < 0x10000)
+    {
+        data[0] = (tb_char_t)(0xe0 | (ch >> 12));
+        data[1] = (tb_char_t)(0x80 | ((ch >> 6) & 0x3f));
+        data[2] = (tb_char_t)(0x80 | (ch & 0x3f));
+        return 3;
+    }
+    data[0] = (tb_char_t)(0xf0 | (ch >> 18));
+    data[1] = (tb_char_t)(0x80 | ((ch >> 12) & 0x3f));
+    data[2] = (tb_char_t)(0x80 | ((ch >> 6) & 0x3f));
+    data[3] = (tb_char_t)(0x80 | (ch & 0x3f));
+    return 4;
+}
+
+#endif
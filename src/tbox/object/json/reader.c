@@ -0,0 +1,680 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        reader.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "json_reader"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "reader.h"
+#include "../impl/reader/json.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max depth of the nested values
+#define TB_JSON_READER_DEPTH_MAXN               (512)
+
+// the max size of the number string
+#define TB_JSON_READER_NUMBER_MAXN              (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the json reader state enum
+typedef enum __tb_json_reader_state_e
+{
+    TB_JSON_READER_STATE_ROOT                   = 0     //!< expect the root value or end
+,   TB_JSON_READER_STATE_VALUE                  = 1     //!< expect the value
+,   TB_JSON_READER_STATE_VALUE_OR_END           = 2     //!< expect the first array item or ']'
+,   TB_JSON_READER_STATE_KEY                    = 3     //!< expect the key
+,   TB_JSON_READER_STATE_KEY_OR_END             = 4     //!< expect the first key or '}'
+,   TB_JSON_READER_STATE_NEXT                   = 5     //!< expect ',' or the end of the container
+
+}tb_json_reader_state_e;
+
+// the json reader impl type
+typedef struct __tb_json_reader_impl_t
+{
+    // the event
+    tb_size_t               event;
+
+    // the state
+    tb_size_t               state;
+
+    // the level
+    tb_size_t               level;
+
+    // has error?
+    tb_bool_t               error;
+
+    // is bowner of the stream?
+    tb_bool_t               bowner;
+
+    // the boolean value
+    tb_bool_t               boolean;
+
+    // is float number?
+    tb_bool_t               bfloat;
+
+    // the stream
+    tb_stream_ref_t         stream;
+
+    // the peeked data
+    tb_byte_t const*        b;
+
+    // the current position of the peeked data
+    tb_byte_t const*        p;
+
+    // the end position of the peeked data
+    tb_byte_t const*        e;
+
+    // the string data
+    tb_buffer_t             data;
+
+    // the string size
+    tb_size_t               size;
+
+    // the container stack, '{' or '['
+    tb_byte_t               stack[TB_JSON_READER_DEPTH_MAXN];
+
+}tb_json_reader_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * parser implementation
+ */
+static tb_bool_t tb_json_reader_fill(tb_json_reader_impl_t* impl)
+{
+    // skip the consumed data
+    if (impl->b)
+    {
+        tb_size_t size = impl->e - impl->b;
+        impl->b = tb_null;
+        impl->p = tb_null;
+        impl->e = tb_null;
+        if (!tb_stream_skip(impl->stream, size)) return tb_false;
+    }
+
+    // peek the next data
+    while (!tb_stream_beof(impl->stream))
+    {
+        // peek data
+        tb_byte_t*  data = tb_null;
+        tb_long_t   real = tb_stream_peek(impl->stream, &data, TB_STREAM_BLOCK_MAXN);
+
+        // ok?
+        if (real > 0 && data)
+        {
+            impl->b = data;
+            impl->p = data;
+            impl->e = data + real;
+            return tb_true;
+        }
+        // no data? wait it
+        else if (!real)
+        {
+            real = tb_stream_wait(impl->stream, TB_STREAM_WAIT_READ, tb_stream_timeout(impl->stream));
+            tb_check_break(real > 0);
+        }
+        // failed or end?
+        else break;
+    }
+    return tb_false;
+}
+static __tb_inline__ tb_long_t tb_json_reader_peekc(tb_json_reader_impl_t* impl)
+{
+    if (impl->p == impl->e && !tb_json_reader_fill(impl)) return -1;
+    return *impl->p;
+}
+static __tb_inline__ tb_long_t tb_json_reader_getc(tb_json_reader_impl_t* impl)
+{
+    if (impl->p == impl->e && !tb_json_reader_fill(impl)) return -1;
+    return *impl->p++;
+}
+static tb_long_t tb_json_reader_space(tb_json_reader_impl_t* impl)
+{
+    // skip spaces and peek the next character
+    while (1)
+    {
+        while (impl->p < impl->e && (*impl->p == ' ' || *impl->p == '\n' || *impl->p == '\r' || *impl->p == '\t')) impl->p++;
+        if (impl->p < impl->e) return *impl->p;
+        if (!tb_json_reader_fill(impl)) return -1;
+    }
+}
+static tb_bool_t tb_json_reader_append(tb_json_reader_impl_t* impl, tb_byte_t const* data, tb_size_t size)
+{
+    // grow data
+    tb_byte_t* cstr = tb_buffer_resize(&impl->data, impl->size + size + 1);
+    tb_assert_and_check_return_val(cstr, tb_false);
+
+    /* append data
+     *
+     * @note the peeked data may be mapped from file directly,
+     * so we cannot copy it by the checked tb_memcpy() in debug mode
+     */
+    tb_memcpy_(cstr + impl->size, data, size);
+    impl->size += size;
+    cstr[impl->size] = '\0';
+    return tb_true;
+}
+static tb_bool_t tb_json_reader_hex4(tb_json_reader_impl_t* impl, tb_uint32_t* pch)
+{
+    // get four hex digits
+    tb_byte_t   hex[4];
+    tb_size_t   i = 0;
+    for (i = 0; i < 4; i++)
+    {
+        tb_long_t ch = tb_json_reader_getc(impl);
+        tb_check_return_val(ch >= 0 && tb_isdigit16(ch), tb_false);
+        hex[i] = (tb_byte_t)ch;
+    }
+
+    // the unicode character
+    *pch = tb_json_hex4(hex);
+    return tb_true;
+}
+static tb_bool_t tb_json_reader_escape(tb_json_reader_impl_t* impl, tb_long_t esc);
+static tb_bool_t tb_json_reader_unicode(tb_json_reader_impl_t* impl)
+{
+    // the unicode character
+    tb_uint32_t uc = 0;
+    tb_check_return_val(tb_json_reader_hex4(impl, &uc), tb_false);
+
+    // the high surrogate? try to get the low surrogate from the next escaped character
+    tb_char_t data[4];
+    if (uc >= 0xd800 && uc < 0xdc00 && tb_json_reader_peekc(impl) == '\\')
+    {
+        impl->p++;
+        tb_long_t esc = tb_json_reader_getc(impl);
+        if (esc == 'u')
+        {
+            tb_uint32_t lc = 0;
+            tb_check_return_val(tb_json_reader_hex4(impl, &lc), tb_false);
+            if (lc >= 0xdc00 && lc < 0xe000) uc = 0x10000 + ((uc - 0xd800) << 10) + (lc - 0xdc00);
+            else
+            {
+                // append the lone high surrogate
+                if (!tb_json_reader_append(impl, (tb_byte_t const*)data, tb_json_utf8_encode(0xfffd, data))) return tb_false;
+                uc = lc;
+            }
+        }
+        else
+        {
+            // append the lone high surrogate and the next escaped character
+            if (!tb_json_reader_append(impl, (tb_byte_t const*)data, tb_json_utf8_encode(0xfffd, data))) return tb_false;
+            return tb_json_reader_escape(impl, esc);
+        }
+    }
+
+    // the lone surrogate will be replaced with U+FFFD
+    if (uc >= 0xd800 && uc < 0xe000) uc = 0xfffd;
+
+    // append it
+    return tb_json_reader_append(impl, (tb_byte_t const*)data, tb_json_utf8_encode(uc, data));
+}
+static tb_bool_t tb_json_reader_escape(tb_json_reader_impl_t* impl, tb_long_t esc)
+{
+    // the escaped character
+    tb_byte_t ch;
+    switch (esc)
+    {
+    case '\"': ch = '\"'; break;
+    case '\\': ch = '\\'; break;
+    case '/': ch = '/'; break;
+    case 'b': ch = '\b'; break;
+    case 'f': ch = '\f'; break;
+    case 'n': ch = '\n'; break;
+    case 'r': ch = '\r'; break;
+    case 't': ch = '\t'; break;
+    case 'u': return tb_json_reader_unicode(impl);
+    default: return tb_false;
+    }
+    return tb_json_reader_append(impl, &ch, 1);
+}
+static tb_bool_t tb_json_reader_string_parse(tb_json_reader_impl_t* impl)
+{
+    // skip '\"'
+    impl->p++;
+
+    // clear data
+    impl->size = 0;
+    tb_byte_t* cstr = tb_buffer_resize(&impl->data, 1);
+    tb_assert_and_check_return_val(cstr, tb_false);
+    cstr[0] = '\0';
+
+    // walk
+    tb_bool_t high = tb_false;
+    while (1)
+    {
+        // no data? fill it
+        if (impl->p == impl->e && !tb_json_reader_fill(impl)) return tb_false;
+
+        // find the end or the escaped character
+        tb_bool_t           h = tb_false;
+        tb_byte_t const*    q = tb_oc_json_reader_scan(impl->p, impl->e, &h);
+        if (q > impl->p && !tb_json_reader_append(impl, impl->p, q - impl->p)) return tb_false;
+        if (h) high = tb_true;
+        impl->p = q;
+        tb_check_continue(q < impl->e);
+
+        // end?
+        tb_byte_t ch = *impl->p++;
+        if (ch == '\"') break;
+        // single quote? append it
+        else if (ch == '\'')
+        {
+            if (!tb_json_reader_append(impl, &ch, 1)) return tb_false;
+            continue;
+        }
+
+        // the escaped character
+        if (!tb_json_reader_escape(impl, tb_json_reader_getc(impl))) return tb_false;
+    }
+
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+    // check utf8, we check the whole string because the character may be split by the peeked data
+    if (high && !tb_charset_utf8_valid((tb_byte_t const*)tb_buffer_data(&impl->data), impl->size)) return tb_false;
+#endif
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_json_reader_number_parse(tb_json_reader_impl_t* impl)
+{
+    // read the number string
+    tb_char_t   data[TB_JSON_READER_NUMBER_MAXN];
+    tb_size_t   size = 0;
+    while (1)
+    {
+        tb_long_t ch = tb_json_reader_peekc(impl);
+        tb_check_break(ch >= 0 && (tb_isdigit10(ch) || ch == '.' || ch == 'e' || ch == 'E' || ch == '-' || ch == '+'));
+        tb_check_return_val(size + 1 < sizeof(data), tb_false);
+        data[size++] = (tb_char_t)ch;
+        impl->p++;
+    }
+    data[size] = '\0';
+
+    // check the number grammar
+    tb_char_t const* p = data;
+    tb_char_t const* e = data + size;
+    if (p < e && *p == '-') p++;
+    if (p < e && *p == '0') p++;
+    else if (p < e && *p >= '1' && *p <= '9')
+    {
+        while (p < e && tb_isdigit10(*p)) p++;
+    }
+    else return tb_false;
+    impl->bfloat = tb_false;
+    if (p < e && *p == '.')
+    {
+        impl->bfloat = tb_true;
+        tb_check_return_val(++p < e && tb_isdigit10(*p), tb_false);
+        while (p < e && tb_isdigit10(*p)) p++;
+    }
+    if (p < e && (*p == 'e' || *p == 'E'))
+    {
+        impl->bfloat = tb_true;
+        if (++p < e && (*p == '+' || *p == '-')) p++;
+        tb_check_return_val(p < e && tb_isdigit10(*p), tb_false);
+        while (p < e && tb_isdigit10(*p)) p++;
+    }
+    tb_check_return_val(p == e, tb_false);
+
+    // save the number string
+    impl->size = 0;
+    return tb_json_reader_append(impl, (tb_byte_t const*)data, size);
+}
+static tb_bool_t tb_json_reader_literal_parse(tb_json_reader_impl_t* impl, tb_char_t const* literal)
+{
+    // check the literal characters
+    for (; *literal; literal++)
+    {
+        if (tb_json_reader_getc(impl) != *literal) return tb_false;
+    }
+    return tb_true;
+}
+static tb_size_t tb_json_reader_value_parse(tb_json_reader_impl_t* impl, tb_long_t ch)
+{
+    // done
+    tb_size_t event = TB_JSON_READER_EVENT_NONE;
+    switch (ch)
+    {
+    case '{':
+    case '[':
+        {
+            // too deep?
+            tb_check_break(impl->level < TB_JSON_READER_DEPTH_MAXN);
+
+            // enter the container
+            impl->p++;
+            impl->stack[impl->level++] = (tb_byte_t)ch;
+            impl->state = ch == '{'? TB_JSON_READER_STATE_KEY_OR_END : TB_JSON_READER_STATE_VALUE_OR_END;
+            return ch == '{'? TB_JSON_READER_EVENT_DICTIONARY_BEG : TB_JSON_READER_EVENT_ARRAY_BEG;
+        }
+    case '\"':
+        if (tb_json_reader_string_parse(impl)) event = TB_JSON_READER_EVENT_STRING;
+        break;
+    case 't':
+        impl->boolean = tb_true;
+        if (tb_json_reader_literal_parse(impl, "true")) event = TB_JSON_READER_EVENT_BOOLEAN;
+        break;
+    case 'f':
+        impl->boolean = tb_false;
+        if (tb_json_reader_literal_parse(impl, "false")) event = TB_JSON_READER_EVENT_BOOLEAN;
+        break;
+    case 'n':
+        if (tb_json_reader_literal_parse(impl, "null")) event = TB_JSON_READER_EVENT_NULL;
+        break;
+    default:
+        if (tb_json_reader_number_parse(impl)) event = TB_JSON_READER_EVENT_NUMBER;
+        break;
+    }
+
+    // the next state
+    if (event) impl->state = impl->level? TB_JSON_READER_STATE_NEXT : TB_JSON_READER_STATE_ROOT;
+    return event;
+}
+static tb_size_t tb_json_reader_next_parse(tb_json_reader_impl_t* impl)
+{
+    while (1)
+    {
+        // skip spaces and peek the next character
+        tb_long_t ch = tb_json_reader_space(impl);
+
+        // end?
+        if (ch < 0)
+        {
+            // it is not error if all root values have been read
+            if (impl->state != TB_JSON_READER_STATE_ROOT) impl->error = tb_true;
+            return TB_JSON_READER_EVENT_NONE;
+        }
+
+        // done
+        switch (impl->state)
+        {
+        case TB_JSON_READER_STATE_VALUE_OR_END:
+        case TB_JSON_READER_STATE_KEY_OR_END:
+            {
+                // the end of empty container?
+                if (ch == (impl->state == TB_JSON_READER_STATE_KEY_OR_END? '}' : ']'))
+                {
+                    impl->state = TB_JSON_READER_STATE_NEXT;
+                    continue;
+                }
+
+                // read the first item or key
+                impl->state = impl->state == TB_JSON_READER_STATE_KEY_OR_END? TB_JSON_READER_STATE_KEY : TB_JSON_READER_STATE_VALUE;
+                continue;
+            }
+        case TB_JSON_READER_STATE_KEY:
+            {
+                // read key
+                tb_check_break(ch == '\"' && tb_json_reader_string_parse(impl));
+
+                // skip ':'
+                tb_check_break(tb_json_reader_space(impl) == ':');
+                impl->p++;
+
+                // read value
+                impl->state = TB_JSON_READER_STATE_VALUE;
+                return TB_JSON_READER_EVENT_KEY;
+            }
+        case TB_JSON_READER_STATE_NEXT:
+            {
+                // the next item or key?
+                tb_byte_t type = impl->stack[impl->level - 1];
+                impl->p++;
+                if (ch == ',')
+                {
+                    impl->state = type == '{'? TB_JSON_READER_STATE_KEY : TB_JSON_READER_STATE_VALUE;
+                    continue;
+                }
+
+                // the end of container?
+                tb_check_break(ch == (type == '{'? '}' : ']'));
+                impl->level--;
+                impl->state = impl->level? TB_JSON_READER_STATE_NEXT : TB_JSON_READER_STATE_ROOT;
+                return type == '{'? TB_JSON_READER_EVENT_DICTIONARY_END : TB_JSON_READER_EVENT_ARRAY_END;
+            }
+        default:
+            {
+                // read value
+                tb_size_t event = tb_json_reader_value_parse(impl, ch);
+                tb_check_break(event);
+                return event;
+            }
+        }
+        break;
+    }
+
+    // failed
+    impl->error = tb_true;
+    return TB_JSON_READER_EVENT_NONE;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_json_reader_ref_t tb_json_reader_init()
+{
+    // init reader
+    tb_json_reader_impl_t* impl = tb_malloc0_type(tb_json_reader_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init data
+    tb_buffer_init(&impl->data);
+
+    // ok
+    return (tb_json_reader_ref_t)impl;
+}
+tb_void_t tb_json_reader_exit(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // clos it first
+    tb_json_reader_clos(reader);
+
+    // exit data
+    tb_buffer_exit(&impl->data);
+
+    // free it
+    tb_free(impl);
+}
+tb_bool_t tb_json_reader_open(tb_json_reader_ref_t reader, tb_stream_ref_t stream, tb_bool_t bowner)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && stream, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // check
+        tb_assert_and_check_break(!impl->stream);
+
+        // init the stream
+        impl->stream = stream;
+        impl->bowner = bowner;
+
+        // open the stream if be not opened
+        if (!tb_stream_is_opened(impl->stream) && !tb_stream_open(impl->stream)) break;
+
+        // init state
+        impl->event = TB_JSON_READER_EVENT_NONE;
+        impl->state = TB_JSON_READER_STATE_ROOT;
+        impl->level = 0;
+        impl->error = tb_false;
+        impl->size  = 0;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? close it
+    if (!ok) tb_json_reader_clos(reader);
+
+    // ok?
+    return ok;
+}
+tb_void_t tb_json_reader_clos(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // skip the read data, so the stream can be used to read the left data
+    if (impl->stream && impl->p > impl->b) tb_stream_skip(impl->stream, impl->p - impl->b);
+    impl->b = tb_null;
+    impl->p = tb_null;
+    impl->e = tb_null;
+
+    // exit the stream
+    if (impl->stream && impl->bowner) tb_stream_exit(impl->stream);
+    impl->stream = tb_null;
+    impl->bowner = tb_false;
+
+    // clear state
+    impl->event = TB_JSON_READER_EVENT_NONE;
+    impl->level = 0;
+    impl->size  = 0;
+    tb_buffer_clear(&impl->data);
+}
+tb_size_t tb_json_reader_next(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->stream, TB_JSON_READER_EVENT_NONE);
+
+    // failed?
+    tb_check_return_val(!impl->error, TB_JSON_READER_EVENT_NONE);
+
+    // read the next event
+    impl->event = tb_json_reader_next_parse(impl);
+
+    // trace
+    if (impl->error) tb_trace_d("invalid json data at level: %lu", impl->level);
+    return impl->event;
+}
+tb_bool_t tb_json_reader_skip(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // skip the key? read its value first
+    if (impl->event == TB_JSON_READER_EVENT_KEY && !tb_json_reader_next(reader)) return tb_false;
+
+    // skip the container
+    if (impl->event == TB_JSON_READER_EVENT_DICTIONARY_BEG || impl->event == TB_JSON_READER_EVENT_ARRAY_BEG)
+    {
+        tb_size_t level = impl->level;
+        while (impl->level >= level)
+        {
+            if (!tb_json_reader_next(reader)) return tb_false;
+        }
+    }
+    return !impl->error;
+}
+tb_bool_t tb_json_reader_error(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_true);
+
+    return impl->error;
+}
+tb_stream_ref_t tb_json_reader_stream(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    return impl->stream;
+}
+tb_size_t tb_json_reader_level(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, 0);
+
+    return impl->level;
+}
+tb_char_t const* tb_json_reader_string(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the string
+    tb_check_return_val(impl->event == TB_JSON_READER_EVENT_KEY || impl->event == TB_JSON_READER_EVENT_STRING || impl->event == TB_JSON_READER_EVENT_NUMBER, tb_null);
+    return (tb_char_t const*)tb_buffer_data(&impl->data);
+}
+tb_size_t tb_json_reader_size(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, 0);
+
+    return tb_json_reader_string(reader)? impl->size : 0;
+}
+tb_bool_t tb_json_reader_bool(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    return impl->event == TB_JSON_READER_EVENT_BOOLEAN? impl->boolean : tb_false;
+}
+tb_sint64_t tb_json_reader_sint64(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_NUMBER, 0);
+
+    // the value
+    tb_char_t const* cstr = (tb_char_t const*)tb_buffer_data(&impl->data);
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    if (impl->bfloat) return (tb_sint64_t)tb_s10tod(cstr);
+#endif
+    return tb_s10toi64(cstr);
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+tb_double_t tb_json_reader_double(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_NUMBER, 0);
+
+    // the value
+    return tb_s10tod((tb_char_t const*)tb_buffer_data(&impl->data));
+}
+#endif
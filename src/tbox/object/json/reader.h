@@ -0,0 +1,224 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        reader.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_JSON_READER_H
+#define TB_OBJECT_JSON_READER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the json reader event type
+typedef enum __tb_json_reader_event_e
+{
+    TB_JSON_READER_EVENT_NONE                   = 0     //!< end or error
+,   TB_JSON_READER_EVENT_DICTIONARY_BEG         = 1
+,   TB_JSON_READER_EVENT_DICTIONARY_END         = 2
+,   TB_JSON_READER_EVENT_ARRAY_BEG              = 3
+,   TB_JSON_READER_EVENT_ARRAY_END              = 4
+,   TB_JSON_READER_EVENT_KEY                    = 5
+,   TB_JSON_READER_EVENT_STRING                 = 6
+,   TB_JSON_READER_EVENT_NUMBER                 = 7
+,   TB_JSON_READER_EVENT_BOOLEAN                = 8
+,   TB_JSON_READER_EVENT_NULL                   = 9
+
+}tb_json_reader_event_e;
+
+/// the json reader ref type
+typedef __tb_typeref__(json_reader);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the json reader
+ *
+ * @return              the reader
+ */
+tb_json_reader_ref_t    tb_json_reader_init(tb_noarg_t);
+
+/*! exit the json reader
+ *
+ * @param reader        the json reader
+ */
+tb_void_t               tb_json_reader_exit(tb_json_reader_ref_t reader);
+
+/*! open the json reader
+ *
+ * @param reader        the json reader
+ * @param stream        the stream, will open it if be not opened
+ * @param bowner        the json reader is owner of the stream?
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_reader_open(tb_json_reader_ref_t reader, tb_stream_ref_t stream, tb_bool_t bowner);
+
+/*! clos the json reader
+ *
+ * @param reader        the json reader
+ */
+tb_void_t               tb_json_reader_clos(tb_json_reader_ref_t reader);
+
+/*! the next event of the json reader
+ *
+ * the data is read incrementally from the stream, and only the current key or value is buffered,
+ * so we can read the json data which is larger than memory.
+ *
+ * the multiple root values separated by spaces are supported, e.g. the newline-delimited json (ndjson).
+ *
+ * @param reader        the json reader
+ *
+ * @return              the event, return TB_JSON_READER_EVENT_NONE if end or error
+ *
+ * @code
+ *
+    // init reader
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_json_reader_open(reader, tb_stream_init_from_url(argv[1]), tb_true))
+        {
+            // walk
+            tb_size_t event = TB_JSON_READER_EVENT_NONE;
+            while ((event = tb_json_reader_next(reader)))
+            {
+                switch (event)
+                {
+                case TB_JSON_READER_EVENT_KEY:
+                    tb_trace_i("key: %s", tb_json_reader_string(reader));
+                    break;
+                case TB_JSON_READER_EVENT_STRING:
+                    tb_trace_i("string: %s", tb_json_reader_string(reader));
+                    break;
+                case TB_JSON_READER_EVENT_NUMBER:
+                    tb_trace_i("number: %lld", tb_json_reader_sint64(reader));
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // failed?
+            if (tb_json_reader_error(reader)) tb_trace_e("invalid json data!");
+        }
+
+        // exit reader
+        tb_json_reader_exit(reader);
+    }
+
+ * @endcode
+ */
+tb_size_t               tb_json_reader_next(tb_json_reader_ref_t reader);
+
+/*! skip the current value
+ *
+ * skip the whole dictionary or array if the current event is the begin of them,
+ * skip the value of the current key if the current event is key.
+ *
+ * @param reader        the json reader
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_reader_skip(tb_json_reader_ref_t reader);
+
+/*! has error?
+ *
+ * @param reader        the json reader
+ *
+ * @return              tb_true if the json data is invalid or the stream is failed
+ */
+tb_bool_t               tb_json_reader_error(tb_json_reader_ref_t reader);
+
+/*! the json stream
+ *
+ * @param reader        the json reader
+ *
+ * @return              the json stream
+ */
+tb_stream_ref_t         tb_json_reader_stream(tb_json_reader_ref_t reader);
+
+/*! the json level
+ *
+ * @param reader        the json reader
+ *
+ * @return              the nested level of dictionary and array
+ */
+tb_size_t               tb_json_reader_level(tb_json_reader_ref_t reader);
+
+/*! the current string
+ *
+ * @param reader        the json reader
+ *
+ * @return              the decoded key or string, or the number string, it is valid until the next event
+ */
+tb_char_t const*        tb_json_reader_string(tb_json_reader_ref_t reader);
+
+/*! the current string size
+ *
+ * @param reader        the json reader
+ *
+ * @return              the string size
+ */
+tb_size_t               tb_json_reader_size(tb_json_reader_ref_t reader);
+
+/*! the current boolean value
+ *
+ * @param reader        the json reader
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_reader_bool(tb_json_reader_ref_t reader);
+
+/*! the current integer value of the number
+ *
+ * @param reader        the json reader
+ *
+ * @return              the value, the float number will be truncated
+ */
+tb_sint64_t             tb_json_reader_sint64(tb_json_reader_ref_t reader);
+
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+/*! the current double value of the number
+ *
+ * @param reader        the json reader
+ *
+ * @return              the value
+ */
+tb_double_t             tb_json_reader_double(tb_json_reader_ref_t reader);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
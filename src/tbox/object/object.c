@@ -311,6 +311,10 @@ tb_object_ref_t tb_object_read_from_url(tb_char_t const* url)
     tb_stream_ref_t stream = tb_stream_init_from_url(url);
     tb_assert_and_check_return_val(stream, tb_null);
 
+    // map the file and read it directly if possible
+    if (tb_stream_type(stream) == TB_STREAM_TYPE_FILE)
+        tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_SET_MMAP, TB_STREAM_FILE_MMAP_SEQUENTIAL);
+
     // read object
     if (tb_stream_open(stream)) object = tb_object_read(stream);
 
@@ -341,6 +345,10 @@ tb_object_ref_t tb_object_read_from_data(tb_byte_t const* data, tb_size_t size)
     // ok?
     return object;
 }
+tb_void_t tb_object_json_fast_enable(tb_bool_t enable)
+{
+    tb_oc_json_reader_fast_enable(enable);
+}
 tb_long_t tb_object_writ(tb_object_ref_t object, tb_stream_ref_t stream, tb_size_t format)
 {
     // check
@@ -34,6 +34,7 @@
 #include "number.h"
 #include "boolean.h"
 #include "dictionary.h"
+#include "json/json.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -109,6 +110,16 @@ tb_object_ref_t     tb_object_read_from_url(tb_char_t const* url);
  */
 tb_object_ref_t     tb_object_read_from_data(tb_byte_t const* data, tb_size_t size);
 
+/*! enable or disable the fast json reader, it's enabled by default
+ *
+ * the fast reader gets the whole input at once (the file will be mapped for tb_object_read_from_url)
+ * and scans strings by simd, it will fall back to the stream reader if the input size is unknown
+ * or the json reader is hooked
+ *
+ * @param enable    enable it?
+ */
+tb_void_t           tb_object_json_fast_enable(tb_bool_t enable);
+
 /*! writ object
  *
  * @param object    the object
@@ -24,6 +24,158 @@
  */
 #include "prefix.h"
 #include "cpu.h"
+#if (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_COMPILER_IS_MSVC)
+#   include <intrin.h>
+#   define TB_CPU_CPUID_ENABLE
+#elif (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_COMPILER_IS_GCC)
+#   include <cpuid.h>
+#   define TB_CPU_CPUID_ENABLE
+#elif defined(TB_ARCH_ARM64) && (defined(TB_CONFIG_OS_LINUX) || (defined(TB_CONFIG_OS_ANDROID) && defined(__ANDROID_API__) && __ANDROID_API__ >= 18))
+#   include <sys/auxv.h>
+#   define TB_CPU_HWCAP_ENABLE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_CPU_CPUID_ENABLE
+static tb_void_t tb_cpu_cpuid(tb_uint32_t leaf, tb_uint32_t subleaf, tb_uint32_t info[4])
+{
+#   if defined(TB_COMPILER_IS_MSVC)
+    __cpuidex((int*)info, (int)leaf, (int)subleaf);
+#   else
+    __cpuid_count(leaf, subleaf, info[0], info[1], info[2], info[3]);
+#   endif
+}
+static tb_size_t tb_cpu_features_detect()
+{
+    // get the max leaf
+    tb_uint32_t info[4] = {0};
+    tb_cpu_cpuid(0, 0, info);
+    tb_uint32_t maxleaf = info[0];
+    tb_check_return_val(maxleaf >= 1, TB_CPU_FEATURE_NONE);
+
+    // get the features of the leaf 1
+    tb_size_t features = TB_CPU_FEATURE_NONE;
+    tb_cpu_cpuid(1, 0, info);
+    if (info[3] & (1 << 26)) features |= TB_CPU_FEATURE_SSE2;
+    if (info[2] & (1 << 9)) features |= TB_CPU_FEATURE_SSSE3;
+    if (info[2] & (1 << 19)) features |= TB_CPU_FEATURE_SSE41;
+    if (info[2] & (1 << 20)) features |= TB_CPU_FEATURE_SSE42;
+    if (info[2] & (1 << 1)) features |= TB_CPU_FEATURE_PCLMUL;
+
+    // the os has saved the xmm, ymm and zmm registers? (osxsave and avx)
+    tb_bool_t ymm = tb_false;
+    tb_bool_t zmm = tb_false;
+    if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)))
+    {
+#   if defined(TB_COMPILER_IS_MSVC)
+        tb_uint64_t xcr0 = _xgetbv(0);
+#   else
+        // xgetbv, old assemblers do not know this opcode
+        tb_uint32_t eax = 0;
+        tb_uint32_t edx = 0;
+        __tb_asm__ __tb_volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+        tb_uint64_t xcr0 = ((tb_uint64_t)edx << 32) | eax;
+#   endif
+        ymm = (xcr0 & 0x06) == 0x06;
+        zmm = (xcr0 & 0xe6) == 0xe6;
+    }
+
+    // get the extended features of the leaf 7
+    if (maxleaf >= 7)
+    {
+        tb_cpu_cpuid(7, 0, info);
+        if (ymm && (info[1] & (1 << 5))) features |= TB_CPU_FEATURE_AVX2;
+        if (info[1] & (1 << 9)) features |= TB_CPU_FEATURE_ERMS;
+        if (zmm && (info[1] & (1 << 16)) && (info[1] & (1 << 30))) features |= TB_CPU_FEATURE_AVX512;
+        if (info[1] & (1 << 29)) features |= TB_CPU_FEATURE_SHA;
+        if (info[3] & (1 << 4)) features |= TB_CPU_FEATURE_FSRM;
+    }
+    return features;
+}
+static tb_size_t tb_cpu_cache_size_detect()
+{
+    // get the leaf of the deterministic cache parameters, intel: 4, amd: 0x8000001d
+    tb_uint32_t info[4] = {0};
+    tb_uint32_t leaf = 4;
+    tb_cpu_cpuid(0, 0, info);
+    if (info[1] == 0x68747541) // "Auth"enticAMD
+    {
+        tb_cpu_cpuid(0x80000000, 0, info);
+        tb_check_return_val(info[0] >= 0x8000001d, 0);
+        leaf = 0x8000001d;
+    }
+    else tb_check_return_val(info[0] >= 4, 0);
+
+    // get the size of the last level data or unified cache
+    tb_size_t size = 0;
+    tb_size_t level = 0;
+    tb_uint32_t i = 0;
+    for (i = 0; i < 16; i++)
+    {
+        // no more caches?
+        tb_cpu_cpuid(leaf, i, info);
+        tb_uint32_t type = info[0] & 0x1f;
+        tb_check_break(type);
+
+        // the instruction cache? skip it
+        tb_check_continue(type != 2);
+
+        // size = ways * partitions * line size * sets
+        tb_size_t l = (info[0] >> 5) & 0x7;
+        if (l >= level)
+        {
+            level = l;
+            size = (tb_size_t)((info[1] >> 22) + 1) * (((info[1] >> 12) & 0x3ff) + 1) * ((info[1] & 0xfff) + 1) * ((tb_size_t)info[2] + 1);
+        }
+    }
+    return size;
+}
+#elif defined(TB_ARCH_ARM64)
+static tb_size_t tb_cpu_features_detect()
+{
+    // neon is always supported on arm64
+    tb_size_t features = TB_CPU_FEATURE_NEON;
+
+    // the features enabled by the compiler
+#   ifdef __ARM_FEATURE_CRC32
+    features |= TB_CPU_FEATURE_CRC32;
+#   endif
+#   if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+    features |= TB_CPU_FEATURE_PMULL;
+#   endif
+#   if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2)
+    features |= TB_CPU_FEATURE_SHA1 | TB_CPU_FEATURE_SHA2;
+#   endif
+
+    // the features of the running cpu
+#   if defined(TB_CPU_HWCAP_ENABLE)
+    tb_size_t hwcap = (tb_size_t)getauxval(AT_HWCAP);
+    if (hwcap & (1 << 4)) features |= TB_CPU_FEATURE_PMULL;
+    if (hwcap & (1 << 5)) features |= TB_CPU_FEATURE_SHA1;
+    if (hwcap & (1 << 6)) features |= TB_CPU_FEATURE_SHA2;
+    if (hwcap & (1 << 7)) features |= TB_CPU_FEATURE_CRC32;
+#   elif defined(TB_CONFIG_OS_WINDOWS) && defined(TB_COMPILER_IS_MSVC)
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE)) features |= TB_CPU_FEATURE_CRC32;
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE))
+        features |= TB_CPU_FEATURE_PMULL | TB_CPU_FEATURE_SHA1 | TB_CPU_FEATURE_SHA2;
+#   elif defined(TB_CONFIG_OS_MACOSX) || defined(TB_CONFIG_OS_IOS)
+    // all apple arm64 cpus have the crypto extensions
+    features |= TB_CPU_FEATURE_PMULL | TB_CPU_FEATURE_SHA1 | TB_CPU_FEATURE_SHA2;
+#   endif
+    return features;
+}
+#else
+static tb_size_t tb_cpu_features_detect()
+{
+#   ifdef TB_ARCH_ARM_NEON
+    return TB_CPU_FEATURE_NEON;
+#   else
+    return TB_CPU_FEATURE_NONE;
+#   endif
+}
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -38,4 +190,20 @@ tb_size_t tb_cpu_count()
     return 1;
 }
 #endif
-
+tb_size_t tb_cpu_features()
+{
+    // we will pre-initialize it in tb_platform_init()
+    static tb_size_t features = -1;
+    if (features == -1) features = tb_cpu_features_detect();
+    return features;
+}
+tb_size_t tb_cpu_cache_size()
+{
+#ifdef TB_CPU_CPUID_ENABLE
+    static tb_size_t size = -1;
+    if (size == -1) size = tb_cpu_cache_size_detect();
+    return size;
+#else
+    return 0;
+#endif
+}
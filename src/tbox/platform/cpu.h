@@ -73,6 +73,32 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the cpu feature enum
+typedef enum __tb_cpu_feature_e
+{
+    TB_CPU_FEATURE_NONE             = 0
+,   TB_CPU_FEATURE_SSE2             = 1 << 0    //!< x86: sse2
+,   TB_CPU_FEATURE_SSSE3            = 1 << 1    //!< x86: ssse3
+,   TB_CPU_FEATURE_SSE41            = 1 << 2    //!< x86: sse4.1
+,   TB_CPU_FEATURE_SSE42            = 1 << 3    //!< x86: sse4.2, with the crc32c instruction
+,   TB_CPU_FEATURE_PCLMUL           = 1 << 4    //!< x86: carry-less multiplication
+,   TB_CPU_FEATURE_AVX2             = 1 << 5    //!< x86: avx2, and the os saves the ymm registers
+,   TB_CPU_FEATURE_SHA              = 1 << 6    //!< x86: sha extensions
+,   TB_CPU_FEATURE_ERMS             = 1 << 7    //!< x86: enhanced rep movsb/stosb
+,   TB_CPU_FEATURE_FSRM             = 1 << 8    //!< x86: fast short rep movsb
+,   TB_CPU_FEATURE_AVX512           = 1 << 9    //!< x86: avx512f and avx512bw, and the os saves the zmm registers
+,   TB_CPU_FEATURE_NEON             = 1 << 16   //!< arm: neon
+,   TB_CPU_FEATURE_CRC32            = 1 << 17   //!< arm: crc32 and crc32c instructions
+,   TB_CPU_FEATURE_PMULL            = 1 << 18   //!< arm: polynomial multiplication (64x64)
+,   TB_CPU_FEATURE_SHA1             = 1 << 19   //!< arm: sha1 instructions
+,   TB_CPU_FEATURE_SHA2             = 1 << 20   //!< arm: sha256 instructions
+
+}tb_cpu_feature_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -83,6 +109,29 @@ __tb_extern_c_enter__
  */
 tb_size_t               tb_cpu_count(tb_noarg_t);
 
+/*! the cpu features
+ *
+ * the features are detected at runtime (cpuid on x86, hwcap on arm) and be cached
+ *
+ * @code
+    if (tb_cpu_features() & TB_CPU_FEATURE_PCLMUL)
+    {
+        // ...
+    }
+ * @endcode
+ *
+ * @return              the features, e.g. TB_CPU_FEATURE_SSE42 | TB_CPU_FEATURE_PCLMUL
+ */
+tb_size_t               tb_cpu_features(tb_noarg_t);
+
+/*! the size of the last level cache
+ *
+ * it is detected by cpuid on x86 and be cached
+ *
+ * @return              the cache size in bytes, returns 0 if unknown
+ */
+tb_size_t               tb_cpu_cache_size(tb_noarg_t);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
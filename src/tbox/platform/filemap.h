@@ -0,0 +1,83 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        filemap.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_FILEMAP_H
+#define TB_PLATFORM_FILEMAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "file.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the file map advice enum
+typedef enum __tb_filemap_advice_e
+{
+    TB_FILEMAP_ADVICE_NORMAL        = 0     //!< no special treatment
+,   TB_FILEMAP_ADVICE_SEQUENTIAL    = 1     //!< expect sequential page references, read ahead aggressively
+,   TB_FILEMAP_ADVICE_RANDOM        = 2     //!< expect random page references, disable read ahead
+
+}tb_filemap_advice_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the offset alignment of the file map
+ *
+ * @return          the alignment, e.g. the page size or the allocation granularity on windows
+ */
+tb_size_t           tb_filemap_align(tb_noarg_t);
+
+/*! map the file data as read-only
+ *
+ * @param file      the file
+ * @param offset    the file offset, it must be aligned by tb_filemap_align()
+ * @param size      the map size
+ * @param advice    the advice
+ *
+ * @return          the mapped data address, return tb_null if failed or not supported
+ */
+tb_byte_t const*    tb_filemap_init(tb_file_ref_t file, tb_hize_t offset, tb_size_t size, tb_size_t advice);
+
+/*! unmap the mapped file data
+ *
+ * @param data      the mapped data address
+ * @param size      the map size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_filemap_exit(tb_byte_t const* data, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
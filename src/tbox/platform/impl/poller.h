@@ -127,6 +127,24 @@ typedef struct __tb_poller_t
      */
     tb_bool_t                (*modify)(struct __tb_poller_t* poller, tb_poller_object_ref_t object, tb_size_t events, tb_cpointer_t priv);
 
+    /* post an io to the completion-based poller, it's optional
+     *
+     * @param poller         the poller
+     * @param io             the io
+     *
+     * @return               tb_true or tb_false
+     */
+    tb_bool_t                (*post)(struct __tb_poller_t* poller, tb_poller_io_ref_t io);
+
+    /* cancel the posted io, it's optional
+     *
+     * @param poller         the poller
+     * @param io             the io
+     *
+     * @return               tb_true or tb_false
+     */
+    tb_bool_t                (*cancel)(struct __tb_poller_t* poller, tb_poller_io_ref_t io);
+
     /* attach the poller to the current thread (only for windows/iocp now)
      *
      * @param poller         the poller
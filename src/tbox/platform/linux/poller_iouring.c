@@ -0,0 +1,1070 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        poller_iouring.c
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../atomic32.h"
+#include "../posix/sockaddr.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the submission queue entries count
+#ifdef __tb_small__
+#   define TB_POLLER_IOURING_ENTRIES            (64)
+#else
+#   define TB_POLLER_IOURING_ENTRIES            (256)
+#endif
+
+// the items grow
+#ifdef __tb_small__
+#   define TB_POLLER_IOURING_ITEMS_GROW         (64)
+#else
+#   define TB_POLLER_IOURING_ITEMS_GROW         (256)
+#endif
+
+// the user data of the ignored completion events, e.g. poll remove
+#define TB_POLLER_IOURING_USERDATA_IGNORE       ((tb_uint64_t)-1)
+
+// the user data of the probe completion event
+#define TB_POLLER_IOURING_USERDATA_PROBE        ((tb_uint64_t)-2)
+
+/* the user data flag of the poll requests
+ *
+ * the user data of the completion-based io is the io pointer, the user space address always has the cleared high bit
+ */
+#define TB_POLLER_IOURING_USERDATA_POLL         ((tb_uint64_t)1 << 63)
+
+// the generation mask of the poll requests
+#define TB_POLLER_IOURING_GEN_MASK              (0x7fffffff)
+
+// make the user data from the fd and generation
+#define tb_poller_iouring_userdata(fd, gen)     (TB_POLLER_IOURING_USERDATA_POLL | ((tb_uint64_t)((gen) & TB_POLLER_IOURING_GEN_MASK) << 32) | (tb_uint32_t)(fd))
+
+// the required features: single mmap, no dropped completions and timeout argument for io_uring_enter
+#define TB_POLLER_IOURING_FEATURES              (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)
+
+// the item flags
+#define TB_POLLER_IOURING_ITEM_INSERTED         (1)
+#define TB_POLLER_IOURING_ITEM_ARMED            (2)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring private data of the posted io, it's stored in io->reserved
+typedef struct __tb_poller_iouring_io_t
+{
+    // the kernel socket address for accept and connect, it must be kept until the io is completed
+    struct sockaddr_storage     addr;
+
+    // the kernel socket address length
+    socklen_t                   addrlen;
+
+    // has been canceled?
+    tb_uint32_t                 canceled;
+
+    // the linked timeout
+    struct __kernel_timespec    ts;
+
+}tb_poller_iouring_io_t;
+
+// the io_uring poller item type
+typedef struct __tb_poller_iouring_item_t
+{
+    // the generation, the stale completion events of the previous poll requests will be ignored
+    tb_uint32_t             gen;
+
+    // the poller events
+    tb_uint16_t             events;
+
+    // the flags
+    tb_uint16_t             flags;
+
+    // the ready events of the current completion events
+    tb_uint16_t             revents;
+
+}tb_poller_iouring_item_t;
+
+/* the io_uring poller type
+ *
+ * we submit the requests in batches and wait the completion events in one io_uring_enter() call,
+ *
+ * - insert/modify: only prepare the poll request (sqe), it will be submitted in the next wait()
+ * - post: prepare the recv/send/accept/connect request with the linked timeout, it will be submitted in the next wait()
+ *   and the io will be completed by the kernel directly, we need not wait the readiness events and call recv/send again
+ * - wait: submit all prepared requests and wait the completion events (cqe)
+ * - clear (edge trigger): multishot poll request, it will be re-armed if it's terminated by the kernel
+ * - level trigger: oneshot poll request, it will be re-armed after the completion event is reaped
+ * - the events of all ready objects are re-checked by one poll() call, so we will not report the stale events like epoll
+ *
+ * the readiness events are slower than epoll because of the extra poll() call and re-arming the poll requests,
+ * so this poller need be selected explicitly, e.g. TB_CO_SCHEDULER_FLAG_IOURING, and it's mainly used for the completion-based io.
+ */
+typedef struct __tb_poller_iouring_t
+{
+    // the poller base
+    tb_poller_t                 base;
+
+    // the pair sockets for spak, kill ..
+    tb_socket_ref_t             pair[2];
+
+    // the ring fd
+    tb_int_t                    ringfd;
+
+    // the ring data (single mmap)
+    tb_pointer_t                ring;
+
+    // the ring size
+    tb_size_t                   ring_size;
+
+    // the submission queue entries
+    struct io_uring_sqe*        sqes;
+
+    // the submission queue entries size
+    tb_size_t                   sqes_size;
+
+    // the submission queue head, tail and index array
+    tb_uint32_t*                sq_head;
+    tb_uint32_t*                sq_tail;
+    tb_uint32_t*                sq_array;
+
+    // the submission queue mask and entries count
+    tb_uint32_t                 sq_mask;
+    tb_uint32_t                 sq_entries;
+
+    // the local submission queue tail of the prepared requests
+    tb_uint32_t                 sq_tail_local;
+
+    // the completion queue head and tail
+    tb_uint32_t*                cq_head;
+    tb_uint32_t*                cq_tail;
+
+    // the completion queue mask
+    tb_uint32_t                 cq_mask;
+
+    // the completion queue entries
+    struct io_uring_cqe*        cqes;
+
+    // the items (fd => item)
+    tb_poller_iouring_item_t*   items;
+
+    // the items maximum count
+    tb_size_t                   items_maxn;
+
+    // the ready objects (fd) of the current completion events
+    tb_long_t*                  ready;
+
+    // the poll fds for checking the ready objects
+    struct pollfd*              pfds;
+
+    // the ready objects maximum count
+    tb_size_t                   ready_maxn;
+
+    // the pending completion-based io count
+    tb_size_t                   io_pending;
+
+    // the socket data
+    tb_pollerdata_t             pollerdata;
+
+}tb_poller_iouring_t, *tb_poller_iouring_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_int_t tb_poller_iouring_setup(tb_uint32_t entries, struct io_uring_params* params)
+{
+    return (tb_int_t)syscall(__NR_io_uring_setup, entries, params);
+}
+static __tb_inline__ tb_int_t tb_poller_iouring_enter(tb_int_t ringfd, tb_uint32_t to_submit, tb_uint32_t min_complete, tb_uint32_t flags, tb_pointer_t arg, tb_size_t argsz)
+{
+    return (tb_int_t)syscall(__NR_io_uring_enter, ringfd, to_submit, min_complete, flags, arg, argsz);
+}
+static tb_uint32_t tb_poller_iouring_mask(tb_size_t events)
+{
+    tb_uint32_t mask = 0;
+    if (events & TB_POLLER_EVENT_RECV) mask |= POLLIN;
+    if (events & TB_POLLER_EVENT_SEND) mask |= POLLOUT;
+#ifdef POLLRDHUP
+    if (events & TB_POLLER_EVENT_CLEAR) mask |= POLLRDHUP;
+#endif
+
+#ifdef TB_WORDS_BIGENDIAN
+    // the poll32_events is stored as the swapped half-words on the big-endian
+    mask = (mask << 16) | (mask >> 16);
+#endif
+    return mask;
+}
+static tb_poller_iouring_item_t* tb_poller_iouring_item(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_bool_t grow)
+{
+    // check
+    tb_assert(poller && fd >= 0);
+
+    // exists?
+    if (fd < poller->items_maxn) return &poller->items[fd];
+    tb_check_return_val(grow, tb_null);
+
+    // grow items
+    tb_size_t maxn = fd + 1 + TB_POLLER_IOURING_ITEMS_GROW;
+    poller->items = poller->items? (tb_poller_iouring_item_t*)tb_ralloc(poller->items, maxn * sizeof(tb_poller_iouring_item_t))
+                                 : tb_nalloc_type(maxn, tb_poller_iouring_item_t);
+    tb_assert_and_check_return_val(poller->items, tb_null);
+
+    // init the growed items
+    tb_memset(poller->items + poller->items_maxn, 0, (maxn - poller->items_maxn) * sizeof(tb_poller_iouring_item_t));
+    poller->items_maxn = maxn;
+    return &poller->items[fd];
+}
+static tb_bool_t tb_poller_iouring_submit(tb_poller_iouring_ref_t poller, tb_bool_t wait, tb_long_t timeout)
+{
+    // check
+    tb_assert(poller && poller->ringfd >= 0);
+
+    // the pending requests count
+    tb_uint32_t to_submit = poller->sq_tail_local - tb_atomic32_get((tb_atomic32_t*)poller->sq_head);
+
+    // init the wait arguments
+    tb_uint32_t                     flags = 0;
+    struct __kernel_timespec        ts;
+    struct io_uring_getevents_arg   arg;
+    tb_pointer_t                    argp = tb_null;
+    tb_size_t                       argsz = 0;
+    if (wait)
+    {
+        flags |= IORING_ENTER_GETEVENTS;
+        tb_memset(&arg, 0, sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8;
+        if (timeout >= 0)
+        {
+            ts.tv_sec   = timeout / 1000;
+            ts.tv_nsec  = (timeout % 1000) * 1000000;
+            arg.ts      = (tb_uint64_t)(tb_size_t)&ts;
+        }
+        flags |= IORING_ENTER_EXT_ARG;
+        argp = &arg;
+        argsz = sizeof(arg);
+    }
+
+    // no requests and need not wait?
+    tb_check_return_val(to_submit || wait, tb_true);
+
+    // submit requests and wait the completion events
+    if (tb_poller_iouring_enter(poller->ringfd, to_submit, wait? 1 : 0, flags, argp, argsz) < 0)
+    {
+        // timeout, interrupted or the completion queue is busy? we will reap the completion events directly
+        if (errno == ETIME || errno == EINTR || errno == EBUSY || errno == EAGAIN)
+            return tb_true;
+
+        // trace
+        tb_trace_e("enter failed, errno: %d", errno);
+        return tb_false;
+    }
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_reserve(tb_poller_iouring_ref_t poller, tb_uint32_t count)
+{
+    // check
+    tb_assert(poller && count <= poller->sq_entries);
+
+    /* the submission queue has no enough free entries? submit all pending requests first
+     *
+     * we need reserve the linked requests at once, the link chain will be broken if they are submitted in the different io_uring_enter() calls
+     */
+    if (poller->sq_tail_local - tb_atomic32_get((tb_atomic32_t*)poller->sq_head) + count > poller->sq_entries)
+    {
+        if (!tb_poller_iouring_submit(poller, tb_false, 0)) return tb_false;
+        tb_assert_and_check_return_val(poller->sq_tail_local - tb_atomic32_get((tb_atomic32_t*)poller->sq_head) + count <= poller->sq_entries, tb_false);
+    }
+    return tb_true;
+}
+static struct io_uring_sqe* tb_poller_iouring_sqe(tb_poller_iouring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->sqes);
+
+    // the submission queue is full? submit all pending requests first
+    if (!tb_poller_iouring_reserve(poller, 1)) return tb_null;
+
+    // get a free request
+    tb_uint32_t             index = poller->sq_tail_local & poller->sq_mask;
+    struct io_uring_sqe*    sqe = &poller->sqes[index];
+
+    // clear it, it's mapped from the kernel and not allocated from the memory pool, so we cannot use the checked tb_memset
+    tb_memset_(sqe, 0, sizeof(struct io_uring_sqe));
+
+    // publish it, it will be submitted in the next io_uring_enter()
+    poller->sq_array[index] = index;
+    poller->sq_tail_local++;
+    tb_atomic32_set((tb_atomic32_t*)poller->sq_tail, poller->sq_tail_local);
+    return sqe;
+}
+static tb_bool_t tb_poller_iouring_arm(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_poller_iouring_item_t* item)
+{
+    // check
+    tb_assert(poller && item);
+
+    // make a poll request
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // init it, we use the multishot poll request for the edge trigger
+    sqe->opcode         = IORING_OP_POLL_ADD;
+    sqe->fd             = (tb_int_t)fd;
+    sqe->poll32_events  = tb_poller_iouring_mask(item->events);
+    sqe->user_data      = tb_poller_iouring_userdata(fd, item->gen);
+    if (item->events & TB_POLLER_EVENT_CLEAR) sqe->len = IORING_POLL_ADD_MULTI;
+
+    // mark it as armed
+    item->flags |= TB_POLLER_IOURING_ITEM_ARMED;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_disarm(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_poller_iouring_item_t* item)
+{
+    // check
+    tb_assert(poller && item);
+
+    // not armed?
+    tb_check_return_val(item->flags & TB_POLLER_IOURING_ITEM_ARMED, tb_true);
+
+    // make a poll remove request
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // remove the previous poll request
+    sqe->opcode     = IORING_OP_POLL_REMOVE;
+    sqe->fd         = -1;
+    sqe->addr       = tb_poller_iouring_userdata(fd, item->gen);
+    sqe->user_data  = TB_POLLER_IOURING_USERDATA_IGNORE;
+
+    // mark it as disarmed
+    item->flags &= ~TB_POLLER_IOURING_ITEM_ARMED;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_probe(tb_poller_iouring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->pair[0] && poller->pair[1]);
+
+    /* we need the multishot poll request for the edge trigger (linux 5.13+)
+     * but it cannot be detected by the features, so we attempt to poll the spak socket once
+     */
+    if (1 != tb_socket_send(poller->pair[0], (tb_byte_t const*)"p", 1)) return tb_false;
+
+    // make a multishot poll request
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+    sqe->opcode         = IORING_OP_POLL_ADD;
+    sqe->fd             = (tb_int_t)tb_ptr2fd(poller->pair[1]);
+    sqe->poll32_events  = tb_poller_iouring_mask(TB_POLLER_EVENT_RECV);
+    sqe->user_data      = TB_POLLER_IOURING_USERDATA_PROBE;
+    sqe->len            = IORING_POLL_ADD_MULTI;
+
+    // wait the probe result
+    tb_long_t result = -EINVAL;
+    tb_size_t retry = 8;
+    while (retry-- && result == -EINVAL)
+    {
+        // submit and wait it
+        if (!tb_poller_iouring_submit(poller, tb_true, 1000)) return tb_false;
+
+        // reap the completion events
+        tb_uint32_t head = *poller->cq_head;
+        tb_uint32_t tail = tb_atomic32_get((tb_atomic32_t*)poller->cq_tail);
+        for (; head != tail; head++)
+        {
+            struct io_uring_cqe* cqe = &poller->cqes[head & poller->cq_mask];
+            if (cqe->user_data == TB_POLLER_IOURING_USERDATA_PROBE)
+            {
+                result = cqe->res;
+                retry = 0;
+            }
+        }
+        tb_atomic32_set((tb_atomic32_t*)poller->cq_head, head);
+    }
+
+    // remove the probe request
+    if (result >= 0)
+    {
+        sqe = tb_poller_iouring_sqe(poller);
+        tb_assert_and_check_return_val(sqe, tb_false);
+        sqe->opcode     = IORING_OP_POLL_REMOVE;
+        sqe->fd         = -1;
+        sqe->addr       = TB_POLLER_IOURING_USERDATA_PROBE;
+        sqe->user_data  = TB_POLLER_IOURING_USERDATA_IGNORE;
+        if (!tb_poller_iouring_submit(poller, tb_false, 0)) return tb_false;
+    }
+
+    // read the spak
+    tb_char_t spak = '\0';
+    if (1 != tb_socket_recv(poller->pair[1], (tb_byte_t*)&spak, 1)) return tb_false;
+
+    // trace
+    tb_trace_d("probe multishot poll: %s", result >= 0? "ok" : "no");
+
+    // ok?
+    return result >= 0;
+}
+static tb_void_t tb_poller_iouring_complete(tb_poller_iouring_ref_t poller, tb_poller_io_ref_t io, tb_long_t res)
+{
+    // check
+    tb_assert(poller && io && io->func);
+
+    // done
+    tb_poller_iouring_io_t* iouring_io = (tb_poller_iouring_io_t*)io->reserved;
+    if (res >= 0)
+    {
+        io->state   = TB_STATE_OK;
+        io->result  = res;
+        switch (io->code)
+        {
+        case TB_POLLER_IOCODE_ACPT:
+            {
+                // disable the nagle's algorithm like tb_socket_accept()
+                tb_int_t enable = 1;
+                setsockopt((tb_int_t)res, IPPROTO_TCP, TCP_NODELAY, (tb_char_t*)&enable, sizeof(enable));
+
+                // save the client socket and address
+                io->client = tb_fd2sock(res);
+                io->result = 1;
+                tb_sockaddr_save(&io->addr, &iouring_io->addr);
+            }
+            break;
+        case TB_POLLER_IOCODE_CONN:
+            io->result = 1;
+            break;
+        default:
+            break;
+        }
+    }
+    // canceled by the linked timeout or tb_poller_cancel()?
+    else if (res == -ECANCELED)
+    {
+        io->state   = iouring_io->canceled? TB_STATE_KILLED : TB_STATE_TIMEOUT;
+        io->result  = 0;
+    }
+    else
+    {
+        // trace
+        tb_trace_d("io(%p): code: %u, sock: %p failed, errno: %ld", io, io->code, io->sock, -res);
+
+        // failed
+        io->state   = TB_STATE_FAILED;
+        io->result  = -1;
+    }
+
+    // done the io func, the io may be freed or reposted in it
+    io->func((tb_poller_ref_t)poller, io);
+}
+static tb_bool_t tb_poller_iouring_post(tb_poller_t* self, tb_poller_io_ref_t io)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && io && io->sock && io->func, tb_false);
+    tb_assert_static(sizeof(tb_poller_iouring_io_t) <= sizeof(io->reserved));
+
+    // the user data must not conflict with the poll requests
+    tb_assert_and_check_return_val(!((tb_uint64_t)(tb_size_t)io & TB_POLLER_IOURING_USERDATA_POLL), tb_false);
+
+    // reserve the io request and the linked timeout request
+    if (!tb_poller_iouring_reserve(poller, io->timeout >= 0? 2 : 1)) return tb_false;
+
+    // init the io state
+    tb_poller_iouring_io_t* iouring_io = (tb_poller_iouring_io_t*)io->reserved;
+    iouring_io->canceled = 0;
+    io->state   = TB_STATE_PENDING;
+    io->result  = 0;
+    io->client  = tb_null;
+
+    // make the io request
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+    sqe->fd         = (tb_int_t)tb_sock2fd(io->sock);
+    sqe->user_data  = (tb_uint64_t)(tb_size_t)io;
+    switch (io->code)
+    {
+    case TB_POLLER_IOCODE_RECV:
+        sqe->opcode     = IORING_OP_RECV;
+        sqe->addr       = (tb_uint64_t)(tb_size_t)io->data;
+        sqe->len        = (tb_uint32_t)io->size;
+        sqe->msg_flags  = (io->flags & TB_POLLER_IOFLAG_WAITALL)? MSG_WAITALL : 0;
+        break;
+    case TB_POLLER_IOCODE_SEND:
+        sqe->opcode     = IORING_OP_SEND;
+        sqe->addr       = (tb_uint64_t)(tb_size_t)io->data;
+        sqe->len        = (tb_uint32_t)io->size;
+        sqe->msg_flags  = MSG_NOSIGNAL | ((io->flags & TB_POLLER_IOFLAG_WAITALL)? MSG_WAITALL : 0);
+        break;
+    case TB_POLLER_IOCODE_ACPT:
+        iouring_io->addrlen = sizeof(iouring_io->addr);
+        sqe->opcode         = IORING_OP_ACCEPT;
+        sqe->addr           = (tb_uint64_t)(tb_size_t)&iouring_io->addr;
+        sqe->addr2          = (tb_uint64_t)(tb_size_t)&iouring_io->addrlen;
+        sqe->accept_flags   = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        break;
+    case TB_POLLER_IOCODE_CONN:
+        iouring_io->addrlen = (socklen_t)tb_sockaddr_load(&iouring_io->addr, &io->addr);
+        sqe->opcode         = IORING_OP_CONNECT;
+        sqe->addr           = (tb_uint64_t)(tb_size_t)&iouring_io->addr;
+        sqe->off            = iouring_io->addrlen;
+        break;
+    default:
+        // trace
+        tb_trace_e("post io(%p) failed, unknown code: %u", io, io->code);
+
+        // we cannot withdraw the published request, so make it as a nop request for the ignored completion event
+        sqe->opcode     = IORING_OP_NOP;
+        sqe->fd         = -1;
+        sqe->user_data  = TB_POLLER_IOURING_USERDATA_IGNORE;
+        return tb_false;
+    }
+
+#ifdef IORING_RECVSEND_POLL_FIRST
+    // the socket is not ready? we wait the readiness first instead of attempting to recv/send it in the kernel (linux 5.19+)
+    if ((io->flags & TB_POLLER_IOFLAG_NOTREADY) && (io->code == TB_POLLER_IOCODE_RECV || io->code == TB_POLLER_IOCODE_SEND))
+        sqe->ioprio |= IORING_RECVSEND_POLL_FIRST;
+#endif
+
+    // link a timeout request, the io request will be canceled with -ECANCELED if it's timeout
+    if (io->timeout >= 0)
+    {
+        sqe->flags |= IOSQE_IO_LINK;
+        iouring_io->ts.tv_sec   = io->timeout / 1000;
+        iouring_io->ts.tv_nsec  = (io->timeout % 1000) * 1000000;
+
+        sqe = tb_poller_iouring_sqe(poller);
+        tb_assert_and_check_return_val(sqe, tb_false);
+        sqe->opcode     = IORING_OP_LINK_TIMEOUT;
+        sqe->fd         = -1;
+        sqe->addr       = (tb_uint64_t)(tb_size_t)&iouring_io->ts;
+        sqe->len        = 1;
+        sqe->user_data  = TB_POLLER_IOURING_USERDATA_IGNORE;
+    }
+
+    // ok, it will be submitted in the next wait()
+    poller->io_pending++;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_cancel(tb_poller_t* self, tb_poller_io_ref_t io)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && io, tb_false);
+
+    // has been completed?
+    tb_check_return_val(io->state == TB_STATE_PENDING, tb_false);
+
+    // mark it as canceled, the io will be completed with TB_STATE_KILLED
+    tb_poller_iouring_io_t* iouring_io = (tb_poller_iouring_io_t*)io->reserved;
+    iouring_io->canceled = 1;
+
+    // make a cancel request
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+    sqe->opcode     = IORING_OP_ASYNC_CANCEL;
+    sqe->fd         = -1;
+    sqe->addr       = (tb_uint64_t)(tb_size_t)io;
+    sqe->user_data  = TB_POLLER_IOURING_USERDATA_IGNORE;
+
+    /* submit it now, because the pending io request holds the file reference,
+     * the socket may be closed after canceling and the connection will not be closed if it's still pending
+     */
+    return tb_poller_iouring_submit(poller, tb_false, 0);
+}
+static tb_void_t tb_poller_iouring_cancel_all(tb_poller_iouring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->ringfd >= 0);
+
+#ifdef IORING_ASYNC_CANCEL_ANY
+    // cancel all pending requests (linux 5.19+)
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return(sqe);
+    sqe->opcode         = IORING_OP_ASYNC_CANCEL;
+    sqe->fd             = -1;
+    sqe->cancel_flags   = IORING_ASYNC_CANCEL_ANY;
+    sqe->user_data      = TB_POLLER_IOURING_USERDATA_IGNORE;
+
+    // wait and reap the canceled io, we need not call the io func because the poller is exiting
+    tb_size_t retry = 10;
+    while (poller->io_pending && retry--)
+    {
+        if (!tb_poller_iouring_submit(poller, tb_true, 100)) break;
+
+        tb_uint32_t head = *poller->cq_head;
+        tb_uint32_t tail = tb_atomic32_get((tb_atomic32_t*)poller->cq_tail);
+        for (; head != tail; head++)
+        {
+            tb_uint64_t userdata = poller->cqes[head & poller->cq_mask].user_data;
+            if (!(userdata & TB_POLLER_IOURING_USERDATA_POLL) && poller->io_pending)
+                poller->io_pending--;
+        }
+        tb_atomic32_set((tb_atomic32_t*)poller->cq_head, head);
+    }
+#endif
+
+    // trace
+    if (poller->io_pending) tb_trace_e("%lu pending io are not completed before exiting!", poller->io_pending);
+}
+static tb_void_t tb_poller_iouring_exit(tb_poller_t* self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    /* cancel and reap all pending io first,
+     * because the kernel will cancel them asynchronously after closing the ring, and the io and its buffers may be freed after exiting
+     */
+    if (poller->ringfd >= 0 && poller->sqes && poller->io_pending) tb_poller_iouring_cancel_all(poller);
+
+    // exit pair sockets
+    if (poller->pair[0]) tb_socket_exit(poller->pair[0]);
+    if (poller->pair[1]) tb_socket_exit(poller->pair[1]);
+    poller->pair[0] = tb_null;
+    poller->pair[1] = tb_null;
+
+    // exit the ring
+    if (poller->sqes) munmap(poller->sqes, poller->sqes_size);
+    if (poller->ring) munmap(poller->ring, poller->ring_size);
+    poller->sqes = tb_null;
+    poller->ring = tb_null;
+
+    // close the ring fd
+    if (poller->ringfd >= 0) close(poller->ringfd);
+    poller->ringfd = -1;
+
+    // exit items
+    if (poller->items) tb_free(poller->items);
+    poller->items       = tb_null;
+    poller->items_maxn  = 0;
+
+    // exit the ready objects
+    if (poller->ready) tb_free(poller->ready);
+    if (poller->pfds) tb_free(poller->pfds);
+    poller->ready       = tb_null;
+    poller->pfds        = tb_null;
+    poller->ready_maxn  = 0;
+
+    // exit socket data
+    tb_pollerdata_exit(&poller->pollerdata);
+
+    // free it
+    tb_free(poller);
+}
+static tb_void_t tb_poller_iouring_kill(tb_poller_t* self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // kill it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"k", 1);
+}
+static tb_void_t tb_poller_iouring_spak(tb_poller_t* self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // post it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"p", 1);
+}
+static tb_bool_t tb_poller_iouring_insert(tb_poller_t* self, tb_poller_object_ref_t object, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && object, tb_false);
+
+    // get the item
+    tb_long_t                   fd = tb_ptr2fd(object->ref.ptr);
+    tb_poller_iouring_item_t*   item = tb_poller_iouring_item(poller, fd, tb_true);
+    tb_assert_and_check_return_val(item, tb_false);
+
+    // exists?
+    if (item->flags & TB_POLLER_IOURING_ITEM_INSERTED)
+    {
+        // trace
+        tb_trace_e("insert object(%p) events: %lu failed, it has been inserted!", object->ref.ptr, events);
+        return tb_false;
+    }
+
+    // bind the object type to the private data
+    priv = tb_poller_priv_set_object_type(object, priv);
+
+    // bind user private data to object
+    if (!(events & TB_POLLER_EVENT_NOEXTRA) || object->type == TB_POLLER_OBJECT_PIPE)
+        tb_pollerdata_set(&poller->pollerdata, object, priv);
+
+    // init item
+    item->gen++;
+    item->events = (tb_uint16_t)events;
+    item->flags  = TB_POLLER_IOURING_ITEM_INSERTED;
+
+    // arm it, it will be submitted in the next wait()
+    return tb_poller_iouring_arm(poller, fd, item);
+}
+static tb_bool_t tb_poller_iouring_remove(tb_poller_t* self, tb_poller_object_ref_t object)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && object, tb_false);
+
+    // get the item
+    tb_long_t                   fd = tb_ptr2fd(object->ref.ptr);
+    tb_poller_iouring_item_t*   item = tb_poller_iouring_item(poller, fd, tb_false);
+    if (!item || !(item->flags & TB_POLLER_IOURING_ITEM_INSERTED))
+    {
+        // trace
+        tb_trace_e("remove object(%p) failed, it has been not inserted!", object->ref.ptr);
+        return tb_false;
+    }
+
+    // disarm it
+    if (!tb_poller_iouring_disarm(poller, fd, item)) return tb_false;
+
+    // reset item
+    item->gen++;
+    item->events = 0;
+    item->flags  = 0;
+
+    // remove user private data from this object
+    tb_pollerdata_reset(&poller->pollerdata, object);
+
+    /* submit it now, because the poll request holds the file reference,
+     * the object may be closed after removing and the connection will not be closed if it's still polled
+     */
+    return tb_poller_iouring_submit(poller, tb_false, 0);
+}
+static tb_bool_t tb_poller_iouring_modify(tb_poller_t* self, tb_poller_object_ref_t object, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && object, tb_false);
+
+    // get the item
+    tb_long_t                   fd = tb_ptr2fd(object->ref.ptr);
+    tb_poller_iouring_item_t*   item = tb_poller_iouring_item(poller, fd, tb_false);
+    if (!item || !(item->flags & TB_POLLER_IOURING_ITEM_INSERTED))
+    {
+        // trace
+        tb_trace_e("modify object(%p) events: %lu failed, it has been not inserted!", object->ref.ptr, events);
+        return tb_false;
+    }
+
+    // bind the object type to the private data
+    priv = tb_poller_priv_set_object_type(object, priv);
+
+    // bind user private data to object
+    if (!(events & TB_POLLER_EVENT_NOEXTRA) || object->type == TB_POLLER_OBJECT_PIPE)
+        tb_pollerdata_set(&poller->pollerdata, object, priv);
+
+    // disarm the previous poll request
+    if (!tb_poller_iouring_disarm(poller, fd, item)) return tb_false;
+
+    // update item
+    item->gen++;
+    item->events = (tb_uint16_t)events;
+
+    // re-arm it, it will be submitted in the next wait()
+    return tb_poller_iouring_arm(poller, fd, item);
+}
+static tb_long_t tb_poller_iouring_wait(tb_poller_t* self, tb_poller_event_func_t func, tb_long_t timeout)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && poller->ready && func, -1);
+
+    // submit all prepared requests and wait the completion events
+    if (!tb_poller_iouring_submit(poller, tb_true, timeout)) return -1;
+
+    /* reap the completion events and merge them for each object
+     *
+     * the events of the multishot poll request are stashed when the object is woken up,
+     * so they may be stale if the data has been received by the user before we reap them.
+     */
+    tb_bool_t           killed = tb_false;
+    tb_size_t           ready_count = 0;
+    tb_size_t           io_count = 0;
+    tb_uint32_t         head = *poller->cq_head;
+    tb_uint32_t         tail = tb_atomic32_get((tb_atomic32_t*)poller->cq_tail);
+    tb_socket_ref_t     pair = poller->pair[1];
+    for (; head != tail && ready_count < poller->ready_maxn; head++)
+    {
+        // get the completion event
+        struct io_uring_cqe* cqe = &poller->cqes[head & poller->cq_mask];
+
+        // ignore it? e.g. poll remove
+        tb_uint64_t userdata = cqe->user_data;
+        tb_check_continue(userdata != TB_POLLER_IOURING_USERDATA_IGNORE && userdata != TB_POLLER_IOURING_USERDATA_PROBE);
+
+        // the completion-based io? complete it directly
+        if (!(userdata & TB_POLLER_IOURING_USERDATA_POLL))
+        {
+            tb_assert(poller->io_pending);
+            poller->io_pending--;
+            tb_poller_iouring_complete(poller, (tb_poller_io_ref_t)(tb_size_t)userdata, cqe->res);
+            io_count++;
+            continue ;
+        }
+
+        // get the item, the completion events of the stale poll requests will be ignored
+        tb_long_t                   fd = (tb_long_t)(tb_uint32_t)userdata;
+        tb_uint32_t                 gen = (tb_uint32_t)(userdata >> 32) & TB_POLLER_IOURING_GEN_MASK;
+        tb_poller_iouring_item_t*   item = tb_poller_iouring_item(poller, fd, tb_false);
+        tb_check_continue(item && (item->gen & TB_POLLER_IOURING_GEN_MASK) == gen && (item->flags & TB_POLLER_IOURING_ITEM_INSERTED));
+
+        // this poll request has been terminated? we need re-arm it if it's not oneshot
+        if (!(cqe->flags & IORING_CQE_F_MORE))
+        {
+            item->flags &= ~TB_POLLER_IOURING_ITEM_ARMED;
+            if (!(item->events & TB_POLLER_EVENT_ONESHOT) && !tb_poller_iouring_arm(poller, fd, item))
+                break;
+        }
+
+        // the poll request was canceled? it has been re-armed
+        tb_long_t res = cqe->res;
+        tb_check_continue(res != -ECANCELED);
+
+        // spank socket events?
+        if (tb_fd2ptr(fd) == (tb_pointer_t)pair)
+        {
+            // read spak
+            tb_char_t spak = '\0';
+            while (1 == tb_socket_recv(pair, (tb_byte_t*)&spak, 1))
+            {
+                // killed?
+                if (spak == 'k') killed = tb_true;
+            }
+            continue ;
+        }
+
+        // mark this object as ready, the events will be checked later
+        tb_uint16_t events = (tb_uint16_t)((res < 0)? TB_POLLER_EVENT_ERROR : TB_POLLER_EVENT_EALL);
+        if (!item->revents) poller->ready[ready_count++] = fd;
+        item->revents |= events;
+    }
+
+    // mark all completion events as consumed
+    tb_atomic32_set((tb_atomic32_t*)poller->cq_head, head);
+
+    // killed?
+    tb_check_return_val(!killed, -1);
+    tb_check_return_val(ready_count, io_count);
+
+    // check the current events of all ready objects in one call, we need not pass the stale events like epoll
+    tb_size_t i = 0;
+    for (i = 0; i < ready_count; i++)
+    {
+        tb_poller_iouring_item_t* item = &poller->items[poller->ready[i]];
+        poller->pfds[i].fd      = (tb_int_t)poller->ready[i];
+        poller->pfds[i].events  = 0;
+        poller->pfds[i].revents = 0;
+        if (item->events & TB_POLLER_EVENT_RECV) poller->pfds[i].events |= POLLIN;
+        if (item->events & TB_POLLER_EVENT_SEND) poller->pfds[i].events |= POLLOUT;
+#ifdef POLLRDHUP
+        if (item->events & TB_POLLER_EVENT_CLEAR) poller->pfds[i].events |= POLLRDHUP;
+#endif
+    }
+    if (poll(poller->pfds, ready_count, 0) < 0 && errno != EINTR)
+    {
+        // trace
+        tb_trace_e("poll ready objects failed, errno: %d", errno);
+        return -1;
+    }
+
+    // handle events
+    tb_size_t           wait = io_count;
+    tb_poller_object_t  object;
+    for (i = 0; i < ready_count; i++)
+    {
+        // get the item, it may be removed or modified by the previous event function
+        tb_long_t                   fd = poller->ready[i];
+        tb_poller_iouring_item_t*   item = &poller->items[fd];
+        tb_size_t                   revents = item->revents;
+        item->revents = 0;
+        tb_check_continue(item->flags & TB_POLLER_IOURING_ITEM_INSERTED);
+
+        // init events
+        tb_size_t   events = TB_POLLER_EVENT_NONE;
+        tb_size_t   mask = poller->pfds[i].revents;
+        if (mask & POLLIN) events |= TB_POLLER_EVENT_RECV;
+        if (mask & POLLOUT) events |= TB_POLLER_EVENT_SEND;
+        if (((revents & TB_POLLER_EVENT_ERROR) || (mask & (POLLHUP | POLLERR | POLLNVAL))) && !(events & (TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND)))
+            events |= TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
+
+        // the stale events? ignore it
+        tb_check_continue(events);
+
+#ifdef POLLRDHUP
+        // connection closed for the edge trigger?
+        if ((mask & POLLRDHUP) && (item->events & TB_POLLER_EVENT_CLEAR)) events |= TB_POLLER_EVENT_EOF;
+#endif
+
+        // call event function
+        object.ref.ptr = tb_fd2ptr(fd);
+        tb_cpointer_t priv = tb_pollerdata_get(&poller->pollerdata, &object);
+        object.type = tb_poller_priv_get_object_type(priv);
+        func((tb_poller_ref_t)self, &object, events, tb_poller_priv_get_original(priv));
+
+        // update the events count
+        wait++;
+    }
+
+    // ok
+    return wait;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_poller_t* tb_poller_iouring_init()
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_poller_iouring_ref_t poller = tb_null;
+    do
+    {
+        // make poller
+        poller = tb_malloc0_type(tb_poller_iouring_t);
+        tb_assert_and_check_break(poller);
+        poller->ringfd = -1;
+
+        // init base
+        poller->base.type   = TB_POLLER_TYPE_IOURING;
+        poller->base.exit   = tb_poller_iouring_exit;
+        poller->base.kill   = tb_poller_iouring_kill;
+        poller->base.spak   = tb_poller_iouring_spak;
+        poller->base.wait   = tb_poller_iouring_wait;
+        poller->base.insert = tb_poller_iouring_insert;
+        poller->base.remove = tb_poller_iouring_remove;
+        poller->base.modify = tb_poller_iouring_modify;
+        poller->base.post   = tb_poller_iouring_post;
+        poller->base.cancel = tb_poller_iouring_cancel;
+        poller->base.supported_events = TB_POLLER_EVENT_EALL | TB_POLLER_EVENT_CLEAR | TB_POLLER_EVENT_ONESHOT;
+
+        // init poller data
+        tb_pollerdata_init(&poller->pollerdata);
+
+        // init io_uring, it may be not supported or disabled by the kernel
+        struct io_uring_params params;
+        tb_memset(&params, 0, sizeof(params));
+#if defined(IORING_SETUP_COOP_TASKRUN) && defined(IORING_SETUP_SUBMIT_ALL)
+        /* we need not be interrupted to run the completion works because we always reap them in io_uring_enter() (linux 5.19+),
+         * and we need continue to submit the other requests if one request is failed
+         */
+        params.flags = IORING_SETUP_COOP_TASKRUN | IORING_SETUP_SUBMIT_ALL;
+        poller->ringfd = tb_poller_iouring_setup(TB_POLLER_IOURING_ENTRIES, &params);
+        if (poller->ringfd < 0 && errno == EINVAL)
+#endif
+        {
+            tb_memset(&params, 0, sizeof(params));
+            poller->ringfd = tb_poller_iouring_setup(TB_POLLER_IOURING_ENTRIES, &params);
+        }
+        if (poller->ringfd < 0)
+        {
+            // trace
+            tb_trace_d("io_uring is not supported, errno: %d", errno);
+            break;
+        }
+
+        // check features
+        if ((params.features & TB_POLLER_IOURING_FEATURES) != TB_POLLER_IOURING_FEATURES)
+        {
+            // trace
+            tb_trace_d("io_uring features: %x are not supported", params.features);
+            break;
+        }
+
+        // map the submission and completion queue rings
+        tb_size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(tb_uint32_t);
+        tb_size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        poller->ring_size = tb_max(sq_size, cq_size);
+        poller->ring = mmap(tb_null, poller->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_SQ_RING);
+        if (poller->ring == MAP_FAILED) poller->ring = tb_null;
+        tb_assert_and_check_break(poller->ring);
+
+        // map the submission queue entries
+        poller->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        poller->sqes = (struct io_uring_sqe*)mmap(tb_null, poller->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_SQES);
+        if (poller->sqes == MAP_FAILED) poller->sqes = tb_null;
+        tb_assert_and_check_break(poller->sqes);
+
+        // init the submission queue
+        tb_byte_t* ring = (tb_byte_t*)poller->ring;
+        poller->sq_head         = (tb_uint32_t*)(ring + params.sq_off.head);
+        poller->sq_tail         = (tb_uint32_t*)(ring + params.sq_off.tail);
+        poller->sq_array        = (tb_uint32_t*)(ring + params.sq_off.array);
+        poller->sq_mask         = *(tb_uint32_t*)(ring + params.sq_off.ring_mask);
+        poller->sq_entries      = *(tb_uint32_t*)(ring + params.sq_off.ring_entries);
+        poller->sq_tail_local   = *poller->sq_tail;
+
+        // init the completion queue
+        poller->cq_head         = (tb_uint32_t*)(ring + params.cq_off.head);
+        poller->cq_tail         = (tb_uint32_t*)(ring + params.cq_off.tail);
+        poller->cq_mask         = *(tb_uint32_t*)(ring + params.cq_off.ring_mask);
+        poller->cqes            = (struct io_uring_cqe*)(ring + params.cq_off.cqes);
+
+        // init the ready objects
+        poller->ready_maxn      = params.cq_entries;
+        poller->ready           = tb_nalloc_type(poller->ready_maxn, tb_long_t);
+        poller->pfds            = tb_nalloc_type(poller->ready_maxn, struct pollfd);
+        tb_assert_and_check_break(poller->ready && poller->pfds);
+
+        // init pair sockets
+        if (!tb_socket_pair(TB_SOCKET_TYPE_TCP, poller->pair)) break;
+
+        // probe the multishot poll request
+        if (!tb_poller_iouring_probe(poller)) break;
+
+        // insert pair socket first
+        tb_poller_object_t object;
+        object.type = TB_POLLER_OBJECT_SOCK;
+        object.ref.sock = poller->pair[1];
+        if (!tb_poller_iouring_insert((tb_poller_t*)poller, &object, TB_POLLER_EVENT_RECV, tb_null)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (poller) tb_poller_iouring_exit((tb_poller_t*)poller);
+        poller = tb_null;
+    }
+
+    // ok?
+    return (tb_poller_t*)poller;
+}
+
@@ -48,6 +48,7 @@
 #include "stdfile.h"
 #include "fwatcher.h"
 #include "filelock.h"
+#include "filemap.h"
 #include "syserror.h"
 #include "addrinfo.h"
 #include "spinlock.h"
@@ -48,6 +48,10 @@
     && defined(TB_CONFIG_POSIX_HAVE_EPOLL_WAIT)
 #   include "linux/poller_epoll.c"
 #   define TB_POLLER_ENABLE_EPOLL
+#   ifdef TB_CONFIG_LINUX_HAVE_IO_URING
+#       include "linux/poller_iouring.c"
+#       define TB_POLLER_ENABLE_IOURING
+#   endif
 #elif defined(TB_CONFIG_OS_MACOSX) || defined(TB_CONFIG_OS_BSD)
 #   include "bsd/poller_kqueue.c"
 #   define TB_POLLER_ENABLE_KQUEUE
@@ -83,13 +87,25 @@
  * implementation
  */
 tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
+{
+    return tb_poller_init_with_type(priv, TB_POLLER_TYPE_NONE);
+}
+tb_poller_ref_t tb_poller_init_with_type(tb_cpointer_t priv, tb_size_t type)
 {
     tb_bool_t       ok = tb_false;
     tb_poller_t*    poller = tb_null;
     do
     {
         // init poller
-#if defined(TB_POLLER_ENABLE_EPOLL)
+#if defined(TB_POLLER_ENABLE_IOURING)
+        /* io_uring need be selected explicitly, because its readiness events are slower than epoll,
+         * it's mainly used for the completion-based io, e.g. tb_poller_post()
+         *
+         * and we fall back to epoll if it's not supported by the kernel
+         */
+        if (type == TB_POLLER_TYPE_IOURING) poller = tb_poller_iouring_init();
+        if (!poller) poller = tb_poller_epoll_init();
+#elif defined(TB_POLLER_ENABLE_EPOLL)
         poller = tb_poller_epoll_init();
 #elif defined(TB_POLLER_ENABLE_KQUEUE)
         poller = tb_poller_kqueue_init();
@@ -362,6 +378,24 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
 #endif
     return wait;
 }
+tb_bool_t tb_poller_post(tb_poller_ref_t self, tb_poller_io_ref_t io)
+{
+    // check
+    tb_poller_t* poller = (tb_poller_t*)self;
+    tb_assert_and_check_return_val(poller && io && io->sock, tb_false);
+
+    // post it if the poller is completion-based
+    return poller->post? poller->post(poller, io) : tb_false;
+}
+tb_bool_t tb_poller_cancel(tb_poller_ref_t self, tb_poller_io_ref_t io)
+{
+    // check
+    tb_poller_t* poller = (tb_poller_t*)self;
+    tb_assert_and_check_return_val(poller && io, tb_false);
+
+    // cancel it
+    return poller->cancel? poller->cancel(poller, io) : tb_false;
+}
 tb_void_t tb_poller_attach(tb_poller_ref_t self)
 {
     // check
@@ -48,6 +48,7 @@ typedef enum __tb_poller_type_e
 ,   TB_POLLER_TYPE_EPOLL        = 3
 ,   TB_POLLER_TYPE_KQUEUE       = 4
 ,   TB_POLLER_TYPE_SELECT       = 5
+,   TB_POLLER_TYPE_IOURING      = 6
 
 }tb_poller_type_e;
 
@@ -120,6 +121,83 @@ typedef struct __tb_poller_object_t
  */
 typedef tb_void_t   (*tb_poller_event_func_t)(tb_poller_ref_t poller, tb_poller_object_ref_t object, tb_long_t events, tb_cpointer_t priv);
 
+/// the poller io code enum, only for the completion-based poller
+typedef enum __tb_poller_iocode_e
+{
+    TB_POLLER_IOCODE_NONE       = 0
+,   TB_POLLER_IOCODE_RECV       = 1 //!< recv data from the socket
+,   TB_POLLER_IOCODE_SEND       = 2 //!< send data to the socket
+,   TB_POLLER_IOCODE_ACPT       = 3 //!< accept a client socket
+,   TB_POLLER_IOCODE_CONN       = 4 //!< connect to the address
+
+}tb_poller_iocode_e;
+
+/// the poller io flag enum
+typedef enum __tb_poller_ioflag_e
+{
+    TB_POLLER_IOFLAG_NONE       = 0
+,   TB_POLLER_IOFLAG_WAITALL    = 1 //!< recv or send all data before it's completed, unless the socket is closed, failed or timeout
+,   TB_POLLER_IOFLAG_NOTREADY   = 2 //!< the socket is not ready, e.g. the previous recv/send returned EAGAIN, so we need not try it before waiting
+
+}tb_poller_ioflag_e;
+
+/// the poller io type
+struct __tb_poller_io_t;
+
+/*! the poller io func type
+ *
+ * @param poller    the poller
+ * @param io        the completed io, see io->state and io->result
+ */
+typedef tb_void_t   (*tb_poller_io_func_t)(tb_poller_ref_t poller, struct __tb_poller_io_t* io);
+
+/*! the poller io type, it will be completed by the kernel for the completion-based poller (io_uring)
+ *
+ * it must be kept alive until it's completed, and the io func will be called in tb_poller_wait()
+ */
+typedef struct __tb_poller_io_t
+{
+    /// the io code
+    tb_uint8_t              code;
+
+    /// the io flags
+    tb_uint8_t              flags;
+
+    /// the socket
+    tb_socket_ref_t         sock;
+
+    /// the data, only for recv and send
+    tb_byte_t*              data;
+
+    /// the data size, only for recv and send
+    tb_size_t               size;
+
+    /// the peer address for conn, the client address for acpt
+    tb_ipaddr_t             addr;
+
+    /// the timeout (ms), infinity: -1
+    tb_long_t               timeout;
+
+    /// the state after completed, e.g. TB_STATE_OK, TB_STATE_TIMEOUT, TB_STATE_KILLED, TB_STATE_FAILED
+    tb_size_t               state;
+
+    /// the result after completed, the real size for recv and send, 0: closed
+    tb_long_t               result;
+
+    /// the accepted client socket, only for acpt
+    tb_socket_ref_t         client;
+
+    /// the io func
+    tb_poller_io_func_t     func;
+
+    /// the user private data
+    tb_cpointer_t           priv;
+
+    /// the reserved data of the poller, e.g. the kernel socket address and timeout
+    tb_hize_t               reserved[20];
+
+}tb_poller_io_t, *tb_poller_io_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -132,6 +210,17 @@ typedef tb_void_t   (*tb_poller_event_func_t)(tb_poller_ref_t poller, tb_poller_
  */
 tb_poller_ref_t     tb_poller_init(tb_cpointer_t priv);
 
+/*! init poller with the given type
+ *
+ * the default poller will be used if the given type is not supported, e.g. io_uring is disabled by the kernel
+ *
+ * @param priv      the user private data
+ * @param type      the poller type, e.g. TB_POLLER_TYPE_IOURING, use the default poller if be TB_POLLER_TYPE_NONE
+ *
+ * @return          the poller
+ */
+tb_poller_ref_t     tb_poller_init_with_type(tb_cpointer_t priv, tb_size_t type);
+
 /*! exit poller
  *
  * @param poller    the poller
@@ -216,6 +305,27 @@ tb_bool_t           tb_poller_modify(tb_poller_ref_t poller, tb_poller_object_re
  */
 tb_long_t           tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout);
 
+/*! post an io to the completion-based poller (only for io_uring now)
+ *
+ * it will be submitted with the other requests in the next tb_poller_wait(),
+ * and the io func will be called in tb_poller_wait() after it's completed.
+ *
+ * @param poller    the poller
+ * @param io        the io
+ *
+ * @return          tb_true or tb_false, it will return tb_false if the poller does not support it
+ */
+tb_bool_t           tb_poller_post(tb_poller_ref_t poller, tb_poller_io_ref_t io);
+
+/*! cancel the posted io, it will be completed with TB_STATE_KILLED if it has been not completed
+ *
+ * @param poller    the poller
+ * @param io        the io
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_poller_cancel(tb_poller_ref_t poller, tb_poller_io_ref_t io);
+
 /*! attach the poller to the current thread (only for windows/iocp now)
  *
  * @param poller    the poller
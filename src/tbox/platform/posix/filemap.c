@@ -0,0 +1,71 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        filemap.c
+ * @ingroup     platform
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../filemap.h"
+#include "../page.h"
+#include <sys/mman.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t tb_filemap_align()
+{
+    return tb_page_size();
+}
+tb_byte_t const* tb_filemap_init(tb_file_ref_t file, tb_hize_t offset, tb_size_t size, tb_size_t advice)
+{
+    // check
+    tb_assert_and_check_return_val(file && size, tb_null);
+    tb_assert_and_check_return_val(!(offset & (tb_filemap_align() - 1)), tb_null);
+
+    // map it
+    tb_pointer_t data = mmap(tb_null, size, PROT_READ, MAP_SHARED, tb_file2fd(file), (off_t)offset);
+    tb_check_return_val(data != MAP_FAILED, tb_null);
+
+#ifdef POSIX_MADV_SEQUENTIAL
+    // advise it
+    switch (advice)
+    {
+    case TB_FILEMAP_ADVICE_SEQUENTIAL:
+        posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+        break;
+    case TB_FILEMAP_ADVICE_RANDOM:
+        posix_madvise(data, size, POSIX_MADV_RANDOM);
+        break;
+    default:
+        break;
+    }
+#endif
+
+    // ok
+    return (tb_byte_t const*)data;
+}
+tb_bool_t tb_filemap_exit(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // unmap it
+    return !munmap((tb_pointer_t)data, size);
+}
@@ -41,6 +41,11 @@
 #ifdef TB_CONFIG_POSIX_HAVE_SENDFILE
 #   include <sys/sendfile.h>
 #endif
+#ifdef TB_CONFIG_POSIX_HAVE_SPLICE
+#   include "../thread_local.h"
+#   include "../native_memory.h"
+#   include <sys/stat.h>
+#endif
 #ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
 #   include "../../coroutine/coroutine.h"
 #   include "../../coroutine/impl/impl.h"
@@ -55,9 +60,154 @@
 #   define SO_NOSIGPIPE MSG_NOSIGNAL
 #endif
 
+// the splice size
+#define TB_SOCKET_SPLICE_MAXN       (65536)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef TB_CONFIG_POSIX_HAVE_SPLICE
+// the splice pipe type
+typedef struct __tb_socket_splice_pipe_t
+{
+    // the pipe fds, read: fds[0], writ: fds[1]
+    tb_int_t            fds[2];
+
+    // is busy?
+    tb_bool_t           busy;
+
+}tb_socket_splice_pipe_t;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_CONFIG_POSIX_HAVE_SPLICE
+// the cached splice pipe of the current thread
+static tb_thread_local_t g_splice_pipe = TB_THREAD_LOCAL_INIT;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#ifdef TB_CONFIG_POSIX_HAVE_SPLICE
+static tb_void_t tb_socket_splice_pipe_free(tb_cpointer_t priv)
+{
+    tb_socket_splice_pipe_t* spipe = (tb_socket_splice_pipe_t*)priv;
+    if (spipe)
+    {
+        if (spipe->fds[0] >= 0) close(spipe->fds[0]);
+        if (spipe->fds[1] >= 0) close(spipe->fds[1]);
+        tb_native_memory_free(spipe);
+    }
+}
+static tb_socket_splice_pipe_t* tb_socket_splice_pipe_make()
+{
+    /* make pipe
+     *
+     * we use the native memory because the cached pipe lives as long as the current thread,
+     * it may be made in the scoped arena allocator (tb_allocator_scope_enter()) and be freed in the thread local destructor
+     */
+    tb_socket_splice_pipe_t* spipe = (tb_socket_splice_pipe_t*)tb_native_memory_malloc0(sizeof(tb_socket_splice_pipe_t));
+    tb_assert_and_check_return_val(spipe, tb_null);
+
+    // init pipe fds
+    if (pipe2(spipe->fds, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        tb_native_memory_free(spipe);
+        return tb_null;
+    }
+    return spipe;
+}
+static tb_socket_splice_pipe_t* tb_socket_splice_pipe_take()
+{
+    /* get the cached pipe of the current thread
+     *
+     * the cached pipe maybe busy if the current coroutine is suspended in tb_socket_splice(),
+     * so we make a temporary pipe for the other coroutines in this thread.
+     */
+    tb_socket_splice_pipe_t* spipe = tb_null;
+    if (tb_thread_local_init(&g_splice_pipe, tb_socket_splice_pipe_free))
+    {
+        spipe = (tb_socket_splice_pipe_t*)tb_thread_local_get(&g_splice_pipe);
+        if (!spipe)
+        {
+            spipe = tb_socket_splice_pipe_make();
+            if (spipe && !tb_thread_local_set(&g_splice_pipe, spipe))
+            {
+                tb_socket_splice_pipe_free(spipe);
+                spipe = tb_null;
+            }
+        }
+    }
+    if (spipe && !spipe->busy)
+    {
+        spipe->busy = tb_true;
+        return spipe;
+    }
+    return tb_socket_splice_pipe_make();
+}
+static tb_void_t tb_socket_splice_pipe_give(tb_socket_splice_pipe_t* spipe, tb_bool_t drained)
+{
+    // check
+    tb_assert_and_check_return(spipe);
+
+    // is the cached pipe? we need free it if there are some data left in pipe
+    if (g_splice_pipe.inited && spipe == tb_thread_local_get(&g_splice_pipe))
+    {
+        if (drained) spipe->busy = tb_false;
+        else tb_thread_local_set(&g_splice_pipe, tb_null);
+    }
+    else tb_socket_splice_pipe_free(spipe);
+}
+static tb_bool_t tb_socket_splice_file_ok(tb_file_ref_t file)
+{
+    /* we can only splice data to the regular file or block device with the given offset,
+     * and splice() will return EINVAL for the file opened with O_APPEND
+     */
+    struct stat st = {0};
+    tb_int_t    fd = tb_file2fd(file);
+    tb_int_t    flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && !(flags & O_APPEND) && !fstat(fd, &st) && (S_ISREG(st.st_mode) || S_ISBLK(st.st_mode));
+}
+static tb_bool_t tb_socket_splice_pipe_drain(tb_socket_splice_pipe_t* spipe, tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t offset, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(spipe && (sock || file), tb_false);
+
+    /* drain the left data in pipe to the socket or file with the buffered writing
+     * if splice() has been failed, otherwise these received data will be lost
+     */
+    tb_byte_t data[8192];
+    while (size)
+    {
+        // read data from pipe, all data are already in pipe and it will not be blocked
+        tb_long_t real = (tb_long_t)read(spipe->fds[0], data, tb_min(size, sizeof(data)));
+        if (real < 0 && errno == EINTR) continue;
+        tb_check_break(real > 0);
+
+        // writ data to the socket or file
+        if (sock)
+        {
+            tb_check_break(tb_socket_bsend(sock, data, real));
+        }
+        else
+        {
+            tb_long_t writ = 0;
+            while (writ < real)
+            {
+                tb_long_t ok = tb_file_pwrit(file, data + writ, real - writ, offset + writ);
+                if (ok > 0) writ += ok;
+                else break;
+            }
+            tb_check_break(writ == real);
+            offset += real;
+        }
+        size -= real;
+    }
+    return !size;
+}
+#endif
 static tb_int_t tb_socket_type(tb_size_t type)
 {
     // get socket type
@@ -670,6 +820,139 @@ tb_hong_t tb_socket_sendf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t of
     return writ == read? writ : -1;
 #endif
 }
+tb_hong_t tb_socket_recvf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t offset, tb_hize_t size)
+{
+    // check
+    tb_assert_and_check_return_val(sock && file && size, -1);
+
+#if defined(TB_CONFIG_POSIX_HAVE_SPLICE)
+
+    // we cannot splice data to this file? do not receive any data and fall back to the buffered receiving
+    tb_check_return_val(tb_socket_splice_file_ok(file), -1);
+
+    // take a pipe
+    tb_socket_splice_pipe_t* spipe = tb_socket_splice_pipe_take();
+    tb_check_return_val(spipe, -1);
+
+    // splice data from the socket to pipe
+    tb_long_t real = splice(tb_sock2fd(sock), tb_null, spipe->fds[1], tb_null, (size_t)tb_min(size, TB_SOCKET_SPLICE_MAXN), SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+
+    // trace
+    tb_trace_d("recvf: %p %llu => %ld, errno: %d", sock, size, real, errno);
+
+    // no data?
+    if (real <= 0)
+    {
+        tb_socket_splice_pipe_give(spipe, tb_true);
+        return (real < 0 && (errno == EINTR || errno == EAGAIN))? 0 : real;
+    }
+
+    // splice data from pipe to the file
+    loff_t      seek = (loff_t)offset;
+    tb_long_t   writ = 0;
+    while (writ < real)
+    {
+        tb_long_t ok = splice(spipe->fds[0], tb_null, tb_file2fd(file), &seek, real - writ, SPLICE_F_MOVE);
+        if (ok > 0) writ += ok;
+        else if (ok < 0 && errno == EINTR) continue;
+        else break;
+    }
+
+    // splice failed? drain the left data in pipe to the file
+    if (writ < real && tb_socket_splice_pipe_drain(spipe, tb_null, file, (tb_hize_t)seek, real - writ))
+        writ = real;
+
+    // give the pipe
+    tb_socket_splice_pipe_give(spipe, writ == real);
+    return writ == real? real : -1;
+
+#else
+
+    // recv data
+    tb_byte_t data[8192];
+    tb_long_t real = tb_socket_recv(sock, data, (tb_size_t)tb_min(size, sizeof(data)));
+    tb_check_return_val(real > 0, real);
+
+    // writ data
+    tb_long_t writ = 0;
+    while (writ < real)
+    {
+        tb_long_t ok = tb_file_pwrit(file, data + writ, real - writ, offset + writ);
+        if (ok > 0) writ += ok;
+        else break;
+    }
+
+    // ok?
+    return writ == real? real : -1;
+#endif
+}
+tb_hong_t tb_socket_splice(tb_socket_ref_t sock, tb_socket_ref_t from, tb_hize_t size)
+{
+    // check
+    tb_assert_and_check_return_val(sock && from && size, -1);
+
+#if defined(TB_CONFIG_POSIX_HAVE_SPLICE)
+
+    // take a pipe
+    tb_socket_splice_pipe_t* spipe = tb_socket_splice_pipe_take();
+    tb_check_return_val(spipe, -1);
+
+    // splice data from the given socket to pipe
+    tb_long_t real = splice(tb_sock2fd(from), tb_null, spipe->fds[1], tb_null, (size_t)tb_min(size, TB_SOCKET_SPLICE_MAXN), SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+
+    // trace
+    tb_trace_d("splice: %p => %p %llu => %ld, errno: %d", from, sock, size, real, errno);
+
+    // no data?
+    if (real <= 0)
+    {
+        tb_socket_splice_pipe_give(spipe, tb_true);
+        return (real < 0 && (errno == EINTR || errno == EAGAIN))? 0 : real;
+    }
+
+    // splice data from pipe to the socket
+    tb_long_t send = 0;
+    tb_long_t wait = 0;
+    while (send < real)
+    {
+        // send it
+        tb_long_t ok = splice(spipe->fds[0], tb_null, tb_sock2fd(sock), tb_null, real - send, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+
+        // has data?
+        if (ok > 0)
+        {
+            send += ok;
+            wait = 0;
+        }
+        // no data? wait it
+        else if (ok < 0 && (errno == EINTR || errno == EAGAIN) && !wait)
+        {
+            wait = tb_socket_wait(sock, TB_SOCKET_EVENT_SEND, -1);
+            tb_check_break(wait > 0);
+        }
+        // failed?
+        else break;
+    }
+
+    // splice failed? drain the left data in pipe to the socket
+    if (send < real && tb_socket_splice_pipe_drain(spipe, sock, tb_null, 0, real - send))
+        send = real;
+
+    // give the pipe
+    tb_socket_splice_pipe_give(spipe, send == real);
+    return send == real? real : -1;
+
+#else
+
+    // recv data
+    tb_byte_t data[8192];
+    tb_long_t real = tb_socket_recv(from, data, (tb_size_t)tb_min(size, sizeof(data)));
+    tb_check_return_val(real > 0, real);
+
+    // send data
+    return tb_socket_bsend(sock, data, real)? real : -1;
+#endif
+}
 tb_long_t tb_socket_urecv(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_byte_t* data, tb_size_t size)
 {
     // check
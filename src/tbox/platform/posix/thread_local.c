@@ -81,6 +81,9 @@ tb_bool_t tb_thread_local_init(tb_thread_local_ref_t local, tb_thread_local_free
     // check
     tb_assert_and_check_return_val(local, tb_false);
 
+    // the thread local environment has not been initialized? e.g. be called before tb_init()
+    tb_check_return_val(g_thread_local_inited, tb_false);
+
     // run the once function
     tb_value_t tuple[2];
     tuple[0].ptr = (tb_pointer_t)local;
@@ -133,6 +133,16 @@ tb_hong_t tb_socket_sendf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t of
     tb_trace_noimpl();
     return -1;
 }
+tb_hong_t tb_socket_recvf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t offset, tb_hize_t size)
+{
+    tb_trace_noimpl();
+    return -1;
+}
+tb_hong_t tb_socket_splice(tb_socket_ref_t sock, tb_socket_ref_t from, tb_hize_t size)
+{
+    tb_trace_noimpl();
+    return -1;
+}
 tb_long_t tb_socket_urecv(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_byte_t* data, tb_size_t size)
 {
     tb_trace_noimpl();
@@ -280,6 +280,32 @@ tb_long_t           tb_socket_sendv(tb_socket_ref_t sock, tb_iovec_t const* list
  */
 tb_hong_t           tb_socket_sendf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t offset, tb_hize_t size);
 
+/*! recv data to the file
+ *
+ * the data will be spliced to the file directly in kernel if be supported, e.g. splice() on linux
+ *
+ * @param sock      the socket
+ * @param file      the file
+ * @param offset    the file offset
+ * @param size      the maximum size
+ *
+ * @return          the real size or -1
+ */
+tb_hong_t           tb_socket_recvf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t offset, tb_hize_t size);
+
+/*! splice data from the given socket to the socket
+ *
+ * the data will be spliced in kernel if be supported, e.g. splice() on linux,
+ * and it will wait the socket until all received data have been sent.
+ *
+ * @param sock      the socket
+ * @param from      the socket for receiving data
+ * @param size      the maximum size
+ *
+ * @return          the real size or -1
+ */
+tb_hong_t           tb_socket_splice(tb_socket_ref_t sock, tb_socket_ref_t from, tb_hize_t size);
+
 /*! send the socket data for udp
  *
  * @param sock      the socket
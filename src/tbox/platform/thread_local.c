@@ -44,6 +44,9 @@ static tb_single_list_entry_head_t  g_thread_local_list;
 // the thread local list lock
 static tb_spinlock_t                g_thread_local_lock = TB_SPINLOCK_INIT;
 
+// the thread local environment have been initialized?
+static tb_bool_t                    g_thread_local_inited = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -56,6 +59,7 @@ tb_bool_t tb_thread_local_init_env()
     tb_single_list_entry_init(&g_thread_local_list, tb_thread_local_t, entry, tb_null);
 
     // ok
+    g_thread_local_inited = tb_true;
     return tb_true;
 }
 tb_void_t tb_thread_local_exit_env()
@@ -68,7 +72,12 @@ tb_void_t tb_thread_local_exit_env()
     {
         // exit it
         tb_thread_local_exit(local);
+
+        // reset it, we can init it again after the environment is re-initialized
+        local->inited   = tb_false;
+        local->once     = 0;
     }
+    g_thread_local_inited = tb_false;
 
     // exit the thread local list
     tb_single_list_entry_exit(&g_thread_local_list);
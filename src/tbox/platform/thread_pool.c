@@ -74,6 +74,19 @@
 #   define TB_THREAD_POOL_JOBS_PULL_TIME_MAXN   (20000)
 #endif
 
+// the job deque maxn of each worker for the stealing mode, must be pow2
+#ifdef __tb_small__
+#   define TB_THREAD_POOL_JOBS_DEQUE_MAXN       (1024)
+#else
+#   define TB_THREAD_POOL_JOBS_DEQUE_MAXN       (4096)
+#endif
+
+// the jobs grabbing maxn from the global jobs once for the stealing mode
+#define TB_THREAD_POOL_JOBS_GRAB_MAXN           (32)
+
+// the local jobs count before checking the global jobs first for the stealing mode
+#define TB_THREAD_POOL_JOBS_LOCAL_TICK          (61)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -84,7 +97,11 @@ typedef struct __tb_thread_pool_job_t
     // the task
     tb_thread_pool_task_t               task;
 
-    // the reference count, must be <= 2
+    /* the reference count
+     *
+     * it's referenced by the pool, the task handle and the workers which are holding it in their working jobs,
+     * so it will not be freed by cleaning the pending jobs if the other worker is still holding it.
+     */
     tb_atomic32_t                       refn;
 
     /* the state
@@ -97,6 +114,9 @@ typedef struct __tb_thread_pool_job_t
      */
     tb_atomic32_t                       state;
 
+    // the kill epoch when posting it, only for the stealing mode
+    tb_size_t                           epoch;
+
     // the entry
     tb_list_entry_t                     entry;
 
@@ -148,6 +168,21 @@ typedef struct __tb_thread_pool_worker_t
     // is stoped?
     tb_atomic_flag_t                    bstoped;
 
+    // the top index of the job deque, it will be changed by the thieves, only for the stealing mode
+    tb_atomic_t                         deque_top;
+
+    // the job deque, only for the stealing mode
+    tb_atomic_t*                        deque;
+
+    // the local jobs count, only for the stealing mode
+    tb_size_t                           tick;
+
+    // the random seed for choosing the victim worker, only for the stealing mode
+    tb_size_t                           seed;
+
+    // the bottom index of the job deque, it will be changed by the owner worker, only for the stealing mode
+    tb_atomic_t                         deque_bottom;
+
     // the private data
     tb_thread_pool_worker_priv_t        priv[TB_THREAD_POOL_WORKER_PRIV_MAXN];
 
@@ -156,6 +191,9 @@ typedef struct __tb_thread_pool_worker_t
 // the thread pool type
 typedef struct __tb_thread_pool_impl_t
 {
+    // the mode
+    tb_size_t                           mode;
+
     // the thread stack size
     tb_size_t                           stack;
 
@@ -186,11 +224,34 @@ typedef struct __tb_thread_pool_impl_t
     // the worker size
     tb_size_t                           worker_size;
 
+    // the jobs count, only for the stealing mode
+    tb_atomic_t                         jobs_count;
+
+    // the global jobs count (urgent and waiting), only for the stealing mode
+    tb_atomic_t                         jobs_global;
+
+    // the kill epoch, all jobs posted before this epoch will be killed, only for the stealing mode
+    tb_atomic_t                         jobs_epoch;
+
+    // the idle worker count, only for the stealing mode
+    tb_atomic_t                         worker_idle;
+
     // the worker list
     tb_thread_pool_worker_t             worker_list[TB_THREAD_POOL_WORKER_MAXN];
 
 }tb_thread_pool_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the current worker of the stealing mode
+#ifdef __tb_thread_local__
+static __tb_thread_local__ tb_thread_pool_worker_t*     g_worker_self = tb_null;
+#else
+static tb_thread_local_t                                g_worker_self = TB_THREAD_LOCAL_INIT;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
@@ -243,8 +304,9 @@ static tb_bool_t tb_thread_pool_worker_walk_pull(tb_iterator_ref_t iterator, tb_
     // append the job to the pending jobs
     tb_list_entry_insert_tail(&impl->jobs_pending, &job->entry);
 
-    // append the job to the working jobs
+    // append the job to the working jobs, refn++
     tb_vector_insert_tail(worker->jobs, job);
+    job->refn++;
 
     // computate the job average time
     tb_size_t average_time = 200;
@@ -280,8 +342,9 @@ static tb_bool_t tb_thread_pool_worker_walk_pull_and_clean(tb_iterator_ref_t ite
     tb_bool_t ok = tb_false;
     if (state == TB_STATE_WAITING && worker->pull < TB_THREAD_POOL_JOBS_PULL_TIME_MAXN)
     {
-        // append the job to the working jobs
+        // append the job to the working jobs, refn++
         tb_vector_insert_tail(worker->jobs, job);
+        job->refn++;
 
         // computate the job average time
         tb_size_t average_time = 200;
@@ -571,6 +634,15 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
                 }
             }
 
+            // release jobs, refn--, and free it if the pool and the other workers have released it
+            tb_spinlock_enter(&impl->lock);
+            tb_for_all (tb_thread_pool_job_t*, held, worker->jobs)
+            {
+                if (held->refn > 1) held->refn--;
+                else tb_fixed_pool_free(impl->jobs_pool, held);
+            }
+            tb_spinlock_leave(&impl->lock);
+
             // clear jobs
             tb_vector_clear(worker->jobs);
         }
@@ -743,6 +815,480 @@ static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t
     return job;
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * stealing implementation
+ */
+static __tb_inline__ tb_thread_pool_worker_t* tb_thread_pool_stealing_self(tb_noarg_t)
+{
+#ifdef __tb_thread_local__
+    return g_worker_self;
+#else
+    return (tb_thread_pool_worker_t*)tb_thread_local_get(&g_worker_self);
+#endif
+}
+static __tb_inline__ tb_long_t tb_thread_pool_stealing_deque_size(tb_thread_pool_worker_t* worker)
+{
+    tb_long_t size = tb_atomic_get_explicit(&worker->deque_bottom, TB_ATOMIC_ACQUIRE) - tb_atomic_get_explicit(&worker->deque_top, TB_ATOMIC_ACQUIRE);
+    return size > 0? size : 0;
+}
+static tb_bool_t tb_thread_pool_stealing_deque_push(tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check, only the owner worker can push it
+    tb_assert(worker && worker->deque && job);
+
+    // full?
+    tb_long_t bottom = tb_atomic_get_explicit(&worker->deque_bottom, TB_ATOMIC_RELAXED);
+    tb_long_t top = tb_atomic_get_explicit(&worker->deque_top, TB_ATOMIC_ACQUIRE);
+    tb_check_return_val(bottom - top < TB_THREAD_POOL_JOBS_DEQUE_MAXN, tb_false);
+
+    // push it to the bottom and publish it to the thieves
+    tb_atomic_set_explicit(&worker->deque[bottom & (TB_THREAD_POOL_JOBS_DEQUE_MAXN - 1)], (tb_long_t)job, TB_ATOMIC_RELAXED);
+    tb_atomic_set_explicit(&worker->deque_bottom, bottom + 1, TB_ATOMIC_RELEASE);
+    return tb_true;
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_deque_pop(tb_thread_pool_worker_t* worker)
+{
+    // check, only the owner worker can pop it
+    tb_assert(worker && worker->deque);
+
+    // reserve the bottom job first
+    tb_long_t bottom = tb_atomic_get_explicit(&worker->deque_bottom, TB_ATOMIC_RELAXED) - 1;
+    tb_atomic_set_explicit(&worker->deque_bottom, bottom, TB_ATOMIC_RELAXED);
+    tb_memory_barrier();
+    tb_long_t top = tb_atomic_get_explicit(&worker->deque_top, TB_ATOMIC_RELAXED);
+
+    // empty?
+    tb_thread_pool_job_t* job = tb_null;
+    if (top <= bottom)
+    {
+        // get the bottom job
+        job = (tb_thread_pool_job_t*)tb_atomic_get_explicit(&worker->deque[bottom & (TB_THREAD_POOL_JOBS_DEQUE_MAXN - 1)], TB_ATOMIC_RELAXED);
+
+        // the last job? we need race with the thieves
+        if (top == bottom)
+        {
+            if (!tb_atomic_compare_and_swap_explicit(&worker->deque_top, &top, top + 1, TB_ATOMIC_SEQ_CST, TB_ATOMIC_RELAXED))
+                job = tb_null;
+            tb_atomic_set_explicit(&worker->deque_bottom, bottom + 1, TB_ATOMIC_RELAXED);
+        }
+    }
+    else tb_atomic_set_explicit(&worker->deque_bottom, bottom + 1, TB_ATOMIC_RELAXED);
+
+    // ok?
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_deque_steal(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert(worker && worker->deque);
+
+    // empty?
+    tb_long_t top = tb_atomic_get_explicit(&worker->deque_top, TB_ATOMIC_ACQUIRE);
+    tb_memory_barrier();
+    tb_long_t bottom = tb_atomic_get_explicit(&worker->deque_bottom, TB_ATOMIC_ACQUIRE);
+    tb_check_return_val(top < bottom, tb_null);
+
+    // steal the top job, it may be failed if other thieves or the owner has taken it
+    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)tb_atomic_get_explicit(&worker->deque[top & (TB_THREAD_POOL_JOBS_DEQUE_MAXN - 1)], TB_ATOMIC_RELAXED);
+    return tb_atomic_compare_and_swap_explicit(&worker->deque_top, &top, top + 1, TB_ATOMIC_SEQ_CST, TB_ATOMIC_RELAXED)? job : tb_null;
+}
+static tb_void_t tb_thread_pool_stealing_job_exit(tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(job);
+
+    // exit the job
+    if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+    // refn--, free it if no task handle refers to it
+    if (tb_atomic32_fetch_and_sub(&job->refn, 1) == 1) tb_free(job);
+}
+static tb_void_t tb_thread_pool_stealing_job_done(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(impl && job && job->task.done);
+
+    // killed by tb_thread_pool_task_kill_all() after posting it?
+    tb_int32_t state = TB_STATE_WAITING;
+    if (job->epoch != (tb_size_t)tb_atomic_get_explicit(&impl->jobs_epoch, TB_ATOMIC_ACQUIRE))
+        tb_atomic32_fetch_and_cmpset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
+
+    // the job is waiting? work it
+    if (tb_atomic32_compare_and_swap(&job->state, &state, TB_STATE_WORKING))
+    {
+        // trace
+        tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker? worker->id : -1, job->task.done, job->task.name);
+
+        // done the job
+        job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // update the job state
+        tb_atomic32_set(&job->state, TB_STATE_FINISHED);
+    }
+    // the job is killing? kill it
+    else if (state == TB_STATE_KILLING)
+    {
+        // update the job state
+        tb_atomic32_set(&job->state, TB_STATE_KILLED);
+    }
+
+    // exit the job
+    tb_thread_pool_stealing_job_exit(worker, job);
+
+    // jobs count--
+    tb_atomic_fetch_and_sub(&impl->jobs_count, 1);
+}
+static tb_void_t tb_thread_pool_stealing_wakeup(tb_thread_pool_impl_t* impl)
+{
+    // wake up one idle worker if exists
+    tb_memory_barrier();
+    if (tb_atomic_get_explicit(&impl->worker_idle, TB_ATOMIC_RELAXED) > 0)
+        tb_thread_pool_worker_post(impl, 1);
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_grab(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_bool_t waiting)
+{
+    // check
+    tb_assert(impl && worker);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // grab one urgent job first
+    tb_size_t               grab = 0;
+    tb_list_entry_ref_t     entry = tb_null;
+    tb_thread_pool_job_t*   job = tb_null;
+    if (tb_list_entry_size(&impl->jobs_urgent))
+    {
+        entry = tb_list_entry_head(&impl->jobs_urgent);
+        tb_list_entry_remove_head(&impl->jobs_urgent);
+        job = (tb_thread_pool_job_t*)tb_list_entry(&impl->jobs_urgent, entry);
+        grab = 1;
+    }
+    // grab a batch of the waiting jobs, we run the first one and move others to the local deque
+    else if (waiting && tb_list_entry_size(&impl->jobs_waiting))
+    {
+        // the grab count, we need leave some jobs for the other workers
+        tb_size_t maxn = tb_list_entry_size(&impl->jobs_waiting) / impl->worker_size + 1;
+        maxn = tb_min(maxn, TB_THREAD_POOL_JOBS_GRAB_MAXN);
+
+        // grab them
+        while (grab < maxn && tb_list_entry_size(&impl->jobs_waiting))
+        {
+            // the job
+            entry = tb_list_entry_head(&impl->jobs_waiting);
+            tb_thread_pool_job_t* item = (tb_thread_pool_job_t*)tb_list_entry(&impl->jobs_waiting, entry);
+
+            // move it to the local deque
+            if (job && !tb_thread_pool_stealing_deque_push(worker, item)) break;
+            if (!job) job = item;
+
+            // remove it from the waiting jobs
+            tb_list_entry_remove_head(&impl->jobs_waiting);
+            grab++;
+        }
+    }
+
+    // update the global jobs count
+    if (grab) tb_atomic_fetch_and_sub(&impl->jobs_global, grab);
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+
+    // trace
+    tb_trace_d("worker[%lu]: grab: %lu jobs from global", worker->id, grab);
+
+    // the other idle workers may steal the grabbed jobs
+    if (grab > 1) tb_thread_pool_stealing_wakeup(impl);
+
+    // ok?
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_steal(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert(impl && worker);
+
+    // only one worker?
+    tb_size_t worker_size = impl->worker_size;
+    tb_check_return_val(worker_size > 1, tb_null);
+
+    // choose a random victim to start
+    worker->seed = worker->seed * 1103515245 + 12345;
+    tb_size_t start = (worker->seed >> 16) % worker_size;
+
+    // walk all other workers
+    tb_size_t i = 0;
+    tb_thread_pool_job_t* job = tb_null;
+    for (i = 0; i < worker_size && !job; i++)
+    {
+        // the victim worker
+        tb_thread_pool_worker_t* victim = &impl->worker_list[(start + i) % worker_size];
+        tb_check_continue(victim != worker && victim->deque);
+
+        // steal one job to run
+        job = tb_thread_pool_stealing_deque_steal(victim);
+        tb_check_continue(job);
+
+        // steal the half of remaining jobs to the local deque
+        tb_long_t half = tb_thread_pool_stealing_deque_size(victim) >> 1;
+        tb_long_t left = TB_THREAD_POOL_JOBS_DEQUE_MAXN - tb_thread_pool_stealing_deque_size(worker);
+        if (half > left) half = left;
+        while (half-- > 0)
+        {
+            // steal it
+            tb_thread_pool_job_t* item = tb_thread_pool_stealing_deque_steal(victim);
+            tb_check_break(item);
+
+            // move it to the local deque, it will not be full because we have reserved it
+            if (!tb_thread_pool_stealing_deque_push(worker, item))
+            {
+                tb_assert(0);
+                break;
+            }
+        }
+
+        // trace
+        tb_trace_d("worker[%lu]: steal: jobs from worker[%lu]", worker->id, victim->id);
+    }
+
+    // ok?
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_pull(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert(impl && worker);
+
+    /* pull the urgent jobs from the global first,
+     * and we also check the global waiting jobs sometimes for the fairness
+     */
+    tb_thread_pool_job_t* job = tb_null;
+    tb_bool_t fairness = !(++worker->tick % TB_THREAD_POOL_JOBS_LOCAL_TICK);
+    if (tb_atomic_get_explicit(&impl->jobs_global, TB_ATOMIC_ACQUIRE) > 0)
+        job = tb_thread_pool_stealing_grab(impl, worker, fairness);
+
+    // pull it from the local deque
+    if (!job) job = tb_thread_pool_stealing_deque_pop(worker);
+
+    // grab the waiting jobs from the global
+    if (!job && tb_atomic_get_explicit(&impl->jobs_global, TB_ATOMIC_ACQUIRE) > 0)
+        job = tb_thread_pool_stealing_grab(impl, worker, tb_true);
+
+    // steal jobs from the other workers
+    if (!job) job = tb_thread_pool_stealing_steal(impl, worker);
+
+    // ok?
+    return job;
+}
+static tb_int_t tb_thread_pool_stealing_loop(tb_cpointer_t priv)
+{
+    // the worker
+    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)priv;
+
+    // trace
+    tb_trace_d("worker[%lu]: init", worker? worker->id : -1);
+
+    // done
+    do
+    {
+        // check
+        tb_assert_and_check_break(worker && worker->deque);
+
+        // the pool
+        tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+        tb_assert_and_check_break(impl && impl->semaphore);
+
+        // bind the current worker
+#ifdef __tb_thread_local__
+        g_worker_self = worker;
+#else
+        if (!tb_thread_local_init(&g_worker_self, tb_null)) break;
+        tb_thread_local_set(&g_worker_self, worker);
+#endif
+
+        // loop
+        while (1)
+        {
+            /* killed? we need check it before pulling jobs,
+             * all remaining jobs will be killed before exiting
+             */
+            tb_bool_t stoped = tb_atomic_flag_test_explicit(&worker->bstoped, TB_ATOMIC_ACQUIRE);
+
+            // pull and done a job
+            tb_thread_pool_job_t* job = tb_thread_pool_stealing_pull(impl, worker);
+            if (job)
+            {
+                tb_thread_pool_stealing_job_done(impl, worker, job);
+                continue;
+            }
+
+            // no more jobs after killing?
+            tb_check_break(!stoped);
+
+            // be idle now, we need check jobs again to avoid missing the wakeup
+            tb_atomic_fetch_and_add(&impl->worker_idle, 1);
+            tb_memory_barrier();
+            if (    (job = tb_thread_pool_stealing_pull(impl, worker))
+                ||  tb_atomic_flag_test_explicit(&worker->bstoped, TB_ATOMIC_ACQUIRE))
+            {
+                tb_atomic_fetch_and_sub(&impl->worker_idle, 1);
+                if (job) tb_thread_pool_stealing_job_done(impl, worker, job);
+                continue;
+            }
+
+            // trace
+            tb_trace_d("worker[%lu]: wait: ..", worker->id);
+
+            // wait some time
+            tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
+            tb_atomic_fetch_and_sub(&impl->worker_idle, 1);
+            tb_assert_and_check_break(wait > 0);
+
+            // trace
+            tb_trace_d("worker[%lu]: wait: ok", worker->id);
+        }
+
+    } while (0);
+
+    // exit worker
+    if (worker)
+    {
+        // trace
+        tb_trace_d("worker[%lu]: exit", worker->id);
+
+        // stop it
+        tb_atomic_flag_test_and_set_explicit(&worker->bstoped, TB_ATOMIC_RELAXED);
+
+        // exit all private data
+        tb_size_t i = 0;
+        tb_size_t n = tb_arrayn(worker->priv);
+        for (i = 0; i < n; i++)
+        {
+            // the private data
+            tb_thread_pool_worker_priv_t* priv = &worker->priv[n - i - 1];
+
+            // exit it
+            if (priv->exit) priv->exit((tb_thread_pool_worker_ref_t)worker, priv->priv);
+
+            // clear it
+            priv->exit = tb_null;
+            priv->priv = tb_null;
+        }
+
+        // unbind the current worker
+#ifdef __tb_thread_local__
+        g_worker_self = tb_null;
+#else
+        tb_thread_local_set(&g_worker_self, tb_null);
+#endif
+    }
+
+    // exit
+    return 0;
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_post_task(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task, tb_size_t refn)
+{
+    // check
+    tb_assert_and_check_return_val(impl && task && task->done, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_thread_pool_job_t*   job = tb_null;
+    do
+    {
+        // make job
+        job = tb_malloc0_type(tb_thread_pool_job_t);
+        tb_assert_and_check_break(job);
+
+        // init job
+        tb_atomic32_init(&job->refn, (tb_int32_t)refn);
+        tb_atomic32_init(&job->state, TB_STATE_WAITING);
+        job->task   = *task;
+        job->epoch  = (tb_size_t)tb_atomic_get_explicit(&impl->jobs_epoch, TB_ATOMIC_ACQUIRE);
+
+        // jobs count++
+        tb_atomic_fetch_and_add(&impl->jobs_count, 1);
+
+        // post the non-urgent job to the local deque if we are in the worker of this pool
+        tb_thread_pool_worker_t* worker = tb_thread_pool_stealing_self();
+        if (    !task->urgent && worker && worker->pool == (tb_thread_pool_ref_t)impl
+            &&  !tb_atomic_flag_test_explicit(&worker->bstoped, TB_ATOMIC_ACQUIRE)
+            &&  tb_thread_pool_stealing_deque_push(worker, job))
+        {
+            ok = tb_true;
+            break;
+        }
+
+        // enter
+        tb_spinlock_enter(&impl->lock);
+
+        // post it to the global jobs
+        if (!impl->bstoped && tb_list_entry_size(&impl->jobs_waiting) + tb_list_entry_size(&impl->jobs_urgent) + 1 < TB_THREAD_POOL_JOBS_WAITING_MAXN)
+        {
+            tb_list_entry_insert_tail(task->urgent? &impl->jobs_urgent : &impl->jobs_waiting, &job->entry);
+            tb_atomic_fetch_and_add(&impl->jobs_global, 1);
+            ok = tb_true;
+        }
+
+        // leave
+        tb_spinlock_leave(&impl->lock);
+
+    } while (0);
+
+    // ok? wake up one idle worker
+    if (ok) tb_thread_pool_stealing_wakeup(impl);
+    // failed?
+    else if (job)
+    {
+        // exit it
+        tb_atomic_fetch_and_sub(&impl->jobs_count, 1);
+        tb_free(job);
+        job = tb_null;
+    }
+
+    // trace
+    tb_trace_d("task[%p:%s]: post: %s", task->done, task->name, ok? "ok" : "failed");
+
+    // ok?
+    return job;
+}
+static tb_void_t tb_thread_pool_stealing_exit(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // kill and exit all remaining jobs in the global jobs, e.g. the worker has been not started
+    while (tb_list_entry_size(&impl->jobs_urgent) || tb_list_entry_size(&impl->jobs_waiting))
+    {
+        tb_list_entry_head_ref_t jobs = tb_list_entry_size(&impl->jobs_urgent)? &impl->jobs_urgent : &impl->jobs_waiting;
+        tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)tb_list_entry(jobs, tb_list_entry_head(jobs));
+        tb_list_entry_remove_head(jobs);
+        tb_atomic32_fetch_and_cmpset(&job->state, TB_STATE_WAITING, TB_STATE_KILLED);
+        tb_thread_pool_stealing_job_exit(tb_null, job);
+    }
+
+    // exit all worker deques
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(impl->worker_list); i++)
+    {
+        // the worker
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+        tb_check_continue(worker->deque);
+
+        // kill and exit all remaining jobs
+        tb_thread_pool_job_t* job = tb_null;
+        while ((job = tb_thread_pool_stealing_deque_pop(worker)))
+        {
+            tb_atomic32_fetch_and_cmpset(&job->state, TB_STATE_WAITING, TB_STATE_KILLED);
+            tb_thread_pool_stealing_job_exit(tb_null, job);
+        }
+
+        // exit the deque
+        tb_free(worker->deque);
+        worker->deque = tb_null;
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -752,6 +1298,13 @@ tb_thread_pool_ref_t tb_thread_pool()
 }
 tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
 {
+    return tb_thread_pool_init_with_mode(worker_maxn, stack, TB_THREAD_POOL_MODE_NORMAL);
+}
+tb_thread_pool_ref_t tb_thread_pool_init_with_mode(tb_size_t worker_maxn, tb_size_t stack, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(mode == TB_THREAD_POOL_MODE_NORMAL || mode == TB_THREAD_POOL_MODE_STEALING, tb_null);
+
     // done
     tb_bool_t               ok = tb_false;
     tb_thread_pool_impl_t*  impl = tb_null;
@@ -764,10 +1317,13 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
         // init lock
         if (!tb_spinlock_init(&impl->lock)) break;
 
-        // computate the default worker maxn if be zero
-        if (!worker_maxn) worker_maxn = tb_cpu_count() << 2;
+        // computate the default worker maxn if be zero, the stealing workers are always busy and need not more than cpu count
+        if (!worker_maxn) worker_maxn = mode == TB_THREAD_POOL_MODE_STEALING? tb_cpu_count() : (tb_cpu_count() << 2);
         tb_assert_and_check_break(worker_maxn);
 
+        // init mode
+        impl->mode          = mode;
+
         // init thread stack
         impl->stack         = stack;
 
@@ -797,6 +1353,49 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
         tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&impl->lock, TB_TRACE_MODULE_NAME);
 #endif
 
+        // init all stealing workers now, each worker has a local job deque
+        if (mode == TB_THREAD_POOL_MODE_STEALING)
+        {
+            // init jobs count
+            tb_atomic_init(&impl->jobs_count, 0);
+            tb_atomic_init(&impl->jobs_global, 0);
+            tb_atomic_init(&impl->jobs_epoch, 0);
+            tb_atomic_init(&impl->worker_idle, 0);
+
+            // init workers
+            tb_size_t i = 0;
+            tb_size_t n = tb_min(worker_maxn, TB_THREAD_POOL_WORKER_MAXN);
+            for (i = 0; i < n; i++)
+            {
+                // the worker
+                tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+                // init worker
+                tb_atomic_flag_clear_explicit(&worker->bstoped, TB_ATOMIC_RELAXED);
+                tb_atomic_init(&worker->deque_top, 0);
+                tb_atomic_init(&worker->deque_bottom, 0);
+                worker->id          = i;
+                worker->pool        = (tb_thread_pool_ref_t)impl;
+                worker->seed        = i + 1;
+                worker->deque       = tb_nalloc0_type(TB_THREAD_POOL_JOBS_DEQUE_MAXN, tb_atomic_t);
+                tb_assert_and_check_break(worker->deque);
+            }
+            tb_assert_and_check_break(i == n);
+
+            // update the worker size before starting them, the thieves need it
+            impl->worker_size   = n;
+            impl->worker_maxn   = n;
+
+            // start workers
+            for (i = 0; i < n; i++)
+            {
+                tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+                worker->loop = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_stealing_loop, worker, impl->stack);
+                tb_assert_and_check_break(worker->loop);
+            }
+            tb_assert_and_check_break(i == n);
+        }
+
         // ok
         ok = tb_true;
 
@@ -864,6 +1463,10 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
     // enter
     tb_spinlock_enter(&impl->lock);
 
+    // exit all stealing jobs and deques
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+        tb_thread_pool_stealing_exit(impl);
+
     // exit pending jobs
     tb_list_entry_exit(&impl->jobs_pending);
 
@@ -921,7 +1524,8 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
         for (i = 0; i < n; i++) tb_atomic_flag_test_and_set_explicit(&impl->worker_list[i].bstoped, TB_ATOMIC_RELAXED);
 
         // kill all jobs
-        if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+        if (impl->mode == TB_THREAD_POOL_MODE_STEALING) tb_atomic_fetch_and_add(&impl->jobs_epoch, 1);
+        else if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
 
         // post it
         post = impl->worker_size;
@@ -976,6 +1580,10 @@ tb_size_t tb_thread_pool_task_size(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl, 0);
 
+    // the stealing mode? get the task size without lock
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+        return (tb_size_t)tb_atomic_get(&impl->jobs_count);
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -994,6 +1602,21 @@ tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* n
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_false);
 
+    // the stealing mode?
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        // init task
+        tb_thread_pool_task_t task = {0};
+        task.name       = name;
+        task.done       = done;
+        task.exit       = exit;
+        task.priv       = priv;
+        task.urgent     = urgent;
+
+        // post task
+        return tb_thread_pool_stealing_post_task(impl, &task, 1)? tb_true : tb_false;
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1039,6 +1662,19 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && list, 0);
 
+    // the stealing mode?
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        tb_size_t ok = 0;
+        for (ok = 0; ok < size; ok++)
+        {
+            // post task
+            tb_thread_pool_job_t* job = tb_thread_pool_stealing_post_task(impl, &list[ok], 1);
+            tb_check_break(job);
+        }
+        return ok;
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1072,6 +1708,21 @@ tb_thread_pool_task_ref_t tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_null);
 
+    // the stealing mode?
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        // init task
+        tb_thread_pool_task_t task = {0};
+        task.name       = name;
+        task.done       = done;
+        task.exit       = exit;
+        task.priv       = priv;
+        task.urgent     = urgent;
+
+        // post task, the task handle holds one reference
+        return (tb_thread_pool_task_ref_t)tb_thread_pool_stealing_post_task(impl, &task, 2);
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1135,6 +1786,13 @@ tb_void_t tb_thread_pool_task_kill_all(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return(impl);
 
+    // the stealing mode? kill all jobs posted before the new epoch
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        tb_atomic_fetch_and_add(&impl->jobs_epoch, 1);
+        return ;
+    }
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -1179,6 +1837,18 @@ tb_long_t tb_thread_pool_task_wait_all(tb_thread_pool_ref_t pool, tb_long_t time
     tb_hong_t time = tb_cache_time_spak();
     while ((timeout < 0 || tb_cache_time_spak() < time + timeout))
     {
+        // the stealing mode?
+        if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+        {
+            // the jobs count
+            size = (tb_size_t)tb_atomic_get(&impl->jobs_count);
+            tb_check_break(size);
+
+            // wait some time
+            tb_msleep(size > impl->worker_size? 200 : 10);
+            continue;
+        }
+
         // enter
         tb_spinlock_enter(&impl->lock);
 
@@ -1222,6 +1892,13 @@ tb_void_t tb_thread_pool_task_exit(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     // kill it first
     tb_thread_pool_task_kill(pool, task);
 
+    // the stealing mode? refn--, and free it if the worker has released it
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        if (tb_atomic32_fetch_and_sub(&job->refn, 1) == 1) tb_free(job);
+        return ;
+    }
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -1266,7 +1943,7 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
         tb_trace_i("");
 
         // dump all jobs
-        if (impl->jobs_pool)
+        if (impl->jobs_pool && impl->mode == TB_THREAD_POOL_MODE_NORMAL)
         {
             // trace
             tb_trace_i("jobs: size: %lu", tb_fixed_pool_size(impl->jobs_pool));
@@ -1274,6 +1951,16 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
             // dump jobs
             tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_dump_all, tb_null);
         }
+        // dump the stealing jobs
+        else if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+        {
+            // trace
+            tb_trace_i("jobs: size: %lu, global: %ld, epoch: %ld, idle: %ld", (tb_size_t)tb_atomic_get(&impl->jobs_count), tb_atomic_get(&impl->jobs_global), tb_atomic_get(&impl->jobs_epoch), tb_atomic_get(&impl->worker_idle));
+
+            // dump the local jobs
+            for (i = 0; i < impl->worker_size; i++)
+                tb_trace_i("    worker: id: %lu, local jobs: %ld", i, impl->worker_list[i].deque? tb_thread_pool_stealing_deque_size(&impl->worker_list[i]) : 0);
+        }
     }
 
     // leave
@@ -47,6 +47,14 @@ __tb_extern_c_enter__
  * types
  */
 
+/// the thread pool mode enum
+typedef enum __tb_thread_pool_mode_e
+{
+    TB_THREAD_POOL_MODE_NORMAL          = 0     //!< all workers pull jobs from the global job lists
+,   TB_THREAD_POOL_MODE_STEALING        = 1     //!< each worker has a lock-free job deque and steals jobs from others if be idle
+
+}tb_thread_pool_mode_e;
+
 /// the thread pool ref type
 typedef __tb_typeref__(thread_pool);
 
@@ -104,6 +112,24 @@ tb_thread_pool_ref_t        tb_thread_pool(tb_noarg_t);
  */
 tb_thread_pool_ref_t        tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack);
 
+/*! init thread pool with the given mode
+ *
+ * the stealing mode is more scalable for many cpu cores and many small tasks.
+ *
+ * - all workers are started at once and each worker has a lock-free job deque (Chase-Lev)
+ * - the tasks posted from the worker threads are pushed to the local deque of the current worker
+ * - the tasks posted from the other threads are pushed to the global job lists
+ * - the idle worker will steal the half jobs of the other workers
+ * - the urgent tasks are always pushed to the global urgent job list and will be done first
+ *
+ * @param worker_maxn       the thread worker max count, using the default count
+ * @param stack             the thread stack, using the default stack size if be zero
+ * @param mode              the thread pool mode, e.g. TB_THREAD_POOL_MODE_STEALING
+ *
+ * @return                  the thread pool
+ */
+tb_thread_pool_ref_t        tb_thread_pool_init_with_mode(tb_size_t worker_maxn, tb_size_t stack, tb_size_t mode);
+
 /*! exit thread pool
  *
  * @param pool              the thread pool
@@ -35,6 +35,35 @@
 #include "../algorithm/algorithm.h"
 #include "../utils/utils.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the root level bits of the timer wheel, 256 slots of 1ms
+#define TB_TIMER_WHEEL_ROOT_BITS            (8)
+#define TB_TIMER_WHEEL_ROOT_SIZE            (1 << TB_TIMER_WHEEL_ROOT_BITS)
+#define TB_TIMER_WHEEL_ROOT_MASK            (TB_TIMER_WHEEL_ROOT_SIZE - 1)
+
+// the node level bits of the timer wheel, 64 slots for each level
+#define TB_TIMER_WHEEL_NODE_BITS            (6)
+#define TB_TIMER_WHEEL_NODE_SIZE            (1 << TB_TIMER_WHEEL_NODE_BITS)
+#define TB_TIMER_WHEEL_NODE_MASK            (TB_TIMER_WHEEL_NODE_SIZE - 1)
+
+// the level count of the timer wheel, 8 + 6 * 4 bits: about 49 days
+#define TB_TIMER_WHEEL_LEVELS               (5)
+
+// the slot count of the timer wheel
+#define TB_TIMER_WHEEL_SLOT_MAXN            (TB_TIMER_WHEEL_ROOT_SIZE + TB_TIMER_WHEEL_NODE_SIZE * (TB_TIMER_WHEEL_LEVELS - 1))
+
+// the max delay of the timer wheel, the further tasks will be cascaded again
+#define TB_TIMER_WHEEL_DELAY_MAXN           ((tb_hong_t)1 << (TB_TIMER_WHEEL_ROOT_BITS + TB_TIMER_WHEEL_NODE_BITS * (TB_TIMER_WHEEL_LEVELS - 1)))
+
+// the slot shift of the given level
+#define tb_timer_wheel_shift(level)         ((level)? TB_TIMER_WHEEL_ROOT_BITS + TB_TIMER_WHEEL_NODE_BITS * ((level) - 1) : 0)
+
+// the slot offset of the given level
+#define tb_timer_wheel_offset(level)        ((level)? TB_TIMER_WHEEL_ROOT_SIZE + TB_TIMER_WHEEL_NODE_SIZE * ((level) - 1) : 0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -63,8 +92,31 @@ typedef struct __tb_timer_task_t
     // the refn, <= 2
     tb_uint32_t                 refn    : 2;
 
+    // the slot entry, only for the wheel mode
+    tb_list_entry_t             entry;
+
+    // the slot, only for the wheel mode
+    tb_list_entry_head_ref_t    slot;
+
 }tb_timer_task_t;
 
+// the timer wheel type
+typedef struct __tb_timer_wheel_t
+{
+    // the base time, all ticks before it have been expired
+    tb_hong_t                   base;
+
+    // the expired tasks
+    tb_list_entry_head_t        expired;
+
+    // the non-empty slots bitmap
+    tb_uint64_t                 bits[TB_TIMER_WHEEL_SLOT_MAXN >> 6];
+
+    // the slots, level0: [0, 256), level1: [256, 320), ...
+    tb_list_entry_head_t        slots[TB_TIMER_WHEEL_SLOT_MAXN];
+
+}tb_timer_wheel_t;
+
 /// the timer type
 typedef struct __tb_timer_t
 {
@@ -86,9 +138,12 @@ typedef struct __tb_timer_t
     // the pool
     tb_fixed_pool_ref_t         pool;
 
-    // the heap
+    // the heap, only for the heap mode
     tb_heap_ref_t               heap;
 
+    // the wheel, only for the wheel mode
+    tb_timer_wheel_t*           wheel;
+
     // the event
     tb_event_ref_t              event;
 
@@ -125,6 +180,185 @@ static tb_bool_t tb_timer_pred_by_task(tb_iterator_ref_t iterator, tb_cpointer_t
     // is equal?
     return item == value;
 }
+static tb_void_t tb_timer_wheel_init(tb_timer_wheel_t* wheel, tb_hong_t now)
+{
+    // check
+    tb_assert(wheel);
+
+    // init base time
+    wheel->base = now;
+
+    // init bitmap
+    tb_memset(wheel->bits, 0, sizeof(wheel->bits));
+
+    // init expired tasks
+    tb_list_entry_init(&wheel->expired, tb_timer_task_t, entry, tb_null);
+
+    // init slots
+    tb_size_t i = 0;
+    for (i = 0; i < TB_TIMER_WHEEL_SLOT_MAXN; i++)
+        tb_list_entry_init(&wheel->slots[i], tb_timer_task_t, entry, tb_null);
+}
+static tb_long_t tb_timer_wheel_find(tb_timer_wheel_t* wheel, tb_size_t from, tb_size_t to)
+{
+    // find the first non-empty slot in [from, to)
+    while (from < to)
+    {
+        // the bits of the current word
+        tb_uint64_t bits = wheel->bits[from >> 6] >> (from & 63);
+        if (bits)
+        {
+            tb_size_t index = from + tb_bits_cl0_u64_le(bits);
+            return index < to? (tb_long_t)index : -1;
+        }
+
+        // the next word
+        from = (from + 64) & ~63;
+    }
+    return -1;
+}
+static tb_void_t tb_timer_wheel_add(tb_timer_wheel_t* wheel, tb_timer_task_t* timer_task)
+{
+    // check
+    tb_assert(wheel && timer_task && !timer_task->slot);
+
+    // expired now?
+    tb_list_entry_head_ref_t slot = tb_null;
+    if (timer_task->when < wheel->base) slot = &wheel->expired;
+    else
+    {
+        // the when, we cascade the further task again if it exceeds the max delay
+        tb_hong_t when = timer_task->when;
+        if (when - wheel->base >= TB_TIMER_WHEEL_DELAY_MAXN) when = wheel->base + TB_TIMER_WHEEL_DELAY_MAXN - 1;
+
+        // hash it to the slot of the given level
+        tb_size_t index;
+        tb_size_t level = 0;
+        tb_hong_t delta = when - wheel->base;
+        if (delta < TB_TIMER_WHEEL_ROOT_SIZE) index = (tb_size_t)(when & TB_TIMER_WHEEL_ROOT_MASK);
+        else
+        {
+            for (level = 1; level < TB_TIMER_WHEEL_LEVELS - 1 && delta >= ((tb_hong_t)1 << tb_timer_wheel_shift(level + 1)); level++) ;
+            index = tb_timer_wheel_offset(level) + (tb_size_t)((when >> tb_timer_wheel_shift(level)) & TB_TIMER_WHEEL_NODE_MASK);
+        }
+
+        // mark this slot
+        wheel->bits[index >> 6] |= ((tb_uint64_t)1 << (index & 63));
+        slot = &wheel->slots[index];
+    }
+
+    // add it to the slot
+    tb_list_entry_insert_tail(slot, &timer_task->entry);
+    timer_task->slot = slot;
+}
+static tb_void_t tb_timer_wheel_del(tb_timer_wheel_t* wheel, tb_timer_task_t* timer_task)
+{
+    // check
+    tb_assert(wheel && timer_task && timer_task->slot);
+
+    // remove it from the slot
+    tb_list_entry_head_ref_t slot = timer_task->slot;
+    tb_list_entry_remove(slot, &timer_task->entry);
+    timer_task->slot = tb_null;
+
+    // clear the empty slot
+    if (slot != &wheel->expired && !tb_list_entry_size(slot))
+    {
+        tb_size_t index = slot - wheel->slots;
+        wheel->bits[index >> 6] &= ~((tb_uint64_t)1 << (index & 63));
+    }
+}
+static tb_size_t tb_timer_wheel_cascade(tb_timer_wheel_t* wheel, tb_size_t level)
+{
+    // the slot of the current round
+    tb_size_t index = (tb_size_t)((wheel->base >> tb_timer_wheel_shift(level)) & TB_TIMER_WHEEL_NODE_MASK);
+    tb_list_entry_head_ref_t slot = &wheel->slots[tb_timer_wheel_offset(level) + index];
+
+    // re-hash all tasks to the lower levels
+    while (tb_list_entry_size(slot))
+    {
+        tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_list_entry(slot, tb_list_entry_head(slot));
+        tb_timer_wheel_del(wheel, timer_task);
+        tb_timer_wheel_add(wheel, timer_task);
+    }
+
+    // return the slot index, the higher level need be cascaded if it is zero
+    return index;
+}
+static tb_void_t tb_timer_wheel_spak(tb_timer_wheel_t* wheel, tb_hong_t now)
+{
+    // move all expired tasks before now to the expired list
+    while (wheel->base <= now)
+    {
+        // the root level wraps? cascade the higher levels lazily
+        tb_size_t index = (tb_size_t)(wheel->base & TB_TIMER_WHEEL_ROOT_MASK);
+        if (!index)
+        {
+            tb_size_t level = 1;
+            while (level < TB_TIMER_WHEEL_LEVELS && !tb_timer_wheel_cascade(wheel, level)) level++;
+        }
+
+        // expired?
+        tb_list_entry_head_ref_t slot = &wheel->slots[index];
+        if (tb_list_entry_size(slot))
+        {
+            while (tb_list_entry_size(slot))
+            {
+                tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_list_entry(slot, tb_list_entry_head(slot));
+                tb_timer_wheel_del(wheel, timer_task);
+                tb_list_entry_insert_tail(&wheel->expired, &timer_task->entry);
+                timer_task->slot = &wheel->expired;
+            }
+            wheel->base++;
+            continue;
+        }
+
+        // skip the empty slots until the next non-empty slot or the next round
+        tb_long_t next = tb_timer_wheel_find(wheel, index + 1, TB_TIMER_WHEEL_ROOT_SIZE);
+        tb_hong_t base = next >= 0? wheel->base - index + next : (wheel->base | TB_TIMER_WHEEL_ROOT_MASK) + 1;
+        wheel->base = tb_min(base, now + 1);
+    }
+}
+static tb_hong_t tb_timer_wheel_top(tb_timer_wheel_t* wheel)
+{
+    // exists expired tasks?
+    tb_check_return_val(!tb_list_entry_size(&wheel->expired), wheel->base - 1);
+
+    // find it from the root level, the slots before the current index are in the next round
+    tb_hong_t base  = wheel->base;
+    tb_size_t index = (tb_size_t)(base & TB_TIMER_WHEEL_ROOT_MASK);
+    tb_long_t next  = tb_timer_wheel_find(wheel, index, TB_TIMER_WHEEL_ROOT_SIZE);
+    if (next >= 0) return base - index + next;
+
+    /* the slots before the current index are in the next round,
+     * but the tasks of the higher levels may be cascaded and expired before them
+     */
+    tb_hong_t when  = -1;
+    if ((next = tb_timer_wheel_find(wheel, 0, index)) >= 0) when = base - index + TB_TIMER_WHEEL_ROOT_SIZE + next;
+
+    /* find the nearest cascading time of the higher levels
+     *
+     * the tasks will be not expired before cascading, so it's the lower bound of the top when
+     */
+    tb_size_t level = 1;
+    for (level = 1; level < TB_TIMER_WHEEL_LEVELS; level++)
+    {
+        tb_size_t shift     = tb_timer_wheel_shift(level);
+        tb_size_t offset    = tb_timer_wheel_offset(level);
+        tb_size_t current   = (tb_size_t)((base >> shift) & TB_TIMER_WHEEL_NODE_MASK);
+        tb_size_t distance  = 0;
+        if ((next = tb_timer_wheel_find(wheel, offset + current + 1, offset + TB_TIMER_WHEEL_NODE_SIZE)) >= 0)
+            distance = next - offset - current;
+        else if ((next = tb_timer_wheel_find(wheel, offset, offset + current + 1)) >= 0)
+            distance = next - offset + TB_TIMER_WHEEL_NODE_SIZE - current;
+        if (distance)
+        {
+            tb_hong_t cascade = ((base >> shift) + distance) << shift;
+            if (when < 0 || cascade < when) when = cascade;
+        }
+    }
+    return when;
+}
 static tb_int_t tb_timer_instance_loop(tb_cpointer_t priv)
 {
     // timer
@@ -210,6 +444,13 @@ tb_timer_ref_t tb_timer()
 }
 tb_timer_ref_t tb_timer_init(tb_size_t grow, tb_bool_t ctime)
 {
+    return tb_timer_init_with_mode(grow, ctime, TB_TIMER_MODE_HEAP);
+}
+tb_timer_ref_t tb_timer_init_with_mode(tb_size_t grow, tb_bool_t ctime, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(mode == TB_TIMER_MODE_HEAP || mode == TB_TIMER_MODE_WHEEL, tb_null);
+
     // done
     tb_bool_t   ok = tb_false;
     tb_timer_t* timer = tb_null;
@@ -235,9 +476,21 @@ tb_timer_ref_t tb_timer_init(tb_size_t grow, tb_bool_t ctime)
         timer->pool         = tb_fixed_pool_init(tb_null, timer->grow, sizeof(tb_timer_task_t), tb_null, tb_null, tb_null);
         tb_assert_and_check_break(timer->pool);
 
+        // init wheel
+        if (mode == TB_TIMER_MODE_WHEEL)
+        {
+            timer->wheel    = tb_malloc0_type(tb_timer_wheel_t);
+            tb_assert_and_check_break(timer->wheel);
+
+            // init the base time
+            tb_timer_wheel_init(timer->wheel, tb_timer_now(timer));
+        }
         // init heap
-        timer->heap         = tb_heap_init(timer->grow, element);
-        tb_assert_and_check_break(timer->heap);
+        else
+        {
+            timer->heap     = tb_heap_init(timer->grow, element);
+            tb_assert_and_check_break(timer->heap);
+        }
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -285,6 +538,10 @@ tb_void_t tb_timer_exit(tb_timer_ref_t self)
     if (timer->heap) tb_heap_exit(timer->heap);
     timer->heap = tb_null;
 
+    // exit wheel
+    if (timer->wheel) tb_free(timer->wheel);
+    timer->wheel = tb_null;
+
     // exit pool
     if (timer->pool) tb_fixed_pool_exit(timer->pool);
     timer->pool = tb_null;
@@ -331,6 +588,9 @@ tb_void_t tb_timer_clear(tb_timer_ref_t self)
         // clear heap
         if (timer->heap) tb_heap_clear(timer->heap);
 
+        // clear wheel
+        if (timer->wheel) tb_timer_wheel_init(timer->wheel, tb_timer_now(timer));
+
         // clear pool
         if (timer->pool) tb_fixed_pool_clear(timer->pool);
 
@@ -342,7 +602,7 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer && (timer->heap || timer->wheel), -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_flag_test_explicit(&timer->stop, TB_ATOMIC_RELAXED), -1);
@@ -352,7 +612,8 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
 
     // done
     tb_hize_t when = -1;
-    if (tb_heap_size(timer->heap))
+    if (timer->wheel) when = (tb_hize_t)tb_timer_wheel_top(timer->wheel);
+    else if (tb_heap_size(timer->heap))
     {
         // the task
         tb_timer_task_t const* timer_task = (tb_timer_task_t const*)tb_heap_top(timer->heap);
@@ -369,7 +630,7 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer && (timer->heap || timer->wheel), -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_flag_test_explicit(&timer->stop, TB_ATOMIC_RELAXED), -1);
@@ -379,7 +640,20 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
 
     // done
     tb_size_t delay = -1;
-    if (tb_heap_size(timer->heap))
+    if (timer->wheel)
+    {
+        // the top when
+        tb_hong_t when = tb_timer_wheel_top(timer->wheel);
+        if (when >= 0)
+        {
+            // the now
+            tb_hong_t now = tb_timer_now(timer);
+
+            // the delay
+            delay = when > now? (tb_size_t)(when - now) : 0;
+        }
+    }
+    else if (tb_heap_size(timer->heap))
     {
         // the task
         tb_timer_task_t const* timer_task = (tb_timer_task_t const*)tb_heap_top(timer->heap);
@@ -399,15 +673,91 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
     // ok?
     return delay;
 }
+static tb_bool_t tb_timer_spak_wheel(tb_timer_t* timer)
+{
+    // check
+    tb_assert(timer && timer->pool && timer->wheel);
+
+    // enter
+    tb_spinlock_enter(&timer->lock);
+
+    // move all expired tasks to the expired list
+    tb_hong_t now = tb_timer_now(timer);
+    tb_timer_wheel_spak(timer->wheel, now);
+
+    // only done the current expired tasks, the new expired tasks will be done at the next spak
+    tb_size_t count = tb_list_entry_size(&timer->wheel->expired);
+
+    // leave
+    tb_spinlock_leave(&timer->lock);
+
+    // done all expired tasks
+    while (count--)
+    {
+        // enter
+        tb_spinlock_enter(&timer->lock);
+
+        // done
+        tb_timer_task_func_t    func = tb_null;
+        tb_cpointer_t           priv = tb_null;
+        tb_bool_t               killed = tb_false;
+        if (tb_list_entry_size(&timer->wheel->expired))
+        {
+            // pop the expired task
+            tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_list_entry(&timer->wheel->expired, tb_list_entry_head(&timer->wheel->expired));
+            tb_timer_wheel_del(timer->wheel, timer_task);
+
+            // check refn
+            tb_assert(timer_task->refn);
+
+            // save func and data for calling it later
+            func = timer_task->func;
+            priv = timer_task->priv;
+
+            // killed?
+            killed = timer_task->killed? tb_true : tb_false;
+
+            // repeat?
+            if (timer_task->repeat)
+            {
+                // update when
+                timer_task->when = now + timer_task->period;
+
+                // continue timer_task
+                tb_timer_wheel_add(timer->wheel, timer_task);
+            }
+            else
+            {
+                // refn--
+                if (timer_task->refn > 1) timer_task->refn--;
+                // remove it from pool directly
+                else tb_fixed_pool_free(timer->pool, timer_task);
+            }
+        }
+        else count = 0;
+
+        // leave
+        tb_spinlock_leave(&timer->lock);
+
+        // done func
+        if (func) func(killed, priv);
+    }
+
+    // ok
+    return tb_true;
+}
 tb_bool_t tb_timer_spak(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap, tb_false);
+    tb_assert_and_check_return_val(timer && timer->pool && (timer->heap || timer->wheel), tb_false);
 
     // stoped?
     tb_check_return_val(!tb_atomic_flag_test_explicit(&timer->stop, TB_ATOMIC_RELAXED), tb_false);
 
+    // spak the wheel, all expired tasks will be done at once
+    if (timer->wheel) return tb_timer_spak_wheel(timer);
+
     // enter
     tb_spinlock_enter(&timer->lock);
 
@@ -534,7 +884,7 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap && func, tb_null);
+    tb_assert_and_check_return_val(timer && timer->pool && (timer->heap || timer->wheel) && func, tb_null);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_flag_test_explicit(&timer->stop, TB_ATOMIC_RELAXED), tb_null);
@@ -548,8 +898,12 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
     tb_timer_task_t*    timer_task = (tb_timer_task_t*)tb_fixed_pool_malloc0(timer->pool);
     if (timer_task)
     {
-        // the top when
-        if (tb_heap_size(timer->heap))
+        // the top when, we need not it if no timer loop
+        if (timer->wheel)
+        {
+            if (timer->event) when_top = (tb_hize_t)tb_timer_wheel_top(timer->wheel);
+        }
+        else if (tb_heap_size(timer->heap))
         {
             tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
             if (timer_task) when_top = timer_task->when;
@@ -564,7 +918,8 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
         timer_task->repeat    = repeat? 1 : 0;
 
         // add task
-        tb_heap_put(timer->heap, timer_task);
+        if (timer->wheel) tb_timer_wheel_add(timer->wheel, timer_task);
+        else tb_heap_put(timer->heap, timer_task);
 
         // the event
         event = timer->event;
@@ -602,7 +957,7 @@ tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t p
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return(timer && timer->pool && timer->heap && func);
+    tb_assert_and_check_return(timer && timer->pool && (timer->heap || timer->wheel) && func);
 
     // stoped?
     tb_assert_and_check_return(!tb_atomic_flag_test_explicit(&timer->stop, TB_ATOMIC_RELAXED));
@@ -616,8 +971,12 @@ tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t p
     tb_timer_task_t*    timer_task = (tb_timer_task_t*)tb_fixed_pool_malloc0(timer->pool);
     if (timer_task)
     {
-        // the top when
-        if (tb_heap_size(timer->heap))
+        // the top when, we need not it if no timer loop
+        if (timer->wheel)
+        {
+            if (timer->event) when_top = (tb_hize_t)tb_timer_wheel_top(timer->wheel);
+        }
+        else if (tb_heap_size(timer->heap))
         {
             tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
             if (timer_task) when_top = timer_task->when;
@@ -632,7 +991,8 @@ tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t p
         timer_task->repeat    = repeat? 1 : 0;
 
         // add task
-        tb_heap_put(timer->heap, timer_task);
+        if (timer->wheel) tb_timer_wheel_add(timer->wheel, timer_task);
+        else tb_heap_put(timer->heap, timer_task);
 
         // the event
         event = timer->event;
@@ -667,8 +1027,17 @@ tb_void_t tb_timer_task_exit(tb_timer_ref_t self, tb_timer_task_ref_t task)
     // enter
     tb_spinlock_enter(&timer->lock);
 
+    // remove it from the wheel directly
+    if (timer->wheel)
+    {
+        // remove it if it has been not expired, we need not wait it
+        if (timer_task->slot) tb_timer_wheel_del(timer->wheel, timer_task);
+
+        // remove it from pool
+        tb_fixed_pool_free(timer->pool, timer_task);
+    }
     // remove it?
-    if (timer_task->refn > 1)
+    else if (timer_task->refn > 1)
     {
         // refn--
         timer_task->refn--;
@@ -704,6 +1073,26 @@ tb_void_t tb_timer_task_kill(tb_timer_ref_t self, tb_timer_task_ref_t task)
         // expired or removed?
         tb_check_break(timer_task->refn == 2);
 
+        // the wheel mode? move it to the expired list directly
+        if (timer->wheel)
+        {
+            // remove it from the slot
+            tb_timer_wheel_del(timer->wheel, timer_task);
+
+            // killed and no repeat
+            timer_task->killed = 1;
+            timer_task->repeat = 0;
+            timer_task->when = tb_timer_now(timer);
+
+            // add it to the expired list
+            tb_list_entry_insert_tail(&timer->wheel->expired, &timer_task->entry);
+            timer_task->slot = &timer->wheel->expired;
+
+            // the event
+            event = timer->event;
+            break;
+        }
+
         // find it
         tb_size_t itor = tb_find_all_if(timer->heap, tb_timer_pred_by_task, timer_task);
         tb_assert_and_check_break(itor != tb_iterator_tail(timer->heap));
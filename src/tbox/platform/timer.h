@@ -36,6 +36,14 @@ __tb_extern_c_enter__
  * types
  */
 
+/// the timer mode enum
+typedef enum __tb_timer_mode_e
+{
+    TB_TIMER_MODE_HEAP          = 0     //!< all tasks are sorted by the min-heap, post/kill: O(log n)
+,   TB_TIMER_MODE_WHEEL         = 1     //!< all tasks are hashed into the hierarchical timing wheel, post/exit/kill: O(1)
+
+}tb_timer_mode_e;
+
 /*! the timer task func type
  *
  * @param killed    is killed?
@@ -68,6 +76,23 @@ tb_timer_ref_t      tb_timer(tb_noarg_t);
  */
 tb_timer_ref_t      tb_timer_init(tb_size_t grow, tb_bool_t ctime);
 
+/*! init timer with the given mode
+ *
+ * the wheel mode is more suitable for churning many short-lived timeout tasks,
+ * e.g. arm and cancel a timeout for each socket operation in the coroutine scheduler.
+ *
+ * - the tick is 1ms, and the wheel has 5 levels (256 + 64 * 4 slots) for about 49 days
+ * - the further tasks will be cascaded into the lower level lazily when the lower level wraps
+ * - we can use an instance for each thread to avoid the lock contention
+ *
+ * @param grow      the timer grow
+ * @param ctime     using ctime?
+ * @param mode      the timer mode, e.g. TB_TIMER_MODE_WHEEL
+ *
+ * @return          the timer
+ */
+tb_timer_ref_t      tb_timer_init_with_mode(tb_size_t grow, tb_bool_t ctime, tb_size_t mode);
+
 /*! exit timer
  *
  * @param timer     the timer
@@ -0,0 +1,62 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        filemap.c
+ * @ingroup     platform
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../filemap.h"
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t tb_filemap_align()
+{
+    // the allocation granularity, e.g. 64KB
+    SYSTEM_INFO info = {0};
+    GetSystemInfo(&info);
+    return (tb_size_t)info.dwAllocationGranularity;
+}
+tb_byte_t const* tb_filemap_init(tb_file_ref_t file, tb_hize_t offset, tb_size_t size, tb_size_t advice)
+{
+    // check
+    tb_assert_and_check_return_val(file && size, tb_null);
+    tb_assert_and_check_return_val(!(offset & (tb_filemap_align() - 1)), tb_null);
+
+    // create the file mapping
+    HANDLE mapping = CreateFileMappingW((HANDLE)file, tb_null, PAGE_READONLY, 0, 0, tb_null);
+    tb_check_return_val(mapping, tb_null);
+
+    // map it, the view will keep a reference to the mapping object
+    tb_pointer_t data = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(offset >> 32), (DWORD)(offset & 0xffffffff), (SIZE_T)size);
+    CloseHandle(mapping);
+
+    // ok?
+    return (tb_byte_t const*)data;
+}
+tb_bool_t tb_filemap_exit(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // unmap it
+    return UnmapViewOfFile((LPCVOID)data)? tb_true : tb_false;
+}
@@ -747,6 +747,41 @@ tb_hong_t tb_socket_sendf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t of
     // send data
     return tb_socket_send(sock, data, read);
 }
+tb_hong_t tb_socket_recvf(tb_socket_ref_t sock, tb_file_ref_t file, tb_hize_t offset, tb_hize_t size)
+{
+    // check
+    tb_assert_and_check_return_val(sock && file && size, -1);
+
+    // recv data
+    tb_byte_t data[8192];
+    tb_long_t real = tb_socket_recv(sock, data, (tb_size_t)tb_min(size, sizeof(data)));
+    tb_check_return_val(real > 0, real);
+
+    // writ data
+    tb_long_t writ = 0;
+    while (writ < real)
+    {
+        tb_long_t ok = tb_file_pwrit(file, data + writ, real - writ, offset + writ);
+        if (ok > 0) writ += ok;
+        else break;
+    }
+
+    // ok?
+    return writ == real? real : -1;
+}
+tb_hong_t tb_socket_splice(tb_socket_ref_t sock, tb_socket_ref_t from, tb_hize_t size)
+{
+    // check
+    tb_assert_and_check_return_val(sock && from && size, -1);
+
+    // recv data
+    tb_byte_t data[8192];
+    tb_long_t real = tb_socket_recv(from, data, (tb_size_t)tb_min(size, sizeof(data)));
+    tb_check_return_val(real > 0, real);
+
+    // send data
+    return tb_socket_bsend(sock, data, real)? real : -1;
+}
 tb_long_t tb_socket_urecv(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_byte_t* data, tb_size_t size)
 {
     // check
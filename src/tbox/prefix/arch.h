@@ -154,7 +154,7 @@
 #       define TB_ARCH_ARM_THUMB
 #       define TB_ARCH_STRING_2             "_thumb"
 #   endif
-#   if defined(__ARM_NEON__)
+#   if defined(__ARM_NEON__) || defined(__ARM_NEON)
 #       define TB_ARCH_ARM_NEON
 #       define TB_ARCH_STRING_3             "_neon"
 #   endif
@@ -280,6 +280,9 @@
 #       undef TB_ARCH_STRING_2
 #       define TB_ARCH_STRING_2             "_sse3"
 #   endif
+#   if defined(__AVX2__)
+#       define TB_ARCH_AVX2
+#   endif
 #endif
 
 // vfp
@@ -146,6 +146,21 @@
 #   define __tb_unlikely__(x)                   (x)
 #endif
 
+// enable the given instruction sets for the function, e.g. __tb_target__("sse4.2,pclmul")
+#if defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)
+#   define __tb_target__(t)                     __attribute__((target(t)))
+#else
+#   define __tb_target__(t)
+#endif
+
+/* leave the avx state at the end of the __tb_target__("avx") or __tb_target__("avx2") function
+ *
+ * it clears the upper halves of the ymm registers to avoid the transition penalty of the following sse code,
+ * we need call it explicitly because gcc does not insert vzeroupper if optimizing for size (-Os).
+ * the caller need include <immintrin.h>.
+ */
+#define tb_avx_leave()                          _mm256_zeroupper()
+
 // debug
 #ifdef __tb_debug__
 #   define __tb_debug_decl__                    , tb_char_t const* func_, tb_size_t line_, tb_char_t const* file_
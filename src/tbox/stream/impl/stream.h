@@ -109,6 +109,13 @@ typedef struct __tb_stream_t
     // kill
     tb_void_t           (*kill)(tb_stream_ref_t stream);
 
+    /* map the data at the current offset, optional
+     *
+     * the stream will read and peek the mapped data directly without cache if exists,
+     * return the mapped size, zero for end or -1 for failed
+     */
+    tb_long_t           (*mmap)(tb_stream_ref_t stream, tb_byte_t** pdata, tb_size_t size);
+
 }tb_stream_t;
 
 
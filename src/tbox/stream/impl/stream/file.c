@@ -31,6 +31,13 @@
 // the file cache maxn
 #define TB_STREAM_FILE_CACHE_MAXN             TB_FILE_DIRECT_CSIZE
 
+// the file mmap window size
+#if TB_CPU_BIT64
+#   define TB_STREAM_FILE_MMAP_WINDOW         (1 << 30)
+#else
+#   define TB_STREAM_FILE_MMAP_WINDOW         (16 << 20)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -53,8 +60,30 @@ typedef struct __tb_stream_file_t
     // is stream file?
     tb_bool_t           bstream;
 
+    // the mmap mode
+    tb_size_t           mmap;
+
+    // the mapped data of the current window
+    tb_byte_t const*    map_data;
+
+    // the file offset of the current window
+    tb_hize_t           map_offset;
+
+    // the size of the current window
+    tb_size_t           map_size;
+
+    // the file size for mapping, it's zero if not be mapped
+    tb_hize_t           map_filesize;
+
 }tb_stream_file_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c_enter__
+tb_void_t tb_stream_mmap_set_(tb_stream_ref_t stream, tb_long_t (*mmap)(tb_stream_ref_t stream, tb_byte_t** pdata, tb_size_t size));
+__tb_extern_c_leave__
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -66,6 +95,68 @@ static __tb_inline__ tb_stream_file_t* tb_stream_file_cast(tb_stream_ref_t strea
     // ok?
     return (tb_stream_file_t*)stream;
 }
+static tb_long_t tb_stream_file_mmap(tb_stream_ref_t stream, tb_byte_t** pdata, tb_size_t size)
+{
+    // check
+    tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
+    tb_assert_and_check_return_val(stream_file && stream_file->file && pdata, -1);
+
+    // end?
+    tb_hize_t offset = tb_stream_offset(stream);
+    tb_check_return_val(offset < stream_file->map_filesize, 0);
+
+    // the need size
+    tb_hize_t left = stream_file->map_filesize - offset;
+    tb_size_t need = (tb_size_t)tb_min(tb_max(size, 1), left);
+
+    // not in the current window? remap it
+    if (!stream_file->map_data || offset < stream_file->map_offset || offset + need > stream_file->map_offset + stream_file->map_size)
+    {
+        // unmap the previous window
+        if (stream_file->map_data) tb_filemap_exit(stream_file->map_data, stream_file->map_size);
+        stream_file->map_data = tb_null;
+        stream_file->map_size = 0;
+
+        // the new window
+        tb_hize_t base = offset & ~(tb_hize_t)(tb_filemap_align() - 1);
+        tb_hize_t window = tb_max(TB_STREAM_FILE_MMAP_WINDOW, (offset - base) + need);
+        window = tb_min(window, stream_file->map_filesize - base);
+
+        // the advice
+        tb_size_t advice = TB_FILEMAP_ADVICE_NORMAL;
+        if (stream_file->mmap == TB_STREAM_FILE_MMAP_SEQUENTIAL) advice = TB_FILEMAP_ADVICE_SEQUENTIAL;
+        else if (stream_file->mmap == TB_STREAM_FILE_MMAP_RANDOM) advice = TB_FILEMAP_ADVICE_RANDOM;
+
+        // map it
+        stream_file->map_data = tb_filemap_init(stream_file->file, base, (tb_size_t)window, advice);
+        tb_check_return_val(stream_file->map_data, -1);
+
+        // save window
+        stream_file->map_offset = base;
+        stream_file->map_size   = (tb_size_t)window;
+    }
+
+    // save data
+    *pdata = (tb_byte_t*)stream_file->map_data + (tb_size_t)(offset - stream_file->map_offset);
+    return (tb_long_t)(stream_file->map_offset + stream_file->map_size - offset);
+}
+static tb_void_t tb_stream_file_unmap(tb_stream_ref_t stream)
+{
+    // check
+    tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
+    tb_assert_and_check_return(stream_file);
+
+    // mapped? unmap it
+    if (stream_file->map_filesize)
+    {
+        if (stream_file->map_data) tb_filemap_exit(stream_file->map_data, stream_file->map_size);
+        tb_stream_mmap_set_(stream, tb_null);
+    }
+    stream_file->map_data       = tb_null;
+    stream_file->map_offset     = 0;
+    stream_file->map_size       = 0;
+    stream_file->map_filesize   = 0;
+}
 static tb_bool_t tb_stream_file_open(tb_stream_ref_t stream)
 {
     // check
@@ -93,6 +184,16 @@ static tb_bool_t tb_stream_file_open(tb_stream_ref_t stream)
     // init offset
     stream_file->offset = 0;
 
+    // map the file data? it will fall back to the cached reading if failed
+    if (stream_file->mmap && !stream_file->bstream && !(stream_file->mode & (TB_FILE_MODE_WO | TB_FILE_MODE_RW)))
+    {
+        tb_byte_t* data = tb_null;
+        stream_file->map_filesize = tb_file_size(stream_file->file);
+        if (stream_file->map_filesize && tb_stream_file_mmap(stream, &data, 1) > 0)
+            tb_stream_mmap_set_(stream, tb_stream_file_mmap);
+        else stream_file->map_filesize = 0;
+    }
+
     // ok
     return tb_true;
 }
@@ -102,6 +203,9 @@ static tb_bool_t tb_stream_file_clos(tb_stream_ref_t stream)
     tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
     tb_assert_and_check_return_val(stream_file, tb_false);
 
+    // unmap the file data
+    tb_stream_file_unmap(stream);
+
     // exit file
     if (stream_file->file && !tb_file_exit(stream_file->file)) return tb_false;
     stream_file->file = tb_null;
@@ -169,6 +273,9 @@ static tb_bool_t tb_stream_file_seek(tb_stream_ref_t stream, tb_hize_t offset)
     // is stream file?
     tb_check_return_val(!stream_file->bstream, tb_false);
 
+    // mapped? we need only check the offset
+    if (stream_file->map_filesize) return offset <= stream_file->map_filesize;
+
     // seek
     if (tb_file_seek(stream_file->file, offset, TB_FILE_SEEK_BEG) == offset)
     {
@@ -191,7 +298,8 @@ static tb_long_t tb_stream_file_wait(tb_stream_ref_t stream, tb_size_t wait, tb_
             events |= TB_STREAM_WAIT_READ;
         else
         {
-            if (stream_file->offset < tb_file_size(stream_file->file))
+            tb_hize_t offset = stream_file->map_filesize? tb_stream_offset(stream) : stream_file->offset;
+            if (offset < tb_file_size(stream_file->file))
                 events |= TB_STREAM_WAIT_READ;
             else events = -1;
         }
@@ -257,6 +365,25 @@ static tb_bool_t tb_stream_file_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             stream_file->bstream = (tb_bool_t)tb_va_arg(args, tb_bool_t);
             return tb_true;
         }
+    case TB_STREAM_CTRL_FILE_SET_MMAP:
+        {
+            // check
+            tb_assert_and_check_return_val(tb_stream_is_closed(stream), tb_false);
+
+            // set mmap mode
+            stream_file->mmap = (tb_size_t)tb_va_arg(args, tb_size_t);
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_FILE_GET_MMAP:
+        {
+            // the pmmap
+            tb_size_t* pmmap = (tb_size_t*)tb_va_arg(args, tb_size_t*);
+            tb_assert_and_check_return_val(pmmap, tb_false);
+
+            // get mmap mode
+            *pmmap = stream_file->mmap;
+            return tb_true;
+        }
     case TB_STREAM_CTRL_FILE_GET_FILE:
         {
             // the pfile
@@ -68,6 +68,12 @@ typedef struct __tb_stream_sock_t
     // is owner of socket
     tb_uint32_t             owner : 1;
 
+    // is the connection reused from the pool?
+    tb_uint32_t             reused : 1;
+
+    // the connection pool, reuse the keep-alive connection from it
+    tb_http_pool_ref_t      pool;
+
     // the wait event
     tb_long_t               wait;
 
@@ -127,6 +133,38 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
     tb_uint16_t port = tb_ipaddr_port(addr);
     tb_assert_and_check_return_val(port, tb_false);
 
+    // tcp or udp? for url: sock://ip:port/?udp=
+    tb_char_t const* args = tb_url_args(url);
+    if (args && !tb_strnicmp(args, "udp=", 4)) stream_sock->type = TB_SOCKET_TYPE_UDP;
+    else if (args && !tb_strnicmp(args, "tcp=", 4)) stream_sock->type = TB_SOCKET_TYPE_TCP;
+
+    // attempt to reuse the idle connection from the pool, we need not lookup dns and connect it
+    stream_sock->reused = 0;
+    if (stream_sock->pool && stream_sock->owner && !stream_sock->sock && stream_sock->type == TB_SOCKET_TYPE_TCP)
+    {
+        tb_ssl_ref_t hssl = tb_null;
+        if (tb_http_pool_get(stream_sock->pool, tb_url_host(url), port, tb_url_ssl(url), &stream_sock->sock, &hssl))
+        {
+#ifdef TB_SSL_ENABLE
+            // use the opened ssl of this connection
+            if (hssl)
+            {
+                if (stream_sock->hssl) tb_ssl_exit(stream_sock->hssl);
+                stream_sock->hssl = hssl;
+                tb_ssl_set_timeout(stream_sock->hssl, tb_stream_timeout(stream));
+            }
+#endif
+
+            // trace
+            tb_trace_d("sock(%p): reuse: %s:%u", stream_sock->sock, tb_url_host(url), port);
+
+            // ok
+            stream_sock->reused = 1;
+            tb_stream_state_set(stream, TB_STATE_OK);
+            return tb_true;
+        }
+    }
+
     // no ip?
     if (tb_ipaddr_ip_is_empty(addr))
     {
@@ -142,11 +180,6 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
         tb_ipaddr_ip_set(addr, &ip_addr);
     }
 
-    // tcp or udp? for url: sock://ip:port/?udp=
-    tb_char_t const* args = tb_url_args(url);
-    if (args && !tb_strnicmp(args, "udp=", 4)) stream_sock->type = TB_SOCKET_TYPE_UDP;
-    else if (args && !tb_strnicmp(args, "tcp=", 4)) stream_sock->type = TB_SOCKET_TYPE_TCP;
-
     // exit sock first if not keep-alive
     if (!stream_sock->keep_alive && stream_sock->sock)
     {
@@ -396,14 +429,48 @@ static tb_bool_t tb_stream_sock_clos(tb_stream_ref_t stream)
     tb_stream_sock_t* stream_sock = tb_stream_sock_cast(stream);
     tb_assert_and_check_return_val(stream_sock, tb_false);
 
+    // keep alive? put the connection to the pool
+    if (    stream_sock->pool && stream_sock->keep_alive && stream_sock->owner
+        &&  stream_sock->sock && stream_sock->type == TB_SOCKET_TYPE_TCP
+        &&  !tb_stream_is_killed(stream))
+    {
+        // the url
+        tb_url_ref_t url = tb_stream_url(stream);
+        tb_bool_t    bssl = tb_url_ssl(url);
+        tb_ssl_ref_t hssl = tb_null;
+#ifdef TB_SSL_ENABLE
+        if (bssl) hssl = stream_sock->hssl;
+#endif
+
+        // put it
+        if (tb_http_pool_put(stream_sock->pool, tb_url_host(url), tb_url_port(url), bssl, stream_sock->sock, hssl))
+        {
+            // trace
+            tb_trace_d("sock(%p): keep: %s:%u", stream_sock->sock, tb_url_host(url), tb_url_port(url));
+
+            // the pool owns them now
+            stream_sock->sock = tb_null;
+#ifdef TB_SSL_ENABLE
+            if (hssl) stream_sock->hssl = tb_null;
+#endif
+
+            // clear
+            stream_sock->wait = 0;
+            stream_sock->tryn = 0;
+            stream_sock->read = 0;
+            stream_sock->writ = 0;
+            return tb_true;
+        }
+    }
+
 #ifdef TB_SSL_ENABLE
     // close ssl
     if (tb_url_ssl(tb_stream_url(stream)) && stream_sock->hssl)
         tb_ssl_close(stream_sock->hssl);
 #endif
 
-    // keep alive? not close it
-    tb_check_return_val(!stream_sock->keep_alive, tb_true);
+    // keep alive? not close it, but it has been closed if we failed to put it to the pool
+    tb_check_return_val(!stream_sock->keep_alive || stream_sock->pool, tb_true);
 
     // exit socket
     if (stream_sock->owner)
@@ -704,6 +771,35 @@ static tb_bool_t tb_stream_sock_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             stream_sock->keep_alive = keep_alive? 1 : 0;
             return tb_true;
         }
+    case TB_STREAM_CTRL_SOCK_SET_POOL:
+        {
+            // check
+            tb_assert_and_check_return_val(tb_stream_is_closed(stream), tb_false);
+
+            // set pool
+            stream_sock->pool = (tb_http_pool_ref_t)tb_va_arg(args, tb_http_pool_ref_t);
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_SOCK_GET_POOL:
+        {
+            // the ppool
+            tb_http_pool_ref_t* ppool = (tb_http_pool_ref_t*)tb_va_arg(args, tb_http_pool_ref_t*);
+            tb_assert_and_check_return_val(ppool, tb_false);
+
+            // get pool
+            *ppool = stream_sock->pool;
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_SOCK_GET_REUSED:
+        {
+            // the preused
+            tb_bool_t* preused = (tb_bool_t*)tb_va_arg(args, tb_bool_t*);
+            tb_assert_and_check_return_val(preused, tb_false);
+
+            // is reused?
+            *preused = stream_sock->reused? tb_true : tb_false;
+            return tb_true;
+        }
     case TB_STREAM_CTRL_SOCK_GET_SOCK:
         {
             // the psock
@@ -78,6 +78,16 @@ typedef enum __tb_stream_wait_e
 
 }tb_stream_wait_e;
 
+/// the file stream mmap mode enum, @see TB_STREAM_CTRL_FILE_SET_MMAP
+typedef enum __tb_stream_file_mmap_e
+{
+    TB_STREAM_FILE_MMAP_NONE        = 0     //!< read the file data to the stream cache
+,   TB_STREAM_FILE_MMAP_NORMAL      = 1     //!< map the file data as read-only
+,   TB_STREAM_FILE_MMAP_SEQUENTIAL  = 2     //!< map the file data for the sequential access
+,   TB_STREAM_FILE_MMAP_RANDOM      = 3     //!< map the file data for the random access
+
+}tb_stream_file_mmap_e;
+
 /// the stream ctrl enum
 typedef enum __tb_stream_ctrl_e
 {
@@ -108,12 +118,17 @@ typedef enum __tb_stream_ctrl_e
 ,   TB_STREAM_CTRL_FILE_SET_MODE            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 2)
 ,   TB_STREAM_CTRL_FILE_AS_STREAM           = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 3)
 ,   TB_STREAM_CTRL_FILE_GET_FILE            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 4)
+,   TB_STREAM_CTRL_FILE_SET_MMAP            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 5)
+,   TB_STREAM_CTRL_FILE_GET_MMAP            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 6)
 
     // the stream for sock
 ,   TB_STREAM_CTRL_SOCK_GET_TYPE            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 1)
 ,   TB_STREAM_CTRL_SOCK_SET_TYPE            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 2)
 ,   TB_STREAM_CTRL_SOCK_KEEP_ALIVE          = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 3)
 ,   TB_STREAM_CTRL_SOCK_GET_SOCK            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 4)
+,   TB_STREAM_CTRL_SOCK_GET_POOL            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 5)
+,   TB_STREAM_CTRL_SOCK_SET_POOL            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 6)
+,   TB_STREAM_CTRL_SOCK_GET_REUSED          = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 7)
 
     // the stream for http
 ,   TB_STREAM_CTRL_HTTP_GET_HEAD            = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 1)
@@ -130,6 +145,8 @@ typedef enum __tb_stream_ctrl_e
 ,   TB_STREAM_CTRL_HTTP_GET_POST_FUNC       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 12)
 ,   TB_STREAM_CTRL_HTTP_GET_POST_PRIV       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 13)
 ,   TB_STREAM_CTRL_HTTP_GET_POST_LRATE      = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 14)
+,   TB_STREAM_CTRL_HTTP_GET_POOL            = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 15)
+,   TB_STREAM_CTRL_HTTP_GET_HEAD_MAXN       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 16)
 
 ,   TB_STREAM_CTRL_HTTP_SET_HEAD            = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 20)
 ,   TB_STREAM_CTRL_HTTP_SET_RANGE           = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 21)
@@ -145,6 +162,8 @@ typedef enum __tb_stream_ctrl_e
 ,   TB_STREAM_CTRL_HTTP_SET_POST_FUNC       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 31)
 ,   TB_STREAM_CTRL_HTTP_SET_POST_PRIV       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 32)
 ,   TB_STREAM_CTRL_HTTP_SET_POST_LRATE      = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 33)
+,   TB_STREAM_CTRL_HTTP_SET_POOL            = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 34)
+,   TB_STREAM_CTRL_HTTP_SET_HEAD_MAXN       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 35)
 
     // the stream for filter
 ,   TB_STREAM_CTRL_FLTR_GET_STREAM          = TB_STREAM_CTRL(TB_STREAM_TYPE_FLTR, 1)
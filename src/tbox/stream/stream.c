@@ -38,6 +38,99 @@
 #include "../string/string.h"
 #include "../platform/platform.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_stream_sync_cache(tb_stream_ref_t self)
+{
+    // check
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return_val(stream && stream->writ && stream->wait && tb_stream_is_opened(self), tb_false);
+
+    // stoped?
+    tb_assert_and_check_return_val((TB_STATE_OPENED == tb_atomic32_get(&stream->istate)), tb_false);
+
+    // cached? sync cache
+    if (tb_queue_buffer_maxn(&stream->cache))
+    {
+        // have data?
+        if (!tb_queue_buffer_null(&stream->cache))
+        {
+            // check: must be writed cache
+            tb_assert_and_check_return_val(stream->bwrited, tb_false);
+
+            // enter cache for pull
+            tb_size_t   size = 0;
+            tb_byte_t*  head = tb_queue_buffer_pull_init(&stream->cache, &size);
+            tb_assert_and_check_return_val(head && size, tb_false);
+
+            // writ cache data to self
+            tb_size_t   writ = 0;
+            while (writ < size && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
+            {
+                // writ
+                tb_long_t real = stream->writ(self, head + writ, size - writ);
+
+                // ok?
+                if (real > 0)
+                {
+                    // save writ
+                    writ += real;
+                }
+                // no data?
+                else if (!real)
+                {
+                    // wait
+                    real = stream->wait(self, TB_STREAM_WAIT_WRIT, tb_stream_timeout(self));
+
+                    // ok?
+                    tb_check_break(real > 0);
+                }
+                // error or end?
+                else break;
+            }
+
+            // leave cache for pull
+            tb_queue_buffer_pull_exit(&stream->cache, writ);
+
+            // cache be not cleared?
+            if (!tb_queue_buffer_null(&stream->cache))
+            {
+                // killed? save state
+                if (!stream->state && (TB_STATE_KILLING == tb_atomic32_get(&stream->istate)))
+                    stream->state = TB_STATE_KILLED;
+
+                // failed
+                return tb_false;
+            }
+        }
+        else stream->bwrited = 1;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_stream_splice_file(tb_stream_ref_t self, tb_file_ref_t* pfile)
+{
+    // check
+    tb_assert(self && pfile);
+
+    // is file stream? the stream file (e.g. stdin) is not seekable and we cannot splice it with offset
+    return tb_stream_type(self) == TB_STREAM_TYPE_FILE && tb_stream_size(self) >= 0
+        && tb_stream_ctrl(self, TB_STREAM_CTRL_FILE_GET_FILE, pfile) && *pfile;
+}
+static tb_bool_t tb_stream_splice_sock(tb_stream_ref_t self, tb_socket_ref_t* psock)
+{
+    // check
+    tb_assert(self && psock);
+
+    // is tcp socket stream? we cannot splice the ssl data
+    tb_size_t type = 0;
+    return tb_stream_type(self) == TB_STREAM_TYPE_SOCK && !tb_url_ssl(tb_stream_url(self))
+        && tb_stream_ctrl(self, TB_STREAM_CTRL_SOCK_GET_TYPE, &type) && type == TB_SOCKET_TYPE_TCP
+        && tb_stream_ctrl(self, TB_STREAM_CTRL_SOCK_GET_SOCK, psock) && *psock;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -669,6 +762,18 @@ tb_bool_t tb_stream_need(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
     // stoped?
     tb_assert_and_check_return_val(TB_STATE_OPENED == tb_atomic32_get(&stream->istate), tb_false);
 
+    // mapped? need the mapped data directly
+    if (stream->mmap)
+    {
+        tb_byte_t* mapped = tb_null;
+        tb_long_t  real = stream->mmap(self, &mapped, size);
+        tb_check_return_val(real >= (tb_long_t)size && mapped, tb_false);
+
+        // save data
+        *data = mapped;
+        return tb_true;
+    }
+
     // have writed cache? sync first
     if (stream->bwrited && !tb_queue_buffer_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return tb_false;
 
@@ -756,6 +861,18 @@ tb_long_t tb_stream_peek(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
     // stoped?
     tb_assert_and_check_return_val(TB_STATE_OPENED == tb_atomic32_get(&stream->istate), -1);
 
+    // mapped? peek the mapped data directly
+    if (stream->mmap)
+    {
+        tb_byte_t* mapped = tb_null;
+        tb_long_t  real = stream->mmap(self, &mapped, size);
+        tb_check_return_val(real > 0 && mapped, real);
+
+        // save data
+        *data = mapped;
+        return tb_min(size, real);
+    }
+
     // have writed cache? sync first
     if (stream->bwrited && !tb_queue_buffer_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return -1;
 
@@ -817,6 +934,26 @@ tb_long_t tb_stream_read(tb_stream_ref_t self, tb_byte_t* data, tb_size_t size)
     // check self
     tb_assert_and_check_return_val(stream && tb_stream_is_opened(self) && stream->read, -1);
 
+    // mapped? read the mapped data directly
+    if (stream->mmap)
+    {
+        tb_byte_t* mapped = tb_null;
+        tb_long_t  real = stream->mmap(self, &mapped, size);
+        tb_check_return_val(real > 0 && mapped, real);
+
+        /* copy data
+         *
+         * @note we use tb_memcpy_ because the mapped data is not allocated from the pool
+         * and the checked tb_memcpy() may access the memory before the mapped region in debug mode
+         */
+        if (real > size) real = size;
+        tb_memcpy_(data, mapped, real);
+
+        // update offset
+        stream->offset += real;
+        return real;
+    }
+
     // done
     tb_long_t read = 0;
     do
@@ -1028,70 +1165,89 @@ tb_bool_t tb_stream_sync(tb_stream_ref_t self, tb_bool_t bclosing)
 {
     // check
     tb_stream_t* stream = tb_stream_cast(self);
-    tb_assert_and_check_return_val(stream && stream->writ && stream->wait && tb_stream_is_opened(self), tb_false);
+    tb_assert_and_check_return_val(stream, tb_false);
 
-    // stoped?
-    tb_assert_and_check_return_val((TB_STATE_OPENED == tb_atomic32_get(&stream->istate)), tb_false);
+    // sync cache first
+    if (!tb_stream_sync_cache(self)) return tb_false;
 
-    // cached? sync cache first
-    if (tb_queue_buffer_maxn(&stream->cache))
+    // sync
+    return stream->sync? stream->sync(self, bclosing) : tb_true;
+}
+tb_long_t tb_stream_splice_(tb_stream_ref_t self, tb_stream_ref_t ostream, tb_size_t size)
+{
+    // check
+    tb_stream_t* istream_ = tb_stream_cast(self);
+    tb_stream_t* ostream_ = tb_stream_cast(ostream);
+    tb_assert_and_check_return_val(istream_ && ostream_ && size, -1);
+    tb_assert_and_check_return_val(tb_stream_is_opened(self) && tb_stream_is_opened(ostream), -1);
+
+    // get the native file or socket, only support file => sock, sock => file and sock => sock
+    tb_file_ref_t   ifile = tb_null;
+    tb_file_ref_t   ofile = tb_null;
+    tb_socket_ref_t isock = tb_null;
+    tb_socket_ref_t osock = tb_null;
+    if (!tb_stream_splice_sock(self, &isock) && !tb_stream_splice_file(self, &ifile)) return -1;
+    if (!tb_stream_splice_sock(ostream, &osock) && !(isock && tb_stream_splice_file(ostream, &ofile))) return -1;
+
+    // have the read cache of istream? transfer it first
+    if (tb_queue_buffer_maxn(&istream_->cache) && !istream_->bwrited && !tb_queue_buffer_null(&istream_->cache))
     {
-        // have data?
-        if (!tb_queue_buffer_null(&stream->cache))
-        {
-            // check: must be writed cache
-            tb_assert_and_check_return_val(stream->bwrited, tb_false);
+        // enter cache for pull
+        tb_size_t   pull = 0;
+        tb_byte_t*  data = tb_queue_buffer_pull_init(&istream_->cache, &pull);
+        tb_assert_and_check_return_val(data && pull, -1);
+
+        // writ it to ostream
+        pull = tb_min(pull, size);
+        if (!tb_stream_bwrit(ostream, data, pull)) return -1;
+
+        // leave cache for pull
+        tb_queue_buffer_pull_exit(&istream_->cache, pull);
+        istream_->offset += pull;
+        return (tb_long_t)pull;
+    }
 
-            // enter cache for pull
-            tb_size_t   size = 0;
-            tb_byte_t*  head = tb_queue_buffer_pull_init(&stream->cache, &size);
-            tb_assert_and_check_return_val(head && size, tb_false);
+    // have the writ cache of ostream? sync it first
+    if (ostream_->bwrited && !tb_stream_sync_cache(ostream)) return -1;
 
-            // writ cache data to self
-            tb_size_t   writ = 0;
-            while (writ < size && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
-            {
-                // writ
-                tb_long_t real = stream->writ(self, head + writ, size - writ);
+    // splice it
+    tb_hong_t real = -1;
+    if (ifile) real = tb_socket_sendf(osock, ifile, istream_->offset, size);
+    else if (ofile) real = tb_socket_recvf(isock, ofile, ostream_->offset, size);
+    else real = tb_socket_splice(osock, isock, size);
+    tb_check_return_val(real > 0, (tb_long_t)real);
 
-                // ok?
-                if (real > 0)
-                {
-                    // save writ
-                    writ += real;
-                }
-                // no data?
-                else if (!real)
-                {
-                    // wait
-                    real = stream->wait(self, TB_STREAM_WAIT_WRIT, tb_stream_timeout(self));
+    // update the offset of istream, we need also seek the file position because sendfile() does not change it
+    istream_->offset += real;
+    if (ifile && !(istream_->seek && istream_->seek(self, istream_->offset))) return -1;
 
-                    // ok?
-                    tb_check_break(real > 0);
-                }
-                // error or end?
-                else break;
-            }
+    // update the offset of ostream
+    ostream_->offset += real;
+    if (ofile && !(ostream_->seek && ostream_->seek(ostream, ostream_->offset))) return -1;
 
-            // leave cache for pull
-            tb_queue_buffer_pull_exit(&stream->cache, writ);
+    // ok
+    return (tb_long_t)real;
+}
+tb_void_t tb_stream_mmap_set_(tb_stream_ref_t self, tb_long_t (*mmap)(tb_stream_ref_t self, tb_byte_t** pdata, tb_size_t size))
+{
+    // check
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return(stream);
 
-            // cache be not cleared?
-            if (!tb_queue_buffer_null(&stream->cache))
-            {
-                // killed? save state
-                if (!stream->state && (TB_STATE_KILLING == tb_atomic32_get(&stream->istate)))
-                    stream->state = TB_STATE_KILLED;
+    // check cache, we cannot switch it if there are some cached data
+    tb_assert_and_check_return(tb_queue_buffer_null(&stream->cache));
 
-                // failed
-                return tb_false;
-            }
-        }
-        else stream->bwrited = 1;
-    }
+    // set the mmap function
+    stream->mmap = mmap;
+}
+tb_bool_t tb_stream_mapped_(tb_stream_ref_t self)
+{
+    // check
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return_val(stream, tb_false);
 
-    // sync
-    return stream->sync? stream->sync(self, bclosing) : tb_true;
+    // is mapped?
+    return stream->mmap? tb_true : tb_false;
 }
 tb_bool_t tb_stream_seek(tb_stream_ref_t self, tb_hize_t offset)
 {
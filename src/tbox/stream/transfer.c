@@ -34,6 +34,20 @@
 #include "../network/network.h"
 #include "../platform/platform.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum splice size for zero-copy
+#define TB_TRANSFER_SPLICE_MAXN             (1 << 20)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c_enter__
+tb_long_t tb_stream_splice_(tb_stream_ref_t istream, tb_stream_ref_t ostream, tb_size_t size);
+__tb_extern_c_leave__
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -61,20 +75,48 @@ tb_hong_t tb_transfer(tb_stream_ref_t istream, tb_stream_ref_t ostream, tb_size_
     tb_size_t crate = 0;
     tb_long_t delay = 0;
     tb_size_t writ1s = 0;
+    tb_long_t wait = 0;
+
+    /* attempt to splice data in kernel for file => sock, sock => file and sock => sock,
+     * and we fall back to the buffered transfer if it's not supported
+     */
+    tb_bool_t splice = tb_true;
+    tb_bool_t ifile = tb_stream_type(istream) == TB_STREAM_TYPE_FILE;
     do
     {
-        // the need
-        tb_size_t need = lrate? tb_min(lrate, TB_STREAM_BLOCK_MAXN) : TB_STREAM_BLOCK_MAXN;
+        // read and writ data
+        tb_long_t real = -1;
+        if (splice)
+        {
+            // the need
+            tb_size_t need = lrate? tb_min(lrate, TB_TRANSFER_SPLICE_MAXN) : TB_TRANSFER_SPLICE_MAXN;
 
-        // read data
-        tb_long_t real = tb_stream_read(istream, data, need);
-        if (real > 0)
+            // splice data
+            real = tb_stream_splice_(istream, ostream, need);
+
+            // not supported? fall back to the buffered transfer
+            if (real < 0 && !writ)
+            {
+                splice = tb_false;
+                continue;
+            }
+        }
+        else
         {
-            // writ data
-            if (!tb_stream_bwrit(ostream, data, real)) break;
+            // the need
+            tb_size_t need = lrate? tb_min(lrate, TB_STREAM_BLOCK_MAXN) : TB_STREAM_BLOCK_MAXN;
 
+            // read data
+            real = tb_stream_read(istream, data, need);
+
+            // writ data
+            if (real > 0 && !tb_stream_bwrit(ostream, data, real)) break;
+        }
+        if (real > 0)
+        {
             // save writ
             writ += real;
+            wait = 0;
 
             // has func or limit rate?
             if (func || lrate)
@@ -118,12 +160,27 @@ tb_hong_t tb_transfer(tb_stream_ref_t istream, tb_stream_ref_t ostream, tb_size_
         }
         else if (!real)
         {
-            // wait
-            tb_long_t wait = tb_stream_wait(istream, TB_STREAM_WAIT_READ, tb_stream_timeout(istream));
-            tb_check_break(wait > 0);
+            // no data after waiting? it's end for splicing
+            if (splice && wait) break;
 
-            // has writ?
-            tb_assert_and_check_break(wait & TB_STREAM_WAIT_READ);
+            // wait the ostream for file => sock
+            if (splice && ifile)
+            {
+                wait = tb_stream_wait(ostream, TB_STREAM_WAIT_WRIT, tb_stream_timeout(ostream));
+                tb_check_break(wait > 0);
+
+                // can writ?
+                tb_assert_and_check_break(wait & TB_STREAM_WAIT_WRIT);
+            }
+            else
+            {
+                // wait
+                wait = tb_stream_wait(istream, TB_STREAM_WAIT_READ, tb_stream_timeout(istream));
+                tb_check_break(wait > 0);
+
+                // has writ?
+                tb_assert_and_check_break(wait & TB_STREAM_WAIT_READ);
+            }
         }
         else break;
 
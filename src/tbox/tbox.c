@@ -208,6 +208,9 @@ tb_void_t tb_exit()
     // kill singleton
     tb_singleton_kill();
 
+    // stop the async trace, the flusher thread uses the platform environment
+    tb_trace_mode_set(tb_trace_mode() & ~TB_TRACE_MODE_ASYNC);
+
     // exit object
 #ifdef TB_CONFIG_MODULE_HAVE_OBJECT
     tb_object_exit_env();
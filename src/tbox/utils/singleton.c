@@ -31,6 +31,7 @@
  */
 #include "singleton.h"
 #include "../libc/libc.h"
+#include "../memory/allocator.h"
 #include "../platform/platform.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -147,8 +148,10 @@ tb_handle_t tb_singleton_instance(tb_size_t type, tb_singleton_init_func_t init,
         // init priv
         g_singletons[type].priv = priv;
 
-        // init it
+        // init it, the singleton lives until tb_exit(), so it cannot be allocated from the scoped allocator, e.g. arena
+        tb_allocator_ref_t scoped = tb_allocator_scope_enter(tb_null);
         instance = init(&g_singletons[type].priv);
+        tb_allocator_scope_leave(scoped);
 
         // init func
         g_singletons[type].exit = exit;
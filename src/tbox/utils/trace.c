@@ -24,6 +24,7 @@
  * includes
  */
 #include "trace.h"
+#include "used.h"
 #include "../libc/libc.h"
 #include "../platform/platform.h"
 #include "../platform/impl/mutex.h"
@@ -43,12 +44,115 @@
 #   endif
 #endif
 
+// the async mode is enabled?
+#ifndef TB_CONFIG_MICRO_ENABLE
+#   define TB_TRACE_ASYNC_ENABLE
+#endif
+
+#ifdef TB_TRACE_ASYNC_ENABLE
+
+// the ring size of each thread, it must be pow2 and be larger than (TB_TRACE_LINE_MAXN + 16) * 2
+#ifdef __tb_small__
+#   define TB_TRACE_RING_SIZE           (8192 << 2)
+#else
+#   define TB_TRACE_RING_SIZE           (8192 << 3)
+#endif
+
+// the ring mask
+#define TB_TRACE_RING_MASK              (TB_TRACE_RING_SIZE - 1)
+
+// the record size of the wrapped tail, the rest space of the ring will be skipped
+#define TB_TRACE_RING_WRAP              (0xffffffff)
+
+// the flush interval (ms) of the background thread
+#define TB_TRACE_ASYNC_INTERVAL         (10)
+
+// the max iovec count of the batched writing
+#define TB_TRACE_ASYNC_IOVEC_MAXN       (64)
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the trace time stamp type, tb_localtime() is too slow to be called for each line
+typedef struct __tb_trace_stamp_t
+{
+    // the time
+    tb_time_t                   time;
+
+    // the stamp size
+    tb_size_t                   size;
+
+    // the stamp data, e.g. "[2024-01-01 00:00:00]: "
+    tb_char_t                   data[64];
+
+}tb_trace_stamp_t;
+
+#ifdef TB_TRACE_ASYNC_ENABLE
+
+// the trace record type, the line is followed and be aligned by 8 bytes
+typedef struct __tb_trace_record_t
+{
+    // the line size, not including '\0'
+    tb_uint32_t                 size;
+
+    // the offset of the printed line, the time and thread prefix are only written to file
+    tb_uint16_t                 offset;
+
+    // the trace mode
+    tb_uint16_t                 mode;
+
+}tb_trace_record_t;
+
+/* the trace ring type
+ *
+ * it is a single-producer and single-consumer ring of the thread,
+ * the owner thread writes the head and the flusher reads the tail with the trace lock.
+ */
+typedef struct __tb_trace_ring_t
+{
+    // the next ring
+    struct __tb_trace_ring_t*   next;
+
+    // the head, only be written by the owner thread
+    tb_atomic_t                 head;
+
+    // the padding, the head and tail are not in the same cache line
+    tb_byte_t                   pad0[TB_L1_CACHE_BYTES];
+
+    // the tail, only be written by the flusher
+    tb_atomic_t                 tail;
+
+    // the owner thread has been exited?
+    tb_atomic32_t               closed;
+
+    // the ring is being freed on the owner thread?
+    tb_bool_t                   freeing;
+
+    // the time stamp of the owner thread
+    tb_trace_stamp_t            stamp;
+
+    // the padding
+    tb_byte_t                   pad1[TB_L1_CACHE_BYTES];
+
+    // the line of the owner thread
+    tb_char_t                   line[TB_TRACE_LINE_MAXN];
+
+    // the ring data
+    tb_byte_t                   data[TB_TRACE_RING_SIZE];
+
+}tb_trace_ring_t, *tb_trace_ring_ref_t;
+
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
 
 // the mode
-static tb_size_t        g_mode = TB_TRACE_MODE_PRINT;
+static tb_atomic_t      g_mode = TB_TRACE_MODE_PRINT;
 
 #ifndef TB_CONFIG_MICRO_ENABLE
 // the file
@@ -56,6 +160,9 @@ static tb_file_ref_t    g_file = tb_null;
 
 // the file is referenced?
 static tb_bool_t        g_bref = tb_false;
+
+// the time stamp
+static tb_trace_stamp_t g_stamp;
 #endif
 
 // the line
@@ -65,6 +172,453 @@ static tb_char_t        g_line[TB_TRACE_LINE_MAXN];
 static tb_mutex_t       g_lock_mutex;
 static tb_mutex_ref_t   g_lock = tb_null;
 
+#ifdef TB_TRACE_ASYNC_ENABLE
+// the rings, be protected by the lock
+static tb_trace_ring_ref_t  g_rings = tb_null;
+
+// the ring of the current thread
+static tb_thread_local_t    g_ring_local = TB_THREAD_LOCAL_INIT;
+
+// the lock of the flusher state
+static tb_mutex_t           g_async_lock_mutex;
+static tb_mutex_ref_t       g_async_lock = tb_null;
+
+// the flusher thread and semaphore
+static tb_thread_ref_t      g_async_thread = tb_null;
+static tb_semaphore_ref_t   g_async_semaphore = tb_null;
+
+// the flusher is running? and stop it?
+static tb_atomic32_t        g_async_running = 0;
+static tb_atomic32_t        g_async_stop = 0;
+
+// the written lines, be protected by the lock
+static tb_hize_t            g_async_writ = 0;
+
+// the dropped and waited lines
+static tb_atomic64_t        g_async_drop = 0;
+static tb_atomic64_t        g_async_wait = 0;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t tb_trace_format(tb_char_t* line, tb_size_t maxn, tb_trace_stamp_t* stamp, tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args, tb_size_t* offset)
+{
+    // init
+    tb_char_t*      p = line;
+    tb_char_t*      e = line + maxn;
+
+    // print prefix to file
+#ifndef TB_CONFIG_MICRO_ENABLE
+    if (stamp)
+    {
+        // update the time stamp per second
+        tb_time_t now = tb_time();
+        if (now != stamp->time)
+        {
+            tb_tm_t lt = {0};
+            stamp->size = 0;
+            if (tb_localtime(now, &lt))
+                stamp->size = tb_snprintf(stamp->data, sizeof(stamp->data), "[%04ld-%02ld-%02ld %02ld:%02ld:%02ld]: ", lt.year, lt.month, lt.mday, lt.hour, lt.minute, lt.second);
+            stamp->time = now;
+        }
+
+        // print time to file
+        if (stamp->size < (tb_size_t)(e - p))
+        {
+            tb_memcpy_(p, stamp->data, stamp->size);
+            p += stamp->size;
+        }
+
+        // print self to file
+        if (p < e) p += tb_snprintf(p, e - p, "[%lx]: ", tb_thread_self());
+    }
+#else
+    tb_used(stamp);
+#endif
+
+    // save the offset of the printed line
+    *offset = p < e? p - line : 0;
+
+    // append prefix
+    if (prefix && p < e) p += tb_snprintf(p, e - p, "[%s]: ", prefix);
+
+    // append module
+    if (module && p < e) p += tb_snprintf(p, e - p, "[%s]: ", module);
+
+    // append format
+    if (p < e) p += tb_vsnprintf(p, e - p, format, args);
+
+    // append end
+    if (p < e) *p = '\0';
+    e[-1] = '\0';
+
+    // the line size
+    return p < e? p - line : maxn - 1;
+}
+#ifndef TB_CONFIG_MICRO_ENABLE
+static tb_void_t tb_trace_file_writ(tb_byte_t const* data, tb_size_t size)
+{
+    // done
+    tb_size_t writ = 0;
+    while (writ < size)
+    {
+        // writ it
+        tb_long_t real = tb_file_writ(g_file, data + writ, size - writ);
+        tb_check_break(real > 0);
+
+        // save size
+        writ += real;
+    }
+}
+#endif
+#ifdef TB_TRACE_ASYNC_ENABLE
+static tb_void_t tb_trace_file_writv(tb_iovec_t* list, tb_size_t size)
+{
+    // done
+    while (size)
+    {
+        // writ it
+        tb_long_t real = tb_file_writv(g_file, list, size);
+        tb_check_break(real > 0);
+
+        // skip the written data
+        while (size && (tb_size_t)real >= list->size)
+        {
+            real -= list->size;
+            list++;
+            size--;
+        }
+        if (size && real)
+        {
+            list->data += real;
+            list->size -= real;
+        }
+    }
+}
+static tb_void_t tb_trace_ring_free(tb_cpointer_t priv)
+{
+    // check
+    tb_trace_ring_ref_t ring = (tb_trace_ring_ref_t)priv;
+    tb_check_return(ring);
+
+    // be freeing? it will be called again by tb_thread_local_set()
+    tb_check_return(!ring->freeing);
+    ring->freeing = tb_true;
+
+    // clear the ring of the current thread, the next lines will be written synchronously
+    tb_thread_local_set(&g_ring_local, tb_null);
+
+    // mark it as closed, it will be freed by the flusher after all lines have been written
+    tb_atomic32_set(&ring->closed, 1);
+}
+static tb_trace_ring_ref_t tb_trace_ring(tb_noarg_t)
+{
+    // init the ring local, it will be failed before tb_init() or after tb_exit()
+    if (!tb_thread_local_init(&g_ring_local, tb_trace_ring_free)) return tb_null;
+
+    // get the ring of the current thread
+    tb_trace_ring_ref_t ring = (tb_trace_ring_ref_t)tb_thread_local_get(&g_ring_local);
+    tb_check_return_val(!ring, ring);
+
+    // the ring has been closed on this thread?
+    tb_check_return_val(!tb_thread_local_has(&g_ring_local), tb_null);
+
+    // make a new ring
+    ring = (tb_trace_ring_ref_t)tb_native_memory_malloc0(sizeof(tb_trace_ring_t));
+    tb_check_return_val(ring, tb_null);
+
+    // save it to the current thread
+    if (!tb_thread_local_set(&g_ring_local, ring))
+    {
+        tb_native_memory_free(ring);
+        return tb_null;
+    }
+
+    // register it to the flusher
+    if (g_lock) tb_mutex_enter_without_profiler(g_lock);
+    ring->next = g_rings;
+    g_rings = ring;
+    if (g_lock) tb_mutex_leave(g_lock);
+
+    // ok
+    return ring;
+}
+static tb_void_t tb_trace_async_wakeup(tb_noarg_t)
+{
+    // the semaphore may be exited by tb_trace_mode_set() at the same time, so we need the lock
+    if (g_async_lock) tb_mutex_enter_without_profiler(g_async_lock);
+    if (g_async_semaphore) tb_semaphore_post(g_async_semaphore, 1);
+    if (g_async_lock) tb_mutex_leave(g_async_lock);
+}
+static tb_void_t tb_trace_ring_push(tb_trace_ring_ref_t ring, tb_size_t mode, tb_size_t offset, tb_size_t size)
+{
+    // the head and tail
+    tb_size_t head = (tb_size_t)tb_atomic_get_explicit(&ring->head, TB_ATOMIC_RELAXED);
+    tb_size_t tail = (tb_size_t)tb_atomic_get_explicit(&ring->tail, TB_ATOMIC_ACQUIRE);
+
+    // the record need be contiguous, we skip the rest space at the end of the ring if it is not enough
+    tb_size_t need = tb_align8(sizeof(tb_trace_record_t) + size + 1);
+    tb_size_t pos  = head & TB_TRACE_RING_MASK;
+    tb_size_t skip = TB_TRACE_RING_SIZE - pos < need? TB_TRACE_RING_SIZE - pos : 0;
+
+    // the ring is full?
+    if (head + skip + need - tail > TB_TRACE_RING_SIZE)
+    {
+        // drop it?
+        if (!(mode & TB_TRACE_MODE_BLOCK))
+        {
+            tb_atomic64_fetch_and_add(&g_async_drop, 1);
+            return ;
+        }
+
+        // wait the flusher
+        tb_atomic64_fetch_and_add(&g_async_wait, 1);
+        tb_trace_async_wakeup();
+        do
+        {
+            // the flusher has been stopped? drop it
+            if (!tb_atomic32_get(&g_async_running))
+            {
+                tb_atomic64_fetch_and_add(&g_async_drop, 1);
+                return ;
+            }
+
+            // wait some time, the flusher needs to run on the same cpu core if the cores are busy
+            tb_usleep(100);
+
+            // update the tail
+            tail = (tb_size_t)tb_atomic_get_explicit(&ring->tail, TB_ATOMIC_ACQUIRE);
+
+        } while (head + skip + need - tail > TB_TRACE_RING_SIZE);
+    }
+
+    // skip the rest space
+    tb_byte_t* data = ring->data;
+    if (skip)
+    {
+        ((tb_trace_record_t*)(data + pos))->size = TB_TRACE_RING_WRAP;
+        head += skip;
+        pos = 0;
+    }
+
+    // write the record
+    tb_trace_record_t* record = (tb_trace_record_t*)(data + pos);
+    record->size    = (tb_uint32_t)size;
+    record->offset  = (tb_uint16_t)offset;
+    record->mode    = (tb_uint16_t)mode;
+    tb_memcpy_(record + 1, ring->line, size + 1);
+
+    // publish it
+    tb_atomic_set_explicit(&ring->head, head + need, TB_ATOMIC_RELEASE);
+
+    // wake up the flusher if the ring becomes half full
+    if (head + need - tail > (TB_TRACE_RING_SIZE >> 1) && head - tail <= (TB_TRACE_RING_SIZE >> 1))
+        tb_trace_async_wakeup();
+}
+static tb_bool_t tb_trace_async_done(tb_size_t mode, tb_bool_t tail, tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args)
+{
+    // get the ring of the current thread
+    tb_trace_ring_ref_t ring = tb_trace_ring();
+    tb_check_return_val(ring, tb_false);
+
+    // format the line
+    tb_size_t offset = 0;
+    tb_size_t size = tb_trace_format(ring->line, sizeof(ring->line), !tail && (mode & TB_TRACE_MODE_FILE)? &ring->stamp : tb_null, prefix, module, format, args, &offset);
+
+    // push it
+    tb_trace_ring_push(ring, mode, offset, size);
+    return tb_true;
+}
+// drain all rings, the trace lock need be entered
+static tb_size_t tb_trace_async_drain(tb_noarg_t)
+{
+    // done
+    tb_size_t               count = 0;
+    tb_size_t               print = 0;
+    tb_trace_ring_ref_t*    pring = &g_rings;
+    while (*pring)
+    {
+        // the ring
+        tb_trace_ring_ref_t ring = *pring;
+
+        // get the closed state first, all lines have been written if it is closed
+        tb_bool_t closed = tb_atomic32_get_explicit(&ring->closed, TB_ATOMIC_ACQUIRE)? tb_true : tb_false;
+
+        // the head and tail
+        tb_size_t head = (tb_size_t)tb_atomic_get_explicit(&ring->head, TB_ATOMIC_ACQUIRE);
+        tb_size_t tail = (tb_size_t)tb_atomic_get_explicit(&ring->tail, TB_ATOMIC_RELAXED);
+
+        // read the records
+        tb_iovec_t  list[TB_TRACE_ASYNC_IOVEC_MAXN];
+        tb_size_t   size = 0;
+        while (tail != head)
+        {
+            // the record
+            tb_size_t           pos = tail & TB_TRACE_RING_MASK;
+            tb_trace_record_t*  record = (tb_trace_record_t*)(ring->data + pos);
+
+            // skip the rest space
+            if (record->size == TB_TRACE_RING_WRAP)
+            {
+                tail += TB_TRACE_RING_SIZE - pos;
+                continue;
+            }
+
+            // print it
+            tb_char_t* line = (tb_char_t*)(record + 1);
+            if (record->mode & TB_TRACE_MODE_PRINT)
+            {
+                tb_print(line + record->offset);
+                print++;
+            }
+
+            // write it to file in batches
+            if ((record->mode & TB_TRACE_MODE_FILE) && g_file && record->size)
+            {
+                list[size].data = (tb_byte_t*)line;
+                list[size].size = record->size;
+                size++;
+            }
+
+            // next
+            tail += tb_align8(sizeof(tb_trace_record_t) + record->size + 1);
+            count++;
+
+            // the batch is full? write it and free the space
+            if (size == TB_TRACE_ASYNC_IOVEC_MAXN)
+            {
+                tb_trace_file_writv(list, size);
+                size = 0;
+                tb_atomic_set_explicit(&ring->tail, tail, TB_ATOMIC_RELEASE);
+            }
+        }
+
+        // write the left lines to file
+        if (size) tb_trace_file_writv(list, size);
+        tb_atomic_set_explicit(&ring->tail, tail, TB_ATOMIC_RELEASE);
+
+        // free the closed ring
+        if (closed)
+        {
+            *pring = ring->next;
+            tb_native_memory_free(ring);
+        }
+        else pring = &ring->next;
+    }
+
+    // sync the printed lines
+    if (print) tb_print_sync();
+
+    // update the written count
+    g_async_writ += count;
+    return count;
+}
+static tb_int_t tb_trace_async_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_semaphore_ref_t semaphore = (tb_semaphore_ref_t)priv;
+    tb_assert_and_check_return_val(semaphore, -1);
+
+    // flush the lines in batches
+    tb_bool_t stop = tb_false;
+    while (!stop)
+    {
+        // wait it
+        tb_semaphore_wait(semaphore, TB_TRACE_ASYNC_INTERVAL);
+
+        // stop it? we need drain all lines before stopping
+        stop = tb_atomic32_get(&g_async_stop)? tb_true : tb_false;
+
+        // drain all rings
+        if (g_lock) tb_mutex_enter_without_profiler(g_lock);
+        tb_trace_async_drain();
+        if (g_lock) tb_mutex_leave(g_lock);
+    }
+    return 0;
+}
+// start the flusher, the async lock need be entered
+static tb_bool_t tb_trace_async_start(tb_noarg_t)
+{
+    // have been started?
+    tb_check_return_val(!g_async_thread, tb_true);
+
+    // init semaphore
+    g_async_semaphore = tb_semaphore_init(0);
+    tb_check_return_val(g_async_semaphore, tb_false);
+
+    // init thread
+    tb_atomic32_set(&g_async_stop, 0);
+    g_async_thread = tb_thread_init("trace", tb_trace_async_loop, g_async_semaphore, 0);
+    if (!g_async_thread)
+    {
+        tb_semaphore_exit(g_async_semaphore);
+        g_async_semaphore = tb_null;
+        return tb_false;
+    }
+
+    // ok
+    tb_atomic32_set(&g_async_running, 1);
+    return tb_true;
+}
+// stop the flusher, the async lock need be entered
+static tb_void_t tb_trace_async_stop(tb_noarg_t)
+{
+    // have been stopped?
+    tb_check_return(g_async_thread);
+
+    // stop thread
+    tb_atomic32_set(&g_async_running, 0);
+    tb_atomic32_set(&g_async_stop, 1);
+    tb_semaphore_post(g_async_semaphore, 1);
+
+    // exit thread
+    tb_thread_wait(g_async_thread, -1, tb_null);
+    tb_thread_exit(g_async_thread);
+    g_async_thread = tb_null;
+
+    // exit semaphore
+    tb_semaphore_exit(g_async_semaphore);
+    g_async_semaphore = tb_null;
+}
+#endif
+static tb_void_t tb_trace_done_impl(tb_bool_t tail, tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args)
+{
+    // the mode
+    tb_size_t mode = (tb_size_t)tb_atomic_get(&g_mode);
+    tb_check_return(mode);
+
+    // write it to the ring of the current thread
+#ifdef TB_TRACE_ASYNC_ENABLE
+    if ((mode & TB_TRACE_MODE_ASYNC) && tb_trace_async_done(mode, tail, prefix, module, format, args)) return ;
+#endif
+
+    // enter
+    if (g_lock) tb_mutex_enter_without_profiler(g_lock);
+
+    // format it
+    tb_size_t offset = 0;
+#ifndef TB_CONFIG_MICRO_ENABLE
+    tb_trace_stamp_t* stamp = !tail && (mode & TB_TRACE_MODE_FILE) && g_file? &g_stamp : tb_null;
+#else
+    tb_trace_stamp_t* stamp = tb_null;
+#endif
+    tb_size_t size = tb_trace_format(g_line, sizeof(g_line), stamp, prefix, module, format, args, &offset);
+
+    // print it
+    if (mode & TB_TRACE_MODE_PRINT) tb_print(g_line + offset);
+
+    // print it to file
+#ifndef TB_CONFIG_MICRO_ENABLE
+    if ((mode & TB_TRACE_MODE_FILE) && g_file) tb_trace_file_writ((tb_byte_t const*)g_line, size);
+#else
+    tb_used(size);
+#endif
+
+    // leave
+    if (g_lock) tb_mutex_leave(g_lock);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -72,10 +626,29 @@ tb_bool_t tb_trace_init()
 {
     // init lock
     g_lock = tb_mutex_init_impl(&g_lock_mutex);
-    return g_lock? tb_true : tb_false;
+    tb_check_return_val(g_lock, tb_false);
+
+    // init the async lock
+#ifdef TB_TRACE_ASYNC_ENABLE
+    g_async_lock = tb_mutex_init_impl(&g_async_lock_mutex);
+    tb_check_return_val(g_async_lock, tb_false);
+#endif
+
+    // ok
+    return tb_true;
 }
 tb_void_t tb_trace_exit()
 {
+    // stop the flusher, it has been stopped in tb_exit() normally
+#ifdef TB_TRACE_ASYNC_ENABLE
+    if (g_async_lock)
+    {
+        tb_mutex_enter_without_profiler(g_async_lock);
+        tb_trace_async_stop();
+        tb_mutex_leave(g_async_lock);
+    }
+#endif
+
     // sync trace
     tb_trace_sync();
 
@@ -83,7 +656,17 @@ tb_void_t tb_trace_exit()
     if (g_lock) tb_mutex_enter_without_profiler(g_lock);
 
     // clear mode
-    g_mode = TB_TRACE_MODE_PRINT;
+    tb_atomic_set(&g_mode, TB_TRACE_MODE_PRINT);
+
+    // free all rings, the thread locals have been exited now
+#ifdef TB_TRACE_ASYNC_ENABLE
+    while (g_rings)
+    {
+        tb_trace_ring_ref_t ring = g_rings;
+        g_rings = ring->next;
+        tb_native_memory_free(ring);
+    }
+#endif
 
     // clear file
 #ifndef TB_CONFIG_MICRO_ENABLE
@@ -95,37 +678,53 @@ tb_void_t tb_trace_exit()
     // leave
     if (g_lock) tb_mutex_leave(g_lock);
 
+    // exit the async lock
+#ifdef TB_TRACE_ASYNC_ENABLE
+    if (g_async_lock) tb_mutex_exit_impl(&g_async_lock_mutex);
+    g_async_lock = tb_null;
+#endif
+
     // exit lock
     tb_mutex_exit_impl(&g_lock_mutex);
     g_lock = tb_null;
 }
 tb_size_t tb_trace_mode()
 {
-    // enter
-    if (g_lock) tb_mutex_enter_without_profiler(g_lock);
-
-    // the mode
-    tb_size_t mode = g_mode;
-
-    // leave
-    if (g_lock) tb_mutex_leave(g_lock);
-
-    // ok?
-    return mode;
+    return (tb_size_t)tb_atomic_get(&g_mode);
 }
 tb_bool_t tb_trace_mode_set(tb_size_t mode)
 {
+#ifdef TB_TRACE_ASYNC_ENABLE
+    // no async mode?
+    if (!(mode & TB_TRACE_MODE_ASYNC)) mode &= ~TB_TRACE_MODE_BLOCK;
+
     // enter
-    if (g_lock) tb_mutex_enter_without_profiler(g_lock);
+    tb_check_return_val(g_async_lock || !(mode & TB_TRACE_MODE_ASYNC), tb_false);
+    if (g_async_lock) tb_mutex_enter_without_profiler(g_async_lock);
+
+    // start the flusher first if the async mode is enabled
+    tb_bool_t ok = (mode & TB_TRACE_MODE_ASYNC)? tb_trace_async_start() : tb_true;
 
     // set the mode
-    g_mode = mode;
+    if (ok) tb_atomic_set(&g_mode, mode);
+
+    // stop the flusher and write the left lines if the async mode is disabled
+    if (ok && !(mode & TB_TRACE_MODE_ASYNC) && g_async_thread)
+    {
+        tb_trace_async_stop();
+        tb_trace_sync();
+    }
 
     // leave
-    if (g_lock) tb_mutex_leave(g_lock);
+    if (g_async_lock) tb_mutex_leave(g_async_lock);
 
-    // ok
+    // ok?
+    return ok;
+#else
+    // the async mode is not supported
+    tb_atomic_set(&g_mode, mode & ~(TB_TRACE_MODE_ASYNC | TB_TRACE_MODE_BLOCK));
     return tb_true;
+#endif
 }
 #ifndef TB_CONFIG_MICRO_ENABLE
 tb_file_ref_t tb_trace_file()
@@ -193,73 +792,8 @@ tb_void_t tb_trace_done_with_args(tb_char_t const* prefix, tb_char_t const* modu
     // check
     tb_check_return(format);
 
-    // enter
-    if (g_lock) tb_mutex_enter_without_profiler(g_lock);
-
-    // done
-    do
-    {
-        // check
-        tb_check_break(g_mode);
-
-        // init
-        tb_char_t*      p = g_line;
-        tb_char_t*      e = g_line + sizeof(g_line);
-
-        // print prefix to file
-#ifndef TB_CONFIG_MICRO_ENABLE
-        if ((g_mode & TB_TRACE_MODE_FILE) && g_file)
-        {
-            // print time to file
-            tb_tm_t lt = {0};
-            if (p < e && tb_localtime(tb_time(), &lt))
-                p += tb_snprintf(p, e - p, "[%04ld-%02ld-%02ld %02ld:%02ld:%02ld]: ", lt.year, lt.month, lt.mday, lt.hour, lt.minute, lt.second);
-
-            // print self to file
-            if (p < e) p += tb_snprintf(p, e - p, "[%lx]: ", tb_thread_self());
-        }
-#endif
-
-        // append prefix
-        tb_char_t*      b = p;
-        if (prefix && p < e) p += tb_snprintf(p, e - p, "[%s]: ", prefix);
-
-        // append module
-        if (module && p < e) p += tb_snprintf(p, e - p, "[%s]: ", module);
-
-        // append format
-        if (p < e) p += tb_vsnprintf(p, e - p, format, args);
-
-        // append end
-        if (p < e) *p = '\0';
-        e[-1] = '\0';
-
-        // print it
-        if (g_mode & TB_TRACE_MODE_PRINT) tb_print(b);
-
-        // print it to file
-#ifndef TB_CONFIG_MICRO_ENABLE
-        if ((g_mode & TB_TRACE_MODE_FILE) && g_file)
-        {
-            // done
-            tb_size_t size = p - g_line;
-            tb_size_t writ = 0;
-            while (writ < size)
-            {
-                // writ it
-                tb_long_t real = tb_file_writ(g_file, (tb_byte_t const*)g_line + writ, size - writ);
-                tb_check_break(real > 0);
-
-                // save size
-                writ += real;
-            }
-        }
-#endif
-
-    } while (0);
-
-    // leave
-    if (g_lock) tb_mutex_leave(g_lock);
+    // done trace
+    tb_trace_done_impl(tb_false, prefix, module, format, args);
 }
 tb_void_t tb_trace_done(tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, ...)
 {
@@ -281,71 +815,56 @@ tb_void_t tb_trace_tail(tb_char_t const* format, ...)
     // check
     tb_check_return(format);
 
-    // enter
-    if (g_lock) tb_mutex_enter_without_profiler(g_lock);
-
-    // done
-    do
-    {
-        // check
-        tb_check_break(g_mode);
-
-        // init
-        tb_va_list_t    l;
-        tb_char_t*      p = g_line;
-        tb_char_t*      e = g_line + sizeof(g_line);
-        tb_va_start(l, format);
-
-        // append format
-        if (p < e) p += tb_vsnprintf(p, e - p, format, l);
-
-        // append end
-        if (p < e) *p = '\0';
-        e[-1] = '\0';
-
-        // print it
-        if (g_mode & TB_TRACE_MODE_PRINT) tb_print(g_line);
-
-        // print it to file
-#ifndef TB_CONFIG_MICRO_ENABLE
-        if ((g_mode & TB_TRACE_MODE_FILE) && g_file)
-        {
-            // done
-            tb_size_t size = p - g_line;
-            tb_size_t writ = 0;
-            while (writ < size)
-            {
-                // writ it
-                tb_long_t real = tb_file_writ(g_file, (tb_byte_t const*)g_line + writ, size - writ);
-                tb_check_break(real > 0);
-
-                // save size
-                writ += real;
-            }
-        }
-#endif
-
-        // exit
-        tb_va_end(l);
+    // init args
+    tb_va_list_t args;
+    tb_va_start(args, format);
 
-    } while (0);
+    // done trace tail
+    tb_trace_done_impl(tb_true, tb_null, tb_null, format, args);
 
-    // leave
-    if (g_lock) tb_mutex_leave(g_lock);
+    // exit args
+    tb_va_end(args);
 }
 tb_void_t tb_trace_sync()
 {
     // enter
     if (g_lock) tb_mutex_enter_without_profiler(g_lock);
 
+    // write all lines of the async mode
+#ifdef TB_TRACE_ASYNC_ENABLE
+    tb_trace_async_drain();
+#endif
+
+    // the mode
+    tb_size_t mode = (tb_size_t)tb_atomic_get(&g_mode);
+
     // sync it
-    if (g_mode & TB_TRACE_MODE_PRINT) tb_print_sync();
+    if (mode & TB_TRACE_MODE_PRINT) tb_print_sync();
 
     // sync it to file
 #ifndef TB_CONFIG_MICRO_ENABLE
-    if ((g_mode & TB_TRACE_MODE_FILE) && g_file) tb_file_sync(g_file);
+    if ((mode & TB_TRACE_MODE_FILE) && g_file) tb_file_sync(g_file);
 #endif
 
     // leave
     if (g_lock) tb_mutex_leave(g_lock);
 }
+tb_void_t tb_trace_stat(tb_trace_stat_ref_t stat)
+{
+    // check
+    tb_assert_and_check_return(stat);
+
+    // clear it
+    tb_memset_(stat, 0, sizeof(tb_trace_stat_t));
+
+#ifdef TB_TRACE_ASYNC_ENABLE
+    // get the written count
+    if (g_lock) tb_mutex_enter_without_profiler(g_lock);
+    stat->writ = g_async_writ;
+    if (g_lock) tb_mutex_leave(g_lock);
+
+    // get the dropped and waited count
+    stat->drop = (tb_hize_t)tb_atomic64_get(&g_async_drop);
+    stat->wait = (tb_hize_t)tb_atomic64_get(&g_async_wait);
+#endif
+}
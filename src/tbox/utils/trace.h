@@ -43,9 +43,25 @@ typedef enum __tb_trace_mode_e
     TB_TRACE_MODE_NONE      = 0
 ,   TB_TRACE_MODE_FILE      = 1
 ,   TB_TRACE_MODE_PRINT     = 2
+,   TB_TRACE_MODE_ASYNC     = 4     //!< the lines are written to the per-thread rings and be flushed by the background thread
+,   TB_TRACE_MODE_BLOCK     = 8     //!< wait for the flusher instead of dropping the line if the ring is full, only for the async mode
 
 }tb_trace_mode_e;
 
+/// the trace stat type
+typedef struct __tb_trace_stat_t
+{
+    /// the written lines of the async mode
+    tb_hize_t               writ;
+
+    /// the dropped lines because the ring is full
+    tb_hize_t               drop;
+
+    /// the lines which have been waited for the flusher because the ring is full
+    tb_hize_t               wait;
+
+}tb_trace_stat_t, *tb_trace_stat_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -67,6 +83,17 @@ tb_void_t           tb_trace_exit(tb_noarg_t);
 tb_size_t           tb_trace_mode(tb_noarg_t);
 
 /*! set the trace mode
+ *
+ * the async mode can be switched at runtime, e.g.
+ *
+ * @code
+    tb_trace_mode_set(TB_TRACE_MODE_PRINT | TB_TRACE_MODE_ASYNC);
+ * @endcode
+ *
+ * each thread formats the lines into its own lock-free ring and the background thread
+ * writes them in batches, the line is dropped if the ring is full unless TB_TRACE_MODE_BLOCK is set.
+ *
+ * the async mode is not supported for the micro mode and it will be ignored.
  *
  * @param mode      the trace mode
  *
@@ -121,9 +148,17 @@ tb_void_t           tb_trace_done(tb_char_t const* prefix, tb_char_t const* modu
 tb_void_t           tb_trace_tail(tb_char_t const* format, ...);
 
 /*! sync trace
+ *
+ * it also flushes all pending lines of the async mode
  */
 tb_void_t           tb_trace_sync(tb_noarg_t);
 
+/*! the trace stat of the async mode
+ *
+ * @param stat      the trace stat
+ */
+tb_void_t           tb_trace_stat(tb_trace_stat_ref_t stat);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -54,7 +54,7 @@ target("tbox")
 
     -- add the common source files
     add_files("*.c")
-    add_files("hash/bkdr.c", "hash/fnv32.c", "hash/adler32.c")
+    add_files("hash/bkdr.c", "hash/fnv32.c", "hash/adler32.c", "hash/xxh3.c")
     add_files("math/**.c")
     add_files("libc/**.c|string/impl/**.c")
     add_files("utils/*.c|option.c")
@@ -84,7 +84,7 @@ target("tbox")
 
     -- add the source files for the hash module
     if has_config("hash") then
-        add_files("hash/*.c")
+        add_files("hash/*.c", "hash/impl/*.c")
         if not is_plat("windows") and not has_config("cosmocc") and not is_config("toolchain", "cosmocc") then
             add_files("hash/arch/crc32.S")
         end
@@ -31,6 +31,7 @@ target "tbox"
     add_files "hash/bkdr.c"
     add_files "hash/fnv32.c"
     add_files "hash/adler32.c"
+    add_files "hash/xxh3.c"
     add_files "math/**.c"
     add_files "libc/misc/*.c"
     add_files "libc/misc/time/*.c"
@@ -87,6 +88,7 @@ target "tbox"
     add_files "platform/event.c"
     add_files "platform/file.c"
     add_files "platform/filelock.c"
+    add_files "platform/filemap.c"
     add_files "platform/fwatcher.c"
     add_files "platform/hostname.c"
     add_files "platform/ifaddrs.c"
@@ -178,6 +180,7 @@ target "tbox"
         add_files "hash/blizzard.c"
         add_files "hash/crc16.c"
         add_files "hash/crc32.c"
+        add_files "hash/crc32c.c"
         add_files "hash/crc8.c"
         add_files "hash/djb2.c"
         add_files "hash/fnv64.c"
@@ -187,6 +190,7 @@ target "tbox"
         add_files "hash/rs.c"
         add_files "hash/sha.c"
         add_files "hash/uuid.c"
+        add_files "hash/impl/multi.c"
         if ! is_toolchain "cosmocc"; then
             add_files "hash/arch/crc32.S"
         fi
@@ -208,6 +212,7 @@ target "tbox"
     if has_config "object"; then
         add_files "object/*.c"
         add_files "object/impl/*.c"
+        add_files "object/json/*.c"
         add_files "object/impl/reader/bin.c"
         add_files "object/impl/reader/json.c"
         add_files "object/impl/reader/bplist.c"
@@ -162,6 +162,7 @@ check_interfaces() {
         "memset" \
         "memmove" \
         "memcmp" \
+        "memchr" \
         "memmem" \
         "strcat" \
         "strncat" \
@@ -258,6 +259,7 @@ check_interfaces() {
     check_module_cfuncs "posix" "unistd.h"                         "fdatasync"
     check_module_cfuncs "posix" "copyfile.h"                       "copyfile"
     check_module_cfuncs "posix" "sys/sendfile.h"                   "sendfile"
+    check_module_cfuncs "posix" "fcntl.h"                          "splice" # need _GNU_SOURCE
     check_module_cfuncs "posix" "sys/epoll.h"                      "epoll_create" "epoll_wait"
     check_module_cfuncs "posix" "spawn.h"                          "posix_spawnp" "posix_spawn_file_actions_addchdir_np"
     check_module_cfuncs "posix" "unistd.h"                         "execvp" "execvpe" "fork" "vfork"
@@ -282,6 +284,11 @@ check_interfaces() {
     check_module_csnippets "linux_ifaddrs" "TB_CONFIG_LINUX_HAVE_IFADDRS" \
         "#include <linux/if.h>\n
          #include <linux/netlink.h>"
+    check_module_csnippets "linux_io_uring" "TB_CONFIG_LINUX_HAVE_IO_URING" \
+        "#include <linux/io_uring.h>\n
+         #include <sys/syscall.h>\n
+         #include <unistd.h>\n
+         void test() {struct io_uring_getevents_arg arg; struct io_uring_params p; p.features = IORING_FEAT_EXT_ARG; arg.ts = IORING_POLL_ADD_MULTI; syscall(__NR_io_uring_setup, 1, &p);}"
 
     # add the interfaces for sigsetjmp
     check_module_csnippets "libc_sigsetjmp" "TB_CONFIG_LIBC_HAVE_SIGSETJMP" \
@@ -97,6 +97,7 @@ function _check_interfaces(target)
         "memset",
         "memmove",
         "memcmp",
+        "memchr",
         "memmem",
         "strcat",
         "strncat",
@@ -192,6 +193,7 @@ function _check_interfaces(target)
         _check_module_cfuncs(target, "posix", "unistd.h",                         "fdatasync")
         _check_module_cfuncs(target, "posix", "copyfile.h",                       "copyfile")
         _check_module_cfuncs(target, "posix", "sys/sendfile.h",                   "sendfile")
+        _check_module_cfuncs(target, "posix", "fcntl.h",                          "splice") -- need _GNU_SOURCE
         _check_module_cfuncs(target, "posix", "sys/epoll.h",                      "epoll_create", "epoll_wait")
         _check_module_cfuncs(target, "posix", "unistd.h",                         "execvp", "execvpe", "fork", "vfork")
         _check_module_cfuncs(target, "posix", "sys/wait.h",                       "waitpid")
@@ -271,6 +273,17 @@ function _check_interfaces(target)
     if target:is_plat("linux", "android") then
         _check_module_cfuncs(target, "linux", {"sys/inotify.h"}, "inotify_init")
         _check_keyword_csnippet(target, "linux_ifaddrs", "TB_CONFIG_LINUX_HAVE_IFADDRS", "#include <linux/if.h>\n#include <linux/netlink.h>")
+        _check_keyword_csnippet(target, "linux_io_uring", "TB_CONFIG_LINUX_HAVE_IO_URING", [[
+            #include <linux/io_uring.h>
+            #include <sys/syscall.h>
+            #include <unistd.h>
+            void test() {
+                struct io_uring_getevents_arg arg;
+                struct io_uring_params p;
+                p.features = IORING_FEAT_EXT_ARG;
+                arg.ts = IORING_POLL_ADD_MULTI;
+                syscall(__NR_io_uring_setup, 1, &p);
+            }]])
     end
 
     -- add the interfaces for valgrind